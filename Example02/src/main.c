@@ -9,6 +9,8 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "GL/glus.h"
 
@@ -155,12 +157,26 @@ int main(int argc, char* argv[])
 
     glusWindowSetTerminateFunc(terminate);
 
+    // Renders the given number of frames without showing the window e.g. "--headless 600".
+    if (argc > 1 && strcmp(argv[1], "--headless") == 0)
+    {
+        glusWindowSetHeadless(GLUS_TRUE, argc > 2 ? atoi(argv[2]) : 600, 1.0f / 60.0f);
+    }
+
     if (!glusWindowCreate("GLUS Example Window", 640, 480, GLUS_FALSE, GLUS_FALSE, eglConfigAttributes, eglContextAttributes, 0))
     {
         printf("Could not create window!\n");
         return -1;
     }
 
+    // Headless without a display, GLFW does not create a rendering context.
+    if (!glusWindowHasContext())
+    {
+        printf("Could not create rendering context!\n");
+        glusWindowDestroy();
+        return -1;
+    }
+
     glusWindowRun();
 
     return 0;
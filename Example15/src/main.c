@@ -66,7 +66,11 @@ GLUSboolean init(GLUSvoid)
     GLfloat* points = (GLfloat*) malloc(WATER_PLANE_LENGTH * WATER_PLANE_LENGTH * 4 * sizeof(GLfloat));
     GLuint* indices = (GLuint*) malloc(WATER_PLANE_LENGTH * (WATER_PLANE_LENGTH - 1) * 2 * sizeof(GLuint));
 
-    GLUStgaimage image;
+    static const GLchar* cubemapFilenames[6] = { "water_pos_x.tga", "water_neg_x.tga", "water_pos_y.tga", "water_neg_y.tga", "water_pos_z.tga", "water_neg_z.tga" };
+
+    GLUStgaimage image[6];
+
+    GLUSimagebatchentry entry[6];
 
     GLUStextfile vertexSource;
     GLUStextfile fragmentSource;
@@ -156,29 +160,21 @@ GLUSboolean init(GLUSvoid)
     glGenTextures(1, &g_cubemap);
     glBindTexture(GL_TEXTURE_CUBE_MAP, g_cubemap);
 
-    glusImageLoadTga("water_pos_x.tga", &image);
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X, 0, image.format, image.width, image.height, 0, image.format, GL_UNSIGNED_BYTE, image.data);
-    glusImageDestroyTga(&image);
-
-    glusImageLoadTga("water_neg_x.tga", &image);
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_X, 0, image.format, image.width, image.height, 0, image.format, GL_UNSIGNED_BYTE, image.data);
-    glusImageDestroyTga(&image);
-
-    glusImageLoadTga("water_pos_y.tga", &image);
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Y, 0, image.format, image.width, image.height, 0, image.format, GL_UNSIGNED_BYTE, image.data);
-    glusImageDestroyTga(&image);
-
-    glusImageLoadTga("water_neg_y.tga", &image);
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Y, 0, image.format, image.width, image.height, 0, image.format, GL_UNSIGNED_BYTE, image.data);
-    glusImageDestroyTga(&image);
+    // Load all six sides concurrently.
+    for (i = 0; i < 6; i++)
+    {
+        entry[i].filename = cubemapFilenames[i];
+        entry[i].type = GLUS_IMAGE_TGA;
+        entry[i].image = &image[i];
+    }
 
-    glusImageLoadTga("water_pos_z.tga", &image);
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_Z, 0, image.format, image.width, image.height, 0, image.format, GL_UNSIGNED_BYTE, image.data);
-    glusImageDestroyTga(&image);
+    glusImageLoadBatch(entry, 6, 0, 0, 0);
 
-    glusImageLoadTga("water_neg_z.tga", &image);
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_NEGATIVE_Z, 0, image.format, image.width, image.height, 0, image.format, GL_UNSIGNED_BYTE, image.data);
-    glusImageDestroyTga(&image);
+    for (i = 0; i < 6; i++)
+    {
+        glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, image[i].format, image[i].width, image[i].height, 0, image[i].format, GL_UNSIGNED_BYTE, image[i].data);
+        glusImageDestroyTga(&image[i]);
+    }
 
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
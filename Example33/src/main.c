@@ -137,6 +137,11 @@ GLUSboolean init(GLUSvoid)
 	// 6 sides of diffuse and specular; all roughness levels of specular.
 	GLUShdrimage image[6 * NUMBER_ROUGHNESS + 6];
 
+	// All images are loaded as one batch.
+	GLUSimagebatchentry entry[6 * NUMBER_ROUGHNESS + 6];
+	GLchar filename[6 * NUMBER_ROUGHNESS + 6][27];
+	GLint numberEntries = 0;
+
 	// The look up table (LUT) is stored in a raw binary file.
 	GLUSbinaryfile rawimage;
 
@@ -305,19 +310,30 @@ GLUSboolean init(GLUSvoid)
 						break;
 				}
 
-				printf("Loading '%s' ...", buffer);
+				strcpy(filename[numberEntries], buffer);
 
-				if (!glusImageLoadHdr(buffer, &image[i*NUMBER_ROUGHNESS*6 + k*6 + m]))
-				{
-					printf(" error!\n");
-					continue;
-				}
+				entry[numberEntries].filename = filename[numberEntries];
+				entry[numberEntries].type = GLUS_IMAGE_HDR;
+				entry[numberEntries].image = &image[i*NUMBER_ROUGHNESS*6 + k*6 + m];
 
-				printf(" done.\n");
+				numberEntries++;
 			}
 		}
 	}
 
+	// Decode the files concurrently, using all processors.
+
+	printf("Loading %d HDR images ...", numberEntries);
+
+	if (!glusImageLoadBatch(entry, numberEntries, 0, 0, 0))
+	{
+		printf(" error!\n");
+	}
+	else
+	{
+		printf(" done.\n");
+	}
+
     glGenTextures(1, &g_texture[0]);
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_CUBE_MAP_ARRAY, g_texture[0]);
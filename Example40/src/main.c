@@ -148,12 +148,12 @@ GLUSboolean init(GLUSvoid)
 
     //
 
-    normals = (GLfloat*)malloc(g_gridPlane.numberVertices * 4 * sizeof(GLfloat));
+    normals = (GLfloat*)glusMemoryMalloc(g_gridPlane.numberVertices * 4 * sizeof(GLfloat));
 
     // Add one more GLfloat channel as padding for std430 layout.
     glusPaddingConvertf(normals, g_gridPlane.normals, 3, 1, g_gridPlane.numberVertices);
 
-    free(g_gridPlane.normals);
+    glusMemoryFree(g_gridPlane.normals);
     g_gridPlane.normals = normals;
 
     //
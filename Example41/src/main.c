@@ -36,9 +36,6 @@
 // Length of the ocean grid.
 #define LENGTH	250.0f
 
-// Gravity.
-#define GRAVITY 9.81f
-
 // Amplitude of the wave.
 #define AMPLITUDE 0.002f
 
@@ -48,8 +45,8 @@
 // Wind direction.
 #define WIND_DIRECTION {1.0f, 1.0f}
 
-// Largest possible wave arising.
-#define LPWA (WIND_SPEED * WIND_SPEED / GRAVITY)
+// Number of frames simulated on the CPU, if no window is used.
+#define HEADLESS_FRAMES 60
 
 //
 
@@ -103,20 +100,6 @@ static GLuint g_vao;
 
 static GLuint g_numberIndices;
 
-static GLfloat phillipsSpectrum(GLfloat A, GLfloat L, GLfloat waveDirection[2], GLfloat windDirection[2])
-{
-	GLfloat k = glusVector2Lengthf(waveDirection);
-	GLfloat waveDotWind = glusVector2Dotf(waveDirection, windDirection);
-
-	// Avoid division by zero.
-	if (L == 0.0f || k == 0.0f)
-	{
-		return 0.0f;
-	}
-
-	return A * expf(-1.0f / (k * L * k * L)) / (k * k * k * k) * waveDotWind * waveDotWind;
-}
-
 GLUSboolean init(GLUSvoid)
 {
     GLfloat lightDirection[3] = { 1.0f, 1.0f, 1.0f };
@@ -129,17 +112,16 @@ GLUSboolean init(GLUSvoid)
 
     GLUSshape gridPlane;
 
-    GLint i, k;
+    GLint i;
+    GLuint vertex;
     GLfloat matrix[16];
 
-    GLfloat* h0Data;
+    GLUSocean ocean;
 
     GLint* butterflyIndices;
     GLfloat* butterflyIndicesAsFloat;
 
-    GLfloat waveDirection[2];
     GLfloat windDirection[2] = WIND_DIRECTION;
-    GLfloat phillipsSpectrumValue;
 
     //
 
@@ -210,9 +192,9 @@ GLUSboolean init(GLUSvoid)
     // Rotate by 90 degrees, that the grid is in the x-z-plane.
     glusMatrix4x4Identityf(matrix);
     glusMatrix4x4RotateRxf(matrix, -90.0f);
-    for (i = 0; i < gridPlane.numberVertices; i++)
+    for (vertex = 0; vertex < gridPlane.numberVertices; vertex++)
     {
-    	glusMatrix4x4MultiplyPoint4f(&gridPlane.vertices[4 * i], matrix, &gridPlane.vertices[4 * i]);
+    	glusMatrix4x4MultiplyPoint4f(&gridPlane.vertices[4 * vertex], matrix, &gridPlane.vertices[4 * vertex]);
     }
 
     glGenBuffers(1, &g_verticesVBO);
@@ -237,44 +219,25 @@ GLUSboolean init(GLUSvoid)
     // Generate H0.
     //
 
-    h0Data = (GLfloat*)malloc(N * N * 2 * sizeof(GLfloat));
-
-    if (!h0Data)
+    // The CPU ocean creates the same spectrum, so both paths can be compared.
+    if (!glusOceanCreate(&ocean, N, LENGTH, AMPLITUDE, WIND_SPEED, windDirection, 0))
     {
     	return GLUS_FALSE;
     }
 
-    glusVector2Normalizef(windDirection);
-
-    for (i = 0; i < N; i++)
-    {
-    	// Positive N, that it matches with OpenGL z-axis.
-    	waveDirection[1] = ((GLfloat)N / 2.0f - (GLfloat)i) * (2.0f * GLUS_PI / LENGTH);
-
-        for (k = 0; k < N; k++)
-        {
-        	waveDirection[0] = ((GLfloat)-N / 2.0f + (GLfloat)k) * (2.0f * GLUS_PI / LENGTH);
-
-        	phillipsSpectrumValue = phillipsSpectrum(AMPLITUDE, LPWA, waveDirection, windDirection);
-
-        	h0Data[i * 2 * N + k * 2 + 0] = 1.0f / sqrtf(2.0f) * glusRandomNormalf(0.0f, 1.0f) * phillipsSpectrumValue;
-        	h0Data[i * 2 * N + k * 2 + 1] = 1.0f / sqrtf(2.0f) * glusRandomNormalf(0.0f, 1.0f) * phillipsSpectrumValue;
-        }
-    }
-
     //
 
     glGenTextures(1, &g_textureH0);
     glBindTexture(GL_TEXTURE_2D, g_textureH0);
 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32F, N, N, 0, GL_RG, GL_FLOAT, h0Data);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32F, N, N, 0, GL_RG, GL_FLOAT, ocean.h0);
 
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
-    free(h0Data);
+    glusOceanDestroy(&ocean);
 
 
     glGenTextures(1, &g_textureHt);
@@ -653,6 +616,68 @@ GLUSvoid terminate(GLUSvoid)
     glusProgramDestroy(&g_program);
 }
 
+/**
+ * Simulates the ocean on the CPU and saves the displacement and normal map of each frame.
+ */
+static int runHeadless(const char* prefix, GLint frames)
+{
+	GLUSocean ocean;
+
+	GLfloat windDirection[2] = WIND_DIRECTION;
+
+	char displacementFilename[GLUS_MAX_FILENAME];
+	char normalFilename[GLUS_MAX_FILENAME];
+
+	GLfloat totalUpdateTime = 0.0f;
+
+	GLint frame;
+
+	if (strlen(prefix) + 24 >= GLUS_MAX_FILENAME)
+	{
+		printf("Prefix is too long!\n");
+		return -1;
+	}
+
+	if (!glusOceanCreate(&ocean, N, LENGTH, AMPLITUDE, WIND_SPEED, windDirection, 0))
+	{
+		printf("Could not create ocean!\n");
+		return -1;
+	}
+
+	for (frame = 0; frame < frames; frame++)
+	{
+		if (!glusOceanUpdate(&ocean, (GLfloat)frame / 60.0f))
+		{
+			printf("Could not update ocean!\n");
+			glusOceanDestroy(&ocean);
+			return -1;
+		}
+
+		totalUpdateTime += ocean.updateTime;
+
+		printf("Frame %d: %.2f ms\n", frame, ocean.updateTime * 1000.0f);
+
+		sprintf(displacementFilename, "%s_displacement_%04d.hdr", prefix, frame);
+		sprintf(normalFilename, "%s_normal_%04d.hdr", prefix, frame);
+
+		if (!glusOceanSaveHdr(displacementFilename, normalFilename, &ocean))
+		{
+			printf("Could not save ocean!\n");
+			glusOceanDestroy(&ocean);
+			return -1;
+		}
+	}
+
+	if (frames > 0)
+	{
+		printf("Average: %.2f ms\n", totalUpdateTime * 1000.0f / (GLfloat)frames);
+	}
+
+	glusOceanDestroy(&ocean);
+
+	return 0;
+}
+
 int main(int argc, char* argv[])
 {
 	EGLint eglConfigAttributes[] = {
@@ -676,6 +701,12 @@ int main(int argc, char* argv[])
     		EGL_NONE
     };
 
+    // Without a GPU, the ocean can be simulated on the CPU: Example41 prefix [frames]
+    if (argc > 1)
+    {
+    	return runHeadless(argv[1], argc > 2 ? atoi(argv[2]) : HEADLESS_FRAMES);
+    }
+
     glusWindowSetInitFunc(init);
 
     glusWindowSetReshapeFunc(reshape);
@@ -0,0 +1,210 @@
+/**
+ * OpenGL 4 - Example 46
+ *
+ * Benchmark of the fast fourier transform plans against the DFT and butterfly functions. No window is opened.
+ *
+ * @author	Norbert Nopper norbert@nopper.tv
+ *
+ * Homepage: http://nopper.tv
+ *
+ * Copyright Norbert Nopper
+ */
+
+#include <stdio.h>
+
+#include "GL/glus.h"
+
+#define MIN_N 64
+#define MAX_N 65536
+
+// The DFT builds a N x N matrix and the butterfly shuffle is quadratic, so both are only measured up to these sizes.
+#define MAX_N_DFT 1024
+#define MAX_N_BUTTERFLY 8192
+
+// Every transform is repeated, until this time in nanoseconds has passed.
+#define MEASURE_TIME 250000000
+
+#define TRANSFORM_DFT 0
+#define TRANSFORM_BUTTERFLY 1
+#define TRANSFORM_PLAN_C 2
+#define TRANSFORM_PLAN_F 3
+#define TRANSFORM_PLAN_REAL 4
+#define NUMBER_TRANSFORMS 5
+
+static const GLchar* g_transformNames[NUMBER_TRANSFORMS] = { "DFTc", "ButterflyFFTc", "PlanFFTc", "PlanFFTf", "PlanRealFFTf" };
+
+static GLUScomplex* g_vector = 0;
+static GLUScomplex* g_result = 0;
+
+static GLfloat* g_real = 0;
+static GLfloat* g_imaginary = 0;
+
+static GLfloat* g_realVector = 0;
+static GLfloat* g_resultReal = 0;
+static GLfloat* g_resultImaginary = 0;
+
+static GLUSfourierplan g_plan;
+
+static GLUSboolean transform(const GLint type, const GLint n, const GLint count)
+{
+	switch (type)
+	{
+		case TRANSFORM_DFT:
+			return glusFourierDFTc(g_result, g_vector, n);
+		case TRANSFORM_BUTTERFLY:
+			return glusFourierButterflyFFTc(g_result, g_vector, n);
+		case TRANSFORM_PLAN_C:
+			return glusFourierPlanFFTc(&g_plan, g_result, g_vector);
+		case TRANSFORM_PLAN_F:
+			// The transform runs in place. Alternating with the not scaled inverse keeps the values in range, as both cost the same.
+			if (count % 2 == 0)
+			{
+				return glusFourierPlanFFTf(&g_plan, g_real, g_imaginary);
+			}
+
+			return glusFourierPlanInverseFFTf(&g_plan, g_real, g_imaginary);
+		case TRANSFORM_PLAN_REAL:
+			return glusFourierPlanRealFFTf(&g_plan, g_resultReal, g_resultImaginary, g_realVector);
+	}
+
+	return GLUS_FALSE;
+}
+
+/**
+ * @return Microseconds per transform. Negative, if the transform failed.
+ */
+static GLdouble measure(const GLint type, const GLint n)
+{
+	GLUSuint64 start, now;
+
+	GLint count = 0;
+
+	// Warm up caches and the plan buffers.
+	if (!transform(type, n, 1))
+	{
+		return -1.0;
+	}
+
+	start = glusTimeGetTimestampNanoseconds();
+
+	do
+	{
+		if (!transform(type, n, count))
+		{
+			return -1.0;
+		}
+
+		count++;
+
+		now = glusTimeGetTimestampNanoseconds();
+	}
+	while (now - start < MEASURE_TIME);
+
+	return (GLdouble)(now - start) / 1000.0 / (GLdouble)count;
+}
+
+static GLvoid terminate(GLvoid)
+{
+	glusFourierDestroyPlan(&g_plan);
+
+	glusMemoryFree(g_vector);
+	glusMemoryFree(g_result);
+	glusMemoryFree(g_real);
+	glusMemoryFree(g_imaginary);
+	glusMemoryFree(g_realVector);
+	glusMemoryFree(g_resultReal);
+	glusMemoryFree(g_resultImaginary);
+}
+
+int main(GLvoid)
+{
+	GLint n, i, type;
+
+	GLdouble microseconds;
+
+	g_vector = (GLUScomplex*)glusMemoryMalloc(MAX_N * sizeof(GLUScomplex));
+	g_result = (GLUScomplex*)glusMemoryMalloc(MAX_N * sizeof(GLUScomplex));
+	g_real = (GLfloat*)glusMemoryMalloc(MAX_N * sizeof(GLfloat));
+	g_imaginary = (GLfloat*)glusMemoryMalloc(MAX_N * sizeof(GLfloat));
+	g_realVector = (GLfloat*)glusMemoryMalloc(MAX_N * sizeof(GLfloat));
+	g_resultReal = (GLfloat*)glusMemoryMalloc((MAX_N / 2 + 1) * sizeof(GLfloat));
+	g_resultImaginary = (GLfloat*)glusMemoryMalloc((MAX_N / 2 + 1) * sizeof(GLfloat));
+
+	if (!g_vector || !g_result || !g_real || !g_imaginary || !g_realVector || !g_resultReal || !g_resultImaginary)
+	{
+		printf("Could not allocate buffers\n");
+
+		terminate();
+
+		return -1;
+	}
+
+	glusRandomSetSeed(46);
+
+	printf("Microseconds per transform:\n\n");
+
+	printf("%8s", "n");
+
+	for (type = 0; type < NUMBER_TRANSFORMS; type++)
+	{
+		printf("%15s", g_transformNames[type]);
+	}
+
+	printf("\n");
+
+	for (n = MIN_N; n <= MAX_N; n *= 2)
+	{
+		for (i = 0; i < n; i++)
+		{
+			g_vector[i].real = glusRandomUniformf(-1.0f, 1.0f);
+			g_vector[i].imaginary = glusRandomUniformf(-1.0f, 1.0f);
+
+			g_real[i] = g_vector[i].real;
+			g_imaginary[i] = g_vector[i].imaginary;
+
+			g_realVector[i] = g_vector[i].real;
+		}
+
+		if (!glusFourierCreatePlan(&g_plan, n))
+		{
+			printf("Could not create plan for n = %d\n", n);
+
+			terminate();
+
+			return -1;
+		}
+
+		printf("%8d", n);
+
+		for (type = 0; type < NUMBER_TRANSFORMS; type++)
+		{
+			if ((type == TRANSFORM_DFT && n > MAX_N_DFT) || (type == TRANSFORM_BUTTERFLY && n > MAX_N_BUTTERFLY))
+			{
+				printf("%15s", "-");
+
+				continue;
+			}
+
+			microseconds = measure(type, n);
+
+			if (microseconds < 0.0)
+			{
+				printf("%15s", "failed");
+			}
+			else
+			{
+				printf("%15.2f", microseconds);
+			}
+
+			fflush(stdout);
+		}
+
+		printf("\n");
+
+		glusFourierDestroyPlan(&g_plan);
+	}
+
+	terminate();
+
+	return 0;
+}
@@ -0,0 +1,549 @@
+/**
+ * OpenGL 4 - Example 47
+ *
+ * Benchmark of the wavefront loader against the former fgets and sscanf based parser. No window is opened.
+ *
+ * @author	Norbert Nopper norbert@nopper.tv
+ *
+ * Homepage: http://nopper.tv
+ *
+ * Copyright Norbert Nopper
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "GL/glus.h"
+
+#define BUFFERSIZE 1024
+
+#define INITIAL_ATTRIBUTES 1024
+
+// Every load is repeated, until this time in nanoseconds has passed.
+#define MEASURE_TIME 250000000
+
+#define LOADER_FGETS 0
+#define LOADER_SCANNER 1
+#define NUMBER_LOADERS 2
+
+#define NUMBER_FILES 5
+
+static const GLchar* g_loaderNames[NUMBER_LOADERS] = { "fgets/sscanf", "Scanner" };
+
+static const GLchar* g_filenames[NUMBER_FILES] = { "monkey.obj", "teapot.obj", "bunny.obj", "elephant.obj", "venusm.obj" };
+
+static GLboolean growArray(GLfloat** array, GLuint* capacity, const GLuint required, const GLuint elements)
+{
+	GLfloat* newArray;
+
+	GLuint newCapacity = *capacity;
+
+	if (required <= *capacity)
+	{
+		return GL_TRUE;
+	}
+
+	while (newCapacity < required)
+	{
+		newCapacity *= 2;
+	}
+
+	newArray = (GLfloat*)glusMemoryMalloc(newCapacity * elements * sizeof(GLfloat));
+
+	if (!newArray)
+	{
+		return GL_FALSE;
+	}
+
+	memcpy(newArray, *array, *capacity * elements * sizeof(GLfloat));
+
+	glusMemoryFree(*array);
+
+	*array = newArray;
+	*capacity = newCapacity;
+
+	return GL_TRUE;
+}
+
+/**
+ * Appends one corner of a face. From the fourth corner on, the face is triangulated as a fan.
+ */
+static GLboolean appendCorner(GLfloat** triangleArray, GLuint* capacity, GLuint* total, const GLfloat* source, const GLuint edgeCount, const GLuint elements)
+{
+	if (edgeCount < 3)
+	{
+		if (!growArray(triangleArray, capacity, *total + 1, elements))
+		{
+			return GL_FALSE;
+		}
+
+		memcpy(&(*triangleArray)[elements * *total], source, elements * sizeof(GLfloat));
+
+		*total += 1;
+	}
+	else
+	{
+		if (!growArray(triangleArray, capacity, *total + 3, elements))
+		{
+			return GL_FALSE;
+		}
+
+		memcpy(&(*triangleArray)[elements * *total], &(*triangleArray)[elements * (*total - edgeCount)], elements * sizeof(GLfloat));
+		memcpy(&(*triangleArray)[elements * (*total + 1)], &(*triangleArray)[elements * (*total - 1)], elements * sizeof(GLfloat));
+		memcpy(&(*triangleArray)[elements * (*total + 2)], source, elements * sizeof(GLfloat));
+
+		*total += 3;
+	}
+
+	return GL_TRUE;
+}
+
+static GLboolean copyArray(GLfloat** destination, const GLfloat* source, const GLuint number, const GLuint elements)
+{
+	if (number == 0)
+	{
+		return GL_TRUE;
+	}
+
+	*destination = (GLfloat*)glusMemoryMalloc(number * elements * sizeof(GLfloat));
+
+	if (!*destination)
+	{
+		return GL_FALSE;
+	}
+
+	memcpy(*destination, source, number * elements * sizeof(GLfloat));
+
+	return GL_TRUE;
+}
+
+static GLvoid freeArrays(GLfloat** arrays)
+{
+	GLuint i;
+
+	for (i = 0; i < 6; i++)
+	{
+		glusMemoryFree(arrays[i]);
+
+		arrays[i] = 0;
+	}
+}
+
+/**
+ * The former line based parser of the shape path. Only the fixed attribute arrays are replaced by growing ones, so both loaders handle all files.
+ */
+static GLboolean loadWavefrontFgets(const GLchar* filename, GLUSshape* shape)
+{
+	FILE* f;
+
+	GLchar buffer[BUFFERSIZE];
+	GLchar identifier[7];
+
+	GLfloat* arrays[6] = { 0, 0, 0, 0, 0, 0 };
+	GLuint capacities[6] = { INITIAL_ATTRIBUTES, INITIAL_ATTRIBUTES, INITIAL_ATTRIBUTES, INITIAL_ATTRIBUTES, INITIAL_ATTRIBUTES, INITIAL_ATTRIBUTES };
+	static const GLuint elements[6] = { 4, 3, 2, 4, 3, 2 };
+
+	GLuint numberVertices = 0;
+	GLuint numberNormals = 0;
+	GLuint numberTexCoords = 0;
+
+	GLuint totalNumberVertices = 0;
+	GLuint totalNumberNormals = 0;
+	GLuint totalNumberTexCoords = 0;
+
+	GLuint facesEncoding = 0;
+
+	GLboolean result = GL_TRUE;
+
+	GLuint i;
+
+	memset(shape, 0, sizeof(GLUSshape));
+
+	for (i = 0; i < 6; i++)
+	{
+		arrays[i] = (GLfloat*)glusMemoryMalloc(capacities[i] * elements[i] * sizeof(GLfloat));
+
+		if (!arrays[i])
+		{
+			freeArrays(arrays);
+
+			return GL_FALSE;
+		}
+	}
+
+	f = fopen(filename, "r");
+
+	if (!f)
+	{
+		freeArrays(arrays);
+
+		return GL_FALSE;
+	}
+
+	while (result && fgets(buffer, BUFFERSIZE, f))
+	{
+		if (strncmp(buffer, "vt", 2) == 0)
+		{
+			if (!growArray(&arrays[2], &capacities[2], numberTexCoords + 1, 2))
+			{
+				result = GL_FALSE;
+
+				break;
+			}
+
+			sscanf(buffer, "%s %f %f", identifier, &arrays[2][2 * numberTexCoords + 0], &arrays[2][2 * numberTexCoords + 1]);
+
+			numberTexCoords++;
+		}
+		else if (strncmp(buffer, "vn", 2) == 0)
+		{
+			if (!growArray(&arrays[1], &capacities[1], numberNormals + 1, 3))
+			{
+				result = GL_FALSE;
+
+				break;
+			}
+
+			sscanf(buffer, "%s %f %f %f", identifier, &arrays[1][3 * numberNormals + 0], &arrays[1][3 * numberNormals + 1], &arrays[1][3 * numberNormals + 2]);
+
+			numberNormals++;
+		}
+		else if (strncmp(buffer, "v", 1) == 0)
+		{
+			if (!growArray(&arrays[0], &capacities[0], numberVertices + 1, 4))
+			{
+				result = GL_FALSE;
+
+				break;
+			}
+
+			sscanf(buffer, "%s %f %f %f", identifier, &arrays[0][4 * numberVertices + 0], &arrays[0][4 * numberVertices + 1], &arrays[0][4 * numberVertices + 2]);
+			arrays[0][4 * numberVertices + 3] = 1.0f;
+
+			numberVertices++;
+		}
+		else if (strncmp(buffer, "f", 1) == 0)
+		{
+			GLchar* token;
+
+			GLint vIndex, vtIndex, vnIndex;
+
+			GLuint edgeCount = 0;
+
+			token = strtok(buffer, " \t");
+			token = strtok(0, " \n");
+
+			if (!token)
+			{
+				continue;
+			}
+
+			if (strstr(token, "//") != 0)
+			{
+				facesEncoding = 2;
+			}
+			else if (strstr(token, "/") == 0)
+			{
+				facesEncoding = 0;
+			}
+			else if (strstr(strstr(token, "/") + 1, "/") == 0)
+			{
+				facesEncoding = 1;
+			}
+			else
+			{
+				facesEncoding = 3;
+			}
+
+			while (result && token != 0)
+			{
+				vIndex = -1;
+				vtIndex = -1;
+				vnIndex = -1;
+
+				switch (facesEncoding)
+				{
+					case 0:
+						sscanf(token, "%d", &vIndex);
+					break;
+					case 1:
+						sscanf(token, "%d/%d", &vIndex, &vtIndex);
+					break;
+					case 2:
+						sscanf(token, "%d//%d", &vIndex, &vnIndex);
+					break;
+					case 3:
+						sscanf(token, "%d/%d/%d", &vIndex, &vtIndex, &vnIndex);
+					break;
+				}
+
+				vIndex--;
+				vtIndex--;
+				vnIndex--;
+
+				if (vIndex >= 0 && (GLuint)vIndex < numberVertices)
+				{
+					if (!appendCorner(&arrays[3], &capacities[3], &totalNumberVertices, &arrays[0][4 * vIndex], edgeCount, 4))
+					{
+						result = GL_FALSE;
+					}
+				}
+				if (vnIndex >= 0 && (GLuint)vnIndex < numberNormals)
+				{
+					if (!appendCorner(&arrays[4], &capacities[4], &totalNumberNormals, &arrays[1][3 * vnIndex], edgeCount, 3))
+					{
+						result = GL_FALSE;
+					}
+				}
+				if (vtIndex >= 0 && (GLuint)vtIndex < numberTexCoords)
+				{
+					if (!appendCorner(&arrays[5], &capacities[5], &totalNumberTexCoords, &arrays[2][2 * vtIndex], edgeCount, 2))
+					{
+						result = GL_FALSE;
+					}
+				}
+
+				edgeCount++;
+
+				token = strtok(0, " \n");
+			}
+		}
+	}
+
+	fclose(f);
+
+	if (!result)
+	{
+		freeArrays(arrays);
+
+		return GL_FALSE;
+	}
+
+	// Same result as the former copy of the data: Not indexed triangles with tangents and bitangents.
+
+	shape->numberVertices = totalNumberVertices;
+	shape->numberIndices = totalNumberVertices;
+	shape->mode = GL_TRIANGLES;
+
+	shape->indices = (GLUSindex*)glusMemoryMalloc(totalNumberVertices * sizeof(GLUSindex));
+
+	if (!copyArray(&shape->vertices, arrays[3], totalNumberVertices, 4) || !copyArray(&shape->normals, arrays[4], totalNumberNormals, 3) || !copyArray(&shape->texCoords, arrays[5], totalNumberTexCoords, 2) || !shape->indices)
+	{
+		glusShapeDestroyf(shape);
+
+		freeArrays(arrays);
+
+		return GL_FALSE;
+	}
+
+	freeArrays(arrays);
+
+	for (i = 0; i < totalNumberVertices; i++)
+	{
+		shape->indices[i] = (GLUSindex)i;
+	}
+
+	glusShapeCalculateTangentBitangentf(shape);
+
+	return GL_TRUE;
+}
+
+static GLboolean load(const GLint loader, const GLchar* filename, GLUSshape* shape)
+{
+	switch (loader)
+	{
+		case LOADER_FGETS:
+			return loadWavefrontFgets(filename, shape);
+		case LOADER_SCANNER:
+			return glusShapeLoadWavefront(filename, shape);
+	}
+
+	return GL_FALSE;
+}
+
+/**
+ * @return Milliseconds per load. Negative, if the load failed.
+ */
+static GLdouble measure(const GLint loader, const GLchar* filename)
+{
+	GLUSuint64 start, now;
+
+	GLUSshape shape;
+
+	GLint count = 0;
+
+	// Warm up the file cache.
+	if (!load(loader, filename, &shape))
+	{
+		return -1.0;
+	}
+
+	glusShapeDestroyf(&shape);
+
+	start = glusTimeGetTimestampNanoseconds();
+
+	do
+	{
+		if (!load(loader, filename, &shape))
+		{
+			return -1.0;
+		}
+
+		glusShapeDestroyf(&shape);
+
+		count++;
+
+		now = glusTimeGetTimestampNanoseconds();
+	}
+	while (now - start < MEASURE_TIME);
+
+	return (GLdouble)(now - start) / 1000000.0 / (GLdouble)count;
+}
+
+static GLfloat maximumDifference(const GLfloat* a, const GLfloat* b, const GLuint number)
+{
+	GLfloat difference, result = 0.0f;
+
+	GLuint i;
+
+	if (!a || !b)
+	{
+		return a == b ? 0.0f : -1.0f;
+	}
+
+	for (i = 0; i < number; i++)
+	{
+		difference = a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+
+		if (difference > result)
+		{
+			result = difference;
+		}
+	}
+
+	return result;
+}
+
+/**
+ * @return The largest difference of the attributes of both loaders. Negative, if the shapes differ in their layout.
+ */
+static GLfloat compare(const GLchar* filename)
+{
+	GLUSshape reference, shape;
+
+	GLfloat difference, result = -1.0f;
+
+	if (!loadWavefrontFgets(filename, &reference))
+	{
+		return -1.0f;
+	}
+
+	if (!glusShapeLoadWavefront(filename, &shape))
+	{
+		glusShapeDestroyf(&reference);
+
+		return -1.0f;
+	}
+
+	if (reference.numberVertices == shape.numberVertices)
+	{
+		result = maximumDifference(reference.vertices, shape.vertices, 4 * shape.numberVertices);
+
+		difference = maximumDifference(reference.normals, shape.normals, 3 * shape.numberVertices);
+		result = difference < 0.0f || result < 0.0f ? -1.0f : (difference > result ? difference : result);
+
+		difference = maximumDifference(reference.texCoords, shape.texCoords, 2 * shape.numberVertices);
+		result = difference < 0.0f || result < 0.0f ? -1.0f : (difference > result ? difference : result);
+	}
+
+	glusShapeDestroyf(&reference);
+	glusShapeDestroyf(&shape);
+
+	return result;
+}
+
+static long fileSize(const GLchar* filename)
+{
+	FILE* f;
+
+	long size;
+
+	f = fopen(filename, "rb");
+
+	if (!f)
+	{
+		return -1;
+	}
+
+	fseek(f, 0, SEEK_END);
+	size = ftell(f);
+
+	fclose(f);
+
+	return size;
+}
+
+int main(GLvoid)
+{
+	GLint file, loader;
+
+	GLdouble milliseconds;
+
+	GLfloat difference;
+
+	long size;
+
+	printf("Milliseconds per load and megabytes per second of not indexed shapes:\n\n");
+
+	printf("%14s%10s", "File", "KB");
+
+	for (loader = 0; loader < NUMBER_LOADERS; loader++)
+	{
+		printf("%15s%10s", g_loaderNames[loader], "MB/s");
+	}
+
+	printf("%15s\n", "Max. diff.");
+
+	for (file = 0; file < NUMBER_FILES; file++)
+	{
+		size = fileSize(g_filenames[file]);
+
+		if (size < 0)
+		{
+			printf("%14s%10s\n", g_filenames[file], "missing");
+
+			continue;
+		}
+
+		printf("%14s%10ld", g_filenames[file], size / 1024);
+
+		for (loader = 0; loader < NUMBER_LOADERS; loader++)
+		{
+			milliseconds = measure(loader, g_filenames[file]);
+
+			if (milliseconds < 0.0)
+			{
+				printf("%15s%10s", "failed", "-");
+			}
+			else
+			{
+				printf("%15.2f%10.1f", milliseconds, (GLdouble)size / 1048576.0 / (milliseconds / 1000.0));
+			}
+
+			fflush(stdout);
+		}
+
+		difference = compare(g_filenames[file]);
+
+		if (difference < 0.0f)
+		{
+			printf("%15s\n", "mismatch");
+		}
+		else
+		{
+			printf("%15g\n", difference);
+		}
+	}
+
+	return 0;
+}
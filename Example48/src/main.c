@@ -0,0 +1,780 @@
+/**
+ * OpenGL 4 - Example 48
+ *
+ * Benchmark of the TGA and HDR image decoders against the former byte-wise decoders. No window is opened.
+ *
+ * @author	Norbert Nopper norbert@nopper.tv
+ *
+ * Homepage: http://nopper.tv
+ *
+ * Copyright Norbert Nopper
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "GL/glus.h"
+
+// Every load is repeated, until this time in nanoseconds has passed.
+#define MEASURE_TIME 250000000
+
+#define HDR_WIDTH 1024
+#define HDR_HEIGHT 512
+
+#define DECODER_BYTEWISE 0
+#define DECODER_MAPPED 1
+#define NUMBER_DECODERS 2
+
+#define NUMBER_TGA_FILES 5
+#define NUMBER_HDR_FILES 2
+
+static const GLchar* g_decoderNames[NUMBER_DECODERS] = { "Byte-wise", "Mapped" };
+
+static const GLchar* g_tgaFilenames[NUMBER_TGA_FILES] = { "ChessKing.tga", "four_shapes_color.tga", "ChessPawn.tga", "desert.tga", "wood_texture.tga" };
+
+// The tree has no HDR images, so both are generated. The first one is run length encoded, the second one is written by glusImageSaveHdr without encoding.
+static const GLchar* g_hdrFilenames[NUMBER_HDR_FILES] = { "benchmark_rle.hdr", "benchmark_flat.hdr" };
+
+/**
+ * The former TGA decoder without color maps: One read per run length packet and the repeated pixels copied byte by byte.
+ */
+static GLboolean loadTgaBytewise(const GLchar* filename, GLUStgaimage* tgaimage)
+{
+	FILE* file;
+
+	GLubyte header[18];
+	GLubyte amount, temp;
+
+	GLint bytesPerPixel, pixelsRead, i, k;
+
+	size_t size;
+
+	memset(tgaimage, 0, sizeof(GLUStgaimage));
+
+	file = fopen(filename, "rb");
+
+	if (!file)
+	{
+		return GL_FALSE;
+	}
+
+	if (fread(header, 1, 18, file) != 18 || (header[2] != 2 && header[2] != 3 && header[2] != 10 && header[2] != 11) || (header[16] != 8 && header[16] != 24 && header[16] != 32))
+	{
+		fclose(file);
+
+		return GL_FALSE;
+	}
+
+	tgaimage->width = (GLushort)(header[12] | header[13] << 8);
+	tgaimage->height = (GLushort)(header[14] | header[15] << 8);
+	tgaimage->depth = 1;
+	tgaimage->format = header[16] == 32 ? GL_RGBA : (header[16] == 24 ? GL_RGB : GLUS_SINGLE_CHANNEL);
+
+	bytesPerPixel = header[16] / 8;
+
+	size = (size_t)tgaimage->width * tgaimage->height * bytesPerPixel;
+
+	tgaimage->data = (GLubyte*)glusMemoryMalloc(size);
+
+	if (!tgaimage->data || fseek(file, header[0], SEEK_CUR))
+	{
+		fclose(file);
+
+		glusImageDestroyTga(tgaimage);
+
+		return GL_FALSE;
+	}
+
+	if (header[2] == 2 || header[2] == 3)
+	{
+		if (fread(tgaimage->data, 1, size, file) != size)
+		{
+			fclose(file);
+
+			glusImageDestroyTga(tgaimage);
+
+			return GL_FALSE;
+		}
+	}
+	else
+	{
+		pixelsRead = 0;
+
+		while (pixelsRead < tgaimage->width * tgaimage->height)
+		{
+			if (fread(&amount, 1, 1, file) != 1)
+			{
+				fclose(file);
+
+				glusImageDestroyTga(tgaimage);
+
+				return GL_FALSE;
+			}
+
+			if (amount & 0x80)
+			{
+				amount &= 0x7F;
+
+				amount++;
+
+				if (pixelsRead + amount > tgaimage->width * tgaimage->height || fread(&tgaimage->data[pixelsRead * bytesPerPixel], 1, bytesPerPixel, file) != (size_t)bytesPerPixel)
+				{
+					fclose(file);
+
+					glusImageDestroyTga(tgaimage);
+
+					return GL_FALSE;
+				}
+
+				for (i = 1; i < amount; i++)
+				{
+					for (k = 0; k < bytesPerPixel; k++)
+					{
+						tgaimage->data[(pixelsRead + i) * bytesPerPixel + k] = tgaimage->data[pixelsRead * bytesPerPixel + k];
+					}
+				}
+			}
+			else
+			{
+				amount &= 0x7F;
+
+				amount++;
+
+				if (pixelsRead + amount > tgaimage->width * tgaimage->height || fread(&tgaimage->data[pixelsRead * bytesPerPixel], 1, (size_t)amount * bytesPerPixel, file) != (size_t)amount * bytesPerPixel)
+				{
+					fclose(file);
+
+					glusImageDestroyTga(tgaimage);
+
+					return GL_FALSE;
+				}
+			}
+
+			pixelsRead += amount;
+		}
+	}
+
+	fclose(file);
+
+	if (bytesPerPixel >= 3)
+	{
+		for (i = 0; i < tgaimage->width * tgaimage->height * bytesPerPixel; i += bytesPerPixel)
+		{
+			temp = tgaimage->data[i];
+			tgaimage->data[i] = tgaimage->data[i + 2];
+			tgaimage->data[i + 2] = temp;
+		}
+	}
+
+	return GL_TRUE;
+}
+
+static GLvoid convertRGBE(GLfloat* rgb, const GLubyte* rgbe)
+{
+	GLfloat exponent = (GLfloat)(rgbe[3] - 128);
+
+	rgb[0] = (GLfloat)rgbe[0] / 256.0f * powf(2.0f, exponent);
+	rgb[1] = (GLfloat)rgbe[1] / 256.0f * powf(2.0f, exponent);
+	rgb[2] = (GLfloat)rgbe[2] / 256.0f * powf(2.0f, exponent);
+}
+
+static GLboolean decodeNewRLEBytewise(FILE* file, GLubyte* scanline, const GLint width)
+{
+	GLint channel, x;
+	GLubyte code, channelValue;
+
+	for (channel = 0; channel < 4; channel++)
+	{
+		x = 0;
+
+		while (x < width)
+		{
+			if (fread(&code, 1, 1, file) != 1)
+			{
+				return GL_FALSE;
+			}
+
+			if (code > 128)
+			{
+				code &= 127;
+
+				if (code > width - x || fread(&channelValue, 1, 1, file) != 1)
+				{
+					return GL_FALSE;
+				}
+
+				while (code--)
+				{
+					scanline[x++ * 4 + channel] = channelValue;
+				}
+			}
+			else
+			{
+				if (code > width - x)
+				{
+					return GL_FALSE;
+				}
+
+				while (code--)
+				{
+					if (fread(&channelValue, 1, 1, file) != 1)
+					{
+						return GL_FALSE;
+					}
+
+					scanline[x++ * 4 + channel] = channelValue;
+				}
+			}
+		}
+	}
+
+	return GL_TRUE;
+}
+
+/**
+ * The former HDR decoder: The header, the run length codes and every literal byte are read one by one.
+ * Bytes are read unsigned, as the former signed reads missed encoded scanlines of some widths.
+ */
+static GLboolean loadHdrBytewise(const GLchar* filename, GLUShdrimage* hdrimage)
+{
+	FILE* file;
+
+	GLchar buffer[256];
+	GLchar currentChar, oldChar;
+
+	GLint width, height, x, y, repeat, factor, i;
+
+	GLubyte* scanline;
+	GLubyte rgbe[4];
+	GLubyte prevRgbe[4] = { 0, 0, 0, 0 };
+
+	GLfloat rgb[3];
+
+	memset(hdrimage, 0, sizeof(GLUShdrimage));
+
+	file = fopen(filename, "rb");
+
+	if (!file)
+	{
+		return GL_FALSE;
+	}
+
+	if (fread(buffer, 1, 11, file) != 11 || strncmp(buffer, "#?RADIANCE", 10))
+	{
+		fclose(file);
+
+		return GL_FALSE;
+	}
+
+	currentChar = 0;
+
+	do
+	{
+		oldChar = currentChar;
+
+		if (fread(&currentChar, 1, 1, file) != 1)
+		{
+			fclose(file);
+
+			return GL_FALSE;
+		}
+	}
+	while (currentChar != '\n' || oldChar != '\n');
+
+	i = 0;
+
+	do
+	{
+		if (i == (GLint)sizeof(buffer) - 1 || fread(&currentChar, 1, 1, file) != 1)
+		{
+			fclose(file);
+
+			return GL_FALSE;
+		}
+
+		buffer[i++] = currentChar;
+	}
+	while (currentChar != '\n');
+
+	buffer[i] = 0;
+
+	if (sscanf(buffer, "-Y %d +X %d", &height, &width) != 2 || width <= 0 || height <= 0)
+	{
+		fclose(file);
+
+		return GL_FALSE;
+	}
+
+	hdrimage->width = (GLushort)width;
+	hdrimage->height = (GLushort)height;
+	hdrimage->depth = 1;
+	hdrimage->format = GL_RGB;
+
+	hdrimage->data = (GLfloat*)glusMemoryMalloc((size_t)width * height * 3 * sizeof(GLfloat));
+	scanline = (GLubyte*)glusMemoryMalloc((size_t)width * 4);
+
+	if (!hdrimage->data || !scanline)
+	{
+		glusMemoryFree(scanline);
+
+		fclose(file);
+
+		glusImageDestroyHdr(hdrimage);
+
+		return GL_FALSE;
+	}
+
+	factor = 1;
+	x = 0;
+	y = height - 1;
+
+	while (y >= 0)
+	{
+		if (fread(rgbe, 1, 4, file) != 4)
+		{
+			break;
+		}
+
+		if (width < 32768 && rgbe[0] == 2 && rgbe[1] == 2 && rgbe[2] == ((width >> 8) & 0xFF) && rgbe[3] == (width & 0xFF))
+		{
+			if (!decodeNewRLEBytewise(file, scanline, width))
+			{
+				break;
+			}
+
+			for (i = 0; i < width; i++)
+			{
+				convertRGBE(&hdrimage->data[(width * y + i) * 3], &scanline[i * 4]);
+			}
+
+			y--;
+
+			factor = 1;
+
+			memcpy(prevRgbe, &scanline[(width - 1) * 4], 4);
+
+			continue;
+		}
+		else if (rgbe[0] == 1 && rgbe[1] == 1 && rgbe[2] == 1)
+		{
+			repeat = rgbe[3] * factor;
+
+			memcpy(rgbe, prevRgbe, 4);
+
+			factor *= 256;
+		}
+		else
+		{
+			repeat = 1;
+
+			factor = 1;
+		}
+
+		convertRGBE(rgb, rgbe);
+
+		while (repeat-- && y >= 0)
+		{
+			memcpy(&hdrimage->data[(width * y + x) * 3], rgb, 3 * sizeof(GLfloat));
+
+			x++;
+			if (x >= width)
+			{
+				y--;
+				x = 0;
+			}
+		}
+
+		memcpy(prevRgbe, rgbe, 4);
+	}
+
+	glusMemoryFree(scanline);
+
+	fclose(file);
+
+	if (y >= 0)
+	{
+		glusImageDestroyHdr(hdrimage);
+
+		return GL_FALSE;
+	}
+
+	return GL_TRUE;
+}
+
+/**
+ * Sky like gradient with a flat ground and a noisy band, so runs and literals of several lengths occur.
+ */
+static GLvoid createHdrPixels(GLUShdrimage* hdrimage)
+{
+	GLint x, y;
+
+	GLfloat* pixel;
+
+	for (y = 0; y < hdrimage->height; y++)
+	{
+		for (x = 0; x < hdrimage->width; x++)
+		{
+			pixel = &hdrimage->data[(y * hdrimage->width + x) * 3];
+
+			if (y < hdrimage->height / 3)
+			{
+				pixel[0] = 0.2f;
+				pixel[1] = 0.15f;
+				pixel[2] = 0.1f;
+			}
+			else if (y < hdrimage->height / 2)
+			{
+				pixel[0] = glusRandomUniformf(0.0f, 4.0f);
+				pixel[1] = glusRandomUniformf(0.0f, 4.0f);
+				pixel[2] = glusRandomUniformf(0.0f, 4.0f);
+			}
+			else
+			{
+				pixel[0] = 0.5f + (GLfloat)(x / 64) * 0.5f;
+				pixel[1] = 0.7f + (GLfloat)(x / 64) * 0.5f;
+				pixel[2] = 1.0f + (GLfloat)y / (GLfloat)hdrimage->height * 16.0f;
+			}
+		}
+	}
+}
+
+static GLvoid convertRGB(GLubyte* rgbe, const GLfloat* rgb)
+{
+	GLfloat maximum = rgb[0] > rgb[1] ? rgb[0] : rgb[1];
+	GLfloat scale;
+
+	GLint exponent;
+
+	maximum = rgb[2] > maximum ? rgb[2] : maximum;
+
+	if (maximum < 1e-32f)
+	{
+		memset(rgbe, 0, 4);
+
+		return;
+	}
+
+	scale = frexpf(maximum, &exponent) * 256.0f / maximum;
+
+	rgbe[0] = (GLubyte)(rgb[0] * scale);
+	rgbe[1] = (GLubyte)(rgb[1] * scale);
+	rgbe[2] = (GLubyte)(rgb[2] * scale);
+	rgbe[3] = (GLubyte)(exponent + 128);
+}
+
+/**
+ * Writes the image with the run length encoding of the Radiance scanlines, as most HDR files are stored.
+ */
+static GLboolean saveHdrRle(const GLchar* filename, const GLUShdrimage* hdrimage)
+{
+	FILE* file;
+
+	GLubyte* scanline;
+	GLubyte* component;
+	GLubyte code[2];
+
+	GLint x, y, channel, run, literal;
+
+	GLboolean result = GL_TRUE;
+
+	file = fopen(filename, "wb");
+
+	if (!file)
+	{
+		return GL_FALSE;
+	}
+
+	scanline = (GLubyte*)glusMemoryMalloc((size_t)hdrimage->width * 4);
+
+	if (!scanline)
+	{
+		fclose(file);
+
+		return GL_FALSE;
+	}
+
+	fprintf(file, "#?RADIANCE\nFORMAT=32-bit_rle_rgbe\n\n-Y %d +X %d\n", hdrimage->height, hdrimage->width);
+
+	// The first scanline in the file is the top one.
+	for (y = hdrimage->height - 1; y >= 0 && result; y--)
+	{
+		for (x = 0; x < hdrimage->width; x++)
+		{
+			GLubyte rgbe[4];
+
+			convertRGB(rgbe, &hdrimage->data[(y * hdrimage->width + x) * 3]);
+
+			for (channel = 0; channel < 4; channel++)
+			{
+				scanline[channel * hdrimage->width + x] = rgbe[channel];
+			}
+		}
+
+		fputc(2, file);
+		fputc(2, file);
+		fputc((hdrimage->width >> 8) & 0xFF, file);
+		fputc(hdrimage->width & 0xFF, file);
+
+		for (channel = 0; channel < 4; channel++)
+		{
+			component = &scanline[channel * hdrimage->width];
+
+			x = 0;
+
+			while (x < hdrimage->width)
+			{
+				run = 1;
+
+				while (x + run < hdrimage->width && run < 127 && component[x + run] == component[x])
+				{
+					run++;
+				}
+
+				if (run > 2)
+				{
+					code[0] = (GLubyte)(128 + run);
+					code[1] = component[x];
+
+					fwrite(code, 1, 2, file);
+
+					x += run;
+
+					continue;
+				}
+
+				// Literals up to the next run of at least three values.
+				literal = 1;
+
+				while (x + literal < hdrimage->width && literal < 128 && !(x + literal + 2 < hdrimage->width && component[x + literal] == component[x + literal + 1] && component[x + literal] == component[x + literal + 2]))
+				{
+					literal++;
+				}
+
+				code[0] = (GLubyte)literal;
+
+				fwrite(code, 1, 1, file);
+				fwrite(&component[x], 1, literal, file);
+
+				x += literal;
+			}
+		}
+
+		result = !ferror(file);
+	}
+
+	glusMemoryFree(scanline);
+
+	fclose(file);
+
+	return result;
+}
+
+static GLboolean loadImage(const GLint decoder, const GLboolean hdr, const GLchar* filename, GLUStgaimage* tgaimage, GLUShdrimage* hdrimage)
+{
+	if (hdr)
+	{
+		return decoder == DECODER_BYTEWISE ? loadHdrBytewise(filename, hdrimage) : glusImageLoadHdr(filename, hdrimage);
+	}
+
+	return decoder == DECODER_BYTEWISE ? loadTgaBytewise(filename, tgaimage) : glusImageLoadTga(filename, tgaimage);
+}
+
+static GLvoid destroyImage(const GLboolean hdr, GLUStgaimage* tgaimage, GLUShdrimage* hdrimage)
+{
+	if (hdr)
+	{
+		glusImageDestroyHdr(hdrimage);
+	}
+	else
+	{
+		glusImageDestroyTga(tgaimage);
+	}
+}
+
+/**
+ * @return Milliseconds per load. Negative, if the load failed.
+ */
+static GLdouble measure(const GLint decoder, const GLboolean hdr, const GLchar* filename)
+{
+	GLUSuint64 start, now;
+
+	GLUStgaimage tgaimage;
+	GLUShdrimage hdrimage;
+
+	GLint count = 0;
+
+	// Warm up the file cache.
+	if (!loadImage(decoder, hdr, filename, &tgaimage, &hdrimage))
+	{
+		return -1.0;
+	}
+
+	destroyImage(hdr, &tgaimage, &hdrimage);
+
+	start = glusTimeGetTimestampNanoseconds();
+
+	do
+	{
+		if (!loadImage(decoder, hdr, filename, &tgaimage, &hdrimage))
+		{
+			return -1.0;
+		}
+
+		destroyImage(hdr, &tgaimage, &hdrimage);
+
+		count++;
+
+		now = glusTimeGetTimestampNanoseconds();
+	}
+	while (now - start < MEASURE_TIME);
+
+	return (GLdouble)(now - start) / 1000000.0 / (GLdouble)count;
+}
+
+static GLboolean identical(const GLboolean hdr, const GLchar* filename)
+{
+	GLUStgaimage tgaimages[NUMBER_DECODERS];
+	GLUShdrimage hdrimages[NUMBER_DECODERS];
+
+	GLboolean result;
+
+	if (!loadImage(DECODER_BYTEWISE, hdr, filename, &tgaimages[0], &hdrimages[0]))
+	{
+		return GL_FALSE;
+	}
+
+	if (!loadImage(DECODER_MAPPED, hdr, filename, &tgaimages[1], &hdrimages[1]))
+	{
+		destroyImage(hdr, &tgaimages[0], &hdrimages[0]);
+
+		return GL_FALSE;
+	}
+
+	if (hdr)
+	{
+		result = hdrimages[0].width == hdrimages[1].width && hdrimages[0].height == hdrimages[1].height && memcmp(hdrimages[0].data, hdrimages[1].data, (size_t)hdrimages[0].width * hdrimages[0].height * 3 * sizeof(GLfloat)) == 0;
+	}
+	else
+	{
+		result = tgaimages[0].width == tgaimages[1].width && tgaimages[0].height == tgaimages[1].height && tgaimages[0].format == tgaimages[1].format && memcmp(tgaimages[0].data, tgaimages[1].data, (size_t)tgaimages[0].width * tgaimages[0].height * (tgaimages[0].format == GL_RGBA ? 4 : (tgaimages[0].format == GL_RGB ? 3 : 1))) == 0;
+	}
+
+	destroyImage(hdr, &tgaimages[0], &hdrimages[0]);
+	destroyImage(hdr, &tgaimages[1], &hdrimages[1]);
+
+	return result;
+}
+
+static long fileSize(const GLchar* filename)
+{
+	FILE* f;
+
+	long size;
+
+	f = fopen(filename, "rb");
+
+	if (!f)
+	{
+		return -1;
+	}
+
+	fseek(f, 0, SEEK_END);
+	size = ftell(f);
+
+	fclose(f);
+
+	return size;
+}
+
+static GLvoid printFile(const GLboolean hdr, const GLchar* filename)
+{
+	GLint decoder;
+
+	GLdouble milliseconds;
+
+	long size;
+
+	size = fileSize(filename);
+
+	if (size < 0)
+	{
+		printf("%22s%10s\n", filename, "missing");
+
+		return;
+	}
+
+	printf("%22s%10ld", filename, size / 1024);
+
+	for (decoder = 0; decoder < NUMBER_DECODERS; decoder++)
+	{
+		milliseconds = measure(decoder, hdr, filename);
+
+		if (milliseconds < 0.0)
+		{
+			printf("%12s%10s", "failed", "-");
+		}
+		else
+		{
+			printf("%12.2f%10.1f", milliseconds, (GLdouble)size / 1048576.0 / (milliseconds / 1000.0));
+		}
+
+		fflush(stdout);
+	}
+
+	printf("%12s\n", identical(hdr, filename) ? "yes" : "no");
+}
+
+int main(GLvoid)
+{
+	GLUShdrimage hdrimage;
+
+	GLint file, decoder;
+
+	if (!glusImageCreateHdr(&hdrimage, HDR_WIDTH, HDR_HEIGHT, 1, GL_RGB))
+	{
+		printf("Could not create HDR image\n");
+
+		return -1;
+	}
+
+	glusRandomSetSeed(48);
+
+	createHdrPixels(&hdrimage);
+
+	if (!saveHdrRle(g_hdrFilenames[0], &hdrimage) || !glusImageSaveHdr(g_hdrFilenames[1], &hdrimage))
+	{
+		printf("Could not write HDR images\n");
+
+		glusImageDestroyHdr(&hdrimage);
+
+		return -1;
+	}
+
+	glusImageDestroyHdr(&hdrimage);
+
+	printf("Milliseconds per load and megabytes of the file per second:\n\n");
+
+	printf("%22s%10s", "File", "KB");
+
+	for (decoder = 0; decoder < NUMBER_DECODERS; decoder++)
+	{
+		printf("%12s%10s", g_decoderNames[decoder], "MB/s");
+	}
+
+	printf("%12s\n", "Identical");
+
+	for (file = 0; file < NUMBER_TGA_FILES; file++)
+	{
+		printFile(GL_FALSE, g_tgaFilenames[file]);
+	}
+
+	for (file = 0; file < NUMBER_HDR_FILES; file++)
+	{
+		printFile(GL_TRUE, g_hdrFilenames[file]);
+
+		glusFileRemove(g_hdrFilenames[file]);
+	}
+
+	return 0;
+}
@@ -0,0 +1,238 @@
+/**
+ * OpenGL 4 - Example 49
+ *
+ * Benchmark of the job system: Cost of a single job, of a dependency chain and of a parallel for on the workers compared to own threads per call. No window is opened.
+ *
+ * @author	Norbert Nopper norbert@nopper.tv
+ *
+ * Homepage: http://nopper.tv
+ *
+ * Copyright Norbert Nopper
+ */
+
+#include <stdio.h>
+
+#include "GL/glus.h"
+
+// Every benchmark is repeated, until this time in nanoseconds has passed.
+#define MEASURE_TIME 250000000
+
+#define NUMBER_BATCH_JOBS 256
+
+#define CHAIN_LENGTH 256
+
+#define PARALLEL_COUNT 65536
+
+#define BENCHMARK_SINGLE 0
+#define BENCHMARK_BATCH 1
+#define BENCHMARK_CHAIN 2
+#define BENCHMARK_PARALLEL_FOR 3
+#define NUMBER_BENCHMARKS 4
+
+static const GLchar* g_benchmarkNames[NUMBER_BENCHMARKS] = { "Create, submit and wait one job", "Submit 256 jobs, then wait", "Chain of 256 dependent jobs", "Parallel for of 65536 indices" };
+
+// Number of operations one benchmark call measures, so the time per job or per call is printed.
+static const GLint g_operations[NUMBER_BENCHMARKS] = { 1, NUMBER_BATCH_JOBS, CHAIN_LENGTH, 1 };
+
+static const GLchar* g_operationNames[NUMBER_BENCHMARKS] = { "job", "job", "job", "call" };
+
+static GLUSjob g_jobs[NUMBER_BATCH_JOBS > CHAIN_LENGTH ? NUMBER_BATCH_JOBS : CHAIN_LENGTH];
+
+static GLfloat g_values[PARALLEL_COUNT];
+
+static GLvoid emptyJob(GLvoid* data)
+{
+	(void)data;
+}
+
+static GLvoid chainJob(GLvoid* data)
+{
+	// Each job continues the work of its dependency, so a wrong order changes the result.
+	*(GLuint*)data = *(GLuint*)data * 3 + 1;
+}
+
+static GLvoid scaleRange(GLvoid* data, const GLint begin, const GLint end)
+{
+	GLint i;
+
+	for (i = begin; i < end; i++)
+	{
+		g_values[i] = g_values[i] * 0.5f + *(GLfloat*)data;
+	}
+}
+
+static GLboolean runSingle(GLvoid)
+{
+	if (!glusJobCreate(&g_jobs[0], emptyJob, 0, GLUS_FALSE) || !glusJobSubmit(&g_jobs[0]))
+	{
+		glusJobRelease(&g_jobs[0]);
+
+		return GL_FALSE;
+	}
+
+	glusJobWait(&g_jobs[0]);
+
+	return GL_TRUE;
+}
+
+static GLboolean runBatch(GLvoid)
+{
+	GLint i, numberJobs;
+
+	GLboolean result = GL_TRUE;
+
+	for (numberJobs = 0; numberJobs < NUMBER_BATCH_JOBS; numberJobs++)
+	{
+		if (!glusJobCreate(&g_jobs[numberJobs], emptyJob, 0, GLUS_FALSE) || !glusJobSubmit(&g_jobs[numberJobs]))
+		{
+			glusJobRelease(&g_jobs[numberJobs]);
+
+			result = GL_FALSE;
+
+			break;
+		}
+	}
+
+	for (i = 0; i < numberJobs; i++)
+	{
+		glusJobWait(&g_jobs[i]);
+	}
+
+	return result;
+}
+
+static GLboolean runChain(GLvoid)
+{
+	GLint i;
+
+	GLuint value = 0, expected = 0;
+
+	for (i = 0; i < CHAIN_LENGTH; i++)
+	{
+		if (!glusJobCreate(&g_jobs[i], chainJob, &value, GLUS_FALSE) || (i > 0 && !glusJobAddDependency(&g_jobs[i], &g_jobs[i - 1])))
+		{
+			while (i >= 0)
+			{
+				glusJobRelease(&g_jobs[i--]);
+			}
+
+			return GL_FALSE;
+		}
+
+		expected = expected * 3 + 1;
+	}
+
+	// Submitting from the end, so every job really has to wait for its dependency.
+	for (i = CHAIN_LENGTH - 1; i >= 0; i--)
+	{
+		glusJobSubmit(&g_jobs[i]);
+	}
+
+	glusJobWait(&g_jobs[CHAIN_LENGTH - 1]);
+
+	for (i = 0; i < CHAIN_LENGTH - 1; i++)
+	{
+		glusJobRelease(&g_jobs[i]);
+	}
+
+	return value == expected;
+}
+
+static GLboolean runParallelFor(GLvoid)
+{
+	GLfloat offset = 1.0f;
+
+	return glusJobParallelFor(PARALLEL_COUNT, 0, scaleRange, &offset);
+}
+
+static GLboolean run(const GLint benchmark)
+{
+	switch (benchmark)
+	{
+		case BENCHMARK_SINGLE:
+			return runSingle();
+		case BENCHMARK_BATCH:
+			return runBatch();
+		case BENCHMARK_CHAIN:
+			return runChain();
+		case BENCHMARK_PARALLEL_FOR:
+			return runParallelFor();
+	}
+
+	return GL_FALSE;
+}
+
+/**
+ * @return Microseconds per operation. Negative, if the benchmark failed.
+ */
+static GLdouble measure(const GLint benchmark)
+{
+	GLUSuint64 start, now;
+
+	GLint count = 0;
+
+	// Warm up the queues and the allocator.
+	if (!run(benchmark))
+	{
+		return -1.0;
+	}
+
+	start = glusTimeGetTimestampNanoseconds();
+
+	do
+	{
+		if (!run(benchmark))
+		{
+			return -1.0;
+		}
+
+		count++;
+
+		now = glusTimeGetTimestampNanoseconds();
+	}
+	while (now - start < MEASURE_TIME);
+
+	return (GLdouble)(now - start) / 1000.0 / (GLdouble)count / (GLdouble)g_operations[benchmark];
+}
+
+static GLvoid printResult(const GLchar* name, const GLchar* operation, const GLdouble microseconds)
+{
+	if (microseconds < 0.0)
+	{
+		printf("%-50s%15s\n", name, "failed");
+	}
+	else
+	{
+		printf("%-50s%15.3f us per %s\n", name, microseconds, operation);
+	}
+
+	fflush(stdout);
+}
+
+int main(GLvoid)
+{
+	GLint benchmark;
+
+	// Without the job system, the parallel for starts own threads on every call.
+	printf("Without job system, %d processors:\n\n", glusThreadGetNumberProcessors());
+
+	printResult(g_benchmarkNames[BENCHMARK_PARALLEL_FOR], g_operationNames[BENCHMARK_PARALLEL_FOR], measure(BENCHMARK_PARALLEL_FOR));
+
+	if (!glusJobSystemCreate(0))
+	{
+		printf("Could not create job system\n");
+
+		return -1;
+	}
+
+	printf("\nJob system with %d worker threads:\n\n", glusJobSystemGetNumberThreads());
+
+	for (benchmark = 0; benchmark < NUMBER_BENCHMARKS; benchmark++)
+	{
+		printResult(g_benchmarkNames[benchmark], g_operationNames[benchmark], measure(benchmark));
+	}
+
+	glusJobSystemDestroy();
+
+	return 0;
+}
@@ -0,0 +1,311 @@
+/**
+ * OpenGL 4 - Example 50
+ *
+ * Benchmark of the batch functions against calling the scalar functions for every item. No window is opened.
+ *
+ * @author	Norbert Nopper norbert@nopper.tv
+ *
+ * Homepage: http://nopper.tv
+ *
+ * Copyright Norbert Nopper
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "GL/glus.h"
+
+// Not a multiple of the vector width, so the remaining items are processed as well.
+#define NUMBER_ITEMS 4099
+
+// The slerp error is measured on more pairs than benchmarked.
+#define NUMBER_ERROR_ROUNDS 256
+
+// Every function is repeated, until this time in nanoseconds has passed.
+#define MEASURE_TIME 250000000
+
+#define FUNCTION_MULTIPLY 0
+#define FUNCTION_POINT 1
+#define FUNCTION_PLANE 2
+#define FUNCTION_NORMALIZE 3
+#define FUNCTION_SLERP 4
+#define NUMBER_FUNCTIONS 5
+
+static const GLchar* g_functionNames[NUMBER_FUNCTIONS] = { "Matrix * matrix", "Matrix * point", "Matrix * plane", "Normalize", "Slerp" };
+
+static GLfloat g_matrices0[NUMBER_ITEMS * 16];
+static GLfloat g_matrices1[NUMBER_ITEMS * 16];
+
+static GLfloat g_matrix[16];
+
+static GLfloat g_vectors[NUMBER_ITEMS * 4];
+
+static GLfloat g_quaternions0[NUMBER_ITEMS * 4];
+static GLfloat g_quaternions1[NUMBER_ITEMS * 4];
+static GLfloat g_t[NUMBER_ITEMS];
+
+static GLfloat g_scalarResult[NUMBER_ITEMS * 16];
+static GLfloat g_batchResult[NUMBER_ITEMS * 16];
+
+// Number of floats per result item.
+static const GLint g_resultSize[NUMBER_FUNCTIONS] = { 16, 4, 4, 3, 4 };
+
+static GLvoid runScalar(const GLint function)
+{
+	GLint i;
+
+	switch (function)
+	{
+		case FUNCTION_MULTIPLY:
+			for (i = 0; i < NUMBER_ITEMS; i++)
+			{
+				glusMatrix4x4Multiplyf(&g_scalarResult[i * 16], &g_matrices0[i * 16], &g_matrices1[i * 16]);
+			}
+		break;
+		case FUNCTION_POINT:
+			for (i = 0; i < NUMBER_ITEMS; i++)
+			{
+				glusMatrix4x4MultiplyPoint4f(&g_scalarResult[i * 4], g_matrix, &g_vectors[i * 4]);
+			}
+		break;
+		case FUNCTION_PLANE:
+			for (i = 0; i < NUMBER_ITEMS; i++)
+			{
+				glusMatrix4x4MultiplyPlanef(&g_scalarResult[i * 4], g_matrix, &g_vectors[i * 4]);
+			}
+		break;
+		case FUNCTION_NORMALIZE:
+			// Normalizing in place, so the vectors are copied first. The batch function does the same.
+			memcpy(g_scalarResult, g_vectors, NUMBER_ITEMS * 3 * sizeof(GLfloat));
+
+			for (i = 0; i < NUMBER_ITEMS; i++)
+			{
+				glusVector3Normalizef(&g_scalarResult[i * 3]);
+			}
+		break;
+		case FUNCTION_SLERP:
+			for (i = 0; i < NUMBER_ITEMS; i++)
+			{
+				glusQuaternionSlerpf(&g_scalarResult[i * 4], &g_quaternions0[i * 4], &g_quaternions1[i * 4], g_t[i]);
+			}
+		break;
+	}
+}
+
+static GLvoid runBatch(const GLint function)
+{
+	switch (function)
+	{
+		case FUNCTION_MULTIPLY:
+			glusBatchMatrix4x4Multiplyf(g_batchResult, g_matrices0, g_matrices1, NUMBER_ITEMS);
+		break;
+		case FUNCTION_POINT:
+			glusBatchMatrix4x4MultiplyPoint4f(g_batchResult, g_matrix, g_vectors, NUMBER_ITEMS);
+		break;
+		case FUNCTION_PLANE:
+			glusBatchMatrix4x4MultiplyPlanef(g_batchResult, g_matrix, g_vectors, NUMBER_ITEMS);
+		break;
+		case FUNCTION_NORMALIZE:
+			memcpy(g_batchResult, g_vectors, NUMBER_ITEMS * 3 * sizeof(GLfloat));
+
+			glusBatchVector3Normalizef(g_batchResult, NUMBER_ITEMS);
+		break;
+		case FUNCTION_SLERP:
+			glusBatchQuaternionSlerpf(g_batchResult, g_quaternions0, g_quaternions1, g_t, NUMBER_ITEMS);
+		break;
+	}
+}
+
+/**
+ * @return Nanoseconds per item.
+ */
+static GLdouble measure(const GLint function, const GLboolean batch)
+{
+	GLUSuint64 start, now;
+
+	GLint count = 0;
+
+	start = glusTimeGetTimestampNanoseconds();
+
+	do
+	{
+		if (batch)
+		{
+			runBatch(function);
+		}
+		else
+		{
+			runScalar(function);
+		}
+
+		count++;
+
+		now = glusTimeGetTimestampNanoseconds();
+	}
+	while (now - start < MEASURE_TIME);
+
+	return (GLdouble)(now - start) / (GLdouble)count / (GLdouble)NUMBER_ITEMS;
+}
+
+static GLfloat maximumDifference(const GLint function)
+{
+	GLfloat difference, result = 0.0f;
+
+	GLint i;
+
+	for (i = 0; i < NUMBER_ITEMS * g_resultSize[function]; i++)
+	{
+		difference = g_scalarResult[i] > g_batchResult[i] ? g_scalarResult[i] - g_batchResult[i] : g_batchResult[i] - g_scalarResult[i];
+
+		if (difference > result)
+		{
+			result = difference;
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Largest difference of the scalar and the batch slerp to slerp calculated with double precision.
+ */
+static GLvoid slerpErrors(GLdouble* scalarError, GLdouble* batchError)
+{
+	GLdouble cosAlpha, alpha, sinAlpha, a, b, reference, error;
+
+	GLint i, k;
+
+	for (i = 0; i < NUMBER_ITEMS; i++)
+	{
+		cosAlpha = 0.0;
+
+		for (k = 0; k < 4; k++)
+		{
+			cosAlpha += (GLdouble)g_quaternions0[i * 4 + k] * (GLdouble)g_quaternions1[i * 4 + k];
+		}
+
+		alpha = acos(cosAlpha < -1.0 ? -1.0 : (cosAlpha > 1.0 ? 1.0 : cosAlpha));
+		sinAlpha = sin(alpha);
+
+		if (sinAlpha == 0.0)
+		{
+			continue;
+		}
+
+		a = sin(alpha * (1.0 - g_t[i])) / sinAlpha;
+		b = sin(alpha * g_t[i]) / sinAlpha;
+
+		for (k = 0; k < 4; k++)
+		{
+			reference = a * g_quaternions0[i * 4 + k] + b * g_quaternions1[i * 4 + k];
+
+			error = fabs(g_scalarResult[i * 4 + k] - reference);
+			*scalarError = error > *scalarError ? error : *scalarError;
+
+			error = fabs(g_batchResult[i * 4 + k] - reference);
+			*batchError = error > *batchError ? error : *batchError;
+		}
+	}
+}
+
+static GLvoid createRandomQuaternions(GLvoid)
+{
+	GLint i, k;
+
+	for (i = 0; i < NUMBER_ITEMS; i++)
+	{
+		for (k = 0; k < 4; k++)
+		{
+			g_quaternions0[i * 4 + k] = glusRandomUniformf(-1.0f, 1.0f);
+			g_quaternions1[i * 4 + k] = glusRandomUniformf(-1.0f, 1.0f);
+		}
+
+		glusQuaternionNormalizef(&g_quaternions0[i * 4]);
+		glusQuaternionNormalizef(&g_quaternions1[i * 4]);
+
+		g_t[i] = glusRandomUniformf(0.0f, 1.0f);
+	}
+}
+
+int main(GLvoid)
+{
+	GLint function, i;
+
+	GLdouble scalarTime, batchTime;
+
+	GLfloat difference, slerpDifference;
+
+	GLdouble scalarError = 0.0, batchError = 0.0;
+
+	glusRandomSetSeed(50);
+
+	for (i = 0; i < NUMBER_ITEMS * 16; i++)
+	{
+		g_matrices0[i] = glusRandomUniformf(-1.0f, 1.0f);
+		g_matrices1[i] = glusRandomUniformf(-1.0f, 1.0f);
+	}
+
+	glusMatrix4x4Identityf(g_matrix);
+	glusMatrix4x4RotateRzRxRyf(g_matrix, 30.0f, 45.0f, 60.0f);
+	glusMatrix4x4Translatef(g_matrix, 1.0f, 2.0f, 3.0f);
+
+	for (i = 0; i < NUMBER_ITEMS; i++)
+	{
+		g_vectors[i * 4 + 0] = glusRandomUniformf(-10.0f, 10.0f);
+		g_vectors[i * 4 + 1] = glusRandomUniformf(-10.0f, 10.0f);
+		g_vectors[i * 4 + 2] = glusRandomUniformf(-10.0f, 10.0f);
+		g_vectors[i * 4 + 3] = 1.0f;
+	}
+
+	createRandomQuaternions();
+
+	printf("Instruction set: %s\n\n", glusBatchGetInstructionSet());
+
+	printf("Nanoseconds per item of %d items:\n\n", NUMBER_ITEMS);
+
+	printf("%18s%12s%12s%10s%15s\n", "Function", "Scalar", "Batch", "Speedup", "Max. diff.");
+
+	for (function = 0; function < NUMBER_FUNCTIONS; function++)
+	{
+		runScalar(function);
+		runBatch(function);
+
+		difference = maximumDifference(function);
+
+		scalarTime = measure(function, GL_FALSE);
+		batchTime = measure(function, GL_TRUE);
+
+		printf("%18s%12.2f%12.2f%10.2f%15g\n", g_functionNames[function], scalarTime, batchTime, scalarTime / batchTime, difference);
+
+		fflush(stdout);
+	}
+
+	// The polynomials of the batch slerp are checked on more random pairs.
+	slerpDifference = 0.0f;
+
+	for (i = 0; i < NUMBER_ERROR_ROUNDS; i++)
+	{
+		createRandomQuaternions();
+
+		runScalar(FUNCTION_SLERP);
+		runBatch(FUNCTION_SLERP);
+
+		difference = maximumDifference(FUNCTION_SLERP);
+
+		if (difference > slerpDifference)
+		{
+			slerpDifference = difference;
+		}
+
+		slerpErrors(&scalarError, &batchError);
+	}
+
+	// Both errors are largest for nearly opposite or equal quaternions, as the division by the sine of the angle amplifies the float rounding.
+	printf("\nSlerp of %d random unit quaternion pairs:\n\n", NUMBER_ERROR_ROUNDS * NUMBER_ITEMS);
+	printf("Maximum difference of batch to scalar:  %g\n", slerpDifference);
+	printf("Maximum error of scalar to double:      %g\n", scalarError);
+	printf("Maximum error of batch to double:       %g\n", batchError);
+
+	return 0;
+}
@@ -0,0 +1,454 @@
+/**
+ * OpenGL 4 - Example 51
+ *
+ * Accuracy and speed of the 4x4 matrix inverse: The former Gauss-Jordan elimination, the adjunct of glusMatrix4x4Inversef and the batch function are compared to a Gauss-Jordan elimination with partial pivoting in long double. No window is opened.
+ *
+ * @author	Norbert Nopper norbert@nopper.tv
+ *
+ * Homepage: http://nopper.tv
+ *
+ * Copyright Norbert Nopper
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "GL/glus.h"
+
+// Not a multiple of the vector width, so the remaining matrices are processed as well.
+#define NUMBER_MATRICES 4099
+
+// Every method is repeated, until this time in nanoseconds has passed.
+#define MEASURE_TIME 250000000
+
+#define SET_RANDOM 0
+#define SET_MODEL_VIEW 1
+#define SET_MODEL_VIEW_PROJECTION 2
+#define NUMBER_SETS 3
+
+#define METHOD_GAUSS_JORDAN 0
+#define METHOD_ADJUNCT 1
+#define METHOD_BATCH 2
+#define NUMBER_METHODS 3
+
+static const GLchar* g_setNames[NUMBER_SETS] = { "Random", "Model view", "Model view projection" };
+
+static const GLchar* g_methodNames[NUMBER_METHODS] = { "Gauss-Jordan", "Adjunct", "Batch" };
+
+static GLfloat g_matrices[NUMBER_MATRICES * 16];
+
+static GLfloat g_result[NUMBER_MATRICES * 16];
+
+static long double g_reference[NUMBER_MATRICES * 16];
+
+static GLboolean g_invertible[NUMBER_MATRICES];
+
+//
+// The former glusMatrix4x4Inversef, which is replaced by the adjunct.
+//
+
+static GLboolean isRowZero(const double matrix[16], GLint row)
+{
+	GLint column;
+
+	for (column = 0; column < 4; column++)
+	{
+		if (matrix[column * 4 + row] != 0.0)
+		{
+			return GL_FALSE;
+		}
+	}
+
+	return GL_TRUE;
+}
+
+static GLboolean isColumnZero(const double matrix[16], GLint column)
+{
+	GLint row;
+
+	for (row = 0; row < 4; row++)
+	{
+		if (matrix[column * 4 + row] != 0.0)
+		{
+			return GL_FALSE;
+		}
+	}
+
+	return GL_TRUE;
+}
+
+static GLvoid divideRowByScalar(double result[16], double matrix[16], GLint row, double value)
+{
+	GLint column;
+
+	for (column = 0; column < 4; column++)
+	{
+		matrix[column * 4 + row] /= value;
+		result[column * 4 + row] /= value;
+	}
+}
+
+static GLvoid swapRow(double result[16], double matrix[16], GLint rowOne, GLint rowTwo)
+{
+	GLint column;
+
+	double temp;
+
+	for (column = 0; column < 4; column++)
+	{
+		temp = matrix[column * 4 + rowOne];
+		matrix[column * 4 + rowOne] = matrix[column * 4 + rowTwo];
+		matrix[column * 4 + rowTwo] = temp;
+
+		temp = result[column * 4 + rowOne];
+		result[column * 4 + rowOne] = result[column * 4 + rowTwo];
+		result[column * 4 + rowTwo] = temp;
+	}
+}
+
+static GLvoid addRow(double result[16], double matrix[16], GLint rowOne, GLint rowTwo, double factor)
+{
+	GLint column;
+
+	for (column = 0; column < 4; column++)
+	{
+		matrix[column * 4 + rowOne] += matrix[column * 4 + rowTwo] * factor;
+		result[column * 4 + rowOne] += result[column * 4 + rowTwo] * factor;
+	}
+}
+
+static GLboolean gaussJordanInversef(GLfloat matrix[16])
+{
+	GLint i;
+
+	GLint column;
+	GLint row;
+
+	double matrixAsDouble[16] = { 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0 };
+	double copy[16];
+
+	for (i = 0; i < 16; i++)
+	{
+		copy[i] = (double)matrix[i];
+	}
+
+	// Make triangle form.
+	for (column = 0; column < 4; column++)
+	{
+		for (row = column; row < 4; row++)
+		{
+			if (isRowZero(copy, row))
+			{
+				return GL_FALSE;
+			}
+
+			if (copy[column * 4 + row] != 0.0)
+			{
+				divideRowByScalar(matrixAsDouble, copy, row, copy[column * 4 + row]);
+			}
+		}
+
+		if (isColumnZero(copy, column))
+		{
+			return GL_FALSE;
+		}
+
+		for (row = column + 1; row < 4; row++)
+		{
+			if (copy[column * 4 + row] == 1.0)
+			{
+				swapRow(matrixAsDouble, copy, column, row);
+
+				break;
+			}
+		}
+
+		for (row = column + 1; row < 4; row++)
+		{
+			if (copy[column * 4 + row] != 0.0)
+			{
+				addRow(matrixAsDouble, copy, row, column, -1.0);
+			}
+		}
+	}
+
+	// Make diagonal form.
+	for (column = 3; column >= 0; column--)
+	{
+		for (row = column - 1; row >= 0; row--)
+		{
+			if (copy[column * 4 + row] != 0.0)
+			{
+				addRow(matrixAsDouble, copy, row, column, -copy[column * 4 + row]);
+			}
+		}
+	}
+
+	for (i = 0; i < 16; i++)
+	{
+		matrix[i] = (GLfloat)matrixAsDouble[i];
+	}
+
+	return GL_TRUE;
+}
+
+//
+// The reference: Gauss-Jordan elimination with partial pivoting in long double.
+//
+
+static GLboolean referenceInverse(long double result[16], const GLfloat matrix[16])
+{
+	long double copy[16];
+	long double temp, factor;
+
+	GLint i, column, row, pivot;
+
+	for (i = 0; i < 16; i++)
+	{
+		copy[i] = (long double)matrix[i];
+		result[i] = (i % 5 == 0) ? 1.0L : 0.0L;
+	}
+
+	for (column = 0; column < 4; column++)
+	{
+		pivot = column;
+
+		for (row = column + 1; row < 4; row++)
+		{
+			if (fabsl(copy[column * 4 + row]) > fabsl(copy[column * 4 + pivot]))
+			{
+				pivot = row;
+			}
+		}
+
+		if (copy[column * 4 + pivot] == 0.0L)
+		{
+			return GL_FALSE;
+		}
+
+		for (i = 0; i < 4; i++)
+		{
+			temp = copy[i * 4 + column];
+			copy[i * 4 + column] = copy[i * 4 + pivot];
+			copy[i * 4 + pivot] = temp;
+
+			temp = result[i * 4 + column];
+			result[i * 4 + column] = result[i * 4 + pivot];
+			result[i * 4 + pivot] = temp;
+		}
+
+		factor = copy[column * 4 + column];
+
+		for (i = 0; i < 4; i++)
+		{
+			copy[i * 4 + column] /= factor;
+			result[i * 4 + column] /= factor;
+		}
+
+		for (row = 0; row < 4; row++)
+		{
+			if (row == column)
+			{
+				continue;
+			}
+
+			factor = copy[column * 4 + row];
+
+			for (i = 0; i < 4; i++)
+			{
+				copy[i * 4 + row] -= copy[i * 4 + column] * factor;
+				result[i * 4 + row] -= result[i * 4 + column] * factor;
+			}
+		}
+	}
+
+	return GL_TRUE;
+}
+
+static GLvoid createMatrices(const GLint set)
+{
+	GLfloat projection[16];
+	GLfloat view[16];
+	GLfloat model[16];
+
+	GLint i, k;
+
+	for (i = 0; i < NUMBER_MATRICES; i++)
+	{
+		if (set == SET_RANDOM)
+		{
+			for (k = 0; k < 16; k++)
+			{
+				g_matrices[i * 16 + k] = glusRandomUniformf(-1.0f, 1.0f);
+			}
+
+			continue;
+		}
+
+		glusMatrix4x4LookAtf(view, glusRandomUniformf(-100.0f, 100.0f), glusRandomUniformf(-100.0f, 100.0f), glusRandomUniformf(-100.0f, 100.0f), 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f);
+
+		glusMatrix4x4Identityf(model);
+		glusMatrix4x4Translatef(model, glusRandomUniformf(-10.0f, 10.0f), glusRandomUniformf(-10.0f, 10.0f), glusRandomUniformf(-10.0f, 10.0f));
+		glusMatrix4x4RotateRzRxRyf(model, glusRandomUniformf(0.0f, 360.0f), glusRandomUniformf(0.0f, 360.0f), glusRandomUniformf(0.0f, 360.0f));
+		glusMatrix4x4Scalef(model, glusRandomUniformf(0.01f, 100.0f), glusRandomUniformf(0.01f, 100.0f), glusRandomUniformf(0.01f, 100.0f));
+
+		glusMatrix4x4Multiplyf(&g_matrices[i * 16], view, model);
+
+		if (set == SET_MODEL_VIEW_PROJECTION)
+		{
+			glusMatrix4x4Perspectivef(projection, glusRandomUniformf(30.0f, 90.0f), 16.0f / 9.0f, glusRandomUniformf(0.01f, 1.0f), glusRandomUniformf(100.0f, 10000.0f));
+
+			glusMatrix4x4Multiplyf(&g_matrices[i * 16], projection, &g_matrices[i * 16]);
+		}
+	}
+
+	for (i = 0; i < NUMBER_MATRICES; i++)
+	{
+		g_invertible[i] = referenceInverse(&g_reference[i * 16], &g_matrices[i * 16]);
+	}
+}
+
+static GLvoid run(const GLint method)
+{
+	GLint i;
+
+	if (method == METHOD_BATCH)
+	{
+		glusBatchMatrix4x4Inversef(g_result, g_matrices, NUMBER_MATRICES);
+
+		return;
+	}
+
+	// The scalar functions invert in place, so the matrices are copied first.
+	memcpy(g_result, g_matrices, NUMBER_MATRICES * 16 * sizeof(GLfloat));
+
+	for (i = 0; i < NUMBER_MATRICES; i++)
+	{
+		if (method == METHOD_GAUSS_JORDAN)
+		{
+			gaussJordanInversef(&g_result[i * 16]);
+		}
+		else
+		{
+			glusMatrix4x4Inversef(&g_result[i * 16]);
+		}
+	}
+}
+
+/**
+ * @return Nanoseconds per matrix.
+ */
+static GLdouble measure(const GLint method)
+{
+	GLUSuint64 start, now;
+
+	GLint count = 0;
+
+	start = glusTimeGetTimestampNanoseconds();
+
+	do
+	{
+		run(method);
+
+		count++;
+
+		now = glusTimeGetTimestampNanoseconds();
+	}
+	while (now - start < MEASURE_TIME);
+
+	return (GLdouble)(now - start) / (GLdouble)count / (GLdouble)NUMBER_MATRICES;
+}
+
+/**
+ * Largest error of an element relative to the largest element of the reference inverse.
+ */
+static GLdouble maximumRelativeError(GLvoid)
+{
+	long double maximum, difference, error, result = 0.0L;
+
+	GLint i, k;
+
+	for (i = 0; i < NUMBER_MATRICES; i++)
+	{
+		if (!g_invertible[i])
+		{
+			continue;
+		}
+
+		maximum = 0.0L;
+		difference = 0.0L;
+
+		for (k = 0; k < 16; k++)
+		{
+			if (fabsl(g_reference[i * 16 + k]) > maximum)
+			{
+				maximum = fabsl(g_reference[i * 16 + k]);
+			}
+
+			if (fabsl((long double)g_result[i * 16 + k] - g_reference[i * 16 + k]) > difference)
+			{
+				difference = fabsl((long double)g_result[i * 16 + k] - g_reference[i * 16 + k]);
+			}
+		}
+
+		error = difference / maximum;
+
+		if (error > result)
+		{
+			result = error;
+		}
+	}
+
+	return (GLdouble)result;
+}
+
+int main(GLvoid)
+{
+	GLint set, method;
+
+	GLdouble time[NUMBER_METHODS];
+	GLdouble error[NUMBER_METHODS];
+
+	glusRandomSetSeed(51);
+
+	printf("Instruction set of the batch function: %s\n\n", glusBatchGetInstructionSet());
+
+	printf("Nanoseconds per matrix and largest relative error to the long double reference of %d matrices:\n\n", NUMBER_MATRICES);
+
+	printf("%22s", "Matrices");
+
+	for (method = 0; method < NUMBER_METHODS; method++)
+	{
+		printf("%14s%12s", g_methodNames[method], "Error");
+	}
+
+	printf("\n");
+
+	for (set = 0; set < NUMBER_SETS; set++)
+	{
+		createMatrices(set);
+
+		for (method = 0; method < NUMBER_METHODS; method++)
+		{
+			run(method);
+
+			error[method] = maximumRelativeError();
+
+			time[method] = measure(method);
+		}
+
+		printf("%22s", g_setNames[set]);
+
+		for (method = 0; method < NUMBER_METHODS; method++)
+		{
+			printf("%14.2f%12.3g", time[method], error[method]);
+		}
+
+		printf("\n");
+
+		fflush(stdout);
+	}
+
+	return 0;
+}
@@ -0,0 +1,194 @@
+/**
+ * OpenGL 4 - Example 52
+ *
+ * Rays per second of the ray generation at 4K resolution and for a tile: The interleaved buffer functions compared to the separated buffer functions, which create eight rays at once with AVX. No window is opened.
+ *
+ * @author	Norbert Nopper norbert@nopper.tv
+ *
+ * Homepage: http://nopper.tv
+ *
+ * Copyright Norbert Nopper
+ */
+
+#include <stdio.h>
+
+#include "GL/glus.h"
+
+#define WIDTH 3840
+#define HEIGHT 2160
+
+#define NUMBER_RAYS (WIDTH * HEIGHT)
+
+// A tile fits into the cache, so the speed of the calculation is measured instead of the memory bandwidth.
+#define TILE_WIDTH 256
+#define TILE_HEIGHT 16
+
+#define FOVY 60.0f
+
+// Every function is repeated, until this time in nanoseconds has passed.
+#define MEASURE_TIME 1000000000
+
+#define FUNCTION_PERSPECTIVE 0
+#define FUNCTION_PERSPECTIVE_SOA 1
+#define FUNCTION_LOOK_AT 2
+#define FUNCTION_LOOK_AT_SOA 3
+#define NUMBER_FUNCTIONS 4
+
+static const GLchar* g_functionNames[NUMBER_FUNCTIONS] = { "glusRaytracePerspectivef", "glusRaytracePerspectiveSoAf", "glusRaytraceLookAtf", "glusRaytraceLookAtSoAf" };
+
+static GLfloat* g_directions = 0;
+static GLfloat* g_lookAtDirections = 0;
+
+static GLfloat* g_directionX = 0;
+static GLfloat* g_directionY = 0;
+static GLfloat* g_directionZ = 0;
+
+static GLfloat* g_lookAtDirectionX = 0;
+static GLfloat* g_lookAtDirectionY = 0;
+static GLfloat* g_lookAtDirectionZ = 0;
+
+static GLvoid run(const GLint function, const GLint width, const GLint height)
+{
+	switch (function)
+	{
+		case FUNCTION_PERSPECTIVE:
+			glusRaytracePerspectivef(g_directions, 0, FOVY, width, height);
+		break;
+		case FUNCTION_PERSPECTIVE_SOA:
+			glusRaytracePerspectiveSoAf(g_directionX, g_directionY, g_directionZ, FOVY, width, height);
+		break;
+		case FUNCTION_LOOK_AT:
+			glusRaytraceLookAtf(0, g_lookAtDirections, g_directions, 0, width, height, 1.0f, 2.0f, 5.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f);
+		break;
+		case FUNCTION_LOOK_AT_SOA:
+			glusRaytraceLookAtSoAf(g_lookAtDirectionX, g_lookAtDirectionY, g_lookAtDirectionZ, g_directionX, g_directionY, g_directionZ, width, height, 1.0f, 2.0f, 5.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f);
+		break;
+	}
+}
+
+/**
+ * @return Millions of rays per second.
+ */
+static GLdouble measure(const GLint function, const GLint width, const GLint height)
+{
+	GLUSuint64 start, now;
+
+	GLint count = 0;
+
+	// Warm up, so the pages of the buffers are mapped.
+	run(function, width, height);
+
+	start = glusTimeGetTimestampNanoseconds();
+
+	do
+	{
+		run(function, width, height);
+
+		count++;
+
+		now = glusTimeGetTimestampNanoseconds();
+	}
+	while (now - start < MEASURE_TIME);
+
+	return (GLdouble)width * (GLdouble)height * (GLdouble)count / ((GLdouble)(now - start) / 1000.0);
+}
+
+/**
+ * Largest difference of the separated to the interleaved directions.
+ */
+static GLfloat maximumDifference(const GLfloat* directions, const GLfloat* directionX, const GLfloat* directionY, const GLfloat* directionZ)
+{
+	GLfloat difference, result = 0.0f;
+
+	GLint i, k;
+
+	const GLfloat* separated[3];
+
+	separated[0] = directionX;
+	separated[1] = directionY;
+	separated[2] = directionZ;
+
+	for (i = 0; i < NUMBER_RAYS; i++)
+	{
+		for (k = 0; k < 3; k++)
+		{
+			difference = directions[i * 3 + k] > separated[k][i] ? directions[i * 3 + k] - separated[k][i] : separated[k][i] - directions[i * 3 + k];
+
+			if (difference > result)
+			{
+				result = difference;
+			}
+		}
+	}
+
+	return result;
+}
+
+static GLvoid freeBuffers(GLvoid)
+{
+	glusMemoryFree(g_directions);
+	glusMemoryFree(g_lookAtDirections);
+
+	glusMemoryFree(g_directionX);
+	glusMemoryFree(g_directionY);
+	glusMemoryFree(g_directionZ);
+
+	glusMemoryFree(g_lookAtDirectionX);
+	glusMemoryFree(g_lookAtDirectionY);
+	glusMemoryFree(g_lookAtDirectionZ);
+}
+
+int main(GLvoid)
+{
+	GLint function;
+
+	GLdouble tile[NUMBER_FUNCTIONS];
+
+	g_directions = (GLfloat*)glusMemoryMalloc(NUMBER_RAYS * 3 * sizeof(GLfloat));
+	g_lookAtDirections = (GLfloat*)glusMemoryMalloc(NUMBER_RAYS * 3 * sizeof(GLfloat));
+
+	g_directionX = (GLfloat*)glusMemoryMalloc(NUMBER_RAYS * sizeof(GLfloat));
+	g_directionY = (GLfloat*)glusMemoryMalloc(NUMBER_RAYS * sizeof(GLfloat));
+	g_directionZ = (GLfloat*)glusMemoryMalloc(NUMBER_RAYS * sizeof(GLfloat));
+
+	g_lookAtDirectionX = (GLfloat*)glusMemoryMalloc(NUMBER_RAYS * sizeof(GLfloat));
+	g_lookAtDirectionY = (GLfloat*)glusMemoryMalloc(NUMBER_RAYS * sizeof(GLfloat));
+	g_lookAtDirectionZ = (GLfloat*)glusMemoryMalloc(NUMBER_RAYS * sizeof(GLfloat));
+
+	if (!g_directions || !g_lookAtDirections || !g_directionX || !g_directionY || !g_directionZ || !g_lookAtDirectionX || !g_lookAtDirectionY || !g_lookAtDirectionZ)
+	{
+		printf("Could not allocate the ray buffers\n");
+
+		freeBuffers();
+
+		return -1;
+	}
+
+	printf("Instruction set: %s\n\n", glusBatchGetInstructionSet());
+
+	printf("Millions of rays per second:\n\n");
+
+	printf("%30s%12s%12s\n", "Function", "3840x2160", "256x16");
+
+	// The 4K buffers are compared afterwards, so the tiles are measured first.
+	for (function = 0; function < NUMBER_FUNCTIONS; function++)
+	{
+		tile[function] = measure(function, TILE_WIDTH, TILE_HEIGHT);
+	}
+
+	for (function = 0; function < NUMBER_FUNCTIONS; function++)
+	{
+		printf("%30s%12.2f%12.2f\n", g_functionNames[function], measure(function, WIDTH, HEIGHT), tile[function]);
+
+		fflush(stdout);
+	}
+
+	// The last run of every function is compared.
+	printf("\nMaximum difference of the separated to the interleaved directions:\n\n");
+	printf("%30s%12g\n", "Perspective", maximumDifference(g_directions, g_directionX, g_directionY, g_directionZ));
+	printf("%30s%12g\n", "Look at", maximumDifference(g_lookAtDirections, g_lookAtDirectionX, g_lookAtDirectionY, g_lookAtDirectionZ));
+
+	freeBuffers();
+
+	return 0;
+}
@@ -187,6 +187,12 @@ extern "C"
 
 #include "../GLUS/glus_quaternion.h"
 
+//
+// Batched math functions.
+//
+
+#include "../GLUS/glus_batch.h"
+
 //
 // Complex numbers and vector functions.
 //
@@ -232,6 +238,7 @@ extern "C"
 
 #include "../GLUS/glus_shape_wavefront.h"
 #include "../GLUS/glus_wavefront.h"
+#include "../GLUS/glus_mesh.h"
 
 //
 // Logging
@@ -251,11 +258,21 @@ extern "C"
 
 #include "../GLUS/glus_time.h"
 
+//
+// Threading
+//
+
+#include "../GLUS/glus_thread.h"
+#include "../GLUS/glus_job.h"
+
 //
 // Ray tracing
 //
 
 #include "../GLUS/glus_raytrace.h"
+#include "../GLUS/glus_bvh.h"
+#include "../GLUS/glus_raytrace_scene.h"
+#include "../GLUS/glus_raymarch_scene.h"
 
 //
 // Intersection testing
@@ -270,6 +287,9 @@ extern "C"
 #include "../GLUS/glus_image_tga.h"
 #include "../GLUS/glus_image_hdr.h"
 #include "../GLUS/glus_image_pkm.h"
+#include "../GLUS/glus_image_batch.h"
+#include "../GLUS/glus_ibl.h"
+#include "../GLUS/glus_ocean.h"
 
 #include "../GLUS/glus_file_text.h"
 #include "../GLUS/glus_file_binary.h"
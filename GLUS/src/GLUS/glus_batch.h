@@ -0,0 +1,94 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_BATCH_H_
+#define GLUS_BATCH_H_
+
+/**
+ * Returns the instruction set, which is used by the batch functions. Either "AVX", "SSE2", "NEON" or "C".
+ * AVX is only used, if the processor and the operating system do support it.
+ *
+ * @return The name of the instruction set.
+ */
+GLUSAPI const GLUSchar* GLUSAPIENTRY glusBatchGetInstructionSet(GLUSvoid);
+
+/**
+ * Multiplies pairs of 4x4 matrices: matrices0[i] * matrices1[i]. The result can be the same array as one of the inputs.
+ *
+ * @param result The resulting matrices. Has to have space for number * 16 elements.
+ * @param matrices0 The first matrices.
+ * @param matrices1 The second matrices.
+ * @param number The number of matrix pairs.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusBatchMatrix4x4Multiplyf(GLUSfloat* result, const GLUSfloat* matrices0, const GLUSfloat* matrices1, const GLUSint number);
+
+/**
+ * Calculates the inverses of 4x4 matrices using the determinant and adjunct of a matrix. The results are the same as of glusMatrix4x4Inversef.
+ *
+ * @param result The inverted matrices. Has to have space for number * 16 elements. Can be the same array as matrices.
+ * @param matrices The matrices to be inverted. Matrices, which can not be inverted, are copied unchanged.
+ * @param number The number of matrices.
+ *
+ * @return GLUS_TRUE, if all matrices could be inverted.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusBatchMatrix4x4Inversef(GLUSfloat* result, const GLUSfloat* matrices, const GLUSint number);
+
+/**
+ * Multiplies a 4x4 matrix with 3D points, given as homogeneous coordinates. Like glusMatrix4x4MultiplyPoint4f, the points are divided by w, if w is neither zero nor one.
+ *
+ * @param result The transformed points. Has to have space for number * 4 elements. Can be the same array as points.
+ * @param matrix The matrix used for the transformation.
+ * @param points The used points for the transformation.
+ * @param number The number of points.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusBatchMatrix4x4MultiplyPoint4f(GLUSfloat* result, const GLUSfloat matrix[16], const GLUSfloat* points, const GLUSint number);
+
+/**
+ * Multiplies a 4x4 matrix with planes. To transform planes, the inverse transpose of the matrix used for the points has to be passed.
+ *
+ * @param result The transformed planes. Has to have space for number * 4 elements. Can be the same array as planes.
+ * @param matrix The matrix used for the transformation.
+ * @param planes The used planes for the transformation.
+ * @param number The number of planes.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusBatchMatrix4x4MultiplyPlanef(GLUSfloat* result, const GLUSfloat matrix[16], const GLUSfloat* planes, const GLUSint number);
+
+/**
+ * Normalizes 3D vectors, which are stored one after another. Vectors with a length of zero are not changed.
+ *
+ * @param vectors The vectors, which are normalized in place. Has number * 3 elements.
+ * @param number The number of vectors.
+ *
+ * @return GLUS_TRUE, if all vectors could be normalized.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusBatchVector3Normalizef(GLUSfloat* vectors, const GLUSint number);
+
+/**
+ * Spherical interpolation of pairs of quaternions. The trigonometric functions are approximated by polynomials, so the results differ from glusQuaternionSlerpf in the last bits.
+ * As with glusQuaternionSlerpf, the shortest path is not enforced.
+ *
+ * @param result The interpolated quaternions. Has to have space for number * 4 elements. Can be the same array as one of the inputs.
+ * @param quaternions0 The start quaternions.
+ * @param quaternions1 The end quaternions.
+ * @param t The interpolation factors per pair. Usually in the range from 0.0 to 1.0.
+ * @param number The number of quaternion pairs.
+ *
+ * @return GLUS_TRUE, if all pairs could be interpolated. If the angle between a pair is zero, the start quaternion is taken.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusBatchQuaternionSlerpf(GLUSfloat* result, const GLUSfloat* quaternions0, const GLUSfloat* quaternions1, const GLUSfloat* t, const GLUSint number);
+
+#endif /* GLUS_BATCH_H_ */
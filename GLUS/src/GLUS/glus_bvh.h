@@ -0,0 +1,175 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_BVH_H_
+#define GLUS_BVH_H_
+
+/**
+ * Node of a bounding volume hierarchy.
+ */
+typedef struct _GLUSbvhnode
+{
+	/**
+	 * Minimum corner of the bounding box.
+	 */
+	GLUSfloat minimum[3];
+
+	/**
+	 * Maximum corner of the bounding box.
+	 */
+	GLUSfloat maximum[3];
+
+	/**
+	 * For an inner node, the index of the first child node. The second child node directly follows.
+	 * For a leaf node, the index of the first primitive in the primitive list.
+	 */
+	GLUSint index;
+
+	/**
+	 * Number of primitives in a leaf node. Zero for an inner node.
+	 */
+	GLUSint numberPrimitives;
+
+} GLUSbvhnode;
+
+/**
+ * Bounding volume hierarchy over spheres or triangles. The first node is the root node.
+ */
+typedef struct _GLUSbvh
+{
+	/**
+	 * The nodes.
+	 */
+	GLUSbvhnode* nodes;
+
+	/**
+	 * Number of nodes.
+	 */
+	GLUSint numberNodes;
+
+	/**
+	 * Primitive indices referenced by the leaf nodes.
+	 */
+	GLUSint* primitives;
+
+	/**
+	 * Number of primitives.
+	 */
+	GLUSint numberPrimitives;
+
+	/**
+	 * Spheres as center and radius. Four values per sphere. Null for a triangle hierarchy.
+	 */
+	GLUSfloat* spheres;
+
+	/**
+	 * Triangles as three points in homogeneous coordinates. Twelve values per triangle. Null for a sphere hierarchy.
+	 */
+	GLUSfloat* triangles;
+
+} GLUSbvh;
+
+/**
+ * Result of a closest hit query.
+ */
+typedef struct _GLUSbvhhit
+{
+	/**
+	 * Index of the hit sphere or triangle.
+	 */
+	GLUSint primitive;
+
+	/**
+	 * t of the intersection point.
+	 */
+	GLUSfloat t;
+
+	/**
+	 * Barycentric coordinate of the second triangle point.
+	 */
+	GLUSfloat u;
+
+	/**
+	 * Barycentric coordinate of the third triangle point.
+	 */
+	GLUSfloat v;
+
+	/**
+	 * Set to GLUS_TRUE, if the ray starts inside the hit sphere. Then t is the exit point.
+	 */
+	GLUSboolean insideSphere;
+
+} GLUSbvhhit;
+
+/**
+ * Creates a bounding volume hierarchy over spheres using the surface area heuristic.
+ *
+ * @param bvh				The resulting hierarchy.
+ * @param centers			Pointer to the center of the first sphere.
+ * @param radii				Pointer to the radius of the first sphere.
+ * @param stride			Byte offset between consecutive spheres. If zero, centers are tightly packed with four values and radii with one value.
+ * @param numberSpheres		Number of spheres.
+ *
+ * @return GLUS_TRUE, if creation was successful.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusBvhCreateSpheresf(GLUSbvh* bvh, const GLUSfloat* centers, const GLUSfloat* radii, const GLUSint stride, const GLUSint numberSpheres);
+
+/**
+ * Creates a bounding volume hierarchy over the triangles of a shape using the surface area heuristic.
+ * Triangle i consists of the vertices 3 * i, 3 * i + 1 and 3 * i + 2, indexed if the shape has indices.
+ *
+ * @param bvh	The resulting hierarchy.
+ * @param shape	The shape. The mode has to be GLUS_TRIANGLES.
+ *
+ * @return GLUS_TRUE, if creation was successful.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusBvhCreateShapef(GLUSbvh* bvh, const GLUSshape* shape);
+
+/**
+ * Destroys a bounding volume hierarchy.
+ *
+ * @param bvh The hierarchy to destroy.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusBvhDestroyf(GLUSbvh* bvh);
+
+/**
+ * Finds the closest intersection of a ray. If several primitives are hit at the same t, the one with the lowest index is returned.
+ *
+ * @param hit			The resulting hit.
+ * @param bvh			The hierarchy.
+ * @param rayStart		Point, where the ray starts.
+ * @param rayDirection	Ray direction vector. Has to be normalized for spheres.
+ * @param tMax			Intersections with a greater t are ignored.
+ *
+ * @return GLUS_TRUE, if a primitive was hit.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusBvhIntersectRayClosestf(GLUSbvhhit* hit, const GLUSbvh* bvh, const GLUSfloat rayStart[4], const GLUSfloat rayDirection[3], const GLUSfloat tMax);
+
+/**
+ * Checks, if a ray intersects any primitive. Traversal stops at the first found intersection.
+ *
+ * @param bvh				The hierarchy.
+ * @param rayStart			Point, where the ray starts.
+ * @param rayDirection		Ray direction vector. Has to be normalized for spheres.
+ * @param tMax				Intersections with a greater t are ignored.
+ * @param ignorePrimitive	Index of a primitive, which is not tested. Pass -1 to test all primitives.
+ *
+ * @return GLUS_TRUE, if a primitive was hit.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusBvhIntersectRayAnyf(const GLUSbvh* bvh, const GLUSfloat rayStart[4], const GLUSfloat rayDirection[3], const GLUSfloat tMax, const GLUSint ignorePrimitive);
+
+#endif /* GLUS_BVH_H_ */
@@ -45,6 +45,20 @@ GLUSAPI EGLBoolean GLUSAPIENTRY glusEGLCreateContext(EGLNativeDisplayType eglNat
  */
 GLUSAPI EGLBoolean GLUSAPIENTRY glusEGLCreateWindowSurfaceMakeCurrent(EGLNativeWindowType eglNativeWindowType, EGLDisplay* eglDisplay, EGLConfig* eglConfig, EGLContext* eglContext, EGLSurface* eglSurface, const EGLint* surfaceAttribList);
 
+/**
+ * Creates an off screen pixel buffer surface and sets it as current. The configuration has to support EGL_PBUFFER_BIT.
+ *
+ * @param width						Width of the surface.
+ * @param height					Height of the surface.
+ * @param eglDisplay 				EGL display.
+ * @param eglConfig  				EGL configuration.
+ * @param eglContext 				EGL context.
+ * @param eglSurface 				EGL surface.
+ *
+ * @return EGL_TRUE, when creation of surface and setting of context succeeded.
+ */
+GLUSAPI EGLBoolean GLUSAPIENTRY glusEGLCreatePbufferSurfaceMakeCurrent(const EGLint width, const EGLint height, EGLDisplay* eglDisplay, EGLConfig* eglConfig, EGLContext* eglContext, EGLSurface* eglSurface);
+
 /**
  * Returns the created default EGL display.
  *
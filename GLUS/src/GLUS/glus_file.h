@@ -75,4 +75,14 @@ GLUSAPI FILE* GLUSAPIENTRY glusFileOpen(const char * filename, const char * mode
  */
 GLUSAPI int GLUSAPIENTRY glusFileClose(FILE* stream);
 
+/**
+ * Deletes the file whose name is specified in the parameter filename.
+ *
+ * @param filename C string containing the name of the file to be deleted.
+ *
+ * @return If the file is successfully deleted, a zero value is returned.
+ *		   On failure, a nonzero value is returned.
+ */
+GLUSAPI int GLUSAPIENTRY glusFileRemove(const char* filename);
+
 #endif /* GLUS_FILE_H_ */
@@ -108,4 +108,213 @@ GLUSAPI GLUSboolean glusFourierButterflyFFTc(GLUScomplex* result, const GLUScomp
  */
 GLUSAPI GLUSboolean glusFourierButterflyInverseFFTc(GLUScomplex* result, const GLUScomplex* vector, const GLUSint n);
 
+/**
+ * Precomputed tables for fast fourier transforms of a fixed size. The same plan can be used for several transforms.
+ * The split real and imaginary transforms do not modify the plan, so they can be executed by several threads at the same time.
+ */
+typedef struct _GLUSfourierplan
+{
+	/**
+	 * Number of elements.
+	 */
+	GLUSint n;
+
+	/**
+	 * Binary logarithm of the number of elements.
+	 */
+	GLUSint log2n;
+
+	/**
+	 * Bit reversed index for each element.
+	 */
+	GLUSint* bitReverse;
+
+	/**
+	 * Twiddle factors. Stage with half span h has its h factors starting at index h - 1.
+	 */
+	GLUSfloat* twiddleReal;
+
+	/**
+	 * Imaginary part of the twiddle factors.
+	 */
+	GLUSfloat* twiddleImaginary;
+
+	/**
+	 * Buffer used for the interleaved complex and the real transforms.
+	 */
+	GLUSfloat* workReal;
+
+	/**
+	 * Imaginary part of the buffer.
+	 */
+	GLUSfloat* workImaginary;
+
+} GLUSfourierplan;
+
+/**
+ * Creates a plan for fast fourier transforms with N elements. Twiddle factors and bit reversal are calculated once.
+ *
+ * @param plan	The plan to create.
+ * @param n		The number of elements. Has to be a power of two.
+ *
+ * @return GLUS_TRUE, if creation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourierCreatePlan(GLUSfourierplan* plan, const GLUSint n);
+
+/**
+ * Destroys a plan and frees its resources.
+ *
+ * @param plan The plan to destroy.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusFourierDestroyPlan(GLUSfourierplan* plan);
+
+/**
+ * Performs a fast fourier transform in place on split real and imaginary parts. Same result as glusFourierButterflyFFTc.
+ *
+ * @param plan		The plan created for N elements.
+ * @param real		The real parts of the N elements.
+ * @param imaginary	The imaginary parts of the N elements.
+ *
+ * @return GLUS_TRUE, if transform succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourierPlanFFTf(const GLUSfourierplan* plan, GLUSfloat* real, GLUSfloat* imaginary);
+
+/**
+ * Performs an inverse fast fourier transform in place on split real and imaginary parts. Same result as glusFourierButterflyInverseFFTc.
+ *
+ * @param plan		The plan created for N elements.
+ * @param real		The real parts of the N elements.
+ * @param imaginary	The imaginary parts of the N elements.
+ *
+ * @return GLUS_TRUE, if transform succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourierPlanInverseFFTf(const GLUSfourierplan* plan, GLUSfloat* real, GLUSfloat* imaginary);
+
+/**
+ * Performs a fast fourier transform on a given vector with N elements using a plan. Same result as glusFourierButterflyFFTc.
+ *
+ * @param plan		The plan created for N elements. Its buffer is used, so the plan can only be used by one thread at a time.
+ * @param result	The transformed vector. Can be the source vector.
+ * @param vector	The source vector.
+ *
+ * @return GLUS_TRUE, if transform succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourierPlanFFTc(GLUSfourierplan* plan, GLUScomplex* result, const GLUScomplex* vector);
+
+/**
+ * Performs an inverse fast fourier transform on a given vector with N elements using a plan. Same result as glusFourierButterflyInverseFFTc.
+ *
+ * @param plan		The plan created for N elements. Its buffer is used, so the plan can only be used by one thread at a time.
+ * @param result	The transformed vector. Can be the source vector.
+ * @param vector	The source vector.
+ *
+ * @return GLUS_TRUE, if transform succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourierPlanInverseFFTc(GLUSfourierplan* plan, GLUScomplex* result, const GLUScomplex* vector);
+
+/**
+ * Performs a fast fourier transform on N real values. As the result is conjugate symmetric, only the first N / 2 + 1 elements are calculated.
+ * Internally, a transform with N / 2 elements is done.
+ *
+ * @param plan				The plan created for N elements. At least two elements are needed. Its buffer is used, so the plan can only be used by one thread at a time.
+ * @param resultReal		The real parts of the N / 2 + 1 transformed elements.
+ * @param resultImaginary	The imaginary parts of the N / 2 + 1 transformed elements.
+ * @param vector			The N real source values.
+ *
+ * @return GLUS_TRUE, if transform succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourierPlanRealFFTf(GLUSfourierplan* plan, GLUSfloat* resultReal, GLUSfloat* resultImaginary, const GLUSfloat* vector);
+
+/**
+ * Performs an inverse fast fourier transform, where the result consists of N real values. Only the first N / 2 + 1 elements of the conjugate symmetric source are used.
+ *
+ * @param plan		The plan created for N elements. At least two elements are needed. Its buffer is used, so the plan can only be used by one thread at a time.
+ * @param result	The N real transformed values.
+ * @param real		The real parts of the N / 2 + 1 source elements.
+ * @param imaginary	The imaginary parts of the N / 2 + 1 source elements.
+ *
+ * @return GLUS_TRUE, if transform succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourierPlanInverseRealFFTf(GLUSfourierplan* plan, GLUSfloat* result, const GLUSfloat* real, const GLUSfloat* imaginary);
+
+/**
+ * Performs fast fourier transforms in place on several vectors with N elements, which are stored one after the other.
+ *
+ * @param plan				The plan created for N elements.
+ * @param real				The real parts of all elements.
+ * @param imaginary			The imaginary parts of all elements.
+ * @param numberTransforms	The number of vectors.
+ * @param numberThreads		The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if transform succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourierBatchFFTf(const GLUSfourierplan* plan, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberTransforms, const GLUSint numberThreads);
+
+/**
+ * Performs inverse fast fourier transforms in place on several vectors with N elements, which are stored one after the other.
+ *
+ * @param plan				The plan created for N elements.
+ * @param real				The real parts of all elements.
+ * @param imaginary			The imaginary parts of all elements.
+ * @param numberTransforms	The number of vectors.
+ * @param numberThreads		The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if transform succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourierBatchInverseFFTf(const GLUSfourierplan* plan, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberTransforms, const GLUSint numberThreads);
+
+/**
+ * Performs a two dimensional fast fourier transform in place. Elements are stored row by row. The result is scaled by 1 / (width * height).
+ *
+ * @param planX			The plan created for the width.
+ * @param planY			The plan created for the height.
+ * @param real			The real parts of all elements.
+ * @param imaginary		The imaginary parts of all elements.
+ * @param numberThreads	The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if transform succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourier2DFFTf(const GLUSfourierplan* planX, const GLUSfourierplan* planY, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberThreads);
+
+/**
+ * Performs a two dimensional inverse fast fourier transform in place. Elements are stored row by row.
+ *
+ * @param planX			The plan created for the width.
+ * @param planY			The plan created for the height.
+ * @param real			The real parts of all elements.
+ * @param imaginary		The imaginary parts of all elements.
+ * @param numberThreads	The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if transform succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourier2DInverseFFTf(const GLUSfourierplan* planX, const GLUSfourierplan* planY, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberThreads);
+
+/**
+ * Performs a three dimensional fast fourier transform in place. Elements are stored row by row and slice by slice. The result is scaled by 1 / (width * height * depth).
+ *
+ * @param planX			The plan created for the width.
+ * @param planY			The plan created for the height.
+ * @param planZ			The plan created for the depth.
+ * @param real			The real parts of all elements.
+ * @param imaginary		The imaginary parts of all elements.
+ * @param numberThreads	The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if transform succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourier3DFFTf(const GLUSfourierplan* planX, const GLUSfourierplan* planY, const GLUSfourierplan* planZ, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberThreads);
+
+/**
+ * Performs a three dimensional inverse fast fourier transform in place. Elements are stored row by row and slice by slice.
+ *
+ * @param planX			The plan created for the width.
+ * @param planY			The plan created for the height.
+ * @param planZ			The plan created for the depth.
+ * @param real			The real parts of all elements.
+ * @param imaginary		The imaginary parts of all elements.
+ * @param numberThreads	The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if transform succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusFourier3DInverseFFTf(const GLUSfourierplan* planX, const GLUSfourierplan* planY, const GLUSfourierplan* planZ, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberThreads);
+
 #endif /* GLUS_FOURIER_H_ */
@@ -0,0 +1,109 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_IBL_H_
+#define GLUS_IBL_H_
+
+#define GLUS_IBL_SPECULAR_GGX		0x0001
+#define GLUS_IBL_DIFFUSE_LAMBERT	0x0002
+#define GLUS_IBL_DIFFUSE_SH			0x0003
+
+/**
+ * Creates a cube map out of a panorama using an equirectangular projection. The faces follow the OpenGL cube map layout.
+ *
+ * @param cubeMap		The six faces to create, starting with positive x. Have to be destroyed with glusImageDestroyHdr.
+ * @param panorama		The equirectangular source image.
+ * @param size			Width and height of each face.
+ * @param numberThreads	The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if creation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusIblCreateCubeMapFromPanorama(GLUShdrimage cubeMap[6], const GLUShdrimage* panorama, const GLUSint size, const GLUSint numberThreads);
+
+/**
+ * Prefilters a cube map for image based lighting. The source is importance sampled using a Hammersley point set.
+ * Samples with a large footprint are taken from a lower resolution level of the source, so few samples are needed.
+ *
+ * GLUS_IBL_SPECULAR_GGX convolves with the GGX distribution of the given roughness, assuming normal, view and reflection vector are equal.
+ * GLUS_IBL_DIFFUSE_LAMBERT convolves with the cosine lobe.
+ * GLUS_IBL_DIFFUSE_SH evaluates the irradiance out of spherical harmonics. The roughness and the samples are ignored.
+ *
+ * The diffuse results are already divided by pi, so they only have to be multiplied by the diffuse color.
+ *
+ * @param target		The six faces to create, starting with positive x. Have to be destroyed with glusImageDestroyHdr.
+ * @param source		The six faces of the source cube map. Have to be square, of equal size and of RGB or RGBA format.
+ * @param mode			The convolution to apply.
+ * @param roughness		The roughness in the range [0.0, 1.0]. The GGX alpha is the squared roughness.
+ * @param size			Width and height of each target face.
+ * @param m				Order of the Hammersley point set, so 2^m samples are taken. Has to be in the range 0 < m <= 16.
+ * @param numberThreads	The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if prefiltering succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusIblPrefilterCubeMap(GLUShdrimage target[6], const GLUShdrimage source[6], const GLUSenum mode, const GLUSfloat roughness, const GLUSint size, const GLUSubyte m, const GLUSint numberThreads);
+
+/**
+ * Projects a cube map onto the first nine spherical harmonics.
+ *
+ * @param coefficients	The resulting RGB coefficients, ordered by band.
+ * @param source		The six faces of the source cube map. Have to be square, of equal size and of RGB or RGBA format.
+ * @param numberThreads	The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if projecting succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusIblComputeSh(GLUSfloat coefficients[27], const GLUShdrimage source[6], const GLUSint numberThreads);
+
+/**
+ * Evaluates the diffuse irradiance divided by pi out of spherical harmonics coefficients.
+ *
+ * @param rgb			The resulting color.
+ * @param coefficients	The RGB coefficients as calculated by glusIblComputeSh.
+ * @param normal		The normalized surface normal.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusIblEvaluateSh(GLUSfloat rgb[3], const GLUSfloat coefficients[27], const GLUSfloat normal[3]);
+
+/**
+ * Creates the split sum environment BRDF look up table. The data has two floats per texel: The scale and the bias for the specular color at normal incidence.
+ * The s axis is the dot product of normal and view vector, the t axis is the roughness.
+ *
+ * @param lut			The binary file to fill. Can be saved with glusFileSaveBinary and has to be destroyed with glusFileDestroyBinary.
+ * @param width			Number of texels for the dot product of normal and view vector.
+ * @param height		Number of texels for the roughness.
+ * @param m				Order of the Hammersley point set, so 2^m samples are taken. Has to be in the range 0 < m <= 16.
+ * @param numberThreads	The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if creation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusIblCreateBrdfLut(GLUSbinaryfile* lut, const GLUSint width, const GLUSint height, const GLUSubyte m, const GLUSint numberThreads);
+
+/**
+ * Prefilters a cube map for all roughness levels and the diffuse lighting and saves the faces as HDR files.
+ * Files are named prefix_POS_X_00_s.hdr up to prefix_NEG_Z_nn_s.hdr for the specular levels and prefix_POS_X_00_d.hdr up to prefix_NEG_Z_00_d.hdr for the diffuse lighting.
+ *
+ * @param prefix			The path and the start of the file names.
+ * @param source			The six faces of the source cube map.
+ * @param size				Width and height of each face.
+ * @param numberRoughness	The number of roughness levels. The roughness is increased in equal steps from 0.0 to 1.0.
+ * @param diffuseMode		GLUS_IBL_DIFFUSE_LAMBERT or GLUS_IBL_DIFFUSE_SH.
+ * @param m					Order of the Hammersley point set, so 2^m samples are taken. Has to be in the range 0 < m <= 16.
+ * @param numberThreads		The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if all files were saved.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusIblSaveHdr(const GLUSchar* prefix, const GLUShdrimage source[6], const GLUSint size, const GLUSint numberRoughness, const GLUSenum diffuseMode, const GLUSubyte m, const GLUSint numberThreads);
+
+#endif /* GLUS_IBL_H_ */
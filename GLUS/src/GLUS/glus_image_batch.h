@@ -0,0 +1,133 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_IMAGE_BATCH_H_
+#define GLUS_IMAGE_BATCH_H_
+
+#define GLUS_IMAGE_TGA	0x0001
+#define GLUS_IMAGE_HDR	0x0002
+#define GLUS_IMAGE_PKM	0x0003
+
+/**
+ * One file of a batch.
+ */
+typedef struct _GLUSimagebatchentry
+{
+	/**
+	 * The name of the file to load.
+	 */
+	const GLUSchar* filename;
+
+	/**
+	 * The type of the image. Can be:
+	 *
+	 * GLUS_IMAGE_TGA
+	 * GLUS_IMAGE_HDR
+	 * GLUS_IMAGE_PKM
+	 */
+	GLUSenum type;
+
+	/**
+	 * The structure to fill. Has to point to a GLUStgaimage, GLUShdrimage or GLUSpkmimage depending on the type.
+	 */
+	GLUSvoid* image;
+
+	/**
+	 * Set to GLUS_TRUE, if loading of this file succeeded.
+	 */
+	GLUSboolean result;
+
+} GLUSimagebatchentry;
+
+/**
+ * Function called, after a file of a batch has been loaded. Called from a worker thread, so no OpenGL functions are allowed.
+ *
+ * @param entry		The loaded entry. The result is already set.
+ * @param index		The index of the entry in the batch.
+ * @param userData	The user data passed when the batch was started.
+ */
+typedef GLUSvoid (*GLUSimagebatchfunc)(GLUSimagebatchentry* entry, GLUSint index, GLUSvoid* userData);
+
+/**
+ * Structure for a batch, which is loaded in the background.
+ */
+typedef struct _GLUSimagebatch
+{
+	/**
+	 * Internal data.
+	 */
+	GLUSvoid* handle;
+
+} GLUSimagebatch;
+
+/**
+ * Starts loading the files of a batch in the background. The entries have to stay valid, until the batch is ended.
+ *
+ * @param batch			The batch structure to fill.
+ * @param entries		The files to load.
+ * @param numberEntries	The number of files.
+ * @param numberThreads	The maximum number of files loaded at the same time. If zero or less, the number of processors is used.
+ * @param callback		Function called after each file. Can be 0.
+ * @param userData		Passed to the callback.
+ *
+ * @return GLUS_TRUE, if the batch was started.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageBatchStart(GLUSimagebatch* batch, GLUSimagebatchentry* entries, const GLUSint numberEntries, const GLUSint numberThreads, GLUSimagebatchfunc callback, GLUSvoid* userData);
+
+/**
+ * Checks, if a file of a batch is loaded. Does not block.
+ *
+ * @param batch	The started batch.
+ * @param index	The index of the entry.
+ *
+ * @return GLUS_TRUE, if the file is loaded or failed to load and the callback has returned.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageBatchIsLoaded(GLUSimagebatch* batch, const GLUSint index);
+
+/**
+ * Waits until a file of a batch is loaded. The other files continue loading.
+ *
+ * @param batch	The started batch.
+ * @param index	The index of the entry.
+ *
+ * @return GLUS_TRUE, if loading of this file succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageBatchWait(GLUSimagebatch* batch, const GLUSint index);
+
+/**
+ * Waits until all files of a batch are loaded and releases the batch resources. The loaded images are kept.
+ *
+ * @param batch	The started batch.
+ *
+ * @return GLUS_TRUE, if all files were loaded successfully.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageBatchEnd(GLUSimagebatch* batch);
+
+/**
+ * Loads the files of a batch concurrently and returns, when all are loaded.
+ *
+ * @param entries		The files to load.
+ * @param numberEntries	The number of files.
+ * @param numberThreads	The maximum number of files loaded at the same time. If zero or less, the number of processors is used.
+ * @param callback		Function called after each file. Can be 0.
+ * @param userData		Passed to the callback.
+ *
+ * @return GLUS_TRUE, if all files were loaded successfully.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusImageLoadBatch(GLUSimagebatchentry* entries, const GLUSint numberEntries, const GLUSint numberThreads, GLUSimagebatchfunc callback, GLUSvoid* userData);
+
+#endif /* GLUS_IMAGE_BATCH_H_ */
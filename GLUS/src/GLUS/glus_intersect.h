@@ -33,4 +33,34 @@
  */
 GLUSAPI GLUSint GLUSAPIENTRY glusIntersectRaySpheref(GLUSfloat* tNear, GLUSfloat* tFar, GLUSboolean* insideSphere, const GLUSfloat rayStart[4], const GLUSfloat rayDirection[3], const GLUSfloat sphereCenter[4], const GLUSfloat radius);
 
+/**
+ * Intersecting ray against triangle. Both sides of the triangle are hit.
+ *
+ * @param t				t of the intersection point, if an intersection happened.
+ * @param u				Barycentric coordinate of the intersection point regarding the second point.
+ * @param v				Barycentric coordinate of the intersection point regarding the third point.
+ * @param rayStart		Point, where the ray starts.
+ * @param rayDirection	Ray direction vector.
+ * @param point0		First point of the triangle.
+ * @param point1		Second point of the triangle.
+ * @param point2		Third point of the triangle.
+ *
+ * @return GLUS_TRUE, if the ray hits the triangle in front of the start point.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusIntersectRayTrianglef(GLUSfloat* t, GLUSfloat* u, GLUSfloat* v, const GLUSfloat rayStart[4], const GLUSfloat rayDirection[3], const GLUSfloat point0[4], const GLUSfloat point1[4], const GLUSfloat point2[4]);
+
+/**
+ * Intersecting ray against axis aligned box.
+ *
+ * @param tNear			t, where the ray enters the box. Zero, if the ray starts inside the box.
+ * @param tFar			t, where the ray leaves the box.
+ * @param rayStart		Point, where the ray starts.
+ * @param rayDirection	Ray direction vector.
+ * @param center		The center of the box.
+ * @param halfExtend	The length from the center point to the planes of the box.
+ *
+ * @return GLUS_TRUE, if the ray hits the box in front of the start point.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusIntersectRayAxisAlignedBoxf(GLUSfloat* tNear, GLUSfloat* tFar, const GLUSfloat rayStart[4], const GLUSfloat rayDirection[3], const GLUSfloat center[4], const GLUSfloat halfExtend[3]);
+
 #endif /* GLUS_INTERSECT_H_ */
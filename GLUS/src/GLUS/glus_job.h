@@ -0,0 +1,154 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_JOB_H_
+#define GLUS_JOB_H_
+
+/**
+ * Function executed by a job.
+ *
+ * @param data The data passed during creation of the job.
+ */
+typedef GLUSvoid (*GLUSjobfunc)(GLUSvoid* data);
+
+/**
+ * Function executed for a range of indices.
+ *
+ * @param data	The data passed to the parallel for.
+ * @param begin	First index of the range.
+ * @param end	Index after the last index of the range.
+ */
+typedef GLUSvoid (*GLUSjobrangefunc)(GLUSvoid* data, const GLUSint begin, const GLUSint end);
+
+/**
+ * Structure for a job.
+ */
+typedef struct _GLUSjob
+{
+	/**
+	 * Internal data.
+	 */
+	GLUSvoid* handle;
+
+} GLUSjob;
+
+/**
+ * Starts the job system. Every worker thread owns a queue and steals jobs from the other queues, if its own queue is empty.
+ * The calling thread becomes the main thread, which runs the main thread jobs.
+ * While running, the threaded GLUS functions like the ray tracers use the workers instead of starting own threads.
+ *
+ * @param numberThreads Number of worker threads. If zero or less, one thread less than processors is used, but at least one.
+ *
+ * @return GLUS_TRUE, if the job system was started.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusJobSystemCreate(const GLUSint numberThreads);
+
+/**
+ * Waits for all submitted jobs and stops the job system. Has to be called from the main thread.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusJobSystemDestroy(GLUSvoid);
+
+/**
+ * Checks, if the job system is running.
+ *
+ * @return GLUS_TRUE, if the job system is running.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusJobSystemIsRunning(GLUSvoid);
+
+/**
+ * Gets the number of worker threads.
+ *
+ * @return The number of worker threads. Zero, if the job system is not running.
+ */
+GLUSAPI GLUSint GLUSAPIENTRY glusJobSystemGetNumberThreads(GLUSvoid);
+
+/**
+ * Creates a job. The job is not started before it is submitted, so dependencies can be added.
+ *
+ * @param job			The job structure to fill.
+ * @param function		The function executed by the job.
+ * @param data			The data passed to the function.
+ * @param mainThread	GLUS_TRUE, if the job has to run on the main thread e.g. because of OpenGL calls.
+ *
+ * @return GLUS_TRUE, if the job was created.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusJobCreate(GLUSjob* job, GLUSjobfunc function, GLUSvoid* data, const GLUSboolean mainThread);
+
+/**
+ * Lets a job run not before another job has finished.
+ *
+ * @param job			The job, which is not submitted yet.
+ * @param dependency	The job to wait for. Has not to be waited for or released yet.
+ *
+ * @return GLUS_TRUE, if the dependency was added.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusJobAddDependency(GLUSjob* job, GLUSjob* dependency);
+
+/**
+ * Submits a job. It runs, as soon as all its dependencies have finished.
+ *
+ * @param job The job to submit.
+ *
+ * @return GLUS_TRUE, if the job was submitted.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusJobSubmit(GLUSjob* job);
+
+/**
+ * Checks, if a submitted job has finished.
+ *
+ * @param job The job to check.
+ *
+ * @return GLUS_TRUE, if the job has finished.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusJobIsFinished(GLUSjob* job);
+
+/**
+ * Waits until a submitted job has finished and releases the job. While waiting, other jobs are run.
+ * Jobs depending on main thread jobs only finish, if the main thread waits or runs its jobs.
+ *
+ * @param job The job to wait for.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusJobWait(GLUSjob* job);
+
+/**
+ * Releases a job without waiting. A submitted job still runs.
+ *
+ * @param job The job to release.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusJobRelease(GLUSjob* job);
+
+/**
+ * Runs all queued main thread jobs. Called once per frame by the window loop.
+ *
+ * @return Number of jobs run. Zero, if not called from the main thread.
+ */
+GLUSAPI GLUSint GLUSAPIENTRY glusJobRunMainThread(GLUSvoid);
+
+/**
+ * Calls the function for all indices from zero to count in ranges of the grain size and waits until all have been processed.
+ * If the job system is not running, own threads are started.
+ *
+ * @param count		Number of indices.
+ * @param grainSize	Number of indices per range. If zero or less, the ranges are chosen depending on the number of threads.
+ * @param function	The function to call per range.
+ * @param data		The data passed to the function.
+ *
+ * @return GLUS_TRUE, if all ranges have been processed.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusJobParallelFor(const GLUSint count, const GLUSint grainSize, GLUSjobrangefunc function, GLUSvoid* data);
+
+#endif /* GLUS_JOB_H_ */
@@ -328,7 +328,7 @@ GLUSAPI GLUSfloat GLUSAPIENTRY glusMatrix3x3Determinantf(const GLUSfloat matrix[
 GLUSAPI GLUSfloat GLUSAPIENTRY glusMatrix2x2Determinantf(const GLUSfloat matrix[4]);
 
 /**
- * Calculates the inverse of a 4x4 matrix using Gaussian Elimination.
+ * Calculates the inverse of a 4x4 matrix using the determinant and adjunct of a matrix.
  *
  * @param matrix The matrix to be inverted.
  *
@@ -336,6 +336,16 @@ GLUSAPI GLUSfloat GLUSAPIENTRY glusMatrix2x2Determinantf(const GLUSfloat matrix[
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusMatrix4x4Inversef(GLUSfloat matrix[16]);
 
+/**
+ * Calculates the inverse of a 4x4 matrix by assuming it is an affine matrix, so the last row is 0, 0, 0, 1.
+ * Faster than glusMatrix4x4Inversef and, unlike glusMatrix4x4InverseRigidBodyf, allows non-uniform scaling and shearing.
+ *
+ * @param matrix The matrix to be inverted.
+ *
+ * @return GLUS_TRUE, if creation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusMatrix4x4InverseAffinef(GLUSfloat matrix[16]);
+
 /**
  * Calculates the inverse of a 3x3 matrix using the determinant and adjunct of a matrix.
  *
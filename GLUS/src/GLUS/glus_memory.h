@@ -18,6 +18,43 @@
 #ifndef GLUS_MEMORY_H_
 #define GLUS_MEMORY_H_
 
+/**
+ * Statistics of the memory pool.
+ */
+typedef struct _GLUSmemorystats
+{
+	/**
+	 * Size of the pool in bytes.
+	 */
+	size_t poolSize;
+
+	/**
+	 * Bytes of all allocated blocks, rounded up to their size class.
+	 */
+	size_t bytesInUse;
+
+	/**
+	 * Largest value of bytesInUse since the pool was set.
+	 */
+	size_t peakBytesInUse;
+
+	/**
+	 * Bytes of the pages holding blocks, including blocks cached by threads and not yet used parts of pages.
+	 */
+	size_t bytesCommitted;
+
+	/**
+	 * Size of the largest block, which can currently be allocated.
+	 */
+	size_t largestFreeBlock;
+
+	/**
+	 * Part of the free pages, which is not in the largest free block. Zero, if all free pages are contiguous.
+	 */
+	GLUSfloat fragmentation;
+
+} GLUSmemorystats;
+
 /**
  * Allocate memory block.
  *
@@ -34,4 +71,25 @@ GLUSAPI void* GLUSAPIENTRY glusMemoryMalloc(size_t size);
  */
 GLUSAPI void GLUSAPIENTRY glusMemoryFree(void* pointer);
 
+/**
+ * Sets the memory used by the pool allocator. Only possible, if no memory of the current pool is in use.
+ * Only available, if GLUS is built with the pool allocator, see glus_memory_nodm.c.
+ *
+ * @param memory	The memory to manage. If null, the default pool is used.
+ * @param size		Size of the memory in bytes.
+ *
+ * @return GLUS_TRUE, if the pool could be set.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusMemorySetPool(void* memory, size_t size);
+
+/**
+ * Gathers statistics of the pool allocator.
+ * Only available, if GLUS is built with the pool allocator, see glus_memory_nodm.c.
+ *
+ * @param stats	The statistics.
+ *
+ * @return GLUS_TRUE, if the statistics are available.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusMemoryGetStats(GLUSmemorystats* stats);
+
 #endif /* GLUS_MEMORY_H_ */
@@ -0,0 +1,108 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_MESH_H_
+#define GLUS_MESH_H_
+
+/**
+ * Mesh file containing a shape.
+ */
+#define GLUS_MESH_SHAPE 1
+
+/**
+ * Mesh file containing a scene.
+ */
+#define GLUS_MESH_SCENE 2
+
+/**
+ * Saves a shape as a binary mesh file.
+ *
+ * @param filename The name of the mesh file.
+ * @param shape The shape to save.
+ * @param sourceFilename Optional name of the file the shape was created from. Its modification time and size are stored.
+ *
+ * @return GLUS_TRUE, if saving succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusMeshSaveShape(const GLUSchar* filename, const GLUSshape* shape, const GLUSchar* sourceFilename);
+
+/**
+ * Loads a shape from a binary mesh file.
+ *
+ * @param filename The name of the mesh file.
+ * @param shape The data is stored into this structure.
+ * @param sourceFilename Optional name of the source file. If set, loading fails, if the source file has been changed since saving.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusMeshLoadShape(const GLUSchar* filename, GLUSshape* shape, const GLUSchar* sourceFilename);
+
+/**
+ * Saves a scene with objects, groups and materials as a binary mesh file.
+ *
+ * @param filename The name of the mesh file.
+ * @param scene The scene to save.
+ * @param sourceFilename Optional name of the file the scene was created from. Its modification time and size are stored.
+ *                       The modification time and size of each referenced material file are stored as well.
+ *
+ * @return GLUS_TRUE, if saving succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusMeshSaveScene(const GLUSchar* filename, const GLUSscene* scene, const GLUSchar* sourceFilename);
+
+/**
+ * Loads a scene from a binary mesh file.
+ *
+ * @param filename The name of the mesh file.
+ * @param scene The data is stored into this structure.
+ * @param sourceFilename Optional name of the source file. If set, loading fails, if the source file or one of its material files has been changed since saving.
+ *                       Only the stored stamps are compared, the source files are not read.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusMeshLoadScene(const GLUSchar* filename, GLUSscene* scene, const GLUSchar* sourceFilename);
+
+/**
+ * Converts a wavefront file to a binary mesh file.
+ *
+ * @param wavefrontFilename The name of the wavefront file including extension.
+ * @param meshFilename The name of the mesh file.
+ * @param type Either GLUS_MESH_SHAPE or GLUS_MESH_SCENE.
+ *
+ * @return GLUS_TRUE, if converting succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusMeshConvertWavefront(const GLUSchar* wavefrontFilename, const GLUSchar* meshFilename, const GLUSenum type);
+
+/**
+ * Loads a wavefront object file through a binary mesh file next to it. The mesh file is recreated, if the wavefront file has been changed.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param shape The data is stored into this structure.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeLoadWavefrontCached(const GLUSchar* filename, GLUSshape* shape);
+
+/**
+ * Loads a wavefront scene file through a binary mesh file next to it. The mesh file is recreated, if the wavefront file has been changed.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param scene The data is stored into this structure.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontLoadSceneCached(const GLUSchar* filename, GLUSscene* scene);
+
+#endif /* GLUS_MESH_H_ */
@@ -0,0 +1,141 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_OCEAN_H_
+#define GLUS_OCEAN_H_
+
+/**
+ * Ocean wave simulation on the CPU, following Tessendorf's "Simulating Ocean Water".
+ * The spectrum, the inverse FFT and the normal map match the compute shader passes of the ocean example.
+ */
+typedef struct _GLUSocean
+{
+	/**
+	 * Number of grid points on one side. Power of two.
+	 */
+	GLUSint n;
+
+	/**
+	 * Length of one side of the ocean grid.
+	 */
+	GLUSfloat length;
+
+	/**
+	 * Initial spectrum h0(k). Two floats per grid point, real and imaginary part, laid out like a RG32F texture.
+	 */
+	GLUSfloat* h0;
+
+	/**
+	 * Sum of h0(k) and h0(-k), real part.
+	 */
+	GLUSfloat* h0SumReal;
+
+	/**
+	 * Sum of h0(k) and h0(-k), imaginary part.
+	 */
+	GLUSfloat* h0SumImaginary;
+
+	/**
+	 * Angular frequency of each wave vector.
+	 */
+	GLUSfloat* omega;
+
+	/**
+	 * Spectrum at the current time and, after the inverse transform, the unsigned heights. Real part.
+	 */
+	GLUSfloat* real;
+
+	/**
+	 * Imaginary part of the spectrum.
+	 */
+	GLUSfloat* imaginary;
+
+	/**
+	 * Plan for the inverse transform of the rows and columns.
+	 */
+	GLUSfourierplan plan;
+
+	/**
+	 * Height displacement of each grid point. One channel, so the format is GLUS_RED.
+	 */
+	GLUShdrimage displacement;
+
+	/**
+	 * Normalized normal of each grid point. Format is GLUS_RGB.
+	 */
+	GLUShdrimage normal;
+
+	/**
+	 * Number of threads to use. If zero or less, the number of processors is used.
+	 */
+	GLUSint numberThreads;
+
+	/**
+	 * Time in seconds, the last update took.
+	 */
+	GLUSfloat updateTime;
+
+} GLUSocean;
+
+/**
+ * Creates an ocean and its initial spectrum out of the Phillips spectrum.
+ * The random numbers are drawn in the same order as in the ocean example, so the same seed gives the same spectrum.
+ *
+ * @param ocean			The ocean to create. Has to be destroyed with glusOceanDestroy.
+ * @param n				Number of grid points on one side. Has to be a power of two.
+ * @param length		Length of one side of the ocean grid.
+ * @param amplitude		Amplitude of the waves.
+ * @param windSpeed		Wind speed.
+ * @param windDirection	Wind direction in the x-z-plane. Does not have to be normalized.
+ * @param numberThreads	The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if creation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusOceanCreate(GLUSocean* ocean, const GLUSint n, const GLUSfloat length, const GLUSfloat amplitude, const GLUSfloat windSpeed, const GLUSfloat windDirection[2], const GLUSint numberThreads);
+
+/**
+ * Destroys an ocean by freeing the allocated memory.
+ *
+ * @param ocean The ocean to destroy.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusOceanDestroy(GLUSocean* ocean);
+
+/**
+ * Updates the spectrum to the given time, transforms it back and calculates the displacement and normal map.
+ * The time the update took is stored in the ocean.
+ *
+ * @param ocean		The ocean to update.
+ * @param totalTime	The total passed time.
+ *
+ * @return GLUS_TRUE, if updating succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusOceanUpdate(GLUSocean* ocean, const GLUSfloat totalTime);
+
+/**
+ * Saves the displacement and normal map as HDR images.
+ * As RGBE can not store negative values, positive heights are stored in red and negative heights in green.
+ * Normals are stored biased into the range [0.0, 1.0].
+ *
+ * @param displacementFilename	The filename of the displacement map. If null, it is not saved.
+ * @param normalFilename		The filename of the normal map. If null, it is not saved.
+ * @param ocean					The updated ocean.
+ *
+ * @return GLUS_TRUE, if saving succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusOceanSaveHdr(const GLUSchar* displacementFilename, const GLUSchar* normalFilename, const GLUSocean* ocean);
+
+#endif /* GLUS_OCEAN_H_ */
@@ -18,8 +18,12 @@
 #ifndef GLUS_PERLIN_H_
 #define GLUS_PERLIN_H_
 
+#define GLUS_PERLIN_GRADIENT	0x0001
+#define GLUS_PERLIN_SIMPLEX		0x0002
+
 /**
  * Creates a 1D perlin noise texture. See OpenGL Programming Guide 4.3, p.460ff
+ * Each octave adds gradient noise mapped to the range [0.0, amplitude * persistence^(octave + 1)], clamped to 255.
  *
  * @param image The perlin noise texture will be stored into this image.
  * @param width Width of the texture.
@@ -35,6 +39,7 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise1D(GLUStgaimage* image, co
 
 /**
  * Creates a 2D perlin noise texture. See OpenGL Programming Guide 4.3, p.460ff
+ * Each octave adds gradient noise mapped to the range [0.0, amplitude * persistence^(octave + 1)], clamped to 255.
  *
  * @param image The perlin noise texture will be stored into this image.
  * @param width Width of the texture.
@@ -51,6 +56,7 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise2D(GLUStgaimage* image, co
 
 /**
  * Creates a 3D perlin noise texture. See OpenGL Programming Guide 4.3, p.460ff
+ * Each octave adds gradient noise mapped to the range [0.0, amplitude * persistence^(octave + 1)], clamped to 255.
  *
  * @param image The perlin noise texture will be stored into this image.
  * @param width Width of the texture.
@@ -66,4 +72,87 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise2D(GLUStgaimage* image, co
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise3D(GLUStgaimage* image, const GLUSint width, const GLUSint height, const GLUSint depth, const GLUSint seed, const GLUSfloat frequency, const GLUSfloat amplitude, const GLUSfloat persistence, const GLUSint octaves);
 
+/**
+ * Evaluates 2D gradient noise. The lattice gradients are chosen by hashing the lattice coordinates, so no table is needed.
+ *
+ * @param x			X coordinate.
+ * @param y			Y coordinate.
+ * @param period	Number of lattice cells, after which the noise repeats per axis. If null or zero, the noise does not repeat.
+ * @param seed		Seed of the hash.
+ *
+ * @return The noise value in the range of about [-1.0, 1.0].
+ */
+GLUSAPI GLUSfloat GLUSAPIENTRY glusPerlinGradientNoise2f(const GLUSfloat x, const GLUSfloat y, const GLUSint period[2], const GLUSuint seed);
+
+/**
+ * Evaluates 3D gradient noise. The lattice gradients are chosen by hashing the lattice coordinates, so no table is needed.
+ *
+ * @param x			X coordinate.
+ * @param y			Y coordinate.
+ * @param z			Z coordinate.
+ * @param period	Number of lattice cells, after which the noise repeats per axis. If null or zero, the noise does not repeat.
+ * @param seed		Seed of the hash.
+ *
+ * @return The noise value in the range of about [-1.0, 1.0].
+ */
+GLUSAPI GLUSfloat GLUSAPIENTRY glusPerlinGradientNoise3f(const GLUSfloat x, const GLUSfloat y, const GLUSfloat z, const GLUSint period[3], const GLUSuint seed);
+
+/**
+ * Evaluates 2D simplex noise.
+ *
+ * @param x		X coordinate.
+ * @param y		Y coordinate.
+ * @param seed	Seed of the hash.
+ *
+ * @return The noise value in the range of about [-1.0, 1.0].
+ */
+GLUSAPI GLUSfloat GLUSAPIENTRY glusPerlinSimplexNoise2f(const GLUSfloat x, const GLUSfloat y, const GLUSuint seed);
+
+/**
+ * Evaluates 3D simplex noise.
+ *
+ * @param x		X coordinate.
+ * @param y		Y coordinate.
+ * @param z		Z coordinate.
+ * @param seed	Seed of the hash.
+ *
+ * @return The noise value in the range of about [-1.0, 1.0].
+ */
+GLUSAPI GLUSfloat GLUSAPIENTRY glusPerlinSimplexNoise3f(const GLUSfloat x, const GLUSfloat y, const GLUSfloat z, const GLUSuint seed);
+
+/**
+ * Evaluates 3D noise for several points at once. Four points are evaluated in parallel, if SSE2 or NEON is available.
+ *
+ * @param result	The resulting noise values.
+ * @param x			X coordinates of the points.
+ * @param y			Y coordinates of the points.
+ * @param z			Z coordinates of the points.
+ * @param number	Number of points.
+ * @param type		Either GLUS_PERLIN_GRADIENT or GLUS_PERLIN_SIMPLEX.
+ * @param period	Number of lattice cells, after which gradient noise repeats per axis. If null or zero, the noise does not repeat. Ignored for simplex noise.
+ * @param seed		Seed of the hash.
+ *
+ * @return GLUS_TRUE, if evaluation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusPerlinNoise3fv(GLUSfloat* result, const GLUSfloat* x, const GLUSfloat* y, const GLUSfloat* z, const GLUSint number, const GLUSenum type, const GLUSint period[3], const GLUSuint seed);
+
+/**
+ * Creates a noise texture as the sum of octaves. Each octave doubles the frequency and multiplies the amplitude by the persistence.
+ * Rows are generated in parallel. Gradient noise repeats after the image size, so the texture can be tiled.
+ *
+ * @param image			The noise texture will be stored into this image. Format is GLUS_SINGLE_CHANNEL. Has to be destroyed with glusImageDestroyHdr.
+ * @param width			Width of the texture.
+ * @param height		Height of the texture.
+ * @param depth			Depth of the texture.
+ * @param type			Either GLUS_PERLIN_GRADIENT or GLUS_PERLIN_SIMPLEX.
+ * @param frequency		Number of lattice cells along each side in the first octave. Rounded down to a whole number and limited to the size of the side.
+ * @param persistence	Persistence of the noise.
+ * @param octaves		Octaves of the noise.
+ * @param seed			Seed of the hash.
+ * @param numberThreads	The number of threads to use. If zero or less, the number of processors is used.
+ *
+ * @return GLUS_TRUE, if creation succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusPerlinCreateNoiseHdr(GLUShdrimage* image, const GLUSint width, const GLUSint height, const GLUSint depth, const GLUSenum type, const GLUSfloat frequency, const GLUSfloat persistence, const GLUSint octaves, const GLUSuint seed, const GLUSint numberThreads);
+
 #endif /* GLUS_PERLIN_H_ */
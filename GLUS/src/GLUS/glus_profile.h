@@ -18,6 +18,61 @@
 #ifndef GLUS_PROFILE_H_
 #define GLUS_PROFILE_H_
 
+/**
+ * Zone macros used by GLUS itself. Define GLUS_NO_PROFILE to compile them out.
+ */
+#ifdef GLUS_NO_PROFILE
+#define GLUS_PROFILE_BEGIN(name)
+#define GLUS_PROFILE_END()
+#define GLUS_PROFILE_FLUSH()
+#else
+#define GLUS_PROFILE_BEGIN(name) glusProfileBegin(name)
+#define GLUS_PROFILE_END() glusProfileEnd()
+#define GLUS_PROFILE_FLUSH() glusProfileFlush()
+#endif
+
+/**
+ * Statistics of all zones with the same name. Times are in nanoseconds.
+ */
+typedef struct _GLUSprofilezone
+{
+	/**
+	 * Name of the zone.
+	 */
+	const GLUSchar* name;
+
+	/**
+	 * Number of times the zone was entered.
+	 */
+	GLUSint count;
+
+	/**
+	 * Shortest time spent in the zone.
+	 */
+	GLUSuint64 minimum;
+
+	/**
+	 * Average time spent in the zone.
+	 */
+	GLUSuint64 average;
+
+	/**
+	 * 99 percent of the zones took this time or less.
+	 */
+	GLUSuint64 percentile99;
+
+	/**
+	 * Longest time spent in the zone.
+	 */
+	GLUSuint64 maximum;
+
+	/**
+	 * Sum of all times spent in the zone.
+	 */
+	GLUSuint64 total;
+
+} GLUSprofilezone;
+
 /**
  * Reset FPS profiling.
  */
@@ -33,4 +88,80 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusProfileResetFPSf();
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusProfileUpdateFPSf(GLUSfloat time, GLUSuint* frames);
 
+/**
+ * Starts recording of profile zones. Previously recorded zones are discarded.
+ *
+ * @param maxEvents Maximum number of zones to keep. If zero or less, 262144 zones are kept.
+ *
+ * @return GLUS_TRUE, if recording could be started.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusProfileStart(const GLUSint maxEvents);
+
+/**
+ * Stops recording of profile zones. The recorded zones are kept until the next start or clear.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusProfileStop(GLUSvoid);
+
+/**
+ * Discards the recorded zones and frees the memory.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusProfileClear(GLUSvoid);
+
+/**
+ * Checks, if profile zones are recorded.
+ *
+ * @return GLUS_TRUE, if recording.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusProfileIsRunning(GLUSvoid);
+
+/**
+ * Enters a zone on the calling thread. Zones can be nested and have to be left in reverse order.
+ * If not recording, only a flag is checked.
+ *
+ * @param name Name of the zone. Only the pointer is stored, so it has to stay valid, e.g. a string literal.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusProfileBegin(const GLUSchar* name);
+
+/**
+ * Leaves the last entered zone on the calling thread.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusProfileEnd(GLUSvoid);
+
+/**
+ * Collects the zones from the buffers of all threads. Called by the window loop once per frame.
+ * Each thread has a buffer for 4096 zones. If it is full, further zones are dropped.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusProfileFlush(GLUSvoid);
+
+/**
+ * Gets the statistics of the recorded zones, sorted by the total time.
+ *
+ * @param zones		Array to store the statistics. Can be a null pointer to query the number of zones.
+ * @param maxZones	Maximum number of zones to store.
+ *
+ * @return Number of different zones. Can be more than maxZones.
+ */
+GLUSAPI GLUSint GLUSAPIENTRY glusProfileGetZones(GLUSprofilezone* zones, const GLUSint maxZones);
+
+/**
+ * Gets the number of zones, which could not be recorded, as a buffer was full.
+ *
+ * @return Number of dropped zones.
+ */
+GLUSAPI GLUSint GLUSAPIENTRY glusProfileGetDroppedZones(GLUSvoid);
+
+/**
+ * Logs the statistics of all recorded zones.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusProfileLogZones(GLUSvoid);
+
+/**
+ * Saves the recorded zones in the Chrome trace event format. Can be opened with chrome://tracing.
+ *
+ * @param filename The file name of the JSON file.
+ *
+ * @return GLUS_TRUE, if saving was successful.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusProfileSaveChromeTrace(const GLUSchar* filename);
+
 #endif /* GLUS_PROFILE_H_ */
@@ -19,7 +19,20 @@
 #define GLUS_RANDOM_H_
 
 /**
- * Initializes the random generator.
+ * State of a xoshiro128** pseudo-random number generator. Each thread should use its own state.
+ */
+typedef struct _GLUSrandomstate
+{
+	/**
+	 * The 128 bit state. Is never zero in all elements.
+	 */
+	GLUSuint state[4];
+
+} GLUSrandomstate;
+
+/**
+ * Initializes the shared random generator, used by glusRandomUniformf and glusRandomNormalf.
+ * Every thread has its own shared generator, which starts as seeded with one. This function only seeds the one of the calling thread.
  *
  * @param seed Number for initializing the pseudo-random number generator.
  */
@@ -27,9 +40,10 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusRandomSetSeed(const GLUSuint seed);
 
 /**
  * Returns a uniform distributed random floating point value in the given range.
+ * Uses the shared random generator, so it should not be called from several threads.
  *
  * @param start Smallest possible generated value (inclusive).
- * @param end Largest possible generated value (inclusive).
+ * @param end Largest possible generated value (exclusive).
  *
  * @return The random value.
  */
@@ -37,6 +51,7 @@ GLUSAPI GLUSfloat GLUSAPIENTRY glusRandomUniformf(const GLUSfloat start, const G
 
 /**
  * Returns a normal distributed random floating point value.
+ * Uses the shared random generator, so it should not be called from several threads.
  *
  * @param mean 				Mean.
  * @param standardDeviation Standard deviation.
@@ -56,4 +71,97 @@ GLUSAPI GLUSfloat GLUSAPIENTRY glusRandomNormalf(const GLUSfloat mean, const GLU
  **/
 GLUSAPI GLUSboolean GLUSAPIENTRY glusRandomHammersleyf(GLUSfloat result[2], const GLUSuint sample, const GLUSubyte m);
 
+/**
+ * Samples several floating point value pairs from a Hammersley point set.
+ *
+ * @param result 	The resulting random values. Two values per sample are stored one after another.
+ * @param first		The first sample to take.
+ * @param number	The number of samples. All samples have to be in the range 0 <= sample < 2^m.
+ * @param m			Order m, which allows 2^m samples. Has to be in the range 0 < m <= 32.
+ *
+ * @return GLUS_TRUE, if sampling was successful.
+ **/
+GLUSAPI GLUSboolean GLUSAPIENTRY glusRandomHammersleyfv(GLUSfloat* result, const GLUSuint first, const GLUSint number, const GLUSubyte m);
+
+/**
+ * Samples several floating point value pairs from the first two dimensions of the Sobol sequence.
+ * Unlike the Hammersley point set, the number of samples does not have to be known in advance.
+ * The samples are enumerated in Gray code order, so every aligned block of 2^k samples covers the same points as in the original order.
+ *
+ * @param result 	The resulting random values in the range [0.0, 1.0[. Two values per sample are stored one after another.
+ * @param first		The first sample to take.
+ * @param number	The number of samples.
+ *
+ * @return GLUS_TRUE, if sampling was successful.
+ **/
+GLUSAPI GLUSboolean GLUSAPIENTRY glusRandomSobolfv(GLUSfloat* result, const GLUSuint first, const GLUSint number);
+
+/**
+ * Initializes a random generator state.
+ *
+ * @param randomState	The state to initialize.
+ * @param seed			Number for initializing the state.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusRandomStateSetSeed(GLUSrandomstate* randomState, const GLUSuint seed);
+
+/**
+ * Advances the state by 2^64 values. Calling it once, twice and so on for copies of one state gives non-overlapping streams for several threads.
+ *
+ * @param randomState	The state to advance.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusRandomStateJump(GLUSrandomstate* randomState);
+
+/**
+ * Returns a uniform distributed random 32 bit value.
+ *
+ * @param randomState	The state of the generator.
+ *
+ * @return The random value.
+ */
+GLUSAPI GLUSuint GLUSAPIENTRY glusRandomStateUniformui(GLUSrandomstate* randomState);
+
+/**
+ * Returns a uniform distributed random floating point value in the given range.
+ *
+ * @param randomState	The state of the generator.
+ * @param start			Smallest possible generated value (inclusive).
+ * @param end			Largest possible generated value (exclusive).
+ *
+ * @return The random value.
+ */
+GLUSAPI GLUSfloat GLUSAPIENTRY glusRandomStateUniformf(GLUSrandomstate* randomState, const GLUSfloat start, const GLUSfloat end);
+
+/**
+ * Returns a normal distributed random floating point value.
+ *
+ * @param randomState		The state of the generator.
+ * @param mean 				Mean.
+ * @param standardDeviation Standard deviation.
+ *
+ * @return The random value.
+ */
+GLUSAPI GLUSfloat GLUSAPIENTRY glusRandomStateNormalf(GLUSrandomstate* randomState, const GLUSfloat mean, const GLUSfloat standardDeviation);
+
+/**
+ * Fills an array with uniform distributed random floating point values in the given range.
+ *
+ * @param randomState	The state of the generator.
+ * @param result		The resulting random values.
+ * @param number		The number of values.
+ * @param start			Smallest possible generated value (inclusive).
+ * @param end			Largest possible generated value (exclusive).
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusRandomStateUniformfv(GLUSrandomstate* randomState, GLUSfloat* result, const GLUSint number, const GLUSfloat start, const GLUSfloat end);
+
+/**
+ * Fills an array with normal distributed random floating point values. Each Box-Muller transform gives two values.
+ *
+ * @param randomState		The state of the generator.
+ * @param result			The resulting random values.
+ * @param number			The number of values.
+ * @param mean 				Mean.
+ * @param standardDeviation Standard deviation.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusRandomStateNormalfv(GLUSrandomstate* randomState, GLUSfloat* result, const GLUSint number, const GLUSfloat mean, const GLUSfloat standardDeviation);
+
 #endif /* GLUS_RANDOM_H_ */
@@ -0,0 +1,186 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_RAYMARCH_SCENE_H_
+#define GLUS_RAYMARCH_SCENE_H_
+
+#define GLUS_RAYMARCH_SPHERE		0x0001
+#define GLUS_RAYMARCH_ORIENTED_BOX	0x0002
+
+/**
+ * Material of a ray marched primitive.
+ */
+typedef struct _GLUSraymarchmaterial
+{
+	/**
+	 * Emissive color.
+	 */
+	GLUSfloat emissiveColor[4];
+
+	/**
+	 * Diffuse color.
+	 */
+	GLUSfloat diffuseColor[4];
+
+	/**
+	 * Specular color.
+	 */
+	GLUSfloat specularColor[4];
+
+	/**
+	 * Specular exponent.
+	 */
+	GLUSfloat shininess;
+
+} GLUSraymarchmaterial;
+
+/**
+ * Primitive of a ray marched scene, described by its distance function.
+ */
+typedef struct _GLUSraymarchprimitive
+{
+	/**
+	 * Type of the primitive. Either GLUS_RAYMARCH_SPHERE or GLUS_RAYMARCH_ORIENTED_BOX.
+	 */
+	GLUSenum type;
+
+	/**
+	 * Center of the primitive in homogeneous coordinates.
+	 */
+	GLUSfloat center[4];
+
+	/**
+	 * Radius of a sphere.
+	 */
+	GLUSfloat radius;
+
+	/**
+	 * Length from the center to the planes of an oriented box.
+	 */
+	GLUSfloat halfExtend[3];
+
+	/**
+	 * Orientation of an oriented box as rotation angles in degrees around the x, y and z axis.
+	 */
+	GLUSfloat orientation[3];
+
+	/**
+	 * Material of the primitive.
+	 */
+	GLUSraymarchmaterial material;
+
+} GLUSraymarchprimitive;
+
+/**
+ * Description of a ray marched scene. The scene does not own the primitives and lights.
+ */
+typedef struct _GLUSraymarchscene
+{
+	/**
+	 * The primitives of the scene.
+	 */
+	const GLUSraymarchprimitive* primitives;
+
+	/**
+	 * Number of primitives.
+	 */
+	GLUSint numberPrimitives;
+
+	/**
+	 * The point lights of the scene.
+	 */
+	const GLUSraytracepointlight* pointLights;
+
+	/**
+	 * Number of point lights.
+	 */
+	GLUSint numberPointLights;
+
+	/**
+	 * Color, if a ray does not hit any primitive.
+	 */
+	GLUSfloat backgroundColor[4];
+
+	/**
+	 * Eye / camera position.
+	 */
+	GLUSfloat eye[3];
+
+	/**
+	 * Position, where the view / camera points to.
+	 */
+	GLUSfloat center[3];
+
+	/**
+	 * Up vector of the camera.
+	 */
+	GLUSfloat up[3];
+
+	/**
+	 * Vertical field of view in degrees.
+	 */
+	GLUSfloat fovy;
+
+	/**
+	 * Distance, when marching stops.
+	 */
+	GLUSfloat maxDistance;
+
+	/**
+	 * Maximum number of marching steps per ray.
+	 */
+	GLUSint maxSteps;
+
+	/**
+	 * Distance to a surface, which counts as a hit.
+	 */
+	GLUSfloat epsilon;
+
+	/**
+	 * Sharpness of the shadows. Larger values give harder penumbras. If zero or less, shadows are hard.
+	 */
+	GLUSfloat shadowSharpness;
+
+} GLUSraymarchscene;
+
+/**
+ * Ray marches the scene into an image. The image is divided into tiles, which are processed by several threads.
+ * Per tile, only the primitives, whose bounding spheres touch the view rays of the tile, are marched.
+ * The result does not depend on the number of threads.
+ *
+ * @param tgaimage		The image to render into. Has to be created with the format GLUS_RGB or GLUS_RGBA and a depth of one.
+ * @param scene			The scene to march.
+ * @param numberThreads	Number of threads to use, including the calling thread. If zero or less, one thread per processor is used.
+ *
+ * @return GLUS_TRUE, if rendering was successful.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusRaymarchSceneRender(GLUStgaimage* tgaimage, const GLUSraymarchscene* scene, const GLUSint numberThreads);
+
+/**
+ * Ray marches the scene and saves it as a TGA image. No window or rendering context is needed.
+ *
+ * @param filename		The file name of the image.
+ * @param width			Width of the image.
+ * @param height		Height of the image.
+ * @param scene			The scene to march.
+ * @param numberThreads	Number of threads to use, including the calling thread. If zero or less, one thread per processor is used.
+ *
+ * @return GLUS_TRUE, if rendering and saving was successful.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusRaymarchSceneSaveTga(const GLUSchar* filename, const GLUSint width, const GLUSint height, const GLUSraymarchscene* scene, const GLUSint numberThreads);
+
+#endif /* GLUS_RAYMARCH_SCENE_H_ */
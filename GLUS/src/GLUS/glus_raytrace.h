@@ -52,4 +52,44 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusRaytracePerspectivef(GLUSfloat* directionBu
  */
 GLUSAPI GLUSvoid GLUSAPIENTRY glusRaytraceLookAtf(GLUSfloat* positionBuffer, GLUSfloat* directionBuffer, const GLUSfloat* originDirectionBuffer, const GLUSubyte padding, const GLUSint width, const GLUSint height, const GLUSfloat eyeX, const GLUSfloat eyeY, const GLUSfloat eyeZ, const GLUSfloat centerX, const GLUSfloat centerY, const GLUSfloat centerZ, const GLUSfloat upX, const GLUSfloat upY, const GLUSfloat upZ);
 
+/**
+ * Creates normals in separated buffers for ray traced perspective projection. Directions are pointing to -Z direction.
+ * Rays are created eight at a time, if the processor supports AVX, otherwise four at a time, if SSE or NEON is available. The directions are equal to the ones of glusRaytracePerspectivef.
+ *
+ * @param directionX	The resulting x components of the directions. Has to hold width * height values.
+ * @param directionY	The resulting y components of the directions. Has to hold width * height values.
+ * @param directionZ	The resulting z components of the directions. Has to hold width * height values.
+ * @param fovy			Field of view.
+ * @param width			Width of the buffer.
+ * @param height		Height of the buffer.
+ *
+ * @return GLUS_TRUE, if creation was successful.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusRaytracePerspectiveSoAf(GLUSfloat* directionX, GLUSfloat* directionY, GLUSfloat* directionZ, const GLUSfloat fovy, const GLUSint width, const GLUSint height);
+
+/**
+ * Rotates the directions in separated buffers needed for ray tracing. All rays start at the eye position.
+ * The result and the origin buffers can be the same.
+ * Eight rays are rotated at a time, if the processor supports AVX, otherwise four at a time, if SSE or NEON is available.
+ *
+ * @param directionX		The resulting x components of the directions.
+ * @param directionY		The resulting y components of the directions.
+ * @param directionZ		The resulting z components of the directions.
+ * @param originDirectionX	The x components of the directions pointing to -Z direction.
+ * @param originDirectionY	The y components of the directions pointing to -Z direction.
+ * @param originDirectionZ	The z components of the directions pointing to -Z direction.
+ * @param width 			The width of the buffers.
+ * @param height 			The height of the buffers.
+ * @param eyeX 				Eye / camera X position.
+ * @param eyeY 				Eye / camera Y position.
+ * @param eyeZ 				Eye / camera Z position.
+ * @param centerX 			X Position, where the view / camera points to.
+ * @param centerY 			Y Position, where the view / camera points to.
+ * @param centerZ 			Z Position, where the view / camera points to.
+ * @param upX 				Eye / camera X component from up vector.
+ * @param upY 				Eye / camera Y component from up vector.
+ * @param upZ 				Eye / camera Z component from up vector.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusRaytraceLookAtSoAf(GLUSfloat* directionX, GLUSfloat* directionY, GLUSfloat* directionZ, const GLUSfloat* originDirectionX, const GLUSfloat* originDirectionY, const GLUSfloat* originDirectionZ, const GLUSint width, const GLUSint height, const GLUSfloat eyeX, const GLUSfloat eyeY, const GLUSfloat eyeZ, const GLUSfloat centerX, const GLUSfloat centerY, const GLUSfloat centerZ, const GLUSfloat upX, const GLUSfloat upY, const GLUSfloat upZ);
+
 #endif /* GLUS_RAYTRACE_H_ */
@@ -0,0 +1,201 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_RAYTRACE_SCENE_H_
+#define GLUS_RAYTRACE_SCENE_H_
+
+/**
+ * Material of a ray traced object.
+ */
+typedef struct _GLUSraytracematerial
+{
+	/**
+	 * Emissive color.
+	 */
+	GLUSfloat emissiveColor[4];
+
+	/**
+	 * Diffuse color.
+	 */
+	GLUSfloat diffuseColor[4];
+
+	/**
+	 * Specular color.
+	 */
+	GLUSfloat specularColor[4];
+
+	/**
+	 * Specular exponent.
+	 */
+	GLUSfloat shininess;
+
+	/**
+	 * Opacity. Values below one do refract the ray.
+	 */
+	GLUSfloat alpha;
+
+	/**
+	 * Reflectivity. Values above zero do reflect the ray.
+	 */
+	GLUSfloat reflectivity;
+
+	/**
+	 * Index of refraction of the material. The surrounding medium is air.
+	 */
+	GLUSfloat refractiveIndex;
+
+} GLUSraytracematerial;
+
+/**
+ * Ray traced sphere.
+ */
+typedef struct _GLUSraytracesphere
+{
+	/**
+	 * Center of the sphere in homogeneous coordinates.
+	 */
+	GLUSfloat center[4];
+
+	/**
+	 * Radius of the sphere.
+	 */
+	GLUSfloat radius;
+
+	/**
+	 * Material of the sphere.
+	 */
+	GLUSraytracematerial material;
+
+} GLUSraytracesphere;
+
+/**
+ * Point light illuminating a ray traced scene.
+ */
+typedef struct _GLUSraytracepointlight
+{
+	/**
+	 * Position of the light in homogeneous coordinates.
+	 */
+	GLUSfloat position[4];
+
+	/**
+	 * Color of the light.
+	 */
+	GLUSfloat color[4];
+
+} GLUSraytracepointlight;
+
+/**
+ * Description of a ray traced scene. The scene does not own the spheres and lights.
+ */
+typedef struct _GLUSraytracescene
+{
+	/**
+	 * The spheres of the scene.
+	 */
+	const GLUSraytracesphere* spheres;
+
+	/**
+	 * Number of spheres.
+	 */
+	GLUSint numberSpheres;
+
+	/**
+	 * The point lights of the scene.
+	 */
+	const GLUSraytracepointlight* pointLights;
+
+	/**
+	 * Number of point lights.
+	 */
+	GLUSint numberPointLights;
+
+	/**
+	 * Color, if a ray does not hit any object.
+	 */
+	GLUSfloat backgroundColor[4];
+
+	/**
+	 * Eye / camera position.
+	 */
+	GLUSfloat eye[3];
+
+	/**
+	 * Position, where the view / camera points to.
+	 */
+	GLUSfloat center[3];
+
+	/**
+	 * Up vector of the camera.
+	 */
+	GLUSfloat up[3];
+
+	/**
+	 * Vertical field of view in degrees.
+	 */
+	GLUSfloat fovy;
+
+	/**
+	 * Maximum recursion depth of reflected and refracted rays.
+	 */
+	GLUSint maxDepth;
+
+	/**
+	 * Optional bounding volume hierarchy over the spheres, created with glusBvhCreateSpheresf. If not set, all spheres are tested.
+	 * During rendering, a hierarchy is created for larger scenes, if not set.
+	 */
+	const GLUSbvh* bvh;
+
+} GLUSraytracescene;
+
+/**
+ * Traces one ray through the scene.
+ *
+ * @param pixelColor	The resulting color.
+ * @param scene			The scene to trace.
+ * @param rayPosition	Start position of the ray in homogeneous coordinates.
+ * @param rayDirection	Normalized direction of the ray.
+ * @param depth			Current recursion depth. Start with zero.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusRaytraceSceneTracef(GLUSfloat pixelColor[4], const GLUSraytracescene* scene, const GLUSfloat rayPosition[4], const GLUSfloat rayDirection[3], const GLUSint depth);
+
+/**
+ * Ray traces the scene into an image. The image is divided into tiles, which are processed by several threads.
+ * The result does not depend on the number of threads.
+ *
+ * @param tgaimage		The image to render into. Has to be created with the format GLUS_RGB or GLUS_RGBA and a depth of one.
+ * @param scene			The scene to trace.
+ * @param numberThreads	Number of threads to use, including the calling thread. If zero or less, one thread per processor is used.
+ *
+ * @return GLUS_TRUE, if rendering was successful.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusRaytraceSceneRender(GLUStgaimage* tgaimage, const GLUSraytracescene* scene, const GLUSint numberThreads);
+
+/**
+ * Ray traces the scene and saves it as a TGA image. No window or rendering context is needed.
+ *
+ * @param filename		The file name of the image.
+ * @param width			Width of the image.
+ * @param height		Height of the image.
+ * @param scene			The scene to trace.
+ * @param numberThreads	Number of threads to use, including the calling thread. If zero or less, one thread per processor is used.
+ *
+ * @return GLUS_TRUE, if rendering and saving was successful.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusRaytraceSceneSaveTga(const GLUSchar* filename, const GLUSint width, const GLUSint height, const GLUSraytracescene* scene, const GLUSint numberThreads);
+
+#endif /* GLUS_RAYTRACE_SCENE_H_ */
@@ -20,6 +20,7 @@
 
 /**
  * Creates a shape with adjacent index data for a triangle. Can be used in the geometry shader.
+ * Edges are looked up by their indices and, if not found, by their welded vertices. Non-manifold edges are reported as a warning.
  *
  * @param adjacencyShape 	The shape with additional adjacent index data.
  * @param sourceShape 		The source shape.
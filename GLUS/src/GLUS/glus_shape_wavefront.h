@@ -28,4 +28,14 @@
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeLoadWavefront(const GLUSchar* filename, GLUSshape* shape);
 
+/**
+ * Loads a wavefront object file. Equal vertex, normal and texture coordinate tuples are stored only once and referenced by the indices.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param shape The data is stored into this structure.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusShapeLoadWavefrontIndexed(const GLUSchar* filename, GLUSshape* shape);
+
 #endif /* GLUS_SHAPE_WAVEFRONT_H_ */
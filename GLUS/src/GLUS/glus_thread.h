@@ -0,0 +1,158 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GLUS_THREAD_H_
+#define GLUS_THREAD_H_
+
+/**
+ * Function executed by a thread.
+ *
+ * @param argument The argument passed during creation of the thread.
+ */
+typedef GLUSvoid (*GLUSthreadfunc)(GLUSvoid* argument);
+
+/**
+ * Structure for a thread.
+ */
+typedef struct _GLUSthread
+{
+	/**
+	 * Platform specific data.
+	 */
+	GLUSvoid* handle;
+
+} GLUSthread;
+
+/**
+ * Structure for a mutex.
+ */
+typedef struct _GLUSmutex
+{
+	/**
+	 * Platform specific data.
+	 */
+	GLUSvoid* handle;
+
+} GLUSmutex;
+
+/**
+ * Structure for a condition variable.
+ */
+typedef struct _GLUScondition
+{
+	/**
+	 * Platform specific data.
+	 */
+	GLUSvoid* handle;
+
+} GLUScondition;
+
+/**
+ * Retrieves the number of logical processors.
+ *
+ * @return The number of logical processors. At least one is returned.
+ */
+GLUSAPI GLUSint GLUSAPIENTRY glusThreadGetNumberProcessors(GLUSvoid);
+
+/**
+ * Creates and starts a thread.
+ *
+ * @param thread	The thread structure to fill.
+ * @param function	The function executed by the thread.
+ * @param argument	The argument passed to the function.
+ *
+ * @return GLUS_TRUE, if the thread was started.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusThreadCreate(GLUSthread* thread, GLUSthreadfunc function, GLUSvoid* argument);
+
+/**
+ * Waits until the thread has finished and releases its resources.
+ *
+ * @param thread The thread to wait for.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusThreadJoin(GLUSthread* thread);
+
+/**
+ * Creates a mutex.
+ *
+ * @param mutex The mutex structure to fill.
+ *
+ * @return GLUS_TRUE, if creation was successful.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusMutexCreate(GLUSmutex* mutex);
+
+/**
+ * Destroys a mutex.
+ *
+ * @param mutex The mutex to destroy. Has to be unlocked.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusMutexDestroy(GLUSmutex* mutex);
+
+/**
+ * Locks a mutex. Blocks, if the mutex is locked by another thread.
+ *
+ * @param mutex The mutex to lock.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusMutexLock(GLUSmutex* mutex);
+
+/**
+ * Unlocks a mutex.
+ *
+ * @param mutex The mutex to unlock.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusMutexUnlock(GLUSmutex* mutex);
+
+/**
+ * Creates a condition variable.
+ *
+ * @param condition The condition structure to fill.
+ *
+ * @return GLUS_TRUE, if creation was successful.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusConditionCreate(GLUScondition* condition);
+
+/**
+ * Destroys a condition variable.
+ *
+ * @param condition The condition variable to destroy. No thread is allowed to wait on it.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusConditionDestroy(GLUScondition* condition);
+
+/**
+ * Atomically unlocks the mutex and waits on the condition variable. The mutex is locked again before returning.
+ * As spurious wake ups are possible, the waited for state has to be checked again.
+ *
+ * @param condition	The condition variable to wait on.
+ * @param mutex		The locked mutex protecting the waited for state.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusConditionWait(GLUScondition* condition, GLUSmutex* mutex);
+
+/**
+ * Wakes up one thread waiting on the condition variable.
+ *
+ * @param condition The condition variable.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusConditionSignal(GLUScondition* condition);
+
+/**
+ * Wakes up all threads waiting on the condition variable.
+ *
+ * @param condition The condition variable.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusConditionBroadcast(GLUScondition* condition);
+
+#endif /* GLUS_THREAD_H_ */
@@ -28,5 +28,15 @@
  */
 GLUSAPI GLUSfloat GLUSAPIENTRY glusTimeGetTimestampf();
 
+/**
+ * Return the current monotonic time stamp in nanoseconds.
+ *
+ * Other than the float version, the precision does not get lost with a long uptime.
+ * The value is not related to the one of glusTimeGetTimestampf.
+ *
+ * @return The current time stamp in nanoseconds.
+ */
+GLUSAPI GLUSuint64 GLUSAPIENTRY glusTimeGetTimestampNanoseconds(GLUSvoid);
+
 
 #endif /* GLUS_TIME_H_ */
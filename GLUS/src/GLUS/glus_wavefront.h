@@ -335,6 +335,16 @@ typedef struct _GLUSscene
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontLoad(const GLUSchar* filename, GLUSwavefront* wavefront);
 
+/**
+ * Loads a wavefront object file with groups and materials. Equal vertex, normal and texture coordinate tuples are stored only once and referenced by the group indices.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param wavefront The data is stored into this structure.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontLoadIndexed(const GLUSchar* filename, GLUSwavefront* wavefront);
+
 /**
  * Destroys the wavefront structure by freeing the allocated memory. VBOs, VAOs and textures are not freed.
  *
@@ -352,6 +362,16 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusWavefrontDestroy(GLUSwavefront* wavefront);
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontLoadScene(const GLUSchar* filename, GLUSscene* scene);
 
+/**
+ * Loads a wavefront scene file with objects, groups and materials. Equal vertex, normal and texture coordinate tuples are stored only once per object and referenced by the group indices.
+ *
+ * @param filename The name of the wavefront file including extension.
+ * @param scene The data is stored into this structure.
+ *
+ * @return GLUS_TRUE, if loading succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWavefrontLoadSceneIndexed(const GLUSchar* filename, GLUSscene* scene);
+
 /**
  * Destroys the wavefront structure by freeing the allocated memory. VBOs, VAOs and textures are not freed.
  *
@@ -18,6 +18,162 @@
 #ifndef GLUS_WINDOW_H_
 #define GLUS_WINDOW_H_
 
+#define GLUS_RECORDING_TGA		0x0001
+#define GLUS_RECORDING_TGA_RLE	0x0002
+#define GLUS_RECORDING_Y4M		0x0003
+#define GLUS_RECORDING_RGB		0x0004
+#define GLUS_RECORDING_CUSTOM	0x0005
+
+/**
+ * Function receiving the recorded frames. Called from a background thread, so no OpenGL functions are allowed.
+ * The frames are passed one after another in the order of recording.
+ *
+ * @param frame			The RGBA frame. The first row is the bottom of the window.
+ * @param frameNumber	The number of the window frame, starting with zero. Dropped frames leave gaps.
+ * @param userData		The user data of the sink.
+ *
+ * @return GLUS_TRUE, if the frame could be processed.
+ */
+typedef GLUSboolean (*GLUSrecordingwritefunc)(const GLUStgaimage* frame, const GLUSint frameNumber, GLUSvoid* userData);
+
+/**
+ * Describes, where and how recorded frames are written.
+ */
+typedef struct _GLUSrecordingsink
+{
+	/**
+	 * Type of the sink. Can be:
+	 *
+	 * GLUS_RECORDING_TGA		One uncompressed TGA file per frame.
+	 * GLUS_RECORDING_TGA_RLE	One run length encoded TGA file per frame.
+	 * GLUS_RECORDING_Y4M		One YUV4MPEG2 stream with 4:4:4 sampling.
+	 * GLUS_RECORDING_RGB		One stream of raw 24 bit RGB frames, top row first.
+	 * GLUS_RECORDING_CUSTOM	Frames are passed to the write function.
+	 */
+	GLUSenum type;
+
+	/**
+	 * For TGA files, a template containing the frame number like "screenshot-%04d.tga". Exactly one integer conversion is allowed, a percent sign has to be written as "%%".
+	 * For streams, the file name. "-" writes to the standard output and "|command" writes to the standard input of the started command.
+	 */
+	const GLUSchar* filename;
+
+	/**
+	 * Function used by GLUS_RECORDING_CUSTOM. If it fails on a frame, no further frames are passed and the recording stops.
+	 */
+	GLUSrecordingwritefunc write;
+
+	/**
+	 * Passed to the write function.
+	 */
+	GLUSvoid* userData;
+
+	/**
+	 * Number of encoding threads. If zero or less, one less than the number of processors is used, but at least one.
+	 */
+	GLUSint numberThreads;
+
+	/**
+	 * Number of capture buffers. If zero or less, two more than the number of threads are used.
+	 */
+	GLUSint numberBuffers;
+
+	/**
+	 * If GLUS_TRUE, frames are dropped, when all buffers are in use. Otherwise, the window loop waits for a free buffer.
+	 */
+	GLUSboolean dropFrames;
+
+} GLUSrecordingsink;
+
+/**
+ * Statistics of a recording.
+ */
+typedef struct _GLUSrecordingstats
+{
+	/**
+	 * Frames read from the window.
+	 */
+	GLUSint capturedFrames;
+
+	/**
+	 * Frames written to the sink.
+	 */
+	GLUSint writtenFrames;
+
+	/**
+	 * Frames not captured, as all buffers were in use.
+	 */
+	GLUSint droppedFrames;
+
+	/**
+	 * Frames, which could not be encoded or written.
+	 */
+	GLUSint failedFrames;
+
+	/**
+	 * Captured frames, which are not yet written.
+	 */
+	GLUSint queuedFrames;
+
+	/**
+	 * Maximum number of queued frames during the recording.
+	 */
+	GLUSint maxQueuedFrames;
+
+	/**
+	 * Time in seconds the window loop spent on reading the frames and on waiting for free buffers.
+	 */
+	GLUSdouble captureTime;
+
+} GLUSrecordingstats;
+
+/**
+ * Statistics of a headless run. Times are in seconds.
+ */
+typedef struct _GLUSheadlessstats
+{
+	/**
+	 * Number of calls of the update function.
+	 */
+	GLUSint frames;
+
+	/**
+	 * Time spent in the init function.
+	 */
+	GLUSdouble initTime;
+
+	/**
+	 * Time spent in the terminate function.
+	 */
+	GLUSdouble terminateTime;
+
+	/**
+	 * Shortest time spent in the update function.
+	 */
+	GLUSdouble minimumFrameTime;
+
+	/**
+	 * Average time spent in the update function.
+	 */
+	GLUSdouble averageFrameTime;
+
+	/**
+	 * 99 percent of the frames took this time or less.
+	 */
+	GLUSdouble percentile99FrameTime;
+
+	/**
+	 * Longest time spent in the update function.
+	 */
+	GLUSdouble maximumFrameTime;
+
+	/**
+	 * Sum of all times spent in the update function.
+	 */
+	GLUSdouble totalFrameTime;
+
+} GLUSheadlessstats;
+
 /**
  * Creates the window. In this function, mainly GLEW and GLFW functions are used. By default, a RGBA color buffer is created.
  *
@@ -34,6 +190,45 @@
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusWindowCreate(const GLUSchar* title, const GLUSint width, const GLUSint height, const GLUSboolean fullscreen, const GLUSboolean noResize, const EGLint* configAttribList, const EGLint* contextAttribList, const EGLint* surfaceAttribList);
 
+/**
+ * Sets the headless mode. Has to be called before creating the window.
+ * In headless mode, the rendering context is created without a visible window.
+ * With GLFW, a hidden window is used. As GLFW can only create a context through a display, the window is created without a rendering context, if there is no display.
+ * Then only the CPU work of the application runs and no OpenGL function may be called, which can be checked with glusWindowHasContext().
+ * With EGL, the context renders into a pixel buffer surface of the default display. Mesa needs EGL_PLATFORM=surfaceless, if there is no display server.
+ * Running the main loop calls the init, reshape, update and terminate functions as fast as possible and logs the needed times. Buffers are not swapped.
+ *
+ * @param headless		GLUS_TRUE to enable the headless mode.
+ * @param numberFrames	Number of calls of the update function. If zero or less, the loop runs until the update function returns GLUS_FALSE.
+ * @param timeStep		Time passed to the update function. If zero, the measured time of the last update is passed.
+ *
+ * @return GLUS_TRUE, if the parameters are valid.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWindowSetHeadless(const GLUSboolean headless, const GLUSint numberFrames, const GLUSfloat timeStep);
+
+/**
+ * Checks, if the headless mode is set.
+ *
+ * @return GLUS_TRUE, if in headless mode.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWindowIsHeadless(GLUSvoid);
+
+/**
+ * Checks, if the window has a rendering context. Only in headless mode without a display, the GLFW window is created without one.
+ *
+ * @return GLUS_TRUE, if OpenGL functions can be called.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWindowHasContext(GLUSvoid);
+
+/**
+ * Gets the statistics of the last headless run.
+ *
+ * @param stats The structure to fill.
+ *
+ * @return GLUS_TRUE, if the statistics could be retrieved.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWindowGetHeadlessStats(GLUSheadlessstats* stats);
+
 /**
  * Cleans up the window and frees all resources. Only needs to be called, if creation of the window failed.
  */
@@ -110,6 +305,54 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusWindowSetReshapeFunc(GLUSvoid(*glusNewReshape)
  */
 GLUSAPI GLUSvoid GLUSAPIENTRY glusWindowSetUpdateFunc(GLUSboolean(*glusNewUpdate)(const GLUSfloat time));
 
+/**
+ * Sets the users simulate function, which is called with a fixed time step before the update function.
+ * Depending on the passed time, it is called several times or not at all per frame.
+ * Only used, if a fixed time step is set.
+ *
+ * @param glusNewSimulate The function pointer for the simulation. The time is the fixed time step. If it returns GLUS_FALSE, the application terminates.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusWindowSetSimulateFunc(GLUSboolean(*glusNewSimulate)(const GLUSfloat time));
+
+/**
+ * Sets the users publish function for a threaded simulation.
+ * It is called on the main thread before the update function, while the simulation thread is idle.
+ * The function has to copy the simulated state to the state, which is rendered by the update function.
+ *
+ * @param glusNewPublish The function pointer for publishing the simulated state.
+ */
+GLUSAPI GLUSvoid GLUSAPIENTRY glusWindowSetSimulatePublishFunc(GLUSvoid(*glusNewPublish)(GLUSvoid));
+
+/**
+ * Sets the fixed time step of the simulation. The update function still gets the passed time and is used for rendering.
+ * If running in an own thread, the simulation may not call OpenGL. Without a publish function, the steps of a frame are finished before the update function is called,
+ * so only the work outside the update function overlaps. With a publish function, the steps of a frame run in parallel to the update function,
+ * which renders the state published from the previous steps. The rendered state and a failed simulation are one frame late in this case.
+ *
+ * @param timeStep	The fixed time step in seconds. If zero, the simulate function is not called.
+ * @param maxSteps	Maximum number of steps per frame. Passed time exceeding these steps is dropped. If zero or less, eight steps are used.
+ * @param threaded	GLUS_TRUE, if the simulation should run in an own thread.
+ *
+ * @return GLUS_TRUE, if the time step is valid.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWindowSetFixedTimeStep(const GLUSfloat timeStep, const GLUSint maxSteps, const GLUSboolean threaded);
+
+/**
+ * Gets the remaining time, which was not simulated yet, as a fraction of the fixed time step.
+ * Can be used in the update function to interpolate between the last two simulated states.
+ * If the simulation is threaded and published, the factor belongs to the published state.
+ *
+ * @return The interpolation factor between zero and one. One, if no fixed time step is set.
+ */
+GLUSAPI GLUSfloat GLUSAPIENTRY glusWindowGetInterpolation(GLUSvoid);
+
+/**
+ * Gets the number of simulation steps, which were dropped because of the maximum steps per frame.
+ *
+ * @return The number of dropped steps since the fixed time step was set.
+ */
+GLUSAPI GLUSint GLUSAPIENTRY glusWindowGetDroppedSimulationSteps(GLUSvoid);
+
 /**
  * Sets the users terminate function, which is called in any case. It can be used to clean up resources.
  */
@@ -149,7 +392,7 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusWindowSetMouseWheelFunc(GLUSvoid(*glusNewMouse
 GLUSAPI GLUSvoid GLUSAPIENTRY glusWindowSetMouseMoveFunc(GLUSvoid(*glusNewMouseMove)(const GLUSint buttons, const GLUSint xPos, const GLUSint yPos));
 
 /**
- * Starts recording image clips, by making screenshots of the window.
+ * Starts recording image clips, by making screenshots of the window. The frames are saved as screenshot-0000.tga, screenshot-0001.tga and so on by background threads.
  *
  * @param numberFrames		The number of frames to record.
  * @param framesPerSecond	Frames per second to use.
@@ -158,6 +401,18 @@ GLUSAPI GLUSvoid GLUSAPIENTRY glusWindowSetMouseMoveFunc(GLUSvoid(*glusNewMouseM
  */
 GLUSAPI GLUSboolean GLUSAPIENTRY glusWindowStartRecording(GLUSint numberFrames, GLUSint framesPerSecond);
 
+/**
+ * Starts recording image clips into the given sink. The window content is read into a ring of capture buffers, which are encoded and written by background threads.
+ * If a frame of a stream or custom sink can not be written, the recording stops, as the following frames would not be in order.
+ *
+ * @param sink				Where and how the frames are written.
+ * @param numberFrames		The number of frames to record.
+ * @param framesPerSecond	Frames per second to use.
+ *
+ * @return GLUS_ TRUE, is start succeeded.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWindowStartRecordingSink(const GLUSrecordingsink* sink, GLUSint numberFrames, GLUSint framesPerSecond);
+
 /**
  * Checks, if a recording is running.
  *
@@ -166,10 +421,19 @@ GLUSAPI GLUSboolean GLUSAPIENTRY glusWindowStartRecording(GLUSint numberFrames,
 GLUSAPI GLUSboolean GLUSAPIENTRY glusWindowIsRecording(GLUSvoid);
 
 /**
- * Stops recording the image clips.
+ * Stops recording the image clips. Waits, until all captured frames are written.
  */
 GLUSAPI GLUSvoid GLUSAPIENTRY glusWindowStopRecording(GLUSvoid);
 
+/**
+ * Gets the statistics of the running or the last recording.
+ *
+ * @param stats The structure to fill.
+ *
+ * @return GLUS_TRUE, if the statistics could be retrieved.
+ */
+GLUSAPI GLUSboolean GLUSAPIENTRY glusWindowGetRecordingStats(GLUSrecordingstats* stats);
+
 /**
  * Get window width.
  *
@@ -177,6 +177,12 @@ extern "C"
 
 #include "../GLUS/glus_quaternion.h"
 
+//
+// Batched math functions.
+//
+
+#include "../GLUS/glus_batch.h"
+
 //
 // Complex numbers and vector functions.
 //
@@ -207,6 +213,13 @@ extern "C"
 
 #include "../GLUS/glus_time.h"
 
+//
+// Threading
+//
+
+#include "../GLUS/glus_thread.h"
+#include "../GLUS/glus_job.h"
+
 //
 // Ray tracing
 //
@@ -226,6 +239,7 @@ extern "C"
 #include "../GLUS/glus_image_tga.h"
 #include "../GLUS/glus_image_hdr.h"
 #include "../GLUS/glus_image_pkm.h"
+#include "../GLUS/glus_image_batch.h"
 
 #include "../GLUS/glus_file_text.h"
 #include "../GLUS/glus_file_binary.h"
@@ -0,0 +1,1330 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GLUS_BATCH_SSE
+#if (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || defined(__clang__)
+#include <immintrin.h>
+#define GLUS_BATCH_AVX
+#define GLUS_BATCH_AVX_TARGET __attribute__((target("avx")))
+#elif defined(_MSC_FULL_VER) && _MSC_FULL_VER >= 160040219
+#include <immintrin.h>
+#include <intrin.h>
+#define GLUS_BATCH_AVX
+#define GLUS_BATCH_AVX_TARGET
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GLUS_BATCH_NEON
+#endif
+
+#include "GL/glus.h"
+
+#define GLUS_BATCH_SET_UNKNOWN	-1
+#define GLUS_BATCH_SET_C		0
+#define GLUS_BATCH_SET_SSE2		1
+#define GLUS_BATCH_SET_AVX		2
+#define GLUS_BATCH_SET_NEON		3
+
+// Cody-Waite split of pi for the range reduction of the sine.
+#define GLUS_BATCH_PI_A 3.140625f
+#define GLUS_BATCH_PI_B 9.67653589793e-4f
+
+static GLUSint g_instructionSet = GLUS_BATCH_SET_UNKNOWN;
+
+#if defined(GLUS_BATCH_AVX)
+
+static GLUSboolean glusBatchHasAvx(GLUSvoid)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	GLUSint info[4];
+
+	__cpuid(info, 1);
+
+	// The processor has to support AVX and the operating system has to save the YMM registers.
+	if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0)
+	{
+		return GLUS_FALSE;
+	}
+
+	return (_xgetbv(0) & 6) == 6;
+#else
+	__builtin_cpu_init();
+
+	return __builtin_cpu_supports("avx") ? GLUS_TRUE : GLUS_FALSE;
+#endif
+}
+
+#endif
+
+/**
+ * The instruction set is detected once. Concurrent first calls do detect the same value.
+ */
+static GLUSint glusBatchGetInstructionSetIndex(GLUSvoid)
+{
+	if (g_instructionSet == GLUS_BATCH_SET_UNKNOWN)
+	{
+#if defined(GLUS_BATCH_AVX)
+		g_instructionSet = glusBatchHasAvx() ? GLUS_BATCH_SET_AVX : GLUS_BATCH_SET_SSE2;
+#elif defined(GLUS_BATCH_SSE)
+		g_instructionSet = GLUS_BATCH_SET_SSE2;
+#elif defined(GLUS_BATCH_NEON)
+		g_instructionSet = GLUS_BATCH_SET_NEON;
+#else
+		g_instructionSet = GLUS_BATCH_SET_C;
+#endif
+	}
+
+	return g_instructionSet;
+}
+
+#if defined(GLUS_BATCH_SSE) || defined(GLUS_BATCH_NEON)
+
+//
+// Four elements are processed at once. Matrix, point, plane and vector operations are done in the same order as in the scalar functions.
+//
+
+#if defined(GLUS_BATCH_SSE)
+
+typedef __m128 GLUSbatchfloat4;
+typedef __m128 GLUSbatchmask4;
+typedef __m128i GLUSbatchint4;
+
+static GLUSbatchfloat4 glusBatchSet4(const GLUSfloat value)
+{
+	return _mm_set1_ps(value);
+}
+
+static GLUSbatchfloat4 glusBatchLoad4(const GLUSfloat* values)
+{
+	return _mm_loadu_ps(values);
+}
+
+static GLUSvoid glusBatchStore4(GLUSfloat* values, const GLUSbatchfloat4 vector)
+{
+	_mm_storeu_ps(values, vector);
+}
+
+static GLUSbatchfloat4 glusBatchAdd4(const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return _mm_add_ps(a, b);
+}
+
+static GLUSbatchfloat4 glusBatchSub4(const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return _mm_sub_ps(a, b);
+}
+
+static GLUSbatchfloat4 glusBatchMul4(const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return _mm_mul_ps(a, b);
+}
+
+static GLUSbatchfloat4 glusBatchDiv4(const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return _mm_div_ps(a, b);
+}
+
+static GLUSbatchfloat4 glusBatchSqrt4(const GLUSbatchfloat4 value)
+{
+	return _mm_sqrt_ps(value);
+}
+
+static GLUSbatchfloat4 glusBatchAbs4(const GLUSbatchfloat4 value)
+{
+	return _mm_andnot_ps(_mm_set1_ps(-0.0f), value);
+}
+
+static GLUSbatchfloat4 glusBatchClamp4(const GLUSbatchfloat4 value, const GLUSfloat minValue, const GLUSfloat maxValue)
+{
+	return _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(minValue)), _mm_set1_ps(maxValue));
+}
+
+static GLUSbatchmask4 glusBatchEqual4(const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return _mm_cmpeq_ps(a, b);
+}
+
+static GLUSbatchmask4 glusBatchLess4(const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return _mm_cmplt_ps(a, b);
+}
+
+static GLUSbatchfloat4 glusBatchSelect4(const GLUSbatchmask4 mask, const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static GLUSboolean glusBatchAny4(const GLUSbatchmask4 mask)
+{
+	return _mm_movemask_ps(mask) != 0;
+}
+
+static GLUSfloat glusBatchGetW4(const GLUSbatchfloat4 vector)
+{
+	return _mm_cvtss_f32(_mm_shuffle_ps(vector, vector, _MM_SHUFFLE(3, 3, 3, 3)));
+}
+
+static GLUSbatchint4 glusBatchRound4(const GLUSbatchfloat4 value)
+{
+	return _mm_cvtps_epi32(value);
+}
+
+static GLUSbatchfloat4 glusBatchToFloat4(const GLUSbatchint4 value)
+{
+	return _mm_cvtepi32_ps(value);
+}
+
+static GLUSbatchfloat4 glusBatchNegateOdd4(const GLUSbatchfloat4 value, const GLUSbatchint4 integer)
+{
+	return _mm_xor_ps(value, _mm_castsi128_ps(_mm_slli_epi32(integer, 31)));
+}
+
+typedef __m128d GLUSbatchdouble2;
+typedef __m128d GLUSbatchmask2;
+
+static GLUSbatchdouble2 glusBatchSetDouble2(const GLUSdouble value)
+{
+	return _mm_set1_pd(value);
+}
+
+static GLUSbatchdouble2 glusBatchAddDouble2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 b)
+{
+	return _mm_add_pd(a, b);
+}
+
+static GLUSbatchdouble2 glusBatchSubDouble2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 b)
+{
+	return _mm_sub_pd(a, b);
+}
+
+static GLUSbatchdouble2 glusBatchMulDouble2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 b)
+{
+	return _mm_mul_pd(a, b);
+}
+
+static GLUSbatchdouble2 glusBatchDivDouble2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 b)
+{
+	return _mm_div_pd(a, b);
+}
+
+static GLUSbatchmask2 glusBatchEqualDouble2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 b)
+{
+	return _mm_cmpeq_pd(a, b);
+}
+
+/**
+ * Converts the lower or the upper two elements to double precision.
+ */
+static GLUSbatchdouble2 glusBatchWiden2(const GLUSbatchfloat4 value, const GLUSboolean upper)
+{
+	return _mm_cvtps_pd(upper ? _mm_movehl_ps(value, value) : value);
+}
+
+static GLUSbatchfloat4 glusBatchNarrow4(const GLUSbatchdouble2 lower, const GLUSbatchdouble2 upper)
+{
+	return _mm_movelh_ps(_mm_cvtpd_ps(lower), _mm_cvtpd_ps(upper));
+}
+
+static GLUSbatchmask4 glusBatchNarrowMask4(const GLUSbatchmask2 lower, const GLUSbatchmask2 upper)
+{
+	return _mm_shuffle_ps(_mm_castpd_ps(lower), _mm_castpd_ps(upper), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+/**
+ * Loads four quaternions, points or matrix columns, which are stride elements apart, and transposes them, so each vector holds one component.
+ */
+static GLUSvoid glusBatchLoadTransposed4(GLUSbatchfloat4 vectors[4], const GLUSfloat* values, const GLUSint stride)
+{
+	__m128 row0 = _mm_loadu_ps(values);
+	__m128 row1 = _mm_loadu_ps(values + stride);
+	__m128 row2 = _mm_loadu_ps(values + 2 * stride);
+	__m128 row3 = _mm_loadu_ps(values + 3 * stride);
+
+	_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+	vectors[0] = row0;
+	vectors[1] = row1;
+	vectors[2] = row2;
+	vectors[3] = row3;
+}
+
+static GLUSvoid glusBatchStoreTransposed4(GLUSfloat* values, const GLUSbatchfloat4 vectors[4], const GLUSint stride)
+{
+	__m128 row0 = vectors[0];
+	__m128 row1 = vectors[1];
+	__m128 row2 = vectors[2];
+	__m128 row3 = vectors[3];
+
+	_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+	_mm_storeu_ps(values, row0);
+	_mm_storeu_ps(values + stride, row1);
+	_mm_storeu_ps(values + 2 * stride, row2);
+	_mm_storeu_ps(values + 3 * stride, row3);
+}
+
+/**
+ * Loads four 3D vectors [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3] and deinterleaves them to [x0 x1 x2 x3] [y0 y1 y2 y3] [z0 z1 z2 z3].
+ */
+static GLUSvoid glusBatchLoadTransposed3(GLUSbatchfloat4 vectors[3], const GLUSfloat* values)
+{
+	__m128 v0 = _mm_loadu_ps(values);
+	__m128 v1 = _mm_loadu_ps(values + 4);
+	__m128 v2 = _mm_loadu_ps(values + 8);
+
+	vectors[0] = _mm_shuffle_ps(v0, _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+	vectors[1] = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+	vectors[2] = _mm_shuffle_ps(_mm_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+static GLUSvoid glusBatchStoreTransposed3(GLUSfloat* values, const GLUSbatchfloat4 vectors[3])
+{
+	__m128 x = vectors[0];
+	__m128 y = vectors[1];
+	__m128 z = vectors[2];
+
+	_mm_storeu_ps(values, _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+	_mm_storeu_ps(values + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+	_mm_storeu_ps(values + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+#else
+
+typedef float32x4_t GLUSbatchfloat4;
+typedef uint32x4_t GLUSbatchmask4;
+typedef int32x4_t GLUSbatchint4;
+
+static GLUSbatchfloat4 glusBatchSet4(const GLUSfloat value)
+{
+	return vdupq_n_f32(value);
+}
+
+static GLUSbatchfloat4 glusBatchLoad4(const GLUSfloat* values)
+{
+	return vld1q_f32(values);
+}
+
+static GLUSvoid glusBatchStore4(GLUSfloat* values, const GLUSbatchfloat4 vector)
+{
+	vst1q_f32(values, vector);
+}
+
+static GLUSbatchfloat4 glusBatchAdd4(const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return vaddq_f32(a, b);
+}
+
+static GLUSbatchfloat4 glusBatchSub4(const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return vsubq_f32(a, b);
+}
+
+static GLUSbatchfloat4 glusBatchMul4(const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return vmulq_f32(a, b);
+}
+
+static GLUSbatchfloat4 glusBatchDiv4(const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return vdivq_f32(a, b);
+}
+
+static GLUSbatchfloat4 glusBatchSqrt4(const GLUSbatchfloat4 value)
+{
+	return vsqrtq_f32(value);
+}
+
+static GLUSbatchfloat4 glusBatchAbs4(const GLUSbatchfloat4 value)
+{
+	return vabsq_f32(value);
+}
+
+static GLUSbatchfloat4 glusBatchClamp4(const GLUSbatchfloat4 value, const GLUSfloat minValue, const GLUSfloat maxValue)
+{
+	return vminq_f32(vmaxq_f32(value, vdupq_n_f32(minValue)), vdupq_n_f32(maxValue));
+}
+
+static GLUSbatchmask4 glusBatchEqual4(const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return vceqq_f32(a, b);
+}
+
+static GLUSbatchmask4 glusBatchLess4(const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return vcltq_f32(a, b);
+}
+
+static GLUSbatchfloat4 glusBatchSelect4(const GLUSbatchmask4 mask, const GLUSbatchfloat4 a, const GLUSbatchfloat4 b)
+{
+	return vbslq_f32(mask, a, b);
+}
+
+static GLUSboolean glusBatchAny4(const GLUSbatchmask4 mask)
+{
+	return vmaxvq_u32(mask) != 0;
+}
+
+static GLUSfloat glusBatchGetW4(const GLUSbatchfloat4 vector)
+{
+	return vgetq_lane_f32(vector, 3);
+}
+
+static GLUSbatchint4 glusBatchRound4(const GLUSbatchfloat4 value)
+{
+	return vcvtnq_s32_f32(value);
+}
+
+static GLUSbatchfloat4 glusBatchToFloat4(const GLUSbatchint4 value)
+{
+	return vcvtq_f32_s32(value);
+}
+
+static GLUSbatchfloat4 glusBatchNegateOdd4(const GLUSbatchfloat4 value, const GLUSbatchint4 integer)
+{
+	return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(value), vshlq_n_u32(vreinterpretq_u32_s32(integer), 31)));
+}
+
+typedef float64x2_t GLUSbatchdouble2;
+typedef uint64x2_t GLUSbatchmask2;
+
+static GLUSbatchdouble2 glusBatchSetDouble2(const GLUSdouble value)
+{
+	return vdupq_n_f64(value);
+}
+
+static GLUSbatchdouble2 glusBatchAddDouble2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 b)
+{
+	return vaddq_f64(a, b);
+}
+
+static GLUSbatchdouble2 glusBatchSubDouble2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 b)
+{
+	return vsubq_f64(a, b);
+}
+
+static GLUSbatchdouble2 glusBatchMulDouble2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 b)
+{
+	return vmulq_f64(a, b);
+}
+
+static GLUSbatchdouble2 glusBatchDivDouble2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 b)
+{
+	return vdivq_f64(a, b);
+}
+
+static GLUSbatchmask2 glusBatchEqualDouble2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 b)
+{
+	return vceqq_f64(a, b);
+}
+
+static GLUSbatchdouble2 glusBatchWiden2(const GLUSbatchfloat4 value, const GLUSboolean upper)
+{
+	return upper ? vcvt_high_f64_f32(value) : vcvt_f64_f32(vget_low_f32(value));
+}
+
+static GLUSbatchfloat4 glusBatchNarrow4(const GLUSbatchdouble2 lower, const GLUSbatchdouble2 upper)
+{
+	return vcvt_high_f32_f64(vcvt_f32_f64(lower), upper);
+}
+
+static GLUSbatchmask4 glusBatchNarrowMask4(const GLUSbatchmask2 lower, const GLUSbatchmask2 upper)
+{
+	return vcombine_u32(vmovn_u64(lower), vmovn_u64(upper));
+}
+
+static GLUSvoid glusBatchTranspose4(GLUSbatchfloat4 vectors[4])
+{
+	float32x4x2_t rows01 = vtrnq_f32(vectors[0], vectors[1]);
+	float32x4x2_t rows23 = vtrnq_f32(vectors[2], vectors[3]);
+
+	vectors[0] = vcombine_f32(vget_low_f32(rows01.val[0]), vget_low_f32(rows23.val[0]));
+	vectors[1] = vcombine_f32(vget_low_f32(rows01.val[1]), vget_low_f32(rows23.val[1]));
+	vectors[2] = vcombine_f32(vget_high_f32(rows01.val[0]), vget_high_f32(rows23.val[0]));
+	vectors[3] = vcombine_f32(vget_high_f32(rows01.val[1]), vget_high_f32(rows23.val[1]));
+}
+
+static GLUSvoid glusBatchLoadTransposed4(GLUSbatchfloat4 vectors[4], const GLUSfloat* values, const GLUSint stride)
+{
+	vectors[0] = vld1q_f32(values);
+	vectors[1] = vld1q_f32(values + stride);
+	vectors[2] = vld1q_f32(values + 2 * stride);
+	vectors[3] = vld1q_f32(values + 3 * stride);
+
+	glusBatchTranspose4(vectors);
+}
+
+static GLUSvoid glusBatchStoreTransposed4(GLUSfloat* values, const GLUSbatchfloat4 vectors[4], const GLUSint stride)
+{
+	GLUSbatchfloat4 rows[4];
+
+	rows[0] = vectors[0];
+	rows[1] = vectors[1];
+	rows[2] = vectors[2];
+	rows[3] = vectors[3];
+
+	glusBatchTranspose4(rows);
+
+	vst1q_f32(values, rows[0]);
+	vst1q_f32(values + stride, rows[1]);
+	vst1q_f32(values + 2 * stride, rows[2]);
+	vst1q_f32(values + 3 * stride, rows[3]);
+}
+
+static GLUSvoid glusBatchLoadTransposed3(GLUSbatchfloat4 vectors[3], const GLUSfloat* values)
+{
+	float32x4x3_t rows = vld3q_f32(values);
+
+	vectors[0] = rows.val[0];
+	vectors[1] = rows.val[1];
+	vectors[2] = rows.val[2];
+}
+
+static GLUSvoid glusBatchStoreTransposed3(GLUSfloat* values, const GLUSbatchfloat4 vectors[3])
+{
+	float32x4x3_t rows;
+
+	rows.val[0] = vectors[0];
+	rows.val[1] = vectors[1];
+	rows.val[2] = vectors[2];
+
+	vst3q_f32(values, rows);
+}
+
+#endif
+
+static GLUSvoid glusBatchMatrix4x4Multiply4(GLUSfloat matrix[16], const GLUSfloat matrix0[16], const GLUSfloat matrix1[16])
+{
+	GLUSint column;
+
+	GLUSbatchfloat4 temp[4];
+
+	GLUSbatchfloat4 column0 = glusBatchLoad4(matrix0);
+	GLUSbatchfloat4 column1 = glusBatchLoad4(matrix0 + 4);
+	GLUSbatchfloat4 column2 = glusBatchLoad4(matrix0 + 8);
+	GLUSbatchfloat4 column3 = glusBatchLoad4(matrix0 + 12);
+
+	for (column = 0; column < 4; column++)
+	{
+		temp[column] = glusBatchAdd4(glusBatchAdd4(glusBatchAdd4(glusBatchMul4(column0, glusBatchSet4(matrix1[column * 4])), glusBatchMul4(column1, glusBatchSet4(matrix1[column * 4 + 1]))), glusBatchMul4(column2, glusBatchSet4(matrix1[column * 4 + 2]))), glusBatchMul4(column3, glusBatchSet4(matrix1[column * 4 + 3])));
+	}
+
+	for (column = 0; column < 4; column++)
+	{
+		glusBatchStore4(matrix + column * 4, temp[column]);
+	}
+}
+
+static GLUSvoid glusBatchMatrix4x4MultiplyVectors4(GLUSfloat* result, const GLUSfloat matrix[16], const GLUSfloat* vectors, const GLUSint number, const GLUSboolean divide)
+{
+	GLUSint i;
+
+	GLUSfloat w;
+
+	GLUSbatchfloat4 temp;
+
+	GLUSbatchfloat4 column0 = glusBatchLoad4(matrix);
+	GLUSbatchfloat4 column1 = glusBatchLoad4(matrix + 4);
+	GLUSbatchfloat4 column2 = glusBatchLoad4(matrix + 8);
+	GLUSbatchfloat4 column3 = glusBatchLoad4(matrix + 12);
+
+	for (i = 0; i < number; i++)
+	{
+		temp = glusBatchAdd4(glusBatchAdd4(glusBatchAdd4(glusBatchMul4(column0, glusBatchSet4(vectors[i * 4])), glusBatchMul4(column1, glusBatchSet4(vectors[i * 4 + 1]))), glusBatchMul4(column2, glusBatchSet4(vectors[i * 4 + 2]))), glusBatchMul4(column3, glusBatchSet4(vectors[i * 4 + 3])));
+
+		if (divide)
+		{
+			w = glusBatchGetW4(temp);
+
+			if (w != 0.0f && w != 1.0f)
+			{
+				temp = glusBatchDiv4(temp, glusBatchSet4(w));
+			}
+		}
+
+		glusBatchStore4(result + i * 4, temp);
+	}
+}
+
+static GLUSboolean glusBatchVector3Normalize4(GLUSfloat* vectors)
+{
+	GLUSbatchfloat4 components[3];
+
+	GLUSbatchfloat4 length;
+
+	GLUSbatchmask4 zero;
+
+	GLUSint i;
+
+	glusBatchLoadTransposed3(components, vectors);
+
+	length = glusBatchSqrt4(glusBatchAdd4(glusBatchAdd4(glusBatchMul4(components[0], components[0]), glusBatchMul4(components[1], components[1])), glusBatchMul4(components[2], components[2])));
+
+	zero = glusBatchEqual4(length, glusBatchSet4(0.0f));
+
+	for (i = 0; i < 3; i++)
+	{
+		components[i] = glusBatchSelect4(zero, components[i], glusBatchDiv4(components[i], length));
+	}
+
+	glusBatchStoreTransposed3(vectors, components);
+
+	return !glusBatchAny4(zero);
+}
+
+static GLUSbatchdouble2 glusBatchDifference2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 x, const GLUSbatchdouble2 b, const GLUSbatchdouble2 y)
+{
+	return glusBatchSubDouble2(glusBatchMulDouble2(a, x), glusBatchMulDouble2(b, y));
+}
+
+/**
+ * (a * x - b * y + c * z) * invDet
+ */
+static GLUSbatchdouble2 glusBatchCofactor2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 x, const GLUSbatchdouble2 b, const GLUSbatchdouble2 y, const GLUSbatchdouble2 c, const GLUSbatchdouble2 z, const GLUSbatchdouble2 invDet)
+{
+	return glusBatchMulDouble2(glusBatchAddDouble2(glusBatchSubDouble2(glusBatchMulDouble2(a, x), glusBatchMulDouble2(b, y)), glusBatchMulDouble2(c, z)), invDet);
+}
+
+/**
+ * (-a * x + b * y - c * z) * invDet
+ */
+static GLUSbatchdouble2 glusBatchNegativeCofactor2(const GLUSbatchdouble2 a, const GLUSbatchdouble2 x, const GLUSbatchdouble2 b, const GLUSbatchdouble2 y, const GLUSbatchdouble2 c, const GLUSbatchdouble2 z, const GLUSbatchdouble2 invDet)
+{
+	return glusBatchMulDouble2(glusBatchSubDouble2(glusBatchSubDouble2(glusBatchMulDouble2(b, y), glusBatchMulDouble2(a, x)), glusBatchMulDouble2(c, z)), invDet);
+}
+
+/**
+ * Inverts two matrices in double precision. Each vector holds the same element of the two matrices.
+ *
+ * @return The mask of the matrices, which can not be inverted.
+ */
+static GLUSbatchmask2 glusBatchMatrix4x4Inverse2(GLUSbatchdouble2 result[16], const GLUSbatchdouble2 m[16])
+{
+	GLUSbatchdouble2 s0, s1, s2, s3, s4, s5;
+	GLUSbatchdouble2 c0, c1, c2, c3, c4, c5;
+
+	GLUSbatchdouble2 det;
+	GLUSbatchdouble2 invDet;
+
+	s0 = glusBatchDifference2(m[0], m[5], m[4], m[1]);
+	s1 = glusBatchDifference2(m[0], m[6], m[4], m[2]);
+	s2 = glusBatchDifference2(m[0], m[7], m[4], m[3]);
+	s3 = glusBatchDifference2(m[1], m[6], m[5], m[2]);
+	s4 = glusBatchDifference2(m[1], m[7], m[5], m[3]);
+	s5 = glusBatchDifference2(m[2], m[7], m[6], m[3]);
+
+	c5 = glusBatchDifference2(m[10], m[15], m[14], m[11]);
+	c4 = glusBatchDifference2(m[9], m[15], m[13], m[11]);
+	c3 = glusBatchDifference2(m[9], m[14], m[13], m[10]);
+	c2 = glusBatchDifference2(m[8], m[15], m[12], m[11]);
+	c1 = glusBatchDifference2(m[8], m[14], m[12], m[10]);
+	c0 = glusBatchDifference2(m[8], m[13], m[12], m[9]);
+
+	det = glusBatchAddDouble2(glusBatchSubDouble2(glusBatchAddDouble2(glusBatchAddDouble2(glusBatchSubDouble2(glusBatchMulDouble2(s0, c5), glusBatchMulDouble2(s1, c4)), glusBatchMulDouble2(s2, c3)), glusBatchMulDouble2(s3, c2)), glusBatchMulDouble2(s4, c1)), glusBatchMulDouble2(s5, c0));
+
+	invDet = glusBatchDivDouble2(glusBatchSetDouble2(1.0), det);
+
+	result[0] = glusBatchCofactor2(m[5], c5, m[6], c4, m[7], c3, invDet);
+	result[1] = glusBatchNegativeCofactor2(m[1], c5, m[2], c4, m[3], c3, invDet);
+	result[2] = glusBatchCofactor2(m[13], s5, m[14], s4, m[15], s3, invDet);
+	result[3] = glusBatchNegativeCofactor2(m[9], s5, m[10], s4, m[11], s3, invDet);
+
+	result[4] = glusBatchNegativeCofactor2(m[4], c5, m[6], c2, m[7], c1, invDet);
+	result[5] = glusBatchCofactor2(m[0], c5, m[2], c2, m[3], c1, invDet);
+	result[6] = glusBatchNegativeCofactor2(m[12], s5, m[14], s2, m[15], s1, invDet);
+	result[7] = glusBatchCofactor2(m[8], s5, m[10], s2, m[11], s1, invDet);
+
+	result[8] = glusBatchCofactor2(m[4], c4, m[5], c2, m[7], c0, invDet);
+	result[9] = glusBatchNegativeCofactor2(m[0], c4, m[1], c2, m[3], c0, invDet);
+	result[10] = glusBatchCofactor2(m[12], s4, m[13], s2, m[15], s0, invDet);
+	result[11] = glusBatchNegativeCofactor2(m[8], s4, m[9], s2, m[11], s0, invDet);
+
+	result[12] = glusBatchNegativeCofactor2(m[4], c3, m[5], c1, m[6], c0, invDet);
+	result[13] = glusBatchCofactor2(m[0], c3, m[1], c1, m[2], c0, invDet);
+	result[14] = glusBatchNegativeCofactor2(m[12], s3, m[13], s1, m[14], s0, invDet);
+	result[15] = glusBatchCofactor2(m[8], s3, m[9], s1, m[10], s0, invDet);
+
+	return glusBatchEqualDouble2(det, glusBatchSetDouble2(0.0));
+}
+
+/**
+ * Inverts four matrices at once. The calculation is the same as in glusMatrix4x4Inversef, so the results are equal.
+ */
+static GLUSboolean glusBatchMatrix4x4Inverse4(GLUSfloat* result, const GLUSfloat* matrices)
+{
+	GLUSbatchfloat4 m[16];
+
+	GLUSbatchdouble2 lower[16];
+	GLUSbatchdouble2 upper[16];
+
+	GLUSbatchdouble2 inverseLower[16];
+	GLUSbatchdouble2 inverseUpper[16];
+
+	GLUSbatchmask4 singular;
+
+	GLUSint i;
+
+	// Afterwards, each vector holds the same element of the four matrices.
+	for (i = 0; i < 4; i++)
+	{
+		glusBatchLoadTransposed4(m + i * 4, matrices + i * 4, 16);
+	}
+
+	for (i = 0; i < 16; i++)
+	{
+		lower[i] = glusBatchWiden2(m[i], GLUS_FALSE);
+		upper[i] = glusBatchWiden2(m[i], GLUS_TRUE);
+	}
+
+	singular = glusBatchNarrowMask4(glusBatchMatrix4x4Inverse2(inverseLower, lower), glusBatchMatrix4x4Inverse2(inverseUpper, upper));
+
+	// Singular matrices are not changed.
+	for (i = 0; i < 16; i++)
+	{
+		m[i] = glusBatchSelect4(singular, m[i], glusBatchNarrow4(inverseLower[i], inverseUpper[i]));
+	}
+
+	for (i = 0; i < 4; i++)
+	{
+		glusBatchStoreTransposed4(result + i * 4, m + i * 4, 16);
+	}
+
+	return !glusBatchAny4(singular);
+}
+
+/**
+ * Arc cosine of values in the range from -1.0 to 1.0, using the arc sine polynomial of the Cephes library.
+ */
+static GLUSbatchfloat4 glusBatchAcos4(const GLUSbatchfloat4 value)
+{
+	GLUSbatchfloat4 absolute = glusBatchAbs4(value);
+
+	GLUSbatchmask4 large = glusBatchLess4(glusBatchSet4(0.5f), absolute);
+	GLUSbatchmask4 negative = glusBatchLess4(value, glusBatchSet4(0.0f));
+
+	// For values larger than 0.5, asin(x) = pi/2 - 2 * asin(sqrt((1 - x) / 2)) is used.
+	GLUSbatchfloat4 z = glusBatchSelect4(large, glusBatchMul4(glusBatchSet4(0.5f), glusBatchSub4(glusBatchSet4(1.0f), absolute)), glusBatchMul4(absolute, absolute));
+	GLUSbatchfloat4 x = glusBatchSelect4(large, glusBatchSqrt4(z), absolute);
+
+	GLUSbatchfloat4 asinX;
+	GLUSbatchfloat4 polynomial = glusBatchSet4(4.2163199048e-2f);
+
+	polynomial = glusBatchAdd4(glusBatchMul4(polynomial, z), glusBatchSet4(2.4181311049e-2f));
+	polynomial = glusBatchAdd4(glusBatchMul4(polynomial, z), glusBatchSet4(4.5470025998e-2f));
+	polynomial = glusBatchAdd4(glusBatchMul4(polynomial, z), glusBatchSet4(7.4953002686e-2f));
+	polynomial = glusBatchAdd4(glusBatchMul4(polynomial, z), glusBatchSet4(1.6666752422e-1f));
+
+	asinX = glusBatchAdd4(glusBatchMul4(glusBatchMul4(polynomial, z), x), x);
+
+	return glusBatchSelect4(large, glusBatchSelect4(negative, glusBatchSub4(glusBatchSet4(GLUS_PI), glusBatchAdd4(asinX, asinX)), glusBatchAdd4(asinX, asinX)), glusBatchSub4(glusBatchSet4(GLUS_PI * 0.5f), glusBatchSelect4(negative, glusBatchSub4(glusBatchSet4(0.0f), asinX), asinX)));
+}
+
+/**
+ * Sine, reduced by multiples of pi to the range from -pi/2 to pi/2 and evaluated by its Taylor polynomial.
+ */
+static GLUSbatchfloat4 glusBatchSin4(const GLUSbatchfloat4 value)
+{
+	GLUSbatchint4 multiple = glusBatchRound4(glusBatchMul4(value, glusBatchSet4(1.0f / GLUS_PI)));
+
+	GLUSbatchfloat4 floatMultiple = glusBatchToFloat4(multiple);
+
+	GLUSbatchfloat4 x = glusBatchSub4(glusBatchSub4(value, glusBatchMul4(floatMultiple, glusBatchSet4(GLUS_BATCH_PI_A))), glusBatchMul4(floatMultiple, glusBatchSet4(GLUS_BATCH_PI_B)));
+
+	GLUSbatchfloat4 x2 = glusBatchMul4(x, x);
+
+	GLUSbatchfloat4 polynomial = glusBatchSet4(-2.5052108385e-8f);
+
+	polynomial = glusBatchAdd4(glusBatchMul4(polynomial, x2), glusBatchSet4(2.7557319224e-6f));
+	polynomial = glusBatchAdd4(glusBatchMul4(polynomial, x2), glusBatchSet4(-1.9841269841e-4f));
+	polynomial = glusBatchAdd4(glusBatchMul4(polynomial, x2), glusBatchSet4(8.3333333333e-3f));
+	polynomial = glusBatchAdd4(glusBatchMul4(polynomial, x2), glusBatchSet4(-1.6666666667e-1f));
+
+	// sin(x + k * pi) = (-1)^k * sin(x)
+	return glusBatchNegateOdd4(glusBatchAdd4(glusBatchMul4(glusBatchMul4(polynomial, x2), x), x), multiple);
+}
+
+static GLUSboolean glusBatchQuaternionSlerp4(GLUSfloat* result, const GLUSfloat* quaternions0, const GLUSfloat* quaternions1, const GLUSfloat* t)
+{
+	GLUSbatchfloat4 q0[4];
+	GLUSbatchfloat4 q1[4];
+
+	GLUSbatchfloat4 factor = glusBatchLoad4(t);
+
+	GLUSbatchfloat4 cosAlpha;
+	GLUSbatchfloat4 alpha;
+	GLUSbatchfloat4 sinAlpha;
+
+	GLUSbatchfloat4 a;
+	GLUSbatchfloat4 b;
+
+	GLUSbatchmask4 zero;
+
+	GLUSint i;
+
+	glusBatchLoadTransposed4(q0, quaternions0, 4);
+	glusBatchLoadTransposed4(q1, quaternions1, 4);
+
+	cosAlpha = glusBatchAdd4(glusBatchAdd4(glusBatchAdd4(glusBatchMul4(q0[0], q1[0]), glusBatchMul4(q0[1], q1[1])), glusBatchMul4(q0[2], q1[2])), glusBatchMul4(q0[3], q1[3]));
+
+	alpha = glusBatchAcos4(glusBatchClamp4(cosAlpha, -1.0f, 1.0f));
+
+	sinAlpha = glusBatchSin4(alpha);
+
+	zero = glusBatchEqual4(sinAlpha, glusBatchSet4(0.0f));
+
+	a = glusBatchDiv4(glusBatchSin4(glusBatchMul4(alpha, glusBatchSub4(glusBatchSet4(1.0f), factor))), sinAlpha);
+
+	b = glusBatchDiv4(glusBatchSin4(glusBatchMul4(alpha, factor)), sinAlpha);
+
+	for (i = 0; i < 4; i++)
+	{
+		q1[i] = glusBatchSelect4(zero, q0[i], glusBatchAdd4(glusBatchMul4(a, q0[i]), glusBatchMul4(b, q1[i])));
+	}
+
+	glusBatchStoreTransposed4(result, q1, 4);
+
+	return !glusBatchAny4(zero);
+}
+
+#endif
+
+#if defined(GLUS_BATCH_AVX)
+
+//
+// Two matrix columns, points or planes are processed at once. The 128 bit halves are independent, so the operations are the same as in the four element functions.
+//
+
+static GLUS_BATCH_AVX_TARGET __m256 glusBatchDuplicate8(const GLUSfloat* values)
+{
+	__m128 value = _mm_loadu_ps(values);
+
+	return _mm256_insertf128_ps(_mm256_castps128_ps256(value), value, 1);
+}
+
+static GLUS_BATCH_AVX_TARGET __m256 glusBatchSelect8(const __m256 mask, const __m256 a, const __m256 b)
+{
+	return _mm256_or_ps(_mm256_and_ps(mask, a), _mm256_andnot_ps(mask, b));
+}
+
+static GLUS_BATCH_AVX_TARGET GLUSvoid glusBatchMatrix4x4MultiplyAvx(GLUSfloat* result, const GLUSfloat* matrices0, const GLUSfloat* matrices1, const GLUSint number)
+{
+	GLUSint i;
+
+	__m256 column0;
+	__m256 column1;
+	__m256 column2;
+	__m256 column3;
+
+	__m256 columns01;
+	__m256 columns23;
+
+	for (i = 0; i < number; i++)
+	{
+		column0 = glusBatchDuplicate8(matrices0 + i * 16);
+		column1 = glusBatchDuplicate8(matrices0 + i * 16 + 4);
+		column2 = glusBatchDuplicate8(matrices0 + i * 16 + 8);
+		column3 = glusBatchDuplicate8(matrices0 + i * 16 + 12);
+
+		columns01 = _mm256_loadu_ps(matrices1 + i * 16);
+		columns23 = _mm256_loadu_ps(matrices1 + i * 16 + 8);
+
+		columns01 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(column0, _mm256_permute_ps(columns01, _MM_SHUFFLE(0, 0, 0, 0))), _mm256_mul_ps(column1, _mm256_permute_ps(columns01, _MM_SHUFFLE(1, 1, 1, 1)))), _mm256_mul_ps(column2, _mm256_permute_ps(columns01, _MM_SHUFFLE(2, 2, 2, 2)))), _mm256_mul_ps(column3, _mm256_permute_ps(columns01, _MM_SHUFFLE(3, 3, 3, 3))));
+		columns23 = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(column0, _mm256_permute_ps(columns23, _MM_SHUFFLE(0, 0, 0, 0))), _mm256_mul_ps(column1, _mm256_permute_ps(columns23, _MM_SHUFFLE(1, 1, 1, 1)))), _mm256_mul_ps(column2, _mm256_permute_ps(columns23, _MM_SHUFFLE(2, 2, 2, 2)))), _mm256_mul_ps(column3, _mm256_permute_ps(columns23, _MM_SHUFFLE(3, 3, 3, 3))));
+
+		_mm256_storeu_ps(result + i * 16, columns01);
+		_mm256_storeu_ps(result + i * 16 + 8, columns23);
+	}
+}
+
+/**
+ * Processes pairs of points or planes.
+ *
+ * @return The number of processed elements.
+ */
+static GLUS_BATCH_AVX_TARGET GLUSint glusBatchMatrix4x4MultiplyVectorsAvx(GLUSfloat* result, const GLUSfloat matrix[16], const GLUSfloat* vectors, const GLUSint number, const GLUSboolean divide)
+{
+	GLUSint i;
+
+	__m256 vector;
+	__m256 w;
+	__m256 mask;
+
+	__m256 column0 = glusBatchDuplicate8(matrix);
+	__m256 column1 = glusBatchDuplicate8(matrix + 4);
+	__m256 column2 = glusBatchDuplicate8(matrix + 8);
+	__m256 column3 = glusBatchDuplicate8(matrix + 12);
+
+	for (i = 0; i + 1 < number; i += 2)
+	{
+		vector = _mm256_loadu_ps(vectors + i * 4);
+
+		vector = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(column0, _mm256_permute_ps(vector, _MM_SHUFFLE(0, 0, 0, 0))), _mm256_mul_ps(column1, _mm256_permute_ps(vector, _MM_SHUFFLE(1, 1, 1, 1)))), _mm256_mul_ps(column2, _mm256_permute_ps(vector, _MM_SHUFFLE(2, 2, 2, 2)))), _mm256_mul_ps(column3, _mm256_permute_ps(vector, _MM_SHUFFLE(3, 3, 3, 3))));
+
+		if (divide)
+		{
+			w = _mm256_permute_ps(vector, _MM_SHUFFLE(3, 3, 3, 3));
+
+			mask = _mm256_and_ps(_mm256_cmp_ps(w, _mm256_setzero_ps(), _CMP_NEQ_UQ), _mm256_cmp_ps(w, _mm256_set1_ps(1.0f), _CMP_NEQ_UQ));
+
+			// Elements, which are not divided, are divided by one. For affine matrices, w is one and the division can be skipped.
+			if (_mm256_movemask_ps(mask) != 0)
+			{
+				vector = _mm256_div_ps(vector, glusBatchSelect8(mask, w, _mm256_set1_ps(1.0f)));
+			}
+		}
+
+		_mm256_storeu_ps(result + i * 4, vector);
+	}
+
+	return i;
+}
+
+/**
+ * Processes groups of eight vectors. Each 128 bit half deinterleaves four vectors like glusBatchLoadTransposed3.
+ *
+ * @return The number of processed elements.
+ */
+static GLUS_BATCH_AVX_TARGET GLUSint glusBatchVector3NormalizeAvx(GLUSboolean* normalized, GLUSfloat* vectors, const GLUSint number)
+{
+	GLUSint i;
+
+	GLUSfloat* current;
+
+	__m256 v0;
+	__m256 v1;
+	__m256 v2;
+
+	__m256 x;
+	__m256 y;
+	__m256 z;
+
+	__m256 length;
+	__m256 zero;
+
+	for (i = 0; i + 7 < number; i += 8)
+	{
+		current = vectors + i * 3;
+
+		v0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(current)), _mm_loadu_ps(current + 12), 1);
+		v1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(current + 4)), _mm_loadu_ps(current + 16), 1);
+		v2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(current + 8)), _mm_loadu_ps(current + 20), 1);
+
+		x = _mm256_shuffle_ps(v0, _mm256_shuffle_ps(v1, v2, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+		y = _mm256_shuffle_ps(_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(0, 0, 1, 1)), _mm256_shuffle_ps(v1, v2, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		z = _mm256_shuffle_ps(_mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(1, 1, 2, 2)), _mm256_shuffle_ps(v2, v2, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+		length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z)));
+
+		zero = _mm256_cmp_ps(length, _mm256_setzero_ps(), _CMP_EQ_OQ);
+
+		if (_mm256_movemask_ps(zero) != 0)
+		{
+			*normalized = GLUS_FALSE;
+		}
+
+		x = glusBatchSelect8(zero, x, _mm256_div_ps(x, length));
+		y = glusBatchSelect8(zero, y, _mm256_div_ps(y, length));
+		z = glusBatchSelect8(zero, z, _mm256_div_ps(z, length));
+
+		v0 = _mm256_shuffle_ps(_mm256_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+		v1 = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm256_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+		v2 = _mm256_shuffle_ps(_mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+
+		_mm_storeu_ps(current, _mm256_castps256_ps128(v0));
+		_mm_storeu_ps(current + 4, _mm256_castps256_ps128(v1));
+		_mm_storeu_ps(current + 8, _mm256_castps256_ps128(v2));
+		_mm_storeu_ps(current + 12, _mm256_extractf128_ps(v0, 1));
+		_mm_storeu_ps(current + 16, _mm256_extractf128_ps(v1, 1));
+		_mm_storeu_ps(current + 20, _mm256_extractf128_ps(v2, 1));
+	}
+
+	return i;
+}
+
+
+static GLUS_BATCH_AVX_TARGET __m256d glusBatchDifferenceAvx(const __m256d a, const __m256d x, const __m256d b, const __m256d y)
+{
+	return _mm256_sub_pd(_mm256_mul_pd(a, x), _mm256_mul_pd(b, y));
+}
+
+static GLUS_BATCH_AVX_TARGET __m256d glusBatchCofactorAvx(const __m256d a, const __m256d x, const __m256d b, const __m256d y, const __m256d c, const __m256d z, const __m256d invDet)
+{
+	return _mm256_mul_pd(_mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(a, x), _mm256_mul_pd(b, y)), _mm256_mul_pd(c, z)), invDet);
+}
+
+static GLUS_BATCH_AVX_TARGET __m256d glusBatchNegativeCofactorAvx(const __m256d a, const __m256d x, const __m256d b, const __m256d y, const __m256d c, const __m256d z, const __m256d invDet)
+{
+	return _mm256_mul_pd(_mm256_sub_pd(_mm256_sub_pd(_mm256_mul_pd(b, y), _mm256_mul_pd(a, x)), _mm256_mul_pd(c, z)), invDet);
+}
+
+/**
+ * Inverts groups of four matrices with four doubles per vector, like glusBatchMatrix4x4Inverse4.
+ *
+ * @return The number of processed matrices.
+ */
+static GLUS_BATCH_AVX_TARGET GLUSint glusBatchMatrix4x4InverseAvx(GLUSboolean* inverted, GLUSfloat* result, const GLUSfloat* matrices, const GLUSint number)
+{
+	GLUSint i;
+	GLUSint k;
+
+	__m128 rows[16];
+	__m128 singular;
+
+	__m256d m[16];
+	__m256d inverse[16];
+
+	__m256d s0, s1, s2, s3, s4, s5;
+	__m256d c0, c1, c2, c3, c4, c5;
+
+	__m256d det;
+	__m256d invDet;
+
+	for (i = 0; i + 3 < number; i += 4)
+	{
+		for (k = 0; k < 4; k++)
+		{
+			rows[k * 4] = _mm_loadu_ps(matrices + i * 16 + k * 4);
+			rows[k * 4 + 1] = _mm_loadu_ps(matrices + i * 16 + 16 + k * 4);
+			rows[k * 4 + 2] = _mm_loadu_ps(matrices + i * 16 + 32 + k * 4);
+			rows[k * 4 + 3] = _mm_loadu_ps(matrices + i * 16 + 48 + k * 4);
+
+			_MM_TRANSPOSE4_PS(rows[k * 4], rows[k * 4 + 1], rows[k * 4 + 2], rows[k * 4 + 3]);
+		}
+
+		for (k = 0; k < 16; k++)
+		{
+			m[k] = _mm256_cvtps_pd(rows[k]);
+		}
+
+		s0 = glusBatchDifferenceAvx(m[0], m[5], m[4], m[1]);
+		s1 = glusBatchDifferenceAvx(m[0], m[6], m[4], m[2]);
+		s2 = glusBatchDifferenceAvx(m[0], m[7], m[4], m[3]);
+		s3 = glusBatchDifferenceAvx(m[1], m[6], m[5], m[2]);
+		s4 = glusBatchDifferenceAvx(m[1], m[7], m[5], m[3]);
+		s5 = glusBatchDifferenceAvx(m[2], m[7], m[6], m[3]);
+
+		c5 = glusBatchDifferenceAvx(m[10], m[15], m[14], m[11]);
+		c4 = glusBatchDifferenceAvx(m[9], m[15], m[13], m[11]);
+		c3 = glusBatchDifferenceAvx(m[9], m[14], m[13], m[10]);
+		c2 = glusBatchDifferenceAvx(m[8], m[15], m[12], m[11]);
+		c1 = glusBatchDifferenceAvx(m[8], m[14], m[12], m[10]);
+		c0 = glusBatchDifferenceAvx(m[8], m[13], m[12], m[9]);
+
+		det = _mm256_add_pd(_mm256_sub_pd(_mm256_add_pd(_mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(s0, c5), _mm256_mul_pd(s1, c4)), _mm256_mul_pd(s2, c3)), _mm256_mul_pd(s3, c2)), _mm256_mul_pd(s4, c1)), _mm256_mul_pd(s5, c0));
+
+		invDet = _mm256_div_pd(_mm256_set1_pd(1.0), det);
+
+		inverse[0] = glusBatchCofactorAvx(m[5], c5, m[6], c4, m[7], c3, invDet);
+		inverse[1] = glusBatchNegativeCofactorAvx(m[1], c5, m[2], c4, m[3], c3, invDet);
+		inverse[2] = glusBatchCofactorAvx(m[13], s5, m[14], s4, m[15], s3, invDet);
+		inverse[3] = glusBatchNegativeCofactorAvx(m[9], s5, m[10], s4, m[11], s3, invDet);
+
+		inverse[4] = glusBatchNegativeCofactorAvx(m[4], c5, m[6], c2, m[7], c1, invDet);
+		inverse[5] = glusBatchCofactorAvx(m[0], c5, m[2], c2, m[3], c1, invDet);
+		inverse[6] = glusBatchNegativeCofactorAvx(m[12], s5, m[14], s2, m[15], s1, invDet);
+		inverse[7] = glusBatchCofactorAvx(m[8], s5, m[10], s2, m[11], s1, invDet);
+
+		inverse[8] = glusBatchCofactorAvx(m[4], c4, m[5], c2, m[7], c0, invDet);
+		inverse[9] = glusBatchNegativeCofactorAvx(m[0], c4, m[1], c2, m[3], c0, invDet);
+		inverse[10] = glusBatchCofactorAvx(m[12], s4, m[13], s2, m[15], s0, invDet);
+		inverse[11] = glusBatchNegativeCofactorAvx(m[8], s4, m[9], s2, m[11], s0, invDet);
+
+		inverse[12] = glusBatchNegativeCofactorAvx(m[4], c3, m[5], c1, m[6], c0, invDet);
+		inverse[13] = glusBatchCofactorAvx(m[0], c3, m[1], c1, m[2], c0, invDet);
+		inverse[14] = glusBatchNegativeCofactorAvx(m[12], s3, m[13], s1, m[14], s0, invDet);
+		inverse[15] = glusBatchCofactorAvx(m[8], s3, m[9], s1, m[10], s0, invDet);
+
+		// Narrowing the double mask gives all bits set for each singular matrix.
+		singular = _mm256_cvtpd_ps(_mm256_cmp_pd(det, _mm256_setzero_pd(), _CMP_EQ_OQ));
+		singular = _mm_cmpneq_ps(singular, _mm_setzero_ps());
+
+		if (_mm_movemask_ps(singular) != 0)
+		{
+			*inverted = GLUS_FALSE;
+		}
+
+		// Singular matrices are not changed.
+		for (k = 0; k < 16; k++)
+		{
+			rows[k] = _mm_or_ps(_mm_and_ps(singular, rows[k]), _mm_andnot_ps(singular, _mm256_cvtpd_ps(inverse[k])));
+		}
+
+		for (k = 0; k < 4; k++)
+		{
+			_MM_TRANSPOSE4_PS(rows[k * 4], rows[k * 4 + 1], rows[k * 4 + 2], rows[k * 4 + 3]);
+
+			_mm_storeu_ps(result + i * 16 + k * 4, rows[k * 4]);
+			_mm_storeu_ps(result + i * 16 + 16 + k * 4, rows[k * 4 + 1]);
+			_mm_storeu_ps(result + i * 16 + 32 + k * 4, rows[k * 4 + 2]);
+			_mm_storeu_ps(result + i * 16 + 48 + k * 4, rows[k * 4 + 3]);
+		}
+	}
+
+	return i;
+}
+
+#endif
+
+const GLUSchar* GLUSAPIENTRY glusBatchGetInstructionSet(GLUSvoid)
+{
+	switch (glusBatchGetInstructionSetIndex())
+	{
+		case GLUS_BATCH_SET_AVX:
+			return "AVX";
+		case GLUS_BATCH_SET_SSE2:
+			return "SSE2";
+		case GLUS_BATCH_SET_NEON:
+			return "NEON";
+	}
+
+	return "C";
+}
+
+/**
+ * The ray tracing functions use AVX only, if the batch functions do.
+ */
+GLUSboolean _glusBatchIsAvxEnabled(GLUSvoid)
+{
+	return glusBatchGetInstructionSetIndex() == GLUS_BATCH_SET_AVX;
+}
+
+GLUSvoid GLUSAPIENTRY glusBatchMatrix4x4Multiplyf(GLUSfloat* result, const GLUSfloat* matrices0, const GLUSfloat* matrices1, const GLUSint number)
+{
+	GLUSint i;
+
+	switch (glusBatchGetInstructionSetIndex())
+	{
+#if defined(GLUS_BATCH_AVX)
+		case GLUS_BATCH_SET_AVX:
+			glusBatchMatrix4x4MultiplyAvx(result, matrices0, matrices1, number);
+
+			return;
+#endif
+#if defined(GLUS_BATCH_SSE) || defined(GLUS_BATCH_NEON)
+		case GLUS_BATCH_SET_SSE2:
+		case GLUS_BATCH_SET_NEON:
+			for (i = 0; i < number; i++)
+			{
+				glusBatchMatrix4x4Multiply4(result + i * 16, matrices0 + i * 16, matrices1 + i * 16);
+			}
+
+			return;
+#endif
+	}
+
+	for (i = 0; i < number; i++)
+	{
+		glusMatrix4x4Multiplyf(result + i * 16, matrices0 + i * 16, matrices1 + i * 16);
+	}
+}
+
+static GLUSvoid glusBatchMatrix4x4MultiplyVectors(GLUSfloat* result, const GLUSfloat matrix[16], const GLUSfloat* vectors, const GLUSint number, const GLUSboolean divide)
+{
+	GLUSint i = 0;
+
+	switch (glusBatchGetInstructionSetIndex())
+	{
+#if defined(GLUS_BATCH_AVX)
+		case GLUS_BATCH_SET_AVX:
+			i = glusBatchMatrix4x4MultiplyVectorsAvx(result, matrix, vectors, number, divide);
+
+			glusBatchMatrix4x4MultiplyVectors4(result + i * 4, matrix, vectors + i * 4, number - i, divide);
+
+			return;
+#endif
+#if defined(GLUS_BATCH_SSE) || defined(GLUS_BATCH_NEON)
+		case GLUS_BATCH_SET_SSE2:
+		case GLUS_BATCH_SET_NEON:
+			glusBatchMatrix4x4MultiplyVectors4(result, matrix, vectors, number, divide);
+
+			return;
+#endif
+	}
+
+	for (i = 0; i < number; i++)
+	{
+		if (divide)
+		{
+			glusMatrix4x4MultiplyPoint4f(result + i * 4, matrix, vectors + i * 4);
+		}
+		else
+		{
+			glusMatrix4x4MultiplyPlanef(result + i * 4, matrix, vectors + i * 4);
+		}
+	}
+}
+
+GLUSvoid GLUSAPIENTRY glusBatchMatrix4x4MultiplyPoint4f(GLUSfloat* result, const GLUSfloat matrix[16], const GLUSfloat* points, const GLUSint number)
+{
+	glusBatchMatrix4x4MultiplyVectors(result, matrix, points, number, GLUS_TRUE);
+}
+
+GLUSvoid GLUSAPIENTRY glusBatchMatrix4x4MultiplyPlanef(GLUSfloat* result, const GLUSfloat matrix[16], const GLUSfloat* planes, const GLUSint number)
+{
+	glusBatchMatrix4x4MultiplyVectors(result, matrix, planes, number, GLUS_FALSE);
+}
+
+GLUSboolean GLUSAPIENTRY glusBatchVector3Normalizef(GLUSfloat* vectors, const GLUSint number)
+{
+	GLUSboolean normalized = GLUS_TRUE;
+
+	GLUSint i = 0;
+
+	switch (glusBatchGetInstructionSetIndex())
+	{
+#if defined(GLUS_BATCH_AVX)
+		case GLUS_BATCH_SET_AVX:
+			i = glusBatchVector3NormalizeAvx(&normalized, vectors, number);
+			// Fall through.
+#endif
+#if defined(GLUS_BATCH_SSE) || defined(GLUS_BATCH_NEON)
+		case GLUS_BATCH_SET_SSE2:
+		case GLUS_BATCH_SET_NEON:
+			for (; i + 3 < number; i += 4)
+			{
+				if (!glusBatchVector3Normalize4(vectors + i * 3))
+				{
+					normalized = GLUS_FALSE;
+				}
+			}
+			break;
+#endif
+	}
+
+	for (; i < number; i++)
+	{
+		if (!glusVector3Normalizef(vectors + i * 3))
+		{
+			normalized = GLUS_FALSE;
+		}
+	}
+
+	return normalized;
+}
+
+GLUSboolean GLUSAPIENTRY glusBatchMatrix4x4Inversef(GLUSfloat* result, const GLUSfloat* matrices, const GLUSint number)
+{
+	GLUSboolean inverted = GLUS_TRUE;
+
+	GLUSint i = 0;
+
+	switch (glusBatchGetInstructionSetIndex())
+	{
+#if defined(GLUS_BATCH_AVX)
+		case GLUS_BATCH_SET_AVX:
+			i = glusBatchMatrix4x4InverseAvx(&inverted, result, matrices, number);
+			break;
+#endif
+#if defined(GLUS_BATCH_SSE) || defined(GLUS_BATCH_NEON)
+		case GLUS_BATCH_SET_SSE2:
+		case GLUS_BATCH_SET_NEON:
+			for (; i + 3 < number; i += 4)
+			{
+				if (!glusBatchMatrix4x4Inverse4(result + i * 16, matrices + i * 16))
+				{
+					inverted = GLUS_FALSE;
+				}
+			}
+			break;
+#endif
+	}
+
+	// The scalar function gives the same results, so it is used for the remaining matrices.
+	for (; i < number; i++)
+	{
+		if (result != matrices)
+		{
+			glusMatrix4x4Copyf(result + i * 16, matrices + i * 16, GLUS_FALSE);
+		}
+
+		if (!glusMatrix4x4Inversef(result + i * 16))
+		{
+			inverted = GLUS_FALSE;
+		}
+	}
+
+	return inverted;
+}
+
+GLUSboolean GLUSAPIENTRY glusBatchQuaternionSlerpf(GLUSfloat* result, const GLUSfloat* quaternions0, const GLUSfloat* quaternions1, const GLUSfloat* t, const GLUSint number)
+{
+	GLUSboolean interpolated = GLUS_TRUE;
+
+	GLUSint i = 0;
+
+#if defined(GLUS_BATCH_SSE) || defined(GLUS_BATCH_NEON)
+	GLUSfloat remainder0[16];
+	GLUSfloat remainder1[16];
+	GLUSfloat remainderT[4];
+
+	GLUSint k;
+
+	if (glusBatchGetInstructionSetIndex() != GLUS_BATCH_SET_C)
+	{
+		for (; i + 3 < number; i += 4)
+		{
+			if (!glusBatchQuaternionSlerp4(result + i * 4, quaternions0 + i * 4, quaternions1 + i * 4, t + i))
+			{
+				interpolated = GLUS_FALSE;
+			}
+		}
+
+		if (i < number)
+		{
+			// The remaining pairs are padded, so all pairs are interpolated by the same approximation.
+			for (k = 0; k < 4; k++)
+			{
+				if (i + k < number)
+				{
+					glusQuaternionCopyf(remainder0 + k * 4, quaternions0 + (i + k) * 4);
+					glusQuaternionCopyf(remainder1 + k * 4, quaternions1 + (i + k) * 4);
+					remainderT[k] = t[i + k];
+				}
+				else
+				{
+					glusQuaternionIdentityf(remainder0 + k * 4);
+					glusQuaternionRotateRxf(remainder1 + k * 4, 90.0f);
+					remainderT[k] = 0.0f;
+				}
+			}
+
+			if (!glusBatchQuaternionSlerp4(remainder0, remainder0, remainder1, remainderT))
+			{
+				interpolated = GLUS_FALSE;
+			}
+
+			for (k = 0; i + k < number; k++)
+			{
+				glusQuaternionCopyf(result + (i + k) * 4, remainder0 + k * 4);
+			}
+		}
+
+		return interpolated;
+	}
+#endif
+
+	for (; i < number; i++)
+	{
+		if (!glusQuaternionSlerpf(result + i * 4, quaternions0 + i * 4, quaternions1 + i * 4, t[i]))
+		{
+			interpolated = GLUS_FALSE;
+		}
+	}
+
+	return interpolated;
+}
@@ -0,0 +1,761 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+#define GLUS_BVH_BINS 16
+
+#define GLUS_BVH_MAX_LEAF_PRIMITIVES 4
+
+// Limits the traversal stack.
+#define GLUS_BVH_MAX_DEPTH 64
+
+// Cost of traversing a node relative to intersecting a primitive.
+#define GLUS_BVH_TRAVERSAL_COST 1.0f
+
+typedef struct _GLUSbvhbuild
+{
+	GLUSbvh* bvh;
+
+	// Minimum and maximum corner per primitive.
+	GLUSfloat* bounds;
+
+	GLUSfloat* centroids;
+
+} GLUSbvhbuild;
+
+static GLUSvoid glusBvhEmptyBox(GLUSfloat box[6])
+{
+	box[0] = INFINITY;
+	box[1] = INFINITY;
+	box[2] = INFINITY;
+	box[3] = -INFINITY;
+	box[4] = -INFINITY;
+	box[5] = -INFINITY;
+}
+
+static GLUSvoid glusBvhGrowBox(GLUSfloat box[6], const GLUSfloat other[6])
+{
+	GLUSint i;
+
+	// Called for every primitive and bin, so no function calls.
+	for (i = 0; i < 3; i++)
+	{
+		if (other[i] < box[i])
+		{
+			box[i] = other[i];
+		}
+		if (other[i + 3] > box[i + 3])
+		{
+			box[i + 3] = other[i + 3];
+		}
+	}
+}
+
+static GLUSfloat glusBvhBoxArea(const GLUSfloat box[6])
+{
+	GLUSfloat dx = box[3] - box[0];
+	GLUSfloat dy = box[4] - box[1];
+	GLUSfloat dz = box[5] - box[2];
+
+	if (dx < 0.0f || dy < 0.0f || dz < 0.0f)
+	{
+		return 0.0f;
+	}
+
+	return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+static GLUSint glusBvhBin(const GLUSfloat centroid, const GLUSfloat minimum, const GLUSfloat extend)
+{
+	GLUSint bin = (GLUSint)((centroid - minimum) * (GLUSfloat)GLUS_BVH_BINS / extend);
+
+	if (bin < 0)
+	{
+		return 0;
+	}
+
+	if (bin >= GLUS_BVH_BINS)
+	{
+		return GLUS_BVH_BINS - 1;
+	}
+
+	return bin;
+}
+
+static GLUSvoid glusBvhBuildNode(GLUSbvhbuild* build, const GLUSint nodeIndex, const GLUSint begin, const GLUSint end, const GLUSint depth)
+{
+	GLUSbvh* bvh = build->bvh;
+	GLUSbvhnode* node = &bvh->nodes[nodeIndex];
+
+	GLUSfloat box[6], centroidBox[6];
+
+	GLUSfloat binBoxes[GLUS_BVH_BINS][6];
+	GLUSint binCounts[GLUS_BVH_BINS];
+
+	GLUSfloat leftAreas[GLUS_BVH_BINS];
+	GLUSint leftCounts[GLUS_BVH_BINS];
+
+	GLUSfloat sweepBox[6];
+	GLUSint sweepCount;
+
+	GLUSfloat cost, bestCost, extend;
+	GLUSint bestAxis, bestBin;
+
+	GLUSint i, k, axis, primitive, count, middle, left;
+
+	glusBvhEmptyBox(box);
+	glusBvhEmptyBox(centroidBox);
+
+	for (i = begin; i < end; i++)
+	{
+		primitive = bvh->primitives[i];
+
+		glusBvhGrowBox(box, &build->bounds[primitive * 6]);
+
+		for (k = 0; k < 3; k++)
+		{
+			if (build->centroids[primitive * 3 + k] < centroidBox[k])
+			{
+				centroidBox[k] = build->centroids[primitive * 3 + k];
+			}
+			if (build->centroids[primitive * 3 + k] > centroidBox[k + 3])
+			{
+				centroidBox[k + 3] = build->centroids[primitive * 3 + k];
+			}
+		}
+	}
+
+	for (k = 0; k < 3; k++)
+	{
+		node->minimum[k] = box[k];
+		node->maximum[k] = box[k + 3];
+	}
+
+	count = end - begin;
+
+	node->index = begin;
+	node->numberPrimitives = count;
+
+	if (count == 1 || depth >= GLUS_BVH_MAX_DEPTH)
+	{
+		return;
+	}
+
+	// Binned surface area heuristic
+
+	bestCost = INFINITY;
+	bestAxis = -1;
+	bestBin = 0;
+
+	for (axis = 0; axis < 3; axis++)
+	{
+		extend = centroidBox[axis + 3] - centroidBox[axis];
+
+		if (extend <= 0.0f)
+		{
+			continue;
+		}
+
+		for (i = 0; i < GLUS_BVH_BINS; i++)
+		{
+			glusBvhEmptyBox(binBoxes[i]);
+			binCounts[i] = 0;
+		}
+
+		for (i = begin; i < end; i++)
+		{
+			primitive = bvh->primitives[i];
+
+			k = glusBvhBin(build->centroids[primitive * 3 + axis], centroidBox[axis], extend);
+
+			glusBvhGrowBox(binBoxes[k], &build->bounds[primitive * 6]);
+			binCounts[k]++;
+		}
+
+		glusBvhEmptyBox(sweepBox);
+		sweepCount = 0;
+
+		for (i = 0; i < GLUS_BVH_BINS - 1; i++)
+		{
+			glusBvhGrowBox(sweepBox, binBoxes[i]);
+			sweepCount += binCounts[i];
+
+			leftAreas[i] = glusBvhBoxArea(sweepBox);
+			leftCounts[i] = sweepCount;
+		}
+
+		glusBvhEmptyBox(sweepBox);
+		sweepCount = 0;
+
+		for (i = GLUS_BVH_BINS - 1; i > 0; i--)
+		{
+			glusBvhGrowBox(sweepBox, binBoxes[i]);
+			sweepCount += binCounts[i];
+
+			// Split between bin i - 1 and i.
+			if (leftCounts[i - 1] == 0 || sweepCount == 0)
+			{
+				continue;
+			}
+
+			cost = leftAreas[i - 1] * (GLUSfloat)leftCounts[i - 1] + glusBvhBoxArea(sweepBox) * (GLUSfloat)sweepCount;
+
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				bestAxis = axis;
+				bestBin = i;
+			}
+		}
+	}
+
+	if (bestAxis >= 0)
+	{
+		// Compare splitting against keeping the primitives in a leaf.
+		if (count <= GLUS_BVH_MAX_LEAF_PRIMITIVES && GLUS_BVH_TRAVERSAL_COST * glusBvhBoxArea(box) + bestCost >= glusBvhBoxArea(box) * (GLUSfloat)count)
+		{
+			return;
+		}
+
+		extend = centroidBox[bestAxis + 3] - centroidBox[bestAxis];
+
+		i = begin;
+		k = end - 1;
+
+		while (i <= k)
+		{
+			primitive = bvh->primitives[i];
+
+			if (glusBvhBin(build->centroids[primitive * 3 + bestAxis], centroidBox[bestAxis], extend) < bestBin)
+			{
+				i++;
+			}
+			else
+			{
+				bvh->primitives[i] = bvh->primitives[k];
+				bvh->primitives[k] = primitive;
+
+				k--;
+			}
+		}
+
+		middle = i;
+	}
+	else
+	{
+		// All centroids are equal, so only the number of primitives can be reduced.
+		if (count <= GLUS_BVH_MAX_LEAF_PRIMITIVES)
+		{
+			return;
+		}
+
+		middle = (begin + end) / 2;
+	}
+
+	if (middle == begin || middle == end)
+	{
+		middle = (begin + end) / 2;
+	}
+
+	left = bvh->numberNodes;
+
+	bvh->numberNodes += 2;
+
+	node->index = left;
+	node->numberPrimitives = 0;
+
+	glusBvhBuildNode(build, left, begin, middle, depth + 1);
+	glusBvhBuildNode(build, left + 1, middle, end, depth + 1);
+}
+
+static GLUSboolean glusBvhBuild(GLUSbvh* bvh, GLUSbvhbuild* build)
+{
+	GLUSint i;
+
+	build->bvh = bvh;
+
+	bvh->primitives = (GLUSint*)glusMemoryMalloc(bvh->numberPrimitives * sizeof(GLUSint));
+
+	// Each split creates two nodes and each leaf has at least one primitive.
+	bvh->nodes = (GLUSbvhnode*)glusMemoryMalloc((2 * bvh->numberPrimitives - 1) * sizeof(GLUSbvhnode));
+
+	if (!bvh->primitives || !bvh->nodes)
+	{
+		return GLUS_FALSE;
+	}
+
+	for (i = 0; i < bvh->numberPrimitives; i++)
+	{
+		bvh->primitives[i] = i;
+	}
+
+	bvh->numberNodes = 1;
+
+	glusBvhBuildNode(build, 0, 0, bvh->numberPrimitives, 0);
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusBvhCreateSpheresf(GLUSbvh* bvh, const GLUSfloat* centers, const GLUSfloat* radii, const GLUSint stride, const GLUSint numberSpheres)
+{
+	GLUSbvhbuild build;
+
+	GLUSint i, k;
+
+	const GLUSfloat* center;
+	GLUSfloat radius;
+
+	GLUSboolean result;
+
+	if (!bvh)
+	{
+		return GLUS_FALSE;
+	}
+
+	memset(bvh, 0, sizeof(GLUSbvh));
+
+	if (!centers || !radii || stride < 0 || numberSpheres <= 0)
+	{
+		return GLUS_FALSE;
+	}
+
+	bvh->numberPrimitives = numberSpheres;
+
+	bvh->spheres = (GLUSfloat*)glusMemoryMalloc(numberSpheres * 4 * sizeof(GLUSfloat));
+
+	build.bounds = (GLUSfloat*)glusMemoryMalloc(numberSpheres * 6 * sizeof(GLUSfloat));
+	build.centroids = (GLUSfloat*)glusMemoryMalloc(numberSpheres * 3 * sizeof(GLUSfloat));
+
+	if (!bvh->spheres || !build.bounds || !build.centroids)
+	{
+		glusMemoryFree(build.bounds);
+		glusMemoryFree(build.centroids);
+
+		glusBvhDestroyf(bvh);
+
+		return GLUS_FALSE;
+	}
+
+	for (i = 0; i < numberSpheres; i++)
+	{
+		if (stride)
+		{
+			center = (const GLUSfloat*)((const GLUSubyte*)centers + i * stride);
+			radius = *(const GLUSfloat*)((const GLUSubyte*)radii + i * stride);
+		}
+		else
+		{
+			center = &centers[i * 4];
+			radius = radii[i];
+		}
+
+		for (k = 0; k < 3; k++)
+		{
+			bvh->spheres[i * 4 + k] = center[k];
+
+			build.bounds[i * 6 + k] = center[k] - radius;
+			build.bounds[i * 6 + k + 3] = center[k] + radius;
+
+			build.centroids[i * 3 + k] = center[k];
+		}
+
+		bvh->spheres[i * 4 + 3] = radius;
+	}
+
+	result = glusBvhBuild(bvh, &build);
+
+	glusMemoryFree(build.bounds);
+	glusMemoryFree(build.centroids);
+
+	if (!result)
+	{
+		glusBvhDestroyf(bvh);
+	}
+
+	return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusBvhCreateShapef(GLUSbvh* bvh, const GLUSshape* shape)
+{
+	GLUSbvhbuild build;
+
+	GLUSint i, k, corner, numberTriangles;
+
+	GLUSuint vertex;
+
+	GLUSboolean result;
+
+	if (!bvh)
+	{
+		return GLUS_FALSE;
+	}
+
+	memset(bvh, 0, sizeof(GLUSbvh));
+
+	if (!shape || !shape->vertices || shape->mode != GLUS_TRIANGLES)
+	{
+		return GLUS_FALSE;
+	}
+
+	numberTriangles = (GLUSint)((shape->indices ? shape->numberIndices : shape->numberVertices) / 3);
+
+	if (numberTriangles <= 0)
+	{
+		return GLUS_FALSE;
+	}
+
+	bvh->numberPrimitives = numberTriangles;
+
+	bvh->triangles = (GLUSfloat*)glusMemoryMalloc(numberTriangles * 12 * sizeof(GLUSfloat));
+
+	build.bounds = (GLUSfloat*)glusMemoryMalloc(numberTriangles * 6 * sizeof(GLUSfloat));
+	build.centroids = (GLUSfloat*)glusMemoryMalloc(numberTriangles * 3 * sizeof(GLUSfloat));
+
+	if (!bvh->triangles || !build.bounds || !build.centroids)
+	{
+		glusMemoryFree(build.bounds);
+		glusMemoryFree(build.centroids);
+
+		glusBvhDestroyf(bvh);
+
+		return GLUS_FALSE;
+	}
+
+	for (i = 0; i < numberTriangles; i++)
+	{
+		glusBvhEmptyBox(&build.bounds[i * 6]);
+
+		for (corner = 0; corner < 3; corner++)
+		{
+			vertex = shape->indices ? shape->indices[i * 3 + corner] : (GLUSuint)(i * 3 + corner);
+
+			if (vertex >= shape->numberVertices)
+			{
+				glusMemoryFree(build.bounds);
+				glusMemoryFree(build.centroids);
+
+				glusBvhDestroyf(bvh);
+
+				return GLUS_FALSE;
+			}
+
+			for (k = 0; k < 3; k++)
+			{
+				bvh->triangles[i * 12 + corner * 4 + k] = shape->vertices[vertex * 4 + k];
+
+				build.bounds[i * 6 + k] = glusMathMinf(build.bounds[i * 6 + k], shape->vertices[vertex * 4 + k]);
+				build.bounds[i * 6 + k + 3] = glusMathMaxf(build.bounds[i * 6 + k + 3], shape->vertices[vertex * 4 + k]);
+			}
+
+			bvh->triangles[i * 12 + corner * 4 + 3] = 1.0f;
+		}
+
+		for (k = 0; k < 3; k++)
+		{
+			build.centroids[i * 3 + k] = (build.bounds[i * 6 + k] + build.bounds[i * 6 + k + 3]) * 0.5f;
+		}
+	}
+
+	result = glusBvhBuild(bvh, &build);
+
+	glusMemoryFree(build.bounds);
+	glusMemoryFree(build.centroids);
+
+	if (!result)
+	{
+		glusBvhDestroyf(bvh);
+	}
+
+	return result;
+}
+
+GLUSvoid GLUSAPIENTRY glusBvhDestroyf(GLUSbvh* bvh)
+{
+	if (!bvh)
+	{
+		return;
+	}
+
+	if (bvh->nodes)
+	{
+		glusMemoryFree(bvh->nodes);
+
+		bvh->nodes = 0;
+	}
+
+	if (bvh->primitives)
+	{
+		glusMemoryFree(bvh->primitives);
+
+		bvh->primitives = 0;
+	}
+
+	if (bvh->spheres)
+	{
+		glusMemoryFree(bvh->spheres);
+
+		bvh->spheres = 0;
+	}
+
+	if (bvh->triangles)
+	{
+		glusMemoryFree(bvh->triangles);
+
+		bvh->triangles = 0;
+	}
+
+	bvh->numberNodes = 0;
+	bvh->numberPrimitives = 0;
+}
+
+/**
+ * Slab test against the node box. NaN values from a zero direction component and a start on the slab plane are ignored.
+ */
+static GLUSboolean glusBvhIntersectNode(GLUSfloat* tNear, const GLUSbvhnode* node, const GLUSfloat rayStart[4], const GLUSfloat inverseDirection[3], const GLUSfloat tMax)
+{
+	GLUSint i;
+
+	GLUSfloat t0, t1, temp;
+
+	GLUSfloat tMin = 0.0f;
+	GLUSfloat tFar = tMax;
+
+	for (i = 0; i < 3; i++)
+	{
+		t0 = (node->minimum[i] - rayStart[i]) * inverseDirection[i];
+		t1 = (node->maximum[i] - rayStart[i]) * inverseDirection[i];
+
+		if (t0 > t1)
+		{
+			temp = t0;
+			t0 = t1;
+			t1 = temp;
+		}
+
+		if (t0 > tMin)
+		{
+			tMin = t0;
+		}
+		if (t1 < tFar)
+		{
+			tFar = t1;
+		}
+	}
+
+	*tNear = tMin;
+
+	return tMin <= tFar;
+}
+
+/**
+ * Intersects a primitive. For spheres, the exit point is returned, if the ray starts inside.
+ */
+static GLUSboolean glusBvhIntersectPrimitive(GLUSbvhhit* hit, const GLUSbvh* bvh, const GLUSint primitive, const GLUSfloat rayStart[4], const GLUSfloat rayDirection[3])
+{
+	GLUSfloat tFar;
+
+	if (bvh->spheres)
+	{
+		if (!glusIntersectRaySpheref(&hit->t, &tFar, &hit->insideSphere, rayStart, rayDirection, &bvh->spheres[primitive * 4], bvh->spheres[primitive * 4 + 3]))
+		{
+			return GLUS_FALSE;
+		}
+
+		if (hit->insideSphere)
+		{
+			hit->t = tFar;
+		}
+
+		hit->u = 0.0f;
+		hit->v = 0.0f;
+	}
+	else
+	{
+		if (!glusIntersectRayTrianglef(&hit->t, &hit->u, &hit->v, rayStart, rayDirection, &bvh->triangles[primitive * 12], &bvh->triangles[primitive * 12 + 4], &bvh->triangles[primitive * 12 + 8]))
+		{
+			return GLUS_FALSE;
+		}
+
+		hit->insideSphere = GLUS_FALSE;
+	}
+
+	hit->primitive = primitive;
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusBvhIntersectRayClosestf(GLUSbvhhit* hit, const GLUSbvh* bvh, const GLUSfloat rayStart[4], const GLUSfloat rayDirection[3], const GLUSfloat tMax)
+{
+	GLUSint stack[GLUS_BVH_MAX_DEPTH + 2];
+	GLUSfloat stackNear[GLUS_BVH_MAX_DEPTH + 2];
+	GLUSint stackSize = 0;
+
+	GLUSfloat inverseDirection[3];
+
+	GLUSfloat tNear, tNearLeft, tNearRight;
+	GLUSboolean hitLeft, hitRight;
+
+	const GLUSbvhnode* node;
+
+	GLUSbvhhit current;
+	GLUSboolean found = GLUS_FALSE;
+
+	GLUSint i;
+
+	if (!hit || !bvh || !bvh->nodes || !rayStart || !rayDirection)
+	{
+		return GLUS_FALSE;
+	}
+
+	hit->t = tMax;
+
+	inverseDirection[0] = 1.0f / rayDirection[0];
+	inverseDirection[1] = 1.0f / rayDirection[1];
+	inverseDirection[2] = 1.0f / rayDirection[2];
+
+	if (!glusBvhIntersectNode(&tNear, &bvh->nodes[0], rayStart, inverseDirection, tMax))
+	{
+		return GLUS_FALSE;
+	}
+
+	stack[stackSize] = 0;
+	stackNear[stackSize] = tNear;
+	stackSize++;
+
+	while (stackSize > 0)
+	{
+		stackSize--;
+
+		// Boxes starting exactly at the current hit are visited, as a primitive with a lower index can be hit at the same t.
+		if (stackNear[stackSize] > hit->t)
+		{
+			continue;
+		}
+
+		node = &bvh->nodes[stack[stackSize]];
+
+		if (node->numberPrimitives > 0)
+		{
+			for (i = node->index; i < node->index + node->numberPrimitives; i++)
+			{
+				if (!glusBvhIntersectPrimitive(&current, bvh, bvh->primitives[i], rayStart, rayDirection))
+				{
+					continue;
+				}
+
+				if (current.t < hit->t || (current.t == hit->t && (!found || current.primitive < hit->primitive)))
+				{
+					*hit = current;
+
+					found = GLUS_TRUE;
+				}
+			}
+
+			continue;
+		}
+
+		hitLeft = glusBvhIntersectNode(&tNearLeft, &bvh->nodes[node->index], rayStart, inverseDirection, hit->t);
+		hitRight = glusBvhIntersectNode(&tNearRight, &bvh->nodes[node->index + 1], rayStart, inverseDirection, hit->t);
+
+		// Push the farther child first, so the nearer one is processed next.
+		if (hitLeft && hitRight && tNearLeft < tNearRight)
+		{
+			stack[stackSize] = node->index + 1;
+			stackNear[stackSize] = tNearRight;
+			stackSize++;
+
+			hitRight = GLUS_FALSE;
+		}
+
+		if (hitLeft)
+		{
+			stack[stackSize] = node->index;
+			stackNear[stackSize] = tNearLeft;
+			stackSize++;
+		}
+
+		if (hitRight)
+		{
+			stack[stackSize] = node->index + 1;
+			stackNear[stackSize] = tNearRight;
+			stackSize++;
+		}
+	}
+
+	return found;
+}
+
+GLUSboolean GLUSAPIENTRY glusBvhIntersectRayAnyf(const GLUSbvh* bvh, const GLUSfloat rayStart[4], const GLUSfloat rayDirection[3], const GLUSfloat tMax, const GLUSint ignorePrimitive)
+{
+	GLUSint stack[GLUS_BVH_MAX_DEPTH + 2];
+	GLUSint stackSize = 0;
+
+	GLUSfloat inverseDirection[3];
+
+	GLUSfloat tNear;
+
+	const GLUSbvhnode* node;
+
+	GLUSbvhhit current;
+
+	GLUSint i;
+
+	if (!bvh || !bvh->nodes || !rayStart || !rayDirection)
+	{
+		return GLUS_FALSE;
+	}
+
+	inverseDirection[0] = 1.0f / rayDirection[0];
+	inverseDirection[1] = 1.0f / rayDirection[1];
+	inverseDirection[2] = 1.0f / rayDirection[2];
+
+	stack[stackSize++] = 0;
+
+	while (stackSize > 0)
+	{
+		node = &bvh->nodes[stack[--stackSize]];
+
+		if (!glusBvhIntersectNode(&tNear, node, rayStart, inverseDirection, tMax))
+		{
+			continue;
+		}
+
+		if (node->numberPrimitives > 0)
+		{
+			for (i = node->index; i < node->index + node->numberPrimitives; i++)
+			{
+				if (bvh->primitives[i] == ignorePrimitive)
+				{
+					continue;
+				}
+
+				if (glusBvhIntersectPrimitive(&current, bvh, bvh->primitives[i], rayStart, rayDirection) && current.t <= tMax)
+				{
+					return GLUS_TRUE;
+				}
+			}
+
+			continue;
+		}
+
+		stack[stackSize++] = node->index + 1;
+		stack[stackSize++] = node->index;
+	}
+
+	return GLUS_FALSE;
+}
@@ -137,6 +137,50 @@ EGLBoolean GLUSAPIENTRY glusEGLCreateWindowSurfaceMakeCurrent(EGLNativeWindowTyp
     return EGL_TRUE;
 }
 
+EGLBoolean GLUSAPIENTRY glusEGLCreatePbufferSurfaceMakeCurrent(const EGLint width, const EGLint height, EGLDisplay* eglDisplay, EGLConfig* eglConfig, EGLContext* eglContext, EGLSurface* eglSurface)
+{
+    EGLSurface surface = EGL_NO_SURFACE;
+
+    EGLint surfaceAttribList[] = { EGL_WIDTH, 0, EGL_HEIGHT, 0, EGL_NONE };
+
+    if (!eglDisplay || !eglConfig || !eglContext || !eglSurface)
+    {
+        glusLogPrint(GLUS_LOG_ERROR, "No eglDisplay, eglConfig, eglContext or eglSurface passed");
+
+        return EGL_FALSE;
+    }
+
+    surfaceAttribList[1] = width;
+    surfaceAttribList[3] = height;
+
+    // Create a surface
+    surface = eglCreatePbufferSurface(*eglDisplay, *eglConfig, surfaceAttribList);
+    if (surface == EGL_NO_SURFACE)
+    {
+        glusLogPrint(GLUS_LOG_ERROR, "Could not create EGL pbuffer surface");
+
+        glusEGLTerminate(eglDisplay, eglContext, 0);
+
+        return EGL_FALSE;
+    }
+
+    // Make the context current
+    if (!eglMakeCurrent(*eglDisplay, surface, surface, *eglContext))
+    {
+        glusLogPrint(GLUS_LOG_ERROR, "Could not set EGL context as current");
+
+        eglDestroySurface(*eglDisplay, surface);
+
+        glusEGLTerminate(eglDisplay, eglContext, 0);
+
+        return EGL_FALSE;
+    }
+
+    *eglSurface = surface;
+
+    return EGL_TRUE;
+}
+
 GLUSvoid GLUSAPIENTRY glusEGLTerminate(EGLDisplay* eglDisplay, EGLContext* eglContext, EGLSurface* eglSurface)
 {
     if (!eglDisplay)
@@ -15,6 +15,15 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "GL/glus.h"
 
 GLUSboolean _glusFileCheckRead(FILE* f, size_t actualRead, size_t expectedRead)
@@ -80,3 +89,196 @@ int GLUSAPIENTRY glusFileClose(FILE* stream)
 {
 	return fclose(stream);
 }
+
+int GLUSAPIENTRY glusFileRemove(const char* filename)
+{
+	char buffer[GLUS_MAX_FILENAME];
+
+	if (!filename || strlen(filename) + strlen(GLUS_BASE_DIRECTORY) >= GLUS_MAX_FILENAME)
+	{
+		return -1;
+	}
+
+	strcpy(buffer, GLUS_BASE_DIRECTORY);
+	strcat(buffer, filename);
+
+	return remove(buffer);
+}
+
+GLUSboolean _glusFileMap(const GLUSchar* filename, GLUSubyte** data, size_t* length)
+{
+	char buffer[GLUS_MAX_FILENAME];
+
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+	LARGE_INTEGER fileSize;
+#else
+	int file;
+	struct stat fileStatus;
+	void* view;
+#endif
+
+	if (!filename || !data || !length)
+	{
+		return GLUS_FALSE;
+	}
+
+	*data = 0;
+	*length = 0;
+
+	if (strlen(filename) + strlen(GLUS_BASE_DIRECTORY) >= GLUS_MAX_FILENAME)
+	{
+		return GLUS_FALSE;
+	}
+
+	strcpy(buffer, GLUS_BASE_DIRECTORY);
+	strcat(buffer, filename);
+
+#ifdef _WIN32
+	file = CreateFileA(buffer, GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+
+		return GLUS_FALSE;
+	}
+
+	// Empty files can not be mapped, but are valid.
+	if (fileSize.QuadPart == 0)
+	{
+		CloseHandle(file);
+
+		return GLUS_TRUE;
+	}
+
+	mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+
+	// The view keeps the file open, so the handles can be closed.
+	CloseHandle(file);
+
+	if (!mapping)
+	{
+		return GLUS_FALSE;
+	}
+
+	*data = (GLUSubyte*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+	CloseHandle(mapping);
+
+	if (!*data)
+	{
+		return GLUS_FALSE;
+	}
+
+	*length = (size_t)fileSize.QuadPart;
+#else
+	file = open(buffer, O_RDONLY);
+
+	if (file < 0)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (fstat(file, &fileStatus) != 0)
+	{
+		close(file);
+
+		return GLUS_FALSE;
+	}
+
+	// Empty files can not be mapped, but are valid.
+	if (fileStatus.st_size == 0)
+	{
+		close(file);
+
+		return GLUS_TRUE;
+	}
+
+	view = mmap(0, (size_t)fileStatus.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+
+	// The mapping keeps the file open, so the descriptor can be closed.
+	close(file);
+
+	if (view == MAP_FAILED)
+	{
+		return GLUS_FALSE;
+	}
+
+	*data = (GLUSubyte*)view;
+	*length = (size_t)fileStatus.st_size;
+#endif
+
+	return GLUS_TRUE;
+}
+
+GLUSvoid _glusFileUnmap(GLUSubyte* data, size_t length)
+{
+	if (!data)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+#else
+	munmap(data, length);
+#endif
+}
+
+GLUSboolean _glusFileGetStamp(const GLUSchar* filename, GLUSuint64* modificationTime, GLUSuint64* size)
+{
+	char buffer[GLUS_MAX_FILENAME];
+
+#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA fileAttributes;
+#else
+	struct stat fileStatus;
+#endif
+
+	if (!filename || !modificationTime || !size)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (strlen(filename) + strlen(GLUS_BASE_DIRECTORY) >= GLUS_MAX_FILENAME)
+	{
+		return GLUS_FALSE;
+	}
+
+	strcpy(buffer, GLUS_BASE_DIRECTORY);
+	strcat(buffer, filename);
+
+#ifdef _WIN32
+	if (!GetFileAttributesExA(buffer, GetFileExInfoStandard, &fileAttributes))
+	{
+		return GLUS_FALSE;
+	}
+
+	*modificationTime = ((GLUSuint64)fileAttributes.ftLastWriteTime.dwHighDateTime << 32) | (GLUSuint64)fileAttributes.ftLastWriteTime.dwLowDateTime;
+	*size = ((GLUSuint64)fileAttributes.nFileSizeHigh << 32) | (GLUSuint64)fileAttributes.nFileSizeLow;
+#else
+	if (stat(buffer, &fileStatus) != 0)
+	{
+		return GLUS_FALSE;
+	}
+
+	// Nanoseconds where available, as two changes can happen within one second.
+#if defined(__APPLE__)
+	*modificationTime = (GLUSuint64)fileStatus.st_mtimespec.tv_sec * 1000000000 + (GLUSuint64)fileStatus.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+	*modificationTime = (GLUSuint64)fileStatus.st_mtim.tv_sec * 1000000000 + (GLUSuint64)fileStatus.st_mtim.tv_nsec;
+#else
+	*modificationTime = (GLUSuint64)fileStatus.st_mtime;
+#endif
+	*size = (GLUSuint64)fileStatus.st_size;
+#endif
+
+	return GLUS_TRUE;
+}
@@ -22,7 +22,7 @@
 extern GLUSboolean _glusFileCheckRead(FILE* f, size_t actualRead, size_t expectedRead);
 extern GLUSboolean _glusFileCheckWrite(FILE* f, size_t actualWrite, size_t expectedWrite);
 
-GLUSboolean GLUSAPIENTRY glusFileLoadBinary(const GLUSchar* filename, GLUSbinaryfile* binaryfile)
+static GLUSboolean glusFileLoadBinaryData(const GLUSchar* filename, GLUSbinaryfile* binaryfile)
 {
 	FILE* f;
 	size_t elementsRead;
@@ -90,6 +90,19 @@ GLUSboolean GLUSAPIENTRY glusFileLoadBinary(const GLUSchar* filename, GLUSbinary
 	return GLUS_TRUE;
 }
 
+GLUSboolean GLUSAPIENTRY glusFileLoadBinary(const GLUSchar* filename, GLUSbinaryfile* binaryfile)
+{
+	GLUSboolean result;
+
+	GLUS_PROFILE_BEGIN("glusFileLoadBinary");
+
+	result = glusFileLoadBinaryData(filename, binaryfile);
+
+	GLUS_PROFILE_END();
+
+	return result;
+}
+
 GLUSboolean GLUSAPIENTRY glusFileSaveBinary(const GLUSchar* filename, const GLUSbinaryfile* binaryfile)
 {
 	FILE* file;
@@ -22,7 +22,7 @@
 extern GLUSboolean _glusFileCheckRead(FILE* f, size_t actualRead, size_t expectedRead);
 extern GLUSboolean _glusFileCheckWrite(FILE* f, size_t actualWrite, size_t expectedWrite);
 
-GLUSboolean GLUSAPIENTRY glusFileLoadText(const GLUSchar* filename, GLUStextfile* textfile)
+static GLUSboolean glusFileLoadTextData(const GLUSchar* filename, GLUStextfile* textfile)
 {
 	FILE* f;
 	size_t elementsRead;
@@ -90,6 +90,19 @@ GLUSboolean GLUSAPIENTRY glusFileLoadText(const GLUSchar* filename, GLUStextfile
 	return GLUS_TRUE;
 }
 
+GLUSboolean GLUSAPIENTRY glusFileLoadText(const GLUSchar* filename, GLUStextfile* textfile)
+{
+	GLUSboolean result;
+
+	GLUS_PROFILE_BEGIN("glusFileLoadText");
+
+	result = glusFileLoadTextData(filename, textfile);
+
+	GLUS_PROFILE_END();
+
+	return result;
+}
+
 GLUSboolean GLUSAPIENTRY glusFileSaveText(const GLUSchar* filename, const GLUStextfile* textfile)
 {
 	FILE* file;
@@ -15,8 +15,27 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GLUS_FOURIER_SSE
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GLUS_FOURIER_NEON
+#endif
+
 #include "GL/glus.h"
 
+/**
+ * Number of neighboring lines transformed together.
+ */
+#define GLUS_FOURIER_BLOCK 16
+
+extern GLUSboolean _glusThreadRunTiles(const GLUSint numberTiles, const GLUSint numberThreads, GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile), GLUSvoid* data);
+
+extern GLUSint _glusThreadGetTileWorker(GLUSvoid);
+
+extern GLUSint _glusThreadGetNumberTileWorkers(const GLUSint numberTiles, const GLUSint numberThreads);
+
 static GLUSboolean glusFourierIsPowerOfTwo(const GLUSint n)
 {
 	GLUSint test = n;
@@ -418,3 +437,782 @@ GLUSboolean glusFourierButterflyShuffleFFTi(GLUSint* result, const GLUSint* vect
 	return GLUS_FALSE;
 }
 
+GLUSboolean GLUSAPIENTRY glusFourierCreatePlan(GLUSfourierplan* plan, const GLUSint n)
+{
+	const GLUSdouble pi = 3.1415926535897932384626433832795;
+
+	GLUSint i, k, h, log2n;
+
+	if (!plan)
+	{
+		return GLUS_FALSE;
+	}
+
+	plan->n = 0;
+	plan->log2n = 0;
+	plan->bitReverse = 0;
+	plan->twiddleReal = 0;
+	plan->twiddleImaginary = 0;
+	plan->workReal = 0;
+	plan->workImaginary = 0;
+
+	if (!glusFourierIsPowerOfTwo(n))
+	{
+		return GLUS_FALSE;
+	}
+
+	log2n = 0;
+	while ((1 << log2n) < n)
+	{
+		log2n++;
+	}
+
+	plan->bitReverse = (GLUSint*)glusMemoryMalloc(n * sizeof(GLUSint));
+
+	// Twiddle factors of all stages need N - 1 entries, the buffers 2 * N entries.
+	plan->twiddleReal = (GLUSfloat*)glusMemoryMalloc((4 * n + 2) * sizeof(GLUSfloat));
+
+	if (!plan->bitReverse || !plan->twiddleReal)
+	{
+		glusFourierDestroyPlan(plan);
+
+		return GLUS_FALSE;
+	}
+
+	plan->twiddleImaginary = plan->twiddleReal + n;
+	plan->workReal = plan->twiddleImaginary + n;
+	plan->workImaginary = plan->workReal + n + 1;
+
+	plan->n = n;
+	plan->log2n = log2n;
+
+	for (i = 0; i < n; i++)
+	{
+		plan->bitReverse[i] = 0;
+
+		for (k = 0; k < log2n; k++)
+		{
+			if (i & (1 << k))
+			{
+				plan->bitReverse[i] |= 1 << (log2n - 1 - k);
+			}
+		}
+	}
+
+	// Calculated in double precision, so no error is accumulated over the stages.
+	for (h = 1; h < n; h *= 2)
+	{
+		for (i = 0; i < h; i++)
+		{
+			plan->twiddleReal[h - 1 + i] = (GLUSfloat)cos(-pi * (GLUSdouble)i / (GLUSdouble)h);
+			plan->twiddleImaginary[h - 1 + i] = (GLUSfloat)sin(-pi * (GLUSdouble)i / (GLUSdouble)h);
+		}
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusFourierDestroyPlan(GLUSfourierplan* plan)
+{
+	if (!plan)
+	{
+		return;
+	}
+
+	glusMemoryFree(plan->bitReverse);
+
+	// All float arrays share one allocation.
+	glusMemoryFree(plan->twiddleReal);
+
+	plan->n = 0;
+	plan->log2n = 0;
+	plan->bitReverse = 0;
+	plan->twiddleReal = 0;
+	plan->twiddleImaginary = 0;
+	plan->workReal = 0;
+	plan->workImaginary = 0;
+}
+
+/**
+ * Two radix-2 stages with half span h and 2h done in one pass over the data.
+ */
+static GLUSvoid glusFourierRadix4Stage(const GLUSfourierplan* plan, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint n, const GLUSint h)
+{
+	const GLUSfloat* w2Real = &plan->twiddleReal[h - 1];
+	const GLUSfloat* w2Imaginary = &plan->twiddleImaginary[h - 1];
+	const GLUSfloat* w4Real = &plan->twiddleReal[2 * h - 1];
+	const GLUSfloat* w4Imaginary = &plan->twiddleImaginary[2 * h - 1];
+
+	GLUSint block, j;
+
+	GLUSfloat* r0;
+	GLUSfloat* r1;
+	GLUSfloat* r2;
+	GLUSfloat* r3;
+	GLUSfloat* i0;
+	GLUSfloat* i1;
+	GLUSfloat* i2;
+	GLUSfloat* i3;
+
+	GLUSfloat t1r, t1i, t3r, t3i, b0r, b0i, b1r, b1i, b2r, b2i, b3r, b3i, u2r, u2i, u3r, u3i;
+
+	for (block = 0; block < n; block += 4 * h)
+	{
+		r0 = &real[block];
+		r1 = r0 + h;
+		r2 = r1 + h;
+		r3 = r2 + h;
+		i0 = &imaginary[block];
+		i1 = i0 + h;
+		i2 = i1 + h;
+		i3 = i2 + h;
+
+		j = 0;
+
+#if defined(GLUS_FOURIER_SSE)
+		for (; j + 4 <= h; j += 4)
+		{
+			__m128 vw2r = _mm_loadu_ps(&w2Real[j]);
+			__m128 vw2i = _mm_loadu_ps(&w2Imaginary[j]);
+			__m128 vw4r = _mm_loadu_ps(&w4Real[j]);
+			__m128 vw4i = _mm_loadu_ps(&w4Imaginary[j]);
+
+			__m128 va0r = _mm_loadu_ps(&r0[j]);
+			__m128 va0i = _mm_loadu_ps(&i0[j]);
+			__m128 va1r = _mm_loadu_ps(&r1[j]);
+			__m128 va1i = _mm_loadu_ps(&i1[j]);
+			__m128 va2r = _mm_loadu_ps(&r2[j]);
+			__m128 va2i = _mm_loadu_ps(&i2[j]);
+			__m128 va3r = _mm_loadu_ps(&r3[j]);
+			__m128 va3i = _mm_loadu_ps(&i3[j]);
+
+			__m128 vt1r = _mm_sub_ps(_mm_mul_ps(vw2r, va1r), _mm_mul_ps(vw2i, va1i));
+			__m128 vt1i = _mm_add_ps(_mm_mul_ps(vw2r, va1i), _mm_mul_ps(vw2i, va1r));
+			__m128 vt3r = _mm_sub_ps(_mm_mul_ps(vw2r, va3r), _mm_mul_ps(vw2i, va3i));
+			__m128 vt3i = _mm_add_ps(_mm_mul_ps(vw2r, va3i), _mm_mul_ps(vw2i, va3r));
+
+			__m128 vb0r = _mm_add_ps(va0r, vt1r);
+			__m128 vb0i = _mm_add_ps(va0i, vt1i);
+			__m128 vb1r = _mm_sub_ps(va0r, vt1r);
+			__m128 vb1i = _mm_sub_ps(va0i, vt1i);
+			__m128 vb2r = _mm_add_ps(va2r, vt3r);
+			__m128 vb2i = _mm_add_ps(va2i, vt3i);
+			__m128 vb3r = _mm_sub_ps(va2r, vt3r);
+			__m128 vb3i = _mm_sub_ps(va2i, vt3i);
+
+			__m128 vu2r = _mm_sub_ps(_mm_mul_ps(vw4r, vb2r), _mm_mul_ps(vw4i, vb2i));
+			__m128 vu2i = _mm_add_ps(_mm_mul_ps(vw4r, vb2i), _mm_mul_ps(vw4i, vb2r));
+			__m128 vu3r = _mm_sub_ps(_mm_mul_ps(vw4r, vb3r), _mm_mul_ps(vw4i, vb3i));
+			__m128 vu3i = _mm_add_ps(_mm_mul_ps(vw4r, vb3i), _mm_mul_ps(vw4i, vb3r));
+
+			_mm_storeu_ps(&r0[j], _mm_add_ps(vb0r, vu2r));
+			_mm_storeu_ps(&i0[j], _mm_add_ps(vb0i, vu2i));
+			_mm_storeu_ps(&r2[j], _mm_sub_ps(vb0r, vu2r));
+			_mm_storeu_ps(&i2[j], _mm_sub_ps(vb0i, vu2i));
+			_mm_storeu_ps(&r1[j], _mm_add_ps(vb1r, vu3i));
+			_mm_storeu_ps(&i1[j], _mm_sub_ps(vb1i, vu3r));
+			_mm_storeu_ps(&r3[j], _mm_sub_ps(vb1r, vu3i));
+			_mm_storeu_ps(&i3[j], _mm_add_ps(vb1i, vu3r));
+		}
+#elif defined(GLUS_FOURIER_NEON)
+		for (; j + 4 <= h; j += 4)
+		{
+			float32x4_t vw2r = vld1q_f32(&w2Real[j]);
+			float32x4_t vw2i = vld1q_f32(&w2Imaginary[j]);
+			float32x4_t vw4r = vld1q_f32(&w4Real[j]);
+			float32x4_t vw4i = vld1q_f32(&w4Imaginary[j]);
+
+			float32x4_t va0r = vld1q_f32(&r0[j]);
+			float32x4_t va0i = vld1q_f32(&i0[j]);
+			float32x4_t va1r = vld1q_f32(&r1[j]);
+			float32x4_t va1i = vld1q_f32(&i1[j]);
+			float32x4_t va2r = vld1q_f32(&r2[j]);
+			float32x4_t va2i = vld1q_f32(&i2[j]);
+			float32x4_t va3r = vld1q_f32(&r3[j]);
+			float32x4_t va3i = vld1q_f32(&i3[j]);
+
+			float32x4_t vt1r = vsubq_f32(vmulq_f32(vw2r, va1r), vmulq_f32(vw2i, va1i));
+			float32x4_t vt1i = vaddq_f32(vmulq_f32(vw2r, va1i), vmulq_f32(vw2i, va1r));
+			float32x4_t vt3r = vsubq_f32(vmulq_f32(vw2r, va3r), vmulq_f32(vw2i, va3i));
+			float32x4_t vt3i = vaddq_f32(vmulq_f32(vw2r, va3i), vmulq_f32(vw2i, va3r));
+
+			float32x4_t vb0r = vaddq_f32(va0r, vt1r);
+			float32x4_t vb0i = vaddq_f32(va0i, vt1i);
+			float32x4_t vb1r = vsubq_f32(va0r, vt1r);
+			float32x4_t vb1i = vsubq_f32(va0i, vt1i);
+			float32x4_t vb2r = vaddq_f32(va2r, vt3r);
+			float32x4_t vb2i = vaddq_f32(va2i, vt3i);
+			float32x4_t vb3r = vsubq_f32(va2r, vt3r);
+			float32x4_t vb3i = vsubq_f32(va2i, vt3i);
+
+			float32x4_t vu2r = vsubq_f32(vmulq_f32(vw4r, vb2r), vmulq_f32(vw4i, vb2i));
+			float32x4_t vu2i = vaddq_f32(vmulq_f32(vw4r, vb2i), vmulq_f32(vw4i, vb2r));
+			float32x4_t vu3r = vsubq_f32(vmulq_f32(vw4r, vb3r), vmulq_f32(vw4i, vb3i));
+			float32x4_t vu3i = vaddq_f32(vmulq_f32(vw4r, vb3i), vmulq_f32(vw4i, vb3r));
+
+			vst1q_f32(&r0[j], vaddq_f32(vb0r, vu2r));
+			vst1q_f32(&i0[j], vaddq_f32(vb0i, vu2i));
+			vst1q_f32(&r2[j], vsubq_f32(vb0r, vu2r));
+			vst1q_f32(&i2[j], vsubq_f32(vb0i, vu2i));
+			vst1q_f32(&r1[j], vaddq_f32(vb1r, vu3i));
+			vst1q_f32(&i1[j], vsubq_f32(vb1i, vu3r));
+			vst1q_f32(&r3[j], vsubq_f32(vb1r, vu3i));
+			vst1q_f32(&i3[j], vaddq_f32(vb1i, vu3r));
+		}
+#endif
+
+		for (; j < h; j++)
+		{
+			t1r = w2Real[j] * r1[j] - w2Imaginary[j] * i1[j];
+			t1i = w2Real[j] * i1[j] + w2Imaginary[j] * r1[j];
+			t3r = w2Real[j] * r3[j] - w2Imaginary[j] * i3[j];
+			t3i = w2Real[j] * i3[j] + w2Imaginary[j] * r3[j];
+
+			b0r = r0[j] + t1r;
+			b0i = i0[j] + t1i;
+			b1r = r0[j] - t1r;
+			b1i = i0[j] - t1i;
+			b2r = r2[j] + t3r;
+			b2i = i2[j] + t3i;
+			b3r = r2[j] - t3r;
+			b3i = i2[j] - t3i;
+
+			u2r = w4Real[j] * b2r - w4Imaginary[j] * b2i;
+			u2i = w4Real[j] * b2i + w4Imaginary[j] * b2r;
+			u3r = w4Real[j] * b3r - w4Imaginary[j] * b3i;
+			u3i = w4Real[j] * b3i + w4Imaginary[j] * b3r;
+
+			// The twiddle factor of the second half is multiplied by -i.
+
+			r0[j] = b0r + u2r;
+			i0[j] = b0i + u2i;
+			r2[j] = b0r - u2r;
+			i2[j] = b0i - u2i;
+			r1[j] = b1r + u3i;
+			i1[j] = b1i - u3r;
+			r3[j] = b1r - u3i;
+			i3[j] = b1i + u3r;
+		}
+	}
+}
+
+/**
+ * Unscaled forward transform with n elements, where n is not larger than the plan size.
+ * The inverse transform is done by exchanging the real and imaginary parts.
+ */
+static GLUSvoid glusFourierPlanTransform(const GLUSfourierplan* plan, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint n)
+{
+	GLUSint i, k, h, log2n, shift;
+
+	GLUSfloat temp, r0, i0;
+
+	log2n = 0;
+	while ((1 << log2n) < n)
+	{
+		log2n++;
+	}
+
+	// Bit reversal of a smaller size is the bit reversal of the plan size shifted down.
+	shift = plan->log2n - log2n;
+
+	for (i = 0; i < n; i++)
+	{
+		k = plan->bitReverse[i] >> shift;
+
+		if (i < k)
+		{
+			temp = real[i];
+			real[i] = real[k];
+			real[k] = temp;
+
+			temp = imaginary[i];
+			imaginary[i] = imaginary[k];
+			imaginary[k] = temp;
+		}
+	}
+
+	h = 1;
+
+	// An odd number of stages starts with one radix-2 stage. Its twiddle factor is one.
+	if (log2n & 0x1)
+	{
+		for (i = 0; i < n; i += 2)
+		{
+			r0 = real[i];
+			i0 = imaginary[i];
+
+			real[i] = r0 + real[i + 1];
+			imaginary[i] = i0 + imaginary[i + 1];
+			real[i + 1] = r0 - real[i + 1];
+			imaginary[i + 1] = i0 - imaginary[i + 1];
+		}
+
+		h = 2;
+	}
+
+	for (; h < n; h *= 4)
+	{
+		glusFourierRadix4Stage(plan, real, imaginary, n, h);
+	}
+}
+
+static GLUSvoid glusFourierPlanScale(GLUSfloat* real, GLUSfloat* imaginary, const GLUSint n, const GLUSfloat scalar)
+{
+	GLUSint i;
+
+	for (i = 0; i < n; i++)
+	{
+		real[i] *= scalar;
+		imaginary[i] *= scalar;
+	}
+}
+
+GLUSboolean GLUSAPIENTRY glusFourierPlanFFTf(const GLUSfourierplan* plan, GLUSfloat* real, GLUSfloat* imaginary)
+{
+	if (!plan || !plan->bitReverse || !real || !imaginary)
+	{
+		return GLUS_FALSE;
+	}
+
+	glusFourierPlanTransform(plan, real, imaginary, plan->n);
+
+	glusFourierPlanScale(real, imaginary, plan->n, 1.0f / (GLUSfloat)plan->n);
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusFourierPlanInverseFFTf(const GLUSfourierplan* plan, GLUSfloat* real, GLUSfloat* imaginary)
+{
+	if (!plan || !plan->bitReverse || !real || !imaginary)
+	{
+		return GLUS_FALSE;
+	}
+
+	// Exchanging real and imaginary part before and after the transform conjugates the twiddle factors.
+	glusFourierPlanTransform(plan, imaginary, real, plan->n);
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusFourierPlanFFTc(GLUSfourierplan* plan, GLUScomplex* result, const GLUScomplex* vector)
+{
+	GLUSint i;
+
+	if (!plan || !plan->bitReverse || !result || !vector)
+	{
+		return GLUS_FALSE;
+	}
+
+	for (i = 0; i < plan->n; i++)
+	{
+		plan->workReal[i] = vector[i].real;
+		plan->workImaginary[i] = vector[i].imaginary;
+	}
+
+	glusFourierPlanFFTf(plan, plan->workReal, plan->workImaginary);
+
+	for (i = 0; i < plan->n; i++)
+	{
+		result[i].real = plan->workReal[i];
+		result[i].imaginary = plan->workImaginary[i];
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusFourierPlanInverseFFTc(GLUSfourierplan* plan, GLUScomplex* result, const GLUScomplex* vector)
+{
+	GLUSint i;
+
+	if (!plan || !plan->bitReverse || !result || !vector)
+	{
+		return GLUS_FALSE;
+	}
+
+	for (i = 0; i < plan->n; i++)
+	{
+		plan->workReal[i] = vector[i].real;
+		plan->workImaginary[i] = vector[i].imaginary;
+	}
+
+	glusFourierPlanInverseFFTf(plan, plan->workReal, plan->workImaginary);
+
+	for (i = 0; i < plan->n; i++)
+	{
+		result[i].real = plan->workReal[i];
+		result[i].imaginary = plan->workImaginary[i];
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusFourierPlanRealFFTf(GLUSfourierplan* plan, GLUSfloat* resultReal, GLUSfloat* resultImaginary, const GLUSfloat* vector)
+{
+	GLUSint i, k, m;
+
+	GLUSfloat* zReal;
+	GLUSfloat* zImaginary;
+
+	GLUSfloat scalar, evenReal, evenImaginary, oddReal, oddImaginary, wReal, wImaginary;
+
+	if (!plan || !plan->bitReverse || plan->n < 2 || !resultReal || !resultImaginary || !vector)
+	{
+		return GLUS_FALSE;
+	}
+
+	m = plan->n / 2;
+
+	zReal = plan->workReal;
+	zImaginary = plan->workImaginary;
+
+	// Even values are packed into the real and odd values into the imaginary part of a half sized transform.
+
+	for (i = 0; i < m; i++)
+	{
+		zReal[i] = vector[2 * i];
+		zImaginary[i] = vector[2 * i + 1];
+	}
+
+	glusFourierPlanTransform(plan, zReal, zImaginary, m);
+
+	// Z[m] equals Z[0] because of the periodicity.
+	zReal[m] = zReal[0];
+	zImaginary[m] = zImaginary[0];
+
+	scalar = 1.0f / (GLUSfloat)plan->n;
+
+	for (k = 0; k <= m; k++)
+	{
+		// Split into the transforms of the even and odd values.
+		evenReal = 0.5f * (zReal[k] + zReal[m - k]);
+		evenImaginary = 0.5f * (zImaginary[k] - zImaginary[m - k]);
+		oddReal = 0.5f * (zImaginary[k] + zImaginary[m - k]);
+		oddImaginary = -0.5f * (zReal[k] - zReal[m - k]);
+
+		// The last stage of the plan contains the twiddle factors for N elements.
+		if (k < m)
+		{
+			wReal = plan->twiddleReal[m - 1 + k];
+			wImaginary = plan->twiddleImaginary[m - 1 + k];
+		}
+		else
+		{
+			wReal = -1.0f;
+			wImaginary = 0.0f;
+		}
+
+		resultReal[k] = (evenReal + wReal * oddReal - wImaginary * oddImaginary) * scalar;
+		resultImaginary[k] = (evenImaginary + wReal * oddImaginary + wImaginary * oddReal) * scalar;
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusFourierPlanInverseRealFFTf(GLUSfourierplan* plan, GLUSfloat* result, const GLUSfloat* real, const GLUSfloat* imaginary)
+{
+	GLUSint i, k, m;
+
+	GLUSfloat* zReal;
+	GLUSfloat* zImaginary;
+
+	GLUSfloat evenReal, evenImaginary, differenceReal, differenceImaginary, oddReal, oddImaginary, wReal, wImaginary;
+
+	if (!plan || !plan->bitReverse || plan->n < 2 || !result || !real || !imaginary)
+	{
+		return GLUS_FALSE;
+	}
+
+	m = plan->n / 2;
+
+	zReal = plan->workReal;
+	zImaginary = plan->workImaginary;
+
+	for (k = 0; k < m; k++)
+	{
+		// Element k + N / 2 is the conjugate of element N / 2 - k.
+		evenReal = real[k] + real[m - k];
+		evenImaginary = imaginary[k] - imaginary[m - k];
+		differenceReal = real[k] - real[m - k];
+		differenceImaginary = imaginary[k] + imaginary[m - k];
+
+		// Multiply the difference with the conjugated twiddle factor.
+		wReal = plan->twiddleReal[m - 1 + k];
+		wImaginary = -plan->twiddleImaginary[m - 1 + k];
+
+		oddReal = differenceReal * wReal - differenceImaginary * wImaginary;
+		oddImaginary = differenceReal * wImaginary + differenceImaginary * wReal;
+
+		// Even part goes to the real and odd part to the imaginary values.
+		zReal[k] = evenReal - oddImaginary;
+		zImaginary[k] = evenImaginary + oddReal;
+	}
+
+	glusFourierPlanTransform(plan, zImaginary, zReal, m);
+
+	for (i = 0; i < m; i++)
+	{
+		result[2 * i] = zReal[i];
+		result[2 * i + 1] = zImaginary[i];
+	}
+
+	return GLUS_TRUE;
+}
+
+/**
+ * Transforms of all lines along one axis. Line l of outer block o starts at o * n * stride + l and has its elements stride apart.
+ */
+typedef struct _GLUSfourierpass
+{
+	const GLUSfourierplan* plan;
+
+	GLUSfloat* real;
+
+	GLUSfloat* imaginary;
+
+	GLUSint stride;
+
+	GLUSint numberBlocks;
+
+	GLUSfloat scalar;
+
+	/**
+	 * Buffer for gathering the lines. One part per worker, so it is allocated once per pass.
+	 */
+	GLUSfloat* scratch;
+
+	GLUSint numberScratch;
+
+	GLUSboolean failed;
+
+} GLUSfourierpass;
+
+static GLUSvoid glusFourierPassTile(GLUSvoid* data, const GLUSint tile)
+{
+	GLUSfourierpass* pass = (GLUSfourierpass*)data;
+
+	GLUSint n = pass->plan->n;
+	GLUSint stride = pass->stride;
+	GLUSint tilesPerBlock, outer, first, number, worker, i, k;
+
+	GLUSfloat* lineReal;
+	GLUSfloat* lineImaginary;
+	GLUSfloat* real;
+	GLUSfloat* imaginary;
+
+	if (stride == 1)
+	{
+		// Lines are contiguous, so they are transformed in place.
+
+		first = tile * GLUS_FOURIER_BLOCK;
+		number = pass->numberBlocks - first < GLUS_FOURIER_BLOCK ? pass->numberBlocks - first : GLUS_FOURIER_BLOCK;
+
+		for (i = 0; i < number; i++)
+		{
+			real = &pass->real[(first + i) * n];
+			imaginary = &pass->imaginary[(first + i) * n];
+
+			glusFourierPlanTransform(pass->plan, real, imaginary, n);
+
+			if (pass->scalar != 1.0f)
+			{
+				glusFourierPlanScale(real, imaginary, n, pass->scalar);
+			}
+		}
+
+		return;
+	}
+
+	// Neighboring lines are gathered together, so every cache line loaded is used completely.
+
+	tilesPerBlock = (stride + GLUS_FOURIER_BLOCK - 1) / GLUS_FOURIER_BLOCK;
+
+	outer = tile / tilesPerBlock;
+	first = (tile % tilesPerBlock) * GLUS_FOURIER_BLOCK;
+	number = stride - first < GLUS_FOURIER_BLOCK ? stride - first : GLUS_FOURIER_BLOCK;
+
+	real = &pass->real[outer * n * stride + first];
+	imaginary = &pass->imaginary[outer * n * stride + first];
+
+	worker = _glusThreadGetTileWorker();
+
+	if (worker >= pass->numberScratch)
+	{
+		pass->failed = GLUS_TRUE;
+
+		return;
+	}
+
+	lineReal = &pass->scratch[worker * 2 * GLUS_FOURIER_BLOCK * n];
+	lineImaginary = lineReal + GLUS_FOURIER_BLOCK * n;
+
+	for (k = 0; k < n; k++)
+	{
+		for (i = 0; i < number; i++)
+		{
+			lineReal[i * n + k] = real[k * stride + i];
+			lineImaginary[i * n + k] = imaginary[k * stride + i];
+		}
+	}
+
+	for (i = 0; i < number; i++)
+	{
+		glusFourierPlanTransform(pass->plan, &lineReal[i * n], &lineImaginary[i * n], n);
+	}
+
+	for (k = 0; k < n; k++)
+	{
+		for (i = 0; i < number; i++)
+		{
+			real[k * stride + i] = lineReal[i * n + k] * pass->scalar;
+			imaginary[k * stride + i] = lineImaginary[i * n + k] * pass->scalar;
+		}
+	}
+}
+
+/**
+ * Transforms all lines along one axis. For contiguous lines, the number of blocks is the number of lines.
+ */
+static GLUSboolean glusFourierPass(const GLUSfourierplan* plan, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint stride, const GLUSint numberBlocks, const GLUSfloat scalar, const GLUSint numberThreads)
+{
+	GLUSfourierpass pass;
+
+	GLUSint numberTiles;
+
+	GLUSboolean result;
+
+	pass.plan = plan;
+	pass.real = real;
+	pass.imaginary = imaginary;
+	pass.stride = stride;
+	pass.numberBlocks = numberBlocks;
+	pass.scalar = scalar;
+	pass.scratch = 0;
+	pass.numberScratch = 0;
+	pass.failed = GLUS_FALSE;
+
+	if (stride == 1)
+	{
+		numberTiles = (numberBlocks + GLUS_FOURIER_BLOCK - 1) / GLUS_FOURIER_BLOCK;
+	}
+	else
+	{
+		numberTiles = numberBlocks * ((stride + GLUS_FOURIER_BLOCK - 1) / GLUS_FOURIER_BLOCK);
+
+		pass.numberScratch = _glusThreadGetNumberTileWorkers(numberTiles, numberThreads);
+		pass.scratch = (GLUSfloat*)glusMemoryMalloc(pass.numberScratch * 2 * GLUS_FOURIER_BLOCK * plan->n * sizeof(GLUSfloat));
+
+		if (!pass.scratch)
+		{
+			return GLUS_FALSE;
+		}
+	}
+
+	result = _glusThreadRunTiles(numberTiles, numberThreads, glusFourierPassTile, &pass) && !pass.failed;
+
+	glusMemoryFree(pass.scratch);
+
+	return result;
+}
+
+/**
+ * Separable transform over up to three axes. The inverse is done by exchanging real and imaginary parts.
+ */
+static GLUSboolean glusFourierMultiTransform(const GLUSfourierplan* planX, const GLUSfourierplan* planY, const GLUSfourierplan* planZ, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberTransforms, const GLUSboolean inverse, const GLUSint numberThreads)
+{
+	GLUSint width, height, depth;
+
+	GLUSfloat scalar;
+
+	GLUSfloat* temp;
+
+	if (!planX || !planX->bitReverse || (planY && !planY->bitReverse) || (planZ && !planZ->bitReverse) || !real || !imaginary || numberTransforms < 1)
+	{
+		return GLUS_FALSE;
+	}
+
+	width = planX->n;
+	height = planY ? planY->n : 1;
+	depth = planZ ? planZ->n : 1;
+
+	scalar = 1.0f;
+
+	if (inverse)
+	{
+		temp = real;
+		real = imaginary;
+		imaginary = temp;
+	}
+	else
+	{
+		scalar = 1.0f / ((GLUSfloat)width * (GLUSfloat)height * (GLUSfloat)depth);
+	}
+
+	// The scaling is done once by the last pass.
+
+	if (!glusFourierPass(planX, real, imaginary, 1, height * depth * numberTransforms, planY ? 1.0f : scalar, numberThreads))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (planY && !glusFourierPass(planY, real, imaginary, width, depth, planZ ? 1.0f : scalar, numberThreads))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (planZ && !glusFourierPass(planZ, real, imaginary, width * height, 1, scalar, numberThreads))
+	{
+		return GLUS_FALSE;
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusFourierBatchFFTf(const GLUSfourierplan* plan, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberTransforms, const GLUSint numberThreads)
+{
+	return glusFourierMultiTransform(plan, 0, 0, real, imaginary, numberTransforms, GLUS_FALSE, numberThreads);
+}
+
+GLUSboolean GLUSAPIENTRY glusFourierBatchInverseFFTf(const GLUSfourierplan* plan, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberTransforms, const GLUSint numberThreads)
+{
+	return glusFourierMultiTransform(plan, 0, 0, real, imaginary, numberTransforms, GLUS_TRUE, numberThreads);
+}
+
+GLUSboolean GLUSAPIENTRY glusFourier2DFFTf(const GLUSfourierplan* planX, const GLUSfourierplan* planY, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberThreads)
+{
+	if (!planY)
+	{
+		return GLUS_FALSE;
+	}
+
+	return glusFourierMultiTransform(planX, planY, 0, real, imaginary, 1, GLUS_FALSE, numberThreads);
+}
+
+GLUSboolean GLUSAPIENTRY glusFourier2DInverseFFTf(const GLUSfourierplan* planX, const GLUSfourierplan* planY, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberThreads)
+{
+	if (!planY)
+	{
+		return GLUS_FALSE;
+	}
+
+	return glusFourierMultiTransform(planX, planY, 0, real, imaginary, 1, GLUS_TRUE, numberThreads);
+}
+
+GLUSboolean GLUSAPIENTRY glusFourier3DFFTf(const GLUSfourierplan* planX, const GLUSfourierplan* planY, const GLUSfourierplan* planZ, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberThreads)
+{
+	if (!planY || !planZ)
+	{
+		return GLUS_FALSE;
+	}
+
+	return glusFourierMultiTransform(planX, planY, planZ, real, imaginary, 1, GLUS_FALSE, numberThreads);
+}
+
+GLUSboolean GLUSAPIENTRY glusFourier3DInverseFFTf(const GLUSfourierplan* planX, const GLUSfourierplan* planY, const GLUSfourierplan* planZ, GLUSfloat* real, GLUSfloat* imaginary, const GLUSint numberThreads)
+{
+	if (!planY || !planZ)
+	{
+		return GLUS_FALSE;
+	}
+
+	return glusFourierMultiTransform(planX, planY, planZ, real, imaginary, 1, GLUS_TRUE, numberThreads);
+}
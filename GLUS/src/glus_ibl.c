@@ -0,0 +1,1156 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+#define GLUS_IBL_MAX_LEVELS 16
+
+extern GLUSboolean _glusThreadRunTiles(const GLUSint numberTiles, const GLUSint numberThreads, GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile), GLUSvoid* data);
+
+/**
+ * Cube map with all levels down to one texel. Texels are stored as RGB.
+ */
+typedef struct _GLUSiblcubemap
+{
+	GLUSfloat* faces[GLUS_IBL_MAX_LEVELS][6];
+
+	GLUSint size[GLUS_IBL_MAX_LEVELS];
+
+	GLUSint numberLevels;
+
+} GLUSiblcubemap;
+
+/**
+ * Sample directions in tangent space, where the z axis is the normal. Stored as separate arrays, so they are processed in one tight loop.
+ */
+typedef struct _GLUSiblsamples
+{
+	GLUSfloat* x;
+
+	GLUSfloat* y;
+
+	GLUSfloat* z;
+
+	GLUSfloat* weight;
+
+	GLUSfloat* lod;
+
+	GLUSint numberSamples;
+
+	GLUSfloat totalWeight;
+
+} GLUSiblsamples;
+
+typedef struct _GLUSiblprefilter
+{
+	GLUShdrimage* target;
+
+	const GLUSiblcubemap* source;
+
+	const GLUSiblsamples* samples;
+
+	const GLUSfloat* coefficients;
+
+	const GLUShdrimage* panorama;
+
+	GLUSenum mode;
+
+	GLUSint size;
+
+} GLUSiblprefilter;
+
+typedef struct _GLUSiblsh
+{
+	const GLUSiblcubemap* source;
+
+	GLUSfloat* rowCoefficients;
+
+} GLUSiblsh;
+
+typedef struct _GLUSibllut
+{
+	GLUSfloat* data;
+
+	GLUSint width;
+
+	GLUSint height;
+
+	const GLUSfloat* cosPhi;
+
+	const GLUSfloat* sinPhi;
+
+	const GLUSfloat* xi;
+
+	GLUSint numberSamples;
+
+	GLUSboolean failed;
+
+} GLUSibllut;
+
+static const GLUSchar* GLUS_IBL_FACE_NAMES[6] = { "POS_X", "NEG_X", "POS_Y", "NEG_Y", "POS_Z", "NEG_Z" };
+
+/**
+ * Direction of a face position in the range [-1.0, 1.0] as defined by the OpenGL cube map layout. The result is not normalized.
+ */
+static GLUSvoid glusIblGetFaceDirection(GLUSfloat direction[3], const GLUSint face, const GLUSfloat sc, const GLUSfloat tc)
+{
+	switch (face)
+	{
+		case 0:
+			direction[0] = 1.0f;
+			direction[1] = -tc;
+			direction[2] = -sc;
+			break;
+		case 1:
+			direction[0] = -1.0f;
+			direction[1] = -tc;
+			direction[2] = sc;
+			break;
+		case 2:
+			direction[0] = sc;
+			direction[1] = 1.0f;
+			direction[2] = tc;
+			break;
+		case 3:
+			direction[0] = sc;
+			direction[1] = -1.0f;
+			direction[2] = -tc;
+			break;
+		case 4:
+			direction[0] = sc;
+			direction[1] = -tc;
+			direction[2] = 1.0f;
+			break;
+		default:
+			direction[0] = -sc;
+			direction[1] = -tc;
+			direction[2] = -1.0f;
+			break;
+	}
+}
+
+/**
+ * Selects the face by the major axis of the direction and returns the texture coordinates in the range [0.0, 1.0].
+ */
+static GLUSint glusIblGetFace(GLUSfloat* s, GLUSfloat* t, const GLUSfloat direction[3])
+{
+	GLUSfloat absX = fabsf(direction[0]);
+	GLUSfloat absY = fabsf(direction[1]);
+	GLUSfloat absZ = fabsf(direction[2]);
+
+	GLUSfloat sc, tc, ma;
+
+	GLUSint face;
+
+	if (absX >= absY && absX >= absZ)
+	{
+		ma = absX;
+
+		if (direction[0] >= 0.0f)
+		{
+			face = 0;
+			sc = -direction[2];
+		}
+		else
+		{
+			face = 1;
+			sc = direction[2];
+		}
+		tc = -direction[1];
+	}
+	else if (absY >= absZ)
+	{
+		ma = absY;
+
+		sc = direction[0];
+
+		if (direction[1] >= 0.0f)
+		{
+			face = 2;
+			tc = direction[2];
+		}
+		else
+		{
+			face = 3;
+			tc = -direction[2];
+		}
+	}
+	else
+	{
+		ma = absZ;
+
+		if (direction[2] >= 0.0f)
+		{
+			face = 4;
+			sc = direction[0];
+		}
+		else
+		{
+			face = 5;
+			sc = -direction[0];
+		}
+		tc = -direction[1];
+	}
+
+	*s = 0.5f * (sc / ma + 1.0f);
+	*t = 0.5f * (tc / ma + 1.0f);
+
+	return face;
+}
+
+static GLUSvoid glusIblSampleLevel(GLUSfloat rgb[3], const GLUSiblcubemap* cubeMap, const GLUSint level, const GLUSint face, const GLUSfloat s, const GLUSfloat t)
+{
+	const GLUSfloat* data = cubeMap->faces[level][face];
+
+	GLUSint size = cubeMap->size[level];
+
+	GLUSfloat x = s * (GLUSfloat)size - 0.5f;
+	GLUSfloat y = t * (GLUSfloat)size - 0.5f;
+
+	GLUSfloat fx = floorf(x);
+	GLUSfloat fy = floorf(y);
+
+	GLUSfloat wx = x - fx;
+	GLUSfloat wy = y - fy;
+
+	GLUSint x0 = (GLUSint)fx;
+	GLUSint y0 = (GLUSint)fy;
+	GLUSint x1 = x0 + 1;
+	GLUSint y1 = y0 + 1;
+
+	const GLUSfloat* t00;
+	const GLUSfloat* t10;
+	const GLUSfloat* t01;
+	const GLUSfloat* t11;
+
+	GLUSint i;
+
+	// Clamp to the edge of the face.
+
+	x0 = x0 < 0 ? 0 : (x0 >= size ? size - 1 : x0);
+	x1 = x1 < 0 ? 0 : (x1 >= size ? size - 1 : x1);
+	y0 = y0 < 0 ? 0 : (y0 >= size ? size - 1 : y0);
+	y1 = y1 < 0 ? 0 : (y1 >= size ? size - 1 : y1);
+
+	t00 = &data[(y0 * size + x0) * 3];
+	t10 = &data[(y0 * size + x1) * 3];
+	t01 = &data[(y1 * size + x0) * 3];
+	t11 = &data[(y1 * size + x1) * 3];
+
+	for (i = 0; i < 3; i++)
+	{
+		rgb[i] = (t00[i] * (1.0f - wx) + t10[i] * wx) * (1.0f - wy) + (t01[i] * (1.0f - wx) + t11[i] * wx) * wy;
+	}
+}
+
+/**
+ * Samples the cube map with linear filtering between the levels.
+ */
+static GLUSvoid glusIblSampleCubeMap(GLUSfloat rgb[3], const GLUSiblcubemap* cubeMap, const GLUSfloat direction[3], GLUSfloat lod)
+{
+	GLUSfloat s, t, fraction;
+	GLUSfloat next[3];
+
+	GLUSint face, level;
+
+	face = glusIblGetFace(&s, &t, direction);
+
+	lod = glusMathClampf(lod, 0.0f, (GLUSfloat)(cubeMap->numberLevels - 1));
+
+	level = (GLUSint)lod;
+	fraction = lod - (GLUSfloat)level;
+
+	glusIblSampleLevel(rgb, cubeMap, level, face, s, t);
+
+	if (fraction > 0.0f && level + 1 < cubeMap->numberLevels)
+	{
+		glusIblSampleLevel(next, cubeMap, level + 1, face, s, t);
+
+		rgb[0] += (next[0] - rgb[0]) * fraction;
+		rgb[1] += (next[1] - rgb[1]) * fraction;
+		rgb[2] += (next[2] - rgb[2]) * fraction;
+	}
+}
+
+static GLUSvoid glusIblDestroyCubeMap(GLUSiblcubemap* cubeMap)
+{
+	GLUSint level, face;
+
+	for (level = 0; level < GLUS_IBL_MAX_LEVELS; level++)
+	{
+		for (face = 0; face < 6; face++)
+		{
+			glusMemoryFree(cubeMap->faces[level][face]);
+
+			cubeMap->faces[level][face] = 0;
+		}
+	}
+
+	cubeMap->numberLevels = 0;
+}
+
+/**
+ * Converts the source faces to RGB and builds all levels using a box filter.
+ */
+static GLUSboolean glusIblCreateCubeMap(GLUSiblcubemap* cubeMap, const GLUShdrimage source[6])
+{
+	GLUSint level, face, x, y, c, size, previousSize, stride, i;
+
+	const GLUSfloat* previous;
+	GLUSfloat* current;
+
+	for (level = 0; level < GLUS_IBL_MAX_LEVELS; level++)
+	{
+		for (face = 0; face < 6; face++)
+		{
+			cubeMap->faces[level][face] = 0;
+		}
+		cubeMap->size[level] = 0;
+	}
+	cubeMap->numberLevels = 0;
+
+	if (!source)
+	{
+		return GLUS_FALSE;
+	}
+
+	size = source[0].width;
+
+	for (face = 0; face < 6; face++)
+	{
+		if (!source[face].data || source[face].width != size || source[face].height != size || (source[face].format != GLUS_RGB && source[face].format != GLUS_RGBA))
+		{
+			return GLUS_FALSE;
+		}
+	}
+
+	if (size < 1)
+	{
+		return GLUS_FALSE;
+	}
+
+	cubeMap->size[0] = size;
+	cubeMap->numberLevels = 1;
+
+	for (face = 0; face < 6; face++)
+	{
+		stride = source[face].format == GLUS_RGBA ? 4 : 3;
+
+		cubeMap->faces[0][face] = (GLUSfloat*)glusMemoryMalloc(size * size * 3 * sizeof(GLUSfloat));
+
+		if (!cubeMap->faces[0][face])
+		{
+			glusIblDestroyCubeMap(cubeMap);
+
+			return GLUS_FALSE;
+		}
+
+		for (i = 0; i < size * size; i++)
+		{
+			for (c = 0; c < 3; c++)
+			{
+				cubeMap->faces[0][face][i * 3 + c] = source[face].data[i * stride + c];
+			}
+		}
+	}
+
+	for (level = 1; level < GLUS_IBL_MAX_LEVELS && cubeMap->size[level - 1] > 1; level++)
+	{
+		previousSize = cubeMap->size[level - 1];
+		size = previousSize / 2;
+
+		cubeMap->size[level] = size;
+
+		for (face = 0; face < 6; face++)
+		{
+			current = (GLUSfloat*)glusMemoryMalloc(size * size * 3 * sizeof(GLUSfloat));
+
+			if (!current)
+			{
+				glusIblDestroyCubeMap(cubeMap);
+
+				return GLUS_FALSE;
+			}
+
+			cubeMap->faces[level][face] = current;
+
+			previous = cubeMap->faces[level - 1][face];
+
+			for (y = 0; y < size; y++)
+			{
+				for (x = 0; x < size; x++)
+				{
+					for (c = 0; c < 3; c++)
+					{
+						current[(y * size + x) * 3 + c] = 0.25f * (previous[((2 * y) * previousSize + 2 * x) * 3 + c] + previous[((2 * y) * previousSize + 2 * x + 1) * 3 + c] + previous[((2 * y + 1) * previousSize + 2 * x) * 3 + c] + previous[((2 * y + 1) * previousSize + 2 * x + 1) * 3 + c]);
+					}
+				}
+			}
+		}
+
+		cubeMap->numberLevels++;
+	}
+
+	return GLUS_TRUE;
+}
+
+static GLUSvoid glusIblDestroySamples(GLUSiblsamples* samples)
+{
+	// All arrays share one allocation.
+	glusMemoryFree(samples->x);
+
+	samples->x = 0;
+	samples->y = 0;
+	samples->z = 0;
+	samples->weight = 0;
+	samples->lod = 0;
+	samples->numberSamples = 0;
+}
+
+/**
+ * Creates the sample directions and their source level once, as they are equal for every texel.
+ */
+static GLUSboolean glusIblCreateSamples(GLUSiblsamples* samples, const GLUSenum mode, const GLUSfloat roughness, const GLUSubyte m, const GLUSint sourceSize, const GLUSint targetSize)
+{
+	GLUSint maxSamples = 1 << m;
+	GLUSint i;
+
+	GLUSfloat xi[2];
+	GLUSfloat alpha, alphaSquared, phi, cosTheta, sinTheta, hx, hy, hz, lx, ly, lz, pdf, d, texelSolidAngle, sampleSolidAngle, minLod;
+
+	samples->x = (GLUSfloat*)glusMemoryMalloc(5 * maxSamples * sizeof(GLUSfloat));
+
+	if (!samples->x)
+	{
+		return GLUS_FALSE;
+	}
+
+	samples->y = samples->x + maxSamples;
+	samples->z = samples->y + maxSamples;
+	samples->weight = samples->z + maxSamples;
+	samples->lod = samples->weight + maxSamples;
+	samples->numberSamples = 0;
+	samples->totalWeight = 0.0f;
+
+	alpha = roughness * roughness;
+	alphaSquared = alpha * alpha;
+
+	texelSolidAngle = 4.0f * GLUS_PI / (6.0f * (GLUSfloat)sourceSize * (GLUSfloat)sourceSize);
+
+	// A smaller target never needs more detail than one of its texels covers.
+	minLod = glusMathMaxf(log2f((GLUSfloat)sourceSize / (GLUSfloat)targetSize), 0.0f);
+
+	for (i = 0; i < maxSamples; i++)
+	{
+		glusRandomHammersleyf(xi, (GLUSuint)i, m);
+
+		phi = 2.0f * GLUS_PI * xi[0];
+
+		if (mode == GLUS_IBL_SPECULAR_GGX)
+		{
+			// see http://blog.selfshadow.com/publications/s2013-shading-course/karis/s2013_pbs_epic_notes_v2.pdf
+			cosTheta = sqrtf((1.0f - xi[1]) / (1.0f + (alphaSquared - 1.0f) * xi[1]));
+			sinTheta = sqrtf(1.0f - cosTheta * cosTheta);
+
+			hx = sinTheta * cosf(phi);
+			hy = sinTheta * sinf(phi);
+			hz = cosTheta;
+
+			// Reflect the view vector, which is equal to the normal.
+			lx = 2.0f * hz * hx;
+			ly = 2.0f * hz * hy;
+			lz = 2.0f * hz * hz - 1.0f;
+
+			if (lz <= 0.0f)
+			{
+				continue;
+			}
+
+			// As normal and view vector are equal, the pdf of the reflected vector is D / 4.
+			d = alphaSquared / (GLUS_PI * (hz * hz * (alphaSquared - 1.0f) + 1.0f) * (hz * hz * (alphaSquared - 1.0f) + 1.0f));
+			pdf = d * 0.25f;
+
+			samples->weight[samples->numberSamples] = lz;
+		}
+		else
+		{
+			cosTheta = sqrtf(1.0f - xi[1]);
+			sinTheta = sqrtf(xi[1]);
+
+			lx = sinTheta * cosf(phi);
+			ly = sinTheta * sinf(phi);
+			lz = cosTheta;
+
+			if (lz <= 0.0f)
+			{
+				continue;
+			}
+
+			pdf = cosTheta / GLUS_PI;
+
+			// Cosine is already part of the distribution.
+			samples->weight[samples->numberSamples] = 1.0f;
+		}
+
+		samples->x[samples->numberSamples] = lx;
+		samples->y[samples->numberSamples] = ly;
+		samples->z[samples->numberSamples] = lz;
+
+		// see GPU Gems 3, Chapter 20. GPU-Based Importance Sampling
+		if (alpha == 0.0f && mode == GLUS_IBL_SPECULAR_GGX)
+		{
+			samples->lod[samples->numberSamples] = minLod;
+		}
+		else
+		{
+			sampleSolidAngle = 1.0f / ((GLUSfloat)maxSamples * pdf);
+
+			samples->lod[samples->numberSamples] = glusMathMaxf(0.5f * log2f(sampleSolidAngle / texelSolidAngle) + 1.0f, minLod);
+		}
+
+		samples->totalWeight += samples->weight[samples->numberSamples];
+
+		samples->numberSamples++;
+	}
+
+	if (samples->numberSamples == 0)
+	{
+		glusIblDestroySamples(samples);
+
+		return GLUS_FALSE;
+	}
+
+	return GLUS_TRUE;
+}
+
+static GLUSvoid glusIblGetShBasis(GLUSfloat basis[9], const GLUSfloat direction[3])
+{
+	GLUSfloat x = direction[0];
+	GLUSfloat y = direction[1];
+	GLUSfloat z = direction[2];
+
+	basis[0] = 0.282095f;
+
+	basis[1] = 0.488603f * y;
+	basis[2] = 0.488603f * z;
+	basis[3] = 0.488603f * x;
+
+	basis[4] = 1.092548f * x * y;
+	basis[5] = 1.092548f * y * z;
+	basis[6] = 0.315392f * (3.0f * z * z - 1.0f);
+	basis[7] = 1.092548f * x * z;
+	basis[8] = 0.546274f * (x * x - y * y);
+}
+
+static GLUSfloat glusIblGetAreaElement(const GLUSfloat x, const GLUSfloat y)
+{
+	return atan2f(x * y, sqrtf(x * x + y * y + 1.0f));
+}
+
+static GLUSvoid glusIblPrefilterRow(GLUSvoid* data, const GLUSint tile)
+{
+	GLUSiblprefilter* prefilter = (GLUSiblprefilter*)data;
+
+	const GLUSiblsamples* samples = prefilter->samples;
+
+	GLUSint size = prefilter->size;
+	GLUSint face = tile / size;
+	GLUSint y = tile % size;
+	GLUSint x, i;
+
+	GLUSfloat normal[3], tangent[3], bitangent[3], up[3], direction[3], rgb[3], color[3], st[2];
+	GLUSfloat inverseLength, inverseTotalWeight, phi, theta;
+
+	GLUSfloat* row = &prefilter->target[face].data[y * size * 3];
+
+	for (x = 0; x < size; x++)
+	{
+		glusIblGetFaceDirection(normal, face, 2.0f * ((GLUSfloat)x + 0.5f) / (GLUSfloat)size - 1.0f, 2.0f * ((GLUSfloat)y + 0.5f) / (GLUSfloat)size - 1.0f);
+
+		inverseLength = 1.0f / sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+		normal[0] *= inverseLength;
+		normal[1] *= inverseLength;
+		normal[2] *= inverseLength;
+
+		if (prefilter->panorama)
+		{
+			// Equirectangular projection, where the first row of the image is the bottom.
+			phi = atan2f(normal[0], -normal[2]);
+			theta = asinf(glusMathClampf(normal[1], -1.0f, 1.0f));
+
+			st[0] = 0.5f + phi / (2.0f * GLUS_PI);
+			st[1] = 0.5f + theta / GLUS_PI;
+
+			glusImageSampleHdr2D(color, prefilter->panorama, st);
+		}
+		else if (prefilter->mode == GLUS_IBL_DIFFUSE_SH)
+		{
+			glusIblEvaluateSh(color, prefilter->coefficients, normal);
+		}
+		else
+		{
+			up[0] = 0.0f;
+			up[1] = 0.0f;
+			up[2] = 1.0f;
+
+			if (fabsf(normal[2]) > 0.999f)
+			{
+				up[0] = 1.0f;
+				up[2] = 0.0f;
+			}
+
+			glusVector3Crossf(tangent, up, normal);
+			glusVector3Normalizef(tangent);
+			glusVector3Crossf(bitangent, normal, tangent);
+
+			color[0] = 0.0f;
+			color[1] = 0.0f;
+			color[2] = 0.0f;
+
+			for (i = 0; i < samples->numberSamples; i++)
+			{
+				direction[0] = tangent[0] * samples->x[i] + bitangent[0] * samples->y[i] + normal[0] * samples->z[i];
+				direction[1] = tangent[1] * samples->x[i] + bitangent[1] * samples->y[i] + normal[1] * samples->z[i];
+				direction[2] = tangent[2] * samples->x[i] + bitangent[2] * samples->y[i] + normal[2] * samples->z[i];
+
+				glusIblSampleCubeMap(rgb, prefilter->source, direction, samples->lod[i]);
+
+				color[0] += rgb[0] * samples->weight[i];
+				color[1] += rgb[1] * samples->weight[i];
+				color[2] += rgb[2] * samples->weight[i];
+			}
+
+			inverseTotalWeight = 1.0f / samples->totalWeight;
+
+			color[0] *= inverseTotalWeight;
+			color[1] *= inverseTotalWeight;
+			color[2] *= inverseTotalWeight;
+		}
+
+		row[x * 3 + 0] = color[0];
+		row[x * 3 + 1] = color[1];
+		row[x * 3 + 2] = color[2];
+	}
+}
+
+static GLUSvoid glusIblProjectRow(GLUSvoid* data, const GLUSint tile)
+{
+	GLUSiblsh* sh = (GLUSiblsh*)data;
+
+	GLUSint size = sh->source->size[0];
+	GLUSint face = tile / size;
+	GLUSint y = tile % size;
+	GLUSint x, i;
+
+	const GLUSfloat* texel = &sh->source->faces[0][face][y * size * 3];
+
+	GLUSfloat* coefficients = &sh->rowCoefficients[tile * 27];
+
+	GLUSfloat direction[3], basis[9];
+	GLUSfloat inverseSize, x0, x1, y0, y1, solidAngle, inverseLength;
+
+	for (i = 0; i < 27; i++)
+	{
+		coefficients[i] = 0.0f;
+	}
+
+	inverseSize = 1.0f / (GLUSfloat)size;
+
+	y0 = 2.0f * (GLUSfloat)y * inverseSize - 1.0f;
+	y1 = 2.0f * (GLUSfloat)(y + 1) * inverseSize - 1.0f;
+
+	for (x = 0; x < size; x++)
+	{
+		x0 = 2.0f * (GLUSfloat)x * inverseSize - 1.0f;
+		x1 = 2.0f * (GLUSfloat)(x + 1) * inverseSize - 1.0f;
+
+		// Exact solid angle of the texel on the unit sphere.
+		solidAngle = glusIblGetAreaElement(x0, y0) - glusIblGetAreaElement(x0, y1) - glusIblGetAreaElement(x1, y0) + glusIblGetAreaElement(x1, y1);
+
+		glusIblGetFaceDirection(direction, face, 0.5f * (x0 + x1), 0.5f * (y0 + y1));
+
+		inverseLength = 1.0f / sqrtf(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+
+		direction[0] *= inverseLength;
+		direction[1] *= inverseLength;
+		direction[2] *= inverseLength;
+
+		glusIblGetShBasis(basis, direction);
+
+		for (i = 0; i < 9; i++)
+		{
+			coefficients[i * 3 + 0] += texel[x * 3 + 0] * basis[i] * solidAngle;
+			coefficients[i * 3 + 1] += texel[x * 3 + 1] * basis[i] * solidAngle;
+			coefficients[i * 3 + 2] += texel[x * 3 + 2] * basis[i] * solidAngle;
+		}
+	}
+}
+
+static GLUSvoid glusIblIntegrateBrdfRow(GLUSvoid* data, const GLUSint tile)
+{
+	GLUSibllut* lut = (GLUSibllut*)data;
+
+	GLUSint numberSamples = lut->numberSamples;
+	GLUSint x, i;
+
+	GLUSfloat roughness = ((GLUSfloat)tile + 0.5f) / (GLUSfloat)lut->height;
+	GLUSfloat alpha = roughness * roughness;
+	GLUSfloat alphaSquared = alpha * alpha;
+
+	// see http://blog.selfshadow.com/publications/s2013-shading-course/karis/s2013_pbs_epic_notes_v2.pdf
+	GLUSfloat k = alpha * 0.5f;
+
+	GLUSfloat vx, vz, hz, vDotH, lz, g, visibility, fresnel, scale, bias, cosTheta;
+
+	GLUSfloat* hx;
+	GLUSfloat* hy;
+	GLUSfloat* hzs;
+
+	// Half vectors only depend on the roughness, so they are shared by the whole row.
+
+	hx = (GLUSfloat*)glusMemoryMalloc(3 * numberSamples * sizeof(GLUSfloat));
+
+	if (!hx)
+	{
+		lut->failed = GLUS_TRUE;
+
+		return;
+	}
+
+	hy = hx + numberSamples;
+	hzs = hy + numberSamples;
+
+	for (i = 0; i < numberSamples; i++)
+	{
+		cosTheta = sqrtf((1.0f - lut->xi[i]) / (1.0f + (alphaSquared - 1.0f) * lut->xi[i]));
+
+		hx[i] = sqrtf(1.0f - cosTheta * cosTheta) * lut->cosPhi[i];
+		hy[i] = sqrtf(1.0f - cosTheta * cosTheta) * lut->sinPhi[i];
+		hzs[i] = cosTheta;
+	}
+
+	for (x = 0; x < lut->width; x++)
+	{
+		vz = ((GLUSfloat)x + 0.5f) / (GLUSfloat)lut->width;
+		vx = sqrtf(1.0f - vz * vz);
+
+		scale = 0.0f;
+		bias = 0.0f;
+
+		for (i = 0; i < numberSamples; i++)
+		{
+			hz = hzs[i];
+
+			vDotH = vx * hx[i] + vz * hz;
+
+			lz = 2.0f * vDotH * hz - vz;
+
+			if (lz > 0.0f && vDotH > 0.0f)
+			{
+				g = (vz / (vz * (1.0f - k) + k)) * (lz / (lz * (1.0f - k) + k));
+
+				visibility = g * vDotH / (hz * vz);
+
+				fresnel = powf(1.0f - vDotH, 5.0f);
+
+				scale += (1.0f - fresnel) * visibility;
+				bias += fresnel * visibility;
+			}
+		}
+
+		lut->data[(tile * lut->width + x) * 2 + 0] = scale / (GLUSfloat)numberSamples;
+		lut->data[(tile * lut->width + x) * 2 + 1] = bias / (GLUSfloat)numberSamples;
+	}
+
+	glusMemoryFree(hx);
+}
+
+static GLUSvoid glusIblDestroyFaces(GLUShdrimage faces[6])
+{
+	GLUSint face;
+
+	for (face = 0; face < 6; face++)
+	{
+		glusImageDestroyHdr(&faces[face]);
+	}
+}
+
+static GLUSboolean glusIblCreateFaces(GLUShdrimage faces[6], const GLUSint size)
+{
+	GLUSint face;
+
+	for (face = 0; face < 6; face++)
+	{
+		faces[face].data = 0;
+	}
+
+	for (face = 0; face < 6; face++)
+	{
+		if (!glusImageCreateHdr(&faces[face], size, size, 1, GLUS_RGB))
+		{
+			glusIblDestroyFaces(faces);
+
+			return GLUS_FALSE;
+		}
+	}
+
+	return GLUS_TRUE;
+}
+
+static GLUSboolean glusIblProjectSh(GLUSfloat coefficients[27], const GLUSiblcubemap* cubeMap, const GLUSint numberThreads)
+{
+	GLUSiblsh sh;
+
+	GLUSint numberRows, row, i;
+
+	GLUSboolean result;
+
+	numberRows = 6 * cubeMap->size[0];
+
+	sh.source = cubeMap;
+	sh.rowCoefficients = (GLUSfloat*)glusMemoryMalloc(numberRows * 27 * sizeof(GLUSfloat));
+
+	if (!sh.rowCoefficients)
+	{
+		return GLUS_FALSE;
+	}
+
+	// Every row is summed up separately, so no synchronization is needed.
+	result = _glusThreadRunTiles(numberRows, numberThreads, glusIblProjectRow, &sh);
+
+	if (result)
+	{
+		for (i = 0; i < 27; i++)
+		{
+			coefficients[i] = 0.0f;
+		}
+
+		for (row = 0; row < numberRows; row++)
+		{
+			for (i = 0; i < 27; i++)
+			{
+				coefficients[i] += sh.rowCoefficients[row * 27 + i];
+			}
+		}
+	}
+
+	glusMemoryFree(sh.rowCoefficients);
+
+	return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusIblCreateCubeMapFromPanorama(GLUShdrimage cubeMap[6], const GLUShdrimage* panorama, const GLUSint size, const GLUSint numberThreads)
+{
+	GLUSiblprefilter prefilter;
+
+	if (!cubeMap || !panorama || !panorama->data || size < 1)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!glusIblCreateFaces(cubeMap, size))
+	{
+		return GLUS_FALSE;
+	}
+
+	prefilter.target = cubeMap;
+	prefilter.source = 0;
+	prefilter.samples = 0;
+	prefilter.coefficients = 0;
+	prefilter.panorama = panorama;
+	prefilter.mode = 0;
+	prefilter.size = size;
+
+	if (!_glusThreadRunTiles(6 * size, numberThreads, glusIblPrefilterRow, &prefilter))
+	{
+		glusIblDestroyFaces(cubeMap);
+
+		return GLUS_FALSE;
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusIblPrefilterCubeMap(GLUShdrimage target[6], const GLUShdrimage source[6], const GLUSenum mode, const GLUSfloat roughness, const GLUSint size, const GLUSubyte m, const GLUSint numberThreads)
+{
+	GLUSiblcubemap cubeMap;
+	GLUSiblsamples samples;
+	GLUSiblprefilter prefilter;
+
+	GLUSfloat coefficients[27];
+
+	GLUSboolean result;
+
+	if (!target || !source || size < 1 || roughness < 0.0f || roughness > 1.0f)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (mode != GLUS_IBL_SPECULAR_GGX && mode != GLUS_IBL_DIFFUSE_LAMBERT && mode != GLUS_IBL_DIFFUSE_SH)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (mode != GLUS_IBL_DIFFUSE_SH && (m == 0 || m > 16))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!glusIblCreateCubeMap(&cubeMap, source))
+	{
+		return GLUS_FALSE;
+	}
+
+	samples.x = 0;
+
+	if (mode == GLUS_IBL_DIFFUSE_SH)
+	{
+		if (!glusIblProjectSh(coefficients, &cubeMap, numberThreads))
+		{
+			glusIblDestroyCubeMap(&cubeMap);
+
+			return GLUS_FALSE;
+		}
+	}
+	else if (!glusIblCreateSamples(&samples, mode, roughness, m, cubeMap.size[0], size))
+	{
+		glusIblDestroyCubeMap(&cubeMap);
+
+		return GLUS_FALSE;
+	}
+
+	if (!glusIblCreateFaces(target, size))
+	{
+		glusIblDestroySamples(&samples);
+		glusIblDestroyCubeMap(&cubeMap);
+
+		return GLUS_FALSE;
+	}
+
+	prefilter.target = target;
+	prefilter.source = &cubeMap;
+	prefilter.samples = &samples;
+	prefilter.coefficients = coefficients;
+	prefilter.panorama = 0;
+	prefilter.mode = mode;
+	prefilter.size = size;
+
+	// One row of a face is one tile.
+	result = _glusThreadRunTiles(6 * size, numberThreads, glusIblPrefilterRow, &prefilter);
+
+	glusIblDestroySamples(&samples);
+	glusIblDestroyCubeMap(&cubeMap);
+
+	if (!result)
+	{
+		glusIblDestroyFaces(target);
+	}
+
+	return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusIblComputeSh(GLUSfloat coefficients[27], const GLUShdrimage source[6], const GLUSint numberThreads)
+{
+	GLUSiblcubemap cubeMap;
+
+	GLUSboolean result;
+
+	if (!coefficients || !glusIblCreateCubeMap(&cubeMap, source))
+	{
+		return GLUS_FALSE;
+	}
+
+	result = glusIblProjectSh(coefficients, &cubeMap, numberThreads);
+
+	glusIblDestroyCubeMap(&cubeMap);
+
+	return result;
+}
+
+GLUSvoid GLUSAPIENTRY glusIblEvaluateSh(GLUSfloat rgb[3], const GLUSfloat coefficients[27], const GLUSfloat normal[3])
+{
+	// see An Efficient Representation for Irradiance Environment Maps, Ramamoorthi and Hanrahan
+	// The band factors pi, 2pi/3 and pi/4 are already divided by pi.
+	static const GLUSfloat bandFactor[9] = { 1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f };
+
+	GLUSfloat basis[9];
+
+	GLUSint i;
+
+	if (!rgb || !coefficients || !normal)
+	{
+		return;
+	}
+
+	glusIblGetShBasis(basis, normal);
+
+	rgb[0] = 0.0f;
+	rgb[1] = 0.0f;
+	rgb[2] = 0.0f;
+
+	for (i = 0; i < 9; i++)
+	{
+		rgb[0] += bandFactor[i] * coefficients[i * 3 + 0] * basis[i];
+		rgb[1] += bandFactor[i] * coefficients[i * 3 + 1] * basis[i];
+		rgb[2] += bandFactor[i] * coefficients[i * 3 + 2] * basis[i];
+	}
+
+	// Ringing can produce negative values for high contrast environments.
+	rgb[0] = glusMathMaxf(rgb[0], 0.0f);
+	rgb[1] = glusMathMaxf(rgb[1], 0.0f);
+	rgb[2] = glusMathMaxf(rgb[2], 0.0f);
+}
+
+GLUSboolean GLUSAPIENTRY glusIblCreateBrdfLut(GLUSbinaryfile* lut, const GLUSint width, const GLUSint height, const GLUSubyte m, const GLUSint numberThreads)
+{
+	GLUSibllut integration;
+
+	GLUSfloat* table;
+
+	GLUSfloat xi[2];
+
+	GLUSint numberSamples, i;
+
+	GLUSboolean result;
+
+	if (!lut || width < 1 || height < 1 || m == 0 || m > 16)
+	{
+		return GLUS_FALSE;
+	}
+
+	lut->binary = 0;
+	lut->length = 0;
+
+	numberSamples = 1 << m;
+
+	table = (GLUSfloat*)glusMemoryMalloc(3 * numberSamples * sizeof(GLUSfloat));
+
+	if (!table)
+	{
+		return GLUS_FALSE;
+	}
+
+	lut->binary = (GLUSubyte*)glusMemoryMalloc(width * height * 2 * sizeof(GLUSfloat));
+
+	if (!lut->binary)
+	{
+		glusMemoryFree(table);
+
+		return GLUS_FALSE;
+	}
+
+	lut->length = width * height * 2 * (GLUSint)sizeof(GLUSfloat);
+
+	integration.data = (GLUSfloat*)lut->binary;
+	integration.width = width;
+	integration.height = height;
+	integration.cosPhi = table;
+	integration.sinPhi = table + numberSamples;
+	integration.xi = table + 2 * numberSamples;
+	integration.numberSamples = numberSamples;
+	integration.failed = GLUS_FALSE;
+
+	for (i = 0; i < numberSamples; i++)
+	{
+		glusRandomHammersleyf(xi, (GLUSuint)i, m);
+
+		table[i] = cosf(2.0f * GLUS_PI * xi[0]);
+		table[numberSamples + i] = sinf(2.0f * GLUS_PI * xi[0]);
+		table[2 * numberSamples + i] = xi[1];
+	}
+
+	// One row of the same roughness is one tile.
+	result = _glusThreadRunTiles(height, numberThreads, glusIblIntegrateBrdfRow, &integration) && !integration.failed;
+
+	glusMemoryFree(table);
+
+	if (!result)
+	{
+		glusFileDestroyBinary(lut);
+	}
+
+	return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusIblSaveHdr(const GLUSchar* prefix, const GLUShdrimage source[6], const GLUSint size, const GLUSint numberRoughness, const GLUSenum diffuseMode, const GLUSubyte m, const GLUSint numberThreads)
+{
+	GLUShdrimage target[6];
+
+	GLUSchar buffer[GLUS_MAX_FILENAME];
+
+	GLUSint level, face;
+
+	GLUSfloat roughness;
+
+	GLUSboolean result = GLUS_TRUE;
+
+	if (!prefix || numberRoughness < 1 || numberRoughness > 100 || (diffuseMode != GLUS_IBL_DIFFUSE_LAMBERT && diffuseMode != GLUS_IBL_DIFFUSE_SH))
+	{
+		return GLUS_FALSE;
+	}
+
+	// Prefix, face name, level and extension have to fit.
+	if (strlen(prefix) + 16 >= GLUS_MAX_FILENAME)
+	{
+		return GLUS_FALSE;
+	}
+
+	// The diffuse lighting is stored after the last roughness level.
+
+	for (level = 0; level <= numberRoughness && result; level++)
+	{
+		if (level < numberRoughness)
+		{
+			roughness = numberRoughness > 1 ? (GLUSfloat)level / (GLUSfloat)(numberRoughness - 1) : 0.0f;
+
+			result = glusIblPrefilterCubeMap(target, source, GLUS_IBL_SPECULAR_GGX, roughness, size, m, numberThreads);
+		}
+		else
+		{
+			result = glusIblPrefilterCubeMap(target, source, diffuseMode, 0.0f, size, m, numberThreads);
+		}
+
+		if (!result)
+		{
+			break;
+		}
+
+		for (face = 0; face < 6; face++)
+		{
+			if (level < numberRoughness)
+			{
+				sprintf(buffer, "%s_%s_%02d_s.hdr", prefix, GLUS_IBL_FACE_NAMES[face], level);
+			}
+			else
+			{
+				sprintf(buffer, "%s_%s_00_d.hdr", prefix, GLUS_IBL_FACE_NAMES[face]);
+			}
+
+			if (result && !glusImageSaveHdr(buffer, &target[face]))
+			{
+				glusLogPrint(GLUS_LOG_ERROR, "Could not save image '%s'", buffer);
+
+				result = GLUS_FALSE;
+			}
+
+			glusImageDestroyHdr(&target[face]);
+		}
+	}
+
+	return result;
+}
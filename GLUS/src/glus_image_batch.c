@@ -0,0 +1,276 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+extern GLUSboolean _glusThreadRunTiles(const GLUSint numberTiles, const GLUSint numberThreads, GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile), GLUSvoid* data);
+
+typedef struct _GLUSimagebatchdata
+{
+	GLUSimagebatchentry* entries;
+
+	GLUSint numberEntries;
+
+	GLUSint numberThreads;
+
+	GLUSimagebatchfunc callback;
+
+	GLUSvoid* userData;
+
+	/**
+	 * Per entry flag, if the entry is loaded. Protected by the mutex.
+	 */
+	GLUSboolean* loaded;
+
+	GLUSmutex mutex;
+
+	GLUScondition condition;
+
+	GLUSthread thread;
+
+} GLUSimagebatchdata;
+
+static GLUSvoid glusImageBatchLoadEntry(GLUSvoid* data, const GLUSint tile)
+{
+	GLUSimagebatchdata* batchData = (GLUSimagebatchdata*)data;
+
+	GLUSimagebatchentry* entry = &batchData->entries[tile];
+
+	switch (entry->type)
+	{
+		case GLUS_IMAGE_TGA:
+			entry->result = glusImageLoadTga(entry->filename, (GLUStgaimage*)entry->image);
+			break;
+		case GLUS_IMAGE_HDR:
+			entry->result = glusImageLoadHdr(entry->filename, (GLUShdrimage*)entry->image);
+			break;
+		case GLUS_IMAGE_PKM:
+			entry->result = glusImageLoadPkm(entry->filename, (GLUSpkmimage*)entry->image);
+			break;
+		default:
+			entry->result = GLUS_FALSE;
+			break;
+	}
+
+	if (!entry->result)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not load image '%s'", entry->filename ? entry->filename : "");
+	}
+
+	if (batchData->callback)
+	{
+		batchData->callback(entry, tile, batchData->userData);
+	}
+
+	glusMutexLock(&batchData->mutex);
+
+	batchData->loaded[tile] = GLUS_TRUE;
+
+	glusConditionBroadcast(&batchData->condition);
+
+	glusMutexUnlock(&batchData->mutex);
+}
+
+static GLUSvoid glusImageBatchRun(GLUSvoid* argument)
+{
+	GLUSimagebatchdata* batchData = (GLUSimagebatchdata*)argument;
+
+	GLUSint i;
+
+	// Each file is one tile, so idle workers take over the files of busy ones.
+
+	if (_glusThreadRunTiles(batchData->numberEntries, batchData->numberThreads, glusImageBatchLoadEntry, batchData))
+	{
+		return;
+	}
+
+	// Scheduler could not be set up, so load all files by this thread.
+
+	for (i = 0; i < batchData->numberEntries; i++)
+	{
+		glusImageBatchLoadEntry(batchData, i);
+	}
+}
+
+static GLUSvoid glusImageBatchDestroyData(GLUSimagebatchdata* batchData)
+{
+	glusConditionDestroy(&batchData->condition);
+	glusMutexDestroy(&batchData->mutex);
+
+	glusMemoryFree(batchData->loaded);
+	glusMemoryFree(batchData);
+}
+
+GLUSboolean GLUSAPIENTRY glusImageBatchStart(GLUSimagebatch* batch, GLUSimagebatchentry* entries, const GLUSint numberEntries, const GLUSint numberThreads, GLUSimagebatchfunc callback, GLUSvoid* userData)
+{
+	GLUSimagebatchdata* batchData;
+
+	GLUSint i;
+
+	if (!batch)
+	{
+		return GLUS_FALSE;
+	}
+
+	batch->handle = 0;
+
+	if (!entries || numberEntries <= 0)
+	{
+		return GLUS_FALSE;
+	}
+
+	batchData = (GLUSimagebatchdata*)glusMemoryMalloc(sizeof(GLUSimagebatchdata));
+
+	if (!batchData)
+	{
+		return GLUS_FALSE;
+	}
+
+	batchData->entries = entries;
+	batchData->numberEntries = numberEntries;
+	batchData->numberThreads = numberThreads > 0 ? numberThreads : glusThreadGetNumberProcessors();
+	batchData->callback = callback;
+	batchData->userData = userData;
+	batchData->loaded = (GLUSboolean*)glusMemoryMalloc(numberEntries * sizeof(GLUSboolean));
+	batchData->mutex.handle = 0;
+	batchData->condition.handle = 0;
+	batchData->thread.handle = 0;
+
+	if (!batchData->loaded || !glusMutexCreate(&batchData->mutex) || !glusConditionCreate(&batchData->condition))
+	{
+		glusImageBatchDestroyData(batchData);
+
+		return GLUS_FALSE;
+	}
+
+	for (i = 0; i < numberEntries; i++)
+	{
+		entries[i].result = GLUS_FALSE;
+
+		batchData->loaded[i] = GLUS_FALSE;
+	}
+
+	batch->handle = batchData;
+
+	// If no background thread is available, the files are loaded before returning.
+
+	if (!glusThreadCreate(&batchData->thread, glusImageBatchRun, batchData))
+	{
+		glusImageBatchRun(batchData);
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageBatchIsLoaded(GLUSimagebatch* batch, const GLUSint index)
+{
+	GLUSimagebatchdata* batchData;
+
+	GLUSboolean loaded;
+
+	if (!batch || !batch->handle)
+	{
+		return GLUS_FALSE;
+	}
+
+	batchData = (GLUSimagebatchdata*)batch->handle;
+
+	if (index < 0 || index >= batchData->numberEntries)
+	{
+		return GLUS_FALSE;
+	}
+
+	glusMutexLock(&batchData->mutex);
+
+	loaded = batchData->loaded[index];
+
+	glusMutexUnlock(&batchData->mutex);
+
+	return loaded;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageBatchWait(GLUSimagebatch* batch, const GLUSint index)
+{
+	GLUSimagebatchdata* batchData;
+
+	if (!batch || !batch->handle)
+	{
+		return GLUS_FALSE;
+	}
+
+	batchData = (GLUSimagebatchdata*)batch->handle;
+
+	if (index < 0 || index >= batchData->numberEntries)
+	{
+		return GLUS_FALSE;
+	}
+
+	glusMutexLock(&batchData->mutex);
+
+	while (!batchData->loaded[index])
+	{
+		glusConditionWait(&batchData->condition, &batchData->mutex);
+	}
+
+	glusMutexUnlock(&batchData->mutex);
+
+	return batchData->entries[index].result;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageBatchEnd(GLUSimagebatch* batch)
+{
+	GLUSimagebatchdata* batchData;
+
+	GLUSboolean result = GLUS_TRUE;
+
+	GLUSint i;
+
+	if (!batch || !batch->handle)
+	{
+		return GLUS_FALSE;
+	}
+
+	batchData = (GLUSimagebatchdata*)batch->handle;
+
+	glusThreadJoin(&batchData->thread);
+
+	for (i = 0; i < batchData->numberEntries; i++)
+	{
+		if (!batchData->entries[i].result)
+		{
+			result = GLUS_FALSE;
+		}
+	}
+
+	glusImageBatchDestroyData(batchData);
+
+	batch->handle = 0;
+
+	return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusImageLoadBatch(GLUSimagebatchentry* entries, const GLUSint numberEntries, const GLUSint numberThreads, GLUSimagebatchfunc callback, GLUSvoid* userData)
+{
+	GLUSimagebatch batch;
+
+	if (!glusImageBatchStart(&batch, entries, numberEntries, numberThreads, callback, userData))
+	{
+		return GLUS_FALSE;
+	}
+
+	return glusImageBatchEnd(&batch);
+}
@@ -19,17 +19,21 @@
 
 extern GLUSvoid _glusImageGatherSamplePoints(GLUSint sampleIndex[4], GLUSfloat sampleWeight[2], const GLUSfloat st[2], GLUSint width, GLUSint height, GLUSint stride);
 
-extern GLUSboolean _glusFileCheckRead(FILE* f, size_t actualRead, size_t expectedRead);
+extern GLUSboolean _glusFileMap(const GLUSchar* filename, GLUSubyte** data, size_t* length);
+extern GLUSvoid _glusFileUnmap(GLUSubyte* data, size_t length);
+
 extern GLUSboolean _glusFileCheckWrite(FILE* f, size_t actualWrite, size_t expectedWrite);
 
 static GLUSvoid glusImageConvertRGBE(GLUSfloat* rgb, const GLUSubyte* rgbe)
 {
-	GLUSfloat exponent = (GLUSfloat)(rgbe[3] - 128);
+	// Same as dividing by 256 and multiplying by two to the power of the exponent, but with one exact scaling.
+	GLUSfloat scale = ldexpf(1.0f, (GLUSint)rgbe[3] - 128 - 8);
 
-	rgb[0] = (GLUSfloat)rgbe[0] / 256.0f * powf(2.0f, exponent);
-	rgb[1] = (GLUSfloat)rgbe[1] / 256.0f * powf(2.0f, exponent);
-	rgb[2] = (GLUSfloat)rgbe[2] / 256.0f * powf(2.0f, exponent);
+	rgb[0] = (GLUSfloat)rgbe[0] * scale;
+	rgb[1] = (GLUSfloat)rgbe[1] * scale;
+	rgb[2] = (GLUSfloat)rgbe[2] * scale;
 }
+
 static GLUSvoid glusImageConvertRGB(GLUSubyte* rgbe, const GLUSfloat* rgb)
 {
 	GLUSfloat significant[3];
@@ -56,91 +60,61 @@ static GLUSvoid glusImageConvertRGB(GLUSubyte* rgbe, const GLUSfloat* rgb)
 	rgbe[3] = (GLUSubyte)(maxExponent + 128);
 }
 
-static GLUSint glusImageDecodeNewRLE(FILE* file, GLUSubyte* scanline, GLUSint width)
+static GLUSboolean glusImageDecodeNewRLE(GLUSubyte* scanline, GLUSint width, const GLUSubyte* fileData, size_t fileLength, size_t* position)
 {
-	GLUSint channel, x, scanLength, maxScanLength;
-	GLUSubyte code, channelValue;
-	size_t elementsRead;
+	GLUSint channel, x;
+	GLUSubyte code;
 
-	maxScanLength = 0;
+	GLUSubyte* component;
 
-	// read each component
+	// Each component is decoded into its own plane of the scanline, so runs and literals are copied as a whole.
 	for (channel = 0; channel < 4; channel++)
 	{
-		x = 0;
+		component = &scanline[channel * width];
 
-		scanLength = 0;
+		x = 0;
 
 		while (x < width)
 		{
-			elementsRead = fread(&code, 1, 1, file);
-
-			if (!_glusFileCheckRead(file, elementsRead, 1))
+			if (*position >= fileLength)
 			{
-				return -1;
+				return GLUS_FALSE;
 			}
 
+			code = fileData[(*position)++];
+
 			if (code > 128)
 			{
 				// Run
 
 				code &= 127;
 
-				scanLength += code;
-
-				if (scanLength > width)
+				if (code > width - x || *position >= fileLength)
 				{
-					glusFileClose(file);
-
-					return -1;
-				}
-
-				elementsRead = fread(&channelValue, 1, 1, file);
-
-				if (!_glusFileCheckRead(file, elementsRead, 1))
-				{
-					return -1;
+					return GLUS_FALSE;
 				}
 
-				while (code--)
-				{
-					scanline[x++ * 4 + channel] = channelValue;
-				}
+				memset(&component[x], fileData[(*position)++], code);
 			}
 			else
 			{
 				// Non-run
 
-				scanLength += code;
-
-				if (scanLength > width)
+				if (code > width - x || fileLength - *position < code)
 				{
-					glusFileClose(file);
-
-					return -1;
+					return GLUS_FALSE;
 				}
 
-				while (code--)
-				{
-					elementsRead = fread(&channelValue, 1, 1, file);
-
-					if (!_glusFileCheckRead(file, elementsRead, 1))
-					{
-						return -1;
-					}
+				memcpy(&component[x], &fileData[*position], code);
 
-					scanline[x++ * 4 + channel] = channelValue;
-				}
+				*position += code;
 			}
-		}
 
-		if (scanLength > maxScanLength)
-		{
-			maxScanLength = scanLength;
+			x += code;
 		}
 	}
 
-	return maxScanLength;
+	return GLUS_TRUE;
 }
 
 GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage* hdrimage, GLUSint width, GLUSint height, GLUSint depth, GLUSenum format)
@@ -190,12 +164,9 @@ GLUSboolean GLUSAPIENTRY glusImageCreateHdr(GLUShdrimage* hdrimage, GLUSint widt
 // see http://radiance-online.org/cgi-bin/viewcvs.cgi/ray/src/common/color.c?view=markup
 // see http://www.flipcode.com/archives/HDR_Image_Reader.shtml
 
-GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage* hdrimage)
+static GLUSboolean glusImageDecodeHdr(GLUShdrimage* hdrimage, const GLUSubyte* fileData, size_t fileLength)
 {
-	FILE* file;
-
 	GLUSchar buffer[256];
-	GLUSchar currentChar, oldChar;
 
 	GLUSint width, height, x, y, repeat, factor, i;
 
@@ -205,99 +176,51 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
 
 	GLUSfloat rgb[3];
 
-	size_t elementsRead;
-
-	// check, if we have a valid pointer
-	if (!filename || !hdrimage)
-	{
-		return GLUS_FALSE;
-	}
-
-	hdrimage->width = 0;
-	hdrimage->height = 0;
-	hdrimage->depth = 0;
-	hdrimage->data = 0;
-
-	// open filename in "read binary" mode
-	file = glusFileOpen(filename, "rb");
+	GLUSfloat* pixel;
 
-	if (!file)
-	{
-		return GLUS_FALSE;
-	}
-
-	elementsRead = fread(buffer, 10, 1, file);
-
-	if (!_glusFileCheckRead(file, elementsRead, 1))
-	{
-		return GLUS_FALSE;
-	}
+	size_t position;
 
 	//
 	// Information header
 	//
 
 	// Identifier
-	if (strncmp(buffer, "#?RADIANCE", 10))
+	if (fileLength < 11 || strncmp((const GLUSchar*)fileData, "#?RADIANCE", 10))
 	{
-		glusFileClose(file);
-
 		return GLUS_FALSE;
 	}
 
-	// Go to variables
-	if (fseek(file, 1, SEEK_CUR))
-	{
-		glusFileClose(file);
-
-		return GLUS_FALSE;
-	}
+	// Variables. Empty line indicates end of header.
+	position = 12;
 
-	// Variables
-	currentChar = 0;
-	while (GLUS_TRUE)
+	while (position < fileLength && !(fileData[position - 1] == '\n' && fileData[position] == '\n'))
 	{
-		oldChar = currentChar;
-
-		elementsRead = fread(&currentChar, 1, 1, file);
-
-		if (!_glusFileCheckRead(file, elementsRead, 1))
-		{
-			return GLUS_FALSE;
-		}
-
-		// Empty line indicates end of header
-		if (currentChar == '\n' && oldChar == '\n')
-		{
-			break;
-		}
+		position++;
 	}
 
+	position++;
+
 	// Resolution
 	i = 0;
 	while (GLUS_TRUE)
 	{
-		elementsRead = fread(&currentChar, 1, 1, file);
-
-		if (!_glusFileCheckRead(file, elementsRead, 1))
+		if (position >= fileLength || i >= (GLUSint)sizeof(buffer) - 1)
 		{
 			return GLUS_FALSE;
 		}
 
-		buffer[i++] = currentChar;
+		buffer[i++] = (GLUSchar)fileData[position++];
 
-		if (currentChar == '\n')
+		if (buffer[i - 1] == '\n')
 		{
 			break;
 		}
 	}
 
-	if (!sscanf(buffer, "-Y %d +X %d", &height, &width))
-	{
-		glusFileClose(file);
-
-		glusImageDestroyHdr(hdrimage);
+	buffer[i] = 0;
 
+	if (sscanf(buffer, "-Y %d +X %d", &height, &width) != 2 || width <= 0 || height <= 0 || width > 65535 || height > 65535)
+	{
 		return GLUS_FALSE;
 	}
 
@@ -306,28 +229,18 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
 	hdrimage->depth = 1;
 	hdrimage->format = GLUS_RGB;
 
-	hdrimage->data = (GLUSfloat*)glusMemoryMalloc(width * height * 3 * sizeof(GLUSfloat));
+	hdrimage->data = (GLUSfloat*)glusMemoryMalloc((size_t)width * height * 3 * sizeof(GLUSfloat));
 
 	if (!hdrimage->data)
 	{
-		glusFileClose(file);
-
-		glusImageDestroyHdr(hdrimage);
-
 		return GLUS_FALSE;
 	}
 
 	// Scanlines
-	scanline = (GLUSubyte*)glusMemoryMalloc(width * 4 * sizeof(GLUSubyte));
+	scanline = (GLUSubyte*)glusMemoryMalloc((size_t)width * 4 * sizeof(GLUSubyte));
 
 	if (!scanline)
 	{
-		glusMemoryFree(scanline);
-
-		glusFileClose(file);
-
-		glusImageDestroyHdr(hdrimage);
-
 		return GLUS_FALSE;
 	}
 
@@ -341,55 +254,49 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
 	y = height - 1;
 	while (y >= 0)
 	{
-		elementsRead = fread(buffer, 4, 1, file);
-
-		if (!_glusFileCheckRead(file, elementsRead, 1))
+		if (fileLength - position < 4)
 		{
 			glusMemoryFree(scanline);
 
-			glusImageDestroyHdr(hdrimage);
-
 			return GLUS_FALSE;
 		}
 
+		rgbe[0] = fileData[position + 0];
+		rgbe[1] = fileData[position + 1];
+		rgbe[2] = fileData[position + 2];
+		rgbe[3] = fileData[position + 3];
+
+		position += 4;
+
 		repeat = 0;
 
 		// Examine value
-		if (width < 32768 && buffer[0] == 2 && buffer[1] == 2 && buffer[2] == ((width >> 8) & 0xFF) && buffer[3] == (width & 0xFF))
+		if (width < 32768 && rgbe[0] == 2 && rgbe[1] == 2 && rgbe[2] == ((width >> 8) & 0xFF) && rgbe[3] == (width & 0xFF))
 		{
 			// New RLE decoding
 
-			GLUSint scanlinePixels = glusImageDecodeNewRLE(file, scanline, width);
-
-			if (scanlinePixels < 0)
+			if (!glusImageDecodeNewRLE(scanline, width, fileData, fileLength, &position))
 			{
 				glusMemoryFree(scanline);
 
-				// File already closed
-
-				glusImageDestroyHdr(hdrimage);
-
 				return GLUS_FALSE;
 			}
 
-			for (i = 0; i < scanlinePixels; i++)
+			for (i = 0; i < width; i++)
 			{
 				if (y < 0)
 				{
 					glusMemoryFree(scanline);
 
-					glusFileClose(file);
-
-					glusImageDestroyHdr(hdrimage);
-
 					return GLUS_FALSE;
 				}
 
-				glusImageConvertRGBE(rgb, &scanline[i * 4]);
+				rgbe[0] = scanline[i];
+				rgbe[1] = scanline[width + i];
+				rgbe[2] = scanline[2 * width + i];
+				rgbe[3] = scanline[3 * width + i];
 
-				hdrimage->data[(width * y + x) * 3 + 0] = rgb[0];
-				hdrimage->data[(width * y + x) * 3 + 1] = rgb[1];
-				hdrimage->data[(width * y + x) * 3 + 2] = rgb[2];
+				glusImageConvertRGBE(&hdrimage->data[(width * y + x) * 3], rgbe);
 
 				x++;
 				if (x >= width)
@@ -401,18 +308,18 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
 
 			factor = 1;
 
-			prevRgbe[0] = scanline[(scanlinePixels - 1) * 4 + 0];
-			prevRgbe[1] = scanline[(scanlinePixels - 1) * 4 + 1];
-			prevRgbe[2] = scanline[(scanlinePixels - 1) * 4 + 2];
-			prevRgbe[3] = scanline[(scanlinePixels - 1) * 4 + 3];
+			prevRgbe[0] = rgbe[0];
+			prevRgbe[1] = rgbe[1];
+			prevRgbe[2] = rgbe[2];
+			prevRgbe[3] = rgbe[3];
 
 			continue;
 		}
-		else if (buffer[0] == 1 && buffer[1] == 1 && buffer[2] == 1)
+		else if (rgbe[0] == 1 && rgbe[1] == 1 && rgbe[2] == 1)
 		{
 			// Old RLE decoding
 
-			repeat = buffer[3] * factor;
+			repeat = rgbe[3] * factor;
 
 			rgbe[0] = prevRgbe[0];
 			rgbe[1] = prevRgbe[1];
@@ -427,11 +334,6 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
 
 			repeat = 1;
 
-			rgbe[0] = buffer[0];
-			rgbe[1] = buffer[1];
-			rgbe[2] = buffer[2];
-			rgbe[3] = buffer[3];
-
 			factor = 1;
 		}
 
@@ -443,16 +345,14 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
 			{
 				glusMemoryFree(scanline);
 
-				glusFileClose(file);
-
-				glusImageDestroyHdr(hdrimage);
-
 				return GLUS_FALSE;
 			}
 
-			hdrimage->data[(width * y + x) * 3 + 0] = rgb[0];
-			hdrimage->data[(width * y + x) * 3 + 1] = rgb[1];
-			hdrimage->data[(width * y + x) * 3 + 2] = rgb[2];
+			pixel = &hdrimage->data[(width * y + x) * 3];
+
+			pixel[0] = rgb[0];
+			pixel[1] = rgb[1];
+			pixel[2] = rgb[2];
 
 			x++;
 			if (x >= width)
@@ -472,11 +372,51 @@ GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage
 
 	glusMemoryFree(scanline);
 
-	glusFileClose(file);
-
 	return GLUS_TRUE;
 }
 
+GLUSboolean GLUSAPIENTRY glusImageLoadHdr(const GLUSchar* filename, GLUShdrimage* hdrimage)
+{
+	GLUSubyte* fileData;
+	size_t fileLength;
+
+	GLUSboolean result;
+
+	// check, if we have a valid pointer
+	if (!filename || !hdrimage)
+	{
+		return GLUS_FALSE;
+	}
+
+	GLUS_PROFILE_BEGIN("glusImageLoadHdr");
+
+	hdrimage->width = 0;
+	hdrimage->height = 0;
+	hdrimage->depth = 0;
+	hdrimage->data = 0;
+
+	// The whole file is decoded from memory, so runs are expanded without any further reads.
+	if (!_glusFileMap(filename, &fileData, &fileLength))
+	{
+		GLUS_PROFILE_END();
+
+		return GLUS_FALSE;
+	}
+
+	result = glusImageDecodeHdr(hdrimage, fileData, fileLength);
+
+	_glusFileUnmap(fileData, fileLength);
+
+	if (!result)
+	{
+		glusImageDestroyHdr(hdrimage);
+	}
+
+	GLUS_PROFILE_END();
+
+	return result;
+}
+
 GLUSboolean GLUSAPIENTRY glusImageSaveHdr(const GLUSchar* filename, const GLUShdrimage* hdrimage)
 {
 	FILE* file;
@@ -17,7 +17,7 @@
 
 #include "GL/glus.h"
 
-GLUSboolean GLUSAPIENTRY glusImageLoadPkm(const GLUSchar* filename, GLUSpkmimage* pkmimage)
+static GLUSboolean glusImageLoadPkmData(const GLUSchar* filename, GLUSpkmimage* pkmimage)
 {
 	GLUSbinaryfile binaryfile;
 
@@ -116,6 +116,19 @@ GLUSboolean GLUSAPIENTRY glusImageLoadPkm(const GLUSchar* filename, GLUSpkmimage
 	return GLUS_TRUE;
 }
 
+GLUSboolean GLUSAPIENTRY glusImageLoadPkm(const GLUSchar* filename, GLUSpkmimage* pkmimage)
+{
+	GLUSboolean result;
+
+	GLUS_PROFILE_BEGIN("glusImageLoadPkm");
+
+	result = glusImageLoadPkmData(filename, pkmimage);
+
+	GLUS_PROFILE_END();
+
+	return result;
+}
+
 GLUSvoid GLUSAPIENTRY glusImageDestroyPkm(GLUSpkmimage* pkmimage)
 {
 	if (!pkmimage)
@@ -21,7 +21,9 @@
 
 extern GLUSvoid _glusImageGatherSamplePoints(GLUSint sampleIndex[4], GLUSfloat sampleWeight[2], const GLUSfloat st[2], GLUSint width, GLUSint height, GLUSint stride);
 
-extern GLUSboolean _glusFileCheckRead(FILE* f, size_t actualRead, size_t expectedRead);
+extern GLUSboolean _glusFileMap(const GLUSchar* filename, GLUSubyte** data, size_t* length);
+extern GLUSvoid _glusFileUnmap(GLUSubyte* data, size_t length);
+
 extern GLUSboolean _glusFileCheckWrite(FILE* f, size_t actualWrite, size_t expectedWrite);
 
 static GLUSvoid glusImageSwapColorChannel(GLUSint width, GLUSint height, GLUSenum format, GLUSubyte* data)
@@ -88,352 +90,193 @@ GLUSboolean GLUSAPIENTRY glusImageCreateTga(GLUStgaimage* tgaimage, GLUSint widt
 	return GLUS_TRUE;
 }
 
-GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage* tgaimage)
+static GLUSboolean glusImageDecodeTga(GLUStgaimage* tgaimage, const GLUSubyte* fileData, size_t fileLength)
 {
-	FILE* file;
-
 	GLUSboolean hasColorMap = GLUS_FALSE;
 
 	GLUSubyte imageType;
 	GLUSubyte bitsPerPixel;
+	GLUSint bytesPerPixel;
 
-	GLUSushort firstEntryIndex;
-	GLUSushort colorMapLength;
-	GLUSubyte colorMapEntrySize;
-	GLUSubyte* colorMap = 0;
+	GLUSushort firstEntryIndex = 0;
+	GLUSushort colorMapLength = 0;
+	GLUSubyte colorMapEntrySize = 0;
+	const GLUSubyte* colorMap = 0;
 
-	GLUSuint i, k;
+	size_t position, numberPixels, pixelsRead, length, copied;
 
-	size_t elementsRead;
+	GLUSuint i;
 
-	// check, if we have a valid pointer
-	if (!filename || !tgaimage)
-	{
-		return GLUS_FALSE;
-	}
-
-	tgaimage->width = 0;
-	tgaimage->height = 0;
-	tgaimage->depth = 0;
-	tgaimage->data = 0;
-	tgaimage->format = 0;
-
-	// open filename in "read binary" mode
-	file = glusFileOpen(filename, "rb");
-
-	if (!file)
-	{
-		return GLUS_FALSE;
-	}
-
-	// seek through the tga header, up to the type:
-	if (fseek(file, 2, SEEK_CUR))
-	{
-		glusFileClose(file);
-
-		return GLUS_FALSE;
-	}
-
-	// read the image type
-	elementsRead = fread(&imageType, 1, 1, file);
-
-	if (!_glusFileCheckRead(file, elementsRead, 1))
+	// The header has a fixed size of 18 bytes.
+	if (fileLength < 18)
 	{
 		return GLUS_FALSE;
 	}
 
 	// check the type
+	imageType = fileData[2];
+
 	if (imageType != 1 && imageType != 2 && imageType != 3 && imageType != 9 && imageType != 10 && imageType != 11)
 	{
-		glusFileClose(file);
-
 		return GLUS_FALSE;
 	}
 
 	if (imageType == 1 || imageType == 9)
 	{
 		hasColorMap = GLUS_TRUE;
-	}
-
-	if (!hasColorMap)
-	{
-		// seek through the tga header, up to the width/height:
-		if (fseek(file, 9, SEEK_CUR))
-		{
-			glusFileClose(file);
-
-			return GLUS_FALSE;
-		}
-	}
-	else
-	{
-		elementsRead = fread(&firstEntryIndex, 2, 1, file);
-
-		if (!_glusFileCheckRead(file, elementsRead, 1))
-		{
-			glusImageDestroyTga(tgaimage);
 
-			return GLUS_FALSE;
-		}
-
-		elementsRead = fread(&colorMapLength, 2, 1, file);
-
-		if (!_glusFileCheckRead(file, elementsRead, 1))
-		{
-			glusImageDestroyTga(tgaimage);
-
-			return GLUS_FALSE;
-		}
-
-		elementsRead = fread(&colorMapEntrySize, 1, 1, file);
-
-		if (!_glusFileCheckRead(file, elementsRead, 1))
-		{
-			glusImageDestroyTga(tgaimage);
-
-			return GLUS_FALSE;
-		}
-
-		// seek through the tga header, up to the width/height:
-		if (fseek(file, 4, SEEK_CUR))
-		{
-			glusFileClose(file);
-
-			return GLUS_FALSE;
-		}
-	}
-
-	// read the width
-	elementsRead = fread(&tgaimage->width, 2, 1, file);
-
-	if (!_glusFileCheckRead(file, elementsRead, 1))
-	{
-		glusImageDestroyTga(tgaimage);
-
-		return GLUS_FALSE;
+		firstEntryIndex = (GLUSushort)(fileData[3] | (fileData[4] << 8));
+		colorMapLength = (GLUSushort)(fileData[5] | (fileData[6] << 8));
+		colorMapEntrySize = fileData[7];
 	}
 
-	if (tgaimage->width > GLUS_MAX_DIMENSION)
-	{
-		glusImageDestroyTga(tgaimage);
-
-		return GLUS_FALSE;
-	}
+	tgaimage->width = (GLUSushort)(fileData[12] | (fileData[13] << 8));
+	tgaimage->height = (GLUSushort)(fileData[14] | (fileData[15] << 8));
 
-	// read the height
-	elementsRead = fread(&tgaimage->height, 2, 1, file);
-
-	if (!_glusFileCheckRead(file, elementsRead, 1))
+	if (tgaimage->width > GLUS_MAX_DIMENSION || tgaimage->height > GLUS_MAX_DIMENSION)
 	{
-		glusImageDestroyTga(tgaimage);
-
-		return GLUS_FALSE;
-	}
-
-	if (tgaimage->height > GLUS_MAX_DIMENSION)
-	{
-		glusImageDestroyTga(tgaimage);
-
 		return GLUS_FALSE;
 	}
 
 	tgaimage->depth = 1;
 
-	// read the bits per pixel
-	elementsRead = fread(&bitsPerPixel, 1, 1, file);
+	// check the pixel depth
+	bitsPerPixel = fileData[16];
 
-	if (!_glusFileCheckRead(file, elementsRead, 1))
+	if (bitsPerPixel != 8 && bitsPerPixel != 24 && bitsPerPixel != 32)
 	{
-		glusImageDestroyTga(tgaimage);
-
 		return GLUS_FALSE;
 	}
 
-	// check the pixel depth
-	if (bitsPerPixel != 8 && bitsPerPixel != 24 && bitsPerPixel != 32)
+	tgaimage->format = GLUS_SINGLE_CHANNEL;
+	if (bitsPerPixel == 24)
 	{
-		glusFileClose(file);
-
-		glusImageDestroyTga(tgaimage);
-
-		return GLUS_FALSE;
+		tgaimage->format = GLUS_RGB;
 	}
-	else
+	else if (bitsPerPixel == 32)
 	{
-		tgaimage->format = GLUS_SINGLE_CHANNEL;
-		if (bitsPerPixel == 24)
-		{
-			tgaimage->format = GLUS_RGB;
-		}
-		else if (bitsPerPixel == 32)
-		{
-			tgaimage->format = GLUS_RGBA;
-		}
+		tgaimage->format = GLUS_RGBA;
 	}
 
-	// move file pointer to beginning of targa data
-	if (fseek(file, 1, SEEK_CUR))
-	{
-		glusFileClose(file);
-
-		glusImageDestroyTga(tgaimage);
+	bytesPerPixel = bitsPerPixel / 8;
 
-		return GLUS_FALSE;
-	}
+	// beginning of the color map or the targa data
+	position = 18;
 
 	if (hasColorMap)
 	{
-		// Create color map space.
-
-		GLUSint bytesPerPixel = colorMapEntrySize / 8;
-
-		colorMap = (GLUSubyte*)glusMemoryMalloc((size_t)colorMapLength * bytesPerPixel * sizeof(GLUSubyte));
-
-		if (!colorMap)
+		if (colorMapEntrySize != 8 && colorMapEntrySize != 24 && colorMapEntrySize != 32)
 		{
-			glusFileClose(file);
-
-			glusImageDestroyTga(tgaimage);
-
 			return GLUS_FALSE;
 		}
 
-		// Read in the color map.
-
-		elementsRead = fread(colorMap, 1, (size_t)colorMapLength * bytesPerPixel * sizeof(GLUSubyte), file);
+		length = (size_t)colorMapLength * (colorMapEntrySize / 8);
 
-		if (!_glusFileCheckRead(file, elementsRead, (size_t)colorMapLength * bytesPerPixel * sizeof(GLUSubyte)))
+		if (fileLength - position < length)
 		{
-			glusImageDestroyTga(tgaimage);
-
-			glusMemoryFree(colorMap);
-			colorMap = 0;
-
 			return GLUS_FALSE;
 		}
 
-		// swap the color if necessary
-		if (colorMapEntrySize == 24 || colorMapEntrySize == 32)
-		{
-			glusImageSwapColorChannel(colorMapLength, 1, colorMapEntrySize == 24 ? GLUS_RGB : GLUS_RGBA, colorMap);
-		}
+		// The color map is used directly from the file.
+		colorMap = &fileData[position];
+
+		position += length;
 	}
 
-	// allocate enough memory for the targa  data
-	tgaimage->data = (GLUSubyte*)glusMemoryMalloc((size_t)tgaimage->width * tgaimage->height * bitsPerPixel / 8);
+	numberPixels = (size_t)tgaimage->width * tgaimage->height;
+
+	// allocate enough memory for the targa data
+	tgaimage->data = (GLUSubyte*)glusMemoryMalloc(numberPixels * bytesPerPixel);
 
 	// verify memory allocation
 	if (!tgaimage->data)
 	{
-		glusFileClose(file);
-
-		glusImageDestroyTga(tgaimage);
-
-		if (hasColorMap)
-		{
-			glusMemoryFree(colorMap);
-			colorMap = 0;
-		}
-
 		return GLUS_FALSE;
 	}
 
 	if (imageType == 1 || imageType == 2 || imageType == 3)
 	{
-		// read in the raw data
-		elementsRead = fread(tgaimage->data, 1, (size_t)tgaimage->width * tgaimage->height * bitsPerPixel / 8, file);
+		// copy the raw data
+		length = numberPixels * bytesPerPixel;
 
-		if (!_glusFileCheckRead(file, elementsRead, (size_t)tgaimage->width * tgaimage->height * bitsPerPixel / 8))
+		if (fileLength - position < length)
 		{
-			glusImageDestroyTga(tgaimage);
-
-			if (hasColorMap)
-			{
-				glusMemoryFree(colorMap);
-				colorMap = 0;
-			}
-
 			return GLUS_FALSE;
 		}
+
+		memcpy(tgaimage->data, &fileData[position], length);
 	}
 	else
 	{
 		// RLE encoded
-		GLUSint pixelsRead = 0;
+		pixelsRead = 0;
 
-		while (pixelsRead < tgaimage->width * tgaimage->height)
+		while (pixelsRead < numberPixels)
 		{
-			GLUSubyte amount;
+			GLUSubyte* target = &tgaimage->data[pixelsRead * bytesPerPixel];
 
-			elementsRead = fread(&amount, 1, 1, file);
+			size_t amount;
 
-			if (!_glusFileCheckRead(file, elementsRead, 1))
+			if (position >= fileLength)
 			{
-				glusImageDestroyTga(tgaimage);
+				return GLUS_FALSE;
+			}
 
-				if (hasColorMap)
-				{
-					glusMemoryFree(colorMap);
-					colorMap = 0;
-				}
+			amount = (fileData[position] & 0x7F) + 1;
 
+			// Packets must not run over the end of the image.
+			if (amount > numberPixels - pixelsRead)
+			{
 				return GLUS_FALSE;
 			}
 
-			if (amount & 0x80)
+			length = amount * bytesPerPixel;
+
+			if (fileData[position++] & 0x80)
 			{
-				GLUSint i;
-				GLUSint k;
+				// Run
 
-				amount &= 0x7F;
+				if (fileLength - position < (size_t)bytesPerPixel)
+				{
+					return GLUS_FALSE;
+				}
 
-				amount++;
+				if (bytesPerPixel == 1)
+				{
+					memset(target, fileData[position], amount);
+				}
+				else
+				{
+					// Copy the pixel once, then double the already copied part.
 
-				// read in the rle data
-				elementsRead = fread(&tgaimage->data[pixelsRead * bitsPerPixel / 8], 1, bitsPerPixel / 8, file);
+					memcpy(target, &fileData[position], bytesPerPixel);
 
-				if (!_glusFileCheckRead(file, elementsRead, bitsPerPixel / 8))
-				{
-					glusImageDestroyTga(tgaimage);
+					copied = bytesPerPixel;
 
-					if (hasColorMap)
+					while (copied < length)
 					{
-						glusMemoryFree(colorMap);
-						colorMap = 0;
-					}
+						size_t block = copied < length - copied ? copied : length - copied;
 
-					return GLUS_FALSE;
-				}
+						memcpy(&target[copied], target, block);
 
-				for (i = 1; i < amount; i++)
-				{
-					for (k = 0; k < bitsPerPixel / 8; k++)
-					{
-						tgaimage->data[(pixelsRead + i) * bitsPerPixel / 8 + k] = tgaimage->data[pixelsRead * bitsPerPixel / 8 + k];
+						copied += block;
 					}
 				}
+
+				position += bytesPerPixel;
 			}
 			else
 			{
-				amount &= 0x7F;
-
-				amount++;
+				// Raw
 
-				// read in the raw data
-				elementsRead = fread(&tgaimage->data[pixelsRead * bitsPerPixel / 8], 1, (size_t)amount * bitsPerPixel / 8, file);
-
-				if (!_glusFileCheckRead(file, elementsRead, (size_t)amount * bitsPerPixel / 8))
+				if (fileLength - position < length)
 				{
-					glusImageDestroyTga(tgaimage);
-
-					if (hasColorMap)
-					{
-						glusMemoryFree(colorMap);
-						colorMap = 0;
-					}
-
 					return GLUS_FALSE;
 				}
+
+				memcpy(target, &fileData[position], length);
+
+				position += length;
 			}
 
 			pixelsRead += amount;
@@ -446,30 +289,22 @@ GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage
 		glusImageSwapColorChannel(tgaimage->width, tgaimage->height, tgaimage->format, tgaimage->data);
 	}
 
-	// close the file
-	glusFileClose(file);
-
 	if (hasColorMap)
 	{
 		GLUSubyte* data = tgaimage->data;
 
-		GLUSint bytesPerPixel;
+		GLUSubyte* target;
+		const GLUSubyte* entry;
 
-		// Allocating new memory, as current memory is a look up table index and not a color.
+		GLUSint entrySize = colorMapEntrySize / 8;
 
-		bytesPerPixel = colorMapEntrySize / 8;
+		// Allocating new memory, as current memory is a look up table index and not a color.
 
-		tgaimage->data = (GLUSubyte*)glusMemoryMalloc((size_t)tgaimage->width * tgaimage->height * bytesPerPixel);
+		tgaimage->data = (GLUSubyte*)glusMemoryMalloc(numberPixels * entrySize);
 
 		if (!tgaimage->data)
 		{
-			glusImageDestroyTga(tgaimage);
-
 			glusMemoryFree(data);
-			data = 0;
-
-			glusMemoryFree(colorMap);
-			colorMap = 0;
 
 			return GLUS_FALSE;
 		}
@@ -484,28 +319,86 @@ GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage
 			tgaimage->format = GLUS_RGBA;
 		}
 
-		// Copy color values from the color map into the image data.
+		// Copy color values from the color map into the image data. The entries are stored as BGR or BGRA.
 
-		for (i = 0; i < (GLUSuint)tgaimage->width * (GLUSuint)tgaimage->height; i++)
+		for (i = 0; i < (GLUSuint)numberPixels; i++)
 		{
-			for (k = 0; k < (GLUSuint)bytesPerPixel; k++)
+			if ((GLUSuint)firstEntryIndex + data[i] >= colorMapLength)
 			{
-				tgaimage->data[i * bytesPerPixel + k] = colorMap[(firstEntryIndex + data[i]) * bytesPerPixel + k];
+				glusMemoryFree(data);
+
+				return GLUS_FALSE;
 			}
-		}
 
-		// Freeing data.
+			entry = &colorMap[(firstEntryIndex + data[i]) * entrySize];
+			target = &tgaimage->data[i * entrySize];
 
-		glusMemoryFree(data);
-		data = 0;
+			if (entrySize == 1)
+			{
+				target[0] = entry[0];
+			}
+			else
+			{
+				target[0] = entry[2];
+				target[1] = entry[1];
+				target[2] = entry[0];
+
+				if (entrySize == 4)
+				{
+					target[3] = entry[3];
+				}
+			}
+		}
 
-		glusMemoryFree(colorMap);
-		colorMap = 0;
+		glusMemoryFree(data);
 	}
 
 	return GLUS_TRUE;
 }
 
+GLUSboolean GLUSAPIENTRY glusImageLoadTga(const GLUSchar* filename, GLUStgaimage* tgaimage)
+{
+	GLUSubyte* fileData;
+	size_t fileLength;
+
+	GLUSboolean result;
+
+	// check, if we have a valid pointer
+	if (!filename || !tgaimage)
+	{
+		return GLUS_FALSE;
+	}
+
+	GLUS_PROFILE_BEGIN("glusImageLoadTga");
+
+	tgaimage->width = 0;
+	tgaimage->height = 0;
+	tgaimage->depth = 0;
+	tgaimage->data = 0;
+	tgaimage->format = 0;
+
+	// The whole file is decoded from memory, so runs are expanded without any further reads.
+	if (!_glusFileMap(filename, &fileData, &fileLength))
+	{
+		GLUS_PROFILE_END();
+
+		return GLUS_FALSE;
+	}
+
+	result = glusImageDecodeTga(tgaimage, fileData, fileLength);
+
+	_glusFileUnmap(fileData, fileLength);
+
+	if (!result)
+	{
+		glusImageDestroyTga(tgaimage);
+	}
+
+	GLUS_PROFILE_END();
+
+	return result;
+}
+
 GLUSboolean GLUSAPIENTRY glusImageSaveTga(const GLUSchar* filename, const GLUStgaimage* tgaimage)
 {
 	FILE* file;
@@ -636,6 +529,165 @@ GLUSboolean GLUSAPIENTRY glusImageSaveTga(const GLUSchar* filename, const GLUStg
 	return GLUS_TRUE;
 }
 
+static GLUSboolean glusImageIsEqualPixel(const GLUSubyte* pixel0, const GLUSubyte* pixel1, GLUSint bytesPerPixel)
+{
+	GLUSint i;
+
+	for (i = 0; i < bytesPerPixel; i++)
+	{
+		if (pixel0[i] != pixel1[i])
+		{
+			return GLUS_FALSE;
+		}
+	}
+
+	return GLUS_TRUE;
+}
+
+static GLUSvoid glusImageCopyPixelSwapped(GLUSubyte* target, const GLUSubyte* source, GLUSint bytesPerPixel)
+{
+	if (bytesPerPixel == 1)
+	{
+		target[0] = source[0];
+
+		return;
+	}
+
+	target[0] = source[2];
+	target[1] = source[1];
+	target[2] = source[0];
+
+	if (bytesPerPixel == 4)
+	{
+		target[3] = source[3];
+	}
+}
+
+GLUSboolean _glusImageSaveTgaRle(const GLUSchar* filename, const GLUStgaimage* tgaimage)
+{
+	FILE* file;
+	GLUSubyte* data;
+	GLUSubyte bitsPerPixel;
+	GLUSint bytesPerPixel;
+	size_t elementsWritten, position, maximumLength;
+	GLUSint x, y, i, amount;
+
+	if (!filename || !tgaimage || !tgaimage->data || tgaimage->width < 1 || tgaimage->height < 1)
+	{
+		return GLUS_FALSE;
+	}
+
+	switch (tgaimage->format)
+	{
+		case GLUS_ALPHA:
+		case GLUS_RED:
+		case GLUS_LUMINANCE:
+			bitsPerPixel = 8;
+		break;
+		case GLUS_RGB:
+			bitsPerPixel = 24;
+		break;
+		case GLUS_RGBA:
+			bitsPerPixel = 32;
+		break;
+		default:
+			return GLUS_FALSE;
+	}
+
+	bytesPerPixel = bitsPerPixel / 8;
+
+	// Worst case is one raw packet header per 128 pixels of a scanline.
+	maximumLength = 18 + (size_t)tgaimage->height * ((size_t)tgaimage->width * bytesPerPixel + (tgaimage->width + 127) / 128);
+
+	data = (GLUSubyte*)glusMemoryMalloc(maximumLength);
+
+	if (!data)
+	{
+		return GLUS_FALSE;
+	}
+
+	// TGA header
+	memset(data, 0, 18);
+
+	data[2] = bitsPerPixel == 8 ? 11 : 10;
+	data[12] = (GLUSubyte)(tgaimage->width & 0xFF);
+	data[13] = (GLUSubyte)(tgaimage->width >> 8);
+	data[14] = (GLUSubyte)(tgaimage->height & 0xFF);
+	data[15] = (GLUSubyte)(tgaimage->height >> 8);
+	data[16] = bitsPerPixel;
+
+	position = 18;
+
+	// Packets do not cross scanlines.
+	for (y = 0; y < tgaimage->height; y++)
+	{
+		const GLUSubyte* row = &tgaimage->data[(size_t)y * tgaimage->width * bytesPerPixel];
+
+		x = 0;
+
+		while (x < tgaimage->width)
+		{
+			amount = 1;
+
+			while (x + amount < tgaimage->width && amount < 128 && glusImageIsEqualPixel(&row[x * bytesPerPixel], &row[(x + amount) * bytesPerPixel], bytesPerPixel))
+			{
+				amount++;
+			}
+
+			if (amount > 1)
+			{
+				// Run
+				data[position++] = (GLUSubyte)(0x80 | (amount - 1));
+
+				glusImageCopyPixelSwapped(&data[position], &row[x * bytesPerPixel], bytesPerPixel);
+
+				position += bytesPerPixel;
+			}
+			else
+			{
+				// Raw, until the next two equal pixels start a run.
+				while (x + amount < tgaimage->width && amount < 128 && !(x + amount + 1 < tgaimage->width && glusImageIsEqualPixel(&row[(x + amount) * bytesPerPixel], &row[(x + amount + 1) * bytesPerPixel], bytesPerPixel)))
+				{
+					amount++;
+				}
+
+				data[position++] = (GLUSubyte)(amount - 1);
+
+				for (i = 0; i < amount; i++)
+				{
+					glusImageCopyPixelSwapped(&data[position], &row[(x + i) * bytesPerPixel], bytesPerPixel);
+
+					position += bytesPerPixel;
+				}
+			}
+
+			x += amount;
+		}
+	}
+
+	file = glusFileOpen(filename, "wb");
+
+	if (!file)
+	{
+		glusMemoryFree(data);
+
+		return GLUS_FALSE;
+	}
+
+	elementsWritten = fwrite(data, 1, position, file);
+
+	glusMemoryFree(data);
+
+	if (!_glusFileCheckWrite(file, elementsWritten, position))
+	{
+		return GLUS_FALSE;
+	}
+
+	glusFileClose(file);
+
+	return GLUS_TRUE;
+}
+
 GLUSvoid GLUSAPIENTRY glusImageDestroyTga(GLUStgaimage* tgaimage)
 {
 	if (!tgaimage)
@@ -100,3 +100,123 @@ GLUSint GLUSAPIENTRY glusIntersectRaySpheref(GLUSfloat* tNear, GLUSfloat* tFar,
 
 	return intersections;
 }
+
+GLUSboolean GLUSAPIENTRY glusIntersectRayTrianglef(GLUSfloat* t, GLUSfloat* u, GLUSfloat* v, const GLUSfloat rayStart[4], const GLUSfloat rayDirection[3], const GLUSfloat point0[4], const GLUSfloat point1[4], const GLUSfloat point2[4])
+{
+	// see Fast, Minimum Storage Ray/Triangle Intersection, Moeller and Trumbore
+
+	GLUSfloat edge1[3], edge2[3], p[3], s[3], q[3];
+	GLUSfloat determinant, inverseDeterminant, currentT, currentU, currentV;
+
+	glusPoint4SubtractPoint4f(edge1, point1, point0);
+	glusPoint4SubtractPoint4f(edge2, point2, point0);
+
+	glusVector3Crossf(p, rayDirection, edge2);
+
+	determinant = glusVector3Dotf(edge1, p);
+
+	// Ray is parallel to the triangle plane.
+	if (determinant == 0.0f)
+	{
+		return GLUS_FALSE;
+	}
+
+	inverseDeterminant = 1.0f / determinant;
+
+	glusPoint4SubtractPoint4f(s, rayStart, point0);
+
+	currentU = glusVector3Dotf(s, p) * inverseDeterminant;
+
+	// Comparisons are written to also reject NaN from almost degenerated triangles.
+	if (!(currentU >= 0.0f && currentU <= 1.0f))
+	{
+		return GLUS_FALSE;
+	}
+
+	glusVector3Crossf(q, s, edge1);
+
+	currentV = glusVector3Dotf(rayDirection, q) * inverseDeterminant;
+
+	if (!(currentV >= 0.0f && currentU + currentV <= 1.0f))
+	{
+		return GLUS_FALSE;
+	}
+
+	currentT = glusVector3Dotf(edge2, q) * inverseDeterminant;
+
+	// Triangle is behind the ray.
+	if (!(currentT >= 0.0f))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (t)
+	{
+		*t = currentT;
+	}
+	if (u)
+	{
+		*u = currentU;
+	}
+	if (v)
+	{
+		*v = currentV;
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusIntersectRayAxisAlignedBoxf(GLUSfloat* tNear, GLUSfloat* tFar, const GLUSfloat rayStart[4], const GLUSfloat rayDirection[3], const GLUSfloat center[4], const GLUSfloat halfExtend[3])
+{
+	// see Real-Time Collision Detection p180
+
+	GLUSint i;
+	GLUSfloat tMin = 0.0f;
+	GLUSfloat tMax = INFINITY;
+	GLUSfloat inverseDirection, t0, t1, temp;
+
+	for (i = 0; i < 3; i++)
+	{
+		if (rayDirection[i] == 0.0f)
+		{
+			// Ray is parallel to the slab, so it has to start inside.
+			if (rayStart[i] < center[i] - halfExtend[i] || rayStart[i] > center[i] + halfExtend[i])
+			{
+				return GLUS_FALSE;
+			}
+		}
+		else
+		{
+			inverseDirection = 1.0f / rayDirection[i];
+
+			t0 = (center[i] - halfExtend[i] - rayStart[i]) * inverseDirection;
+			t1 = (center[i] + halfExtend[i] - rayStart[i]) * inverseDirection;
+
+			if (t0 > t1)
+			{
+				temp = t0;
+				t0 = t1;
+				t1 = temp;
+			}
+
+			tMin = glusMathMaxf(tMin, t0);
+			tMax = glusMathMinf(tMax, t1);
+
+			if (tMin > tMax)
+			{
+				return GLUS_FALSE;
+			}
+		}
+	}
+
+	if (tNear)
+	{
+		*tNear = tMin;
+	}
+	if (tFar)
+	{
+		*tFar = tMax;
+	}
+
+	return GLUS_TRUE;
+}
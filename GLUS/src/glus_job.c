@@ -0,0 +1,1049 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "GL/glus.h"
+
+// Initial number of jobs per queue. Queues grow, if needed.
+#define GLUS_JOB_QUEUE_SIZE 64
+
+// Ranges per thread, if no grain size is given. More ranges balance better, if ranges take different times.
+#define GLUS_JOB_RANGES_PER_THREAD 4
+
+#if defined(_MSC_VER)
+#define GLUS_JOB_THREAD_LOCAL __declspec(thread)
+#else
+#define GLUS_JOB_THREAD_LOCAL __thread
+#endif
+
+/**
+ * Internal data of a job. Function, data and main thread flag are not changed after creation,
+ * all other members are protected by the global mutex.
+ */
+typedef struct _GLUSjobdata
+{
+	GLUSjobfunc function;
+
+	GLUSvoid* data;
+
+	GLUSboolean mainThread;
+
+	GLUSboolean submitted;
+
+	GLUSboolean finished;
+
+	// Unfinished dependencies. One more, as long as the job is not submitted.
+	GLUSint openDependencies;
+
+	// The handle, the submission until the job is finished and every job, which has this job as dependent.
+	GLUSint references;
+
+	struct _GLUSjobdata** dependents;
+
+	GLUSint numberDependents;
+
+	GLUSint maxDependents;
+
+} GLUSjobdata;
+
+/**
+ * Queue of ready jobs. The owner takes from the back, other threads steal from the front.
+ */
+typedef struct _GLUSjobqueue
+{
+	GLUSmutex mutex;
+
+	GLUSjobdata** jobs;
+
+	GLUSint maxJobs;
+
+	GLUSint front;
+
+	GLUSint numberJobs;
+
+} GLUSjobqueue;
+
+typedef struct _GLUSjobtiles
+{
+	volatile GLUSint nextTile;
+
+	volatile GLUSint nextWorker;
+
+	GLUSint numberTiles;
+
+	GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile);
+
+	GLUSvoid* data;
+
+} GLUSjobtiles;
+
+typedef struct _GLUSjobrange
+{
+	GLUSint count;
+
+	GLUSint grainSize;
+
+	GLUSjobrangefunc function;
+
+	GLUSvoid* data;
+
+} GLUSjobrange;
+
+extern GLUSboolean _glusThreadRunTiles(const GLUSint numberTiles, const GLUSint numberThreads, GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile), GLUSvoid* data);
+
+extern GLUSint _glusThreadSetTileWorker(const GLUSint index);
+
+static GLUSboolean g_running = GLUS_FALSE;
+
+static GLUSint g_numberWorkers = 0;
+
+static GLUSthread* g_workers = 0;
+
+// First queue is used by all threads, which are not workers. Then one queue per worker follows.
+static GLUSjobqueue* g_queues = 0;
+
+static GLUSint g_numberQueues = 0;
+
+static GLUSjobqueue g_mainQueue;
+
+// Jobs in the queues and in the main queue. Only a hint for sleeping threads, the queues are authoritative.
+static volatile GLUSint g_queuedJobs = 0;
+static volatile GLUSint g_queuedMainJobs = 0;
+
+static GLUSmutex g_mutex;
+static GLUScondition g_condition;
+
+// All following variables are protected by the mutex.
+
+static GLUSint g_unfinishedJobs = 0;
+static GLUSint g_sleepingThreads = 0;
+static GLUSboolean g_quit = GLUS_FALSE;
+
+static GLUS_JOB_THREAD_LOCAL GLUSint g_queueIndex = 0;
+static GLUS_JOB_THREAD_LOCAL GLUSboolean g_mainThread = GLUS_FALSE;
+
+static GLUSint glusJobLoad(volatile GLUSint* value)
+{
+#ifdef _WIN32
+	GLUSint result = *value;
+
+	_ReadWriteBarrier();
+
+	return result;
+#else
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static GLUSint glusJobAdd(volatile GLUSint* value, const GLUSint add)
+{
+#ifdef _WIN32
+	return InterlockedExchangeAdd((volatile LONG*)value, add) + add;
+#else
+	return __atomic_add_fetch(value, add, __ATOMIC_ACQ_REL);
+#endif
+}
+
+static GLUSboolean glusJobQueueCreate(GLUSjobqueue* queue)
+{
+	queue->jobs = (GLUSjobdata**)glusMemoryMalloc(GLUS_JOB_QUEUE_SIZE * sizeof(GLUSjobdata*));
+
+	if (!queue->jobs)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!glusMutexCreate(&queue->mutex))
+	{
+		glusMemoryFree(queue->jobs);
+
+		return GLUS_FALSE;
+	}
+
+	queue->maxJobs = GLUS_JOB_QUEUE_SIZE;
+	queue->front = 0;
+	queue->numberJobs = 0;
+
+	return GLUS_TRUE;
+}
+
+static GLUSvoid glusJobQueueDestroy(GLUSjobqueue* queue)
+{
+	glusMutexDestroy(&queue->mutex);
+
+	glusMemoryFree(queue->jobs);
+}
+
+static GLUSboolean glusJobQueuePush(GLUSjobqueue* queue, GLUSjobdata* job)
+{
+	GLUSjobdata** jobs;
+
+	GLUSint i;
+
+	glusMutexLock(&queue->mutex);
+
+	if (queue->numberJobs == queue->maxJobs)
+	{
+		jobs = (GLUSjobdata**)glusMemoryMalloc(2 * queue->maxJobs * sizeof(GLUSjobdata*));
+
+		if (!jobs)
+		{
+			glusMutexUnlock(&queue->mutex);
+
+			return GLUS_FALSE;
+		}
+
+		for (i = 0; i < queue->numberJobs; i++)
+		{
+			jobs[i] = queue->jobs[(queue->front + i) % queue->maxJobs];
+		}
+
+		glusMemoryFree(queue->jobs);
+
+		queue->jobs = jobs;
+		queue->maxJobs *= 2;
+		queue->front = 0;
+	}
+
+	queue->jobs[(queue->front + queue->numberJobs) % queue->maxJobs] = job;
+
+	queue->numberJobs++;
+
+	glusMutexUnlock(&queue->mutex);
+
+	return GLUS_TRUE;
+}
+
+static GLUSjobdata* glusJobQueuePop(GLUSjobqueue* queue, const GLUSboolean front)
+{
+	GLUSjobdata* job = 0;
+
+	glusMutexLock(&queue->mutex);
+
+	if (queue->numberJobs > 0)
+	{
+		queue->numberJobs--;
+
+		if (front)
+		{
+			job = queue->jobs[queue->front];
+
+			queue->front = (queue->front + 1) % queue->maxJobs;
+		}
+		else
+		{
+			job = queue->jobs[(queue->front + queue->numberJobs) % queue->maxJobs];
+		}
+	}
+
+	glusMutexUnlock(&queue->mutex);
+
+	return job;
+}
+
+static GLUSvoid glusJobExecute(GLUSjobdata* job);
+
+static GLUSvoid glusJobReleaseData(GLUSjobdata* job)
+{
+	GLUSboolean release;
+
+	glusMutexLock(&g_mutex);
+
+	job->references--;
+
+	release = job->references == 0;
+
+	glusMutexUnlock(&g_mutex);
+
+	if (release)
+	{
+		glusMemoryFree(job->dependents);
+
+		glusMemoryFree(job);
+	}
+}
+
+static GLUSvoid glusJobPush(GLUSjobdata* job)
+{
+	GLUSjobqueue* queue = job->mainThread ? &g_mainQueue : &g_queues[g_queueIndex];
+
+	volatile GLUSint* queuedJobs = job->mainThread ? &g_queuedMainJobs : &g_queuedJobs;
+
+	// Without memory for a larger queue, the job is run directly.
+	if (!glusJobQueuePush(queue, job))
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not queue job");
+
+		glusJobExecute(job);
+
+		return;
+	}
+
+	glusJobAdd(queuedJobs, 1);
+
+	glusMutexLock(&g_mutex);
+
+	if (g_sleepingThreads > 0)
+	{
+		// Only the main thread can run main thread jobs, so all have to be woken up.
+		if (job->mainThread)
+		{
+			glusConditionBroadcast(&g_condition);
+		}
+		else
+		{
+			glusConditionSignal(&g_condition);
+		}
+	}
+
+	glusMutexUnlock(&g_mutex);
+}
+
+static GLUSjobdata* glusJobFind(GLUSvoid)
+{
+	GLUSjobdata* job = 0;
+
+	GLUSint i;
+
+	if (g_mainThread && glusJobLoad(&g_queuedMainJobs) > 0)
+	{
+		job = glusJobQueuePop(&g_mainQueue, GLUS_TRUE);
+
+		if (job)
+		{
+			glusJobAdd(&g_queuedMainJobs, -1);
+
+			return job;
+		}
+	}
+
+	if (glusJobLoad(&g_queuedJobs) <= 0)
+	{
+		return 0;
+	}
+
+	// Newest job of the own queue first, as its data is most likely still in the cache ...
+
+	job = glusJobQueuePop(&g_queues[g_queueIndex], GLUS_FALSE);
+
+	// ... otherwise steal the oldest job of another queue.
+
+	for (i = 1; i < g_numberQueues && !job; i++)
+	{
+		job = glusJobQueuePop(&g_queues[(g_queueIndex + i) % g_numberQueues], GLUS_TRUE);
+	}
+
+	if (job)
+	{
+		glusJobAdd(&g_queuedJobs, -1);
+	}
+
+	return job;
+}
+
+static GLUSvoid glusJobExecute(GLUSjobdata* job)
+{
+	GLUSint i, numberReady;
+
+	GLUS_PROFILE_BEGIN("glusJob");
+
+	job->function(job->data);
+
+	GLUS_PROFILE_END();
+
+	glusMutexLock(&g_mutex);
+
+	job->finished = GLUS_TRUE;
+
+	// Dependents are pushed after unlocking, so the ready ones are moved to the front.
+
+	numberReady = 0;
+
+	for (i = 0; i < job->numberDependents; i++)
+	{
+		job->dependents[i]->openDependencies--;
+
+		if (job->dependents[i]->openDependencies == 0)
+		{
+			GLUSjobdata* dependent = job->dependents[i];
+
+			job->dependents[i] = job->dependents[numberReady];
+			job->dependents[numberReady] = dependent;
+
+			numberReady++;
+		}
+	}
+
+	g_unfinishedJobs--;
+
+	if (g_sleepingThreads > 0)
+	{
+		glusConditionBroadcast(&g_condition);
+	}
+
+	glusMutexUnlock(&g_mutex);
+
+	for (i = 0; i < numberReady; i++)
+	{
+		glusJobPush(job->dependents[i]);
+	}
+
+	for (i = 0; i < job->numberDependents; i++)
+	{
+		glusJobReleaseData(job->dependents[i]);
+	}
+
+	glusJobReleaseData(job);
+}
+
+static GLUSboolean glusJobRunNext(GLUSvoid)
+{
+	GLUSjobdata* job = glusJobFind();
+
+	if (!job)
+	{
+		return GLUS_FALSE;
+	}
+
+	glusJobExecute(job);
+
+	return GLUS_TRUE;
+}
+
+static GLUSboolean glusJobIsDone(const GLUSjobdata* job)
+{
+	if (job)
+	{
+		return job->finished;
+	}
+
+	return g_unfinishedJobs == 0;
+}
+
+/**
+ * Waits until the job or, if zero, all jobs have finished. Other jobs are run meanwhile.
+ */
+static GLUSvoid glusJobHelp(const GLUSjobdata* job)
+{
+	GLUSboolean done;
+
+	for (;;)
+	{
+		glusMutexLock(&g_mutex);
+
+		done = glusJobIsDone(job);
+
+		glusMutexUnlock(&g_mutex);
+
+		if (done)
+		{
+			return;
+		}
+
+		if (glusJobRunNext())
+		{
+			continue;
+		}
+
+		glusMutexLock(&g_mutex);
+
+		while (!glusJobIsDone(job) && glusJobLoad(&g_queuedJobs) <= 0 && (!g_mainThread || glusJobLoad(&g_queuedMainJobs) <= 0))
+		{
+			g_sleepingThreads++;
+
+			glusConditionWait(&g_condition, &g_mutex);
+
+			g_sleepingThreads--;
+		}
+
+		glusMutexUnlock(&g_mutex);
+	}
+}
+
+static GLUSvoid glusJobWorker(GLUSvoid* argument)
+{
+	GLUSboolean quit = GLUS_FALSE;
+
+	g_queueIndex = (GLUSint)((GLUSjobqueue*)argument - g_queues);
+
+	while (!quit)
+	{
+		if (glusJobRunNext())
+		{
+			continue;
+		}
+
+		glusMutexLock(&g_mutex);
+
+		while (!g_quit && glusJobLoad(&g_queuedJobs) <= 0)
+		{
+			g_sleepingThreads++;
+
+			glusConditionWait(&g_condition, &g_mutex);
+
+			g_sleepingThreads--;
+		}
+
+		quit = g_quit;
+
+		glusMutexUnlock(&g_mutex);
+	}
+}
+
+static GLUSvoid glusJobRunTilesWorker(GLUSvoid* argument)
+{
+	GLUSjobtiles* tiles = (GLUSjobtiles*)argument;
+
+	GLUSint tile, previousWorker;
+
+	previousWorker = _glusThreadSetTileWorker(glusJobAdd(&tiles->nextWorker, 1) - 1);
+
+	while ((tile = glusJobAdd(&tiles->nextTile, 1) - 1) < tiles->numberTiles)
+	{
+		tiles->function(tiles->data, tile);
+	}
+
+	_glusThreadSetTileWorker(previousWorker);
+}
+
+static GLUSint glusJobGetNumberHelpers(const GLUSint numberTiles, const GLUSint numberThreads)
+{
+	GLUSint numberHelpers = numberThreads > 0 ? numberThreads - 1 : g_numberWorkers;
+
+	if (numberHelpers > g_numberWorkers)
+	{
+		numberHelpers = g_numberWorkers;
+	}
+
+	if (numberHelpers > numberTiles - 1)
+	{
+		numberHelpers = numberTiles - 1;
+	}
+
+	return numberHelpers;
+}
+
+/**
+ * Gets the number of workers, which _glusJobRunTiles uses at most. The calling thread is included.
+ *
+ * @return Zero, if the job system is not running.
+ */
+GLUSint _glusJobGetNumberTileWorkers(const GLUSint numberTiles, const GLUSint numberThreads)
+{
+	if (!g_running || numberTiles <= 0)
+	{
+		return 0;
+	}
+
+	return glusJobGetNumberHelpers(numberTiles, numberThreads) + 1;
+}
+
+/**
+ * Calls the function for all tiles using the workers of the job system. The calling thread takes tiles as well.
+ *
+ * @return GLUS_FALSE, if the job system is not running. In this case, no tile has been processed.
+ */
+GLUSboolean _glusJobRunTiles(const GLUSint numberTiles, const GLUSint numberThreads, GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile), GLUSvoid* data)
+{
+	GLUSjobtiles tiles;
+
+	GLUSjob* helpers = 0;
+
+	GLUSint i, numberHelpers;
+
+	if (!g_running)
+	{
+		return GLUS_FALSE;
+	}
+
+	numberHelpers = glusJobGetNumberHelpers(numberTiles, numberThreads);
+
+	if (numberHelpers > 0)
+	{
+		helpers = (GLUSjob*)glusMemoryMalloc(numberHelpers * sizeof(GLUSjob));
+
+		if (!helpers)
+		{
+			return GLUS_FALSE;
+		}
+	}
+
+	tiles.nextTile = 0;
+	tiles.nextWorker = 0;
+	tiles.numberTiles = numberTiles;
+	tiles.function = function;
+	tiles.data = data;
+
+	// If a helper can not be created, its tiles are taken by the others.
+
+	for (i = 0; i < numberHelpers; i++)
+	{
+		if (glusJobCreate(&helpers[i], glusJobRunTilesWorker, &tiles, GLUS_FALSE))
+		{
+			glusJobSubmit(&helpers[i]);
+		}
+	}
+
+	glusJobRunTilesWorker(&tiles);
+
+	for (i = 0; i < numberHelpers; i++)
+	{
+		glusJobWait(&helpers[i]);
+	}
+
+	glusMemoryFree(helpers);
+
+	return GLUS_TRUE;
+}
+
+static GLUSvoid glusJobRangeTile(GLUSvoid* data, const GLUSint tile)
+{
+	GLUSjobrange* range = (GLUSjobrange*)data;
+
+	GLUSint begin = tile * range->grainSize;
+	GLUSint end = range->count - begin > range->grainSize ? begin + range->grainSize : range->count;
+
+	range->function(range->data, begin, end);
+}
+
+GLUSboolean GLUSAPIENTRY glusJobSystemCreate(const GLUSint numberThreads)
+{
+	GLUSint i;
+
+	if (g_running)
+	{
+		return GLUS_FALSE;
+	}
+
+	g_numberWorkers = numberThreads > 0 ? numberThreads : glusThreadGetNumberProcessors() - 1;
+
+	if (g_numberWorkers < 1)
+	{
+		g_numberWorkers = 1;
+	}
+
+	g_workers = (GLUSthread*)glusMemoryMalloc(g_numberWorkers * sizeof(GLUSthread));
+	g_queues = (GLUSjobqueue*)glusMemoryMalloc((g_numberWorkers + 1) * sizeof(GLUSjobqueue));
+
+	if (!g_workers || !g_queues)
+	{
+		glusMemoryFree(g_workers);
+		glusMemoryFree(g_queues);
+
+		return GLUS_FALSE;
+	}
+
+	g_numberQueues = 0;
+
+	for (i = 0; i < g_numberWorkers + 1; i++)
+	{
+		if (!glusJobQueueCreate(&g_queues[i]))
+		{
+			break;
+		}
+
+		g_numberQueues++;
+	}
+
+	if (g_numberQueues < g_numberWorkers + 1 || !glusJobQueueCreate(&g_mainQueue))
+	{
+		for (i = 0; i < g_numberQueues; i++)
+		{
+			glusJobQueueDestroy(&g_queues[i]);
+		}
+
+		glusMemoryFree(g_workers);
+		glusMemoryFree(g_queues);
+
+		return GLUS_FALSE;
+	}
+
+	if (!glusMutexCreate(&g_mutex))
+	{
+		glusJobQueueDestroy(&g_mainQueue);
+
+		for (i = 0; i < g_numberQueues; i++)
+		{
+			glusJobQueueDestroy(&g_queues[i]);
+		}
+
+		glusMemoryFree(g_workers);
+		glusMemoryFree(g_queues);
+
+		return GLUS_FALSE;
+	}
+
+	if (!glusConditionCreate(&g_condition))
+	{
+		glusMutexDestroy(&g_mutex);
+
+		glusJobQueueDestroy(&g_mainQueue);
+
+		for (i = 0; i < g_numberQueues; i++)
+		{
+			glusJobQueueDestroy(&g_queues[i]);
+		}
+
+		glusMemoryFree(g_workers);
+		glusMemoryFree(g_queues);
+
+		return GLUS_FALSE;
+	}
+
+	g_queuedJobs = 0;
+	g_queuedMainJobs = 0;
+	g_unfinishedJobs = 0;
+	g_sleepingThreads = 0;
+	g_quit = GLUS_FALSE;
+
+	g_queueIndex = 0;
+	g_mainThread = GLUS_TRUE;
+
+	g_running = GLUS_TRUE;
+
+	// If a thread can not be started, its queue stays empty and jobs are run by the other threads.
+
+	for (i = 0; i < g_numberWorkers; i++)
+	{
+		if (!glusThreadCreate(&g_workers[i], glusJobWorker, &g_queues[i + 1]))
+		{
+			glusLogPrint(GLUS_LOG_WARNING, "Could not start job thread %d", i);
+
+			g_workers[i].handle = 0;
+		}
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusJobSystemDestroy(GLUSvoid)
+{
+	GLUSint i;
+
+	if (!g_running || !g_mainThread)
+	{
+		return;
+	}
+
+	glusJobHelp(0);
+
+	glusMutexLock(&g_mutex);
+
+	g_quit = GLUS_TRUE;
+
+	glusConditionBroadcast(&g_condition);
+
+	glusMutexUnlock(&g_mutex);
+
+	for (i = 0; i < g_numberWorkers; i++)
+	{
+		glusThreadJoin(&g_workers[i]);
+	}
+
+	glusConditionDestroy(&g_condition);
+	glusMutexDestroy(&g_mutex);
+
+	glusJobQueueDestroy(&g_mainQueue);
+
+	for (i = 0; i < g_numberQueues; i++)
+	{
+		glusJobQueueDestroy(&g_queues[i]);
+	}
+
+	glusMemoryFree(g_workers);
+	glusMemoryFree(g_queues);
+
+	g_workers = 0;
+	g_queues = 0;
+	g_numberWorkers = 0;
+	g_numberQueues = 0;
+
+	g_mainThread = GLUS_FALSE;
+
+	g_running = GLUS_FALSE;
+}
+
+GLUSboolean GLUSAPIENTRY glusJobSystemIsRunning(GLUSvoid)
+{
+	return g_running;
+}
+
+GLUSint GLUSAPIENTRY glusJobSystemGetNumberThreads(GLUSvoid)
+{
+	return g_numberWorkers;
+}
+
+GLUSboolean GLUSAPIENTRY glusJobCreate(GLUSjob* job, GLUSjobfunc function, GLUSvoid* data, const GLUSboolean mainThread)
+{
+	GLUSjobdata* jobData;
+
+	if (!job)
+	{
+		return GLUS_FALSE;
+	}
+
+	job->handle = 0;
+
+	if (!g_running || !function)
+	{
+		return GLUS_FALSE;
+	}
+
+	jobData = (GLUSjobdata*)glusMemoryMalloc(sizeof(GLUSjobdata));
+
+	if (!jobData)
+	{
+		return GLUS_FALSE;
+	}
+
+	jobData->function = function;
+	jobData->data = data;
+	jobData->mainThread = mainThread;
+	jobData->submitted = GLUS_FALSE;
+	jobData->finished = GLUS_FALSE;
+	jobData->openDependencies = 1;
+	jobData->references = 1;
+	jobData->dependents = 0;
+	jobData->numberDependents = 0;
+	jobData->maxDependents = 0;
+
+	job->handle = jobData;
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusJobAddDependency(GLUSjob* job, GLUSjob* dependency)
+{
+	GLUSjobdata* jobData;
+	GLUSjobdata* dependencyData;
+
+	GLUSjobdata** dependents;
+
+	GLUSint i;
+
+	if (!job || !job->handle || !dependency || !dependency->handle || job->handle == dependency->handle)
+	{
+		return GLUS_FALSE;
+	}
+
+	jobData = (GLUSjobdata*)job->handle;
+	dependencyData = (GLUSjobdata*)dependency->handle;
+
+	glusMutexLock(&g_mutex);
+
+	if (jobData->submitted)
+	{
+		glusMutexUnlock(&g_mutex);
+
+		return GLUS_FALSE;
+	}
+
+	if (dependencyData->finished)
+	{
+		glusMutexUnlock(&g_mutex);
+
+		return GLUS_TRUE;
+	}
+
+	if (dependencyData->numberDependents == dependencyData->maxDependents)
+	{
+		dependents = (GLUSjobdata**)glusMemoryMalloc((dependencyData->maxDependents + 4) * sizeof(GLUSjobdata*));
+
+		if (!dependents)
+		{
+			glusMutexUnlock(&g_mutex);
+
+			return GLUS_FALSE;
+		}
+
+		for (i = 0; i < dependencyData->numberDependents; i++)
+		{
+			dependents[i] = dependencyData->dependents[i];
+		}
+
+		glusMemoryFree(dependencyData->dependents);
+
+		dependencyData->dependents = dependents;
+		dependencyData->maxDependents += 4;
+	}
+
+	dependencyData->dependents[dependencyData->numberDependents] = jobData;
+
+	dependencyData->numberDependents++;
+
+	jobData->openDependencies++;
+	jobData->references++;
+
+	glusMutexUnlock(&g_mutex);
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusJobSubmit(GLUSjob* job)
+{
+	GLUSjobdata* jobData;
+
+	GLUSboolean ready;
+
+	if (!job || !job->handle)
+	{
+		return GLUS_FALSE;
+	}
+
+	jobData = (GLUSjobdata*)job->handle;
+
+	glusMutexLock(&g_mutex);
+
+	if (jobData->submitted)
+	{
+		glusMutexUnlock(&g_mutex);
+
+		return GLUS_FALSE;
+	}
+
+	jobData->submitted = GLUS_TRUE;
+
+	jobData->openDependencies--;
+	jobData->references++;
+
+	ready = jobData->openDependencies == 0;
+
+	g_unfinishedJobs++;
+
+	glusMutexUnlock(&g_mutex);
+
+	if (ready)
+	{
+		glusJobPush(jobData);
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusJobIsFinished(GLUSjob* job)
+{
+	GLUSboolean finished;
+
+	if (!job || !job->handle)
+	{
+		return GLUS_FALSE;
+	}
+
+	glusMutexLock(&g_mutex);
+
+	finished = ((GLUSjobdata*)job->handle)->finished;
+
+	glusMutexUnlock(&g_mutex);
+
+	return finished;
+}
+
+GLUSvoid GLUSAPIENTRY glusJobWait(GLUSjob* job)
+{
+	GLUSjobdata* jobData;
+
+	GLUSboolean submitted;
+
+	if (!job || !job->handle)
+	{
+		return;
+	}
+
+	jobData = (GLUSjobdata*)job->handle;
+
+	glusMutexLock(&g_mutex);
+
+	submitted = jobData->submitted;
+
+	glusMutexUnlock(&g_mutex);
+
+	if (submitted)
+	{
+		glusJobHelp(jobData);
+	}
+
+	glusJobRelease(job);
+}
+
+GLUSvoid GLUSAPIENTRY glusJobRelease(GLUSjob* job)
+{
+	if (!job || !job->handle)
+	{
+		return;
+	}
+
+	glusJobReleaseData((GLUSjobdata*)job->handle);
+
+	job->handle = 0;
+}
+
+GLUSint GLUSAPIENTRY glusJobRunMainThread(GLUSvoid)
+{
+	GLUSjobdata* job;
+
+	GLUSint numberJobs = 0;
+	GLUSint maxJobs;
+
+	if (!g_running || !g_mainThread)
+	{
+		return 0;
+	}
+
+	// Jobs queued by the run jobs wait for the next call, so a frame can not be blocked forever.
+
+	maxJobs = glusJobLoad(&g_queuedMainJobs);
+
+	while (numberJobs < maxJobs && (job = glusJobQueuePop(&g_mainQueue, GLUS_TRUE)) != 0)
+	{
+		glusJobAdd(&g_queuedMainJobs, -1);
+
+		glusJobExecute(job);
+
+		numberJobs++;
+	}
+
+	return numberJobs;
+}
+
+GLUSboolean GLUSAPIENTRY glusJobParallelFor(const GLUSint count, const GLUSint grainSize, GLUSjobrangefunc function, GLUSvoid* data)
+{
+	GLUSjobrange range;
+
+	GLUSint numberThreads;
+
+	if (count <= 0 || !function)
+	{
+		return count == 0;
+	}
+
+	range.count = count;
+	range.grainSize = grainSize;
+	range.function = function;
+	range.data = data;
+
+	if (range.grainSize <= 0)
+	{
+		numberThreads = g_running ? g_numberWorkers + 1 : glusThreadGetNumberProcessors();
+
+		range.grainSize = (count - 1) / (numberThreads * GLUS_JOB_RANGES_PER_THREAD) + 1;
+	}
+
+	return _glusThreadRunTiles((count - 1) / range.grainSize + 1, 0, glusJobRangeTile, &range);
+}
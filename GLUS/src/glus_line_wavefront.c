@@ -21,5 +21,13 @@ extern GLUSboolean _glusWavefrontParseLine(const GLUSchar* filename, GLUSline* l
 
 GLUSboolean GLUSAPIENTRY glusLineLoadWavefront(const GLUSchar* filename, GLUSline* line)
 {
-	return _glusWavefrontParseLine(filename, line);
+	GLUSboolean result;
+
+	GLUS_PROFILE_BEGIN("glusLineLoadWavefront");
+
+	result = _glusWavefrontParseLine(filename, line);
+
+	GLUS_PROFILE_END();
+
+	return result;
 }
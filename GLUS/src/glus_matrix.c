@@ -17,79 +17,6 @@
 
 #include "GL/glus.h"
 
-static GLUSboolean glusMatrix4x4IsRowZero(const double matrix[16], GLUSint row)
-{
-    GLUSint column;
-
-    for (column = 0; column < 4; column++)
-    {
-        if (matrix[column * 4 + row] != 0.0)
-        {
-            return GLUS_FALSE;
-        }
-    }
-
-    return GLUS_TRUE;
-}
-
-static GLUSboolean glusMatrix4x4IsColumnZero(const double matrix[16], GLUSint column)
-{
-    GLUSint row;
-
-    for (row = 0; row < 4; row++)
-    {
-        if (matrix[column * 4 + row] != 0.0)
-        {
-            return GLUS_FALSE;
-        }
-    }
-
-    return GLUS_TRUE;
-}
-
-static GLUSvoid glusMatrix4x4DivideRowByScalar(double result[16], double matrix[16], GLUSint row, double  value)
-{
-    GLUSint column;
-    // No inverse for robustness
-
-    for (column = 0; column < 4; column++)
-    {
-        matrix[column * 4 + row] /= value;
-        result[column * 4 + row] /= value;
-    }
-}
-
-static GLUSvoid glusMatrix4x4SwapRow(double result[16], double matrix[16], GLUSint rowOne, GLUSint rowTwo)
-{
-    GLUSint column;
-
-    double temp;
-
-    for (column = 0; column < 4; column++)
-    {
-        temp = matrix[column * 4 + rowOne];
-        matrix[column * 4 + rowOne] = matrix[column * 4 + rowTwo];
-        matrix[column * 4 + rowTwo] = temp;
-
-        temp = result[column * 4 + rowOne];
-        result[column * 4 + rowOne] = result[column * 4 + rowTwo];
-        result[column * 4 + rowTwo] = temp;
-    }
-}
-
-static GLUSvoid glusMatrix4x4AddRow(double result[16], double matrix[16], GLUSint rowOne, GLUSint rowTwo, double factor)
-{
-    GLUSint column;
-
-    for (column = 0; column < 4; column++)
-    {
-        matrix[column * 4 + rowOne] += matrix[column * 4 + rowTwo] * factor;
-        result[column * 4 + rowOne] += result[column * 4 + rowTwo] * factor;
-    }
-}
-
-//
-
 GLUSvoid GLUSAPIENTRY glusMatrix4x4Identityf(GLUSfloat matrix[16])
 {
     matrix[0] = 1.0f;
@@ -469,104 +396,131 @@ GLUSboolean GLUSAPIENTRY glusMatrix4x4Inversef(GLUSfloat matrix[16])
 {
     GLUSint i;
 
-    GLUSint column;
-    GLUSint row;
+    GLUSdouble m[16];
+
+    GLUSdouble s0, s1, s2, s3, s4, s5;
+    GLUSdouble c0, c1, c2, c3, c4, c5;
 
-    double matrix_as_double[16] = {1.0, 0.0, 0.0, 0.0,  0.0, 1.0, 0.0, 0.0,  0.0, 0.0, 1.0, 0.0,  0.0, 0.0, 0.0, 1.0};
-    double copy[16];
+    GLUSdouble det;
+    GLUSdouble invDet;
 
     //
-    // Copy the original matrix as we want to manipulate it
+    // Calculated in double precision, as projection matrices lose too many digits in the sub determinants.
     //
     for (i = 0; i < 16; i++)
     {
-        copy[i] = (double)matrix[i];
+        m[i] = (GLUSdouble)matrix[i];
     }
 
     //
-    // Make triangle form
+    // 2x2 sub determinants of the first two and the last two columns. The adjunct is built from them.
     //
-    for (column = 0; column < 4; column++)
+    s0 = m[0] * m[5] - m[4] * m[1];
+    s1 = m[0] * m[6] - m[4] * m[2];
+    s2 = m[0] * m[7] - m[4] * m[3];
+    s3 = m[1] * m[6] - m[5] * m[2];
+    s4 = m[1] * m[7] - m[5] * m[3];
+    s5 = m[2] * m[7] - m[6] * m[3];
+
+    c5 = m[10] * m[15] - m[14] * m[11];
+    c4 = m[9] * m[15] - m[13] * m[11];
+    c3 = m[9] * m[14] - m[13] * m[10];
+    c2 = m[8] * m[15] - m[12] * m[11];
+    c1 = m[8] * m[14] - m[12] * m[10];
+    c0 = m[8] * m[13] - m[12] * m[9];
+
+    det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+
+    if (det == 0.0)
     {
-        GLUSint row;
+        return GLUS_FALSE;
+    }
 
-        for (row = column; row < 4; row++)
-        {
-        	//
-            // Is row all zero, then return false
-            //
-            if (glusMatrix4x4IsRowZero(copy, row))
-            {
-                return GLUS_FALSE;
-            }
+    invDet = 1.0 / det;
 
-            //
-            // Divide, if not zero, by copy[column*4+row]
-            //
-            if (copy[column * 4 + row] != 0.0)
-            {
-                glusMatrix4x4DivideRowByScalar(matrix_as_double, copy, row, copy[column * 4 + row]);
-            }
-        }
+    matrix[0] = (GLUSfloat)((m[5] * c5 - m[6] * c4 + m[7] * c3) * invDet);
+    matrix[1] = (GLUSfloat)((-m[1] * c5 + m[2] * c4 - m[3] * c3) * invDet);
+    matrix[2] = (GLUSfloat)((m[13] * s5 - m[14] * s4 + m[15] * s3) * invDet);
+    matrix[3] = (GLUSfloat)((-m[9] * s5 + m[10] * s4 - m[11] * s3) * invDet);
 
-        //
-        // Is column all zero, then return false
-        //
-        if (glusMatrix4x4IsColumnZero(copy, column))
-        {
-            return GLUS_FALSE;
-        }
+    matrix[4] = (GLUSfloat)((-m[4] * c5 + m[6] * c2 - m[7] * c1) * invDet);
+    matrix[5] = (GLUSfloat)((m[0] * c5 - m[2] * c2 + m[3] * c1) * invDet);
+    matrix[6] = (GLUSfloat)((-m[12] * s5 + m[14] * s2 - m[15] * s1) * invDet);
+    matrix[7] = (GLUSfloat)((m[8] * s5 - m[10] * s2 + m[11] * s1) * invDet);
 
-        //
-        // Is pivot [column*4+row] = 1.0
-        //
-        for (row = column + 1; row < 4; row++)
-        {
-            if (copy[column * 4 + row] == 1.0)
-            {
-                //
-                // Swap with pivot row = column
-                //
-                glusMatrix4x4SwapRow(matrix_as_double, copy, column, row);
+    matrix[8] = (GLUSfloat)((m[4] * c4 - m[5] * c2 + m[7] * c0) * invDet);
+    matrix[9] = (GLUSfloat)((-m[0] * c4 + m[1] * c2 - m[3] * c0) * invDet);
+    matrix[10] = (GLUSfloat)((m[12] * s4 - m[13] * s2 + m[15] * s0) * invDet);
+    matrix[11] = (GLUSfloat)((-m[8] * s4 + m[9] * s2 - m[11] * s0) * invDet);
 
-                break;
-            }
-        }
+    matrix[12] = (GLUSfloat)((-m[4] * c3 + m[5] * c1 - m[6] * c0) * invDet);
+    matrix[13] = (GLUSfloat)((m[0] * c3 - m[1] * c1 + m[2] * c0) * invDet);
+    matrix[14] = (GLUSfloat)((-m[12] * s3 + m[13] * s1 - m[14] * s0) * invDet);
+    matrix[15] = (GLUSfloat)((m[8] * s3 - m[9] * s1 + m[10] * s0) * invDet);
 
-        for (row = column + 1; row < 4; row++)
-        {
-            //
-            // Subtract, [column*4+row] not zero, current row minus pivot row = column
-            //
-            if (copy[column * 4 + row] != 0.0)
-            {
-                glusMatrix4x4AddRow(matrix_as_double, copy, row, column, -1.0);
-            }
-        }
+    return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusMatrix4x4InverseAffinef(GLUSfloat matrix[16])
+{
+    GLUSint i;
+
+    GLUSdouble m[16];
+    GLUSdouble temp[12];
+
+    GLUSdouble det;
+    GLUSdouble invDet;
+
+    for (i = 0; i < 16; i++)
+    {
+        m[i] = (GLUSdouble)matrix[i];
     }
 
     //
-    // Make diagonal form
+    // Adjunct of the upper left 3x3 matrix, stored with a column stride of four.
     //
-    for (column = 3; column >= 0; column--)
+    temp[0] = m[5] * m[10] - m[9] * m[6];
+    temp[1] = m[9] * m[2] - m[1] * m[10];
+    temp[2] = m[1] * m[6] - m[5] * m[2];
+
+    det = m[0] * temp[0] + m[4] * temp[1] + m[8] * temp[2];
+
+    if (det == 0.0)
     {
-        for (row = column - 1; row >= 0; row--)
-        {
-            //
-            // Subtract, if [column*4+row] not zero, current row minus pivot row = column with factor [column*4+row]
-            //
-            if (copy[column * 4 + row] != 0.0)
-            {
-                glusMatrix4x4AddRow(matrix_as_double, copy, row, column, -copy[column * 4 + row]);
-            }
-        }
+        return GLUS_FALSE;
     }
 
-    for (i = 0; i < 16; i++)
+    invDet = 1.0 / det;
+
+    temp[4] = m[8] * m[6] - m[4] * m[10];
+    temp[5] = m[0] * m[10] - m[8] * m[2];
+    temp[6] = m[4] * m[2] - m[0] * m[6];
+
+    temp[8] = m[4] * m[9] - m[8] * m[5];
+    temp[9] = m[8] * m[1] - m[0] * m[9];
+    temp[10] = m[0] * m[5] - m[4] * m[1];
+
+    for (i = 0; i < 3; i++)
     {
-        matrix[i] = (float)matrix_as_double[i];
+        temp[i] *= invDet;
+        temp[4 + i] *= invDet;
+        temp[8 + i] *= invDet;
+
+        matrix[i] = (GLUSfloat)temp[i];
+        matrix[4 + i] = (GLUSfloat)temp[4 + i];
+        matrix[8 + i] = (GLUSfloat)temp[8 + i];
+
+        //
+        // Inverse translation is -inverse(A) * t.
+        //
+        matrix[12 + i] = (GLUSfloat)(-(temp[i] * m[12] + temp[4 + i] * m[13] + temp[8 + i] * m[14]));
     }
 
+    matrix[3] = 0.0f;
+    matrix[7] = 0.0f;
+    matrix[11] = 0.0f;
+    matrix[15] = 1.0f;
+
     return GLUS_TRUE;
 }
 
@@ -26,3 +26,27 @@ void GLUSAPIENTRY glusMemoryFree(void* pointer)
 {
 	free(pointer);
 }
+
+GLUSboolean GLUSAPIENTRY glusMemorySetPool(void* memory, size_t size)
+{
+	(void)memory;
+	(void)size;
+
+	// The system allocator has no pool.
+	return GLUS_FALSE;
+}
+
+GLUSboolean GLUSAPIENTRY glusMemoryGetStats(GLUSmemorystats* stats)
+{
+	if (stats)
+	{
+		memset(stats, 0, sizeof(GLUSmemorystats));
+	}
+
+	return GLUS_FALSE;
+}
+
+GLUSvoid _glusMemoryFlushThreadCache(GLUSvoid)
+{
+	// No thread caches.
+}
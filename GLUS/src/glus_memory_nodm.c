@@ -15,249 +15,803 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
 #include "GL/glus.h"
 
-// Data type used for the memory array.
-#define GLUS_MEMORY_DATA_TYPE uint32_t
+// Size of the memory pool, if no other pool is set. Change only here, if more or less is needed.
+#ifndef GLUS_MEMORY_SIZE
+#define GLUS_MEMORY_SIZE (128*1024*1024)
+#endif
+
+// Alignment of all blocks.
+#define GLUS_MEMORY_ALIGNMENT 16
+
+// The pool is divided into pages. A page either holds blocks of one size class or is part of a large block.
+#define GLUS_MEMORY_PAGE_SIZE (64*1024)
 
-// Data size of the data type.
-#define GLUS_MEMORY_DATA_SIZE sizeof(GLUS_MEMORY_DATA_TYPE)
+// Blocks up to this size are taken from size classes, larger blocks get whole pages.
+#define GLUS_MEMORY_MAX_CLASS_SIZE (32*1024)
 
-// Alignment in memory.
-#define GLUS_MEMORY_DATA_ALIGNMENT_SIZE (GLUS_MEMORY_DATA_SIZE * 2)
+// 16 to 128 bytes in steps of 16 bytes, then four classes per power of two.
+#define GLUS_MEMORY_CLASSES 40
 
-// Factor to get the right alignment.
-#define GLUS_MEMORY_DATAT_ALIGNMENT_FACTOR (GLUS_MEMORY_DATA_ALIGNMENT_SIZE / GLUS_MEMORY_DATA_SIZE)
+// Free page runs are binned by the power of two of their length.
+#define GLUS_MEMORY_BINS 32
 
-// 128 MB of memory. Change only here, if more or less is needed.
-#define GLUS_MEMORY_SIZE (128*1024*1024/GLUS_MEMORY_DATA_SIZE)
+// Blocks moved at once between a thread cache and the pool.
+#define GLUS_MEMORY_BATCH_SIZE (8*1024)
+#define GLUS_MEMORY_MIN_BATCH 2
+#define GLUS_MEMORY_MAX_BATCH 32
 
-// Number of memory table entries.
-#define GLUS_MEMORY_TABLE_ENTRIES	2048
+// States of a page.
+#define GLUS_MEMORY_PAGE_FREE	1
+#define GLUS_MEMORY_PAGE_CLASS	2
+#define GLUS_MEMORY_PAGE_LARGE	3
 
-// States of a memory block entry.
-#define GLUS_VALID_AND_FREE		1
-#define GLUS_VALID_AND_LOCKED   2
-#define GLUS_INVALID			3
+#if defined(_MSC_VER)
+#define GLUS_MEMORY_THREAD_LOCAL __declspec(thread)
+#else
+#define GLUS_MEMORY_THREAD_LOCAL __thread
+#endif
 
 /**
- * Structure for the memory table entry.
+ * Structure describing one page of the pool.
  */
-typedef struct _GLUSmemoryTable {
+typedef struct _GLUSmemorypage {
+
+	/**
+	 * State of the page.
+	 */
+	GLUSubyte state;
+
+	/**
+	 * Size class of the blocks, if the page holds blocks.
+	 */
+	GLUSubyte sizeClass;
+
+	/**
+	 * Number of pages of a free or large run. Valid at the first page of the run.
+	 */
+	GLUSint runLength;
+
+	/**
+	 * First page of a free run. Valid at the last page of the run.
+	 */
+	GLUSint runStart;
 
 	/**
-	 * Flag, if entry is valid and/or free.
+	 * Next and previous page in the list of free runs or in the list of pages with free blocks.
 	 */
-	GLUSubyte status;
+	GLUSint next;
+	GLUSint previous;
 
 	/**
-	 * Start index into the memory.
+	 * Freed blocks of the page.
 	 */
-	size_t startIndex;
+	void* freeBlocks;
 
 	/**
-	 * Length of the indices from the allocated memory.
+	 * Offset of the never used part of the page.
 	 */
-	size_t lengthIndices;
+	GLUSuint unusedOffset;
+
+	/**
+	 * Number of blocks handed out from the page.
+	 */
+	GLUSuint usedBlocks;
+
+} GLUSmemorypage;
+
+/**
+ * Blocks cached by one thread, so most allocations do not need to lock the pool.
+ */
+typedef struct _GLUSmemorycache {
+
+	void* blocks[GLUS_MEMORY_CLASSES];
+
+	GLUSint numberBlocks[GLUS_MEMORY_CLASSES];
+
+	GLUSint generation;
 
-} GLUSmemoryTable;
+} GLUSmemorycache;
 
 /**
- * Available memory with given data type.
+ * Default memory pool.
  */
-static GLUS_MEMORY_DATA_TYPE g_memory[GLUS_MEMORY_SIZE];
+static GLUSubyte g_memory[GLUS_MEMORY_SIZE];
 
 /**
- * Memory table used to manage the memory array.
+ * Lock for the pool. Only needed, if a thread cache is empty or full and for large blocks.
  */
-static GLUSmemoryTable g_memoryTable[GLUS_MEMORY_TABLE_ENTRIES] = {{GLUS_VALID_AND_FREE, 0, GLUS_MEMORY_SIZE}};
+static volatile GLUSint g_lock = 0;
 
 /**
- * Current amount of initialized memory table entries.
+ * Changed every time a pool is set, so thread caches can be reset.
  */
-static size_t g_memoryTableEntries = 1;
+static volatile GLUSint g_generation = 0;
+
+static GLUSubyte* g_poolData = 0;
+static size_t g_poolSize = 0;
+
+static GLUSmemorypage* g_pages = 0;
+static GLUSint g_numberPages = 0;
+static GLUSint g_committedPages = 0;
+
+static GLUSint g_freeRuns[GLUS_MEMORY_BINS];
+static GLUSint g_classPages[GLUS_MEMORY_CLASSES];
+
+static size_t g_classSizes[GLUS_MEMORY_CLASSES];
+
+static volatile GLUSint64 g_bytesInUse = 0;
+static volatile GLUSint64 g_peakBytesInUse = 0;
 
-static GLUSboolean glusMemoryInitTableEntry(size_t startIndex, size_t lengthIndices)
+static GLUS_MEMORY_THREAD_LOCAL GLUSmemorycache g_cache;
+
+static GLUSvoid glusMemoryLock(GLUSvoid)
 {
-    size_t tableIndex = 0;
+#ifdef _WIN32
+	while (InterlockedExchange((volatile LONG*)&g_lock, 1))
+	{
+		SwitchToThread();
+	}
+#else
+	while (__atomic_exchange_n(&g_lock, 1, __ATOMIC_ACQUIRE))
+	{
+		sched_yield();
+	}
+#endif
+}
 
-	//
+static GLUSvoid glusMemoryUnlock(GLUSvoid)
+{
+#ifdef _WIN32
+	InterlockedExchange((volatile LONG*)&g_lock, 0);
+#else
+	__atomic_store_n(&g_lock, 0, __ATOMIC_RELEASE);
+#endif
+}
 
-    while (tableIndex < g_memoryTableEntries)
-    {
-        // If not valid, the table entry can be reused.
-        if (g_memoryTable[tableIndex].status == GLUS_INVALID)
-        {
-            break;
-        }
+static GLUSvoid glusMemoryCount(const GLUSint64 bytes)
+{
+	GLUSint64 bytesInUse, peakBytesInUse;
 
-        tableIndex++;
-    }
+#ifdef _WIN32
+	bytesInUse = InterlockedExchangeAdd64((volatile LONG64*)&g_bytesInUse, bytes) + bytes;
 
-    if (tableIndex >= GLUS_MEMORY_TABLE_ENTRIES)
-    {
-        return GLUS_FALSE;
-    }
+	peakBytesInUse = g_peakBytesInUse;
 
-	//
+	while (bytesInUse > peakBytesInUse && InterlockedCompareExchange64((volatile LONG64*)&g_peakBytesInUse, bytesInUse, peakBytesInUse) != peakBytesInUse)
+	{
+		peakBytesInUse = g_peakBytesInUse;
+	}
+#else
+	bytesInUse = __atomic_add_fetch(&g_bytesInUse, bytes, __ATOMIC_RELAXED);
 
-	g_memoryTable[tableIndex].status = GLUS_VALID_AND_FREE;
-	g_memoryTable[tableIndex].startIndex = startIndex;
-	g_memoryTable[tableIndex].lengthIndices = lengthIndices;
+	peakBytesInUse = __atomic_load_n(&g_peakBytesInUse, __ATOMIC_RELAXED);
 
-	if (tableIndex == g_memoryTableEntries)
+	while (bytesInUse > peakBytesInUse && !__atomic_compare_exchange_n(&g_peakBytesInUse, &peakBytesInUse, bytesInUse, GLUS_TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
 	{
-		g_memoryTableEntries++;
 	}
+#endif
+}
 
-	return GLUS_TRUE;
+static GLUSint glusMemoryGetSizeClass(size_t size)
+{
+	size_t value;
+	GLUSint shift;
+
+	if (size <= 128)
+	{
+		return (GLUSint)((size + 15) / 16) - 1;
+	}
+
+	// The two bits below the highest bit select one of four classes.
+
+	value = size - 1;
+	shift = 7;
+
+	while (value >> (shift + 1))
+	{
+		shift++;
+	}
+
+	return 8 + (shift - 7) * 4 + (GLUSint)((value >> (shift - 2)) & 3);
+}
+
+static GLUSint glusMemoryGetBin(GLUSint length)
+{
+	GLUSint bin = 0;
+
+	while (length >> (bin + 1))
+	{
+		bin++;
+	}
+
+	return bin;
+}
+
+static GLUSvoid glusMemoryInsertRun(GLUSint start, GLUSint length)
+{
+	GLUSint bin = glusMemoryGetBin(length);
+
+	g_pages[start].state = GLUS_MEMORY_PAGE_FREE;
+	g_pages[start].runLength = length;
+	g_pages[start].previous = -1;
+	g_pages[start].next = g_freeRuns[bin];
+
+	if (g_freeRuns[bin] >= 0)
+	{
+		g_pages[g_freeRuns[bin]].previous = start;
+	}
+
+	g_freeRuns[bin] = start;
+
+	g_pages[start + length - 1].state = GLUS_MEMORY_PAGE_FREE;
+	g_pages[start + length - 1].runStart = start;
+}
+
+static GLUSvoid glusMemoryRemoveRun(GLUSint start)
+{
+	GLUSmemorypage* page = &g_pages[start];
+
+	if (page->previous >= 0)
+	{
+		g_pages[page->previous].next = page->next;
+	}
+	else
+	{
+		g_freeRuns[glusMemoryGetBin(page->runLength)] = page->next;
+	}
+
+	if (page->next >= 0)
+	{
+		g_pages[page->next].previous = page->previous;
+	}
 }
 
-static GLUSvoid glusMemoryGarbageCollect()
+static GLUSvoid glusMemoryInit(GLUSubyte* memory, size_t size)
 {
-	GLUSboolean continueGC = GLUS_TRUE;
+	GLUSint i;
+
+	size_t offset;
+
+	// Align the start of the pool.
+
+	offset = (GLUS_MEMORY_ALIGNMENT - ((size_t)memory % GLUS_MEMORY_ALIGNMENT)) % GLUS_MEMORY_ALIGNMENT;
+
+	memory += offset;
+	size = size > offset ? size - offset : 0;
+
+	// The page descriptions are stored in front of the pages.
+
+	g_numberPages = (GLUSint)(size / (GLUS_MEMORY_PAGE_SIZE + sizeof(GLUSmemorypage)));
+
+	offset = (g_numberPages * sizeof(GLUSmemorypage) + GLUS_MEMORY_ALIGNMENT - 1) / GLUS_MEMORY_ALIGNMENT * GLUS_MEMORY_ALIGNMENT;
+
+	if (g_numberPages > 0 && offset + (size_t)g_numberPages * GLUS_MEMORY_PAGE_SIZE > size)
+	{
+		g_numberPages--;
+	}
+
+	g_pages = (GLUSmemorypage*)memory;
+	g_poolData = memory + offset;
+	g_poolSize = (size_t)g_numberPages * GLUS_MEMORY_PAGE_SIZE;
+
+	g_committedPages = 0;
 
-	// Do garbage collection, until no memory has been merged.
-	while(continueGC)
+	for (i = 0; i < GLUS_MEMORY_BINS; i++)
 	{
-		GLUSuint tableIndex = 0;
+		g_freeRuns[i] = -1;
+	}
 
-		continueGC = GLUS_FALSE;
+	for (i = 0; i < GLUS_MEMORY_CLASSES; i++)
+	{
+		g_classPages[i] = -1;
 
-		while (tableIndex < g_memoryTableEntries)
+		if (i < 8)
 		{
-			if (g_memoryTable[tableIndex].status == GLUS_VALID_AND_FREE)
-			{
-				GLUSuint otherTableIndex = 0;
+			g_classSizes[i] = (i + 1) * 16;
+		}
+		else
+		{
+			g_classSizes[i] = (size_t)(5 + (i - 8) % 4) << ((i - 8) / 4 + 5);
+		}
+	}
 
-				while (otherTableIndex < g_memoryTableEntries)
-				{
-					if (otherTableIndex == tableIndex)
-					{
-						otherTableIndex++;
+	if (g_numberPages > 0)
+	{
+		glusMemoryInsertRun(0, g_numberPages);
+	}
+
+	g_generation++;
+}
+
+static GLUSint glusMemoryAllocatePages(GLUSint length)
+{
+	GLUSint bin, start;
+
+	// Every run in this and the following bins is long enough.
 
-						continue;
-					}
+	for (bin = glusMemoryGetBin(length); bin < GLUS_MEMORY_BINS; bin++)
+	{
+		start = g_freeRuns[bin];
 
-					if (g_memoryTable[otherTableIndex].status == GLUS_VALID_AND_FREE)
-					{
-						// Check, if two entries are adjacent.
-						if (g_memoryTable[tableIndex].startIndex + g_memoryTable[tableIndex].lengthIndices == g_memoryTable[otherTableIndex].startIndex)
-						{
-							g_memoryTable[tableIndex].lengthIndices += g_memoryTable[otherTableIndex].lengthIndices;
+		if (length > (1 << bin))
+		{
+			while (start >= 0 && g_pages[start].runLength < length)
+			{
+				start = g_pages[start].next;
+			}
+		}
 
-							g_memoryTable[otherTableIndex].status = GLUS_INVALID;
+		if (start >= 0)
+		{
+			GLUSint runLength = g_pages[start].runLength;
 
-							// Continue to try to merge.
-							continueGC = GLUS_TRUE;
-						}
-					}
+			glusMemoryRemoveRun(start);
 
-					otherTableIndex++;
-				}
+			if (runLength > length)
+			{
+				glusMemoryInsertRun(start + length, runLength - length);
 			}
 
-			tableIndex++;
+			g_pages[start].runLength = length;
+			g_pages[start + length - 1].runStart = start;
+
+			g_committedPages += length;
+
+			return start;
 		}
 	}
+
+	return -1;
 }
 
-static void* glusMemoryInternalMalloc(size_t size)
+static GLUSvoid glusMemoryFreePages(GLUSint start)
 {
-	GLUSuint tableIndex = 0;
+	GLUSint length = g_pages[start].runLength;
+
+	g_committedPages -= length;
+
+	// Merge with free neighbors, so large blocks can be allocated again.
+
+	if (start > 0 && g_pages[start - 1].state == GLUS_MEMORY_PAGE_FREE)
+	{
+		GLUSint previousStart = g_pages[start - 1].runStart;
+
+		glusMemoryRemoveRun(previousStart);
+
+		length += start - previousStart;
+		start = previousStart;
+	}
+
+	if (start + length < g_numberPages && g_pages[start + length].state == GLUS_MEMORY_PAGE_FREE)
+	{
+		GLUSint nextLength = g_pages[start + length].runLength;
+
+		glusMemoryRemoveRun(start + length);
+
+		length += nextLength;
+	}
+
+	glusMemoryInsertRun(start, length);
+}
+
+static GLUSvoid glusMemoryUnlinkClassPage(GLUSint pageIndex)
+{
+	GLUSmemorypage* page = &g_pages[pageIndex];
+
+	if (page->previous >= 0)
+	{
+		g_pages[page->previous].next = page->next;
+	}
+	else
+	{
+		g_classPages[page->sizeClass] = page->next;
+	}
+
+	if (page->next >= 0)
+	{
+		g_pages[page->next].previous = page->previous;
+	}
+
+	page->next = -1;
+	page->previous = -1;
+}
+
+static GLUSvoid glusMemoryLinkClassPage(GLUSint pageIndex)
+{
+	GLUSmemorypage* page = &g_pages[pageIndex];
+
+	page->previous = -1;
+	page->next = g_classPages[page->sizeClass];
+
+	if (page->next >= 0)
+	{
+		g_pages[page->next].previous = pageIndex;
+	}
+
+	g_classPages[page->sizeClass] = pageIndex;
+}
+
+static void* glusMemoryAllocateBlock(GLUSint sizeClass)
+{
+	GLUSint pageIndex = g_classPages[sizeClass];
+	GLUSmemorypage* page;
+
+	void* block;
+
+	if (pageIndex < 0)
+	{
+		pageIndex = glusMemoryAllocatePages(1);
+
+		if (pageIndex < 0)
+		{
+			return 0;
+		}
 
-	// Calculate needed indecies.
-	size_t lengthIndices = size % GLUS_MEMORY_DATA_SIZE == 0 ? (size / GLUS_MEMORY_DATA_SIZE) : (size / GLUS_MEMORY_DATA_SIZE + 1);
+		page = &g_pages[pageIndex];
 
-	size_t alignmentIndicesRest = lengthIndices % GLUS_MEMORY_DATAT_ALIGNMENT_FACTOR;
+		page->state = GLUS_MEMORY_PAGE_CLASS;
+		page->sizeClass = (GLUSubyte)sizeClass;
+		page->freeBlocks = 0;
+		page->unusedOffset = 0;
+		page->usedBlocks = 0;
 
-	// Needed for overflow of lengthIndices.
-	if (lengthIndices * GLUS_MEMORY_DATA_SIZE < size)
+		glusMemoryLinkClassPage(pageIndex);
+	}
+
+	page = &g_pages[pageIndex];
+
+	// Reuse freed blocks first, then take from the never used part of the page.
+
+	if (page->freeBlocks)
+	{
+		block = page->freeBlocks;
+
+		page->freeBlocks = *(void**)block;
+	}
+	else
 	{
-		return 0;
+		block = g_poolData + (size_t)pageIndex * GLUS_MEMORY_PAGE_SIZE + page->unusedOffset;
+
+		page->unusedOffset += (GLUSuint)g_classSizes[sizeClass];
 	}
 
-	// Test an adjust alignment.
-	if (alignmentIndicesRest != 0)
+	page->usedBlocks++;
+
+	if (!page->freeBlocks && page->unusedOffset + g_classSizes[sizeClass] > GLUS_MEMORY_PAGE_SIZE)
 	{
-	    lengthIndices += GLUS_MEMORY_DATAT_ALIGNMENT_FACTOR - alignmentIndicesRest;
+		glusMemoryUnlinkClassPage(pageIndex);
 	}
 
-	while (tableIndex < g_memoryTableEntries)
+	return block;
+}
+
+static GLUSvoid glusMemoryFreeBlock(void* block, GLUSint pageIndex)
+{
+	GLUSmemorypage* page = &g_pages[pageIndex];
+
+	GLUSboolean full = !page->freeBlocks && page->unusedOffset + g_classSizes[page->sizeClass] > GLUS_MEMORY_PAGE_SIZE;
+
+	*(void**)block = page->freeBlocks;
+	page->freeBlocks = block;
+
+	page->usedBlocks--;
+
+	if (page->usedBlocks == 0)
 	{
-		// Search for a memory table entry, where the size fits in.
-		if (g_memoryTable[tableIndex].status == GLUS_VALID_AND_FREE && g_memoryTable[tableIndex].lengthIndices >= lengthIndices)
+		// Empty pages are given back, so they can be used by other size classes.
+
+		if (!full)
 		{
-		    // Is a split needed?
-		    if (lengthIndices < g_memoryTable[tableIndex].lengthIndices)
-		    {
-                // Assign the rest of the available memory to another table entry.
-                if (!glusMemoryInitTableEntry(g_memoryTable[tableIndex].startIndex + lengthIndices, g_memoryTable[tableIndex].lengthIndices - lengthIndices))
-                {
-                    // No empty entry could be found, so do not split and use all memory.
-                    lengthIndices = g_memoryTable[tableIndex].lengthIndices;
-                }
-		    }
-
-			// Entry now manages the requested memory.
-			g_memoryTable[tableIndex].status = GLUS_VALID_AND_LOCKED;
-			g_memoryTable[tableIndex].lengthIndices = lengthIndices;
-
-			return (void*)&g_memory[g_memoryTable[tableIndex].startIndex];
+			glusMemoryUnlinkClassPage(pageIndex);
 		}
 
-		tableIndex++;
+		g_pages[pageIndex].runLength = 1;
+
+		glusMemoryFreePages(pageIndex);
+	}
+	else if (full)
+	{
+		glusMemoryLinkClassPage(pageIndex);
 	}
+}
+
+static GLUSint glusMemoryGetBatch(GLUSint sizeClass)
+{
+	GLUSint batch = (GLUSint)(GLUS_MEMORY_BATCH_SIZE / g_classSizes[sizeClass]);
+
+	return batch < GLUS_MEMORY_MIN_BATCH ? GLUS_MEMORY_MIN_BATCH : (batch > GLUS_MEMORY_MAX_BATCH ? GLUS_MEMORY_MAX_BATCH : batch);
+}
+
+static GLUSvoid glusMemoryFlushCache(GLUSint sizeClass, GLUSint numberBlocks)
+{
+	void* block;
+
+	while (numberBlocks > 0 && g_cache.blocks[sizeClass])
+	{
+		block = g_cache.blocks[sizeClass];
+
+		g_cache.blocks[sizeClass] = *(void**)block;
+		g_cache.numberBlocks[sizeClass]--;
 
-	return 0;
+		glusMemoryFreeBlock(block, (GLUSint)(((GLUSubyte*)block - g_poolData) / GLUS_MEMORY_PAGE_SIZE));
+
+		numberBlocks--;
+	}
 }
 
-//
+static GLUSvoid glusMemoryCheckCache(GLUSvoid)
+{
+	GLUSint i;
+
+	// Blocks of a previous pool are not valid anymore.
+
+	if (g_cache.generation != g_generation)
+	{
+		for (i = 0; i < GLUS_MEMORY_CLASSES; i++)
+		{
+			g_cache.blocks[i] = 0;
+			g_cache.numberBlocks[i] = 0;
+		}
+
+		g_cache.generation = g_generation;
+	}
+}
+
+GLUSvoid _glusMemoryFlushThreadCache(GLUSvoid)
+{
+	GLUSint i;
+
+	glusMemoryCheckCache();
+
+	glusMemoryLock();
+
+	for (i = 0; i < GLUS_MEMORY_CLASSES; i++)
+	{
+		glusMemoryFlushCache(i, g_cache.numberBlocks[i]);
+	}
+
+	glusMemoryUnlock();
+}
 
 void* GLUSAPIENTRY glusMemoryMalloc(size_t size)
 {
 	void* pointer = 0;
 
+	GLUSint sizeClass, i, batch, start;
+
 	if (size == 0)
 	{
 		return pointer;
 	}
 
-	pointer = glusMemoryInternalMalloc(size);
+	if (size > GLUS_MEMORY_MAX_CLASS_SIZE)
+	{
+		if (size > (size_t)INT32_MAX - GLUS_MEMORY_PAGE_SIZE)
+		{
+			return pointer;
+		}
+
+		glusMemoryLock();
 
-	// If no memory was allocated ...
-	if (!pointer)
+		if (!g_pages)
+		{
+			glusMemoryInit(g_memory, GLUS_MEMORY_SIZE);
+		}
+
+		start = glusMemoryAllocatePages((GLUSint)((size + GLUS_MEMORY_PAGE_SIZE - 1) / GLUS_MEMORY_PAGE_SIZE));
+
+		if (start >= 0)
+		{
+			g_pages[start].state = GLUS_MEMORY_PAGE_LARGE;
+			g_pages[start + g_pages[start].runLength - 1].state = GLUS_MEMORY_PAGE_LARGE;
+
+			pointer = g_poolData + (size_t)start * GLUS_MEMORY_PAGE_SIZE;
+
+			glusMemoryCount((GLUSint64)g_pages[start].runLength * GLUS_MEMORY_PAGE_SIZE);
+		}
+
+		glusMemoryUnlock();
+
+		return pointer;
+	}
+
+	sizeClass = glusMemoryGetSizeClass(size);
+
+	glusMemoryCheckCache();
+
+	// Refill the thread cache from the pool.
+
+	if (!g_cache.blocks[sizeClass])
 	{
-		// ... do garbage collection ...
-		glusMemoryGarbageCollect();
+		glusMemoryLock();
+
+		if (!g_pages)
+		{
+			glusMemoryInit(g_memory, GLUS_MEMORY_SIZE);
+
+			glusMemoryCheckCache();
+		}
+
+		batch = glusMemoryGetBatch(sizeClass);
+
+		for (i = 0; i < batch; i++)
+		{
+			pointer = glusMemoryAllocateBlock(sizeClass);
+
+			if (!pointer)
+			{
+				break;
+			}
+
+			*(void**)pointer = g_cache.blocks[sizeClass];
+			g_cache.blocks[sizeClass] = pointer;
+			g_cache.numberBlocks[sizeClass]++;
+		}
+
+		glusMemoryUnlock();
 
-		// ... and try to allocate again.
-		pointer = glusMemoryInternalMalloc(size);
+		if (!g_cache.blocks[sizeClass])
+		{
+			return 0;
+		}
 	}
 
+	pointer = g_cache.blocks[sizeClass];
+
+	g_cache.blocks[sizeClass] = *(void**)pointer;
+	g_cache.numberBlocks[sizeClass]--;
+
+	glusMemoryCount((GLUSint64)g_classSizes[sizeClass]);
+
 	return pointer;
 }
 
 void GLUSAPIENTRY glusMemoryFree(void* pointer)
 {
-	GLUSuint tableIndex = 0;
+	GLUSint pageIndex, sizeClass;
 
-	if (!pointer)
+	// Ignore memory, which is not from the pool.
+	if (!pointer || !g_pages || (GLUSubyte*)pointer < g_poolData || (GLUSubyte*)pointer >= g_poolData + g_poolSize)
 	{
 		return;
 	}
 
-	// Search pointer ...
-	while (tableIndex < g_memoryTableEntries)
+	pageIndex = (GLUSint)(((GLUSubyte*)pointer - g_poolData) / GLUS_MEMORY_PAGE_SIZE);
+
+	if (g_pages[pageIndex].state == GLUS_MEMORY_PAGE_LARGE)
 	{
-		// ... and free memory by setting flag in table entry.
-		if (g_memoryTable[tableIndex].status == GLUS_VALID_AND_LOCKED && (void*)&g_memory[g_memoryTable[tableIndex].startIndex] == pointer)
+		if ((GLUSubyte*)pointer != g_poolData + (size_t)pageIndex * GLUS_MEMORY_PAGE_SIZE)
 		{
-			g_memoryTable[tableIndex].status = GLUS_VALID_AND_FREE;
-
 			return;
 		}
 
-		tableIndex++;
+		glusMemoryLock();
+
+		glusMemoryCount(-(GLUSint64)g_pages[pageIndex].runLength * GLUS_MEMORY_PAGE_SIZE);
+
+		glusMemoryFreePages(pageIndex);
+
+		glusMemoryUnlock();
+
+		return;
+	}
+
+	if (g_pages[pageIndex].state != GLUS_MEMORY_PAGE_CLASS)
+	{
+		return;
+	}
+
+	sizeClass = g_pages[pageIndex].sizeClass;
+
+	glusMemoryCount(-(GLUSint64)g_classSizes[sizeClass]);
+
+	glusMemoryCheckCache();
+
+	*(void**)pointer = g_cache.blocks[sizeClass];
+	g_cache.blocks[sizeClass] = pointer;
+	g_cache.numberBlocks[sizeClass]++;
+
+	// If the thread cache grows too large, half of it is given back.
+
+	if (g_cache.numberBlocks[sizeClass] > 2 * glusMemoryGetBatch(sizeClass))
+	{
+		glusMemoryLock();
+
+		glusMemoryFlushCache(sizeClass, glusMemoryGetBatch(sizeClass));
+
+		glusMemoryUnlock();
+	}
+}
+
+GLUSboolean GLUSAPIENTRY glusMemorySetPool(void* memory, size_t size)
+{
+	if (memory && size < GLUS_MEMORY_ALIGNMENT + sizeof(GLUSmemorypage) + GLUS_MEMORY_PAGE_SIZE)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Memory pool is too small");
+
+		return GLUS_FALSE;
 	}
+
+	_glusMemoryFlushThreadCache();
+
+	glusMemoryLock();
+
+	if (g_committedPages > 0)
+	{
+		glusMemoryUnlock();
+
+		glusLogPrint(GLUS_LOG_ERROR, "Memory pool can not be changed, as memory is still in use");
+
+		return GLUS_FALSE;
+	}
+
+	if (memory)
+	{
+		glusMemoryInit((GLUSubyte*)memory, size);
+	}
+	else
+	{
+		glusMemoryInit(g_memory, GLUS_MEMORY_SIZE);
+	}
+
+	g_peakBytesInUse = 0;
+
+	glusMemoryUnlock();
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusMemoryGetStats(GLUSmemorystats* stats)
+{
+	GLUSint i, start, largestRun = 0;
+
+	size_t freeBytes;
+
+	if (!stats)
+	{
+		return GLUS_FALSE;
+	}
+
+	glusMemoryLock();
+
+	if (!g_pages)
+	{
+		glusMemoryInit(g_memory, GLUS_MEMORY_SIZE);
+	}
+
+	// The largest run is in the highest non empty bin.
+
+	for (i = GLUS_MEMORY_BINS - 1; i >= 0 && largestRun == 0; i--)
+	{
+		for (start = g_freeRuns[i]; start >= 0; start = g_pages[start].next)
+		{
+			if (g_pages[start].runLength > largestRun)
+			{
+				largestRun = g_pages[start].runLength;
+			}
+		}
+	}
+
+	stats->poolSize = g_poolSize;
+	stats->bytesCommitted = (size_t)g_committedPages * GLUS_MEMORY_PAGE_SIZE;
+	stats->largestFreeBlock = (size_t)largestRun * GLUS_MEMORY_PAGE_SIZE;
+
+	glusMemoryUnlock();
+
+	stats->bytesInUse = (size_t)g_bytesInUse;
+	stats->peakBytesInUse = (size_t)g_peakBytesInUse;
+
+	freeBytes = stats->poolSize - stats->bytesCommitted;
+
+	stats->fragmentation = freeBytes > 0 ? 1.0f - (GLUSfloat)stats->largestFreeBlock / (GLUSfloat)freeBytes : 0.0f;
+
+	return GLUS_TRUE;
 }
@@ -0,0 +1,983 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+#define GLUS_MESH_VERSION 3
+
+#define GLUS_MESH_HEADER_SIZE 56
+
+#define GLUS_MESH_VERTICES      0x01
+#define GLUS_MESH_NORMALS       0x02
+#define GLUS_MESH_TANGENTS      0x04
+#define GLUS_MESH_BITANGENTS    0x08
+#define GLUS_MESH_TEXCOORDS     0x10
+#define GLUS_MESH_ALLATTRIBUTES 0x20
+#define GLUS_MESH_INDICES       0x40
+
+// vertex, normal, tangent, bitangent, texCoords
+#define GLUS_MESH_ALLATTRIBUTES_STRIDE (4 + 3 + 3 + 3 + 2)
+
+extern GLUSboolean _glusFileMap(const GLUSchar* filename, GLUSubyte** data, size_t* length);
+extern GLUSvoid _glusFileUnmap(GLUSubyte* data, size_t length);
+extern GLUSboolean _glusFileGetStamp(const GLUSchar* filename, GLUSuint64* modificationTime, GLUSuint64* size);
+
+extern GLUSboolean _glusWavefrontParseMaterialLibraries(const GLUSubyte* data, size_t length, GLUSboolean (*function)(GLUSvoid* userData, const GLUSchar* filename), GLUSvoid* userData);
+
+static const GLUSchar g_meshMagic[8] = { 'G', 'L', 'U', 'S', 'M', 'E', 'S', 'H' };
+
+/**
+ * Stream over the mesh data. If no data is set while writing, only the length is calculated.
+ */
+typedef struct _GLUSmeshstream
+{
+	GLUSubyte* data;
+
+	size_t position;
+
+	size_t length;
+
+} GLUSmeshstream;
+
+static GLUSuint glusMeshChecksum(const GLUSubyte* data, size_t length)
+{
+	size_t i;
+
+	// FNV-1a
+	GLUSuint checksum = 2166136261u;
+
+	for (i = 0; i < length; i++)
+	{
+		checksum = (checksum ^ data[i]) * 16777619u;
+	}
+
+	return checksum;
+}
+
+/**
+ * Files referenced by the source file, which are written before the shape or scene.
+ */
+typedef struct _GLUSmeshdependencies
+{
+	GLUSmeshstream* stream;
+
+	GLUSuint number;
+
+} GLUSmeshdependencies;
+
+static GLUSvoid glusMeshWrite(GLUSmeshstream* stream, const GLUSvoid* values, size_t size)
+{
+	if (stream->data && size > 0)
+	{
+		memcpy(stream->data + stream->position, values, size);
+	}
+
+	stream->position += size;
+}
+
+static GLUSvoid glusMeshWriteUint(GLUSmeshstream* stream, GLUSuint value)
+{
+	glusMeshWrite(stream, &value, sizeof(GLUSuint));
+}
+
+static GLUSboolean glusMeshRead(GLUSmeshstream* stream, GLUSvoid* values, size_t size)
+{
+	if (size > stream->length - stream->position)
+	{
+		return GLUS_FALSE;
+	}
+
+	memcpy(values, stream->data + stream->position, size);
+
+	stream->position += size;
+
+	return GLUS_TRUE;
+}
+
+static GLUSboolean glusMeshReadUint(GLUSmeshstream* stream, GLUSuint* value)
+{
+	return glusMeshRead(stream, value, sizeof(GLUSuint));
+}
+
+/**
+ * Reads an array into newly allocated memory. Nothing is allocated for an empty array.
+ */
+static GLUSboolean glusMeshReadArray(GLUSmeshstream* stream, GLUSvoid** values, GLUSuint count, size_t elementSize)
+{
+	*values = 0;
+
+	if (count == 0)
+	{
+		return GLUS_TRUE;
+	}
+
+	if ((size_t)count > (stream->length - stream->position) / elementSize)
+	{
+		return GLUS_FALSE;
+	}
+
+	*values = glusMemoryMalloc((size_t)count * elementSize);
+
+	if (!*values)
+	{
+		return GLUS_FALSE;
+	}
+
+	return glusMeshRead(stream, *values, (size_t)count * elementSize);
+}
+
+//
+
+static GLUSvoid glusMeshWriteShape(GLUSmeshstream* stream, const GLUSshape* shape)
+{
+	GLUSuint flags = 0;
+
+	flags |= shape->vertices ? GLUS_MESH_VERTICES : 0;
+	flags |= shape->normals ? GLUS_MESH_NORMALS : 0;
+	flags |= shape->tangents ? GLUS_MESH_TANGENTS : 0;
+	flags |= shape->bitangents ? GLUS_MESH_BITANGENTS : 0;
+	flags |= shape->texCoords ? GLUS_MESH_TEXCOORDS : 0;
+	flags |= shape->allAttributes ? GLUS_MESH_ALLATTRIBUTES : 0;
+	flags |= shape->indices ? GLUS_MESH_INDICES : 0;
+
+	glusMeshWriteUint(stream, shape->numberVertices);
+	glusMeshWriteUint(stream, shape->numberIndices);
+	glusMeshWriteUint(stream, shape->mode);
+	glusMeshWriteUint(stream, flags);
+
+	if (shape->vertices)
+	{
+		glusMeshWrite(stream, shape->vertices, shape->numberVertices * 4 * sizeof(GLUSfloat));
+	}
+	if (shape->normals)
+	{
+		glusMeshWrite(stream, shape->normals, shape->numberVertices * 3 * sizeof(GLUSfloat));
+	}
+	if (shape->tangents)
+	{
+		glusMeshWrite(stream, shape->tangents, shape->numberVertices * 3 * sizeof(GLUSfloat));
+	}
+	if (shape->bitangents)
+	{
+		glusMeshWrite(stream, shape->bitangents, shape->numberVertices * 3 * sizeof(GLUSfloat));
+	}
+	if (shape->texCoords)
+	{
+		glusMeshWrite(stream, shape->texCoords, shape->numberVertices * 2 * sizeof(GLUSfloat));
+	}
+	if (shape->allAttributes)
+	{
+		glusMeshWrite(stream, shape->allAttributes, shape->numberVertices * GLUS_MESH_ALLATTRIBUTES_STRIDE * sizeof(GLUSfloat));
+	}
+	if (shape->indices)
+	{
+		glusMeshWrite(stream, shape->indices, shape->numberIndices * sizeof(GLUSindex));
+	}
+}
+
+static GLUSboolean glusMeshReadShape(GLUSmeshstream* stream, GLUSshape* shape)
+{
+	GLUSuint flags;
+
+	memset(shape, 0, sizeof(GLUSshape));
+
+	if (!glusMeshReadUint(stream, &shape->numberVertices) || !glusMeshReadUint(stream, &shape->numberIndices) || !glusMeshReadUint(stream, &shape->mode) || !glusMeshReadUint(stream, &flags))
+	{
+		return GLUS_FALSE;
+	}
+
+	if ((flags & GLUS_MESH_VERTICES) && !glusMeshReadArray(stream, (GLUSvoid**)&shape->vertices, shape->numberVertices, 4 * sizeof(GLUSfloat)))
+	{
+		return GLUS_FALSE;
+	}
+	if ((flags & GLUS_MESH_NORMALS) && !glusMeshReadArray(stream, (GLUSvoid**)&shape->normals, shape->numberVertices, 3 * sizeof(GLUSfloat)))
+	{
+		return GLUS_FALSE;
+	}
+	if ((flags & GLUS_MESH_TANGENTS) && !glusMeshReadArray(stream, (GLUSvoid**)&shape->tangents, shape->numberVertices, 3 * sizeof(GLUSfloat)))
+	{
+		return GLUS_FALSE;
+	}
+	if ((flags & GLUS_MESH_BITANGENTS) && !glusMeshReadArray(stream, (GLUSvoid**)&shape->bitangents, shape->numberVertices, 3 * sizeof(GLUSfloat)))
+	{
+		return GLUS_FALSE;
+	}
+	if ((flags & GLUS_MESH_TEXCOORDS) && !glusMeshReadArray(stream, (GLUSvoid**)&shape->texCoords, shape->numberVertices, 2 * sizeof(GLUSfloat)))
+	{
+		return GLUS_FALSE;
+	}
+	if ((flags & GLUS_MESH_ALLATTRIBUTES) && !glusMeshReadArray(stream, (GLUSvoid**)&shape->allAttributes, shape->numberVertices, GLUS_MESH_ALLATTRIBUTES_STRIDE * sizeof(GLUSfloat)))
+	{
+		return GLUS_FALSE;
+	}
+	if ((flags & GLUS_MESH_INDICES) && !glusMeshReadArray(stream, (GLUSvoid**)&shape->indices, shape->numberIndices, sizeof(GLUSindex)))
+	{
+		return GLUS_FALSE;
+	}
+
+	return GLUS_TRUE;
+}
+
+static GLUSvoid glusMeshWriteScene(GLUSmeshstream* stream, const GLUSscene* scene)
+{
+	GLUSuint flags, numberMaterials, numberObjects, numberGroups;
+
+	GLUSmaterialList* materialWalker;
+	GLUSobjectList* objectWalker;
+	GLUSgroupList* groupWalker;
+
+	GLUSmaterial material;
+
+	// All objects share the materials of the first object.
+
+	numberMaterials = 0;
+	materialWalker = scene->objectList ? scene->objectList->object.materials : 0;
+	while (materialWalker)
+	{
+		numberMaterials++;
+
+		materialWalker = materialWalker->next;
+	}
+
+	glusMeshWriteUint(stream, numberMaterials);
+
+	materialWalker = scene->objectList ? scene->objectList->object.materials : 0;
+	while (materialWalker)
+	{
+		memcpy(&material, &materialWalker->material, sizeof(GLUSmaterial));
+
+		// Texture names are only valid for the current context.
+		material.emissiveTextureName = 0;
+		material.ambientTextureName = 0;
+		material.diffuseTextureName = 0;
+		material.specularTextureName = 0;
+		material.transparencyTextureName = 0;
+		material.bumpTextureName = 0;
+
+		glusMeshWrite(stream, &material, sizeof(GLUSmaterial));
+
+		materialWalker = materialWalker->next;
+	}
+
+	numberObjects = 0;
+	objectWalker = scene->objectList;
+	while (objectWalker)
+	{
+		numberObjects++;
+
+		objectWalker = objectWalker->next;
+	}
+
+	glusMeshWriteUint(stream, numberObjects);
+
+	objectWalker = scene->objectList;
+	while (objectWalker)
+	{
+		const GLUSwavefront* object = &objectWalker->object;
+
+		flags = 0;
+
+		flags |= object->vertices ? GLUS_MESH_VERTICES : 0;
+		flags |= object->normals ? GLUS_MESH_NORMALS : 0;
+		flags |= object->tangents ? GLUS_MESH_TANGENTS : 0;
+		flags |= object->bitangents ? GLUS_MESH_BITANGENTS : 0;
+		flags |= object->texCoords ? GLUS_MESH_TEXCOORDS : 0;
+
+		glusMeshWrite(stream, object->name, GLUS_MAX_STRING);
+		glusMeshWriteUint(stream, object->numberVertices);
+		glusMeshWriteUint(stream, flags);
+
+		if (object->vertices)
+		{
+			glusMeshWrite(stream, object->vertices, object->numberVertices * 4 * sizeof(GLUSfloat));
+		}
+		if (object->normals)
+		{
+			glusMeshWrite(stream, object->normals, object->numberVertices * 3 * sizeof(GLUSfloat));
+		}
+		if (object->tangents)
+		{
+			glusMeshWrite(stream, object->tangents, object->numberVertices * 3 * sizeof(GLUSfloat));
+		}
+		if (object->bitangents)
+		{
+			glusMeshWrite(stream, object->bitangents, object->numberVertices * 3 * sizeof(GLUSfloat));
+		}
+		if (object->texCoords)
+		{
+			glusMeshWrite(stream, object->texCoords, object->numberVertices * 2 * sizeof(GLUSfloat));
+		}
+
+		numberGroups = 0;
+		groupWalker = object->groups;
+		while (groupWalker)
+		{
+			numberGroups++;
+
+			groupWalker = groupWalker->next;
+		}
+
+		glusMeshWriteUint(stream, numberGroups);
+
+		groupWalker = object->groups;
+		while (groupWalker)
+		{
+			glusMeshWrite(stream, groupWalker->group.name, GLUS_MAX_STRING);
+			glusMeshWrite(stream, groupWalker->group.materialName, GLUS_MAX_STRING);
+			glusMeshWriteUint(stream, groupWalker->group.numberIndices);
+			glusMeshWriteUint(stream, groupWalker->group.mode);
+			glusMeshWrite(stream, groupWalker->group.indices, groupWalker->group.numberIndices * sizeof(GLUSindex));
+
+			groupWalker = groupWalker->next;
+		}
+
+		objectWalker = objectWalker->next;
+	}
+}
+
+static GLUSboolean glusMeshReadScene(GLUSmeshstream* stream, GLUSscene* scene)
+{
+	GLUSuint i, k, flags, numberMaterials, numberObjects, numberGroups;
+
+	GLUSmaterialList* materials = 0;
+	GLUSmaterialList* lastMaterial = 0;
+	GLUSmaterialList* materialWalker;
+
+	GLUSobjectList* lastObject = 0;
+
+	GLUSgroupList* lastGroup;
+
+	memset(scene, 0, sizeof(GLUSscene));
+
+	if (!glusMeshReadUint(stream, &numberMaterials))
+	{
+		return GLUS_FALSE;
+	}
+
+	for (i = 0; i < numberMaterials; i++)
+	{
+		GLUSmaterialList* newMaterial = (GLUSmaterialList*)glusMemoryMalloc(sizeof(GLUSmaterialList));
+
+		if (!newMaterial)
+		{
+			break;
+		}
+
+		memset(newMaterial, 0, sizeof(GLUSmaterialList));
+
+		if (lastMaterial)
+		{
+			lastMaterial->next = newMaterial;
+		}
+		else
+		{
+			materials = newMaterial;
+		}
+		lastMaterial = newMaterial;
+
+		if (!glusMeshRead(stream, &newMaterial->material, sizeof(GLUSmaterial)))
+		{
+			break;
+		}
+	}
+
+	if (i < numberMaterials || !glusMeshReadUint(stream, &numberObjects))
+	{
+		// Materials are freed together with the first object, so destroy them manually.
+		while (materials)
+		{
+			materialWalker = materials->next;
+
+			glusMemoryFree(materials);
+
+			materials = materialWalker;
+		}
+
+		return GLUS_FALSE;
+	}
+
+	// If the scene is empty, the materials are not referenced.
+	if (numberObjects == 0)
+	{
+		while (materials)
+		{
+			materialWalker = materials->next;
+
+			glusMemoryFree(materials);
+
+			materials = materialWalker;
+		}
+	}
+
+	for (i = 0; i < numberObjects; i++)
+	{
+		GLUSwavefront* object;
+
+		GLUSobjectList* newObject = (GLUSobjectList*)glusMemoryMalloc(sizeof(GLUSobjectList));
+
+		if (!newObject)
+		{
+			if (!scene->objectList)
+			{
+				// Keep the materials owned by the scene, so they are freed.
+				while (materials)
+				{
+					materialWalker = materials->next;
+
+					glusMemoryFree(materials);
+
+					materials = materialWalker;
+				}
+			}
+
+			return GLUS_FALSE;
+		}
+
+		memset(newObject, 0, sizeof(GLUSobjectList));
+
+		if (lastObject)
+		{
+			lastObject->next = newObject;
+		}
+		else
+		{
+			scene->objectList = newObject;
+		}
+		lastObject = newObject;
+
+		object = &newObject->object;
+
+		object->materials = materials;
+
+		if (!glusMeshRead(stream, object->name, GLUS_MAX_STRING) || !glusMeshReadUint(stream, &object->numberVertices) || !glusMeshReadUint(stream, &flags))
+		{
+			return GLUS_FALSE;
+		}
+
+		object->name[GLUS_MAX_STRING - 1] = 0;
+
+		if ((flags & GLUS_MESH_VERTICES) && !glusMeshReadArray(stream, (GLUSvoid**)&object->vertices, object->numberVertices, 4 * sizeof(GLUSfloat)))
+		{
+			return GLUS_FALSE;
+		}
+		if ((flags & GLUS_MESH_NORMALS) && !glusMeshReadArray(stream, (GLUSvoid**)&object->normals, object->numberVertices, 3 * sizeof(GLUSfloat)))
+		{
+			return GLUS_FALSE;
+		}
+		if ((flags & GLUS_MESH_TANGENTS) && !glusMeshReadArray(stream, (GLUSvoid**)&object->tangents, object->numberVertices, 3 * sizeof(GLUSfloat)))
+		{
+			return GLUS_FALSE;
+		}
+		if ((flags & GLUS_MESH_BITANGENTS) && !glusMeshReadArray(stream, (GLUSvoid**)&object->bitangents, object->numberVertices, 3 * sizeof(GLUSfloat)))
+		{
+			return GLUS_FALSE;
+		}
+		if ((flags & GLUS_MESH_TEXCOORDS) && !glusMeshReadArray(stream, (GLUSvoid**)&object->texCoords, object->numberVertices, 2 * sizeof(GLUSfloat)))
+		{
+			return GLUS_FALSE;
+		}
+
+		if (!glusMeshReadUint(stream, &numberGroups))
+		{
+			return GLUS_FALSE;
+		}
+
+		lastGroup = 0;
+
+		for (k = 0; k < numberGroups; k++)
+		{
+			GLUSgroupList* newGroup = (GLUSgroupList*)glusMemoryMalloc(sizeof(GLUSgroupList));
+
+			if (!newGroup)
+			{
+				return GLUS_FALSE;
+			}
+
+			memset(newGroup, 0, sizeof(GLUSgroupList));
+
+			if (lastGroup)
+			{
+				lastGroup->next = newGroup;
+			}
+			else
+			{
+				object->groups = newGroup;
+			}
+			lastGroup = newGroup;
+
+			if (!glusMeshRead(stream, newGroup->group.name, GLUS_MAX_STRING) || !glusMeshRead(stream, newGroup->group.materialName, GLUS_MAX_STRING) || !glusMeshReadUint(stream, &newGroup->group.numberIndices) || !glusMeshReadUint(stream, &newGroup->group.mode))
+			{
+				return GLUS_FALSE;
+			}
+
+			newGroup->group.name[GLUS_MAX_STRING - 1] = 0;
+			newGroup->group.materialName[GLUS_MAX_STRING - 1] = 0;
+
+			if (!glusMeshReadArray(stream, (GLUSvoid**)&newGroup->group.indices, newGroup->group.numberIndices, sizeof(GLUSindex)))
+			{
+				return GLUS_FALSE;
+			}
+
+			materialWalker = materials;
+			while (materialWalker)
+			{
+				if (strcmp(materialWalker->material.name, newGroup->group.materialName) == 0)
+				{
+					newGroup->group.material = &materialWalker->material;
+
+					break;
+				}
+
+				materialWalker = materialWalker->next;
+			}
+		}
+	}
+
+	return GLUS_TRUE;
+}
+
+//
+
+static GLUSboolean glusMeshWriteDependency(GLUSvoid* userData, const GLUSchar* filename)
+{
+	GLUSmeshdependencies* dependencies = (GLUSmeshdependencies*)userData;
+
+	GLUSuint64 modificationTime, size;
+
+	if (!_glusFileGetStamp(filename, &modificationTime, &size))
+	{
+		return GLUS_FALSE;
+	}
+
+	glusMeshWriteUint(dependencies->stream, (GLUSuint)strlen(filename));
+	glusMeshWrite(dependencies->stream, filename, strlen(filename));
+	glusMeshWrite(dependencies->stream, &modificationTime, sizeof(GLUSuint64));
+	glusMeshWrite(dependencies->stream, &size, sizeof(GLUSuint64));
+
+	dependencies->number++;
+
+	return GLUS_TRUE;
+}
+
+/**
+ * Only the stamps of the referenced files are compared, so the source files are not read while loading.
+ */
+static GLUSboolean glusMeshReadDependencies(GLUSmeshstream* stream, GLUSuint numberDependencies, GLUSboolean check)
+{
+	GLUSchar filename[GLUS_MAX_FILENAME];
+
+	GLUSuint i, filenameLength;
+	GLUSuint64 modificationTime, size, currentTime, currentSize;
+
+	for (i = 0; i < numberDependencies; i++)
+	{
+		if (!glusMeshReadUint(stream, &filenameLength) || filenameLength >= GLUS_MAX_FILENAME || !glusMeshRead(stream, filename, filenameLength) || !glusMeshRead(stream, &modificationTime, sizeof(GLUSuint64)) || !glusMeshRead(stream, &size, sizeof(GLUSuint64)))
+		{
+			return GLUS_FALSE;
+		}
+
+		filename[filenameLength] = '\0';
+
+		if (check && (!_glusFileGetStamp(filename, &currentTime, &currentSize) || currentTime != modificationTime || currentSize != size))
+		{
+			return GLUS_FALSE;
+		}
+	}
+
+	return GLUS_TRUE;
+}
+
+static GLUSboolean glusMeshSave(const GLUSchar* filename, GLUSuint type, const GLUSshape* shape, const GLUSscene* scene, const GLUSchar* sourceFilename)
+{
+	FILE* file;
+	size_t elementsWritten;
+
+	GLUSmeshstream stream;
+
+	GLUSmeshdependencies dependencies;
+
+	GLUSubyte* sourceData = 0;
+	size_t sourceLength = 0;
+
+	GLUSuint value, pass;
+	GLUSuint64 payloadLength;
+	GLUSuint64 sourceTime = 0;
+	GLUSuint64 sourceSize = 0;
+
+	if (sourceFilename && !_glusFileGetStamp(sourceFilename, &sourceTime, &sourceSize))
+	{
+		return GLUS_FALSE;
+	}
+
+	// Only scenes do load the materials, so only their material files are stamped. The source is only read here, not while loading.
+	if (sourceFilename && type == GLUS_MESH_SCENE && !_glusFileMap(sourceFilename, &sourceData, &sourceLength))
+	{
+		return GLUS_FALSE;
+	}
+
+	// First pass calculates the length, second pass writes the data.
+
+	memset(&stream, 0, sizeof(GLUSmeshstream));
+
+	dependencies.stream = &stream;
+
+	for (pass = 0; pass < 2; pass++)
+	{
+		if (pass == 1)
+		{
+			payloadLength = (GLUSuint64)stream.position;
+
+			stream.length = GLUS_MESH_HEADER_SIZE + stream.position;
+			stream.data = (GLUSubyte*)glusMemoryMalloc(stream.length);
+
+			if (!stream.data)
+			{
+				_glusFileUnmap(sourceData, sourceLength);
+
+				return GLUS_FALSE;
+			}
+
+			stream.position = GLUS_MESH_HEADER_SIZE;
+		}
+
+		dependencies.number = 0;
+
+		if (sourceData && !_glusWavefrontParseMaterialLibraries(sourceData, sourceLength, glusMeshWriteDependency, &dependencies))
+		{
+			glusMemoryFree(stream.data);
+
+			_glusFileUnmap(sourceData, sourceLength);
+
+			return GLUS_FALSE;
+		}
+
+		if (type == GLUS_MESH_SHAPE)
+		{
+			glusMeshWriteShape(&stream, shape);
+		}
+		else
+		{
+			glusMeshWriteScene(&stream, scene);
+		}
+	}
+
+	_glusFileUnmap(sourceData, sourceLength);
+
+	stream.position = 0;
+
+	glusMeshWrite(&stream, g_meshMagic, sizeof(g_meshMagic));
+	glusMeshWriteUint(&stream, GLUS_MESH_VERSION);
+	glusMeshWriteUint(&stream, type);
+	glusMeshWriteUint(&stream, (GLUSuint)sizeof(GLUSindex));
+	glusMeshWriteUint(&stream, (GLUSuint)sizeof(GLUSmaterial));
+	value = glusMeshChecksum(stream.data + GLUS_MESH_HEADER_SIZE, (size_t)payloadLength);
+	glusMeshWriteUint(&stream, value);
+	glusMeshWriteUint(&stream, dependencies.number);
+	glusMeshWrite(&stream, &payloadLength, sizeof(GLUSuint64));
+	glusMeshWrite(&stream, &sourceTime, sizeof(GLUSuint64));
+	glusMeshWrite(&stream, &sourceSize, sizeof(GLUSuint64));
+
+	file = glusFileOpen(filename, "wb");
+
+	if (!file)
+	{
+		glusMemoryFree(stream.data);
+
+		return GLUS_FALSE;
+	}
+
+	elementsWritten = fwrite(stream.data, 1, stream.length, file);
+
+	glusMemoryFree(stream.data);
+
+	if (elementsWritten < stream.length)
+	{
+		glusFileClose(file);
+
+		glusFileRemove(filename);
+
+		return GLUS_FALSE;
+	}
+
+	glusFileClose(file);
+
+	return GLUS_TRUE;
+}
+
+static GLUSboolean glusMeshLoad(const GLUSchar* filename, GLUSuint type, GLUSshape* shape, GLUSscene* scene, const GLUSchar* sourceFilename)
+{
+	GLUSubyte* data;
+	size_t length;
+
+	GLUSmeshstream stream;
+
+	GLUSchar magic[8];
+	GLUSuint version, fileType, indexSize, materialSize, checksum, numberDependencies;
+	GLUSuint64 payloadLength, sourceTime, sourceSize, currentTime, currentSize;
+
+	GLUSboolean result;
+
+	if (!filename)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (sourceFilename && !_glusFileGetStamp(sourceFilename, &currentTime, &currentSize))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!_glusFileMap(filename, &data, &length))
+	{
+		return GLUS_FALSE;
+	}
+
+	stream.data = data;
+	stream.position = 0;
+	stream.length = length;
+
+	if (!glusMeshRead(&stream, magic, sizeof(magic)) || !glusMeshReadUint(&stream, &version) || !glusMeshReadUint(&stream, &fileType) || !glusMeshReadUint(&stream, &indexSize) || !glusMeshReadUint(&stream, &materialSize) || !glusMeshReadUint(&stream, &checksum) || !glusMeshReadUint(&stream, &numberDependencies) || !glusMeshRead(&stream, &payloadLength, sizeof(GLUSuint64)) || !glusMeshRead(&stream, &sourceTime, sizeof(GLUSuint64)) || !glusMeshRead(&stream, &sourceSize, sizeof(GLUSuint64)))
+	{
+		_glusFileUnmap(data, length);
+
+		return GLUS_FALSE;
+	}
+
+	if (memcmp(magic, g_meshMagic, sizeof(g_meshMagic)) != 0 || version != GLUS_MESH_VERSION || fileType != type || indexSize != sizeof(GLUSindex) || materialSize != sizeof(GLUSmaterial) || payloadLength != (GLUSuint64)(length - GLUS_MESH_HEADER_SIZE))
+	{
+		_glusFileUnmap(data, length);
+
+		return GLUS_FALSE;
+	}
+
+	if (sourceFilename && (sourceTime != currentTime || sourceSize != currentSize))
+	{
+		_glusFileUnmap(data, length);
+
+		return GLUS_FALSE;
+	}
+
+	if (!glusMeshReadDependencies(&stream, numberDependencies, sourceFilename != 0))
+	{
+		_glusFileUnmap(data, length);
+
+		return GLUS_FALSE;
+	}
+
+	if (glusMeshChecksum(data + GLUS_MESH_HEADER_SIZE, (size_t)payloadLength) != checksum)
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Mesh file corrupted: %s", filename);
+
+		_glusFileUnmap(data, length);
+
+		return GLUS_FALSE;
+	}
+
+	if (type == GLUS_MESH_SHAPE)
+	{
+		result = glusMeshReadShape(&stream, shape);
+
+		if (!result)
+		{
+			glusShapeDestroyf(shape);
+		}
+	}
+	else
+	{
+		result = glusMeshReadScene(&stream, scene);
+
+		if (!result)
+		{
+			glusWavefrontDestroyScene(scene);
+		}
+	}
+
+	_glusFileUnmap(data, length);
+
+	return result;
+}
+
+static GLUSboolean glusMeshCreateFilename(GLUSchar* meshFilename, const GLUSchar* filename, const GLUSchar* extension)
+{
+	if (!filename || strlen(filename) + strlen(extension) >= GLUS_MAX_FILENAME)
+	{
+		return GLUS_FALSE;
+	}
+
+	strcpy(meshFilename, filename);
+	strcat(meshFilename, extension);
+
+	return GLUS_TRUE;
+}
+
+//
+
+GLUSboolean GLUSAPIENTRY glusMeshSaveShape(const GLUSchar* filename, const GLUSshape* shape, const GLUSchar* sourceFilename)
+{
+	if (!filename || !shape)
+	{
+		return GLUS_FALSE;
+	}
+
+	return glusMeshSave(filename, GLUS_MESH_SHAPE, shape, 0, sourceFilename);
+}
+
+GLUSboolean GLUSAPIENTRY glusMeshLoadShape(const GLUSchar* filename, GLUSshape* shape, const GLUSchar* sourceFilename)
+{
+	GLUSboolean result;
+
+	if (!shape)
+	{
+		return GLUS_FALSE;
+	}
+
+	memset(shape, 0, sizeof(GLUSshape));
+
+	GLUS_PROFILE_BEGIN("glusMeshLoadShape");
+
+	result = glusMeshLoad(filename, GLUS_MESH_SHAPE, shape, 0, sourceFilename);
+
+	GLUS_PROFILE_END();
+
+	return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusMeshSaveScene(const GLUSchar* filename, const GLUSscene* scene, const GLUSchar* sourceFilename)
+{
+	if (!filename || !scene)
+	{
+		return GLUS_FALSE;
+	}
+
+	return glusMeshSave(filename, GLUS_MESH_SCENE, 0, scene, sourceFilename);
+}
+
+GLUSboolean GLUSAPIENTRY glusMeshLoadScene(const GLUSchar* filename, GLUSscene* scene, const GLUSchar* sourceFilename)
+{
+	GLUSboolean result;
+
+	if (!scene)
+	{
+		return GLUS_FALSE;
+	}
+
+	memset(scene, 0, sizeof(GLUSscene));
+
+	GLUS_PROFILE_BEGIN("glusMeshLoadScene");
+
+	result = glusMeshLoad(filename, GLUS_MESH_SCENE, 0, scene, sourceFilename);
+
+	GLUS_PROFILE_END();
+
+	return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusMeshConvertWavefront(const GLUSchar* wavefrontFilename, const GLUSchar* meshFilename, const GLUSenum type)
+{
+	GLUSboolean result;
+
+	GLUSshape shape;
+	GLUSscene scene;
+
+	if (!wavefrontFilename || !meshFilename)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (type == GLUS_MESH_SHAPE)
+	{
+		if (!glusShapeLoadWavefront(wavefrontFilename, &shape))
+		{
+			return GLUS_FALSE;
+		}
+
+		result = glusMeshSaveShape(meshFilename, &shape, wavefrontFilename);
+
+		glusShapeDestroyf(&shape);
+
+		return result;
+	}
+	else if (type == GLUS_MESH_SCENE)
+	{
+		if (!glusWavefrontLoadScene(wavefrontFilename, &scene))
+		{
+			return GLUS_FALSE;
+		}
+
+		result = glusMeshSaveScene(meshFilename, &scene, wavefrontFilename);
+
+		glusWavefrontDestroyScene(&scene);
+
+		return result;
+	}
+
+	return GLUS_FALSE;
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeLoadWavefrontCached(const GLUSchar* filename, GLUSshape* shape)
+{
+	GLUSchar meshFilename[GLUS_MAX_FILENAME];
+
+	if (!glusMeshCreateFilename(meshFilename, filename, ".shape.glusmesh") || !shape)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (glusMeshLoadShape(meshFilename, shape, filename))
+	{
+		return GLUS_TRUE;
+	}
+
+	if (!glusShapeLoadWavefront(filename, shape))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!glusMeshSaveShape(meshFilename, shape, filename))
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Could not save mesh file: %s", meshFilename);
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusWavefrontLoadSceneCached(const GLUSchar* filename, GLUSscene* scene)
+{
+	GLUSchar meshFilename[GLUS_MAX_FILENAME];
+
+	if (!glusMeshCreateFilename(meshFilename, filename, ".scene.glusmesh") || !scene)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (glusMeshLoadScene(meshFilename, scene, filename))
+	{
+		return GLUS_TRUE;
+	}
+
+	if (!glusWavefrontLoadScene(filename, scene))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!glusMeshSaveScene(meshFilename, scene, filename))
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Could not save mesh file: %s", meshFilename);
+	}
+
+	return GLUS_TRUE;
+}
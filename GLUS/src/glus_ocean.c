@@ -0,0 +1,346 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+#define GLUS_OCEAN_GRAVITY 9.81f
+
+extern GLUSboolean _glusThreadRunTiles(const GLUSint numberTiles, const GLUSint numberThreads, GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile), GLUSvoid* data);
+
+extern GLUSdouble _glusThreadGetRawTime(GLUSvoid);
+
+typedef struct _GLUSoceanwork
+{
+	GLUSocean* ocean;
+
+	GLUSfloat totalTime;
+
+} GLUSoceanwork;
+
+static GLUSfloat glusOceanPhillipsSpectrum(const GLUSfloat A, const GLUSfloat L, const GLUSfloat waveDirection[2], const GLUSfloat windDirection[2])
+{
+	GLUSfloat k = glusVector2Lengthf(waveDirection);
+	GLUSfloat waveDotWind = glusVector2Dotf(waveDirection, windDirection);
+
+	// Avoid division by zero.
+	if (L == 0.0f || k == 0.0f)
+	{
+		return 0.0f;
+	}
+
+	return A * expf(-1.0f / (k * L * k * L)) / (k * k * k * k) * waveDotWind * waveDotWind;
+}
+
+/**
+ * h(k, t) = h0(k) * e^(i * omega * t) + h0(-k) * e^(i * omega * t), per row.
+ */
+static GLUSvoid glusOceanSpectrumRow(GLUSvoid* data, const GLUSint tile)
+{
+	const GLUSoceanwork* work = (const GLUSoceanwork*)data;
+	const GLUSocean* ocean = work->ocean;
+
+	GLUSint x, index;
+	GLUSfloat wkTime, cosWkTime, sinWkTime;
+
+	index = tile * ocean->n;
+
+	for (x = 0; x < ocean->n; x++, index++)
+	{
+		wkTime = ocean->omega[index] * work->totalTime;
+
+		cosWkTime = cosf(wkTime);
+		sinWkTime = sinf(wkTime);
+
+		ocean->real[index] = ocean->h0SumReal[index] * cosWkTime - ocean->h0SumImaginary[index] * sinWkTime;
+		ocean->imaginary[index] = ocean->h0SumReal[index] * sinWkTime + ocean->h0SumImaginary[index] * cosWkTime;
+	}
+}
+
+/**
+ * Height out of the inverse transform. The sign alternates per grid point, as the spectrum is centered.
+ */
+static GLUSfloat glusOceanHeight(const GLUSocean* ocean, GLUSint x, GLUSint y)
+{
+	x = x < 0 ? 0 : (x >= ocean->n ? ocean->n - 1 : x);
+	y = y < 0 ? 0 : (y >= ocean->n ? ocean->n - 1 : y);
+
+	return ((x + y) & 1) ? ocean->real[y * ocean->n + x] : -ocean->real[y * ocean->n + x];
+}
+
+static GLUSvoid glusOceanAddNormal(GLUSfloat normal[3], const GLUSfloat tangent[3], const GLUSfloat bitangent[3])
+{
+	GLUSfloat cross[3];
+
+	// Tangent and bitangent do not have to be normalized, as the cross product is.
+	glusVector3Crossf(cross, tangent, bitangent);
+	glusVector3Normalizef(cross);
+
+	normal[0] += cross[0];
+	normal[1] += cross[1];
+	normal[2] += cross[2];
+}
+
+/**
+ * Displacement and normal per row. The normal is averaged out of a horizontal/vertical and a diagonal sampling.
+ */
+static GLUSvoid glusOceanNormalRow(GLUSvoid* data, const GLUSint tile)
+{
+	const GLUSoceanwork* work = (const GLUSoceanwork*)data;
+	const GLUSocean* ocean = work->ocean;
+
+	const GLUSfloat vertexStep = ocean->length / (GLUSfloat)(ocean->n - 1);
+	const GLUSfloat diagonalVertexStep = sqrtf(vertexStep * vertexStep * 2.0f);
+
+	GLUSfloat tangent[3], bitangent[3];
+	GLUSfloat* normal;
+
+	GLUSint x;
+	GLUSint y = tile;
+
+	for (x = 0; x < ocean->n; x++)
+	{
+		normal = &ocean->normal.data[(y * ocean->n + x) * 3];
+
+		normal[0] = 0.0f;
+		normal[1] = 0.0f;
+		normal[2] = 0.0f;
+
+		tangent[0] = 2.0f * vertexStep;
+		tangent[1] = glusOceanHeight(ocean, x + 1, y) - glusOceanHeight(ocean, x - 1, y);
+		tangent[2] = 0.0f;
+
+		bitangent[0] = 0.0f;
+		bitangent[1] = glusOceanHeight(ocean, x, y + 1) - glusOceanHeight(ocean, x, y - 1);
+		bitangent[2] = -2.0f * vertexStep;
+
+		glusOceanAddNormal(normal, tangent, bitangent);
+
+		tangent[0] = 2.0f * diagonalVertexStep;
+		tangent[1] = glusOceanHeight(ocean, x + 1, y - 1) - glusOceanHeight(ocean, x - 1, y + 1);
+		tangent[2] = 2.0f * diagonalVertexStep;
+
+		bitangent[0] = 2.0f * diagonalVertexStep;
+		bitangent[1] = glusOceanHeight(ocean, x + 1, y + 1) - glusOceanHeight(ocean, x - 1, y - 1);
+		bitangent[2] = -2.0f * diagonalVertexStep;
+
+		glusOceanAddNormal(normal, tangent, bitangent);
+
+		glusVector3Normalizef(normal);
+
+		ocean->displacement.data[y * ocean->n + x] = glusOceanHeight(ocean, x, y);
+	}
+}
+
+GLUSboolean GLUSAPIENTRY glusOceanCreate(GLUSocean* ocean, const GLUSint n, const GLUSfloat length, const GLUSfloat amplitude, const GLUSfloat windSpeed, const GLUSfloat windDirection[2], const GLUSint numberThreads)
+{
+	GLUSfloat normalizedWindDirection[2];
+	GLUSfloat waveDirection[2];
+	GLUSfloat phillipsSpectrumValue;
+
+	GLUSint x, y, index, negativeIndex;
+
+	if (!ocean || !windDirection || length <= 0.0f || n < 2 || n > 32768)
+	{
+		return GLUS_FALSE;
+	}
+
+	memset(ocean, 0, sizeof(GLUSocean));
+
+	if (!glusFourierCreatePlan(&ocean->plan, n))
+	{
+		return GLUS_FALSE;
+	}
+
+	ocean->n = n;
+	ocean->length = length;
+	ocean->numberThreads = numberThreads;
+
+	ocean->h0 = (GLUSfloat*)glusMemoryMalloc(n * n * 7 * sizeof(GLUSfloat));
+
+	if (!ocean->h0 || !glusImageCreateHdr(&ocean->displacement, n, n, 1, GLUS_RED) || !glusImageCreateHdr(&ocean->normal, n, n, 1, GLUS_RGB))
+	{
+		glusOceanDestroy(ocean);
+
+		return GLUS_FALSE;
+	}
+
+	ocean->h0SumReal = ocean->h0 + n * n * 2;
+	ocean->h0SumImaginary = ocean->h0SumReal + n * n;
+	ocean->omega = ocean->h0SumImaginary + n * n;
+	ocean->real = ocean->omega + n * n;
+	ocean->imaginary = ocean->real + n * n;
+
+	normalizedWindDirection[0] = windDirection[0];
+	normalizedWindDirection[1] = windDirection[1];
+
+	glusVector2Normalizef(normalizedWindDirection);
+
+	for (y = 0; y < n; y++)
+	{
+		// Positive N, that it matches with OpenGL z-axis.
+		waveDirection[1] = ((GLUSfloat)n / 2.0f - (GLUSfloat)y) * (2.0f * GLUS_PI / length);
+
+		for (x = 0; x < n; x++)
+		{
+			waveDirection[0] = ((GLUSfloat)-n / 2.0f + (GLUSfloat)x) * (2.0f * GLUS_PI / length);
+
+			phillipsSpectrumValue = glusOceanPhillipsSpectrum(amplitude, windSpeed * windSpeed / GLUS_OCEAN_GRAVITY, waveDirection, normalizedWindDirection);
+
+			ocean->h0[y * 2 * n + x * 2 + 0] = 1.0f / sqrtf(2.0f) * glusRandomNormalf(0.0f, 1.0f) * phillipsSpectrumValue;
+			ocean->h0[y * 2 * n + x * 2 + 1] = 1.0f / sqrtf(2.0f) * glusRandomNormalf(0.0f, 1.0f) * phillipsSpectrumValue;
+
+			ocean->omega[y * n + x] = sqrtf(GLUS_OCEAN_GRAVITY * glusVector2Lengthf(waveDirection));
+		}
+	}
+
+	// Both terms of h(k, t) rotate with the same angle, so h0(k) and h0(-k) are only added once.
+	for (y = 0; y < n; y++)
+	{
+		for (x = 0; x < n; x++)
+		{
+			index = y * n + x;
+			negativeIndex = (n - 1 - y) * n + (n - 1 - x);
+
+			ocean->h0SumReal[index] = ocean->h0[index * 2 + 0] + ocean->h0[negativeIndex * 2 + 0];
+			ocean->h0SumImaginary[index] = ocean->h0[index * 2 + 1] + ocean->h0[negativeIndex * 2 + 1];
+		}
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusOceanDestroy(GLUSocean* ocean)
+{
+	if (!ocean)
+	{
+		return;
+	}
+
+	glusImageDestroyHdr(&ocean->normal);
+	glusImageDestroyHdr(&ocean->displacement);
+
+	if (ocean->h0)
+	{
+		glusMemoryFree(ocean->h0);
+
+		ocean->h0 = 0;
+	}
+
+	ocean->h0SumReal = 0;
+	ocean->h0SumImaginary = 0;
+	ocean->omega = 0;
+	ocean->real = 0;
+	ocean->imaginary = 0;
+
+	glusFourierDestroyPlan(&ocean->plan);
+
+	ocean->n = 0;
+}
+
+GLUSboolean GLUSAPIENTRY glusOceanUpdate(GLUSocean* ocean, const GLUSfloat totalTime)
+{
+	GLUSoceanwork work;
+
+	GLUSdouble startTime;
+
+	if (!ocean || !ocean->h0)
+	{
+		return GLUS_FALSE;
+	}
+
+	startTime = _glusThreadGetRawTime();
+
+	work.ocean = ocean;
+	work.totalTime = totalTime;
+
+	if (!_glusThreadRunTiles(ocean->n, ocean->numberThreads, glusOceanSpectrumRow, &work))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!glusFourier2DInverseFFTf(&ocean->plan, &ocean->plan, ocean->real, ocean->imaginary, ocean->numberThreads))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!_glusThreadRunTiles(ocean->n, ocean->numberThreads, glusOceanNormalRow, &work))
+	{
+		return GLUS_FALSE;
+	}
+
+	ocean->updateTime = (GLUSfloat)(_glusThreadGetRawTime() - startTime);
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusOceanSaveHdr(const GLUSchar* displacementFilename, const GLUSchar* normalFilename, const GLUSocean* ocean)
+{
+	GLUShdrimage output;
+
+	GLUSint i;
+	GLUSfloat height;
+
+	GLUSboolean result = GLUS_TRUE;
+
+	if (!ocean || !ocean->h0)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!glusImageCreateHdr(&output, ocean->n, ocean->n, 1, GLUS_RGB))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (displacementFilename)
+	{
+		for (i = 0; i < ocean->n * ocean->n; i++)
+		{
+			height = ocean->displacement.data[i];
+
+			output.data[i * 3 + 0] = height > 0.0f ? height : 0.0f;
+			output.data[i * 3 + 1] = height < 0.0f ? -height : 0.0f;
+			output.data[i * 3 + 2] = 0.0f;
+		}
+
+		if (!glusImageSaveHdr(displacementFilename, &output))
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Could not save image '%s'", displacementFilename);
+
+			result = GLUS_FALSE;
+		}
+	}
+
+	if (normalFilename && result)
+	{
+		for (i = 0; i < ocean->n * ocean->n * 3; i++)
+		{
+			output.data[i] = ocean->normal.data[i] * 0.5f + 0.5f;
+		}
+
+		if (!glusImageSaveHdr(normalFilename, &output))
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Could not save image '%s'", normalFilename);
+
+			result = GLUS_FALSE;
+		}
+	}
+
+	glusImageDestroyHdr(&output);
+
+	return result;
+}
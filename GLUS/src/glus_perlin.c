@@ -15,370 +15,933 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GLUS_PERLIN_SSE
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GLUS_PERLIN_NEON
+#endif
+
 #include "GL/glus.h"
 
-static GLUSfloat glusPerlinGetInterpolatedValue(const GLUSfloat value0, const GLUSfloat value1, const GLUSfloat t)
+#define GLUS_PERLIN_BATCH 64
+
+#define GLUS_PERLIN_PRIME_X 0x8DA6B343
+#define GLUS_PERLIN_PRIME_Y 0xD8163841
+#define GLUS_PERLIN_PRIME_Z 0xCB1AB31F
+
+// Skewing factors of the simplex grids.
+#define GLUS_PERLIN_F2 0.36602540378443864676f
+#define GLUS_PERLIN_G2 0.21132486540518711775f
+#define GLUS_PERLIN_F3 (1.0f / 3.0f)
+#define GLUS_PERLIN_G3 (1.0f / 6.0f)
+
+extern GLUSboolean _glusThreadRunTiles(const GLUSint numberTiles, const GLUSint numberThreads, GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile), GLUSvoid* data);
+
+typedef struct _GLUSperlinwork
 {
-	GLUSfloat ft;
+	GLUSfloat* hdrData;
+
+	GLUSubyte* tgaData;
+
+	GLUSint width;
+
+	GLUSint height;
+
+	GLUSint depth;
+
+	GLUSenum type;
+
+	GLUSfloat frequency;
+
+	GLUSfloat persistence;
+
+	GLUSint octaves;
 
-	ft = (1.0f - cosf(t * GLUS_PI)) / 2.0f;
+	GLUSuint seed;
 
-	return value0 * (1.0f - ft) + value1 * ft;
+	/**
+	 * The 8 bit value is scale * (sum + bias).
+	 */
+	GLUSfloat scale;
+
+	GLUSfloat bias;
+
+} GLUSperlinwork;
+
+/**
+ * Finalizer of MurmurHash3 like hash functions. Every input bit affects every output bit, so neighboring seeds give unrelated noise.
+ */
+static GLUSuint glusPerlinMix(GLUSuint hash)
+{
+	hash ^= hash >> 16;
+	hash *= 0x7FEB352D;
+	hash ^= hash >> 15;
+	hash *= 0x846CA68B;
+	hash ^= hash >> 16;
+
+	return hash;
 }
 
-static GLUSfloat glusPerlinGetNoiseValue1D(GLUStgaimage* image, GLUSint x, const GLUSint amplitude, const GLUSint* data1D)
+/**
+ * Gradient index out of the combined lattice coordinates. The top bits of the second product depend on all bits of the input.
+ */
+static GLUSuint glusPerlinHash(GLUSuint hash)
 {
-	if (!image || !data1D)
-	{
-		return 0.0f;
-	}
+	hash *= 0x7FEB352D;
+	hash ^= hash >> 15;
+	hash *= 0x846CA68B;
 
-	x = x % (GLUSint)image->width;
+	return hash >> 28;
+}
 
-	if (x < 0)
-	{
-		x = (GLUSint)image->width + x;
-	}
+/**
+ * Dot product with one of the twelve gradients pointing to the edges of a cube. See Improving Noise, Ken Perlin.
+ */
+static GLUSfloat glusPerlinGradient(const GLUSuint hash, const GLUSfloat x, const GLUSfloat y, const GLUSfloat z)
+{
+	GLUSuint h = hash;
+
+	GLUSfloat u = h < 8 ? x : y;
+	GLUSfloat v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
+
+	return ((h & 1) == 1 ? -u : u) + ((h & 2) == 2 ? -v : v);
+}
 
-	return (GLUSfloat)(data1D[x] % amplitude);
+static GLUSfloat glusPerlinFade(const GLUSfloat t)
+{
+	return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+}
+
+static GLUSfloat glusPerlinLerp(const GLUSfloat a, const GLUSfloat b, const GLUSfloat t)
+{
+	return a + t * (b - a);
 }
 
-static GLUSfloat glusPerlinGetNoiseValue2D(GLUStgaimage* image, GLUSint x, GLUSint y, const GLUSint amplitude, const GLUSint* data2D)
+/**
+ * Lattice cell and fraction of one coordinate. With a period, the coordinate and the cells are wrapped.
+ */
+static GLUSvoid glusPerlinLattice(GLUSuint* cell0, GLUSuint* cell1, GLUSfloat* fraction, GLUSfloat value, const GLUSint period)
 {
-	if (!image || !data2D)
+	GLUSfloat cell;
+
+	if (period > 0)
 	{
-		return 0.0f;
+		value = value - (GLUSfloat)period * floorf(value / (GLUSfloat)period);
 	}
 
-	x = x % (GLUSint)image->width;
-	y = y % (GLUSint)image->height;
+	cell = floorf(value);
+
+	*fraction = value - cell;
+	*cell0 = (GLUSuint)(GLUSint)cell;
 
-	if (x < 0)
+	if (period > 0)
 	{
-		x = (GLUSint)image->width + x;
+		*cell0 = *cell0 == (GLUSuint)period ? 0 : *cell0;
+		*cell1 = *cell0 + 1;
+		*cell1 = *cell1 == (GLUSuint)period ? 0 : *cell1;
 	}
-	if (y < 0)
+	else
 	{
-		y = (GLUSint)image->height + y;
+		*cell1 = *cell0 + 1;
 	}
-
-	return (GLUSfloat)(data2D[x + y * (GLUSint)image->width] % amplitude);
 }
 
-static GLUSfloat glusPerlinGetNoiseValue3D(GLUStgaimage* image, GLUSint x, GLUSint y, GLUSint z, const GLUSint amplitude, const GLUSint* data3D)
+static GLUSfloat glusPerlinSimplexCorner(const GLUSuint hash, const GLUSfloat x, const GLUSfloat y, const GLUSfloat z, const GLUSfloat radius)
 {
-	if (!image || !data3D)
+	GLUSfloat t = radius - x * x - y * y - z * z;
+
+	if (t < 0.0f)
 	{
 		return 0.0f;
 	}
 
-	x = x % (GLUSint)image->width;
-	y = y % (GLUSint)image->height;
-	z = z % (GLUSint)image->depth;
+	t = t * t;
 
-	if (x < 0)
-	{
-		x = (GLUSint)image->width + x;
-	}
-	if (y < 0)
-	{
-		y = (GLUSint)image->height + y;
-	}
-	if (z < 0)
-	{
-		z = (GLUSint)image->depth + z;
-	}
+	return t * t * glusPerlinGradient(hash, x, y, z);
+}
+
+GLUSfloat GLUSAPIENTRY glusPerlinGradientNoise2f(const GLUSfloat x, const GLUSfloat y, const GLUSint period[2], const GLUSuint seed)
+{
+	GLUSuint x0, x1, y0, y1, hashSeed;
+	GLUSfloat fx, fy, n00, n10, n01, n11;
+
+	glusPerlinLattice(&x0, &x1, &fx, x, period ? period[0] : 0);
+	glusPerlinLattice(&y0, &y1, &fy, y, period ? period[1] : 0);
+
+	hashSeed = glusPerlinMix(seed);
+
+	x0 *= GLUS_PERLIN_PRIME_X;
+	x1 *= GLUS_PERLIN_PRIME_X;
+	y0 = y0 * GLUS_PERLIN_PRIME_Y + hashSeed;
+	y1 = y1 * GLUS_PERLIN_PRIME_Y + hashSeed;
 
-	return (GLUSfloat)(data3D[x + y * (GLUSint)image->width + z * (GLUSint)image->height * (GLUSint)image->width] % amplitude);
+	n00 = glusPerlinGradient(glusPerlinHash(x0 + y0), fx, fy, 0.0f);
+	n10 = glusPerlinGradient(glusPerlinHash(x1 + y0), fx - 1.0f, fy, 0.0f);
+	n01 = glusPerlinGradient(glusPerlinHash(x0 + y1), fx, fy - 1.0f, 0.0f);
+	n11 = glusPerlinGradient(glusPerlinHash(x1 + y1), fx - 1.0f, fy - 1.0f, 0.0f);
+
+	fx = glusPerlinFade(fx);
+
+	return glusPerlinLerp(glusPerlinLerp(n00, n10, fx), glusPerlinLerp(n01, n11, fx), glusPerlinFade(fy));
 }
 
-GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise1D(GLUStgaimage* image, const GLUSint width, const GLUSint seed, const GLUSfloat frequency, const GLUSfloat amplitude, const GLUSfloat persistence, const GLUSint octaves)
+GLUSfloat GLUSAPIENTRY glusPerlinGradientNoise3f(const GLUSfloat x, const GLUSfloat y, const GLUSfloat z, const GLUSint period[3], const GLUSuint seed)
 {
-	GLUSint i;
+	GLUSuint x0, x1, y0, y1, z0, z1, hashSeed;
+	GLUSfloat fx, fy, fz, n000, n100, n010, n110, n001, n101, n011, n111;
+
+	glusPerlinLattice(&x0, &x1, &fx, x, period ? period[0] : 0);
+	glusPerlinLattice(&y0, &y1, &fy, y, period ? period[1] : 0);
+	glusPerlinLattice(&z0, &z1, &fz, z, period ? period[2] : 0);
+
+	hashSeed = glusPerlinMix(seed);
+
+	x0 *= GLUS_PERLIN_PRIME_X;
+	x1 *= GLUS_PERLIN_PRIME_X;
+	y0 *= GLUS_PERLIN_PRIME_Y;
+	y1 *= GLUS_PERLIN_PRIME_Y;
+	z0 = z0 * GLUS_PERLIN_PRIME_Z + hashSeed;
+	z1 = z1 * GLUS_PERLIN_PRIME_Z + hashSeed;
+
+	n000 = glusPerlinGradient(glusPerlinHash(x0 + y0 + z0), fx, fy, fz);
+	n100 = glusPerlinGradient(glusPerlinHash(x1 + y0 + z0), fx - 1.0f, fy, fz);
+	n010 = glusPerlinGradient(glusPerlinHash(x0 + y1 + z0), fx, fy - 1.0f, fz);
+	n110 = glusPerlinGradient(glusPerlinHash(x1 + y1 + z0), fx - 1.0f, fy - 1.0f, fz);
+	n001 = glusPerlinGradient(glusPerlinHash(x0 + y0 + z1), fx, fy, fz - 1.0f);
+	n101 = glusPerlinGradient(glusPerlinHash(x1 + y0 + z1), fx - 1.0f, fy, fz - 1.0f);
+	n011 = glusPerlinGradient(glusPerlinHash(x0 + y1 + z1), fx, fy - 1.0f, fz - 1.0f);
+	n111 = glusPerlinGradient(glusPerlinHash(x1 + y1 + z1), fx - 1.0f, fy - 1.0f, fz - 1.0f);
+
+	fx = glusPerlinFade(fx);
+	fy = glusPerlinFade(fy);
+
+	return glusPerlinLerp(glusPerlinLerp(glusPerlinLerp(n000, n100, fx), glusPerlinLerp(n010, n110, fx), fy), glusPerlinLerp(glusPerlinLerp(n001, n101, fx), glusPerlinLerp(n011, n111, fx), fy), glusPerlinFade(fz));
+}
 
-	GLUSfloat* data;
-	GLUSint* data1D;
+GLUSfloat GLUSAPIENTRY glusPerlinSimplexNoise2f(const GLUSfloat x, const GLUSfloat y, const GLUSuint seed)
+{
+	// see Simplex noise demystified, Stefan Gustavson
 
-	GLUSfloat frequencyFactor;
-	GLUSfloat amplitudeFactor;
+	GLUSfloat s, t, i, j, x0, y0, x1, y1, x2, y2;
+	GLUSuint ix, jy, i1, j1, hashSeed;
 
-	if (!image)
-	{
-		return GLUS_FALSE;
-	}
+	s = (x + y) * GLUS_PERLIN_F2;
+	i = floorf(x + s);
+	j = floorf(y + s);
 
-	if (persistence <= 0.0f || width < 1)
-	{
-		return GLUS_FALSE;
-	}
+	t = (i + j) * GLUS_PERLIN_G2;
+	x0 = x - (i - t);
+	y0 = y - (j - t);
 
-	image->width = (GLUSushort)width;
-	image->height = 1;
-	image->depth = 1;
-	image->format = GLUS_SINGLE_CHANNEL;
-	image->data = glusMemoryMalloc(width * sizeof(GLUSubyte));
+	// Lower or upper triangle of the skewed cell.
+	i1 = x0 > y0 ? 1 : 0;
+	j1 = 1 - i1;
 
-	if (!image->data)
-	{
-		glusImageDestroyTga(image);
+	x1 = x0 - (GLUSfloat)i1 + GLUS_PERLIN_G2;
+	y1 = y0 - (GLUSfloat)j1 + GLUS_PERLIN_G2;
+	x2 = x0 - 1.0f + 2.0f * GLUS_PERLIN_G2;
+	y2 = y0 - 1.0f + 2.0f * GLUS_PERLIN_G2;
 
-		return GLUS_FALSE;
-	}
+	hashSeed = glusPerlinMix(seed);
 
-	data = glusMemoryMalloc(width * sizeof(GLUSfloat));
+	ix = (GLUSuint)(GLUSint)i;
+	jy = (GLUSuint)(GLUSint)j;
 
-	if (!data)
-	{
-		glusImageDestroyTga(image);
+	return 70.0f * (glusPerlinSimplexCorner(glusPerlinHash(ix * GLUS_PERLIN_PRIME_X + jy * GLUS_PERLIN_PRIME_Y + hashSeed), x0, y0, 0.0f, 0.5f) +
+					glusPerlinSimplexCorner(glusPerlinHash((ix + i1) * GLUS_PERLIN_PRIME_X + (jy + j1) * GLUS_PERLIN_PRIME_Y + hashSeed), x1, y1, 0.0f, 0.5f) +
+					glusPerlinSimplexCorner(glusPerlinHash((ix + 1) * GLUS_PERLIN_PRIME_X + (jy + 1) * GLUS_PERLIN_PRIME_Y + hashSeed), x2, y2, 0.0f, 0.5f));
+}
 
-		return GLUS_FALSE;
-	}
+GLUSfloat GLUSAPIENTRY glusPerlinSimplexNoise3f(const GLUSfloat x, const GLUSfloat y, const GLUSfloat z, const GLUSuint seed)
+{
+	// see Simplex noise demystified, Stefan Gustavson
+
+	GLUSfloat s, t, i, j, k, x0, y0, z0;
+	GLUSuint ix, jy, kz, i1, j1, k1, i2, j2, k2, hashSeed;
+	GLUSboolean xy, xz, yz;
+	GLUSfloat n0, n1, n2, n3;
+
+	s = (x + y + z) * GLUS_PERLIN_F3;
+	i = floorf(x + s);
+	j = floorf(y + s);
+	k = floorf(z + s);
+
+	t = (i + j + k) * GLUS_PERLIN_G3;
+	x0 = x - (i - t);
+	y0 = y - (j - t);
+	z0 = z - (k - t);
+
+	// Rank the coordinates to find the simplex of the skewed cell.
+	xy = x0 >= y0;
+	xz = x0 >= z0;
+	yz = y0 >= z0;
+
+	i1 = xy && xz;
+	j1 = !xy && yz;
+	k1 = !xz && !yz;
+	i2 = xy || xz;
+	j2 = !xy || yz;
+	k2 = !(xz && yz);
+
+	hashSeed = glusPerlinMix(seed);
+
+	ix = (GLUSuint)(GLUSint)i;
+	jy = (GLUSuint)(GLUSint)j;
+	kz = (GLUSuint)(GLUSint)k;
+
+	n0 = glusPerlinSimplexCorner(glusPerlinHash(ix * GLUS_PERLIN_PRIME_X + jy * GLUS_PERLIN_PRIME_Y + kz * GLUS_PERLIN_PRIME_Z + hashSeed), x0, y0, z0, 0.6f);
+	n1 = glusPerlinSimplexCorner(glusPerlinHash((ix + i1) * GLUS_PERLIN_PRIME_X + (jy + j1) * GLUS_PERLIN_PRIME_Y + (kz + k1) * GLUS_PERLIN_PRIME_Z + hashSeed), x0 - (GLUSfloat)i1 + GLUS_PERLIN_G3, y0 - (GLUSfloat)j1 + GLUS_PERLIN_G3, z0 - (GLUSfloat)k1 + GLUS_PERLIN_G3, 0.6f);
+	n2 = glusPerlinSimplexCorner(glusPerlinHash((ix + i2) * GLUS_PERLIN_PRIME_X + (jy + j2) * GLUS_PERLIN_PRIME_Y + (kz + k2) * GLUS_PERLIN_PRIME_Z + hashSeed), x0 - (GLUSfloat)i2 + 2.0f * GLUS_PERLIN_G3, y0 - (GLUSfloat)j2 + 2.0f * GLUS_PERLIN_G3, z0 - (GLUSfloat)k2 + 2.0f * GLUS_PERLIN_G3, 0.6f);
+	n3 = glusPerlinSimplexCorner(glusPerlinHash((ix + 1) * GLUS_PERLIN_PRIME_X + (jy + 1) * GLUS_PERLIN_PRIME_Y + (kz + 1) * GLUS_PERLIN_PRIME_Z + hashSeed), x0 - 1.0f + 3.0f * GLUS_PERLIN_G3, y0 - 1.0f + 3.0f * GLUS_PERLIN_G3, z0 - 1.0f + 3.0f * GLUS_PERLIN_G3, 0.6f);
+
+	return 32.0f * (n0 + n1 + n2 + n3);
+}
 
-	for (i = 0; i < width; i++)
-	{
-		data[i] = 0.0f;
-	}
+#if defined(GLUS_PERLIN_SSE) || defined(GLUS_PERLIN_NEON)
 
-	//
+//
+// Four points are evaluated at once. The operations are done in the same order as in the scalar functions.
+//
 
-	data1D = glusMemoryMalloc(width * sizeof(GLUSint));
+#if defined(GLUS_PERLIN_SSE)
 
-	if (!data1D)
-	{
-		glusImageDestroyTga(image);
+typedef __m128 GLUSperlinfloat4;
+typedef __m128i GLUSperlinuint4;
 
-		glusMemoryFree(data);
+static GLUSperlinfloat4 glusPerlinSet4(const GLUSfloat value)
+{
+	return _mm_set1_ps(value);
+}
 
-		return GLUS_FALSE;
-	}
+static GLUSperlinuint4 glusPerlinSetUint4(const GLUSuint value)
+{
+	return _mm_set1_epi32((int)value);
+}
 
-	srand(seed);
-	for (i = 0; i < width; i++)
-	{
-		data1D[i] = rand();
-	}
+static GLUSperlinfloat4 glusPerlinLoad4(const GLUSfloat* values)
+{
+	return _mm_loadu_ps(values);
+}
 
-	//
+static GLUSvoid glusPerlinStore4(GLUSfloat* values, const GLUSperlinfloat4 vector)
+{
+	_mm_storeu_ps(values, vector);
+}
 
-	frequencyFactor = 1.0f;
-	amplitudeFactor = 1.0f / persistence;
+static GLUSperlinfloat4 glusPerlinAdd4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return _mm_add_ps(a, b);
+}
 
-	for (i = 0; i < octaves; i++)
-	{
-		GLUSint x;
+static GLUSperlinfloat4 glusPerlinSub4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return _mm_sub_ps(a, b);
+}
 
-		GLUSint waveLenghtX;
+static GLUSperlinfloat4 glusPerlinMul4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return _mm_mul_ps(a, b);
+}
 
-		GLUSfloat currentFrequency = frequency * frequencyFactor;
-		GLUSfloat currentAmplitude = amplitude / (1.0f * amplitudeFactor);
+static GLUSperlinfloat4 glusPerlinDiv4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return _mm_div_ps(a, b);
+}
 
-		if (currentFrequency <= 1.0f)
-		{
-			currentFrequency = 1.0f;
-		}
+static GLUSperlinfloat4 glusPerlinFloor4(const GLUSperlinfloat4 value)
+{
+	GLUSperlinfloat4 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(value));
 
-		waveLenghtX = width / (GLUSint)currentFrequency;
+	// Truncation rounds negative values up.
+	return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, value), _mm_set1_ps(1.0f)));
+}
 
-		if (waveLenghtX < 1)
-		{
-			waveLenghtX = 1;
-		}
+static GLUSperlinuint4 glusPerlinToUint4(const GLUSperlinfloat4 value)
+{
+	return _mm_cvttps_epi32(value);
+}
 
-		// Render per wavelength
-		for (x = 0; x < width; x += waveLenghtX)
-		{
-			GLUSint xInner;
+static GLUSperlinuint4 glusPerlinGreaterEqual4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return _mm_castps_si128(_mm_cmpge_ps(a, b));
+}
 
-			GLUSfloat p[2];
+static GLUSperlinuint4 glusPerlinLess4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return _mm_castps_si128(_mm_cmplt_ps(a, b));
+}
 
-			GLUSint xRandom = x / waveLenghtX;
+static GLUSperlinfloat4 glusPerlinSelect4(const GLUSperlinuint4 mask, const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return _mm_or_ps(_mm_and_ps(_mm_castsi128_ps(mask), a), _mm_andnot_ps(_mm_castsi128_ps(mask), b));
+}
 
-			// Get random values from adjacent points
-			p[0] = glusPerlinGetNoiseValue1D(image, xRandom, (GLUSint)currentAmplitude, data1D);
-			p[1] = glusPerlinGetNoiseValue1D(image, xRandom + 1, (GLUSint)currentAmplitude, data1D);
+static GLUSperlinuint4 glusPerlinSelectUint4(const GLUSperlinuint4 mask, const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
 
-			// Sample the points in the wavelength area
-			for (xInner = 0; xInner < waveLenghtX && x + xInner < width; xInner++)
-			{
-				GLUSint index = x + xInner;
+static GLUSperlinuint4 glusPerlinAddUint4(const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	return _mm_add_epi32(a, b);
+}
 
-				data[index] += glusPerlinGetInterpolatedValue(p[0], p[1], (GLUSfloat)xInner / (GLUSfloat)waveLenghtX);
-			}
-		}
+static GLUSperlinuint4 glusPerlinMulUint4(const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	// SSE2 has no 32 bit multiplication, so even and odd elements are multiplied to 64 bit.
+	GLUSperlinuint4 even = _mm_mul_epu32(a, b);
+	GLUSperlinuint4 odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
 
-		frequencyFactor *= 2.0f;
-		amplitudeFactor *= 1.0f / persistence;
-	}
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
 
-	glusMemoryFree(data1D);
+static GLUSperlinuint4 glusPerlinAndUint4(const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	return _mm_and_si128(a, b);
+}
 
-	for (i = 0; i < width; i++)
-	{
-		image->data[i] = (GLUSubyte)data[i];
-	}
+static GLUSperlinuint4 glusPerlinOrUint4(const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	return _mm_or_si128(a, b);
+}
 
-	glusMemoryFree(data);
+static GLUSperlinuint4 glusPerlinNotUint4(const GLUSperlinuint4 a)
+{
+	return _mm_xor_si128(a, _mm_set1_epi32(-1));
+}
 
-	return GLUS_TRUE;
+static GLUSperlinuint4 glusPerlinEqualUint4(const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	return _mm_cmpeq_epi32(a, b);
 }
 
-GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise2D(GLUStgaimage* image, const GLUSint width, const GLUSint height, const GLUSint seed, const GLUSfloat frequency, const GLUSfloat amplitude, const GLUSfloat persistence, const GLUSint octaves)
+static GLUSperlinuint4 glusPerlinLessUint4(const GLUSperlinuint4 a, const GLUSperlinuint4 b)
 {
-	GLUSint i;
+	// Only used for small values, so the signed comparison is sufficient.
+	return _mm_cmplt_epi32(a, b);
+}
 
-	GLUSfloat* data;
-	GLUSint* data2D;
+static GLUSperlinuint4 glusPerlinHash4(GLUSperlinuint4 hash)
+{
+	hash = glusPerlinMulUint4(hash, _mm_set1_epi32((int)0x7FEB352D));
+	hash = _mm_xor_si128(hash, _mm_srli_epi32(hash, 15));
+	hash = glusPerlinMulUint4(hash, _mm_set1_epi32((int)0x846CA68B));
 
-	GLUSfloat frequencyFactor;
-	GLUSfloat amplitudeFactor;
+	return _mm_srli_epi32(hash, 28);
+}
 
-	if (!image)
-	{
-		return GLUS_FALSE;
-	}
+#else
 
-	if (persistence <= 0.0f || width < 1 || height < 1)
-	{
-		return GLUS_FALSE;
-	}
+typedef float32x4_t GLUSperlinfloat4;
+typedef uint32x4_t GLUSperlinuint4;
 
-	image->width = (GLUSushort)width;
-	image->height = (GLUSushort)height;
-	image->depth = 1;
-	image->format = GLUS_SINGLE_CHANNEL;
-	image->data = glusMemoryMalloc(width * height * sizeof(GLUSubyte));
+static GLUSperlinfloat4 glusPerlinSet4(const GLUSfloat value)
+{
+	return vdupq_n_f32(value);
+}
 
-	if (!image->data)
+static GLUSperlinuint4 glusPerlinSetUint4(const GLUSuint value)
+{
+	return vdupq_n_u32(value);
+}
+
+static GLUSperlinfloat4 glusPerlinLoad4(const GLUSfloat* values)
+{
+	return vld1q_f32(values);
+}
+
+static GLUSvoid glusPerlinStore4(GLUSfloat* values, const GLUSperlinfloat4 vector)
+{
+	vst1q_f32(values, vector);
+}
+
+static GLUSperlinfloat4 glusPerlinAdd4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return vaddq_f32(a, b);
+}
+
+static GLUSperlinfloat4 glusPerlinSub4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return vsubq_f32(a, b);
+}
+
+static GLUSperlinfloat4 glusPerlinMul4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return vmulq_f32(a, b);
+}
+
+static GLUSperlinfloat4 glusPerlinDiv4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return vdivq_f32(a, b);
+}
+
+static GLUSperlinfloat4 glusPerlinFloor4(const GLUSperlinfloat4 value)
+{
+	return vrndmq_f32(value);
+}
+
+static GLUSperlinuint4 glusPerlinToUint4(const GLUSperlinfloat4 value)
+{
+	return vreinterpretq_u32_s32(vcvtq_s32_f32(value));
+}
+
+static GLUSperlinuint4 glusPerlinGreaterEqual4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return vcgeq_f32(a, b);
+}
+
+static GLUSperlinuint4 glusPerlinLess4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return vcltq_f32(a, b);
+}
+
+static GLUSperlinfloat4 glusPerlinSelect4(const GLUSperlinuint4 mask, const GLUSperlinfloat4 a, const GLUSperlinfloat4 b)
+{
+	return vbslq_f32(mask, a, b);
+}
+
+static GLUSperlinuint4 glusPerlinSelectUint4(const GLUSperlinuint4 mask, const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	return vbslq_u32(mask, a, b);
+}
+
+static GLUSperlinuint4 glusPerlinAddUint4(const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	return vaddq_u32(a, b);
+}
+
+static GLUSperlinuint4 glusPerlinMulUint4(const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	return vmulq_u32(a, b);
+}
+
+static GLUSperlinuint4 glusPerlinAndUint4(const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	return vandq_u32(a, b);
+}
+
+static GLUSperlinuint4 glusPerlinOrUint4(const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	return vorrq_u32(a, b);
+}
+
+static GLUSperlinuint4 glusPerlinNotUint4(const GLUSperlinuint4 a)
+{
+	return vmvnq_u32(a);
+}
+
+static GLUSperlinuint4 glusPerlinEqualUint4(const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	return vceqq_u32(a, b);
+}
+
+static GLUSperlinuint4 glusPerlinLessUint4(const GLUSperlinuint4 a, const GLUSperlinuint4 b)
+{
+	return vcltq_u32(a, b);
+}
+
+static GLUSperlinuint4 glusPerlinHash4(GLUSperlinuint4 hash)
+{
+	hash = vmulq_u32(hash, vdupq_n_u32(0x7FEB352D));
+	hash = veorq_u32(hash, vshrq_n_u32(hash, 15));
+	hash = vmulq_u32(hash, vdupq_n_u32(0x846CA68B));
+
+	return vshrq_n_u32(hash, 28);
+}
+
+#endif
+
+static GLUSperlinfloat4 glusPerlinGradient4(const GLUSperlinuint4 hash, const GLUSperlinfloat4 x, const GLUSperlinfloat4 y, const GLUSperlinfloat4 z)
+{
+	GLUSperlinuint4 h = hash;
+
+	GLUSperlinfloat4 u = glusPerlinSelect4(glusPerlinLessUint4(h, glusPerlinSetUint4(8)), x, y);
+	GLUSperlinfloat4 v = glusPerlinSelect4(glusPerlinLessUint4(h, glusPerlinSetUint4(4)), y, glusPerlinSelect4(glusPerlinOrUint4(glusPerlinEqualUint4(h, glusPerlinSetUint4(12)), glusPerlinEqualUint4(h, glusPerlinSetUint4(14))), x, z));
+
+	GLUSperlinuint4 one = glusPerlinSetUint4(1);
+	GLUSperlinuint4 two = glusPerlinSetUint4(2);
+
+	GLUSperlinfloat4 zero = glusPerlinSet4(0.0f);
+
+	u = glusPerlinSelect4(glusPerlinEqualUint4(glusPerlinAndUint4(h, one), one), glusPerlinSub4(zero, u), u);
+	v = glusPerlinSelect4(glusPerlinEqualUint4(glusPerlinAndUint4(h, two), two), glusPerlinSub4(zero, v), v);
+
+	return glusPerlinAdd4(u, v);
+}
+
+static GLUSperlinfloat4 glusPerlinFade4(const GLUSperlinfloat4 t)
+{
+	return glusPerlinMul4(glusPerlinMul4(glusPerlinMul4(t, t), t), glusPerlinAdd4(glusPerlinMul4(t, glusPerlinSub4(glusPerlinMul4(t, glusPerlinSet4(6.0f)), glusPerlinSet4(15.0f))), glusPerlinSet4(10.0f)));
+}
+
+static GLUSperlinfloat4 glusPerlinLerp4(const GLUSperlinfloat4 a, const GLUSperlinfloat4 b, const GLUSperlinfloat4 t)
+{
+	return glusPerlinAdd4(a, glusPerlinMul4(t, glusPerlinSub4(b, a)));
+}
+
+static GLUSvoid glusPerlinLattice4(GLUSperlinuint4* cell0, GLUSperlinuint4* cell1, GLUSperlinfloat4* fraction, GLUSperlinfloat4 value, const GLUSint period)
+{
+	GLUSperlinfloat4 cell;
+	GLUSperlinfloat4 periodFloat;
+
+	GLUSperlinuint4 periodUint;
+	GLUSperlinuint4 zero = glusPerlinSetUint4(0);
+	GLUSperlinuint4 one = glusPerlinSetUint4(1);
+
+	if (period > 0)
 	{
-		glusImageDestroyTga(image);
+		periodFloat = glusPerlinSet4((GLUSfloat)period);
 
-		return GLUS_FALSE;
+		value = glusPerlinSub4(value, glusPerlinMul4(periodFloat, glusPerlinFloor4(glusPerlinDiv4(value, periodFloat))));
 	}
 
-	data = glusMemoryMalloc(width * height * sizeof(GLUSfloat));
+	cell = glusPerlinFloor4(value);
+
+	*fraction = glusPerlinSub4(value, cell);
+	*cell0 = glusPerlinToUint4(cell);
 
-	if (!data)
+	if (period > 0)
 	{
-		glusImageDestroyTga(image);
+		periodUint = glusPerlinSetUint4((GLUSuint)period);
 
-		return GLUS_FALSE;
+		*cell0 = glusPerlinSelectUint4(glusPerlinEqualUint4(*cell0, periodUint), zero, *cell0);
+		*cell1 = glusPerlinAddUint4(*cell0, one);
+		*cell1 = glusPerlinSelectUint4(glusPerlinEqualUint4(*cell1, periodUint), zero, *cell1);
 	}
-
-	for (i = 0; i < width * height; i++)
+	else
 	{
-		data[i] = 0.0f;
+		*cell1 = glusPerlinAddUint4(*cell0, one);
 	}
+}
 
-	//
+static GLUSperlinfloat4 glusPerlinGradientNoise4(const GLUSperlinfloat4 x, const GLUSperlinfloat4 y, const GLUSperlinfloat4 z, const GLUSint period[3], const GLUSuint hashSeed)
+{
+	GLUSperlinuint4 x0, x1, y0, y1, z0, z1;
+	GLUSperlinfloat4 fx, fy, fz, fx1, fy1, fz1, n000, n100, n010, n110, n001, n101, n011, n111;
+
+	GLUSperlinfloat4 one = glusPerlinSet4(1.0f);
+
+	glusPerlinLattice4(&x0, &x1, &fx, x, period[0]);
+	glusPerlinLattice4(&y0, &y1, &fy, y, period[1]);
+	glusPerlinLattice4(&z0, &z1, &fz, z, period[2]);
+
+	x0 = glusPerlinMulUint4(x0, glusPerlinSetUint4(GLUS_PERLIN_PRIME_X));
+	x1 = glusPerlinMulUint4(x1, glusPerlinSetUint4(GLUS_PERLIN_PRIME_X));
+	y0 = glusPerlinMulUint4(y0, glusPerlinSetUint4(GLUS_PERLIN_PRIME_Y));
+	y1 = glusPerlinMulUint4(y1, glusPerlinSetUint4(GLUS_PERLIN_PRIME_Y));
+	z0 = glusPerlinAddUint4(glusPerlinMulUint4(z0, glusPerlinSetUint4(GLUS_PERLIN_PRIME_Z)), glusPerlinSetUint4(hashSeed));
+	z1 = glusPerlinAddUint4(glusPerlinMulUint4(z1, glusPerlinSetUint4(GLUS_PERLIN_PRIME_Z)), glusPerlinSetUint4(hashSeed));
+
+	fx1 = glusPerlinSub4(fx, one);
+	fy1 = glusPerlinSub4(fy, one);
+	fz1 = glusPerlinSub4(fz, one);
+
+	n000 = glusPerlinGradient4(glusPerlinHash4(glusPerlinAddUint4(glusPerlinAddUint4(x0, y0), z0)), fx, fy, fz);
+	n100 = glusPerlinGradient4(glusPerlinHash4(glusPerlinAddUint4(glusPerlinAddUint4(x1, y0), z0)), fx1, fy, fz);
+	n010 = glusPerlinGradient4(glusPerlinHash4(glusPerlinAddUint4(glusPerlinAddUint4(x0, y1), z0)), fx, fy1, fz);
+	n110 = glusPerlinGradient4(glusPerlinHash4(glusPerlinAddUint4(glusPerlinAddUint4(x1, y1), z0)), fx1, fy1, fz);
+	n001 = glusPerlinGradient4(glusPerlinHash4(glusPerlinAddUint4(glusPerlinAddUint4(x0, y0), z1)), fx, fy, fz1);
+	n101 = glusPerlinGradient4(glusPerlinHash4(glusPerlinAddUint4(glusPerlinAddUint4(x1, y0), z1)), fx1, fy, fz1);
+	n011 = glusPerlinGradient4(glusPerlinHash4(glusPerlinAddUint4(glusPerlinAddUint4(x0, y1), z1)), fx, fy1, fz1);
+	n111 = glusPerlinGradient4(glusPerlinHash4(glusPerlinAddUint4(glusPerlinAddUint4(x1, y1), z1)), fx1, fy1, fz1);
+
+	fx = glusPerlinFade4(fx);
+	fy = glusPerlinFade4(fy);
+
+	return glusPerlinLerp4(glusPerlinLerp4(glusPerlinLerp4(n000, n100, fx), glusPerlinLerp4(n010, n110, fx), fy), glusPerlinLerp4(glusPerlinLerp4(n001, n101, fx), glusPerlinLerp4(n011, n111, fx), fy), glusPerlinFade4(fz));
+}
 
-	data2D = glusMemoryMalloc(width * height * sizeof(GLUSint));
+static GLUSperlinfloat4 glusPerlinSimplexCorner4(const GLUSperlinuint4 hash, const GLUSperlinfloat4 x, const GLUSperlinfloat4 y, const GLUSperlinfloat4 z)
+{
+	GLUSperlinfloat4 t = glusPerlinSub4(glusPerlinSub4(glusPerlinSub4(glusPerlinSet4(0.6f), glusPerlinMul4(x, x)), glusPerlinMul4(y, y)), glusPerlinMul4(z, z));
+	GLUSperlinuint4 outside = glusPerlinLess4(t, glusPerlinSet4(0.0f));
 
-	if (!data2D)
-	{
-		glusImageDestroyTga(image);
+	t = glusPerlinMul4(t, t);
+
+	return glusPerlinSelect4(outside, glusPerlinSet4(0.0f), glusPerlinMul4(glusPerlinMul4(t, t), glusPerlinGradient4(hash, x, y, z)));
+}
+
+static GLUSperlinuint4 glusPerlinSimplexHash4(const GLUSperlinuint4 i, const GLUSperlinuint4 j, const GLUSperlinuint4 k, const GLUSuint hashSeed)
+{
+	GLUSperlinuint4 hash = glusPerlinMulUint4(i, glusPerlinSetUint4(GLUS_PERLIN_PRIME_X));
 
-		glusMemoryFree(data);
+	hash = glusPerlinAddUint4(hash, glusPerlinMulUint4(j, glusPerlinSetUint4(GLUS_PERLIN_PRIME_Y)));
+	hash = glusPerlinAddUint4(hash, glusPerlinMulUint4(k, glusPerlinSetUint4(GLUS_PERLIN_PRIME_Z)));
 
+	return glusPerlinHash4(glusPerlinAddUint4(hash, glusPerlinSetUint4(hashSeed)));
+}
+
+static GLUSperlinfloat4 glusPerlinSimplexNoise4(const GLUSperlinfloat4 x, const GLUSperlinfloat4 y, const GLUSperlinfloat4 z, const GLUSuint hashSeed)
+{
+	GLUSperlinfloat4 s, t, i, j, k, x0, y0, z0, n0, n1, n2, n3;
+	GLUSperlinuint4 ix, jy, kz, xy, xz, yz, i1, j1, k1, i2, j2, k2;
+
+	GLUSperlinfloat4 zero = glusPerlinSet4(0.0f);
+	GLUSperlinfloat4 one = glusPerlinSet4(1.0f);
+	GLUSperlinfloat4 g3 = glusPerlinSet4(GLUS_PERLIN_G3);
+	GLUSperlinfloat4 g3Twice = glusPerlinSet4(2.0f * GLUS_PERLIN_G3);
+	GLUSperlinfloat4 g3Thrice = glusPerlinSet4(3.0f * GLUS_PERLIN_G3);
+	GLUSperlinuint4 oneUint = glusPerlinSetUint4(1);
+
+	s = glusPerlinMul4(glusPerlinAdd4(glusPerlinAdd4(x, y), z), glusPerlinSet4(GLUS_PERLIN_F3));
+	i = glusPerlinFloor4(glusPerlinAdd4(x, s));
+	j = glusPerlinFloor4(glusPerlinAdd4(y, s));
+	k = glusPerlinFloor4(glusPerlinAdd4(z, s));
+
+	t = glusPerlinMul4(glusPerlinAdd4(glusPerlinAdd4(i, j), k), g3);
+	x0 = glusPerlinSub4(x, glusPerlinSub4(i, t));
+	y0 = glusPerlinSub4(y, glusPerlinSub4(j, t));
+	z0 = glusPerlinSub4(z, glusPerlinSub4(k, t));
+
+	xy = glusPerlinGreaterEqual4(x0, y0);
+	xz = glusPerlinGreaterEqual4(x0, z0);
+	yz = glusPerlinGreaterEqual4(y0, z0);
+
+	i1 = glusPerlinAndUint4(xy, xz);
+	j1 = glusPerlinAndUint4(glusPerlinNotUint4(xy), yz);
+	k1 = glusPerlinAndUint4(glusPerlinNotUint4(xz), glusPerlinNotUint4(yz));
+	i2 = glusPerlinOrUint4(xy, xz);
+	j2 = glusPerlinOrUint4(glusPerlinNotUint4(xy), yz);
+	k2 = glusPerlinNotUint4(glusPerlinAndUint4(xz, yz));
+
+	ix = glusPerlinToUint4(i);
+	jy = glusPerlinToUint4(j);
+	kz = glusPerlinToUint4(k);
+
+	n0 = glusPerlinSimplexCorner4(glusPerlinSimplexHash4(ix, jy, kz, hashSeed), x0, y0, z0);
+	n1 = glusPerlinSimplexCorner4(glusPerlinSimplexHash4(glusPerlinAddUint4(ix, glusPerlinAndUint4(i1, oneUint)), glusPerlinAddUint4(jy, glusPerlinAndUint4(j1, oneUint)), glusPerlinAddUint4(kz, glusPerlinAndUint4(k1, oneUint)), hashSeed),
+			glusPerlinAdd4(glusPerlinSub4(x0, glusPerlinSelect4(i1, one, zero)), g3), glusPerlinAdd4(glusPerlinSub4(y0, glusPerlinSelect4(j1, one, zero)), g3), glusPerlinAdd4(glusPerlinSub4(z0, glusPerlinSelect4(k1, one, zero)), g3));
+	n2 = glusPerlinSimplexCorner4(glusPerlinSimplexHash4(glusPerlinAddUint4(ix, glusPerlinAndUint4(i2, oneUint)), glusPerlinAddUint4(jy, glusPerlinAndUint4(j2, oneUint)), glusPerlinAddUint4(kz, glusPerlinAndUint4(k2, oneUint)), hashSeed),
+			glusPerlinAdd4(glusPerlinSub4(x0, glusPerlinSelect4(i2, one, zero)), g3Twice), glusPerlinAdd4(glusPerlinSub4(y0, glusPerlinSelect4(j2, one, zero)), g3Twice), glusPerlinAdd4(glusPerlinSub4(z0, glusPerlinSelect4(k2, one, zero)), g3Twice));
+	n3 = glusPerlinSimplexCorner4(glusPerlinSimplexHash4(glusPerlinAddUint4(ix, oneUint), glusPerlinAddUint4(jy, oneUint), glusPerlinAddUint4(kz, oneUint), hashSeed),
+			glusPerlinAdd4(glusPerlinSub4(x0, one), g3Thrice), glusPerlinAdd4(glusPerlinSub4(y0, one), g3Thrice), glusPerlinAdd4(glusPerlinSub4(z0, one), g3Thrice));
+
+	return glusPerlinMul4(glusPerlinSet4(32.0f), glusPerlinAdd4(glusPerlinAdd4(glusPerlinAdd4(n0, n1), n2), n3));
+}
+
+#endif
+
+GLUSboolean GLUSAPIENTRY glusPerlinNoise3fv(GLUSfloat* result, const GLUSfloat* x, const GLUSfloat* y, const GLUSfloat* z, const GLUSint number, const GLUSenum type, const GLUSint period[3], const GLUSuint seed)
+{
+	GLUSint i;
+
+	GLUSint currentPeriod[3] = { 0, 0, 0 };
+
+#if defined(GLUS_PERLIN_SSE) || defined(GLUS_PERLIN_NEON)
+	GLUSfloat remainder[4][4];
+	GLUSperlinfloat4 noise;
+	GLUSuint hashSeed;
+	GLUSint k;
+#endif
+
+	if (!result || !x || !y || !z || number < 0 || (type != GLUS_PERLIN_GRADIENT && type != GLUS_PERLIN_SIMPLEX))
+	{
 		return GLUS_FALSE;
 	}
 
-	srand(seed);
-	for (i = 0; i < width * height; i++)
+	if (period)
 	{
-		data2D[i] = rand();
+		currentPeriod[0] = period[0];
+		currentPeriod[1] = period[1];
+		currentPeriod[2] = period[2];
 	}
 
-	//
+#if defined(GLUS_PERLIN_SSE) || defined(GLUS_PERLIN_NEON)
+	hashSeed = glusPerlinMix(seed);
 
-	frequencyFactor = 1.0f;
-	amplitudeFactor = 1.0f / persistence;
-
-	for (i = 0; i < octaves; i++)
+	for (i = 0; i < number; i += 4)
 	{
-		GLUSint x, y;
+		if (number - i >= 4)
+		{
+			if (type == GLUS_PERLIN_GRADIENT)
+			{
+				noise = glusPerlinGradientNoise4(glusPerlinLoad4(&x[i]), glusPerlinLoad4(&y[i]), glusPerlinLoad4(&z[i]), currentPeriod, hashSeed);
+			}
+			else
+			{
+				noise = glusPerlinSimplexNoise4(glusPerlinLoad4(&x[i]), glusPerlinLoad4(&y[i]), glusPerlinLoad4(&z[i]), hashSeed);
+			}
+
+			glusPerlinStore4(&result[i], noise);
+		}
+		else
+		{
+			// The last points are padded, so they are evaluated the same way.
+			for (k = 0; k < 4; k++)
+			{
+				remainder[0][k] = i + k < number ? x[i + k] : 0.0f;
+				remainder[1][k] = i + k < number ? y[i + k] : 0.0f;
+				remainder[2][k] = i + k < number ? z[i + k] : 0.0f;
+			}
 
-		GLUSint waveLenghtX;
-		GLUSint waveLenghtY;
+			if (type == GLUS_PERLIN_GRADIENT)
+			{
+				noise = glusPerlinGradientNoise4(glusPerlinLoad4(remainder[0]), glusPerlinLoad4(remainder[1]), glusPerlinLoad4(remainder[2]), currentPeriod, hashSeed);
+			}
+			else
+			{
+				noise = glusPerlinSimplexNoise4(glusPerlinLoad4(remainder[0]), glusPerlinLoad4(remainder[1]), glusPerlinLoad4(remainder[2]), hashSeed);
+			}
 
-		GLUSfloat currentFrequency = frequency * frequencyFactor;
-		GLUSfloat currentAmplitude = amplitude / (1.0f * amplitudeFactor);
+			glusPerlinStore4(remainder[3], noise);
 
-		if (currentFrequency <= 1.0f)
+			for (k = 0; i + k < number; k++)
+			{
+				result[i + k] = remainder[3][k];
+			}
+		}
+	}
+#else
+	for (i = 0; i < number; i++)
+	{
+		if (type == GLUS_PERLIN_GRADIENT)
 		{
-			currentFrequency = 1.0f;
+			result[i] = glusPerlinGradientNoise3f(x[i], y[i], z[i], currentPeriod, seed);
 		}
-
-		waveLenghtX = width / (GLUSint)currentFrequency;
-		waveLenghtY = height / (GLUSint)currentFrequency;
-
-		if (waveLenghtX < 1)
+		else
 		{
-			waveLenghtX = 1;
+			result[i] = glusPerlinSimplexNoise3f(x[i], y[i], z[i], seed);
 		}
-		if (waveLenghtY < 1)
+	}
+#endif
+
+	return GLUS_TRUE;
+}
+
+static GLUSint glusPerlinGetCells(const GLUSfloat frequency, const GLUSint size)
+{
+	GLUSint cells = frequency >= 1.0f ? (GLUSint)frequency : 1;
+
+	return cells < size ? cells : size;
+}
+
+/**
+ * Sums the octaves for one row of the texture.
+ */
+static GLUSvoid glusPerlinCreateRow(GLUSvoid* data, const GLUSint tile)
+{
+	const GLUSperlinwork* work = (const GLUSperlinwork*)data;
+
+	GLUSfloat x[GLUS_PERLIN_BATCH], y[GLUS_PERLIN_BATCH], z[GLUS_PERLIN_BATCH];
+	GLUSfloat noise[GLUS_PERLIN_BATCH], sum[GLUS_PERLIN_BATCH];
+
+	GLUSint period[3];
+
+	GLUSfloat currentFrequency, currentAmplitude, value, scaleX, currentY, currentZ;
+
+	GLUSint i, start, number, octave, index;
+
+	GLUSint row = tile % work->height;
+	GLUSint layer = tile / work->height;
+
+	for (start = 0; start < work->width; start += GLUS_PERLIN_BATCH)
+	{
+		number = work->width - start < GLUS_PERLIN_BATCH ? work->width - start : GLUS_PERLIN_BATCH;
+
+		for (i = 0; i < number; i++)
 		{
-			waveLenghtY = 1;
+			sum[i] = 0.0f;
 		}
 
-		// Render per wavelength
-		for (y = 0; y < height; y += waveLenghtY)
+		currentFrequency = work->frequency;
+		currentAmplitude = 1.0f;
+
+		for (octave = 0; octave < work->octaves; octave++)
 		{
-			for (x = 0; x < width; x += waveLenghtX)
-			{
-				GLUSint xInner, yInner;
+			period[0] = glusPerlinGetCells(currentFrequency, work->width);
+			period[1] = glusPerlinGetCells(currentFrequency, work->height);
+			period[2] = glusPerlinGetCells(currentFrequency, work->depth);
 
-				GLUSfloat p[4];
+			// Sampling at the texel centers, as the gradient noise is zero at the lattice points.
+			scaleX = (GLUSfloat)period[0] / (GLUSfloat)work->width;
+			currentY = ((GLUSfloat)row + 0.5f) * (GLUSfloat)period[1] / (GLUSfloat)work->height;
+			currentZ = ((GLUSfloat)layer + 0.5f) * (GLUSfloat)period[2] / (GLUSfloat)work->depth;
 
-				GLUSint xRandom = x / waveLenghtX;
-				GLUSint yRandom = y / waveLenghtY;
+			for (i = 0; i < number; i++)
+			{
+				x[i] = ((GLUSfloat)(start + i) + 0.5f) * scaleX;
+				y[i] = currentY;
+				z[i] = currentZ;
+			}
 
-				// Get random values from adjacent points
-				p[0] = glusPerlinGetNoiseValue2D(image, xRandom, yRandom, (GLUSint)currentAmplitude, data2D);
-				p[1] = glusPerlinGetNoiseValue2D(image, xRandom + 1, yRandom, (GLUSint)currentAmplitude, data2D);
-				p[2] = glusPerlinGetNoiseValue2D(image, xRandom, yRandom + 1, (GLUSint)currentAmplitude, data2D);
-				p[3] = glusPerlinGetNoiseValue2D(image, xRandom + 1, yRandom + 1, (GLUSint)currentAmplitude, data2D);
+			glusPerlinNoise3fv(noise, x, y, z, number, work->type, period, work->seed + (GLUSuint)octave);
 
-				// Sample the points in the wavelength area
-				for (yInner = 0; yInner < waveLenghtY && y + yInner < height; yInner++)
-				{
-					for (xInner = 0; xInner < waveLenghtX && x + xInner < width; xInner++)
-					{
-						GLUSint index = (y + yInner) * width + x + xInner;
+			for (i = 0; i < number; i++)
+			{
+				sum[i] += noise[i] * currentAmplitude;
+			}
 
-						GLUSfloat x0 = glusPerlinGetInterpolatedValue(p[0], p[1], (GLUSfloat)xInner / (GLUSfloat)waveLenghtX);
-						GLUSfloat x1 = glusPerlinGetInterpolatedValue(p[2], p[3], (GLUSfloat)xInner / (GLUSfloat)waveLenghtX);
+			currentFrequency *= 2.0f;
+			currentAmplitude *= work->persistence;
+		}
 
-						data[index] += glusPerlinGetInterpolatedValue(x0, x1, (GLUSfloat)yInner / (GLUSfloat)waveLenghtY);
-					}
-				}
+		index = (layer * work->height + row) * work->width + start;
+
+		if (work->hdrData)
+		{
+			for (i = 0; i < number; i++)
+			{
+				work->hdrData[index + i] = sum[i];
 			}
 		}
+		else
+		{
+			for (i = 0; i < number; i++)
+			{
+				value = work->scale * (sum[i] + work->bias);
 
-		frequencyFactor *= 2.0f;
-		amplitudeFactor *= 1.0f / persistence;
+				work->tgaData[index + i] = (GLUSubyte)(value < 0.0f ? 0.0f : (value > 255.0f ? 255.0f : value));
+			}
+		}
 	}
+}
+
+GLUSboolean GLUSAPIENTRY glusPerlinCreateNoiseHdr(GLUShdrimage* image, const GLUSint width, const GLUSint height, const GLUSint depth, const GLUSenum type, const GLUSfloat frequency, const GLUSfloat persistence, const GLUSint octaves, const GLUSuint seed, const GLUSint numberThreads)
+{
+	GLUSperlinwork work;
 
-	glusMemoryFree(data2D);
+	if (!image || octaves < 0 || (type != GLUS_PERLIN_GRADIENT && type != GLUS_PERLIN_SIMPLEX))
+	{
+		return GLUS_FALSE;
+	}
 
-	for (i = 0; i < width * height; i++)
+	if (!glusImageCreateHdr(image, width, height, depth, GLUS_SINGLE_CHANNEL))
 	{
-		image->data[i] = (GLUSubyte)data[i];
+		return GLUS_FALSE;
 	}
 
-	glusMemoryFree(data);
+	work.hdrData = image->data;
+	work.tgaData = 0;
+	work.width = width;
+	work.height = height;
+	work.depth = depth;
+	work.type = type;
+	work.frequency = frequency;
+	work.persistence = persistence;
+	work.octaves = octaves;
+	work.seed = seed;
+	work.scale = 1.0f;
+	work.bias = 0.0f;
+
+	if (!_glusThreadRunTiles(height * depth, numberThreads, glusPerlinCreateRow, &work))
+	{
+		glusImageDestroyHdr(image);
+
+		return GLUS_FALSE;
+	}
 
 	return GLUS_TRUE;
 }
 
-GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise3D(GLUStgaimage* image, const GLUSint width, const GLUSint height, const GLUSint depth, const GLUSint seed, const GLUSfloat frequency, const GLUSfloat amplitude, const GLUSfloat persistence, const GLUSint octaves)
+static GLUSboolean glusPerlinCreateNoiseTga(GLUStgaimage* image, const GLUSint width, const GLUSint height, const GLUSint depth, const GLUSint seed, const GLUSfloat frequency, const GLUSfloat amplitude, const GLUSfloat persistence, const GLUSint octaves)
 {
-	GLUSint i;
+	GLUSperlinwork work;
 
-	GLUSfloat* data;
-	GLUSint* data3D;
+	GLUSfloat currentAmplitude;
 
-	GLUSfloat frequencyFactor;
-	GLUSfloat amplitudeFactor;
+	GLUSint i;
 
 	if (!image)
 	{
@@ -403,140 +966,51 @@ GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise3D(GLUStgaimage* image, const GLUS
 		return GLUS_FALSE;
 	}
 
-	data = glusMemoryMalloc(width * height * depth * sizeof(GLUSfloat));
+	work.hdrData = 0;
+	work.tgaData = image->data;
+	work.width = width;
+	work.height = height;
+	work.depth = depth;
+	work.type = GLUS_PERLIN_GRADIENT;
+	work.frequency = frequency;
+	work.persistence = persistence;
+	work.octaves = octaves;
+	work.seed = (GLUSuint)seed;
 
-	if (!data)
-	{
-		glusImageDestroyTga(image);
+	// Each octave is mapped from [-1.0, 1.0] to [0.0, amplitude * persistence^(octave + 1)].
+	work.scale = 0.5f * amplitude * persistence;
+	work.bias = 0.0f;
 
-		return GLUS_FALSE;
-	}
+	currentAmplitude = 1.0f;
 
-	for (i = 0; i < width * height * depth; i++)
+	for (i = 0; i < octaves; i++)
 	{
-		data[i] = 0.0f;
-	}
-
-	//
+		work.bias += currentAmplitude;
 
-	data3D = glusMemoryMalloc(width * height * depth * sizeof(GLUSint));
+		currentAmplitude *= persistence;
+	}
 
-	if (!data3D)
+	if (!_glusThreadRunTiles(height * depth, 0, glusPerlinCreateRow, &work))
 	{
 		glusImageDestroyTga(image);
 
-		glusMemoryFree(data);
-
 		return GLUS_FALSE;
 	}
 
-	srand(seed);
-	for (i = 0; i < width * height * depth; i++)
-	{
-		data3D[i] = rand();
-	}
-
-	//
-
-	frequencyFactor = 1.0f;
-	amplitudeFactor = 1.0f / persistence;
-
-	for (i = 0; i < octaves; i++)
-	{
-		GLUSint x, y, z;
-
-		GLUSint waveLenghtX;
-		GLUSint waveLenghtY;
-		GLUSint waveLenghtZ;
-
-		GLUSfloat currentFrequency = frequency * frequencyFactor;
-		GLUSfloat currentAmplitude = amplitude / (1.0f * amplitudeFactor);
-
-		if (currentFrequency <= 1.0f)
-		{
-			currentFrequency = 1.0f;
-		}
-
-		waveLenghtX = width / (GLUSint)currentFrequency;
-		waveLenghtY = height / (GLUSint)currentFrequency;
-		waveLenghtZ = depth / (GLUSint)currentFrequency;
-
-		if (waveLenghtX < 1)
-		{
-			waveLenghtX = 1;
-		}
-		if (waveLenghtY < 1)
-		{
-			waveLenghtY = 1;
-		}
-		if (waveLenghtZ < 1)
-		{
-			waveLenghtZ = 1;
-		}
-
-		// Render per wavelength
-		for (z = 0; z < depth; z += waveLenghtZ)
-		{
-			for (y = 0; y < height; y += waveLenghtY)
-			{
-				for (x = 0; x < width; x += waveLenghtX)
-				{
-					GLUSint xInner, yInner, zInner;
-
-					GLUSfloat p[8];
-
-					GLUSint xRandom = x / waveLenghtX;
-					GLUSint yRandom = y / waveLenghtY;
-					GLUSint zRandom = z / waveLenghtZ;
-
-					// Get random values from adjacent points
-					p[0] = glusPerlinGetNoiseValue3D(image, xRandom, yRandom, zRandom, (GLUSint)currentAmplitude, data3D);
-					p[1] = glusPerlinGetNoiseValue3D(image, xRandom + 1, yRandom, zRandom, (GLUSint)currentAmplitude, data3D);
-					p[2] = glusPerlinGetNoiseValue3D(image, xRandom, yRandom + 1, zRandom, (GLUSint)currentAmplitude, data3D);
-					p[3] = glusPerlinGetNoiseValue3D(image, xRandom + 1, yRandom + 1, zRandom, (GLUSint)currentAmplitude, data3D);
-
-					p[4] = glusPerlinGetNoiseValue3D(image, xRandom, yRandom, zRandom + 1, (GLUSint)currentAmplitude, data3D);
-					p[5] = glusPerlinGetNoiseValue3D(image, xRandom + 1, yRandom, zRandom + 1, (GLUSint)currentAmplitude, data3D);
-					p[6] = glusPerlinGetNoiseValue3D(image, xRandom, yRandom + 1, zRandom + 1, (GLUSint)currentAmplitude, data3D);
-					p[7] = glusPerlinGetNoiseValue3D(image, xRandom + 1, yRandom + 1, zRandom + 1, (GLUSint)currentAmplitude, data3D);
-
-					// Sample the points in the wavelength area
-					for (zInner = 0; zInner < waveLenghtZ && z + zInner < depth; zInner++)
-					{
-						for (yInner = 0; yInner < waveLenghtY && y + yInner < height; yInner++)
-						{
-							for (xInner = 0; xInner < waveLenghtX && x + xInner < width; xInner++)
-							{
-								GLUSint index = (z + zInner) * height * width + (y + yInner) * width + x + xInner;
-
-								GLUSfloat x0 = glusPerlinGetInterpolatedValue(p[0], p[1], (GLUSfloat)xInner / (GLUSfloat)waveLenghtX);
-								GLUSfloat x1 = glusPerlinGetInterpolatedValue(p[2], p[3], (GLUSfloat)xInner / (GLUSfloat)waveLenghtX);
-								GLUSfloat x2 = glusPerlinGetInterpolatedValue(p[4], p[5], (GLUSfloat)xInner / (GLUSfloat)waveLenghtX);
-								GLUSfloat x3 = glusPerlinGetInterpolatedValue(p[6], p[7], (GLUSfloat)xInner / (GLUSfloat)waveLenghtX);
-
-								GLUSfloat y0 = glusPerlinGetInterpolatedValue(x0, x1, (GLUSfloat)yInner / (GLUSfloat)waveLenghtY);
-								GLUSfloat y1 = glusPerlinGetInterpolatedValue(x2, x3, (GLUSfloat)yInner / (GLUSfloat)waveLenghtY);
-
-								data[index] += glusPerlinGetInterpolatedValue(y0, y1, (GLUSfloat)zInner / (GLUSfloat)waveLenghtZ);
-							}
-						}
-					}
-				}
-			}
-		}
-
-		frequencyFactor *= 2.0f;
-		amplitudeFactor *= 1.0f / persistence;
-	}
-
-	glusMemoryFree(data3D);
+	return GLUS_TRUE;
+}
 
-	for (i = 0; i < width * height * depth; i++)
-	{
-		image->data[i] = (GLUSubyte)data[i];
-	}
+GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise1D(GLUStgaimage* image, const GLUSint width, const GLUSint seed, const GLUSfloat frequency, const GLUSfloat amplitude, const GLUSfloat persistence, const GLUSint octaves)
+{
+	return glusPerlinCreateNoiseTga(image, width, 1, 1, seed, frequency, amplitude, persistence, octaves);
+}
 
-	glusMemoryFree(data);
+GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise2D(GLUStgaimage* image, const GLUSint width, const GLUSint height, const GLUSint seed, const GLUSfloat frequency, const GLUSfloat amplitude, const GLUSfloat persistence, const GLUSint octaves)
+{
+	return glusPerlinCreateNoiseTga(image, width, height, 1, seed, frequency, amplitude, persistence, octaves);
+}
 
-	return GLUS_TRUE;
+GLUSboolean GLUSAPIENTRY glusPerlinCreateNoise3D(GLUStgaimage* image, const GLUSint width, const GLUSint height, const GLUSint depth, const GLUSint seed, const GLUSfloat frequency, const GLUSfloat amplitude, const GLUSfloat persistence, const GLUSint octaves)
+{
+	return glusPerlinCreateNoiseTga(image, width, height, depth, seed, frequency, amplitude, persistence, octaves);
 }
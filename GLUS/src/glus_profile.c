@@ -15,11 +15,174 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#endif
+
 #include "GL/glus.h"
 
+// Zones per thread buffer. Has to be a power of two.
+#define GLUS_PROFILE_BUFFER_SIZE 4096
+
+// Deeper nested zones are not recorded.
+#define GLUS_PROFILE_MAX_DEPTH 64
+
+#define GLUS_PROFILE_DEFAULT_EVENTS (256*1024)
+
+#if defined(_MSC_VER)
+#define GLUS_PROFILE_THREAD_LOCAL __declspec(thread)
+#else
+#define GLUS_PROFILE_THREAD_LOCAL __thread
+#endif
+
+extern GLUSuint64 _glusThreadGetRawTimeNanoseconds(GLUSvoid);
+
+/**
+ * One left zone.
+ */
+typedef struct _GLUSprofileevent
+{
+	const GLUSchar* name;
+
+	GLUSuint64 start;
+
+	GLUSuint64 duration;
+
+	GLUSint thread;
+
+	GLUSint depth;
+
+} GLUSprofileevent;
+
+/**
+ * Buffer of one thread. Only the owning thread writes zones and advances the head, only the flush advances the tail.
+ */
+typedef struct _GLUSprofilethread
+{
+	GLUSprofileevent events[GLUS_PROFILE_BUFFER_SIZE];
+
+	volatile GLUSuint head;
+
+	volatile GLUSuint tail;
+
+	/**
+	 * Set, when the owning thread ended. The buffer is reused after it has been flushed.
+	 */
+	volatile GLUSint released;
+
+	/**
+	 * Zones started with an older generation are ignored.
+	 */
+	GLUSint generation;
+
+	GLUSint id;
+
+	const GLUSchar* names[GLUS_PROFILE_MAX_DEPTH];
+
+	GLUSuint64 starts[GLUS_PROFILE_MAX_DEPTH];
+
+	GLUSint depth;
+
+	struct _GLUSprofilethread* next;
+
+} GLUSprofilethread;
+
 static GLUSfloat passedTime = 0.0f;
 static GLUSint passedFrames = 0;
 
+static volatile GLUSint g_running = GLUS_FALSE;
+
+/**
+ * Incremented on every start.
+ */
+static volatile GLUSint g_generation = 0;
+
+/**
+ * Lock for the thread lists and the collected zones.
+ */
+static volatile GLUSint g_lock = 0;
+
+static GLUSprofilethread* g_usedThreads = 0;
+static GLUSprofilethread* g_freeThreads = 0;
+static GLUSint g_numberThreads = 0;
+
+static GLUSprofileevent* g_events = 0;
+static GLUSint g_numberEvents = 0;
+static GLUSint g_maxEvents = 0;
+
+static volatile GLUSint g_droppedZones = 0;
+
+static GLUSuint64 g_startTime = 0;
+
+static GLUS_PROFILE_THREAD_LOCAL GLUSprofilethread* g_thread = 0;
+
+static GLUSint glusProfileLoad(volatile GLUSint* value)
+{
+#ifdef _WIN32
+	GLUSint result = *value;
+
+	_ReadWriteBarrier();
+
+	return result;
+#else
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static GLUSvoid glusProfileStore(volatile GLUSint* value, GLUSint newValue)
+{
+#ifdef _WIN32
+	InterlockedExchange((volatile LONG*)value, newValue);
+#else
+	__atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+#endif
+}
+
+static GLUSuint glusProfileLoadIndex(volatile GLUSuint* value)
+{
+	return (GLUSuint)glusProfileLoad((volatile GLUSint*)value);
+}
+
+static GLUSvoid glusProfileStoreIndex(volatile GLUSuint* value, GLUSuint newValue)
+{
+	glusProfileStore((volatile GLUSint*)value, (GLUSint)newValue);
+}
+
+static GLUSvoid glusProfileCountDropped(GLUSvoid)
+{
+#ifdef _WIN32
+	InterlockedIncrement((volatile LONG*)&g_droppedZones);
+#else
+	__atomic_add_fetch(&g_droppedZones, 1, __ATOMIC_RELAXED);
+#endif
+}
+
+static GLUSvoid glusProfileLock(GLUSvoid)
+{
+#ifdef _WIN32
+	while (InterlockedExchange((volatile LONG*)&g_lock, 1))
+	{
+		SwitchToThread();
+	}
+#else
+	while (__atomic_exchange_n(&g_lock, 1, __ATOMIC_ACQUIRE))
+	{
+		sched_yield();
+	}
+#endif
+}
+
+static GLUSvoid glusProfileUnlock(GLUSvoid)
+{
+#ifdef _WIN32
+	InterlockedExchange((volatile LONG*)&g_lock, 0);
+#else
+	__atomic_store_n(&g_lock, 0, __ATOMIC_RELEASE);
+#endif
+}
+
 GLUSvoid GLUSAPIENTRY glusProfileResetFPSf()
 {
 	passedTime = 0.0f;
@@ -50,3 +213,566 @@ GLUSboolean GLUSAPIENTRY glusProfileUpdateFPSf(GLUSfloat time, GLUSuint* frames)
 	return GLUS_FALSE;
 }
 
+/**
+ * Moves all zones of the thread buffers to the collected ones. Called with the lock held.
+ */
+static GLUSvoid glusProfileCollect(GLUSvoid)
+{
+	GLUSprofilethread** walker = &g_usedThreads;
+	GLUSprofilethread* thread;
+
+	GLUSuint head, tail;
+
+	while (*walker)
+	{
+		thread = *walker;
+
+		// Read the released flag first, so all zones of an ended thread are visible.
+		if (glusProfileLoad(&thread->released))
+		{
+			head = thread->head;
+		}
+		else
+		{
+			head = glusProfileLoadIndex(&thread->head);
+		}
+
+		tail = thread->tail;
+
+		while (tail != head)
+		{
+			if (g_numberEvents < g_maxEvents)
+			{
+				g_events[g_numberEvents++] = thread->events[tail & (GLUS_PROFILE_BUFFER_SIZE - 1)];
+			}
+			else
+			{
+				glusProfileCountDropped();
+			}
+
+			tail++;
+		}
+
+		glusProfileStoreIndex(&thread->tail, tail);
+
+		if (thread->released)
+		{
+			*walker = thread->next;
+
+			thread->head = 0;
+			thread->tail = 0;
+			thread->released = GLUS_FALSE;
+			thread->depth = 0;
+
+			thread->next = g_freeThreads;
+			g_freeThreads = thread;
+
+			continue;
+		}
+
+		walker = &thread->next;
+	}
+}
+
+static GLUSprofilethread* glusProfileAcquireThread(GLUSvoid)
+{
+	GLUSprofilethread* thread;
+
+	glusProfileLock();
+
+	thread = g_freeThreads;
+
+	if (thread)
+	{
+		g_freeThreads = thread->next;
+	}
+	else
+	{
+		thread = (GLUSprofilethread*)glusMemoryMalloc(sizeof(GLUSprofilethread));
+
+		if (thread)
+		{
+			memset(thread, 0, sizeof(GLUSprofilethread));
+
+			thread->id = g_numberThreads++;
+		}
+	}
+
+	if (thread)
+	{
+		thread->next = g_usedThreads;
+		g_usedThreads = thread;
+	}
+
+	glusProfileUnlock();
+
+	return thread;
+}
+
+GLUSvoid _glusProfileReleaseThread(GLUSvoid)
+{
+	if (!g_thread)
+	{
+		return;
+	}
+
+	glusProfileStore(&g_thread->released, GLUS_TRUE);
+
+	g_thread = 0;
+}
+
+GLUSboolean GLUSAPIENTRY glusProfileStart(const GLUSint maxEvents)
+{
+	GLUSint numberEvents = maxEvents > 0 ? maxEvents : GLUS_PROFILE_DEFAULT_EVENTS;
+
+	glusProfileStop();
+
+	glusProfileLock();
+
+	// Discard zones of the last recording, which are still in the thread buffers.
+	g_numberEvents = 0;
+	g_maxEvents = 0;
+
+	glusProfileCollect();
+
+	if (g_events)
+	{
+		glusMemoryFree(g_events);
+	}
+
+	g_events = (GLUSprofileevent*)glusMemoryMalloc(numberEvents * sizeof(GLUSprofileevent));
+
+	if (!g_events)
+	{
+		glusProfileUnlock();
+
+		return GLUS_FALSE;
+	}
+
+	g_maxEvents = numberEvents;
+
+	glusProfileStore(&g_droppedZones, 0);
+
+	g_startTime = _glusThreadGetRawTimeNanoseconds();
+
+	glusProfileStore(&g_generation, g_generation + 1);
+
+	glusProfileStore(&g_running, GLUS_TRUE);
+
+	glusProfileUnlock();
+
+	return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusProfileStop(GLUSvoid)
+{
+	glusProfileStore(&g_running, GLUS_FALSE);
+
+	glusProfileFlush();
+}
+
+GLUSvoid GLUSAPIENTRY glusProfileClear(GLUSvoid)
+{
+	glusProfileStop();
+
+	glusProfileLock();
+
+	g_maxEvents = 0;
+
+	glusProfileCollect();
+
+	if (g_events)
+	{
+		glusMemoryFree(g_events);
+
+		g_events = 0;
+	}
+
+	g_numberEvents = 0;
+
+	glusProfileStore(&g_droppedZones, 0);
+
+	glusProfileUnlock();
+}
+
+GLUSboolean GLUSAPIENTRY glusProfileIsRunning(GLUSvoid)
+{
+	return (GLUSboolean)glusProfileLoad(&g_running);
+}
+
+GLUSvoid GLUSAPIENTRY glusProfileBegin(const GLUSchar* name)
+{
+	GLUSprofilethread* thread;
+
+	GLUSint generation;
+
+	if (!glusProfileLoad(&g_running))
+	{
+		return;
+	}
+
+	thread = g_thread;
+
+	if (!thread)
+	{
+		thread = glusProfileAcquireThread();
+
+		if (!thread)
+		{
+			return;
+		}
+
+		g_thread = thread;
+	}
+
+	generation = glusProfileLoad(&g_generation);
+
+	// Zones still open from a former recording are not left anymore.
+	if (thread->generation != generation)
+	{
+		thread->generation = generation;
+
+		thread->depth = 0;
+	}
+
+	if (thread->depth < GLUS_PROFILE_MAX_DEPTH)
+	{
+		thread->names[thread->depth] = name;
+		thread->starts[thread->depth] = _glusThreadGetRawTimeNanoseconds();
+	}
+
+	thread->depth++;
+}
+
+GLUSvoid GLUSAPIENTRY glusProfileEnd(GLUSvoid)
+{
+	GLUSprofilethread* thread = g_thread;
+
+	GLUSprofileevent* event;
+
+	GLUSuint64 end;
+
+	GLUSuint head;
+
+	if (!thread || thread->depth == 0)
+	{
+		return;
+	}
+
+	end = _glusThreadGetRawTimeNanoseconds();
+
+	thread->depth--;
+
+	if (thread->depth >= GLUS_PROFILE_MAX_DEPTH || !glusProfileLoad(&g_running) || thread->generation != glusProfileLoad(&g_generation))
+	{
+		return;
+	}
+
+	head = thread->head;
+
+	if (head - glusProfileLoadIndex(&thread->tail) >= GLUS_PROFILE_BUFFER_SIZE)
+	{
+		glusProfileCountDropped();
+
+		return;
+	}
+
+	event = &thread->events[head & (GLUS_PROFILE_BUFFER_SIZE - 1)];
+
+	event->name = thread->names[thread->depth];
+	event->start = thread->starts[thread->depth];
+	event->duration = end - thread->starts[thread->depth];
+	event->thread = thread->id;
+	event->depth = thread->depth;
+
+	// Publish the zone to the flush.
+	glusProfileStoreIndex(&thread->head, head + 1);
+}
+
+GLUSvoid GLUSAPIENTRY glusProfileFlush(GLUSvoid)
+{
+	if (!g_events)
+	{
+		return;
+	}
+
+	glusProfileLock();
+
+	glusProfileCollect();
+
+	glusProfileUnlock();
+}
+
+GLUSint GLUSAPIENTRY glusProfileGetDroppedZones(GLUSvoid)
+{
+	return glusProfileLoad(&g_droppedZones);
+}
+
+static int glusProfileCompareEvents(const void* first, const void* second)
+{
+	const GLUSprofileevent* event0 = (const GLUSprofileevent*)first;
+	const GLUSprofileevent* event1 = (const GLUSprofileevent*)second;
+
+	int result = strcmp(event0->name, event1->name);
+
+	if (result != 0)
+	{
+		return result;
+	}
+
+	if (event0->duration < event1->duration)
+	{
+		return -1;
+	}
+
+	return event0->duration > event1->duration ? 1 : 0;
+}
+
+static int glusProfileCompareZones(const void* first, const void* second)
+{
+	const GLUSprofilezone* zone0 = (const GLUSprofilezone*)first;
+	const GLUSprofilezone* zone1 = (const GLUSprofilezone*)second;
+
+	if (zone0->total > zone1->total)
+	{
+		return -1;
+	}
+
+	return zone0->total < zone1->total ? 1 : 0;
+}
+
+/**
+ * Calculates the statistics of all zones. Called with the lock held.
+ */
+static GLUSint glusProfileCreateZones(GLUSprofilezone** zones)
+{
+	GLUSprofileevent* sorted;
+
+	GLUSprofilezone* zone;
+
+	GLUSint numberZones = 0;
+
+	GLUSint i, first;
+
+	*zones = 0;
+
+	if (g_numberEvents == 0)
+	{
+		return 0;
+	}
+
+	sorted = (GLUSprofileevent*)glusMemoryMalloc(g_numberEvents * sizeof(GLUSprofileevent));
+
+	if (!sorted)
+	{
+		return -1;
+	}
+
+	memcpy(sorted, g_events, g_numberEvents * sizeof(GLUSprofileevent));
+
+	// Sorted by name and duration, so each zone is a range with ascending times.
+	qsort(sorted, g_numberEvents, sizeof(GLUSprofileevent), glusProfileCompareEvents);
+
+	for (i = 0; i < g_numberEvents; i++)
+	{
+		if (i == 0 || strcmp(sorted[i].name, sorted[i - 1].name) != 0)
+		{
+			numberZones++;
+		}
+	}
+
+	*zones = (GLUSprofilezone*)glusMemoryMalloc(numberZones * sizeof(GLUSprofilezone));
+
+	if (!*zones)
+	{
+		glusMemoryFree(sorted);
+
+		return -1;
+	}
+
+	zone = *zones;
+
+	first = 0;
+
+	for (i = 1; i <= g_numberEvents; i++)
+	{
+		if (i < g_numberEvents && strcmp(sorted[i].name, sorted[first].name) == 0)
+		{
+			continue;
+		}
+
+		zone->name = sorted[first].name;
+		zone->count = i - first;
+		zone->minimum = sorted[first].duration;
+		zone->maximum = sorted[i - 1].duration;
+
+		// Nearest rank.
+		zone->percentile99 = sorted[first + (zone->count * 99 + 99) / 100 - 1].duration;
+
+		zone->total = 0;
+		for (; first < i; first++)
+		{
+			zone->total += sorted[first].duration;
+		}
+
+		zone->average = zone->total / zone->count;
+
+		zone++;
+	}
+
+	glusMemoryFree(sorted);
+
+	qsort(*zones, numberZones, sizeof(GLUSprofilezone), glusProfileCompareZones);
+
+	return numberZones;
+}
+
+GLUSint GLUSAPIENTRY glusProfileGetZones(GLUSprofilezone* zones, const GLUSint maxZones)
+{
+	GLUSprofilezone* allZones;
+
+	GLUSint numberZones;
+
+	glusProfileFlush();
+
+	glusProfileLock();
+
+	numberZones = glusProfileCreateZones(&allZones);
+
+	glusProfileUnlock();
+
+	if (numberZones <= 0)
+	{
+		return 0;
+	}
+
+	if (zones && maxZones > 0)
+	{
+		memcpy(zones, allZones, (numberZones < maxZones ? numberZones : maxZones) * sizeof(GLUSprofilezone));
+	}
+
+	glusMemoryFree(allZones);
+
+	return numberZones;
+}
+
+GLUSvoid GLUSAPIENTRY glusProfileLogZones(GLUSvoid)
+{
+	GLUSprofilezone* zones;
+
+	GLUSint numberZones, i;
+
+	glusProfileFlush();
+
+	glusProfileLock();
+
+	numberZones = glusProfileCreateZones(&zones);
+
+	glusProfileUnlock();
+
+	if (numberZones <= 0)
+	{
+		return;
+	}
+
+	glusLogPrint(GLUS_LOG_INFO, "Zone: count, min, avg, p99, max, total [ms]");
+
+	for (i = 0; i < numberZones; i++)
+	{
+		glusLogPrint(GLUS_LOG_INFO, "%s: %d, %.3f, %.3f, %.3f, %.3f, %.3f", zones[i].name, zones[i].count, (GLUSdouble)zones[i].minimum / 1000000.0, (GLUSdouble)zones[i].average / 1000000.0, (GLUSdouble)zones[i].percentile99 / 1000000.0, (GLUSdouble)zones[i].maximum / 1000000.0, (GLUSdouble)zones[i].total / 1000000.0);
+	}
+
+	if (glusProfileGetDroppedZones() > 0)
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Dropped zones: %d", glusProfileGetDroppedZones());
+	}
+
+	glusMemoryFree(zones);
+}
+
+static GLUSboolean glusProfileWriteName(FILE* file, const GLUSchar* name)
+{
+	// Escape, what is not allowed in a JSON string.
+	for (; *name; name++)
+	{
+		if (*name == '"' || *name == '\\')
+		{
+			if (fprintf(file, "\\%c", *name) < 0)
+			{
+				return GLUS_FALSE;
+			}
+		}
+		else if ((GLUSubyte)*name < 0x20)
+		{
+			if (fprintf(file, "\\u%04x", (GLUSuint)(GLUSubyte)*name) < 0)
+			{
+				return GLUS_FALSE;
+			}
+		}
+		else if (fputc(*name, file) == EOF)
+		{
+			return GLUS_FALSE;
+		}
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusProfileSaveChromeTrace(const GLUSchar* filename)
+{
+	FILE* file;
+
+	GLUSprofileevent* event;
+
+	GLUSboolean result = GLUS_TRUE;
+
+	GLUSint i;
+
+	if (!filename)
+	{
+		return GLUS_FALSE;
+	}
+
+	file = glusFileOpen(filename, "w");
+
+	if (!file)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not open file '%s'", filename);
+
+		return GLUS_FALSE;
+	}
+
+	glusProfileFlush();
+
+	glusProfileLock();
+
+	result = fprintf(file, "{\"traceEvents\":[\n") >= 0;
+
+	// Complete events with microseconds since the start of the recording.
+	for (i = 0; i < g_numberEvents && result; i++)
+	{
+		event = &g_events[i];
+
+		result = fprintf(file, "%s{\"name\":\"", i > 0 ? ",\n" : "") >= 0;
+
+		result = result && glusProfileWriteName(file, event->name);
+
+		result = result && fprintf(file, "\",\"cat\":\"glus\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}", (GLUSdouble)(event->start - g_startTime) / 1000.0, (GLUSdouble)event->duration / 1000.0, event->thread) >= 0;
+	}
+
+	glusProfileUnlock();
+
+	result = result && fprintf(file, "\n]}\n") >= 0;
+
+	if (glusFileClose(file) != 0)
+	{
+		result = GLUS_FALSE;
+	}
+
+	if (!result)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not write file '%s'", filename);
+	}
+
+	return result;
+}
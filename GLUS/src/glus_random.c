@@ -17,29 +17,88 @@
 
 #include "GL/glus.h"
 
-#define GLUS_UNIFORM_RANDOM_BIAS 0.0000001f
+// 2^-24, as the upper 24 bits of a random value fill the mantissa of a float.
+#define GLUS_RANDOM_FLOAT_FACTOR (1.0f / 16777216.0f)
 
-GLUSvoid GLUSAPIENTRY glusRandomSetSeed(const GLUSuint seed)
+#if defined(_MSC_VER)
+#define GLUS_RANDOM_THREAD_LOCAL __declspec(thread)
+#else
+#define GLUS_RANDOM_THREAD_LOCAL __thread
+#endif
+
+// Shared state, one per thread, so workers do not race. Initialized as seeded with one, like rand().
+static GLUS_RANDOM_THREAD_LOCAL GLUSrandomstate g_randomState = { { 0x89025CC1, 0x910A2DEC, 0x658EEC67, 0xBEEB8DA1 } };
+
+static GLUSuint glusRandomRotate(const GLUSuint value, const GLUSint bits)
 {
-	srand(seed);
+	return (value << bits) | (value >> (32 - bits));
 }
 
-GLUSfloat GLUSAPIENTRY glusRandomUniformf(const GLUSfloat start, const GLUSfloat end)
+// see http://prng.di.unimi.it/xoshiro128starstar.c
+
+static GLUSuint glusRandomNext(GLUSuint state[4])
 {
-	return ((GLUSfloat)rand() / (GLUSfloat)RAND_MAX) * (end - start) + start;
+	GLUSuint result = glusRandomRotate(state[1] * 5, 7) * 9;
+	GLUSuint t = state[1] << 9;
+
+	state[2] ^= state[0];
+	state[3] ^= state[1];
+	state[1] ^= state[2];
+	state[0] ^= state[3];
+
+	state[2] ^= t;
+
+	state[3] = glusRandomRotate(state[3], 11);
+
+	return result;
+}
+
+/**
+ * Uniform value in the range ]0.0, 1.0], so it can be passed to logf.
+ */
+static GLUSfloat glusRandomOpenZerof(GLUSuint state[4])
+{
+	return (GLUSfloat)((glusRandomNext(state) >> 8) + 1) * GLUS_RANDOM_FLOAT_FACTOR;
 }
 
 // see http://mathworld.wolfram.com/Box-MullerTransformation.html
 
-GLUSfloat GLUSAPIENTRY glusRandomNormalf(const GLUSfloat mean, const GLUSfloat standardDeviation)
+static GLUSvoid glusRandomBoxMuller(GLUSfloat result[2], GLUSuint state[4], const GLUSfloat mean, const GLUSfloat standardDeviation)
+{
+	GLUSfloat radius, angle;
+
+	radius = standardDeviation * sqrtf(-2.0f * logf(glusRandomOpenZerof(state)));
+	angle = 2.0f * GLUS_PI * (GLUSfloat)(glusRandomNext(state) >> 8) * GLUS_RANDOM_FLOAT_FACTOR;
+
+	result[0] = mean + radius * cosf(angle);
+	result[1] = mean + radius * sinf(angle);
+}
+
+static GLUSuint glusRandomReverseBits(GLUSuint value)
+{
+	// Revert bits by swapping blockwise. Lower bits are moved up and higher bits down.
+	value = (value << 16u) | (value >> 16u);
+	value = ((value & 0x00ff00ffu) << 8u) | ((value & 0xff00ff00u) >> 8u);
+	value = ((value & 0x0f0f0f0fu) << 4u) | ((value & 0xf0f0f0f0u) >> 4u);
+	value = ((value & 0x33333333u) << 2u) | ((value & 0xccccccccu) >> 2u);
+	value = ((value & 0x55555555u) << 1u) | ((value & 0xaaaaaaaau) >> 1u);
+
+	return value;
+}
+
+GLUSvoid GLUSAPIENTRY glusRandomSetSeed(const GLUSuint seed)
 {
-	GLUSfloat x1, x2;
+	glusRandomStateSetSeed(&g_randomState, seed);
+}
 
-	// Avoid logf(0.0f) and logf(1.0f)
-	x1 = glusRandomUniformf(GLUS_UNIFORM_RANDOM_BIAS, 1.0f - GLUS_UNIFORM_RANDOM_BIAS);
-	x2 = glusRandomUniformf(0.0f, 1.0f);
+GLUSfloat GLUSAPIENTRY glusRandomUniformf(const GLUSfloat start, const GLUSfloat end)
+{
+	return glusRandomStateUniformf(&g_randomState, start, end);
+}
 
-	return mean + standardDeviation * (sqrtf(-2.0f * logf(x1)) * cosf(2.0f * GLUS_PI * x2));
+GLUSfloat GLUSAPIENTRY glusRandomNormalf(const GLUSfloat mean, const GLUSfloat standardDeviation)
+{
+	return glusRandomStateNormalf(&g_randomState, mean, standardDeviation);
 }
 
 // see http://mathworld.wolfram.com/HammersleyPointSet.html
@@ -62,20 +121,13 @@ GLUSboolean GLUSAPIENTRY glusRandomHammersleyf(GLUSfloat result[2], const GLUSui
 	}
 
 	// If not all bits are used: Check, if sample is out of bounds.
-	if (m < 32 && sample >= (GLUSuint)(1 << m))
+	if (m < 32 && sample >= (1u << m))
 	{
 		return GLUS_FALSE;
 	}
 
-	// Revert bits by swapping blockwise. Lower bits are moved up and higher bits down.
-	revertSample = (sample << 16u) | (sample >> 16u);
-	revertSample = ((revertSample & 0x00ff00ffu) << 8u) | ((revertSample & 0xff00ff00u) >> 8u);
-	revertSample = ((revertSample & 0x0f0f0f0fu) << 4u) | ((revertSample & 0xf0f0f0f0u) >> 4u);
-	revertSample = ((revertSample & 0x33333333u) << 2u) | ((revertSample & 0xccccccccu) >> 2u);
-	revertSample = ((revertSample & 0x55555555u) << 1u) | ((revertSample & 0xaaaaaaaau) >> 1u);
-
 	// Shift back, as only m bits are used.
-	revertSample = revertSample >> (32 - m);
+	revertSample = glusRandomReverseBits(sample) >> (32 - m);
 
 	// Results are in range [0.0 1.0] and not [0.0, 1.0[.
 	binaryFractionFactor = 1.0f / (powf(2.0f, (GLUSfloat)m) - 1.0f);
@@ -85,3 +137,269 @@ GLUSboolean GLUSAPIENTRY glusRandomHammersleyf(GLUSfloat result[2], const GLUSui
 
 	return GLUS_TRUE;
 }
+
+GLUSboolean GLUSAPIENTRY glusRandomHammersleyfv(GLUSfloat* result, const GLUSuint first, const GLUSint number, const GLUSubyte m)
+{
+	GLUSuint sample;
+	GLUSfloat binaryFractionFactor;
+
+	GLUSint i;
+
+	if (!result || number < 0)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (m == 0 || m > 32)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (number == 0)
+	{
+		return GLUS_TRUE;
+	}
+
+	// Check the last sample, as it is the largest one. Overflowing the range is also out of bounds.
+	sample = first + (GLUSuint)(number - 1);
+
+	if (sample < first || (m < 32 && sample >= (1u << m)))
+	{
+		return GLUS_FALSE;
+	}
+
+	binaryFractionFactor = 1.0f / (powf(2.0f, (GLUSfloat)m) - 1.0f);
+
+	for (i = 0; i < number; i++)
+	{
+		sample = first + (GLUSuint)i;
+
+		result[i * 2 + 0] = (GLUSfloat)(glusRandomReverseBits(sample) >> (32 - m)) * binaryFractionFactor;
+		result[i * 2 + 1] = (GLUSfloat)sample * binaryFractionFactor;
+	}
+
+	return GLUS_TRUE;
+}
+
+// see Bratley and Fox, Algorithm 659: Implementing Sobol's quasirandom sequence generator
+
+GLUSboolean GLUSAPIENTRY glusRandomSobolfv(GLUSfloat* result, const GLUSuint first, const GLUSint number)
+{
+	GLUSuint directions[32];
+	GLUSuint x, y, gray, sample;
+
+	GLUSint i, k;
+
+	if (!result || number < 0)
+	{
+		return GLUS_FALSE;
+	}
+
+	// The first dimension uses the directions 2^-(k + 1), which is the van der Corput sequence. The second one uses the primitive polynomial x + 1.
+	directions[0] = 0x80000000u;
+
+	for (k = 1; k < 32; k++)
+	{
+		directions[k] = directions[k - 1] ^ (directions[k - 1] >> 1);
+	}
+
+	// The samples are enumerated in Gray code order, so consecutive samples differ in one direction only.
+	gray = first ^ (first >> 1);
+
+	x = 0;
+	y = 0;
+
+	for (k = 0; k < 32; k++)
+	{
+		if (gray & (1u << k))
+		{
+			x ^= 0x80000000u >> k;
+			y ^= directions[k];
+		}
+	}
+
+	for (i = 0; i < number; i++)
+	{
+		result[i * 2 + 0] = (GLUSfloat)(x >> 8) * GLUS_RANDOM_FLOAT_FACTOR;
+		result[i * 2 + 1] = (GLUSfloat)(y >> 8) * GLUS_RANDOM_FLOAT_FACTOR;
+
+		// The Gray code of the next sample differs in the lowest zero bit of the current sample.
+		sample = first + (GLUSuint)i;
+
+		for (k = 0; k < 31 && (sample & (1u << k)); k++)
+		{
+			// Counting the trailing one bits.
+		}
+
+		x ^= 0x80000000u >> k;
+		y ^= directions[k];
+	}
+
+	return GLUS_TRUE;
+}
+
+//
+
+GLUSvoid GLUSAPIENTRY glusRandomStateSetSeed(GLUSrandomstate* randomState, const GLUSuint seed)
+{
+	// see http://prng.di.unimi.it/splitmix64.c
+
+	GLUSuint64 value = (GLUSuint64)seed;
+	GLUSuint64 z;
+
+	GLUSint i;
+
+	if (!randomState)
+	{
+		return;
+	}
+
+	// SplitMix64 never gives two zero values in a row, so the state is not zero.
+	for (i = 0; i < 2; i++)
+	{
+		value += 0x9E3779B97F4A7C15ull;
+
+		z = value;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		z = z ^ (z >> 31);
+
+		randomState->state[i * 2 + 0] = (GLUSuint)z;
+		randomState->state[i * 2 + 1] = (GLUSuint)(z >> 32);
+	}
+}
+
+GLUSvoid GLUSAPIENTRY glusRandomStateJump(GLUSrandomstate* randomState)
+{
+	static const GLUSuint jump[4] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+
+	GLUSuint result[4] = { 0, 0, 0, 0 };
+
+	GLUSint i, k;
+
+	if (!randomState)
+	{
+		return;
+	}
+
+	for (i = 0; i < 4; i++)
+	{
+		for (k = 0; k < 32; k++)
+		{
+			if (jump[i] & (1u << k))
+			{
+				result[0] ^= randomState->state[0];
+				result[1] ^= randomState->state[1];
+				result[2] ^= randomState->state[2];
+				result[3] ^= randomState->state[3];
+			}
+
+			glusRandomNext(randomState->state);
+		}
+	}
+
+	randomState->state[0] = result[0];
+	randomState->state[1] = result[1];
+	randomState->state[2] = result[2];
+	randomState->state[3] = result[3];
+}
+
+GLUSuint GLUSAPIENTRY glusRandomStateUniformui(GLUSrandomstate* randomState)
+{
+	if (!randomState)
+	{
+		return 0;
+	}
+
+	return glusRandomNext(randomState->state);
+}
+
+GLUSfloat GLUSAPIENTRY glusRandomStateUniformf(GLUSrandomstate* randomState, const GLUSfloat start, const GLUSfloat end)
+{
+	if (!randomState)
+	{
+		return start;
+	}
+
+	return (GLUSfloat)(glusRandomNext(randomState->state) >> 8) * GLUS_RANDOM_FLOAT_FACTOR * (end - start) + start;
+}
+
+GLUSfloat GLUSAPIENTRY glusRandomStateNormalf(GLUSrandomstate* randomState, const GLUSfloat mean, const GLUSfloat standardDeviation)
+{
+	GLUSfloat result[2];
+
+	if (!randomState)
+	{
+		return mean;
+	}
+
+	glusRandomBoxMuller(result, randomState->state, mean, standardDeviation);
+
+	return result[0];
+}
+
+GLUSvoid GLUSAPIENTRY glusRandomStateUniformfv(GLUSrandomstate* randomState, GLUSfloat* result, const GLUSint number, const GLUSfloat start, const GLUSfloat end)
+{
+	GLUSuint state[4];
+	GLUSfloat scale;
+
+	GLUSint i;
+
+	if (!randomState || !result)
+	{
+		return;
+	}
+
+	// Working on a local copy, so the state stays in registers.
+	state[0] = randomState->state[0];
+	state[1] = randomState->state[1];
+	state[2] = randomState->state[2];
+	state[3] = randomState->state[3];
+
+	scale = GLUS_RANDOM_FLOAT_FACTOR * (end - start);
+
+	for (i = 0; i < number; i++)
+	{
+		result[i] = (GLUSfloat)(glusRandomNext(state) >> 8) * scale + start;
+	}
+
+	randomState->state[0] = state[0];
+	randomState->state[1] = state[1];
+	randomState->state[2] = state[2];
+	randomState->state[3] = state[3];
+}
+
+GLUSvoid GLUSAPIENTRY glusRandomStateNormalfv(GLUSrandomstate* randomState, GLUSfloat* result, const GLUSint number, const GLUSfloat mean, const GLUSfloat standardDeviation)
+{
+	GLUSuint state[4];
+	GLUSfloat pair[2];
+
+	GLUSint i;
+
+	if (!randomState || !result)
+	{
+		return;
+	}
+
+	state[0] = randomState->state[0];
+	state[1] = randomState->state[1];
+	state[2] = randomState->state[2];
+	state[3] = randomState->state[3];
+
+	for (i = 0; i + 1 < number; i += 2)
+	{
+		glusRandomBoxMuller(&result[i], state, mean, standardDeviation);
+	}
+
+	if (i < number)
+	{
+		glusRandomBoxMuller(pair, state, mean, standardDeviation);
+
+		result[i] = pair[0];
+	}
+
+	randomState->state[0] = state[0];
+	randomState->state[1] = state[1];
+	randomState->state[2] = state[2];
+	randomState->state[3] = state[3];
+}
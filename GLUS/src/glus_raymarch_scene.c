@@ -0,0 +1,655 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+#define GLUS_RAYMARCH_TILE_SIZE 32
+
+extern GLUSboolean _glusThreadRunTiles(const GLUSint numberTiles, const GLUSint numberThreads, GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile), GLUSvoid* data);
+
+extern GLUSvoid _glusRaytraceCreateDirectionsf(GLUSfloat* directionX, GLUSfloat* directionY, GLUSfloat* directionZ, const GLUSfloat rotation[9], const GLUSfloat xStart, const GLUSfloat xStep, const GLUSfloat y, const GLUSint startColumn, const GLUSint numberColumns);
+
+/**
+ * Primitive prepared for marching.
+ */
+typedef struct _GLUSraymarchobject
+{
+	const GLUSraymarchprimitive* primitive;
+
+	GLUSfloat center[3];
+
+	// Radius of the sphere around the center, which encloses the primitive.
+	GLUSfloat boundingRadius;
+
+	// Rotates from world space into the space of an oriented box.
+	GLUSfloat rotation[9];
+
+} GLUSraymarchobject;
+
+typedef struct _GLUSraymarchwork
+{
+	const GLUSraymarchscene* scene;
+
+	const GLUSraymarchobject* objects;
+
+	// Indices of all objects, used for the shadow rays.
+	const GLUSint* allIndices;
+
+	GLUStgaimage* tgaimage;
+
+	GLUSint stride;
+
+	GLUSint tilesX;
+
+	// Camera
+
+	GLUSfloat rotation[9];
+
+	GLUSfloat xStart;
+	GLUSfloat yStart;
+	GLUSfloat xStep;
+	GLUSfloat yStep;
+
+} GLUSraymarchwork;
+
+static GLUSfloat glusRaymarchObjectDistance(const GLUSraymarchobject* object, const GLUSfloat vector[3])
+{
+	// see http://www.iquilezles.org/www/articles/distfunctions/distfunctions.htm and glusOrientedBoxDistancePoint4f
+
+	const GLUSfloat* halfExtend = object->primitive->halfExtend;
+	const GLUSfloat* rotation = object->rotation;
+
+	GLUSfloat local[3];
+
+	GLUSfloat insideDistance;
+
+	if (object->primitive->type == GLUS_RAYMARCH_SPHERE)
+	{
+		return sqrtf(vector[0] * vector[0] + vector[1] * vector[1] + vector[2] * vector[2]) - object->primitive->radius;
+	}
+
+	local[0] = fabsf(rotation[0] * vector[0] + rotation[3] * vector[1] + rotation[6] * vector[2]) - halfExtend[0];
+	local[1] = fabsf(rotation[1] * vector[0] + rotation[4] * vector[1] + rotation[7] * vector[2]) - halfExtend[1];
+	local[2] = fabsf(rotation[2] * vector[0] + rotation[5] * vector[1] + rotation[8] * vector[2]) - halfExtend[2];
+
+	insideDistance = local[0] > local[1] ? local[0] : local[1];
+	insideDistance = insideDistance > local[2] ? insideDistance : local[2];
+	insideDistance = insideDistance < 0.0f ? insideDistance : 0.0f;
+
+	local[0] = local[0] > 0.0f ? local[0] : 0.0f;
+	local[1] = local[1] > 0.0f ? local[1] : 0.0f;
+	local[2] = local[2] > 0.0f ? local[2] : 0.0f;
+
+	return insideDistance + sqrtf(local[0] * local[0] + local[1] * local[1] + local[2] * local[2]);
+}
+
+static GLUSfloat glusRaymarchSceneDistance(const GLUSraymarchobject** closestObject, const GLUSraymarchobject* objects, const GLUSint* indices, const GLUSint numberIndices, const GLUSfloat point[3])
+{
+	GLUSint i;
+
+	GLUSfloat distance = INFINITY;
+	GLUSfloat currentDistance;
+
+	GLUSfloat vector[3];
+
+	const GLUSraymarchobject* object;
+
+	for (i = 0; i < numberIndices; i++)
+	{
+		object = &objects[indices[i]];
+
+		vector[0] = point[0] - object->center[0];
+		vector[1] = point[1] - object->center[1];
+		vector[2] = point[2] - object->center[2];
+
+		// The distance to the bounding sphere is never larger than the distance to the primitive, so farther primitives can be skipped.
+		if (object->primitive->type != GLUS_RAYMARCH_SPHERE && sqrtf(vector[0] * vector[0] + vector[1] * vector[1] + vector[2] * vector[2]) - object->boundingRadius >= distance)
+		{
+			continue;
+		}
+
+		currentDistance = glusRaymarchObjectDistance(object, vector);
+
+		if (currentDistance < distance)
+		{
+			distance = currentDistance;
+
+			if (closestObject)
+			{
+				*closestObject = object;
+			}
+		}
+	}
+
+	return distance;
+}
+
+static GLUSvoid glusRaymarchObjectNormal(GLUSfloat normal[3], const GLUSraymarchobject* object, const GLUSfloat point[3], const GLUSfloat delta)
+{
+	// Tetrahedron sampling needs four instead of six evaluations of the distance function.
+	static const GLUSfloat offsets[4][3] = { { 1.0f, -1.0f, -1.0f }, { -1.0f, -1.0f, 1.0f }, { -1.0f, 1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } };
+
+	GLUSint i;
+
+	GLUSfloat vector[3];
+	GLUSfloat distance;
+
+	if (object->primitive->type == GLUS_RAYMARCH_SPHERE)
+	{
+		normal[0] = point[0] - object->center[0];
+		normal[1] = point[1] - object->center[1];
+		normal[2] = point[2] - object->center[2];
+	}
+	else
+	{
+		normal[0] = 0.0f;
+		normal[1] = 0.0f;
+		normal[2] = 0.0f;
+
+		for (i = 0; i < 4; i++)
+		{
+			vector[0] = point[0] - object->center[0] + offsets[i][0] * delta;
+			vector[1] = point[1] - object->center[1] + offsets[i][1] * delta;
+			vector[2] = point[2] - object->center[2] + offsets[i][2] * delta;
+
+			distance = glusRaymarchObjectDistance(object, vector);
+
+			normal[0] += offsets[i][0] * distance;
+			normal[1] += offsets[i][1] * distance;
+			normal[2] += offsets[i][2] * distance;
+		}
+	}
+
+	glusVector3Normalizef(normal);
+}
+
+static GLUSfloat glusRaymarchSceneShadow(const GLUSraymarchwork* work, const GLUSfloat position[3], const GLUSfloat direction[3], const GLUSfloat maxDistance)
+{
+	// see http://www.iquilezles.org/www/articles/rmshadows/rmshadows.htm
+
+	const GLUSraymarchscene* scene = work->scene;
+
+	GLUSint i;
+
+	GLUSfloat t = scene->epsilon;
+	GLUSfloat shadow = 1.0f;
+	GLUSfloat distance;
+
+	GLUSfloat point[3];
+
+	// One march towards the light for all primitives. The closest approach of the ray darkens the penumbra.
+	for (i = 0; i < scene->maxSteps && t < maxDistance; i++)
+	{
+		point[0] = position[0] + direction[0] * t;
+		point[1] = position[1] + direction[1] * t;
+		point[2] = position[2] + direction[2] * t;
+
+		distance = glusRaymarchSceneDistance(0, work->objects, work->allIndices, scene->numberPrimitives, point);
+
+		if (distance < scene->epsilon)
+		{
+			return 0.0f;
+		}
+
+		if (scene->shadowSharpness > 0.0f && scene->shadowSharpness * distance / t < shadow)
+		{
+			shadow = scene->shadowSharpness * distance / t;
+		}
+
+		t += distance;
+	}
+
+	return shadow;
+}
+
+static GLUSvoid glusRaymarchSceneMarch(GLUSfloat pixelColor[4], const GLUSraymarchwork* work, const GLUSint* indices, const GLUSint numberIndices, const GLUSfloat rayPosition[3], const GLUSfloat rayDirection[3])
+{
+	const GLUSraymarchscene* scene = work->scene;
+
+	const GLUSraymarchobject* objectNear = 0;
+	const GLUSraymarchmaterial* material;
+
+	GLUSint i;
+
+	GLUSfloat t = 0.0f;
+	GLUSfloat distance;
+
+	GLUSfloat hitPosition[3];
+	GLUSfloat hitDirection[3];
+	GLUSfloat shadowPosition[3];
+
+	GLUSfloat eyeDirection[3];
+
+	pixelColor[0] = 0.0f;
+	pixelColor[1] = 0.0f;
+	pixelColor[2] = 0.0f;
+	pixelColor[3] = 1.0f;
+
+	for (i = 0; i < scene->maxSteps && t <= scene->maxDistance; i++)
+	{
+		hitPosition[0] = rayPosition[0] + rayDirection[0] * t;
+		hitPosition[1] = rayPosition[1] + rayDirection[1] * t;
+		hitPosition[2] = rayPosition[2] + rayDirection[2] * t;
+
+		distance = glusRaymarchSceneDistance(&objectNear, work->objects, indices, numberIndices, hitPosition);
+
+		if (distance < scene->epsilon)
+		{
+			break;
+		}
+
+		objectNear = 0;
+
+		t += distance;
+	}
+
+	// No intersection, return background color / ambient light.
+	if (!objectNear)
+	{
+		pixelColor[0] = scene->backgroundColor[0];
+		pixelColor[1] = scene->backgroundColor[1];
+		pixelColor[2] = scene->backgroundColor[2];
+
+		return;
+	}
+
+	material = &objectNear->primitive->material;
+
+	glusRaymarchObjectNormal(hitDirection, objectNear, hitPosition, scene->epsilon * 0.1f);
+
+	// Start the shadow rays outside of the surface, so they do not hit it immediately.
+	shadowPosition[0] = hitPosition[0] + hitDirection[0] * 2.0f * scene->epsilon;
+	shadowPosition[1] = hitPosition[1] + hitDirection[1] * 2.0f * scene->epsilon;
+	shadowPosition[2] = hitPosition[2] + hitDirection[2] * 2.0f * scene->epsilon;
+
+	glusVector3MultiplyScalarf(eyeDirection, rayDirection, -1.0f);
+
+	// Diffuse and specular color
+	for (i = 0; i < scene->numberPointLights; i++)
+	{
+		const GLUSraytracepointlight* pointLight = &scene->pointLights[i];
+
+		GLUSfloat lightDirection[3];
+		GLUSfloat incidentLightDirection[3];
+
+		GLUSfloat diffuseIntensity, lightDistance, shadow;
+
+		lightDirection[0] = pointLight->position[0] - hitPosition[0];
+		lightDirection[1] = pointLight->position[1] - hitPosition[1];
+		lightDirection[2] = pointLight->position[2] - hitPosition[2];
+		glusVector3Normalizef(lightDirection);
+
+		diffuseIntensity = glusMathMaxf(0.0f, glusVector3Dotf(hitDirection, lightDirection));
+
+		// Surfaces facing away from the light need no shadow ray.
+		if (diffuseIntensity <= 0.0f)
+		{
+			continue;
+		}
+
+		lightDistance = sqrtf((pointLight->position[0] - shadowPosition[0]) * (pointLight->position[0] - shadowPosition[0]) + (pointLight->position[1] - shadowPosition[1]) * (pointLight->position[1] - shadowPosition[1]) + (pointLight->position[2] - shadowPosition[2]) * (pointLight->position[2] - shadowPosition[2]));
+
+		shadow = glusRaymarchSceneShadow(work, shadowPosition, lightDirection, lightDistance);
+
+		if (shadow > 0.0f)
+		{
+			GLUSfloat specularReflection[3];
+
+			GLUSfloat eDotR;
+
+			pixelColor[0] = pixelColor[0] + shadow * diffuseIntensity * material->diffuseColor[0] * pointLight->color[0];
+			pixelColor[1] = pixelColor[1] + shadow * diffuseIntensity * material->diffuseColor[1] * pointLight->color[1];
+			pixelColor[2] = pixelColor[2] + shadow * diffuseIntensity * material->diffuseColor[2] * pointLight->color[2];
+
+			glusVector3MultiplyScalarf(incidentLightDirection, lightDirection, -1.0f);
+
+			glusVector3Reflectf(specularReflection, incidentLightDirection, hitDirection);
+			glusVector3Normalizef(specularReflection);
+
+			eDotR = glusMathMaxf(0.0f, glusVector3Dotf(eyeDirection, specularReflection));
+
+			if (eDotR > 0.0f)
+			{
+				GLUSfloat specularIntensity = shadow * powf(eDotR, material->shininess);
+
+				pixelColor[0] = pixelColor[0] + specularIntensity * material->specularColor[0] * pointLight->color[0];
+				pixelColor[1] = pixelColor[1] + specularIntensity * material->specularColor[1] * pointLight->color[1];
+				pixelColor[2] = pixelColor[2] + specularIntensity * material->specularColor[2] * pointLight->color[2];
+			}
+		}
+	}
+
+	// Emissive color
+	pixelColor[0] = pixelColor[0] + material->emissiveColor[0];
+	pixelColor[1] = pixelColor[1] + material->emissiveColor[1];
+	pixelColor[2] = pixelColor[2] + material->emissiveColor[2];
+}
+
+static GLUSint glusRaymarchSceneCullTile(GLUSint* indices, const GLUSraymarchwork* work, const GLUSfloat corners[4][3])
+{
+	// see Real-Time Rendering, cone against sphere test
+
+	const GLUSraymarchscene* scene = work->scene;
+
+	GLUSint i, numberIndices = 0;
+
+	GLUSfloat axis[3];
+	GLUSfloat vector[3];
+
+	GLUSfloat cosine, coneAngle, distance, radius;
+
+	axis[0] = corners[0][0] + corners[1][0] + corners[2][0] + corners[3][0];
+	axis[1] = corners[0][1] + corners[1][1] + corners[2][1] + corners[3][1];
+	axis[2] = corners[0][2] + corners[1][2] + corners[2][2] + corners[3][2];
+	glusVector3Normalizef(axis);
+
+	// The cone around the axis encloses the four corner rays and so all rays of the tile.
+	cosine = 1.0f;
+
+	for (i = 0; i < 4; i++)
+	{
+		cosine = glusMathMinf(cosine, glusVector3Dotf(axis, corners[i]));
+	}
+
+	coneAngle = acosf(glusMathClampf(cosine, -1.0f, 1.0f));
+
+	for (i = 0; i < scene->numberPrimitives; i++)
+	{
+		vector[0] = work->objects[i].center[0] - scene->eye[0];
+		vector[1] = work->objects[i].center[1] - scene->eye[1];
+		vector[2] = work->objects[i].center[2] - scene->eye[2];
+
+		distance = glusVector3Lengthf(vector);
+
+		// Rays have to come closer than epsilon for a hit.
+		radius = work->objects[i].boundingRadius + scene->epsilon;
+
+		if (distance - radius > scene->maxDistance)
+		{
+			continue;
+		}
+
+		if (distance > radius)
+		{
+			cosine = glusVector3Dotf(vector, axis) / distance;
+
+			if (acosf(glusMathClampf(cosine, -1.0f, 1.0f)) > coneAngle + asinf(radius / distance))
+			{
+				continue;
+			}
+		}
+
+		indices[numberIndices++] = i;
+	}
+
+	return numberIndices;
+}
+
+static GLUSvoid glusRaymarchSceneRenderTile(GLUSvoid* data, const GLUSint tile)
+{
+	const GLUSraymarchwork* work = (const GLUSraymarchwork*)data;
+
+	const GLUSraymarchscene* scene = work->scene;
+	GLUStgaimage* tgaimage = work->tgaimage;
+
+	GLUSint x, y, startX, startY, endX, endY, index;
+
+	GLUSint* indices;
+	GLUSint numberIndices;
+
+	GLUSfloat rayPosition[3];
+	GLUSfloat rayDirection[3];
+
+	GLUSfloat directionX[GLUS_RAYMARCH_TILE_SIZE];
+	GLUSfloat directionY[GLUS_RAYMARCH_TILE_SIZE];
+	GLUSfloat directionZ[GLUS_RAYMARCH_TILE_SIZE];
+
+	GLUSfloat corners[4][3];
+
+	GLUSfloat pixelColor[4];
+
+	startX = (tile % work->tilesX) * GLUS_RAYMARCH_TILE_SIZE;
+	startY = (tile / work->tilesX) * GLUS_RAYMARCH_TILE_SIZE;
+
+	endX = startX + GLUS_RAYMARCH_TILE_SIZE < tgaimage->width ? startX + GLUS_RAYMARCH_TILE_SIZE : tgaimage->width;
+	endY = startY + GLUS_RAYMARCH_TILE_SIZE < tgaimage->height ? startY + GLUS_RAYMARCH_TILE_SIZE : tgaimage->height;
+
+	rayPosition[0] = scene->eye[0];
+	rayPosition[1] = scene->eye[1];
+	rayPosition[2] = scene->eye[2];
+
+	// Gather the primitives, which can be hit by the rays of this tile.
+
+	indices = (GLUSint*)glusMemoryMalloc(scene->numberPrimitives * sizeof(GLUSint));
+
+	if (indices)
+	{
+		for (y = 0; y < 2; y++)
+		{
+			_glusRaytraceCreateDirectionsf(directionX, directionY, directionZ, work->rotation, work->xStart, work->xStep, work->yStart + work->yStep * (GLUSfloat)(y == 0 ? startY : endY - 1), startX, endX - startX);
+
+			corners[y * 2 + 0][0] = directionX[0];
+			corners[y * 2 + 0][1] = directionY[0];
+			corners[y * 2 + 0][2] = directionZ[0];
+
+			corners[y * 2 + 1][0] = directionX[endX - startX - 1];
+			corners[y * 2 + 1][1] = directionY[endX - startX - 1];
+			corners[y * 2 + 1][2] = directionZ[endX - startX - 1];
+		}
+
+		numberIndices = glusRaymarchSceneCullTile(indices, work, (const GLUSfloat(*)[3])corners);
+	}
+	else
+	{
+		numberIndices = scene->numberPrimitives;
+	}
+
+	for (y = startY; y < endY; y++)
+	{
+		// Same rays as created by glusRaytracePerspectivef and glusRaytraceLookAtf.
+		_glusRaytraceCreateDirectionsf(directionX, directionY, directionZ, work->rotation, work->xStart, work->xStep, work->yStart + work->yStep * (GLUSfloat)y, startX, endX - startX);
+
+		for (x = startX; x < endX; x++)
+		{
+			if (numberIndices > 0)
+			{
+				rayDirection[0] = directionX[x - startX];
+				rayDirection[1] = directionY[x - startX];
+				rayDirection[2] = directionZ[x - startX];
+
+				glusRaymarchSceneMarch(pixelColor, work, indices ? indices : work->allIndices, numberIndices, rayPosition, rayDirection);
+			}
+			else
+			{
+				glusVector3Copyf(pixelColor, scene->backgroundColor);
+			}
+
+			index = (x + y * tgaimage->width) * work->stride;
+
+			tgaimage->data[index + 0] = (GLUSubyte)(glusMathMinf(1.0f, pixelColor[0]) * 255.0f);
+			tgaimage->data[index + 1] = (GLUSubyte)(glusMathMinf(1.0f, pixelColor[1]) * 255.0f);
+			tgaimage->data[index + 2] = (GLUSubyte)(glusMathMinf(1.0f, pixelColor[2]) * 255.0f);
+
+			if (work->stride == 4)
+			{
+				tgaimage->data[index + 3] = 255;
+			}
+		}
+	}
+
+	glusMemoryFree(indices);
+}
+
+GLUSboolean GLUSAPIENTRY glusRaymarchSceneRender(GLUStgaimage* tgaimage, const GLUSraymarchscene* scene, const GLUSint numberThreads)
+{
+	GLUSraymarchwork work;
+
+	GLUSraymarchobject* objects;
+	GLUSint* allIndices;
+
+	GLUSfloat forward[3], side[3], up[3];
+
+	GLUSfloat xExtend, yExtend;
+
+	GLUSint i, numberTiles, tilesY;
+
+	GLUSboolean result;
+
+	if (!tgaimage || !tgaimage->data || !scene || tgaimage->depth != 1 || (scene->numberPrimitives > 0 && !scene->primitives) || (scene->numberPointLights > 0 && !scene->pointLights))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (tgaimage->format == GLUS_RGB)
+	{
+		work.stride = 3;
+	}
+	else if (tgaimage->format == GLUS_RGBA)
+	{
+		work.stride = 4;
+	}
+	else
+	{
+		return GLUS_FALSE;
+	}
+
+	for (i = 0; i < scene->numberPrimitives; i++)
+	{
+		if (scene->primitives[i].type != GLUS_RAYMARCH_SPHERE && scene->primitives[i].type != GLUS_RAYMARCH_ORIENTED_BOX)
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Unknown ray marching primitive type: %d", scene->primitives[i].type);
+
+			return GLUS_FALSE;
+		}
+	}
+
+	// Prepare the primitives once, so marching does not have to rebuild the box rotations.
+
+	objects = (GLUSraymarchobject*)glusMemoryMalloc((scene->numberPrimitives > 0 ? scene->numberPrimitives : 1) * sizeof(GLUSraymarchobject));
+	allIndices = (GLUSint*)glusMemoryMalloc((scene->numberPrimitives > 0 ? scene->numberPrimitives : 1) * sizeof(GLUSint));
+
+	if (!objects || !allIndices)
+	{
+		glusMemoryFree(objects);
+		glusMemoryFree(allIndices);
+
+		return GLUS_FALSE;
+	}
+
+	for (i = 0; i < scene->numberPrimitives; i++)
+	{
+		const GLUSraymarchprimitive* primitive = &scene->primitives[i];
+
+		objects[i].primitive = primitive;
+
+		objects[i].center[0] = primitive->center[0];
+		objects[i].center[1] = primitive->center[1];
+		objects[i].center[2] = primitive->center[2];
+
+		glusMatrix3x3Identityf(objects[i].rotation);
+
+		if (primitive->type == GLUS_RAYMARCH_SPHERE)
+		{
+			objects[i].boundingRadius = primitive->radius;
+		}
+		else
+		{
+			glusMatrix3x3RotateRzRyRxf(objects[i].rotation, -primitive->orientation[2], -primitive->orientation[1], -primitive->orientation[0]);
+
+			objects[i].boundingRadius = glusVector3Lengthf(primitive->halfExtend);
+		}
+
+		allIndices[i] = i;
+	}
+
+	work.scene = scene;
+	work.objects = objects;
+	work.allIndices = allIndices;
+	work.tgaimage = tgaimage;
+
+	// Camera, see glusRaytracePerspectivef and glusRaytraceLookAtf.
+
+	yExtend = tanf(glusMathDegToRadf(scene->fovy * 0.5f));
+	xExtend = yExtend * ((GLUSfloat)tgaimage->width / (GLUSfloat)tgaimage->height);
+
+	work.xStep = xExtend / ((GLUSfloat)(tgaimage->width) * 0.5f);
+	work.yStep = yExtend / ((GLUSfloat)(tgaimage->height) * 0.5f);
+
+	work.xStart = -xExtend + work.xStep * 0.5f;
+	work.yStart = -yExtend + work.yStep * 0.5f;
+
+	forward[0] = scene->center[0] - scene->eye[0];
+	forward[1] = scene->center[1] - scene->eye[1];
+	forward[2] = scene->center[2] - scene->eye[2];
+	glusVector3Normalizef(forward);
+
+	glusVector3Crossf(side, forward, scene->up);
+	glusVector3Normalizef(side);
+
+	glusVector3Crossf(up, side, forward);
+
+	work.rotation[0] = side[0];
+	work.rotation[1] = side[1];
+	work.rotation[2] = side[2];
+
+	work.rotation[3] = up[0];
+	work.rotation[4] = up[1];
+	work.rotation[5] = up[2];
+
+	work.rotation[6] = -forward[0];
+	work.rotation[7] = -forward[1];
+	work.rotation[8] = -forward[2];
+
+	work.tilesX = (tgaimage->width + GLUS_RAYMARCH_TILE_SIZE - 1) / GLUS_RAYMARCH_TILE_SIZE;
+	tilesY = (tgaimage->height + GLUS_RAYMARCH_TILE_SIZE - 1) / GLUS_RAYMARCH_TILE_SIZE;
+	numberTiles = work.tilesX * tilesY;
+
+	result = _glusThreadRunTiles(numberTiles, numberThreads, glusRaymarchSceneRenderTile, &work);
+
+	glusMemoryFree(objects);
+	glusMemoryFree(allIndices);
+
+	return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusRaymarchSceneSaveTga(const GLUSchar* filename, const GLUSint width, const GLUSint height, const GLUSraymarchscene* scene, const GLUSint numberThreads)
+{
+	GLUStgaimage tgaimage;
+
+	GLUSboolean result;
+
+	if (!filename || !scene)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!glusImageCreateTga(&tgaimage, width, height, 1, GLUS_RGB))
+	{
+		return GLUS_FALSE;
+	}
+
+	result = glusRaymarchSceneRender(&tgaimage, scene, numberThreads);
+
+	if (result)
+	{
+		result = glusImageSaveTga(filename, &tgaimage);
+	}
+
+	glusImageDestroyTga(&tgaimage);
+
+	return result;
+}
@@ -15,55 +15,52 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define GLUS_RAYTRACE_SSE
+#if (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))) || defined(__clang__)
+#include <immintrin.h>
+#define GLUS_RAYTRACE_AVX
+#define GLUS_RAYTRACE_AVX_TARGET __attribute__((target("avx")))
+#elif defined(_MSC_FULL_VER) && _MSC_FULL_VER >= 160040219
+#include <immintrin.h>
+#define GLUS_RAYTRACE_AVX
+#define GLUS_RAYTRACE_AVX_TARGET
+#endif
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GLUS_RAYTRACE_NEON
+#endif
+
 #include "GL/glus.h"
 
-GLUSboolean GLUSAPIENTRY glusRaytracePerspectivef(GLUSfloat* directionBuffer, const GLUSubyte padding, const GLUSfloat fovy, const GLUSint width, const GLUSint height)
-{
-	GLUSint i, k;
+#if defined(GLUS_RAYTRACE_AVX)
+extern GLUSboolean _glusBatchIsAvxEnabled(GLUSvoid);
+#endif
 
+static GLUSvoid glusRaytraceCreateExtend(GLUSfloat* xStart, GLUSfloat* yStart, GLUSfloat* xStep, GLUSfloat* yStep, const GLUSfloat fovy, const GLUSint width, const GLUSint height)
+{
 	GLUSfloat aspect;
 
 	GLUSfloat yExtend;
 	GLUSfloat xExtend;
 
-	GLUSfloat xStep;
-	GLUSfloat yStep;
-
-	if (!directionBuffer || width <= 0 || height <= 0)
-	{
-		return GLUS_FALSE;
-	}
-
 	aspect = (GLUSfloat)width / (GLUSfloat)height;
 
 	yExtend = tanf(glusMathDegToRadf(fovy * 0.5f));
 	xExtend = yExtend * aspect;
 
-	xStep = xExtend / ((GLUSfloat)(width) * 0.5f);
-	yStep = yExtend / ((GLUSfloat)(height) * 0.5f);
+	*xStep = xExtend / ((GLUSfloat)(width) * 0.5f);
+	*yStep = yExtend / ((GLUSfloat)(height) * 0.5f);
 
-	for (i = 0; i < width * height; i++)
-	{
-		directionBuffer[i * (3 + padding) + 0] = -xExtend + xStep * 0.5f + xStep * (GLUSfloat)(i % width);
-		directionBuffer[i * (3 + padding) + 1] = -yExtend + yStep * 0.5f + yStep * (GLUSfloat)(i / width);
-		directionBuffer[i * (3 + padding) + 2] = -1.0f;
-
-		for (k = 0; k < padding; k++)
-		{
-			directionBuffer[i * (3 + padding) + 3 + k] = 0.0f;
-		}
-
-		glusVector3Normalizef(&directionBuffer[i * (3 + padding)]);
-	}
-
-	return GLUS_TRUE;
+	// Center of the first pixel.
+	*xStart = -xExtend + *xStep * 0.5f;
+	*yStart = -yExtend + *yStep * 0.5f;
 }
 
-GLUSvoid GLUSAPIENTRY glusRaytraceLookAtf(GLUSfloat* positionBuffer, GLUSfloat* directionBuffer, const GLUSfloat* originDirectionBuffer, const GLUSubyte padding, const GLUSint width, const GLUSint height, const GLUSfloat eyeX, const GLUSfloat eyeY, const GLUSfloat eyeZ, const GLUSfloat centerX, const GLUSfloat centerY, const GLUSfloat centerZ, const GLUSfloat upX, const GLUSfloat upY, const GLUSfloat upZ)
+static GLUSvoid glusRaytraceCreateRotation(GLUSfloat rotation[9], const GLUSfloat eyeX, const GLUSfloat eyeY, const GLUSfloat eyeZ, const GLUSfloat centerX, const GLUSfloat centerY, const GLUSfloat centerZ, const GLUSfloat upX, const GLUSfloat upY, const GLUSfloat upZ)
 {
 	GLUSfloat forward[3], side[3], up[3];
-	GLUSfloat rotation[9];
-	GLUSint i, k;
 
 	forward[0] = centerX - eyeX;
 	forward[1] = centerY - eyeY;
@@ -89,6 +86,255 @@ GLUSvoid GLUSAPIENTRY glusRaytraceLookAtf(GLUSfloat* positionBuffer, GLUSfloat*
 	rotation[6] = -forward[0];
 	rotation[7] = -forward[1];
 	rotation[8] = -forward[2];
+}
+
+#if defined(GLUS_RAYTRACE_AVX)
+
+//
+// Eight rays are processed at once. AVX has no fused multiply add, so the results are equal to the four ray and the scalar functions.
+//
+
+static GLUS_RAYTRACE_AVX_TARGET __m256 glusRaytraceRotate8(const GLUSfloat rotation[9], const GLUSint row, const __m256 x, const __m256 y, const __m256 z)
+{
+	return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(rotation[row]), x), _mm256_mul_ps(_mm256_set1_ps(rotation[3 + row]), y)), _mm256_mul_ps(_mm256_set1_ps(rotation[6 + row]), z));
+}
+
+/**
+ * @return The number of created rays, which is a multiple of eight.
+ */
+static GLUS_RAYTRACE_AVX_TARGET GLUSint glusRaytraceCreateDirectionsAvx(GLUSfloat* directionX, GLUSfloat* directionY, GLUSfloat* directionZ, const GLUSfloat rotation[9], const GLUSfloat xStart, const GLUSfloat xStep, const GLUSfloat y, const GLUSint startColumn, const GLUSint numberColumns)
+{
+	GLUSint i;
+
+	__m256 vxStart = _mm256_set1_ps(xStart);
+	__m256 vxStep = _mm256_set1_ps(xStep);
+	__m256 vy = _mm256_set1_ps(y);
+	__m256 vz = _mm256_set1_ps(-1.0f);
+	__m256 vyy = _mm256_mul_ps(vy, vy);
+	__m256 vzz = _mm256_mul_ps(vz, vz);
+	__m256 vx, vlength, nx, ny, nz, rx, ry;
+
+	// Integer adds need AVX2, so the columns are counted as floats. This is exact, as long as the columns are below 2^24.
+	__m256 vcolumn = _mm256_add_ps(_mm256_set1_ps((GLUSfloat)startColumn), _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f));
+	__m256 veight = _mm256_set1_ps(8.0f);
+
+	for (i = 0; i + 8 <= numberColumns; i += 8)
+	{
+		vx = _mm256_add_ps(vxStart, _mm256_mul_ps(vxStep, vcolumn));
+		vlength = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, vx), vyy), vzz));
+		nx = _mm256_div_ps(vx, vlength);
+		ny = _mm256_div_ps(vy, vlength);
+		nz = _mm256_div_ps(vz, vlength);
+
+		if (rotation)
+		{
+			rx = glusRaytraceRotate8(rotation, 0, nx, ny, nz);
+			ry = glusRaytraceRotate8(rotation, 1, nx, ny, nz);
+			nz = glusRaytraceRotate8(rotation, 2, nx, ny, nz);
+
+			nx = rx;
+			ny = ry;
+		}
+
+		_mm256_storeu_ps(&directionX[i], nx);
+		_mm256_storeu_ps(&directionY[i], ny);
+		_mm256_storeu_ps(&directionZ[i], nz);
+
+		vcolumn = _mm256_add_ps(vcolumn, veight);
+	}
+
+	return i;
+}
+
+/**
+ * @return The number of rotated rays, which is a multiple of eight.
+ */
+static GLUS_RAYTRACE_AVX_TARGET GLUSint glusRaytraceRotateDirectionsAvx(GLUSfloat* directionX, GLUSfloat* directionY, GLUSfloat* directionZ, const GLUSfloat* originDirectionX, const GLUSfloat* originDirectionY, const GLUSfloat* originDirectionZ, const GLUSfloat rotation[9], const GLUSint numberRays)
+{
+	GLUSint i;
+
+	__m256 vx, vy, vz;
+
+	for (i = 0; i + 8 <= numberRays; i += 8)
+	{
+		vx = _mm256_loadu_ps(&originDirectionX[i]);
+		vy = _mm256_loadu_ps(&originDirectionY[i]);
+		vz = _mm256_loadu_ps(&originDirectionZ[i]);
+
+		_mm256_storeu_ps(&directionX[i], glusRaytraceRotate8(rotation, 0, vx, vy, vz));
+		_mm256_storeu_ps(&directionY[i], glusRaytraceRotate8(rotation, 1, vx, vy, vz));
+		_mm256_storeu_ps(&directionZ[i], glusRaytraceRotate8(rotation, 2, vx, vy, vz));
+	}
+
+	return i;
+}
+
+#endif
+
+/**
+ * Creates the normalized directions of a row of pixels and optionally rotates them.
+ * Eight rays are processed at once, if the processor supports AVX, otherwise four rays, if SSE or NEON is available. The results are equal to the scalar functions.
+ */
+GLUSvoid _glusRaytraceCreateDirectionsf(GLUSfloat* directionX, GLUSfloat* directionY, GLUSfloat* directionZ, const GLUSfloat rotation[9], const GLUSfloat xStart, const GLUSfloat xStep, const GLUSfloat y, const GLUSint startColumn, const GLUSint numberColumns)
+{
+	GLUSint i = 0;
+
+	GLUSfloat x, z, length;
+	GLUSfloat direction[3];
+
+#if defined(GLUS_RAYTRACE_SSE)
+	__m128 vxStart = _mm_set1_ps(xStart);
+	__m128 vxStep = _mm_set1_ps(xStep);
+	__m128 vy = _mm_set1_ps(y);
+	__m128 vz = _mm_set1_ps(-1.0f);
+	__m128 vyy = _mm_mul_ps(vy, vy);
+	__m128 vzz = _mm_mul_ps(vz, vz);
+	__m128i vcolumn;
+	__m128i vfour = _mm_set1_epi32(4);
+
+#if defined(GLUS_RAYTRACE_AVX)
+	if (_glusBatchIsAvxEnabled())
+	{
+		i = glusRaytraceCreateDirectionsAvx(directionX, directionY, directionZ, rotation, xStart, xStep, y, startColumn, numberColumns);
+	}
+#endif
+
+	// Continues after the rays created with AVX.
+	vcolumn = _mm_add_epi32(_mm_set1_epi32(startColumn + i), _mm_set_epi32(3, 2, 1, 0));
+
+	for (; i + 4 <= numberColumns; i += 4)
+	{
+		__m128 vx = _mm_add_ps(vxStart, _mm_mul_ps(vxStep, _mm_cvtepi32_ps(vcolumn)));
+		__m128 vlength = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), vyy), vzz));
+		__m128 nx = _mm_div_ps(vx, vlength);
+		__m128 ny = _mm_div_ps(vy, vlength);
+		__m128 nz = _mm_div_ps(vz, vlength);
+
+		if (rotation)
+		{
+			__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(rotation[0]), nx), _mm_mul_ps(_mm_set1_ps(rotation[3]), ny)), _mm_mul_ps(_mm_set1_ps(rotation[6]), nz));
+			__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(rotation[1]), nx), _mm_mul_ps(_mm_set1_ps(rotation[4]), ny)), _mm_mul_ps(_mm_set1_ps(rotation[7]), nz));
+			__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(rotation[2]), nx), _mm_mul_ps(_mm_set1_ps(rotation[5]), ny)), _mm_mul_ps(_mm_set1_ps(rotation[8]), nz));
+
+			nx = rx;
+			ny = ry;
+			nz = rz;
+		}
+
+		_mm_storeu_ps(&directionX[i], nx);
+		_mm_storeu_ps(&directionY[i], ny);
+		_mm_storeu_ps(&directionZ[i], nz);
+
+		vcolumn = _mm_add_epi32(vcolumn, vfour);
+	}
+#elif defined(GLUS_RAYTRACE_NEON)
+	static const int32_t offsets[4] = { 0, 1, 2, 3 };
+
+	float32x4_t vxStart = vdupq_n_f32(xStart);
+	float32x4_t vxStep = vdupq_n_f32(xStep);
+	float32x4_t vy = vdupq_n_f32(y);
+	float32x4_t vz = vdupq_n_f32(-1.0f);
+	float32x4_t vyy = vmulq_f32(vy, vy);
+	float32x4_t vzz = vmulq_f32(vz, vz);
+	int32x4_t vcolumn = vaddq_s32(vdupq_n_s32(startColumn), vld1q_s32(offsets));
+	int32x4_t vfour = vdupq_n_s32(4);
+
+	for (; i + 4 <= numberColumns; i += 4)
+	{
+		// Separate multiply and add, as fused operations would change the result.
+		float32x4_t vx = vaddq_f32(vxStart, vmulq_f32(vxStep, vcvtq_f32_s32(vcolumn)));
+		float32x4_t vlength = vsqrtq_f32(vaddq_f32(vaddq_f32(vmulq_f32(vx, vx), vyy), vzz));
+		float32x4_t nx = vdivq_f32(vx, vlength);
+		float32x4_t ny = vdivq_f32(vy, vlength);
+		float32x4_t nz = vdivq_f32(vz, vlength);
+
+		if (rotation)
+		{
+			float32x4_t rx = vaddq_f32(vaddq_f32(vmulq_n_f32(nx, rotation[0]), vmulq_n_f32(ny, rotation[3])), vmulq_n_f32(nz, rotation[6]));
+			float32x4_t ry = vaddq_f32(vaddq_f32(vmulq_n_f32(nx, rotation[1]), vmulq_n_f32(ny, rotation[4])), vmulq_n_f32(nz, rotation[7]));
+			float32x4_t rz = vaddq_f32(vaddq_f32(vmulq_n_f32(nx, rotation[2]), vmulq_n_f32(ny, rotation[5])), vmulq_n_f32(nz, rotation[8]));
+
+			nx = rx;
+			ny = ry;
+			nz = rz;
+		}
+
+		vst1q_f32(&directionX[i], nx);
+		vst1q_f32(&directionY[i], ny);
+		vst1q_f32(&directionZ[i], nz);
+
+		vcolumn = vaddq_s32(vcolumn, vfour);
+	}
+#endif
+
+	// Remaining rays or no SIMD available.
+	for (; i < numberColumns; i++)
+	{
+		x = xStart + xStep * (GLUSfloat)(startColumn + i);
+		z = -1.0f;
+
+		length = sqrtf(x * x + y * y + z * z);
+
+		direction[0] = x / length;
+		direction[1] = y / length;
+		direction[2] = z / length;
+
+		if (rotation)
+		{
+			glusMatrix3x3MultiplyVector3f(direction, rotation, direction);
+		}
+
+		directionX[i] = direction[0];
+		directionY[i] = direction[1];
+		directionZ[i] = direction[2];
+	}
+}
+
+GLUSboolean GLUSAPIENTRY glusRaytracePerspectivef(GLUSfloat* directionBuffer, const GLUSubyte padding, const GLUSfloat fovy, const GLUSint width, const GLUSint height)
+{
+	GLUSint x, y, k;
+
+	GLUSfloat xStart, yStart, xStep, yStep;
+
+	GLUSfloat* direction;
+
+	if (!directionBuffer || width <= 0 || height <= 0)
+	{
+		return GLUS_FALSE;
+	}
+
+	glusRaytraceCreateExtend(&xStart, &yStart, &xStep, &yStep, fovy, width, height);
+
+	direction = directionBuffer;
+
+	for (y = 0; y < height; y++)
+	{
+		for (x = 0; x < width; x++)
+		{
+			direction[0] = xStart + xStep * (GLUSfloat)x;
+			direction[1] = yStart + yStep * (GLUSfloat)y;
+			direction[2] = -1.0f;
+
+			for (k = 0; k < padding; k++)
+			{
+				direction[3 + k] = 0.0f;
+			}
+
+			glusVector3Normalizef(direction);
+
+			direction += 3 + padding;
+		}
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusRaytraceLookAtf(GLUSfloat* positionBuffer, GLUSfloat* directionBuffer, const GLUSfloat* originDirectionBuffer, const GLUSubyte padding, const GLUSint width, const GLUSint height, const GLUSfloat eyeX, const GLUSfloat eyeY, const GLUSfloat eyeZ, const GLUSfloat centerX, const GLUSfloat centerY, const GLUSfloat centerZ, const GLUSfloat upX, const GLUSfloat upY, const GLUSfloat upZ)
+{
+	GLUSfloat rotation[9];
+	GLUSint i, k;
+
+	glusRaytraceCreateRotation(rotation, eyeX, eyeY, eyeZ, centerX, centerY, centerZ, upX, upY, upZ);
 
 	for (i = 0; i < width * height; i++)
 	{
@@ -111,3 +357,83 @@ GLUSvoid GLUSAPIENTRY glusRaytraceLookAtf(GLUSfloat* positionBuffer, GLUSfloat*
 		}
 	}
 }
+
+GLUSboolean GLUSAPIENTRY glusRaytracePerspectiveSoAf(GLUSfloat* directionX, GLUSfloat* directionY, GLUSfloat* directionZ, const GLUSfloat fovy, const GLUSint width, const GLUSint height)
+{
+	GLUSint y;
+
+	GLUSfloat xStart, yStart, xStep, yStep;
+
+	if (!directionX || !directionY || !directionZ || width <= 0 || height <= 0)
+	{
+		return GLUS_FALSE;
+	}
+
+	glusRaytraceCreateExtend(&xStart, &yStart, &xStep, &yStep, fovy, width, height);
+
+	for (y = 0; y < height; y++)
+	{
+		_glusRaytraceCreateDirectionsf(&directionX[y * width], &directionY[y * width], &directionZ[y * width], 0, xStart, xStep, yStart + yStep * (GLUSfloat)y, 0, width);
+	}
+
+	return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusRaytraceLookAtSoAf(GLUSfloat* directionX, GLUSfloat* directionY, GLUSfloat* directionZ, const GLUSfloat* originDirectionX, const GLUSfloat* originDirectionY, const GLUSfloat* originDirectionZ, const GLUSint width, const GLUSint height, const GLUSfloat eyeX, const GLUSfloat eyeY, const GLUSfloat eyeZ, const GLUSfloat centerX, const GLUSfloat centerY, const GLUSfloat centerZ, const GLUSfloat upX, const GLUSfloat upY, const GLUSfloat upZ)
+{
+	GLUSfloat rotation[9];
+	GLUSfloat x, y, z;
+	GLUSint i = 0;
+	GLUSint numberRays;
+
+	if (!directionX || !directionY || !directionZ || !originDirectionX || !originDirectionY || !originDirectionZ || width <= 0 || height <= 0)
+	{
+		return;
+	}
+
+	glusRaytraceCreateRotation(rotation, eyeX, eyeY, eyeZ, centerX, centerY, centerZ, upX, upY, upZ);
+
+	numberRays = width * height;
+
+#if defined(GLUS_RAYTRACE_AVX)
+	if (_glusBatchIsAvxEnabled())
+	{
+		i = glusRaytraceRotateDirectionsAvx(directionX, directionY, directionZ, originDirectionX, originDirectionY, originDirectionZ, rotation, numberRays);
+	}
+#endif
+
+#if defined(GLUS_RAYTRACE_SSE)
+	for (; i + 4 <= numberRays; i += 4)
+	{
+		__m128 vx = _mm_loadu_ps(&originDirectionX[i]);
+		__m128 vy = _mm_loadu_ps(&originDirectionY[i]);
+		__m128 vz = _mm_loadu_ps(&originDirectionZ[i]);
+
+		_mm_storeu_ps(&directionX[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(rotation[0]), vx), _mm_mul_ps(_mm_set1_ps(rotation[3]), vy)), _mm_mul_ps(_mm_set1_ps(rotation[6]), vz)));
+		_mm_storeu_ps(&directionY[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(rotation[1]), vx), _mm_mul_ps(_mm_set1_ps(rotation[4]), vy)), _mm_mul_ps(_mm_set1_ps(rotation[7]), vz)));
+		_mm_storeu_ps(&directionZ[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(rotation[2]), vx), _mm_mul_ps(_mm_set1_ps(rotation[5]), vy)), _mm_mul_ps(_mm_set1_ps(rotation[8]), vz)));
+	}
+#elif defined(GLUS_RAYTRACE_NEON)
+	for (; i + 4 <= numberRays; i += 4)
+	{
+		float32x4_t vx = vld1q_f32(&originDirectionX[i]);
+		float32x4_t vy = vld1q_f32(&originDirectionY[i]);
+		float32x4_t vz = vld1q_f32(&originDirectionZ[i]);
+
+		vst1q_f32(&directionX[i], vaddq_f32(vaddq_f32(vmulq_n_f32(vx, rotation[0]), vmulq_n_f32(vy, rotation[3])), vmulq_n_f32(vz, rotation[6])));
+		vst1q_f32(&directionY[i], vaddq_f32(vaddq_f32(vmulq_n_f32(vx, rotation[1]), vmulq_n_f32(vy, rotation[4])), vmulq_n_f32(vz, rotation[7])));
+		vst1q_f32(&directionZ[i], vaddq_f32(vaddq_f32(vmulq_n_f32(vx, rotation[2]), vmulq_n_f32(vy, rotation[5])), vmulq_n_f32(vz, rotation[8])));
+	}
+#endif
+
+	for (; i < numberRays; i++)
+	{
+		x = originDirectionX[i];
+		y = originDirectionY[i];
+		z = originDirectionZ[i];
+
+		directionX[i] = rotation[0] * x + rotation[3] * y + rotation[6] * z;
+		directionY[i] = rotation[1] * x + rotation[4] * y + rotation[7] * z;
+		directionZ[i] = rotation[2] * x + rotation[5] * y + rotation[8] * z;
+	}
+}
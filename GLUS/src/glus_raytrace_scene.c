@@ -0,0 +1,468 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+#define GLUS_RAYTRACE_TILE_SIZE 32
+
+// Below this number of spheres, testing all spheres is faster than traversing a hierarchy.
+#define GLUS_RAYTRACE_BVH_MIN_SPHERES 16
+
+#define GLUS_RAYTRACE_BIAS 1e-4f
+
+// Index of refraction of the surrounding medium.
+#define GLUS_RAYTRACE_AIR 1.0f
+
+extern GLUSboolean _glusThreadRunTiles(const GLUSint numberTiles, const GLUSint numberThreads, GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile), GLUSvoid* data);
+
+extern GLUSvoid _glusRaytraceCreateDirectionsf(GLUSfloat* directionX, GLUSfloat* directionY, GLUSfloat* directionZ, const GLUSfloat rotation[9], const GLUSfloat xStart, const GLUSfloat xStep, const GLUSfloat y, const GLUSint startColumn, const GLUSint numberColumns);
+
+typedef struct _GLUSraytracework
+{
+	const GLUSraytracescene* scene;
+
+	GLUStgaimage* tgaimage;
+
+	GLUSint stride;
+
+	GLUSint tilesX;
+
+	// Camera
+
+	GLUSfloat rotation[9];
+
+	GLUSfloat xStart;
+	GLUSfloat yStart;
+	GLUSfloat xStep;
+	GLUSfloat yStep;
+
+} GLUSraytracework;
+
+GLUSvoid GLUSAPIENTRY glusRaytraceSceneTracef(GLUSfloat pixelColor[4], const GLUSraytracescene* scene, const GLUSfloat rayPosition[4], const GLUSfloat rayDirection[3], const GLUSint depth)
+{
+	GLUSint i, k;
+
+	GLUSfloat tNear = INFINITY;
+	const GLUSraytracesphere* sphereNear = 0;
+	GLUSboolean insideSphereNear = GLUS_FALSE;
+
+	GLUSfloat ray[3];
+
+	GLUSfloat hitPosition[4];
+	GLUSfloat hitDirection[3];
+
+	GLUSfloat biasedPositiveHitPosition[4];
+	GLUSfloat biasedNegativeHitPosition[4];
+	GLUSfloat biasedHitDirection[3];
+
+	GLUSfloat eyeDirection[3];
+
+	GLUSfloat reflectionColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	GLUSfloat refractionColor[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+	const GLUSraytracematerial* material;
+
+	GLUSfloat eta, r0, fresnel;
+
+	//
+
+	pixelColor[0] = 0.0f;
+	pixelColor[1] = 0.0f;
+	pixelColor[2] = 0.0f;
+	pixelColor[3] = 1.0f;
+
+	//
+
+	if (scene->bvh)
+	{
+		GLUSbvhhit hit;
+
+		if (glusBvhIntersectRayClosestf(&hit, scene->bvh, rayPosition, rayDirection, INFINITY))
+		{
+			tNear = hit.t;
+			sphereNear = &scene->spheres[hit.primitive];
+			insideSphereNear = hit.insideSphere;
+		}
+	}
+	else
+	{
+		for (i = 0; i < scene->numberSpheres; i++)
+		{
+			GLUSfloat t0 = INFINITY;
+			GLUSfloat t1 = INFINITY;
+			GLUSboolean insideSphere = GLUS_FALSE;
+
+			const GLUSraytracesphere* currentSphere = &scene->spheres[i];
+
+			if (glusIntersectRaySpheref(&t0, &t1, &insideSphere, rayPosition, rayDirection, currentSphere->center, currentSphere->radius))
+			{
+				// If intersection happened inside the sphere, take second intersection point, as this one is on the surface.
+				if (insideSphere)
+				{
+					t0 = t1;
+				}
+
+				// Found a sphere, which is closer.
+				if (t0 < tNear)
+				{
+					tNear = t0;
+					sphereNear = currentSphere;
+					insideSphereNear = insideSphere;
+				}
+			}
+		}
+	}
+
+	//
+
+	// No intersection, return background color / ambient light.
+	if (!sphereNear)
+	{
+		pixelColor[0] = scene->backgroundColor[0];
+		pixelColor[1] = scene->backgroundColor[1];
+		pixelColor[2] = scene->backgroundColor[2];
+
+		return;
+	}
+
+	material = &sphereNear->material;
+
+	// Calculate ray hit position ...
+	glusVector3MultiplyScalarf(ray, rayDirection, tNear);
+	glusPoint4AddVector3f(hitPosition, rayPosition, ray);
+
+	// ... and normal
+	glusPoint4SubtractPoint4f(hitDirection, hitPosition, sphereNear->center);
+	glusVector3Normalizef(hitDirection);
+
+	// If inside the sphere, reverse hit vector, as ray comes from inside.
+	if (insideSphereNear)
+	{
+		glusVector3MultiplyScalarf(hitDirection, hitDirection, -1.0f);
+	}
+
+	//
+
+	// Biasing, to avoid artifacts.
+	glusVector3MultiplyScalarf(biasedHitDirection, hitDirection, GLUS_RAYTRACE_BIAS);
+	glusPoint4AddVector3f(biasedPositiveHitPosition, hitPosition, biasedHitDirection);
+	glusPoint4SubtractVector3f(biasedNegativeHitPosition, hitPosition, biasedHitDirection);
+
+	//
+
+	// Air to material ratio of the indices of refraction and reflectivity, see http://en.wikipedia.org/wiki/Refractive_index
+	eta = GLUS_RAYTRACE_AIR / material->refractiveIndex;
+	r0 = ((GLUS_RAYTRACE_AIR - material->refractiveIndex) * (GLUS_RAYTRACE_AIR - material->refractiveIndex)) / ((GLUS_RAYTRACE_AIR + material->refractiveIndex) * (GLUS_RAYTRACE_AIR + material->refractiveIndex));
+
+	fresnel = glusVector3Fresnelf(rayDirection, hitDirection, r0);
+
+	// Reflection ...
+	if (material->reflectivity > 0.0f && depth < scene->maxDepth)
+	{
+		GLUSfloat reflectionDirection[3];
+
+		glusVector3Reflectf(reflectionDirection, rayDirection, hitDirection);
+		glusVector3Normalizef(reflectionDirection);
+
+		glusRaytraceSceneTracef(reflectionColor, scene, biasedPositiveHitPosition, reflectionDirection, depth + 1);
+	}
+
+	// ... refraction.
+	if (material->alpha < 1.0f && depth < scene->maxDepth)
+	{
+		GLUSfloat refractionDirection[3];
+
+		// If inside, it is from material to air.
+		if (insideSphereNear)
+		{
+			eta = 1.0f / eta;
+		}
+
+		glusVector3Refractf(refractionDirection, rayDirection, hitDirection, eta);
+		glusVector3Normalizef(refractionDirection);
+
+		glusRaytraceSceneTracef(refractionColor, scene, biasedNegativeHitPosition, refractionDirection, depth + 1);
+	}
+	else
+	{
+		fresnel = 1.0f;
+	}
+
+	//
+
+	glusVector3MultiplyScalarf(eyeDirection, rayDirection, -1.0f);
+
+	// Diffuse and specular color
+	for (i = 0; i < scene->numberPointLights; i++)
+	{
+		const GLUSraytracepointlight* pointLight = &scene->pointLights[i];
+
+		GLUSboolean obstacle = GLUS_FALSE;
+		GLUSfloat lightDirection[3];
+		GLUSfloat incidentLightDirection[3];
+
+		glusPoint4SubtractPoint4f(lightDirection, pointLight->position, hitPosition);
+		glusVector3Normalizef(lightDirection);
+		glusVector3MultiplyScalarf(incidentLightDirection, lightDirection, -1.0f);
+
+		// Check for obstacles between current hit point surface and point light.
+		if (scene->bvh)
+		{
+			obstacle = glusBvhIntersectRayAnyf(scene->bvh, biasedPositiveHitPosition, lightDirection, INFINITY, (GLUSint)(sphereNear - scene->spheres));
+		}
+		else
+		{
+			for (k = 0; k < scene->numberSpheres; k++)
+			{
+				const GLUSraytracesphere* obstacleSphere = &scene->spheres[k];
+
+				if (obstacleSphere == sphereNear)
+				{
+					continue;
+				}
+
+				if (glusIntersectRaySpheref(0, 0, 0, biasedPositiveHitPosition, lightDirection, obstacleSphere->center, obstacleSphere->radius))
+				{
+					obstacle = GLUS_TRUE;
+
+					break;
+				}
+			}
+		}
+
+		// If no obstacle, illuminate hit point surface.
+		if (!obstacle)
+		{
+			GLUSfloat diffuseIntensity = glusMathMaxf(0.0f, glusVector3Dotf(hitDirection, lightDirection));
+
+			if (diffuseIntensity > 0.0f)
+			{
+				GLUSfloat specularReflection[3];
+
+				GLUSfloat eDotR;
+
+				pixelColor[0] = pixelColor[0] + diffuseIntensity * material->diffuseColor[0] * pointLight->color[0];
+				pixelColor[1] = pixelColor[1] + diffuseIntensity * material->diffuseColor[1] * pointLight->color[1];
+				pixelColor[2] = pixelColor[2] + diffuseIntensity * material->diffuseColor[2] * pointLight->color[2];
+
+				glusVector3Reflectf(specularReflection, incidentLightDirection, hitDirection);
+				glusVector3Normalizef(specularReflection);
+
+				eDotR = glusMathMaxf(0.0f, glusVector3Dotf(eyeDirection, specularReflection));
+
+				if (eDotR > 0.0f && !insideSphereNear)
+				{
+					GLUSfloat specularIntensity = powf(eDotR, material->shininess);
+
+					pixelColor[0] = pixelColor[0] + specularIntensity * material->specularColor[0] * pointLight->color[0];
+					pixelColor[1] = pixelColor[1] + specularIntensity * material->specularColor[1] * pointLight->color[1];
+					pixelColor[2] = pixelColor[2] + specularIntensity * material->specularColor[2] * pointLight->color[2];
+				}
+			}
+		}
+	}
+
+	// Emissive color
+	pixelColor[0] = pixelColor[0] + material->emissiveColor[0];
+	pixelColor[1] = pixelColor[1] + material->emissiveColor[1];
+	pixelColor[2] = pixelColor[2] + material->emissiveColor[2];
+
+	// Final color with reflection and refraction
+	pixelColor[0] = (1.0f - fresnel) * refractionColor[0] * (1.0f - material->alpha) + pixelColor[0] * (1.0f - material->reflectivity) * material->alpha + fresnel * reflectionColor[0] * material->reflectivity;
+	pixelColor[1] = (1.0f - fresnel) * refractionColor[1] * (1.0f - material->alpha) + pixelColor[1] * (1.0f - material->reflectivity) * material->alpha + fresnel * reflectionColor[1] * material->reflectivity;
+	pixelColor[2] = (1.0f - fresnel) * refractionColor[2] * (1.0f - material->alpha) + pixelColor[2] * (1.0f - material->reflectivity) * material->alpha + fresnel * reflectionColor[2] * material->reflectivity;
+}
+
+static GLUSvoid glusRaytraceSceneRenderTile(GLUSvoid* data, const GLUSint tile)
+{
+	const GLUSraytracework* work = (const GLUSraytracework*)data;
+
+	const GLUSraytracescene* scene = work->scene;
+	GLUStgaimage* tgaimage = work->tgaimage;
+
+	GLUSint x, y, startX, startY, endX, endY, index;
+
+	GLUSfloat rayPosition[4];
+	GLUSfloat rayDirection[3];
+
+	GLUSfloat directionX[GLUS_RAYTRACE_TILE_SIZE];
+	GLUSfloat directionY[GLUS_RAYTRACE_TILE_SIZE];
+	GLUSfloat directionZ[GLUS_RAYTRACE_TILE_SIZE];
+
+	GLUSfloat pixelColor[4];
+
+	startX = (tile % work->tilesX) * GLUS_RAYTRACE_TILE_SIZE;
+	startY = (tile / work->tilesX) * GLUS_RAYTRACE_TILE_SIZE;
+
+	endX = startX + GLUS_RAYTRACE_TILE_SIZE < tgaimage->width ? startX + GLUS_RAYTRACE_TILE_SIZE : tgaimage->width;
+	endY = startY + GLUS_RAYTRACE_TILE_SIZE < tgaimage->height ? startY + GLUS_RAYTRACE_TILE_SIZE : tgaimage->height;
+
+	rayPosition[0] = scene->eye[0];
+	rayPosition[1] = scene->eye[1];
+	rayPosition[2] = scene->eye[2];
+	rayPosition[3] = 1.0f;
+
+	for (y = startY; y < endY; y++)
+	{
+		// Same rays as created by glusRaytracePerspectivef and glusRaytraceLookAtf.
+		_glusRaytraceCreateDirectionsf(directionX, directionY, directionZ, work->rotation, work->xStart, work->xStep, work->yStart + work->yStep * (GLUSfloat)y, startX, endX - startX);
+
+		for (x = startX; x < endX; x++)
+		{
+			rayDirection[0] = directionX[x - startX];
+			rayDirection[1] = directionY[x - startX];
+			rayDirection[2] = directionZ[x - startX];
+
+			glusRaytraceSceneTracef(pixelColor, scene, rayPosition, rayDirection, 0);
+
+			index = (x + y * tgaimage->width) * work->stride;
+
+			tgaimage->data[index + 0] = (GLUSubyte)(glusMathMinf(1.0f, pixelColor[0]) * 255.0f);
+			tgaimage->data[index + 1] = (GLUSubyte)(glusMathMinf(1.0f, pixelColor[1]) * 255.0f);
+			tgaimage->data[index + 2] = (GLUSubyte)(glusMathMinf(1.0f, pixelColor[2]) * 255.0f);
+
+			if (work->stride == 4)
+			{
+				tgaimage->data[index + 3] = 255;
+			}
+		}
+	}
+}
+
+GLUSboolean GLUSAPIENTRY glusRaytraceSceneRender(GLUStgaimage* tgaimage, const GLUSraytracescene* scene, const GLUSint numberThreads)
+{
+	GLUSraytracework work;
+
+	GLUSraytracescene bvhScene;
+	GLUSbvh bvh;
+
+	GLUSfloat forward[3], side[3], up[3];
+
+	GLUSfloat xExtend, yExtend;
+
+	GLUSint numberTiles, tilesY;
+
+	GLUSboolean result;
+
+	if (!tgaimage || !tgaimage->data || !scene || tgaimage->depth != 1 || (scene->numberSpheres > 0 && !scene->spheres) || (scene->numberPointLights > 0 && !scene->pointLights))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (tgaimage->format == GLUS_RGB)
+	{
+		work.stride = 3;
+	}
+	else if (tgaimage->format == GLUS_RGBA)
+	{
+		work.stride = 4;
+	}
+	else
+	{
+		return GLUS_FALSE;
+	}
+
+	memset(&bvh, 0, sizeof(GLUSbvh));
+
+	if (!scene->bvh && scene->numberSpheres >= GLUS_RAYTRACE_BVH_MIN_SPHERES)
+	{
+		if (!glusBvhCreateSpheresf(&bvh, scene->spheres[0].center, &scene->spheres[0].radius, sizeof(GLUSraytracesphere), scene->numberSpheres))
+		{
+			return GLUS_FALSE;
+		}
+
+		memcpy(&bvhScene, scene, sizeof(GLUSraytracescene));
+
+		bvhScene.bvh = &bvh;
+
+		scene = &bvhScene;
+	}
+
+	work.scene = scene;
+	work.tgaimage = tgaimage;
+
+	// Camera, see glusRaytracePerspectivef and glusRaytraceLookAtf.
+
+	yExtend = tanf(glusMathDegToRadf(scene->fovy * 0.5f));
+	xExtend = yExtend * ((GLUSfloat)tgaimage->width / (GLUSfloat)tgaimage->height);
+
+	work.xStep = xExtend / ((GLUSfloat)(tgaimage->width) * 0.5f);
+	work.yStep = yExtend / ((GLUSfloat)(tgaimage->height) * 0.5f);
+
+	work.xStart = -xExtend + work.xStep * 0.5f;
+	work.yStart = -yExtend + work.yStep * 0.5f;
+
+	forward[0] = scene->center[0] - scene->eye[0];
+	forward[1] = scene->center[1] - scene->eye[1];
+	forward[2] = scene->center[2] - scene->eye[2];
+	glusVector3Normalizef(forward);
+
+	glusVector3Crossf(side, forward, scene->up);
+	glusVector3Normalizef(side);
+
+	glusVector3Crossf(up, side, forward);
+
+	work.rotation[0] = side[0];
+	work.rotation[1] = side[1];
+	work.rotation[2] = side[2];
+
+	work.rotation[3] = up[0];
+	work.rotation[4] = up[1];
+	work.rotation[5] = up[2];
+
+	work.rotation[6] = -forward[0];
+	work.rotation[7] = -forward[1];
+	work.rotation[8] = -forward[2];
+
+	work.tilesX = (tgaimage->width + GLUS_RAYTRACE_TILE_SIZE - 1) / GLUS_RAYTRACE_TILE_SIZE;
+	tilesY = (tgaimage->height + GLUS_RAYTRACE_TILE_SIZE - 1) / GLUS_RAYTRACE_TILE_SIZE;
+	numberTiles = work.tilesX * tilesY;
+
+	result = _glusThreadRunTiles(numberTiles, numberThreads, glusRaytraceSceneRenderTile, &work);
+
+	glusBvhDestroyf(&bvh);
+
+	return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusRaytraceSceneSaveTga(const GLUSchar* filename, const GLUSint width, const GLUSint height, const GLUSraytracescene* scene, const GLUSint numberThreads)
+{
+	GLUStgaimage tgaimage;
+
+	GLUSboolean result;
+
+	if (!filename || !scene)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!glusImageCreateTga(&tgaimage, width, height, 1, GLUS_RGB))
+	{
+		return GLUS_FALSE;
+	}
+
+	result = glusRaytraceSceneRender(&tgaimage, scene, numberThreads);
+
+	if (result)
+	{
+		result = glusImageSaveTga(filename, &tgaimage);
+	}
+
+	glusImageDestroyTga(&tgaimage);
+
+	return result;
+}
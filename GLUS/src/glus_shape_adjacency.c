@@ -19,6 +19,30 @@
 
 #define GLUS_POINT_TOLERANCE 0.001f
 
+#define GLUS_EDGE_NONE 0xFFFFFFFF
+
+/**
+ * Hash map of triangle edges. Every triangle contributes three entries, which are chained per bucket.
+ * The chains are built in triangle order, so the first match is the same as with a linear scan.
+ */
+typedef struct _GLUSedgemap
+{
+	GLUSuint* buckets;
+
+	GLUSuint* next;
+
+	GLUSuint* tail;
+
+	GLUSuint* low;
+
+	GLUSuint* high;
+
+	GLUSuint* opposite;
+
+	GLUSuint bucketMask;
+
+} GLUSedgemap;
+
 static GLUSboolean glusShapeCheckCompletef(GLUSshape* shape)
 {
 	if (!shape)
@@ -29,134 +53,287 @@ static GLUSboolean glusShapeCheckCompletef(GLUSshape* shape)
 	return shape->vertices && shape->normals && shape->tangents && shape->bitangents && shape->texCoords && shape->allAttributes && shape->indices;
 }
 
-static GLUSboolean glusShapeFindIndexByIndicesf(GLUSuint* adjacentIndex, GLUSuint triangleFirstIndex, GLUSuint edge, const GLUSshape* shape)
+static GLUSuint glusShapeHashEdgef(GLUSuint low, GLUSuint high, GLUSuint mask)
 {
-	GLUSuint i, k, m;
+	return ((low * 73856093u) ^ (high * 19349663u)) & mask;
+}
 
-	GLUSuint equalIndices;
+static GLUSuint glusShapeHashCellf(GLUSint x, GLUSint y, GLUSint z, GLUSuint mask)
+{
+	return (((GLUSuint)x * 73856093u) ^ ((GLUSuint)y * 19349663u) ^ ((GLUSuint)z * 83492791u)) & mask;
+}
 
-	GLUSuint edgeIndices[2];
+static GLUSuint glusShapeBucketCountf(GLUSuint elements)
+{
+	GLUSuint bucketCount = 1;
 
-	if (!adjacentIndex || !shape)
+	while (bucketCount < elements * 2 && bucketCount < 0x80000000)
 	{
-		return GLUS_FALSE;
+		bucketCount <<= 1;
+	}
+
+	return bucketCount;
+}
+
+static GLUSvoid glusShapeDestroyEdgeMapf(GLUSedgemap* edgeMap)
+{
+	if (!edgeMap)
+	{
+		return;
 	}
 
-	if (shape->mode != GLUS_TRIANGLES)
+	glusMemoryFree(edgeMap->buckets);
+	glusMemoryFree(edgeMap->next);
+	glusMemoryFree(edgeMap->tail);
+	glusMemoryFree(edgeMap->low);
+	glusMemoryFree(edgeMap->high);
+	glusMemoryFree(edgeMap->opposite);
+
+	memset(edgeMap, 0, sizeof(GLUSedgemap));
+}
+
+/**
+ * Builds the edge map. The vertex indices of the triangles are optionally remapped, e.g. to welded vertices.
+ * Degenerated triangles are not added.
+ */
+static GLUSboolean glusShapeCreateEdgeMapf(GLUSedgemap* edgeMap, const GLUSshape* shape, const GLUSuint* remap)
+{
+	GLUSuint i, edge, entry, bucket;
+
+	GLUSuint numberTriangles = shape->numberIndices / 3;
+
+	GLUSuint bucketCount = glusShapeBucketCountf(numberTriangles * 3);
+
+	GLUSuint triangle[3];
+
+	memset(edgeMap, 0, sizeof(GLUSedgemap));
+
+	edgeMap->buckets = (GLUSuint*)glusMemoryMalloc(bucketCount * sizeof(GLUSuint));
+	edgeMap->tail = (GLUSuint*)glusMemoryMalloc(bucketCount * sizeof(GLUSuint));
+	edgeMap->next = (GLUSuint*)glusMemoryMalloc(numberTriangles * 3 * sizeof(GLUSuint));
+	edgeMap->low = (GLUSuint*)glusMemoryMalloc(numberTriangles * 3 * sizeof(GLUSuint));
+	edgeMap->high = (GLUSuint*)glusMemoryMalloc(numberTriangles * 3 * sizeof(GLUSuint));
+	edgeMap->opposite = (GLUSuint*)glusMemoryMalloc(numberTriangles * 3 * sizeof(GLUSuint));
+
+	if (!edgeMap->buckets || !edgeMap->tail || !edgeMap->next || !edgeMap->low || !edgeMap->high || !edgeMap->opposite)
 	{
+		glusShapeDestroyEdgeMapf(edgeMap);
+
 		return GLUS_FALSE;
 	}
 
-	for (i = 0; i < shape->numberIndices / 3; i++)
+	edgeMap->bucketMask = bucketCount - 1;
+
+	memset(edgeMap->buckets, 0xFF, bucketCount * sizeof(GLUSuint));
+
+	for (i = 0; i < numberTriangles; i++)
 	{
-		// Skip same triangle
-		if (triangleFirstIndex == i * 3)
+		for (edge = 0; edge < 3; edge++)
 		{
-			continue;
+			triangle[edge] = remap ? remap[shape->indices[3 * i + edge]] : shape->indices[3 * i + edge];
 		}
 
-		equalIndices = 0;
-
-		for (k = 0; k < 3; k++)
+		for (edge = 0; edge < 3; edge++)
 		{
-			for (m = 0 + edge; m < 2 + edge; m++)
+			entry = 3 * i + edge;
+
+			edgeMap->next[entry] = GLUS_EDGE_NONE;
+
+			if (triangle[0] == triangle[1] || triangle[0] == triangle[2] || triangle[1] == triangle[2])
 			{
-				if (shape->indices[triangleFirstIndex + (m % 3)] == shape->indices[i * 3 + k])
-				{
-					equalIndices++;
+				continue;
+			}
 
-					edgeIndices[m - edge] = shape->indices[i * 3 + k];
+			edgeMap->low[entry] = triangle[edge] < triangle[(edge + 1) % 3] ? triangle[edge] : triangle[(edge + 1) % 3];
+			edgeMap->high[entry] = triangle[edge] < triangle[(edge + 1) % 3] ? triangle[(edge + 1) % 3] : triangle[edge];
 
-					break;
-				}
+			// Always store the original index, as this one is written to the adjacency indices.
+			edgeMap->opposite[entry] = shape->indices[3 * i + (edge + 2) % 3];
+
+			bucket = glusShapeHashEdgef(edgeMap->low[entry], edgeMap->high[entry], edgeMap->bucketMask);
+
+			// Append, so the chain stays in triangle order.
+			if (edgeMap->buckets[bucket] == GLUS_EDGE_NONE)
+			{
+				edgeMap->buckets[bucket] = entry;
+			}
+			else
+			{
+				edgeMap->next[edgeMap->tail[bucket]] = entry;
 			}
+			edgeMap->tail[bucket] = entry;
 		}
+	}
+
+	return GLUS_TRUE;
+}
+
+/**
+ * Finds the opposite index of the first other triangle sharing the given edge.
+ * The number of other triangles sharing this edge is returned. A value greater than one means a non-manifold edge.
+ */
+static GLUSuint glusShapeFindIndexByEdgef(GLUSuint* adjacentIndex, const GLUSedgemap* edgeMap, GLUSuint triangleIndex, GLUSuint first, GLUSuint second)
+{
+	GLUSuint entry;
+
+	GLUSuint low = first < second ? first : second;
+	GLUSuint high = first < second ? second : first;
 
-		if (equalIndices == 2)
+	GLUSuint found = 0;
+
+	entry = edgeMap->buckets[glusShapeHashEdgef(low, high, edgeMap->bucketMask)];
+
+	while (entry != GLUS_EDGE_NONE)
+	{
+		// Skip same triangle
+		if (entry / 3 != triangleIndex && edgeMap->low[entry] == low && edgeMap->high[entry] == high)
 		{
-			for (k = 0; k < 3; k++)
+			if (found == 0)
 			{
-				if (shape->indices[i * 3 + k] != edgeIndices[0] && shape->indices[i * 3 + k] != edgeIndices[1])
-				{
-					*adjacentIndex = shape->indices[i * 3 + k];
-
-					break;
-				}
+				*adjacentIndex = edgeMap->opposite[entry];
 			}
 
-			return GLUS_TRUE;
+			found++;
 		}
+
+		entry = edgeMap->next[entry];
 	}
 
-	return GLUS_FALSE;
+	return found;
 }
 
-static GLUSboolean glusShapeFindIndexByVerticesf(GLUSuint* adjacentIndex, GLUSuint triangleIndex, GLUSuint edge, const GLUSshape* shape)
+/**
+ * Finds the vertex with the lowest index, a vertex is welded to. Visited vertices are linked directly to it.
+ */
+static GLUSuint glusShapeFindWeldf(GLUSuint* weld, GLUSuint vertex)
 {
-	GLUSuint i, k, m;
-
-	GLUSuint equalVertices, walkerIndex, searchIndex;
-
-	GLUSuint edgeIndices[2];
+	GLUSuint root = vertex;
+	GLUSuint parent;
 
-	if (!adjacentIndex || !shape)
+	while (weld[root] != root)
 	{
-		return GLUS_FALSE;
+		root = weld[root];
 	}
 
-	if (shape->mode != GLUS_TRIANGLES)
+	while (weld[vertex] != root)
 	{
-		return GLUS_FALSE;
+		parent = weld[vertex];
+
+		weld[vertex] = root;
+
+		vertex = parent;
 	}
 
-	for (i = 0; i < shape->numberIndices / 3; i++)
+	return root;
+}
+
+/**
+ * Welds the vertices, which are within the point tolerance, to the vertex with the lowest index.
+ * Only the first vertex of a group, the representative, is put into a spatial hash with a cell size larger than the tolerance.
+ * A new vertex is compared against the representatives in the neighbour cells. If it is within the tolerance of several of them, their groups are merged.
+ * A vertex, which is only within the tolerance of a non representative vertex of a group, starts a new group.
+ */
+static GLUSuint* glusShapeCreateWeldMapf(const GLUSshape* shape)
+{
+	GLUSuint i, walker, bucket, root, walkerRoot;
+
+	GLUSboolean welded;
+
+	GLUSint x, y, z, cellX, cellY, cellZ;
+
+	GLUSuint bucketCount = glusShapeBucketCountf(shape->numberVertices);
+
+	GLUSfloat cellSize = 2.0f * GLUS_POINT_TOLERANCE;
+
+	const GLUSfloat* search;
+	const GLUSfloat* compare;
+
+	GLUSuint* buckets;
+	GLUSuint* next;
+	GLUSuint* weld;
+
+	buckets = (GLUSuint*)glusMemoryMalloc(bucketCount * sizeof(GLUSuint));
+	next = (GLUSuint*)glusMemoryMalloc(shape->numberVertices * sizeof(GLUSuint));
+	weld = (GLUSuint*)glusMemoryMalloc(shape->numberVertices * sizeof(GLUSuint));
+
+	if (!buckets || !next || !weld)
 	{
-		// Skip same triangle
-		if (triangleIndex == i * 3)
-		{
-			continue;
-		}
+		glusMemoryFree(buckets);
+		glusMemoryFree(next);
+		glusMemoryFree(weld);
 
-		equalVertices = 0;
+		return 0;
+	}
 
-		for (k = 0; k < 3; k++)
-		{
-			walkerIndex = shape->indices[i * 3 + k];
+	memset(buckets, 0xFF, bucketCount * sizeof(GLUSuint));
 
-			for (m = 0 + edge; m < 2 + edge; m++)
-			{
-				searchIndex = shape->indices[triangleIndex + (m % 3)];
+	for (i = 0; i < shape->numberVertices; i++)
+	{
+		search = &shape->vertices[4 * i];
 
-				if (shape->vertices[4 * searchIndex + 0] >= shape->vertices[4 * walkerIndex + 0] - GLUS_POINT_TOLERANCE && shape->vertices[4 * searchIndex + 0] <= shape->vertices[4 * walkerIndex + 0] + GLUS_POINT_TOLERANCE &&
-						shape->vertices[4 * searchIndex + 1] >= shape->vertices[4 * walkerIndex + 1] - GLUS_POINT_TOLERANCE && shape->vertices[4 * searchIndex + 1] <= shape->vertices[4 * walkerIndex + 1] + GLUS_POINT_TOLERANCE &&
-						shape->vertices[4 * searchIndex + 2] >= shape->vertices[4 * walkerIndex + 2] - GLUS_POINT_TOLERANCE && shape->vertices[4 * searchIndex + 2] <= shape->vertices[4 * walkerIndex + 2] + GLUS_POINT_TOLERANCE)
-				{
-					equalVertices++;
+		cellX = (GLUSint)floorf(search[0] / cellSize);
+		cellY = (GLUSint)floorf(search[1] / cellSize);
+		cellZ = (GLUSint)floorf(search[2] / cellSize);
 
-					edgeIndices[m - edge] = walkerIndex;
+		weld[i] = i;
 
-					break;
-				}
-			}
-		}
+		welded = GLUS_FALSE;
 
-		if (equalVertices == 2)
+		for (z = cellZ - 1; z <= cellZ + 1; z++)
 		{
-			for (k = 0; k < 3; k++)
+			for (y = cellY - 1; y <= cellY + 1; y++)
 			{
-				if (shape->indices[i * 3 + k] != edgeIndices[0] && shape->indices[i * 3 + k] != edgeIndices[1])
+				for (x = cellX - 1; x <= cellX + 1; x++)
 				{
-					*adjacentIndex = shape->indices[i * 3 + k];
-
-					break;
+					walker = buckets[glusShapeHashCellf(x, y, z, bucketCount - 1)];
+
+					while (walker != GLUS_EDGE_NONE)
+					{
+						compare = &shape->vertices[4 * walker];
+
+						if (fabsf(search[0] - compare[0]) <= GLUS_POINT_TOLERANCE && fabsf(search[1] - compare[1]) <= GLUS_POINT_TOLERANCE && fabsf(search[2] - compare[2]) <= GLUS_POINT_TOLERANCE)
+						{
+							root = glusShapeFindWeldf(weld, i);
+							walkerRoot = glusShapeFindWeldf(weld, walker);
+
+							// The group with the higher index is welded to the other one.
+							if (root < walkerRoot)
+							{
+								weld[walkerRoot] = root;
+							}
+							else
+							{
+								weld[root] = walkerRoot;
+							}
+
+							welded = GLUS_TRUE;
+						}
+
+						walker = next[walker];
+					}
 				}
 			}
+		}
 
-			return GLUS_TRUE;
+		// Welded vertices are not inserted, so the number of compares per vertex is bound by the representatives around it.
+		if (!welded)
+		{
+			bucket = glusShapeHashCellf(cellX, cellY, cellZ, bucketCount - 1);
+
+			next[i] = buckets[bucket];
+			buckets[bucket] = i;
 		}
 	}
 
-	return GLUS_FALSE;
+	for (i = 0; i < shape->numberVertices; i++)
+	{
+		weld[i] = glusShapeFindWeldf(weld, i);
+	}
+
+	glusMemoryFree(buckets);
+	glusMemoryFree(next);
+
+	return weld;
 }
 
 GLUSboolean GLUSAPIENTRY glusShapeCreateAdjacencyIndicesf(GLUSshape* adjacencyShape, const GLUSshape* sourceShape)
@@ -165,7 +342,14 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateAdjacencyIndicesf(GLUSshape* adjacencySh
 
 	GLUSuint numberIndices;
 
-	GLUSuint adjacentIndex, edge;
+	GLUSuint adjacentIndex, edge, first, second, found;
+
+	GLUSuint numberNonManifold = 0;
+
+	GLUSedgemap indexMap;
+	GLUSedgemap vertexMap;
+
+	GLUSuint* weld = 0;
 
 	if (!adjacencyShape || !sourceShape)
 	{
@@ -205,6 +389,16 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateAdjacencyIndicesf(GLUSshape* adjacencySh
 		return GLUS_FALSE;
 	}
 
+	if (!glusShapeCreateEdgeMapf(&indexMap, sourceShape, 0))
+	{
+		glusShapeDestroyf(adjacencyShape);
+
+		return GLUS_FALSE;
+	}
+
+	// The vertex based edge map is only created on demand.
+	memset(&vertexMap, 0, sizeof(GLUSedgemap));
+
 	// Process all triangles
 	for (i = 0; i < sourceShape->numberIndices / 3; i++)
 	{
@@ -227,25 +421,61 @@ GLUSboolean GLUSAPIENTRY glusShapeCreateAdjacencyIndicesf(GLUSshape* adjacencySh
 		{
 			adjacentIndex = 0;
 
-			// ... by scanning the indices ...
-			if (glusShapeFindIndexByIndicesf(&adjacentIndex, 3 * i, edge, sourceShape))
+			first = sourceShape->indices[3 * i + edge];
+			second = sourceShape->indices[3 * i + (edge + 1) % 3];
+
+			// ... by looking up the indices ...
+			found = glusShapeFindIndexByEdgef(&adjacentIndex, &indexMap, i, first, second);
+
+			// ... and if not found, look up the welded vertices.
+			if (!found)
 			{
-				adjacencyShape->indices[6 * i + edge * 2 + 1] = adjacentIndex;
+				if (!weld)
+				{
+					weld = glusShapeCreateWeldMapf(sourceShape);
 
-				continue;
+					if (!weld || !glusShapeCreateEdgeMapf(&vertexMap, sourceShape, weld))
+					{
+						glusMemoryFree(weld);
+
+						glusShapeDestroyEdgeMapf(&indexMap);
+
+						glusShapeDestroyf(adjacencyShape);
+
+						return GLUS_FALSE;
+					}
+				}
+
+				found = glusShapeFindIndexByEdgef(&adjacentIndex, &vertexMap, i, weld[first], weld[second]);
 			}
 
-			// ... and if not found, compare the vertices.
-			if (glusShapeFindIndexByVerticesf(&adjacentIndex, 3 * i, edge, sourceShape))
+			if (!found)
 			{
-				adjacencyShape->indices[6 * i + edge * 2 + 1] = adjacentIndex;
+				glusLogPrint(GLUS_LOG_WARNING, "Triangle %d with edge %d: No adjacent index found!", i, edge);
 
 				continue;
 			}
 
-			glusLogPrint(GLUS_LOG_WARNING, "Triangle %d with edge %d: No adjacent index found!", i, edge);
+			if (found > 1)
+			{
+				glusLogPrint(GLUS_LOG_WARNING, "Triangle %d with edge %d: Non-manifold edge shared by %d triangles!", i, edge, found + 1);
+
+				numberNonManifold++;
+			}
+
+			adjacencyShape->indices[6 * i + edge * 2 + 1] = adjacentIndex;
 		}
 	}
 
+	if (numberNonManifold > 0)
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "%d non-manifold triangle edges found. First adjacent triangle used.", numberNonManifold);
+	}
+
+	glusMemoryFree(weld);
+
+	glusShapeDestroyEdgeMapf(&vertexMap);
+	glusShapeDestroyEdgeMapf(&indexMap);
+
 	return GLUS_TRUE;
 }
@@ -17,9 +17,30 @@
 
 #include "GL/glus.h"
 
-extern GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUSwavefront* wavefront, GLUSscene* scene);
+extern GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUSwavefront* wavefront, GLUSscene* scene, GLUSboolean indexed);
 
 GLUSboolean GLUSAPIENTRY glusShapeLoadWavefront(const GLUSchar* filename, GLUSshape* shape)
 {
-	return _glusWavefrontParse(filename, shape, 0, 0);
+	GLUSboolean result;
+
+	GLUS_PROFILE_BEGIN("glusShapeLoadWavefront");
+
+	result = _glusWavefrontParse(filename, shape, 0, 0, GLUS_FALSE);
+
+	GLUS_PROFILE_END();
+
+	return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusShapeLoadWavefrontIndexed(const GLUSchar* filename, GLUSshape* shape)
+{
+	GLUSboolean result;
+
+	GLUS_PROFILE_BEGIN("glusShapeLoadWavefrontIndexed");
+
+	result = _glusWavefrontParse(filename, shape, 0, 0, GLUS_TRUE);
+
+	GLUS_PROFILE_END();
+
+	return result;
 }
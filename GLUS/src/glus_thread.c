@@ -0,0 +1,622 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#include "GL/glus.h"
+
+#if defined(_MSC_VER)
+#define GLUS_THREAD_LOCAL __declspec(thread)
+#else
+#define GLUS_THREAD_LOCAL __thread
+#endif
+
+extern GLUSvoid _glusMemoryFlushThreadCache(GLUSvoid);
+
+extern GLUSvoid _glusProfileReleaseThread(GLUSvoid);
+
+extern GLUSboolean _glusJobRunTiles(const GLUSint numberTiles, const GLUSint numberThreads, GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile), GLUSvoid* data);
+
+extern GLUSint _glusJobGetNumberTileWorkers(const GLUSint numberTiles, const GLUSint numberThreads);
+
+typedef struct _GLUSthreaddata
+{
+	GLUSthreadfunc function;
+
+	GLUSvoid* argument;
+
+#ifdef _WIN32
+	HANDLE thread;
+#else
+	pthread_t thread;
+#endif
+
+} GLUSthreaddata;
+
+/**
+ * Range of tiles owned by one worker. The owner takes from the front, other workers steal from the back.
+ */
+typedef struct _GLUStilequeue
+{
+	GLUSmutex mutex;
+
+	GLUSint front;
+
+	GLUSint back;
+
+} GLUStilequeue;
+
+typedef struct _GLUStilework
+{
+	GLUStilequeue* queues;
+
+	GLUSint numberQueues;
+
+	GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile);
+
+	GLUSvoid* data;
+
+} GLUStilework;
+
+typedef struct _GLUStileworker
+{
+	GLUStilework* work;
+
+	GLUSint index;
+
+	GLUSthread thread;
+
+} GLUStileworker;
+
+// Index of the worker, which calls the tile function on this thread.
+static GLUS_THREAD_LOCAL GLUSint g_tileWorker = 0;
+
+#ifdef _WIN32
+static DWORD WINAPI glusThreadRun(LPVOID parameter)
+{
+	GLUSthreaddata* data = (GLUSthreaddata*)parameter;
+
+	data->function(data->argument);
+
+	// Give cached memory back, as the thread cache is lost after the thread ends.
+	_glusMemoryFlushThreadCache();
+
+	// Let the profile buffer of this thread be reused.
+	_glusProfileReleaseThread();
+
+	return 0;
+}
+#else
+static void* glusThreadRun(void* parameter)
+{
+	GLUSthreaddata* data = (GLUSthreaddata*)parameter;
+
+	data->function(data->argument);
+
+	// Give cached memory back, as the thread cache is lost after the thread ends.
+	_glusMemoryFlushThreadCache();
+
+	// Let the profile buffer of this thread be reused.
+	_glusProfileReleaseThread();
+
+	return 0;
+}
+#endif
+
+GLUSint GLUSAPIENTRY glusThreadGetNumberProcessors(GLUSvoid)
+{
+	GLUSint numberProcessors;
+
+#ifdef _WIN32
+	SYSTEM_INFO systemInfo;
+
+	GetSystemInfo(&systemInfo);
+
+	numberProcessors = (GLUSint)systemInfo.dwNumberOfProcessors;
+#else
+	numberProcessors = (GLUSint)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+	return numberProcessors > 0 ? numberProcessors : 1;
+}
+
+GLUSboolean GLUSAPIENTRY glusThreadCreate(GLUSthread* thread, GLUSthreadfunc function, GLUSvoid* argument)
+{
+	GLUSthreaddata* data;
+
+	if (!thread || !function)
+	{
+		return GLUS_FALSE;
+	}
+
+	thread->handle = 0;
+
+	data = (GLUSthreaddata*)glusMemoryMalloc(sizeof(GLUSthreaddata));
+
+	if (!data)
+	{
+		return GLUS_FALSE;
+	}
+
+	data->function = function;
+	data->argument = argument;
+
+#ifdef _WIN32
+	data->thread = CreateThread(0, 0, glusThreadRun, data, 0, 0);
+
+	if (!data->thread)
+	{
+		glusMemoryFree(data);
+
+		return GLUS_FALSE;
+	}
+#else
+	if (pthread_create(&data->thread, 0, glusThreadRun, data) != 0)
+	{
+		glusMemoryFree(data);
+
+		return GLUS_FALSE;
+	}
+#endif
+
+	thread->handle = data;
+
+	return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusThreadJoin(GLUSthread* thread)
+{
+	GLUSthreaddata* data;
+
+	if (!thread || !thread->handle)
+	{
+		return;
+	}
+
+	data = (GLUSthreaddata*)thread->handle;
+
+#ifdef _WIN32
+	WaitForSingleObject(data->thread, INFINITE);
+
+	CloseHandle(data->thread);
+#else
+	pthread_join(data->thread, 0);
+#endif
+
+	glusMemoryFree(data);
+
+	thread->handle = 0;
+}
+
+GLUSboolean GLUSAPIENTRY glusMutexCreate(GLUSmutex* mutex)
+{
+	if (!mutex)
+	{
+		return GLUS_FALSE;
+	}
+
+#ifdef _WIN32
+	mutex->handle = glusMemoryMalloc(sizeof(CRITICAL_SECTION));
+
+	if (!mutex->handle)
+	{
+		return GLUS_FALSE;
+	}
+
+	InitializeCriticalSection((CRITICAL_SECTION*)mutex->handle);
+#else
+	mutex->handle = glusMemoryMalloc(sizeof(pthread_mutex_t));
+
+	if (!mutex->handle)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (pthread_mutex_init((pthread_mutex_t*)mutex->handle, 0) != 0)
+	{
+		glusMemoryFree(mutex->handle);
+
+		mutex->handle = 0;
+
+		return GLUS_FALSE;
+	}
+#endif
+
+	return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusMutexDestroy(GLUSmutex* mutex)
+{
+	if (!mutex || !mutex->handle)
+	{
+		return;
+	}
+
+#ifdef _WIN32
+	DeleteCriticalSection((CRITICAL_SECTION*)mutex->handle);
+#else
+	pthread_mutex_destroy((pthread_mutex_t*)mutex->handle);
+#endif
+
+	glusMemoryFree(mutex->handle);
+
+	mutex->handle = 0;
+}
+
+GLUSvoid GLUSAPIENTRY glusMutexLock(GLUSmutex* mutex)
+{
+#ifdef _WIN32
+	EnterCriticalSection((CRITICAL_SECTION*)mutex->handle);
+#else
+	pthread_mutex_lock((pthread_mutex_t*)mutex->handle);
+#endif
+}
+
+GLUSvoid GLUSAPIENTRY glusMutexUnlock(GLUSmutex* mutex)
+{
+#ifdef _WIN32
+	LeaveCriticalSection((CRITICAL_SECTION*)mutex->handle);
+#else
+	pthread_mutex_unlock((pthread_mutex_t*)mutex->handle);
+#endif
+}
+
+GLUSboolean GLUSAPIENTRY glusConditionCreate(GLUScondition* condition)
+{
+	if (!condition)
+	{
+		return GLUS_FALSE;
+	}
+
+#ifdef _WIN32
+	condition->handle = glusMemoryMalloc(sizeof(CONDITION_VARIABLE));
+
+	if (!condition->handle)
+	{
+		return GLUS_FALSE;
+	}
+
+	InitializeConditionVariable((CONDITION_VARIABLE*)condition->handle);
+#else
+	condition->handle = glusMemoryMalloc(sizeof(pthread_cond_t));
+
+	if (!condition->handle)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (pthread_cond_init((pthread_cond_t*)condition->handle, 0) != 0)
+	{
+		glusMemoryFree(condition->handle);
+
+		condition->handle = 0;
+
+		return GLUS_FALSE;
+	}
+#endif
+
+	return GLUS_TRUE;
+}
+
+GLUSvoid GLUSAPIENTRY glusConditionDestroy(GLUScondition* condition)
+{
+	if (!condition || !condition->handle)
+	{
+		return;
+	}
+
+#ifndef _WIN32
+	pthread_cond_destroy((pthread_cond_t*)condition->handle);
+#endif
+
+	glusMemoryFree(condition->handle);
+
+	condition->handle = 0;
+}
+
+GLUSvoid GLUSAPIENTRY glusConditionWait(GLUScondition* condition, GLUSmutex* mutex)
+{
+#ifdef _WIN32
+	SleepConditionVariableCS((CONDITION_VARIABLE*)condition->handle, (CRITICAL_SECTION*)mutex->handle, INFINITE);
+#else
+	pthread_cond_wait((pthread_cond_t*)condition->handle, (pthread_mutex_t*)mutex->handle);
+#endif
+}
+
+GLUSvoid GLUSAPIENTRY glusConditionSignal(GLUScondition* condition)
+{
+#ifdef _WIN32
+	WakeConditionVariable((CONDITION_VARIABLE*)condition->handle);
+#else
+	pthread_cond_signal((pthread_cond_t*)condition->handle);
+#endif
+}
+
+GLUSvoid GLUSAPIENTRY glusConditionBroadcast(GLUScondition* condition)
+{
+#ifdef _WIN32
+	WakeAllConditionVariable((CONDITION_VARIABLE*)condition->handle);
+#else
+	pthread_cond_broadcast((pthread_cond_t*)condition->handle);
+#endif
+}
+
+static GLUSint glusThreadNextTile(GLUStilework* work, const GLUSint index)
+{
+	GLUSint i, tile;
+
+	GLUStilequeue* queue = &work->queues[index];
+
+	// Take from the front of the own queue first ...
+
+	glusMutexLock(&queue->mutex);
+
+	tile = -1;
+
+	if (queue->front < queue->back)
+	{
+		tile = queue->front;
+
+		queue->front++;
+	}
+
+	glusMutexUnlock(&queue->mutex);
+
+	// ... otherwise steal from the back of another queue. As no tiles are added, all queues are finished, if nothing can be stolen.
+
+	for (i = 1; i < work->numberQueues && tile < 0; i++)
+	{
+		queue = &work->queues[(index + i) % work->numberQueues];
+
+		glusMutexLock(&queue->mutex);
+
+		if (queue->front < queue->back)
+		{
+			queue->back--;
+
+			tile = queue->back;
+		}
+
+		glusMutexUnlock(&queue->mutex);
+	}
+
+	return tile;
+}
+
+/**
+ * Sets the index of the worker, which calls the tile function on this thread.
+ *
+ * @param index The index of the worker.
+ *
+ * @return The previous index, which has to be restored after the tiles, as tile functions can run tiles again.
+ */
+GLUSint _glusThreadSetTileWorker(const GLUSint index)
+{
+	GLUSint previousWorker = g_tileWorker;
+
+	g_tileWorker = index;
+
+	return previousWorker;
+}
+
+/**
+ * Gets the index of the worker, which calls the tile function.
+ * It is smaller than the number of workers, so tile functions can use buffers allocated once per worker.
+ *
+ * @return The index of the worker.
+ */
+GLUSint _glusThreadGetTileWorker(GLUSvoid)
+{
+	return g_tileWorker;
+}
+
+static GLUSvoid glusThreadTileWorker(GLUSvoid* argument)
+{
+	GLUStileworker* worker = (GLUStileworker*)argument;
+
+	GLUSint tile, previousWorker;
+
+	previousWorker = _glusThreadSetTileWorker(worker->index);
+
+	while ((tile = glusThreadNextTile(worker->work, worker->index)) >= 0)
+	{
+		worker->work->function(worker->work->data, tile);
+	}
+
+	_glusThreadSetTileWorker(previousWorker);
+}
+
+static GLUSint glusThreadGetNumberWorkers(const GLUSint numberTiles, const GLUSint numberThreads)
+{
+	GLUSint numberWorkers = numberThreads > 0 ? numberThreads : glusThreadGetNumberProcessors();
+
+	return numberWorkers > numberTiles ? numberTiles : numberWorkers;
+}
+
+/**
+ * Gets the number of workers, which _glusThreadRunTiles uses at most for the same parameters.
+ *
+ * @param numberTiles	The number of tiles.
+ * @param numberThreads	The number of threads. If zero or less, the number of processors is used.
+ *
+ * @return The number of workers.
+ */
+GLUSint _glusThreadGetNumberTileWorkers(const GLUSint numberTiles, const GLUSint numberThreads)
+{
+	GLUSint numberWorkers;
+
+	if (numberTiles <= 0)
+	{
+		return 0;
+	}
+
+	numberWorkers = _glusJobGetNumberTileWorkers(numberTiles, numberThreads);
+
+	if (numberWorkers > 0)
+	{
+		return numberWorkers;
+	}
+
+	return glusThreadGetNumberWorkers(numberTiles, numberThreads);
+}
+
+/**
+ * Calls the function for all tiles using several threads. Each thread owns a contiguous range of tiles, so neighboring tiles share the cache.
+ * If a range is finished, tiles are stolen from the other ranges. The calling thread is the first worker.
+ * If the job system is running, its workers are used instead.
+ */
+GLUSboolean _glusThreadRunTiles(const GLUSint numberTiles, const GLUSint numberThreads, GLUSvoid (*function)(GLUSvoid* data, const GLUSint tile), GLUSvoid* data)
+{
+	GLUStilework work;
+
+	GLUStileworker* workers;
+
+	GLUSint i, numberWorkers;
+
+	if (numberTiles <= 0 || !function)
+	{
+		return numberTiles == 0;
+	}
+
+	// A running job system already has threads, so no own ones are started.
+	if (_glusJobRunTiles(numberTiles, numberThreads, function, data))
+	{
+		return GLUS_TRUE;
+	}
+
+	numberWorkers = glusThreadGetNumberWorkers(numberTiles, numberThreads);
+
+	work.queues = (GLUStilequeue*)glusMemoryMalloc(numberWorkers * sizeof(GLUStilequeue));
+	workers = (GLUStileworker*)glusMemoryMalloc(numberWorkers * sizeof(GLUStileworker));
+
+	if (!work.queues || !workers)
+	{
+		glusMemoryFree(work.queues);
+		glusMemoryFree(workers);
+
+		return GLUS_FALSE;
+	}
+
+	work.numberQueues = 0;
+	work.function = function;
+	work.data = data;
+
+	for (i = 0; i < numberWorkers; i++)
+	{
+		if (!glusMutexCreate(&work.queues[i].mutex))
+		{
+			break;
+		}
+
+		work.numberQueues++;
+	}
+
+	if (work.numberQueues == 0)
+	{
+		glusMemoryFree(work.queues);
+		glusMemoryFree(workers);
+
+		return GLUS_FALSE;
+	}
+
+	numberWorkers = work.numberQueues;
+
+	for (i = 0; i < numberWorkers; i++)
+	{
+		work.queues[i].front = numberTiles * i / numberWorkers;
+		work.queues[i].back = numberTiles * (i + 1) / numberWorkers;
+
+		workers[i].work = &work;
+		workers[i].index = i;
+		workers[i].thread.handle = 0;
+	}
+
+	// If a thread can not be started, its tiles are stolen by the others.
+
+	for (i = 1; i < numberWorkers; i++)
+	{
+		glusThreadCreate(&workers[i].thread, glusThreadTileWorker, &workers[i]);
+	}
+
+	glusThreadTileWorker(&workers[0]);
+
+	for (i = 1; i < numberWorkers; i++)
+	{
+		glusThreadJoin(&workers[i].thread);
+	}
+
+	for (i = 0; i < numberWorkers; i++)
+	{
+		glusMutexDestroy(&work.queues[i].mutex);
+	}
+
+	glusMemoryFree(work.queues);
+	glusMemoryFree(workers);
+
+	return GLUS_TRUE;
+}
+
+/**
+ * Monotonic time in seconds, which does not need an initialized window.
+ */
+GLUSdouble _glusThreadGetRawTime(GLUSvoid)
+{
+#ifdef _WIN32
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+
+	return (GLUSdouble)counter.QuadPart / (GLUSdouble)frequency.QuadPart;
+#else
+	struct timespec currentTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+	return (GLUSdouble)currentTime.tv_sec + (GLUSdouble)currentTime.tv_nsec / 1000000000.0;
+#endif
+}
+
+/**
+ * Monotonic time in nanoseconds, which does not need an initialized window.
+ */
+GLUSuint64 _glusThreadGetRawTimeNanoseconds(GLUSvoid)
+{
+#ifdef _WIN32
+	LARGE_INTEGER frequency;
+	LARGE_INTEGER counter;
+
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&counter);
+
+	// Split, so the multiplication does not overflow.
+	return (GLUSuint64)(counter.QuadPart / frequency.QuadPart) * 1000000000 + (GLUSuint64)(counter.QuadPart % frequency.QuadPart) * 1000000000 / (GLUSuint64)frequency.QuadPart;
+#else
+	struct timespec currentTime;
+
+	clock_gettime(CLOCK_MONOTONIC, &currentTime);
+
+	return (GLUSuint64)currentTime.tv_sec * 1000000000 + (GLUSuint64)currentTime.tv_nsec;
+#endif
+}
@@ -17,8 +17,14 @@
 
 #include "GL/glus.h"
 
+extern GLUSuint64 _glusThreadGetRawTimeNanoseconds(GLUSvoid);
+
 GLUSfloat GLUSAPIENTRY glusTimeGetTimestampf()
 {
 	return (GLUSfloat)glfwGetTime();
 }
 
+GLUSuint64 GLUSAPIENTRY glusTimeGetTimestampNanoseconds(GLUSvoid)
+{
+	return _glusThreadGetRawTimeNanoseconds();
+}
@@ -19,8 +19,14 @@
 
 extern double _glusOsGetRawTime(GLUSvoid);
 
+extern GLUSuint64 _glusThreadGetRawTimeNanoseconds(GLUSvoid);
+
 GLUSfloat GLUSAPIENTRY glusTimeGetTimestampf()
 {
 	return (GLUSfloat)_glusOsGetRawTime();
 }
 
+GLUSuint64 GLUSAPIENTRY glusTimeGetTimestampNanoseconds(GLUSvoid)
+{
+	return _glusThreadGetRawTimeNanoseconds();
+}
@@ -18,10 +18,55 @@
 #include "GL/glus.h"
 
 #define GLUS_MAX_OBJECTS 1
-#define GLUS_MAX_ATTRIBUTES (GLUS_MAX_VERTICES/GLUS_VERTICES_DIVISOR)
-#define GLUS_MAX_TRIANGLE_ATTRIBUTES GLUS_MAX_VERTICES
-#define GLUS_MAX_LINE_ATTRIBUTES GLUS_MAX_VERTICES
-#define GLUS_BUFFERSIZE 1024
+#define GLUS_INITIAL_ATTRIBUTES 4096
+
+extern GLUSboolean _glusFileMap(const GLUSchar* filename, GLUSubyte** data, size_t* length);
+extern GLUSvoid _glusFileUnmap(GLUSubyte* data, size_t length);
+
+static GLUSboolean glusWavefrontGrowTempMemory(GLUSvoid** memory, GLUSuint* capacity, GLUSuint required, size_t elementSize)
+{
+	GLUSvoid* newMemory;
+
+	GLUSuint newCapacity;
+
+	if (!memory || !*memory || !capacity)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (required <= *capacity)
+	{
+		return GLUS_TRUE;
+	}
+
+	newCapacity = *capacity;
+
+	// Grow geometrically, so the number of copies stays low.
+	while (newCapacity < required)
+	{
+		if (newCapacity > 0x7FFFFFFF || (size_t)newCapacity * 2 > ((size_t)-1) / elementSize)
+		{
+			return GLUS_FALSE;
+		}
+
+		newCapacity *= 2;
+	}
+
+	newMemory = glusMemoryMalloc((size_t)newCapacity * elementSize);
+	if (!newMemory)
+	{
+		return GLUS_FALSE;
+	}
+
+	memcpy(newMemory, *memory, (size_t)*capacity * elementSize);
+
+	glusMemoryFree(*memory);
+
+	*memory = newMemory;
+	*capacity = newCapacity;
+
+	return GLUS_TRUE;
+}
 
 static GLUSboolean glusWavefrontMallocTempMemoryLine(GLUSfloat** vertices, GLUSindex** indices)
 {
@@ -30,13 +75,13 @@ static GLUSboolean glusWavefrontMallocTempMemoryLine(GLUSfloat** vertices, GLUSi
 		return GLUS_FALSE;
 	}
 
-	*vertices = (GLUSfloat*)glusMemoryMalloc(4 * GLUS_MAX_ATTRIBUTES * sizeof(GLUSfloat));
+	*vertices = (GLUSfloat*)glusMemoryMalloc(4 * GLUS_INITIAL_ATTRIBUTES * sizeof(GLUSfloat));
 	if (!*vertices)
 	{
 		return GLUS_FALSE;
 	}
 
-	*indices = (GLUSindex*)glusMemoryMalloc(GLUS_MAX_LINE_ATTRIBUTES * sizeof(GLUSindex));
+	*indices = (GLUSindex*)glusMemoryMalloc(GLUS_INITIAL_ATTRIBUTES * sizeof(GLUSindex));
 	if (!*indices)
 	{
 		return GLUS_FALSE;
@@ -69,37 +114,37 @@ static GLUSboolean glusWavefrontMallocTempMemory(GLUSfloat** vertices, GLUSfloat
 		return GLUS_FALSE;
 	}
 
-	*vertices = (GLUSfloat*)glusMemoryMalloc(4 * GLUS_MAX_ATTRIBUTES * sizeof(GLUSfloat));
+	*vertices = (GLUSfloat*)glusMemoryMalloc(4 * GLUS_INITIAL_ATTRIBUTES * sizeof(GLUSfloat));
 	if (!*vertices)
 	{
 		return GLUS_FALSE;
 	}
 
-	*normals = (GLUSfloat*)glusMemoryMalloc(3 * GLUS_MAX_ATTRIBUTES * sizeof(GLUSfloat));
+	*normals = (GLUSfloat*)glusMemoryMalloc(3 * GLUS_INITIAL_ATTRIBUTES * sizeof(GLUSfloat));
 	if (!*normals)
 	{
 		return GLUS_FALSE;
 	}
 
-	*texCoords = (GLUSfloat*)glusMemoryMalloc(2 * GLUS_MAX_ATTRIBUTES * sizeof(GLUSfloat));
+	*texCoords = (GLUSfloat*)glusMemoryMalloc(2 * GLUS_INITIAL_ATTRIBUTES * sizeof(GLUSfloat));
 	if (!*texCoords)
 	{
 		return GLUS_FALSE;
 	}
 
-	*triangleVertices = (GLUSfloat*)glusMemoryMalloc(4 * GLUS_MAX_TRIANGLE_ATTRIBUTES * sizeof(GLUSfloat));
+	*triangleVertices = (GLUSfloat*)glusMemoryMalloc(4 * GLUS_INITIAL_ATTRIBUTES * sizeof(GLUSfloat));
 	if (!*triangleVertices)
 	{
 		return GLUS_FALSE;
 	}
 
-	*triangleNormals = (GLUSfloat*)glusMemoryMalloc(3 * GLUS_MAX_TRIANGLE_ATTRIBUTES * sizeof(GLUSfloat));
+	*triangleNormals = (GLUSfloat*)glusMemoryMalloc(3 * GLUS_INITIAL_ATTRIBUTES * sizeof(GLUSfloat));
 	if (!*triangleNormals)
 	{
 		return GLUS_FALSE;
 	}
 
-	*triangleTexCoords = (GLUSfloat*)glusMemoryMalloc(2 * GLUS_MAX_TRIANGLE_ATTRIBUTES * sizeof(GLUSfloat));
+	*triangleTexCoords = (GLUSfloat*)glusMemoryMalloc(2 * GLUS_INITIAL_ATTRIBUTES * sizeof(GLUSfloat));
 	if (!*triangleTexCoords)
 	{
 		return GLUS_FALSE;
@@ -153,6 +198,277 @@ static GLUSvoid glusWavefrontFreeTempMemory(GLUSfloat** vertices, GLUSfloat** no
 	}
 }
 
+/**
+ * Scanner over the mapped file content. The content is not null terminated.
+ */
+typedef struct _GLUSwavefrontscanner
+{
+	const GLUSchar* current;
+
+	const GLUSchar* end;
+
+} GLUSwavefrontscanner;
+
+static const GLUSdouble g_powersOfTen[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+static GLUSvoid glusWavefrontScannerInit(GLUSwavefrontscanner* scanner, const GLUSubyte* data, size_t length)
+{
+	scanner->current = (const GLUSchar*)data;
+	scanner->end = (const GLUSchar*)data + length;
+}
+
+static GLUSboolean glusWavefrontScannerIsBlank(GLUSchar c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+static GLUSboolean glusWavefrontScannerIsDigit(GLUSchar c)
+{
+	return c >= '0' && c <= '9';
+}
+
+static GLUSvoid glusWavefrontScannerSkipBlanks(GLUSwavefrontscanner* scanner)
+{
+	while (scanner->current < scanner->end && glusWavefrontScannerIsBlank(*scanner->current))
+	{
+		scanner->current++;
+	}
+}
+
+static GLUSvoid glusWavefrontScannerSkipLine(GLUSwavefrontscanner* scanner)
+{
+	while (scanner->current < scanner->end && *scanner->current != '\n')
+	{
+		scanner->current++;
+	}
+
+	if (scanner->current < scanner->end)
+	{
+		scanner->current++;
+	}
+}
+
+/**
+ * Scans the next word of the current line. Too long words are truncated.
+ *
+ * @return The length of the word. Zero, if the end of the line has been reached.
+ */
+static GLUSuint glusWavefrontScannerWord(GLUSwavefrontscanner* scanner, GLUSchar* word, GLUSuint maxLength)
+{
+	GLUSuint length = 0;
+
+	glusWavefrontScannerSkipBlanks(scanner);
+
+	while (scanner->current < scanner->end && *scanner->current != '\n' && !glusWavefrontScannerIsBlank(*scanner->current))
+	{
+		if (length < maxLength - 1)
+		{
+			word[length++] = *scanner->current;
+		}
+
+		scanner->current++;
+	}
+
+	word[length] = 0;
+
+	return length;
+}
+
+/**
+ * Scans a decimal floating point number. The value is not changed, if no number is found.
+ */
+static GLUSboolean glusWavefrontScannerFloat(GLUSwavefrontscanner* scanner, GLUSfloat* value)
+{
+	const GLUSchar* c;
+
+	GLUSboolean negative = GLUS_FALSE;
+	GLUSboolean negativeExponent = GLUS_FALSE;
+
+	GLUSuint64 mantissa = 0;
+
+	GLUSint digits = 0;
+	GLUSint exponent = 0;
+	GLUSint explicitExponent = 0;
+
+	GLUSdouble result;
+
+	glusWavefrontScannerSkipBlanks(scanner);
+
+	c = scanner->current;
+
+	if (c < scanner->end && (*c == '+' || *c == '-'))
+	{
+		negative = (*c == '-');
+
+		c++;
+	}
+
+	// Only the first 18 significant digits are gathered, which are exactly stored in the mantissa.
+	while (c < scanner->end && glusWavefrontScannerIsDigit(*c))
+	{
+		if (mantissa < 100000000000000000ull)
+		{
+			mantissa = mantissa * 10 + (GLUSuint64)(*c - '0');
+		}
+		else
+		{
+			exponent++;
+		}
+
+		digits++;
+		c++;
+	}
+
+	if (c < scanner->end && *c == '.')
+	{
+		c++;
+
+		while (c < scanner->end && glusWavefrontScannerIsDigit(*c))
+		{
+			if (mantissa < 100000000000000000ull)
+			{
+				mantissa = mantissa * 10 + (GLUSuint64)(*c - '0');
+
+				exponent--;
+			}
+
+			digits++;
+			c++;
+		}
+	}
+
+	if (digits == 0)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (c < scanner->end && (*c == 'e' || *c == 'E'))
+	{
+		const GLUSchar* e = c + 1;
+
+		if (e < scanner->end && (*e == '+' || *e == '-'))
+		{
+			negativeExponent = (*e == '-');
+
+			e++;
+		}
+
+		if (e < scanner->end && glusWavefrontScannerIsDigit(*e))
+		{
+			while (e < scanner->end && glusWavefrontScannerIsDigit(*e))
+			{
+				if (explicitExponent < 10000)
+				{
+					explicitExponent = explicitExponent * 10 + (*e - '0');
+				}
+
+				e++;
+			}
+
+			exponent += negativeExponent ? -explicitExponent : explicitExponent;
+
+			c = e;
+		}
+	}
+
+	result = (GLUSdouble)mantissa;
+
+	if (exponent < 0)
+	{
+		result /= (-exponent <= 22) ? g_powersOfTen[-exponent] : pow(10.0, (GLUSdouble)-exponent);
+	}
+	else if (exponent > 0)
+	{
+		result *= (exponent <= 22) ? g_powersOfTen[exponent] : pow(10.0, (GLUSdouble)exponent);
+	}
+
+	*value = (GLUSfloat)(negative ? -result : result);
+
+	scanner->current = c;
+
+	return GLUS_TRUE;
+}
+
+/**
+ * Scans a decimal integer number without skipping blanks. The value is not changed, if no number is found.
+ */
+static GLUSboolean glusWavefrontScannerInt(GLUSwavefrontscanner* scanner, GLUSint* value)
+{
+	const GLUSchar* c = scanner->current;
+
+	GLUSboolean negative = GLUS_FALSE;
+
+	GLUSint result = 0;
+
+	if (c < scanner->end && (*c == '+' || *c == '-'))
+	{
+		negative = (*c == '-');
+
+		c++;
+	}
+
+	if (c >= scanner->end || !glusWavefrontScannerIsDigit(*c))
+	{
+		return GLUS_FALSE;
+	}
+
+	while (c < scanner->end && glusWavefrontScannerIsDigit(*c))
+	{
+		result = result * 10 + (*c - '0');
+
+		c++;
+	}
+
+	*value = negative ? -result : result;
+
+	scanner->current = c;
+
+	return GLUS_TRUE;
+}
+
+/**
+ * Scans a face element in the format v, v/vt, v//vn or v/vt/vn.
+ *
+ * @return GLUS_FALSE, if the end of the line has been reached.
+ */
+static GLUSboolean glusWavefrontScannerFaceElement(GLUSwavefrontscanner* scanner, GLUSint* vIndex, GLUSint* vtIndex, GLUSint* vnIndex)
+{
+	*vIndex = 0;
+	*vtIndex = 0;
+	*vnIndex = 0;
+
+	glusWavefrontScannerSkipBlanks(scanner);
+
+	if (scanner->current >= scanner->end || *scanner->current == '\n')
+	{
+		return GLUS_FALSE;
+	}
+
+	glusWavefrontScannerInt(scanner, vIndex);
+
+	if (scanner->current < scanner->end && *scanner->current == '/')
+	{
+		scanner->current++;
+
+		glusWavefrontScannerInt(scanner, vtIndex);
+
+		if (scanner->current < scanner->end && *scanner->current == '/')
+		{
+			scanner->current++;
+
+			glusWavefrontScannerInt(scanner, vnIndex);
+		}
+	}
+
+	// Skip any remaining, malformed characters of this element.
+	while (scanner->current < scanner->end && *scanner->current != '\n' && !glusWavefrontScannerIsBlank(*scanner->current))
+	{
+		scanner->current++;
+	}
+
+	return GLUS_TRUE;
+}
+
 static GLUSvoid glusWavefrontInitMaterial(GLUSmaterial* material)
 {
 	if (!material)
@@ -244,14 +560,15 @@ static GLUSvoid glusWavefrontDestroyMaterial(GLUSmaterialList** materialList)
 
 static GLUSboolean glusWavefrontLoadMaterial(const GLUSchar* filename, GLUSmaterialList** materialList)
 {
-	FILE* f;
+	GLUSubyte* data;
+	size_t length;
 
-	GLUSint i, k;
+	GLUSwavefrontscanner scanner;
 
-	GLUSchar buffer[GLUS_BUFFERSIZE];
-	GLUSchar* checkBuffer;
+	GLUSint i;
+
+	GLUSchar identifier[GLUS_MAX_STRING];
 	GLUSchar name[GLUS_MAX_STRING];
-	GLUSchar identifier[7];
 
 	GLUSmaterialList* currentMaterialList = 0;
 
@@ -260,76 +577,30 @@ static GLUSboolean glusWavefrontLoadMaterial(const GLUSchar* filename, GLUSmater
 		return GLUS_FALSE;
 	}
 
-	f = glusFileOpen(filename, "r");
-
-	if (!f)
+	if (!_glusFileMap(filename, &data, &length))
 	{
 		return GLUS_FALSE;
 	}
 
-	while (!feof(f))
-	{
-		buffer[0] = 0;
-
-		if (fgets(buffer, GLUS_BUFFERSIZE, f) == 0)
-		{
-			if (ferror(f))
-			{
-				glusFileClose(f);
-
-				return GLUS_FALSE;
-			}
-		}
-
-		checkBuffer = buffer;
+	glusWavefrontScannerInit(&scanner, data, length);
 
-		k = 0;
-
-		// Skip first spaces etc.
-		while (*checkBuffer)
+	for (; scanner.current < scanner.end; glusWavefrontScannerSkipLine(&scanner))
+	{
+		if (!glusWavefrontScannerWord(&scanner, identifier, GLUS_MAX_STRING))
 		{
-			if (*checkBuffer != ' ' && *checkBuffer != '\t')
-			{
-				break;
-			}
-
-			checkBuffer++;
-			k++;
-
-			if (k >= GLUS_BUFFERSIZE)
-			{
-				glusFileClose(f);
-
-				return GLUS_FALSE;
-			}
+			continue;
 		}
 
-		i = 0;
-
-		while (checkBuffer[i])
+		for (i = 0; identifier[i]; i++)
 		{
-			if (checkBuffer[i] == ' ' || checkBuffer[i] == '\t')
-			{
-				break;
-			}
-
-			checkBuffer[i] = tolower(checkBuffer[i]);
-
-			i++;
-
-			if (i >= GLUS_BUFFERSIZE - k)
-			{
-				glusFileClose(f);
-
-				return GLUS_FALSE;
-			}
+			identifier[i] = (GLUSchar)tolower(identifier[i]);
 		}
 
-		if (strncmp(checkBuffer, "newmtl", 6) == 0)
+		if (strcmp(identifier, "newmtl") == 0)
 		{
 			GLUSmaterialList* newMaterialList = 0;
 
-			sscanf(checkBuffer, "%s %s", identifier, name);
+			glusWavefrontScannerWord(&scanner, name, GLUS_MAX_STRING);
 
 			newMaterialList = (GLUSmaterialList*)glusMemoryMalloc(sizeof(GLUSmaterialList));
 
@@ -337,7 +608,7 @@ static GLUSboolean glusWavefrontLoadMaterial(const GLUSchar* filename, GLUSmater
 			{
 				glusWavefrontDestroyMaterial(materialList);
 
-				glusFileClose(f);
+				_glusFileUnmap(data, length);
 
 				return GLUS_FALSE;
 			}
@@ -359,83 +630,86 @@ static GLUSboolean glusWavefrontLoadMaterial(const GLUSchar* filename, GLUSmater
 
 			currentMaterialList = newMaterialList;
 		}
-		else if (strncmp(checkBuffer, "ke", 2) == 0)
+		else if (!currentMaterialList)
 		{
-			sscanf(checkBuffer, "%s %f %f %f", identifier, &currentMaterialList->material.emissive[0], &currentMaterialList->material.emissive[1], &currentMaterialList->material.emissive[2]);
+			// Any other statement needs a material.
+			continue;
+		}
+		else if (strcmp(identifier, "ke") == 0)
+		{
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.emissive[0]);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.emissive[1]);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.emissive[2]);
 
 			currentMaterialList->material.emissive[3] = 1.0f;
 		}
-		else if (strncmp(checkBuffer, "ka", 2) == 0)
+		else if (strcmp(identifier, "ka") == 0)
 		{
-			sscanf(checkBuffer, "%s %f %f %f", identifier, &currentMaterialList->material.ambient[0], &currentMaterialList->material.ambient[1], &currentMaterialList->material.ambient[2]);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.ambient[0]);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.ambient[1]);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.ambient[2]);
 
 			currentMaterialList->material.ambient[3] = 1.0f;
 		}
-		else if (strncmp(checkBuffer, "kd", 2) == 0)
+		else if (strcmp(identifier, "kd") == 0)
 		{
-			sscanf(checkBuffer, "%s %f %f %f", identifier, &currentMaterialList->material.diffuse[0], &currentMaterialList->material.diffuse[1], &currentMaterialList->material.diffuse[2]);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.diffuse[0]);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.diffuse[1]);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.diffuse[2]);
 
 			currentMaterialList->material.diffuse[3] = 1.0f;
 		}
-		else if (strncmp(checkBuffer, "ks", 2) == 0)
+		else if (strcmp(identifier, "ks") == 0)
 		{
-			sscanf(checkBuffer, "%s %f %f %f", identifier, &currentMaterialList->material.specular[0], &currentMaterialList->material.specular[1], &currentMaterialList->material.specular[2]);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.specular[0]);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.specular[1]);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.specular[2]);
 
 			currentMaterialList->material.specular[3] = 1.0f;
 		}
-		else if (strncmp(checkBuffer, "ns", 2) == 0)
+		else if (strcmp(identifier, "ns") == 0)
 		{
-			sscanf(checkBuffer, "%s %f", identifier, &currentMaterialList->material.shininess);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.shininess);
 		}
-		else if (strncmp(checkBuffer, "d", 1) == 0 || strncmp(checkBuffer, "Tr", 2) == 0)
+		else if (strcmp(identifier, "d") == 0)
 		{
-			sscanf(checkBuffer, "%s %f", identifier, &currentMaterialList->material.transparency);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.transparency);
 		}
-		else if (strncmp(checkBuffer, "ni", 2) == 0)
+		else if (strcmp(identifier, "ni") == 0)
 		{
-			sscanf(checkBuffer, "%s %f", identifier, &currentMaterialList->material.indexOfRefraction);
+			glusWavefrontScannerFloat(&scanner, &currentMaterialList->material.indexOfRefraction);
 		}
-		else if (strncmp(checkBuffer, "map_ke", 6) == 0)
+		else if (strcmp(identifier, "map_ke") == 0)
 		{
-			sscanf(checkBuffer, "%s %s", identifier, name);
-
-			strcpy(currentMaterialList->material.emissiveTextureFilename, name);
+			glusWavefrontScannerWord(&scanner, currentMaterialList->material.emissiveTextureFilename, GLUS_MAX_STRING);
 		}
-		else if (strncmp(checkBuffer, "map_ka", 6) == 0)
+		else if (strcmp(identifier, "map_ka") == 0)
 		{
-			sscanf(checkBuffer, "%s %s", identifier, name);
-
-			strcpy(currentMaterialList->material.ambientTextureFilename, name);
+			glusWavefrontScannerWord(&scanner, currentMaterialList->material.ambientTextureFilename, GLUS_MAX_STRING);
 		}
-		else if (strncmp(checkBuffer, "map_kd", 6) == 0)
+		else if (strcmp(identifier, "map_kd") == 0)
 		{
-			sscanf(checkBuffer, "%s %s", identifier, name);
-
-			strcpy(currentMaterialList->material.diffuseTextureFilename, name);
+			glusWavefrontScannerWord(&scanner, currentMaterialList->material.diffuseTextureFilename, GLUS_MAX_STRING);
 		}
-		else if (strncmp(checkBuffer, "map_ks", 6) == 0)
+		else if (strcmp(identifier, "map_ks") == 0)
 		{
-			sscanf(checkBuffer, "%s %s", identifier, name);
-
-			strcpy(currentMaterialList->material.specularTextureFilename, name);
+			glusWavefrontScannerWord(&scanner, currentMaterialList->material.specularTextureFilename, GLUS_MAX_STRING);
 		}
-		else if (strncmp(checkBuffer, "map_d", 5) == 0 || strncmp(checkBuffer, "map_Tr", 6) == 0)
+		else if (strcmp(identifier, "map_d") == 0)
 		{
-			sscanf(checkBuffer, "%s %s", identifier, name);
-
-			strcpy(currentMaterialList->material.transparencyTextureFilename, name);
+			glusWavefrontScannerWord(&scanner, currentMaterialList->material.transparencyTextureFilename, GLUS_MAX_STRING);
 		}
-		else if (strncmp(checkBuffer, "map_bump", 8) == 0 || strncmp(checkBuffer, "bump", 4) == 0)
+		else if (strcmp(identifier, "map_bump") == 0 || strcmp(identifier, "bump") == 0)
 		{
-			sscanf(checkBuffer, "%s %s", identifier, name);
-
-			strcpy(currentMaterialList->material.bumpTextureFilename, name);
+			glusWavefrontScannerWord(&scanner, currentMaterialList->material.bumpTextureFilename, GLUS_MAX_STRING);
 		}
-		else if (strncmp(checkBuffer, "illum", 5) == 0)
+		else if (strcmp(identifier, "illum") == 0)
 		{
-			GLUSint illum;
+			GLUSint illum = 0;
+
+			glusWavefrontScannerSkipBlanks(&scanner);
 
-			sscanf(checkBuffer, "%s %d", identifier, &illum);
+			glusWavefrontScannerInt(&scanner, &illum);
 
 			// Only setting reflection and refraction depending on illumination model.
 			switch (illum)
@@ -456,7 +730,7 @@ static GLUSboolean glusWavefrontLoadMaterial(const GLUSchar* filename, GLUSmater
 		}
 	}
 
-	glusFileClose(f);
+	_glusFileUnmap(data, length);
 
 	return GLUS_TRUE;
 }
@@ -534,10 +808,129 @@ static GLUSboolean glusWavefrontCopyDataLine(GLUSline* line, GLUSuint totalNumbe
 	return GLUS_TRUE;
 }
 
-static GLUSboolean glusWavefrontCopyData(GLUSshape* shape, GLUSuint totalNumberVertices, GLUSfloat* triangleVertices, GLUSuint totalNumberNormals, GLUSfloat* triangleNormals, GLUSuint totalNumberTexCoords, GLUSfloat* triangleTexCoords)
+static GLUSuint glusWavefrontHashAttributes(const GLUSfloat* values, GLUSuint count, GLUSuint hash)
+{
+	GLUSuint i;
+
+	GLUSuint bits;
+
+	for (i = 0; i < count; i++)
+	{
+		memcpy(&bits, &values[i], sizeof(GLUSuint));
+
+		// FNV-1a like mixing of the 32 bit words.
+		hash = (hash ^ bits) * 16777619u;
+	}
+
+	return hash;
+}
+
+/**
+ * Removes all duplicated vertex, normal and texture coordinate tuples in place and creates the indices.
+ *
+ * @return The number of unique vertices. Zero, if the memory could not be allocated.
+ */
+static GLUSuint glusWavefrontIndexData(GLUSindex* indices, GLUSuint totalNumberVertices, GLUSfloat* triangleVertices, GLUSfloat* triangleNormals, GLUSfloat* triangleTexCoords)
+{
+	GLUSuint i, walker, hash;
+
+	GLUSuint bucketCount = 1;
+
+	GLUSuint numberUniqueVertices = 0;
+
+	GLUSuint* buckets;
+	GLUSuint* next;
+
+	while (bucketCount < totalNumberVertices * 2 && bucketCount < 0x80000000)
+	{
+		bucketCount <<= 1;
+	}
+
+	buckets = (GLUSuint*)glusMemoryMalloc(bucketCount * sizeof(GLUSuint));
+	next = (GLUSuint*)glusMemoryMalloc(totalNumberVertices * sizeof(GLUSuint));
+
+	if (!buckets || !next)
+	{
+		glusMemoryFree(buckets);
+		glusMemoryFree(next);
+
+		return 0;
+	}
+
+	memset(buckets, 0xFF, bucketCount * sizeof(GLUSuint));
+
+	for (i = 0; i < totalNumberVertices; i++)
+	{
+		hash = glusWavefrontHashAttributes(&triangleVertices[4 * i], 4, 2166136261u);
+
+		if (triangleNormals)
+		{
+			hash = glusWavefrontHashAttributes(&triangleNormals[3 * i], 3, hash);
+		}
+
+		if (triangleTexCoords)
+		{
+			hash = glusWavefrontHashAttributes(&triangleTexCoords[2 * i], 2, hash);
+		}
+
+		hash &= bucketCount - 1;
+
+		// Unique vertices are already compacted, so the walker is always smaller than the current vertex.
+		walker = buckets[hash];
+
+		while (walker != 0xFFFFFFFF)
+		{
+			if (memcmp(&triangleVertices[4 * walker], &triangleVertices[4 * i], 4 * sizeof(GLUSfloat)) == 0 &&
+				(!triangleNormals || memcmp(&triangleNormals[3 * walker], &triangleNormals[3 * i], 3 * sizeof(GLUSfloat)) == 0) &&
+				(!triangleTexCoords || memcmp(&triangleTexCoords[2 * walker], &triangleTexCoords[2 * i], 2 * sizeof(GLUSfloat)) == 0))
+			{
+				break;
+			}
+
+			walker = next[walker];
+		}
+
+		if (walker != 0xFFFFFFFF)
+		{
+			indices[i] = (GLUSindex)walker;
+
+			continue;
+		}
+
+		memmove(&triangleVertices[4 * numberUniqueVertices], &triangleVertices[4 * i], 4 * sizeof(GLUSfloat));
+
+		if (triangleNormals)
+		{
+			memmove(&triangleNormals[3 * numberUniqueVertices], &triangleNormals[3 * i], 3 * sizeof(GLUSfloat));
+		}
+
+		if (triangleTexCoords)
+		{
+			memmove(&triangleTexCoords[2 * numberUniqueVertices], &triangleTexCoords[2 * i], 2 * sizeof(GLUSfloat));
+		}
+
+		indices[i] = (GLUSindex)numberUniqueVertices;
+
+		next[numberUniqueVertices] = buckets[hash];
+		buckets[hash] = numberUniqueVertices;
+
+		numberUniqueVertices++;
+	}
+
+	glusMemoryFree(buckets);
+	glusMemoryFree(next);
+
+	return numberUniqueVertices;
+}
+
+static GLUSboolean glusWavefrontCopyData(GLUSshape* shape, GLUSuint totalNumberVertices, GLUSfloat* triangleVertices, GLUSuint totalNumberNormals, GLUSfloat* triangleNormals, GLUSuint totalNumberTexCoords, GLUSfloat* triangleTexCoords, GLUSboolean indexed)
 {
 	GLUSuint indicesCounter = 0;
 
+	GLUSuint numberIndices = totalNumberVertices;
+
+	GLUSindex* indices = 0;
+
 	if (!shape || !triangleVertices || !triangleNormals || !triangleTexCoords)
 	{
 		return GLUS_FALSE;
@@ -545,8 +938,68 @@ static GLUSboolean glusWavefrontCopyData(GLUSshape* shape, GLUSuint totalNumberV
 
 	memset(shape, 0, sizeof(GLUSshape));
 
+	if (numberIndices > 0)
+	{
+		indices = (GLUSindex*)glusMemoryMalloc(numberIndices * sizeof(GLUSindex));
+
+		if (indices == 0)
+		{
+			return GLUS_FALSE;
+		}
+	}
+
+	// Only complete vertex tuples can be merged.
+	if (indexed && numberIndices > 0 && (totalNumberNormals == 0 || totalNumberNormals == totalNumberVertices) && (totalNumberTexCoords == 0 || totalNumberTexCoords == totalNumberVertices))
+	{
+		totalNumberVertices = glusWavefrontIndexData(indices, numberIndices, triangleVertices, totalNumberNormals > 0 ? triangleNormals : 0, totalNumberTexCoords > 0 ? triangleTexCoords : 0);
+
+		if (totalNumberVertices == 0)
+		{
+			glusMemoryFree(indices);
+
+			return GLUS_FALSE;
+		}
+
+		if (totalNumberNormals > 0)
+		{
+			totalNumberNormals = totalNumberVertices;
+		}
+
+		if (totalNumberTexCoords > 0)
+		{
+			totalNumberTexCoords = totalNumberVertices;
+		}
+	}
+	else
+	{
+		if (indexed)
+		{
+			glusLogPrint(GLUS_LOG_WARNING, "Wavefront data has incomplete vertex tuples. Indices are not optimized.");
+		}
+
+		// Just create the indices from the list of vertices.
+		for (indicesCounter = 0; indicesCounter < numberIndices; indicesCounter++)
+		{
+			indices[indicesCounter] = indicesCounter;
+		}
+	}
+
+	// All vertices have to be addressable by the index type.
+	if (totalNumberVertices > 0 && (GLUSuint)(GLUSindex)(totalNumberVertices - 1) != totalNumberVertices - 1)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Wavefront data has too many vertices for the index type: %u", totalNumberVertices);
+
+		glusMemoryFree(indices);
+
+		return GLUS_FALSE;
+	}
+
 	shape->numberVertices = totalNumberVertices;
 
+	shape->numberIndices = numberIndices;
+
+	shape->indices = indices;
+
 	if (totalNumberVertices > 0)
 	{
 		shape->vertices = (GLUSfloat*)glusMemoryMalloc(totalNumberVertices * 4 * sizeof(GLUSfloat));
@@ -587,27 +1040,6 @@ static GLUSboolean glusWavefrontCopyData(GLUSshape* shape, GLUSuint totalNumberV
 		memcpy(shape->texCoords, triangleTexCoords, totalNumberTexCoords * 2 * sizeof(GLUSfloat));
 	}
 
-	// Just create the indices from the list of vertices.
-
-	shape->numberIndices = totalNumberVertices;
-
-	if (totalNumberVertices > 0)
-	{
-		shape->indices = (GLUSindex*)glusMemoryMalloc(totalNumberVertices * sizeof(GLUSindex));
-
-		if (shape->indices == 0)
-		{
-			glusShapeDestroyf(shape);
-
-			return GLUS_FALSE;
-		}
-
-		for (indicesCounter = 0; indicesCounter < totalNumberVertices; indicesCounter++)
-		{
-			shape->indices[indicesCounter] = indicesCounter;
-		}
-	}
-
 	shape->mode = GLUS_TRIANGLES;
 
 	return GLUS_TRUE;
@@ -647,9 +1079,12 @@ GLUSboolean _glusWavefrontMove(GLUSwavefront* wavefront, GLUSshape* shape)
 			return GLUS_FALSE;
 		}
 
+		// The groups are stored one after another in the shape indices.
 		for (i = 0; i < groupWalker->group.numberIndices; i++)
 		{
-			groupWalker->group.indices[i] = counter++;
+			groupWalker->group.indices[i] = (counter < shape->numberIndices) ? shape->indices[counter] : (GLUSindex)counter;
+
+			counter++;
 		}
 
 		materialWalker = wavefront->materials;
@@ -677,14 +1112,16 @@ GLUSboolean _glusWavefrontMove(GLUSwavefront* wavefront, GLUSshape* shape)
 	return GLUS_TRUE;
 }
 
-GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUSwavefront* wavefront, GLUSscene* scene)
+GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUSwavefront* wavefront, GLUSscene* scene, GLUSboolean indexed)
 {
 	GLUSboolean result;
 
-	FILE* f;
+	GLUSubyte* data;
+	size_t length;
 
-	GLUSchar buffer[GLUS_BUFFERSIZE];
-	GLUSchar identifier[7];
+	GLUSwavefrontscanner scanner;
+
+	GLUSchar identifier[GLUS_MAX_STRING];
 
 	GLUSfloat x, y, z;
 	GLUSfloat s, t;
@@ -701,6 +1138,14 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 	GLUSfloat* triangleNormals = 0;
 	GLUSfloat* triangleTexCoords = 0;
 
+	GLUSuint verticesCapacity = GLUS_INITIAL_ATTRIBUTES;
+	GLUSuint normalsCapacity = GLUS_INITIAL_ATTRIBUTES;
+	GLUSuint texCoordsCapacity = GLUS_INITIAL_ATTRIBUTES;
+
+	GLUSuint triangleVerticesCapacity = GLUS_INITIAL_ATTRIBUTES;
+	GLUSuint triangleNormalsCapacity = GLUS_INITIAL_ATTRIBUTES;
+	GLUSuint triangleTexCoordsCapacity = GLUS_INITIAL_ATTRIBUTES;
+
 	GLUSuint offsetNumberVertices = 0;
 	GLUSuint offsetNumberNormals = 0;
 	GLUSuint offsetNumberTexCoords = 0;
@@ -709,8 +1154,6 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 	GLUSuint totalNumberNormals = 0;
 	GLUSuint totalNumberTexCoords = 0;
 
-	GLUSuint facesEncoding = 0;
-
 	// Material and groups
 
 	GLUSchar name[GLUS_MAX_STRING];
@@ -746,9 +1189,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 		return GLUS_FALSE;
 	}
 
-	f = glusFileOpen(filename, "r");
-
-	if (!f)
+	if (!_glusFileMap(filename, &data, &length))
 	{
 		return GLUS_FALSE;
 	}
@@ -757,32 +1198,25 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 	{
 		glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-		glusFileClose(f);
+		_glusFileUnmap(data, length);
 
 		return GLUS_FALSE;
 	}
 
-	while (!feof(f))
-	{
-		buffer[0] = 0;
+	glusWavefrontScannerInit(&scanner, data, length);
 
-		if (fgets(buffer, GLUS_BUFFERSIZE, f) == 0)
+	for (; scanner.current < scanner.end; glusWavefrontScannerSkipLine(&scanner))
+	{
+		if (!glusWavefrontScannerWord(&scanner, identifier, GLUS_MAX_STRING))
 		{
-			if (ferror(f))
-			{
-				glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
-
-				glusFileClose(f);
-
-				return GLUS_FALSE;
-			}
+			continue;
 		}
 
 		if (wavefront)
 		{
-			if (strncmp(buffer, "mtllib", 6) == 0)
+			if (strcmp(identifier, "mtllib") == 0)
 			{
-				sscanf(buffer, "%s %s", identifier, name);
+				glusWavefrontScannerWord(&scanner, name, GLUS_MAX_STRING);
 
 				if (numberMaterials == 0)
 				{
@@ -793,14 +1227,14 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 				{
 					glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-					glusFileClose(f);
+					_glusFileUnmap(data, length);
 
 					return GLUS_FALSE;
 				}
 
 				numberMaterials++;
 			}
-			else if (strncmp(buffer, "usemtl", 6) == 0)
+			else if (strcmp(identifier, "usemtl") == 0)
 			{
 				if (!currentGroupList || currentGroupList->group.materialName[0] != '\0')
 				{
@@ -812,7 +1246,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 					{
 						glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-						glusFileClose(f);
+						_glusFileUnmap(data, length);
 
 						return GLUS_FALSE;
 					}
@@ -833,7 +1267,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 
 							glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-							glusFileClose(f);
+							_glusFileUnmap(data, length);
 
 							return GLUS_FALSE;
 						}
@@ -851,15 +1285,15 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 
 				//
 
-				sscanf(buffer, "%s %s", identifier, name);
+				glusWavefrontScannerWord(&scanner, name, GLUS_MAX_STRING);
 
 				strcpy(currentGroupList->group.materialName, name);
 			}
-			else if (strncmp(buffer, "g", 1) == 0)
+			else if (strcmp(identifier, "g") == 0)
 			{
 				GLUSgroupList* newGroupList;
 
-				sscanf(buffer, "%s %s", identifier, name);
+				glusWavefrontScannerWord(&scanner, name, GLUS_MAX_STRING);
 
 				newGroupList = (GLUSgroupList*)glusMemoryMalloc(sizeof(GLUSgroupList));
 
@@ -867,7 +1301,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 				{
 					glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-					glusFileClose(f);
+					_glusFileUnmap(data, length);
 
 					return GLUS_FALSE;
 				}
@@ -888,7 +1322,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 
 						glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-						glusFileClose(f);
+						_glusFileUnmap(data, length);
 
 						return GLUS_FALSE;
 					}
@@ -905,7 +1339,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 			}
 		}
 
-		if (strncmp(buffer, "o", 1) == 0)
+		if (strcmp(identifier, "o") == 0)
 		{
 			if (scene)
 			{
@@ -919,7 +1353,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 						numberIndicesGroup = 0;
 					}
 
-					result = glusWavefrontCopyData(shape, totalNumberVertices - offsetNumberVertices, &triangleVertices[4 * offsetNumberVertices], totalNumberNormals - offsetNumberNormals, &triangleNormals[3 * offsetNumberNormals], totalNumberTexCoords - offsetNumberTexCoords, &triangleTexCoords[2 * offsetNumberTexCoords]);
+					result = glusWavefrontCopyData(shape, totalNumberVertices - offsetNumberVertices, &triangleVertices[4 * offsetNumberVertices], totalNumberNormals - offsetNumberNormals, &triangleNormals[3 * offsetNumberNormals], totalNumberTexCoords - offsetNumberTexCoords, &triangleTexCoords[2 * offsetNumberTexCoords], indexed);
 
 					if (result)
 					{
@@ -930,7 +1364,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 					{
 						glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-						glusFileClose(f);
+						_glusFileUnmap(data, length);
 
 						return GLUS_FALSE;
 					}
@@ -938,7 +1372,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 					memcpy(&currentObjectList->object, wavefront, sizeof(GLUSwavefront));
 				}
 
-				sscanf(buffer, "%s %s", identifier, name);
+				glusWavefrontScannerWord(&scanner, name, GLUS_MAX_STRING);
 
 				strcpy(wavefront->name, name);
 
@@ -949,7 +1383,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 				{
 					glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-					glusFileClose(f);
+					_glusFileUnmap(data, length);
 
 					return GLUS_FALSE;
 				}
@@ -982,7 +1416,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 			{
 				GLUSgroupList* newGroupList;
 
-				sscanf(buffer, "%s %s", identifier, name);
+				glusWavefrontScannerWord(&scanner, name, GLUS_MAX_STRING);
 
 				newGroupList = (GLUSgroupList*)glusMemoryMalloc(sizeof(GLUSgroupList));
 
@@ -990,7 +1424,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 				{
 					glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-					glusFileClose(f);
+					_glusFileUnmap(data, length);
 
 					return GLUS_FALSE;
 				}
@@ -1011,7 +1445,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 
 						glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-						glusFileClose(f);
+						_glusFileUnmap(data, length);
 
 						return GLUS_FALSE;
 					}
@@ -1032,7 +1466,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 				{
 					glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-					glusFileClose(f);
+					_glusFileUnmap(data, length);
 
 					return GLUS_FALSE;
 				}
@@ -1040,36 +1474,39 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 
 			numberObjects++;
 		}
-		else if (strncmp(buffer, "vt", 2) == 0)
+		else if (strcmp(identifier, "vt") == 0)
 		{
-			if (numberTexCoords == GLUS_MAX_ATTRIBUTES)
+			if (!glusWavefrontGrowTempMemory((GLUSvoid**)&texCoords, &texCoordsCapacity, numberTexCoords + 1, 2 * sizeof(GLUSfloat)))
 			{
 				glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-				glusFileClose(f);
+				_glusFileUnmap(data, length);
 
 				return GLUS_FALSE;
 			}
 
-			sscanf(buffer, "%s %f %f", identifier, &s, &t);
+			glusWavefrontScannerFloat(&scanner, &s);
+			glusWavefrontScannerFloat(&scanner, &t);
 
 			texCoords[2 * numberTexCoords + 0] = s;
 			texCoords[2 * numberTexCoords + 1] = t;
 
 			numberTexCoords++;
 		}
-		else if (strncmp(buffer, "vn", 2) == 0)
+		else if (strcmp(identifier, "vn") == 0)
 		{
-			if (numberNormals == GLUS_MAX_ATTRIBUTES)
+			if (!glusWavefrontGrowTempMemory((GLUSvoid**)&normals, &normalsCapacity, numberNormals + 1, 3 * sizeof(GLUSfloat)))
 			{
 				glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-				glusFileClose(f);
+				_glusFileUnmap(data, length);
 
 				return GLUS_FALSE;
 			}
 
-			sscanf(buffer, "%s %f %f %f", identifier, &x, &y, &z);
+			glusWavefrontScannerFloat(&scanner, &x);
+			glusWavefrontScannerFloat(&scanner, &y);
+			glusWavefrontScannerFloat(&scanner, &z);
 
 			normals[3 * numberNormals + 0] = x;
 			normals[3 * numberNormals + 1] = y;
@@ -1077,18 +1514,20 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 
 			numberNormals++;
 		}
-		else if (strncmp(buffer, "v", 1) == 0)
+		else if (strcmp(identifier, "v") == 0)
 		{
-			if (numberVertices == GLUS_MAX_ATTRIBUTES)
+			if (!glusWavefrontGrowTempMemory((GLUSvoid**)&vertices, &verticesCapacity, numberVertices + 1, 4 * sizeof(GLUSfloat)))
 			{
 				glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-				glusFileClose(f);
+				_glusFileUnmap(data, length);
 
 				return GLUS_FALSE;
 			}
 
-			sscanf(buffer, "%s %f %f %f", identifier, &x, &y, &z);
+			glusWavefrontScannerFloat(&scanner, &x);
+			glusWavefrontScannerFloat(&scanner, &y);
+			glusWavefrontScannerFloat(&scanner, &z);
 
 			vertices[4 * numberVertices + 0] = x;
 			vertices[4 * numberVertices + 1] = y;
@@ -1097,87 +1536,48 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 
 			numberVertices++;
 		}
-		else if (strncmp(buffer, "f", 1) == 0)
+		else if (strcmp(identifier, "f") == 0)
 		{
-			GLUSchar* token;
-
 			GLUSint vIndex, vtIndex, vnIndex;
 
-			GLUSuint edgeCount = 0;
-
-			token = strtok(buffer, " \t");
-			token = strtok(0, " \n");
+			GLUSboolean hasTexCoord = GLUS_FALSE;
+			GLUSboolean hasNormal = GLUS_FALSE;
 
-			if (!token)
-			{
-				continue;
-			}
+			GLUSuint edgeCount = 0;
 
-			// Check faces
-			if (strstr(token, "//") != 0)
-			{
-				facesEncoding = 2;
-			}
-			else if (strstr(token, "/") == 0)
+			while (glusWavefrontScannerFaceElement(&scanner, &vIndex, &vtIndex, &vnIndex))
 			{
-				facesEncoding = 0;
-			}
-			else if (strstr(token, "/") != 0)
-			{
-				GLUSchar* c = strstr(token, "/");
-
-				c++;
+				vIndex--;
+				vtIndex--;
+				vnIndex--;
 
-				if (!c)
+				if (edgeCount == 0)
 				{
-					continue;
+					hasTexCoord = vtIndex != -1;
+					hasNormal = vnIndex != -1;
 				}
 
-				if (strstr(c, "/") == 0)
+				// Skipping only one of the indices would misalign the vertices, normals and texture coordinates, so the load fails.
+				if (vIndex < 0 || (GLUSuint)vIndex >= numberVertices || (vnIndex != -1) != hasNormal || (vnIndex != -1 && (vnIndex < 0 || (GLUSuint)vnIndex >= numberNormals)) || (vtIndex != -1) != hasTexCoord || (vtIndex != -1 && (vtIndex < 0 || (GLUSuint)vtIndex >= numberTexCoords)))
 				{
-					facesEncoding = 1;
-				}
-				else
-				{
-					facesEncoding = 3;
-				}
-			}
+					glusLogPrint(GLUS_LOG_ERROR, "Wavefront file has a face with missing or out of range indices: %s", filename);
 
-			while (token != 0)
-			{
-				vIndex = -1;
-				vtIndex = -1;
-				vnIndex = -1;
+					glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-				switch (facesEncoding)
-				{
-					case 0:
-						sscanf(token, "%d", &vIndex);
-					break;
-					case 1:
-						sscanf(token, "%d/%d", &vIndex, &vtIndex);
-					break;
-					case 2:
-						sscanf(token, "%d//%d", &vIndex, &vnIndex);
-					break;
-					case 3:
-						sscanf(token, "%d/%d/%d", &vIndex, &vtIndex, &vnIndex);
-					break;
-				}
+					_glusFileUnmap(data, length);
 
-				vIndex--;
-				vtIndex--;
-				vnIndex--;
+					return GLUS_FALSE;
+				}
 
-				if (vIndex >= 0)
+				if (vIndex >= 0 && (GLUSuint)vIndex < numberVertices)
 				{
 					if (edgeCount < 3)
 					{
-						if (totalNumberVertices >= GLUS_MAX_TRIANGLE_ATTRIBUTES)
+						if (!glusWavefrontGrowTempMemory((GLUSvoid**)&triangleVertices, &triangleVerticesCapacity, totalNumberVertices + 1, 4 * sizeof(GLUSfloat)))
 						{
 							glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-							glusFileClose(f);
+							_glusFileUnmap(data, length);
 
 							return GLUS_FALSE;
 						}
@@ -1189,11 +1589,11 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 					}
 					else
 					{
-						if (totalNumberVertices >= GLUS_MAX_TRIANGLE_ATTRIBUTES - 2)
+						if (!glusWavefrontGrowTempMemory((GLUSvoid**)&triangleVertices, &triangleVerticesCapacity, totalNumberVertices + 3, 4 * sizeof(GLUSfloat)))
 						{
 							glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-							glusFileClose(f);
+							_glusFileUnmap(data, length);
 
 							return GLUS_FALSE;
 						}
@@ -1206,15 +1606,15 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 						numberIndicesGroup +=3;
 					}
 				}
-				if (vnIndex >= 0)
+				if (vnIndex >= 0 && (GLUSuint)vnIndex < numberNormals)
 				{
 					if (edgeCount < 3)
 					{
-						if (totalNumberNormals >= GLUS_MAX_TRIANGLE_ATTRIBUTES)
+						if (!glusWavefrontGrowTempMemory((GLUSvoid**)&triangleNormals, &triangleNormalsCapacity, totalNumberNormals + 1, 3 * sizeof(GLUSfloat)))
 						{
 							glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-							glusFileClose(f);
+							_glusFileUnmap(data, length);
 
 							return GLUS_FALSE;
 						}
@@ -1225,11 +1625,11 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 					}
 					else
 					{
-						if (totalNumberNormals >= GLUS_MAX_TRIANGLE_ATTRIBUTES - 2)
+						if (!glusWavefrontGrowTempMemory((GLUSvoid**)&triangleNormals, &triangleNormalsCapacity, totalNumberNormals + 3, 3 * sizeof(GLUSfloat)))
 						{
 							glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-							glusFileClose(f);
+							_glusFileUnmap(data, length);
 
 							return GLUS_FALSE;
 						}
@@ -1241,15 +1641,15 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 						totalNumberNormals += 3;
 					}
 				}
-				if (vtIndex >= 0)
+				if (vtIndex >= 0 && (GLUSuint)vtIndex < numberTexCoords)
 				{
 					if (edgeCount < 3)
 					{
-						if (totalNumberTexCoords >= GLUS_MAX_TRIANGLE_ATTRIBUTES)
+						if (!glusWavefrontGrowTempMemory((GLUSvoid**)&triangleTexCoords, &triangleTexCoordsCapacity, totalNumberTexCoords + 1, 2 * sizeof(GLUSfloat)))
 						{
 							glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-							glusFileClose(f);
+							_glusFileUnmap(data, length);
 
 							return GLUS_FALSE;
 						}
@@ -1260,11 +1660,11 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 					}
 					else
 					{
-						if (totalNumberTexCoords >= GLUS_MAX_TRIANGLE_ATTRIBUTES - 2)
+						if (!glusWavefrontGrowTempMemory((GLUSvoid**)&triangleTexCoords, &triangleTexCoordsCapacity, totalNumberTexCoords + 3, 2 * sizeof(GLUSfloat)))
 						{
 							glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
-							glusFileClose(f);
+							_glusFileUnmap(data, length);
 
 							return GLUS_FALSE;
 						}
@@ -1278,13 +1678,11 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 				}
 
 				edgeCount++;
-
-				token = strtok(0, " \n");
 			}
 		}
 	}
 
-	glusFileClose(f);
+	_glusFileUnmap(data, length);
 
 	if (wavefront && currentGroupList)
 	{
@@ -1292,7 +1690,7 @@ GLUSboolean _glusWavefrontParse(const GLUSchar* filename, GLUSshape* shape, GLUS
 		numberIndicesGroup = 0;
 	}
 
-	result = glusWavefrontCopyData(shape, totalNumberVertices - offsetNumberVertices, &triangleVertices[4 * offsetNumberVertices], totalNumberNormals - offsetNumberNormals, &triangleNormals[3 * offsetNumberNormals], totalNumberTexCoords - offsetNumberTexCoords, &triangleTexCoords[2 * offsetNumberTexCoords]);
+	result = glusWavefrontCopyData(shape, totalNumberVertices - offsetNumberVertices, &triangleVertices[4 * offsetNumberVertices], totalNumberNormals - offsetNumberNormals, &triangleNormals[3 * offsetNumberNormals], totalNumberTexCoords - offsetNumberTexCoords, &triangleTexCoords[2 * offsetNumberTexCoords], indexed);
 
 	glusWavefrontFreeTempMemory(&vertices, &normals, &texCoords, &triangleVertices, &triangleNormals, &triangleTexCoords);
 
@@ -1337,19 +1735,24 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar* filename, GLUSline* line)
 {
 	GLUSboolean result;
 
-	FILE* f;
+	GLUSubyte* data;
+	size_t length;
 
-	GLUSchar buffer[GLUS_BUFFERSIZE];
-	GLUSchar identifier[7];
+	GLUSwavefrontscanner scanner;
+
+	GLUSchar identifier[GLUS_MAX_STRING];
 
 	GLUSfloat x, y, z;
 
-	GLUSint start, end;
+	GLUSint start = 0, end = 0;
 
 	GLUSfloat* vertices = 0;
 
 	GLUSindex* indices = 0;
 
+	GLUSuint verticesCapacity = GLUS_INITIAL_ATTRIBUTES;
+	GLUSuint indicesCapacity = GLUS_INITIAL_ATTRIBUTES;
+
 	GLUSuint numberVertices = 0;
 
 	GLUSuint numberIndices = 0;
@@ -1368,9 +1771,7 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar* filename, GLUSline* line)
 		return GLUS_FALSE;
 	}
 
-	f = glusFileOpen(filename, "r");
-
-	if (!f)
+	if (!_glusFileMap(filename, &data, &length))
 	{
 		return GLUS_FALSE;
 	}
@@ -1379,52 +1780,47 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar* filename, GLUSline* line)
 	{
 		glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
-		glusFileClose(f);
+		_glusFileUnmap(data, length);
 
 		return GLUS_FALSE;
 	}
 
-	while (!feof(f))
-	{
-		buffer[0] = 0;
+	glusWavefrontScannerInit(&scanner, data, length);
 
-		if (fgets(buffer, GLUS_BUFFERSIZE, f) == 0)
+	for (; scanner.current < scanner.end; glusWavefrontScannerSkipLine(&scanner))
+	{
+		if (!glusWavefrontScannerWord(&scanner, identifier, GLUS_MAX_STRING))
 		{
-			if (ferror(f))
-			{
-				glusWavefrontFreeTempMemoryLine(&vertices, &indices);
-
-				glusFileClose(f);
-
-				return GLUS_FALSE;
-			}
+			continue;
 		}
 
-		if (strncmp(buffer, "o", 1) == 0)
+		if (strcmp(identifier, "o") == 0)
 		{
 			if (numberObjects == GLUS_MAX_OBJECTS)
 			{
 				glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
-				glusFileClose(f);
+				_glusFileUnmap(data, length);
 
 				return GLUS_FALSE;
 			}
 
 			numberObjects++;
 		}
-		else if (strncmp(buffer, "v", 1) == 0)
+		else if (strcmp(identifier, "v") == 0)
 		{
-			if (numberVertices == GLUS_MAX_ATTRIBUTES)
+			if (!glusWavefrontGrowTempMemory((GLUSvoid**)&vertices, &verticesCapacity, numberVertices + 1, 4 * sizeof(GLUSfloat)))
 			{
 				glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
-				glusFileClose(f);
+				_glusFileUnmap(data, length);
 
 				return GLUS_FALSE;
 			}
 
-			sscanf(buffer, "%s %f %f %f", identifier, &x, &y, &z);
+			glusWavefrontScannerFloat(&scanner, &x);
+			glusWavefrontScannerFloat(&scanner, &y);
+			glusWavefrontScannerFloat(&scanner, &z);
 
 			vertices[4 * numberVertices + 0] = x;
 			vertices[4 * numberVertices + 1] = y;
@@ -1433,18 +1829,22 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar* filename, GLUSline* line)
 
 			numberVertices++;
 		}
-		else if (strncmp(buffer, "l", 1) == 0)
+		else if (strcmp(identifier, "l") == 0)
 		{
-			if (numberIndices == GLUS_MAX_LINE_ATTRIBUTES)
+			if (!glusWavefrontGrowTempMemory((GLUSvoid**)&indices, &indicesCapacity, numberIndices + 2, sizeof(GLUSindex)))
 			{
 				glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
-				glusFileClose(f);
+				_glusFileUnmap(data, length);
 
 				return GLUS_FALSE;
 			}
 
-			sscanf(buffer, "%s %d %d", identifier, &start, &end);
+			glusWavefrontScannerSkipBlanks(&scanner);
+			glusWavefrontScannerInt(&scanner, &start);
+
+			glusWavefrontScannerSkipBlanks(&scanner);
+			glusWavefrontScannerInt(&scanner, &end);
 
 			if (start > 0)
 			{
@@ -1458,7 +1858,7 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar* filename, GLUSline* line)
 			{
 				glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
-				glusFileClose(f);
+				_glusFileUnmap(data, length);
 
 				return GLUS_FALSE;
 			}
@@ -1475,7 +1875,7 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar* filename, GLUSline* line)
 			{
 				glusWavefrontFreeTempMemoryLine(&vertices, &indices);
 
-				glusFileClose(f);
+				_glusFileUnmap(data, length);
 
 				return GLUS_FALSE;
 			}
@@ -1487,7 +1887,7 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar* filename, GLUSline* line)
 		}
 	}
 
-	glusFileClose(f);
+	_glusFileUnmap(data, length);
 
 	result = glusWavefrontCopyDataLine(line, numberVertices, vertices, numberIndices, indices);
 
@@ -1496,13 +1896,46 @@ GLUSboolean _glusWavefrontParseLine(const GLUSchar* filename, GLUSline* line)
 	return result;
 }
 
-//
+/**
+ * Calls the function for every material library, which is referenced by the mapped Wavefront data.
+ */
+GLUSboolean _glusWavefrontParseMaterialLibraries(const GLUSubyte* data, size_t length, GLUSboolean (*function)(GLUSvoid* userData, const GLUSchar* filename), GLUSvoid* userData)
+{
+	GLUSwavefrontscanner scanner;
 
-GLUSboolean GLUSAPIENTRY glusWavefrontLoad(const GLUSchar* filename, GLUSwavefront* wavefront)
+	GLUSchar identifier[GLUS_MAX_STRING];
+	GLUSchar name[GLUS_MAX_STRING];
+
+	if (!function)
+	{
+		return GLUS_FALSE;
+	}
+
+	glusWavefrontScannerInit(&scanner, data, length);
+
+	for (; scanner.current < scanner.end; glusWavefrontScannerSkipLine(&scanner))
+	{
+		if (!glusWavefrontScannerWord(&scanner, identifier, GLUS_MAX_STRING) || strcmp(identifier, "mtllib") != 0)
+		{
+			continue;
+		}
+
+		glusWavefrontScannerWord(&scanner, name, GLUS_MAX_STRING);
+
+		if (!function(userData, name))
+		{
+			return GLUS_FALSE;
+		}
+	}
+
+	return GLUS_TRUE;
+}
+
+static GLUSboolean glusWavefrontLoadData(const GLUSchar* filename, GLUSwavefront* wavefront, GLUSboolean indexed)
 {
 	GLUSshape dummyShape;
 
-	if (!_glusWavefrontParse(filename, &dummyShape, wavefront, 0))
+	if (!_glusWavefrontParse(filename, &dummyShape, wavefront, 0, indexed))
 	{
 		glusWavefrontDestroy(wavefront);
 
@@ -1519,6 +1952,59 @@ GLUSboolean GLUSAPIENTRY glusWavefrontLoad(const GLUSchar* filename, GLUSwavefro
 	return GLUS_TRUE;
 }
 
+static GLUSboolean glusWavefrontLoadSceneData(const GLUSchar* filename, GLUSscene* scene, GLUSboolean indexed)
+{
+	GLUSshape dummyShape;
+	GLUSwavefront dummyWavefront;
+
+	if (!scene)
+	{
+		return GLUS_FALSE;
+	}
+
+	memset(&dummyShape, 0, sizeof(GLUSshape));
+	memset(&dummyWavefront, 0, sizeof(GLUSwavefront));
+
+	memset(scene, 0, sizeof(GLUSscene));
+
+	if (!_glusWavefrontParse(filename, &dummyShape, &dummyWavefront, scene, indexed))
+	{
+		glusWavefrontDestroyScene(scene);
+
+		return GLUS_FALSE;
+	}
+
+	return GLUS_TRUE;
+}
+
+//
+
+GLUSboolean GLUSAPIENTRY glusWavefrontLoad(const GLUSchar* filename, GLUSwavefront* wavefront)
+{
+	GLUSboolean result;
+
+	GLUS_PROFILE_BEGIN("glusWavefrontLoad");
+
+	result = glusWavefrontLoadData(filename, wavefront, GLUS_FALSE);
+
+	GLUS_PROFILE_END();
+
+	return result;
+}
+
+GLUSboolean GLUSAPIENTRY glusWavefrontLoadIndexed(const GLUSchar* filename, GLUSwavefront* wavefront)
+{
+	GLUSboolean result;
+
+	GLUS_PROFILE_BEGIN("glusWavefrontLoadIndexed");
+
+	result = glusWavefrontLoadData(filename, wavefront, GLUS_TRUE);
+
+	GLUS_PROFILE_END();
+
+	return result;
+}
+
 GLUSvoid GLUSAPIENTRY glusWavefrontDestroy(GLUSwavefront* wavefront)
 {
 	if (!wavefront)
@@ -1569,27 +2055,28 @@ GLUSvoid GLUSAPIENTRY glusWavefrontDestroy(GLUSwavefront* wavefront)
 
 GLUSboolean GLUSAPIENTRY glusWavefrontLoadScene(const GLUSchar* filename, GLUSscene* scene)
 {
-	GLUSshape dummyShape;
-	GLUSwavefront dummyWavefront;
+	GLUSboolean result;
 
-	if (!scene)
-	{
-		return GLUS_FALSE;
-	}
+	GLUS_PROFILE_BEGIN("glusWavefrontLoadScene");
 
-	memset(&dummyShape, 0, sizeof(GLUSshape));
-	memset(&dummyWavefront, 0, sizeof(GLUSwavefront));
+	result = glusWavefrontLoadSceneData(filename, scene, GLUS_FALSE);
 
-	memset(scene, 0, sizeof(GLUSscene));
+	GLUS_PROFILE_END();
 
-	if (!_glusWavefrontParse(filename, &dummyShape, &dummyWavefront, scene))
-	{
-		glusWavefrontDestroyScene(scene);
+	return result;
+}
 
-		return GLUS_FALSE;
-	}
+GLUSboolean GLUSAPIENTRY glusWavefrontLoadSceneIndexed(const GLUSchar* filename, GLUSscene* scene)
+{
+	GLUSboolean result;
 
-	return GLUS_TRUE;
+	GLUS_PROFILE_BEGIN("glusWavefrontLoadSceneIndexed");
+
+	result = glusWavefrontLoadSceneData(filename, scene, GLUS_TRUE);
+
+	GLUS_PROFILE_END();
+
+	return result;
 }
 
 GLUSvoid GLUSAPIENTRY glusWavefrontDestroyScene(GLUSscene* scene)
@@ -1618,7 +2105,7 @@ GLUSvoid GLUSAPIENTRY glusWavefrontDestroyScene(GLUSscene* scene)
 
 		walker = walker->next;
 
-		free(toDelete);
+		glusMemoryFree(toDelete);
 	}
 
 	memset(scene, 0, sizeof(GLUSscene));
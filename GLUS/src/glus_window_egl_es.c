@@ -17,6 +17,9 @@
 
 #include "GL/glus.h"
 
+// Configuration attributes and values including the added surface type.
+#define GLUS_MAX_HEADLESS_ATTRIBUTES 64
+
 extern GLUSvoid _glusOsPollEvents(GLUSvoid);
 
 extern EGLNativeDisplayType _glusOsGetNativeDisplayType(GLUSvoid);
@@ -29,21 +32,22 @@ extern double _glusOsGetRawTime(GLUSvoid);
 
 extern GLUSvoid _glusOsGetWindowSize(GLUSint* width, GLUSint* height);
 
-extern GLUSint _glusWindowGetCurrentRecordingFrame(GLUSvoid);
+extern GLUSfloat _glusWindowGetRecordingTime(GLUSvoid);
 
-extern GLUSint _glusWindowGetCurrentAndIncreaseRecordingFrame(GLUSvoid);
+extern GLUSboolean _glusWindowRecordFrame(GLUSvoid);
 
-extern GLUSint _glusWindowGetRecordingFrames(GLUSvoid);
+extern GLUSboolean _glusWindowSchedulerStep(GLUSfloat time);
 
-extern GLUSfloat _glusWindowGetRecordingTime(GLUSvoid);
+extern GLUSvoid _glusWindowSchedulerShutdown(GLUSvoid);
 
-extern const GLUStgaimage* _glusWindowGetRecordingImageTga(GLUSvoid);
+extern GLUSboolean _glusWindowRunHeadless(GLUSboolean (*init)(GLUSvoid), GLUSvoid (*reshape)(GLUSint width, GLUSint height), GLUSboolean (*update)(GLUSfloat time), GLUSvoid (*terminate)(GLUSvoid), const GLUSint width, const GLUSint height);
 
 static EGLDisplay g_eglDisplay = EGL_NO_DISPLAY;
 static EGLDisplay g_eglSurface = EGL_NO_SURFACE;
 static EGLDisplay g_eglContext = EGL_NO_CONTEXT;
 
 static GLUSboolean g_windowCreated = GLUS_FALSE;
+static GLUSboolean g_headless = GLUS_FALSE;
 static GLUSboolean g_initdone = GLUS_FALSE;
 static GLUSboolean g_done = GLUS_FALSE;
 static GLUSint g_buttons = 0;
@@ -229,11 +233,22 @@ GLUSvoid _glusWindowInternalMouseMove(GLUSint x, GLUSint y)
 	}
 }
 
+GLUSboolean GLUSAPIENTRY glusWindowHasContext(GLUSvoid)
+{
+	return g_eglContext != EGL_NO_CONTEXT;
+}
+
 GLUSvoid GLUSAPIENTRY glusWindowDestroy(GLUSvoid)
 {
 	glusEGLTerminate(&g_eglDisplay, &g_eglContext, &g_eglSurface);
 
-	_glusOsDestroyNativeWindowDisplay();
+	// A headless context has no native window.
+	if (!g_headless)
+	{
+		_glusOsDestroyNativeWindowDisplay();
+	}
+
+	g_headless = GLUS_FALSE;
 
 	g_windowCreated = GLUS_FALSE;
 
@@ -248,6 +263,10 @@ GLUSboolean GLUSAPIENTRY glusWindowCreate(const GLUSchar* title, const GLUSint w
 
 	EGLint nativeVisualID = 0;
 
+	EGLint headlessConfigAttribList[GLUS_MAX_HEADLESS_ATTRIBUTES];
+
+	GLUSint i;
+
 	if (g_windowCreated)
 	{
 		glusLogPrint(GLUS_LOG_ERROR, "Window already exists");
@@ -255,6 +274,59 @@ GLUSboolean GLUSAPIENTRY glusWindowCreate(const GLUSchar* title, const GLUSint w
 		return GLUS_FALSE;
 	}
 
+	// Without a window, the context renders into a pixel buffer surface.
+	if (glusWindowIsHeadless())
+	{
+		i = 0;
+
+		while (configAttribList && configAttribList[i] != EGL_NONE && i < GLUS_MAX_HEADLESS_ATTRIBUTES - 3)
+		{
+			headlessConfigAttribList[i] = configAttribList[i];
+			headlessConfigAttribList[i + 1] = configAttribList[i + 1];
+
+			if (configAttribList[i] == EGL_SURFACE_TYPE)
+			{
+				headlessConfigAttribList[i + 1] = EGL_PBUFFER_BIT;
+			}
+
+			i += 2;
+		}
+
+		if (configAttribList && configAttribList[i] != EGL_NONE)
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Too many EGL configuration attributes");
+
+			return GLUS_FALSE;
+		}
+
+		headlessConfigAttribList[i] = EGL_SURFACE_TYPE;
+		headlessConfigAttribList[i + 1] = EGL_PBUFFER_BIT;
+		headlessConfigAttribList[i + 2] = EGL_NONE;
+
+		g_headless = GLUS_TRUE;
+
+		if (!glusEGLCreateContext(EGL_DEFAULT_DISPLAY, &g_eglDisplay, &eglConfig, &g_eglContext, headlessConfigAttribList, contextAttribList))
+		{
+			glusWindowDestroy();
+
+			return GLUS_FALSE;
+		}
+
+		if (!glusEGLCreatePbufferSurfaceMakeCurrent(width, height, &g_eglDisplay, &eglConfig, &g_eglContext, &g_eglSurface))
+		{
+			glusWindowDestroy();
+
+			return GLUS_FALSE;
+		}
+
+		g_width = width;
+		g_height = height;
+
+		g_windowCreated = GLUS_TRUE;
+
+		return GLUS_TRUE;
+	}
+
 	if (!glusEGLCreateContext(_glusOsGetNativeDisplayType(), &g_eglDisplay, &eglConfig, &g_eglContext, configAttribList, contextAttribList))
 	{
 		glusWindowDestroy();
@@ -293,6 +365,15 @@ GLUSboolean GLUSAPIENTRY glusWindowRun(GLUSvoid)
 {
 	GLUSboolean run = GLUS_TRUE;
 
+	if (g_headless)
+	{
+		run = _glusWindowRunHeadless(glusInit, glusReshape, glusUpdate, glusTerminate, g_width, g_height);
+
+		glusWindowDestroy();
+
+		return run;
+	}
+
 	if (!glusWindowStartup())
 	{
 		return GLUS_FALSE;
@@ -320,7 +401,15 @@ GLUSboolean GLUSAPIENTRY glusWindowStartup(GLUSvoid)
 	// Init Engine
 	if (glusInit)
 	{
-		if (!glusInit())
+		GLUSboolean result;
+
+		GLUS_PROFILE_BEGIN("glusInit");
+
+		result = glusInit();
+
+		GLUS_PROFILE_END();
+
+		if (!result)
 		{
 			glusWindowShutdown();
 
@@ -343,14 +432,35 @@ GLUSboolean GLUSAPIENTRY glusWindowLoop(GLUSvoid)
 {
 	if (!g_done) // Loop That Runs While done=FALSE
 	{
+		GLUS_PROFILE_BEGIN("glusWindowLoop");
+
+		// Jobs, which have to run on the main thread e.g. because of OpenGL calls.
+		glusJobRunMainThread();
+
 		if (glusUpdate)
 		{
-			g_done = !glusUpdate(glusWindowGetElapsedTime());
+			GLUSfloat time = glusWindowGetElapsedTime();
+
+			g_done = !_glusWindowSchedulerStep(time);
+
+			GLUS_PROFILE_BEGIN("glusUpdate");
+
+			g_done = !glusUpdate(time) || g_done;
+
+			GLUS_PROFILE_END();
 		}
 
+		GLUS_PROFILE_BEGIN("glusWindowSwapBuffers");
+
 		eglSwapBuffers(g_eglDisplay, g_eglSurface); // Swap Buffers (Double Buffering)
 
+		GLUS_PROFILE_END();
+
 		_glusOsPollEvents();
+
+		GLUS_PROFILE_END();
+
+		GLUS_PROFILE_FLUSH();
 	}
 
 	return !g_done;
@@ -360,37 +470,50 @@ GLUSboolean GLUSAPIENTRY glusWindowLoopDoRecording(GLUSvoid)
 {
 	if (!g_done) // Loop That Runs While done=FALSE
 	{
+		GLUS_PROFILE_BEGIN("glusWindowLoop");
+
+		// Jobs, which have to run on the main thread e.g. because of OpenGL calls.
+		glusJobRunMainThread();
+
 		if (glusUpdate)
 		{
+			GLUSfloat time = _glusWindowGetRecordingTime();
+
 			// Still consume and update time, as a fixed recording time is used.
 			glusWindowGetElapsedTime();
 
-			g_done = !glusUpdate(_glusWindowGetRecordingTime());
+			g_done = !_glusWindowSchedulerStep(time);
+
+			GLUS_PROFILE_BEGIN("glusUpdate");
+
+			g_done = !glusUpdate(time) || g_done;
+
+			GLUS_PROFILE_END();
 
 			if (!g_done)
 			{
-				if (_glusWindowGetCurrentRecordingFrame() < _glusWindowGetRecordingFrames())
-				{
-					if (glusScreenshotUseTga(0, 0, _glusWindowGetRecordingImageTga()))
-					{
-						static const GLUSchar* filenameTemplate = "screenshot-%04d.tga";
-						static GLUSchar filename[20];
-
-						sprintf(filename, filenameTemplate, _glusWindowGetCurrentAndIncreaseRecordingFrame());
+				GLUS_PROFILE_BEGIN("glusWindowRecordFrame");
 
-						glusImageSaveTga(filename, _glusWindowGetRecordingImageTga());
-					}
-				}
-				else
+				if (!_glusWindowRecordFrame())
 				{
 					g_done = GLUS_TRUE;
 				}
+
+				GLUS_PROFILE_END();
 			}
 		}
 
+		GLUS_PROFILE_BEGIN("glusWindowSwapBuffers");
+
 		eglSwapBuffers(g_eglDisplay, g_eglSurface); // Swap Buffers (Double Buffering)
 
+		GLUS_PROFILE_END();
+
 		_glusOsPollEvents();
+
+		GLUS_PROFILE_END();
+
+		GLUS_PROFILE_FLUSH();
 	}
 
 	return !g_done;
@@ -398,10 +521,17 @@ GLUSboolean GLUSAPIENTRY glusWindowLoopDoRecording(GLUSvoid)
 
 GLUSvoid GLUSAPIENTRY glusWindowShutdown(GLUSvoid)
 {
+	// Simulation has to be finished, before resources are released
+	_glusWindowSchedulerShutdown();
+
 	// Terminate Game
 	if (glusTerminate)
 	{
+		GLUS_PROFILE_BEGIN("glusTerminate");
+
 		glusTerminate();
+
+		GLUS_PROFILE_END();
 	}
 
 	if (glusWindowIsRecording())
@@ -17,17 +17,18 @@
 
 #include "GL/glus.h"
 
-extern GLUSint _glusWindowGetCurrentRecordingFrame(GLUSvoid);
+extern GLUSfloat _glusWindowGetRecordingTime(GLUSvoid);
 
-extern GLUSint _glusWindowGetCurrentAndIncreaseRecordingFrame(GLUSvoid);
+extern GLUSboolean _glusWindowRecordFrame(GLUSvoid);
 
-extern GLUSint _glusWindowGetRecordingFrames(GLUSvoid);
+extern GLUSboolean _glusWindowSchedulerStep(GLUSfloat time);
 
-extern GLUSfloat _glusWindowGetRecordingTime(GLUSvoid);
+extern GLUSvoid _glusWindowSchedulerShutdown(GLUSvoid);
 
-extern const GLUStgaimage* _glusWindowGetRecordingImageTga(GLUSvoid);
+extern GLUSboolean _glusWindowRunHeadless(GLUSboolean (*init)(GLUSvoid), GLUSvoid (*reshape)(GLUSint width, GLUSint height), GLUSboolean (*update)(GLUSfloat time), GLUSvoid (*terminate)(GLUSvoid), const GLUSint width, const GLUSint height);
 
 static GLFWwindow* g_window = 0;
+static GLUSboolean g_headless = GLUS_FALSE;
 static GLUSboolean g_initdone = GLUS_FALSE;
 static GLUSint g_buttons = 0;
 static GLUSint g_mouseX = 0;
@@ -221,8 +222,32 @@ static GLUSvoid GLUSAPIENTRY glusWindowDebugMessage(GLUSenum source, GLUSenum ty
 	glusLogPrint(GLUS_LOG_DEBUG, "source: 0x%04X type: 0x%04X id: %u severity: 0x%04X '%s'", source, type, id, severity, message);
 }
 
+GLUSboolean GLUSAPIENTRY glusWindowHasContext(GLUSvoid)
+{
+	return g_window != 0;
+}
+
+/**
+ * GLFW can only create a context through a display, so without one the headless mode runs the application without a rendering context.
+ */
+static GLUSboolean glusWindowCreateWithoutContext(const GLUSint width, const GLUSint height)
+{
+	glfwTerminate();
+
+	glusLogPrint(GLUS_LOG_WARNING, "GLFW could not create a hidden window. Running headless without rendering context");
+
+	g_width = width;
+	g_height = height;
+
+	g_headless = GLUS_TRUE;
+
+	return GLUS_TRUE;
+}
+
 GLUSvoid GLUSAPIENTRY glusWindowDestroy(GLUSvoid)
 {
+	g_headless = GLUS_FALSE;
+
 	if (g_window)
 	{
 		glfwMakeContextCurrent(0);
@@ -266,6 +291,11 @@ GLUSboolean GLUSAPIENTRY glusWindowCreate(const GLUSchar* title, const GLUSint w
 
 	if (!glfwInit())
 	{
+		if (glusWindowIsHeadless())
+		{
+			return glusWindowCreateWithoutContext(width, height);
+		}
+
 		glusLogPrint(GLUS_LOG_ERROR, "GLFW could not be initialized");
 
 		return GLUS_FALSE;
@@ -275,6 +305,9 @@ GLUSboolean GLUSAPIENTRY glusWindowCreate(const GLUSchar* title, const GLUSint w
 
 	glfwWindowHint(GLFW_RESIZABLE, !noResize);
 
+	// Without a window, the context still needs one, which is never shown.
+	glfwWindowHint(GLFW_VISIBLE, !glusWindowIsHeadless());
+
 	//
 
 	walker = configAttribList;
@@ -592,9 +625,14 @@ GLUSboolean GLUSAPIENTRY glusWindowCreate(const GLUSchar* title, const GLUSint w
 
 	//
 
-	g_window = glfwCreateWindow(width, height, title, fullscreen ? glfwGetPrimaryMonitor() : 0, 0);
+	g_window = glfwCreateWindow(width, height, title, fullscreen && !glusWindowIsHeadless() ? glfwGetPrimaryMonitor() : 0, 0);
 	if (!g_window)
 	{
+		if (glusWindowIsHeadless())
+		{
+			return glusWindowCreateWithoutContext(width, height);
+		}
+
 		glfwTerminate();
 
 		glusLogPrint(GLUS_LOG_ERROR, "GLFW window could not be opened");
@@ -638,6 +676,8 @@ GLUSboolean GLUSAPIENTRY glusWindowCreate(const GLUSchar* title, const GLUSint w
 
 	glfwGetWindowSize(g_window, &g_width, &g_height);
 
+	g_headless = glusWindowIsHeadless();
+
 	if (debug && glusVersionIsSupported(4, 3))
 	{
 		glusLogSetLevel(GLUS_LOG_DEBUG);
@@ -652,6 +692,15 @@ GLUSboolean GLUSAPIENTRY glusWindowRun(GLUSvoid)
 {
 	GLUSboolean run = GLUS_TRUE;
 
+	if (g_headless)
+	{
+		run = _glusWindowRunHeadless(glusInit, glusReshape, glusUpdate, glusTerminate, g_width, g_height);
+
+		glusWindowDestroy();
+
+		return run;
+	}
+
 	if (!glusWindowStartup())
 	{
 		return GLUS_FALSE;
@@ -679,7 +728,15 @@ GLUSboolean GLUSAPIENTRY glusWindowStartup(GLUSvoid)
 	// Init Engine
 	if (glusInit)
 	{
-		if (!glusInit())
+		GLUSboolean result;
+
+		GLUS_PROFILE_BEGIN("glusInit");
+
+		result = glusInit();
+
+		GLUS_PROFILE_END();
+
+		if (!result)
 		{
 			glusWindowShutdown();
 
@@ -702,18 +759,42 @@ GLUSboolean GLUSAPIENTRY glusWindowLoop(GLUSvoid)
 {
 	if (!glfwWindowShouldClose(g_window))
 	{
+		GLUS_PROFILE_BEGIN("glusWindowLoop");
+
+		// Jobs, which have to run on the main thread e.g. because of OpenGL calls.
+		glusJobRunMainThread();
+
 		if (glusUpdate)
 		{
-			if (!glusUpdate(glusWindowGetElapsedTime()))
+			GLUSfloat time = glusWindowGetElapsedTime();
+
+			if (!_glusWindowSchedulerStep(time))
 			{
 				glfwSetWindowShouldClose(g_window, GLUS_TRUE);
 			}
+
+			GLUS_PROFILE_BEGIN("glusUpdate");
+
+			if (!glusUpdate(time))
+			{
+				glfwSetWindowShouldClose(g_window, GLUS_TRUE);
+			}
+
+			GLUS_PROFILE_END();
 		}
 
+		GLUS_PROFILE_BEGIN("glusWindowSwapBuffers");
+
 		glfwSwapBuffers(g_window); // Swap Buffers
 
+		GLUS_PROFILE_END();
+
 		glfwPollEvents();
 
+		GLUS_PROFILE_END();
+
+		GLUS_PROFILE_FLUSH();
+
 		return GLUS_TRUE;
 	}
 
@@ -724,40 +805,56 @@ GLUSboolean GLUSAPIENTRY glusWindowLoopDoRecording(GLUSvoid)
 {
 	if (!glfwWindowShouldClose(g_window))
 	{
+		GLUS_PROFILE_BEGIN("glusWindowLoop");
+
+		// Jobs, which have to run on the main thread e.g. because of OpenGL calls.
+		glusJobRunMainThread();
+
 		if (glusUpdate)
 		{
+			GLUSfloat time = _glusWindowGetRecordingTime();
+
 			// Still consume and update time, as a fixed recording time is used.
 			glusWindowGetElapsedTime();
 
-			if (!glusUpdate(_glusWindowGetRecordingTime()))
+			if (!_glusWindowSchedulerStep(time))
+			{
+				glfwSetWindowShouldClose(g_window, GLUS_TRUE);
+			}
+
+			GLUS_PROFILE_BEGIN("glusUpdate");
+
+			if (!glusUpdate(time))
 			{
 				glfwSetWindowShouldClose(g_window, GLUS_TRUE);
 			}
 			else
 			{
-				if (_glusWindowGetCurrentRecordingFrame() < _glusWindowGetRecordingFrames())
-				{
-					if (glusScreenshotUseTga(0, 0, _glusWindowGetRecordingImageTga()))
-					{
-						static const GLUSchar* filenameTemplate = "screenshot-%04d.tga";
-						static GLUSchar filename[20];
+				GLUS_PROFILE_END();
 
-						sprintf(filename, filenameTemplate, _glusWindowGetCurrentAndIncreaseRecordingFrame());
+				GLUS_PROFILE_BEGIN("glusWindowRecordFrame");
 
-						glusImageSaveTga(filename, _glusWindowGetRecordingImageTga());
-					}
-				}
-				else
+				if (!_glusWindowRecordFrame())
 				{
 					glfwSetWindowShouldClose(g_window, GLUS_TRUE);
 				}
 			}
+
+			GLUS_PROFILE_END();
 		}
 
+		GLUS_PROFILE_BEGIN("glusWindowSwapBuffers");
+
 		glfwSwapBuffers(g_window); // Swap Buffers
 
+		GLUS_PROFILE_END();
+
 		glfwPollEvents();
 
+		GLUS_PROFILE_END();
+
+		GLUS_PROFILE_FLUSH();
+
 		return GLUS_TRUE;
 	}
 
@@ -766,10 +863,17 @@ GLUSboolean GLUSAPIENTRY glusWindowLoopDoRecording(GLUSvoid)
 
 GLUSvoid GLUSAPIENTRY glusWindowShutdown(GLUSvoid)
 {
+	// Simulation has to be finished, before resources are released
+	_glusWindowSchedulerShutdown();
+
 	// Terminate Game
 	if (glusTerminate)
 	{
+		GLUS_PROFILE_BEGIN("glusTerminate");
+
 		glusTerminate();
+
+		GLUS_PROFILE_END();
 	}
 
 	if (glusWindowIsRecording())
@@ -0,0 +1,220 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+extern GLUSdouble _glusThreadGetRawTime(GLUSvoid);
+
+extern GLUSboolean _glusWindowSchedulerStep(GLUSfloat time);
+
+extern GLUSvoid _glusWindowSchedulerShutdown(GLUSvoid);
+
+static GLUSboolean g_headless = GLUS_FALSE;
+static GLUSint g_numberFrames = 0;
+static GLUSfloat g_timeStep = 0.0f;
+
+static GLUSheadlessstats g_stats = {0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+static int glusWindowHeadlessCompare(const void* first, const void* second)
+{
+	GLUSdouble time0 = *(const GLUSdouble*)first;
+	GLUSdouble time1 = *(const GLUSdouble*)second;
+
+	if (time0 < time1)
+	{
+		return -1;
+	}
+
+	return time0 > time1 ? 1 : 0;
+}
+
+GLUSboolean _glusWindowRunHeadless(GLUSboolean (*init)(GLUSvoid), GLUSvoid (*reshape)(GLUSint width, GLUSint height), GLUSboolean (*update)(GLUSfloat time), GLUSvoid (*terminate)(GLUSvoid), const GLUSint width, const GLUSint height)
+{
+	GLUSdouble* frameTimes = 0;
+	GLUSint maxFrames = 0;
+
+	GLUSdouble startTime, frameTime;
+
+	GLUSfloat time = 0.0f;
+
+	GLUSboolean run = GLUS_TRUE;
+
+	memset(&g_stats, 0, sizeof(g_stats));
+
+	startTime = _glusThreadGetRawTime();
+
+	if (init)
+	{
+		GLUS_PROFILE_BEGIN("glusInit");
+
+		run = init();
+
+		GLUS_PROFILE_END();
+	}
+
+	g_stats.initTime = _glusThreadGetRawTime() - startTime;
+
+	if (!run)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (reshape)
+	{
+		reshape(width, height);
+	}
+
+	maxFrames = g_numberFrames > 0 ? g_numberFrames : 1024;
+
+	frameTimes = (GLUSdouble*)glusMemoryMalloc(maxFrames * sizeof(GLUSdouble));
+
+	while (run && update && (g_numberFrames <= 0 || g_stats.frames < g_numberFrames))
+	{
+		GLUS_PROFILE_BEGIN("glusWindowLoop");
+
+		startTime = _glusThreadGetRawTime();
+
+		// Jobs, which have to run on the main thread e.g. because of OpenGL calls.
+		glusJobRunMainThread();
+
+		// A fixed time step makes every run pass the same times, otherwise the measured time of the last frame is passed.
+		if (g_timeStep > 0.0f)
+		{
+			time = g_timeStep;
+		}
+
+		run = _glusWindowSchedulerStep(time);
+
+		GLUS_PROFILE_BEGIN("glusUpdate");
+
+		run = update(time) && run;
+
+		GLUS_PROFILE_END();
+
+		frameTime = _glusThreadGetRawTime() - startTime;
+
+		GLUS_PROFILE_END();
+
+		GLUS_PROFILE_FLUSH();
+
+		time = (GLUSfloat)frameTime;
+
+		// Without memory for all frame times, only the percentile is missing.
+		if (frameTimes && g_stats.frames == maxFrames)
+		{
+			GLUSdouble* newFrameTimes;
+
+			maxFrames *= 2;
+
+			newFrameTimes = (GLUSdouble*)glusMemoryMalloc(maxFrames * sizeof(GLUSdouble));
+
+			if (newFrameTimes)
+			{
+				memcpy(newFrameTimes, frameTimes, g_stats.frames * sizeof(GLUSdouble));
+			}
+
+			glusMemoryFree(frameTimes);
+
+			frameTimes = newFrameTimes;
+		}
+
+		if (frameTimes)
+		{
+			frameTimes[g_stats.frames] = frameTime;
+		}
+
+		if (g_stats.frames == 0 || frameTime < g_stats.minimumFrameTime)
+		{
+			g_stats.minimumFrameTime = frameTime;
+		}
+
+		if (frameTime > g_stats.maximumFrameTime)
+		{
+			g_stats.maximumFrameTime = frameTime;
+		}
+
+		g_stats.totalFrameTime += frameTime;
+
+		g_stats.frames++;
+	}
+
+	if (g_stats.frames > 0)
+	{
+		g_stats.averageFrameTime = g_stats.totalFrameTime / (GLUSdouble)g_stats.frames;
+
+		if (frameTimes)
+		{
+			qsort(frameTimes, g_stats.frames, sizeof(GLUSdouble), glusWindowHeadlessCompare);
+
+			// Nearest rank.
+			g_stats.percentile99FrameTime = frameTimes[(g_stats.frames * 99 + 99) / 100 - 1];
+		}
+	}
+
+	glusMemoryFree(frameTimes);
+
+	// Simulation has to be finished, before resources are released.
+	_glusWindowSchedulerShutdown();
+
+	startTime = _glusThreadGetRawTime();
+
+	if (terminate)
+	{
+		GLUS_PROFILE_BEGIN("glusTerminate");
+
+		terminate();
+
+		GLUS_PROFILE_END();
+	}
+
+	g_stats.terminateTime = _glusThreadGetRawTime() - startTime;
+
+	glusLogPrint(GLUS_LOG_INFO, "Headless: %d frames, init %.3f ms, frame min %.3f ms, avg %.3f ms, p99 %.3f ms, max %.3f ms, terminate %.3f ms", g_stats.frames, g_stats.initTime * 1000.0, g_stats.minimumFrameTime * 1000.0, g_stats.averageFrameTime * 1000.0, g_stats.percentile99FrameTime * 1000.0, g_stats.maximumFrameTime * 1000.0, g_stats.terminateTime * 1000.0);
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusWindowSetHeadless(const GLUSboolean headless, const GLUSint numberFrames, const GLUSfloat timeStep)
+{
+	if (timeStep < 0.0f)
+	{
+		return GLUS_FALSE;
+	}
+
+	g_headless = headless;
+	g_numberFrames = numberFrames;
+	g_timeStep = timeStep;
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusWindowIsHeadless(GLUSvoid)
+{
+	return g_headless;
+}
+
+GLUSboolean GLUSAPIENTRY glusWindowGetHeadlessStats(GLUSheadlessstats* stats)
+{
+	if (!stats)
+	{
+		return GLUS_FALSE;
+	}
+
+	*stats = g_stats;
+
+	return GLUS_TRUE;
+}
@@ -17,71 +17,850 @@
 
 #include "GL/glus.h"
 
-#define GLUS_MAX_FRAMES 10000
-#define GLUS_MAX_FRAMES_PER_SECOND 120
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+
+#define popen _popen
+#define pclose _pclose
+#endif
+
+#define GLUS_RECORDING_SLOT_FREE		0
+#define GLUS_RECORDING_SLOT_CAPTURED	1
+#define GLUS_RECORDING_SLOT_ENCODING	2
+#define GLUS_RECORDING_SLOT_ENCODED		3
+
+extern GLUSdouble _glusThreadGetRawTime(GLUSvoid);
+
+extern GLUSboolean _glusImageSaveTgaRle(const GLUSchar* filename, const GLUStgaimage* tgaimage);
+
+/**
+ * One capture buffer of the ring.
+ */
+typedef struct _GLUSrecordingslot
+{
+	GLUStgaimage image;
+
+	/**
+	 * Encoded frame of a stream sink.
+	 */
+	GLUSubyte* encoded;
+
+	size_t encodedLength;
+
+	/**
+	 * Number of the window frame.
+	 */
+	GLUSint frame;
+
+	/**
+	 * Position in the output order. Dropped frames do not get a sequence number.
+	 */
+	GLUSint sequence;
+
+	GLUSint state;
+
+	GLUSboolean result;
+
+} GLUSrecordingslot;
+
+static GLUSboolean g_recording = GLUS_FALSE;
 
 static GLUSint g_currentFrame = 0;
 static GLUSint g_numberFrames = 0;
 static GLUSfloat g_recordingTime = 0.0f;
 
-static GLUStgaimage g_tgaimage = {0, 0, 0, 0, 0};
+static GLUSrecordingsink g_sink;
+static GLUSchar g_filename[GLUS_MAX_FILENAME];
+
+static FILE* g_stream = 0;
+static GLUSboolean g_streamPipe = GLUS_FALSE;
+
+static GLUSrecordingslot* g_slots = 0;
+static GLUSint g_numberSlots = 0;
+
+static GLUSthread* g_threads = 0;
+static GLUSint g_numberThreads = 0;
+
+static GLUSmutex g_mutex;
+static GLUScondition g_capturedCondition;
+static GLUScondition g_freeCondition;
+
+// All following variables are protected by the mutex, as soon as threads are running.
+
+static GLUSboolean g_quit = GLUS_FALSE;
 
-GLUSint _glusWindowGetCurrentRecordingFrame(GLUSvoid)
+static GLUSint g_nextCaptureSequence = 0;
+static GLUSint g_nextWriteSequence = 0;
+
+static GLUSboolean g_writing = GLUS_FALSE;
+
+// Set after a frame of an ordered sink failed. Following frames would break the stream, so the recording stops.
+static GLUSboolean g_failed = GLUS_FALSE;
+
+static GLUSrecordingstats g_stats = {0, 0, 0, 0, 0, 0, 0.0};
+
+GLUSfloat _glusWindowGetRecordingTime(GLUSvoid)
 {
-	return g_currentFrame;
+	return g_recordingTime;
 }
 
-GLUSint _glusWindowGetCurrentAndIncreaseRecordingFrame(GLUSvoid)
+static GLUSboolean glusWindowRecordingIsOrdered(GLUSvoid)
 {
-	return g_currentFrame++;
+	return g_sink.type != GLUS_RECORDING_TGA && g_sink.type != GLUS_RECORDING_TGA_RLE;
 }
 
-GLUSint _glusWindowGetRecordingFrames(GLUSvoid)
+/**
+ * Checks, that the file name pattern contains exactly one integer conversion for the frame number.
+ * A percent sign itself has to be written as "%%".
+ */
+static GLUSboolean glusWindowRecordingCheckPattern(const GLUSchar* pattern)
 {
-	return g_numberFrames;
+	GLUSint conversions = 0;
+
+	while (*pattern)
+	{
+		if (*pattern++ != '%')
+		{
+			continue;
+		}
+
+		if (*pattern == '%')
+		{
+			pattern++;
+
+			continue;
+		}
+
+		while (*pattern == '0' || *pattern == '-' || *pattern == '+' || *pattern == ' ')
+		{
+			pattern++;
+		}
+
+		while (*pattern >= '0' && *pattern <= '9')
+		{
+			pattern++;
+		}
+
+		if (*pattern != 'd' && *pattern != 'i')
+		{
+			return GLUS_FALSE;
+		}
+
+		pattern++;
+
+		conversions++;
+	}
+
+	return conversions == 1;
 }
 
-GLUSfloat _glusWindowGetRecordingTime(GLUSvoid)
+static GLUSvoid glusWindowRecordingEncodeY4m(GLUSrecordingslot* slot)
 {
-	return g_recordingTime;
+	GLUSint width = slot->image.width;
+	GLUSint height = slot->image.height;
+	size_t planeSize = (size_t)width * height;
+
+	GLUSubyte* y = slot->encoded + 6;
+	GLUSubyte* u = y + planeSize;
+	GLUSubyte* v = u + planeSize;
+
+	const GLUSubyte* pixel;
+	GLUSint r, g, b, row, column;
+
+	memcpy(slot->encoded, "FRAME\n", 6);
+
+	// BT.601 with limited range. The window content is bottom up, the stream top down.
+	for (row = height - 1; row >= 0; row--)
+	{
+		pixel = &slot->image.data[(size_t)row * width * 4];
+
+		for (column = 0; column < width; column++)
+		{
+			r = pixel[0];
+			g = pixel[1];
+			b = pixel[2];
+
+			*y++ = (GLUSubyte)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+			*u++ = (GLUSubyte)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+			*v++ = (GLUSubyte)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+
+			pixel += 4;
+		}
+	}
+
+	slot->encodedLength = 6 + 3 * planeSize;
 }
 
-const GLUStgaimage* _glusWindowGetRecordingImageTga(GLUSvoid)
+static GLUSvoid glusWindowRecordingEncodeRgb(GLUSrecordingslot* slot)
 {
-	return &g_tgaimage;
+	GLUSint width = slot->image.width;
+	GLUSint height = slot->image.height;
+
+	GLUSubyte* target = slot->encoded;
+
+	const GLUSubyte* pixel;
+	GLUSint row, column;
+
+	for (row = height - 1; row >= 0; row--)
+	{
+		pixel = &slot->image.data[(size_t)row * width * 4];
+
+		for (column = 0; column < width; column++)
+		{
+			*target++ = pixel[0];
+			*target++ = pixel[1];
+			*target++ = pixel[2];
+
+			pixel += 4;
+		}
+	}
+
+	slot->encodedLength = (size_t)width * height * 3;
 }
 
-GLUSboolean GLUSAPIENTRY glusWindowStartRecording(GLUSint numberFrames, GLUSint framesPerSecond)
+/**
+ * Runs without holding the mutex. Files are written directly, streams are only encoded.
+ */
+static GLUSvoid glusWindowRecordingEncode(GLUSrecordingslot* slot)
+{
+	GLUSchar filename[GLUS_MAX_FILENAME];
+
+	GLUSint length;
+
+	switch (g_sink.type)
+	{
+		case GLUS_RECORDING_TGA:
+		case GLUS_RECORDING_TGA_RLE:
+			// The pattern has been checked, so it only contains the conversion for the frame number.
+			length = snprintf(filename, GLUS_MAX_FILENAME, g_filename, slot->frame);
+
+			if (length < 0 || length >= GLUS_MAX_FILENAME)
+			{
+				slot->result = GLUS_FALSE;
+			}
+			else if (g_sink.type == GLUS_RECORDING_TGA)
+			{
+				slot->result = glusImageSaveTga(filename, &slot->image);
+			}
+			else
+			{
+				slot->result = _glusImageSaveTgaRle(filename, &slot->image);
+			}
+			break;
+		case GLUS_RECORDING_Y4M:
+			glusWindowRecordingEncodeY4m(slot);
+
+			slot->result = GLUS_TRUE;
+			break;
+		case GLUS_RECORDING_RGB:
+			glusWindowRecordingEncodeRgb(slot);
+
+			slot->result = GLUS_TRUE;
+			break;
+		default:
+			slot->result = GLUS_TRUE;
+			break;
+	}
+}
+
+/**
+ * Runs without holding the mutex, but only by one thread at a time.
+ */
+static GLUSvoid glusWindowRecordingWrite(GLUSrecordingslot* slot)
+{
+	if (!slot->result)
+	{
+		return;
+	}
+
+	if (g_sink.type == GLUS_RECORDING_CUSTOM)
+	{
+		slot->result = g_sink.write(&slot->image, slot->frame, g_sink.userData);
+
+		return;
+	}
+
+	if (g_stream && fwrite(slot->encoded, 1, slot->encodedLength, g_stream) == slot->encodedLength)
+	{
+		return;
+	}
+
+	slot->result = GLUS_FALSE;
+}
+
+static GLUSvoid glusWindowRecordingFinish(GLUSrecordingslot* slot)
+{
+	if (slot->result)
+	{
+		g_stats.writtenFrames++;
+	}
+	else
+	{
+		if (g_stats.failedFrames == 0)
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Could not write recorded frame %d to '%s'", slot->frame, g_filename);
+		}
+
+		g_stats.failedFrames++;
+	}
+
+	g_stats.queuedFrames--;
+
+	slot->state = GLUS_RECORDING_SLOT_FREE;
+
+	glusConditionBroadcast(&g_freeCondition);
+}
+
+static GLUSrecordingslot* glusWindowRecordingFindSlot(GLUSint state, GLUSint sequence)
+{
+	GLUSrecordingslot* found = 0;
+
+	GLUSint i;
+
+	for (i = 0; i < g_numberSlots; i++)
+	{
+		if (g_slots[i].state != state)
+		{
+			continue;
+		}
+
+		if (sequence >= 0)
+		{
+			if (g_slots[i].sequence == sequence)
+			{
+				return &g_slots[i];
+			}
+		}
+		else if (!found || g_slots[i].sequence < found->sequence)
+		{
+			found = &g_slots[i];
+		}
+	}
+
+	return found;
+}
+
+/**
+ * Encodes captured frames, oldest first. Called with the mutex locked. If wait is set, returns after the recording is stopped, otherwise as soon as no captured frame is left.
+ */
+static GLUSvoid glusWindowRecordingProcess(GLUSboolean wait)
+{
+	GLUSrecordingslot* slot;
+
+	for (;;)
+	{
+		slot = glusWindowRecordingFindSlot(GLUS_RECORDING_SLOT_CAPTURED, -1);
+
+		if (!slot)
+		{
+			if (!wait || g_quit)
+			{
+				return;
+			}
+
+			glusConditionWait(&g_capturedCondition, &g_mutex);
+
+			continue;
+		}
+
+		slot->state = GLUS_RECORDING_SLOT_ENCODING;
+
+		glusMutexUnlock(&g_mutex);
+
+		glusWindowRecordingEncode(slot);
+
+		glusMutexLock(&g_mutex);
+
+		if (!glusWindowRecordingIsOrdered())
+		{
+			// Files are independent, so they are finished in any order.
+
+			glusWindowRecordingFinish(slot);
+
+			continue;
+		}
+
+		slot->state = GLUS_RECORDING_SLOT_ENCODED;
+
+		if (g_writing)
+		{
+			// The writing thread picks up this frame, when it is next.
+
+			continue;
+		}
+
+		g_writing = GLUS_TRUE;
+
+		while ((slot = glusWindowRecordingFindSlot(GLUS_RECORDING_SLOT_ENCODED, g_nextWriteSequence)) != 0)
+		{
+			if (g_failed)
+			{
+				slot->result = GLUS_FALSE;
+			}
+			else
+			{
+				glusMutexUnlock(&g_mutex);
+
+				glusWindowRecordingWrite(slot);
+
+				glusMutexLock(&g_mutex);
+			}
+
+			if (!slot->result)
+			{
+				g_failed = GLUS_TRUE;
+			}
+
+			g_nextWriteSequence++;
+
+			glusWindowRecordingFinish(slot);
+		}
+
+		g_writing = GLUS_FALSE;
+	}
+}
+
+static GLUSvoid glusWindowRecordingRun(GLUSvoid* argument)
+{
+	(void)argument;
+
+	glusMutexLock(&g_mutex);
+
+	glusWindowRecordingProcess(GLUS_TRUE);
+
+	glusMutexUnlock(&g_mutex);
+}
+
+static GLUSboolean glusWindowRecordingOpenStream(GLUSint width, GLUSint height, GLUSint framesPerSecond)
+{
+	if (strcmp(g_filename, "-") == 0)
+	{
+#ifdef _WIN32
+		_setmode(_fileno(stdout), _O_BINARY);
+#endif
+		g_stream = stdout;
+	}
+	else if (g_filename[0] == '|')
+	{
+		g_stream = popen(&g_filename[1], "w");
+
+		g_streamPipe = GLUS_TRUE;
+	}
+	else
+	{
+		g_stream = glusFileOpen(g_filename, "wb");
+	}
+
+	if (!g_stream)
+	{
+		glusLogPrint(GLUS_LOG_ERROR, "Could not open recording stream '%s'", g_filename);
+
+		return GLUS_FALSE;
+	}
+
+	if (g_sink.type == GLUS_RECORDING_Y4M)
+	{
+		if (fprintf(g_stream, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", width, height, framesPerSecond) < 0)
+		{
+			glusLogPrint(GLUS_LOG_ERROR, "Could not write recording stream '%s'", g_filename);
+
+			return GLUS_FALSE;
+		}
+	}
+
+	return GLUS_TRUE;
+}
+
+static GLUSvoid glusWindowRecordingCloseStream(GLUSvoid)
+{
+	if (!g_stream)
+	{
+		return;
+	}
+
+	if (g_streamPipe)
+	{
+		pclose(g_stream);
+	}
+	else if (g_stream == stdout)
+	{
+		fflush(g_stream);
+	}
+	else
+	{
+		glusFileClose(g_stream);
+	}
+
+	g_stream = 0;
+	g_streamPipe = GLUS_FALSE;
+}
+
+static GLUSvoid glusWindowRecordingDestroy(GLUSvoid)
+{
+	GLUSint i;
+
+	if (g_threads)
+	{
+		glusMutexLock(&g_mutex);
+
+		g_quit = GLUS_TRUE;
+
+		glusConditionBroadcast(&g_capturedCondition);
+
+		glusMutexUnlock(&g_mutex);
+
+		for (i = 0; i < g_numberThreads; i++)
+		{
+			glusThreadJoin(&g_threads[i]);
+		}
+
+		glusMemoryFree(g_threads);
+
+		g_threads = 0;
+	}
+
+	g_numberThreads = 0;
+
+	if (g_slots)
+	{
+		for (i = 0; i < g_numberSlots; i++)
+		{
+			glusImageDestroyTga(&g_slots[i].image);
+
+			glusMemoryFree(g_slots[i].encoded);
+		}
+
+		glusMemoryFree(g_slots);
+
+		g_slots = 0;
+
+		glusConditionDestroy(&g_freeCondition);
+		glusConditionDestroy(&g_capturedCondition);
+		glusMutexDestroy(&g_mutex);
+	}
+
+	g_numberSlots = 0;
+
+	glusWindowRecordingCloseStream();
+
+	g_stats.queuedFrames = 0;
+}
+
+GLUSboolean _glusWindowRecordFrame(GLUSvoid)
+{
+	GLUSrecordingslot* slot;
+
+	GLUSdouble startTime;
+
+	GLUSboolean result;
+
+	if (!g_recording || g_currentFrame >= g_numberFrames)
+	{
+		return GLUS_FALSE;
+	}
+
+	startTime = _glusThreadGetRawTime();
+
+	glusMutexLock(&g_mutex);
+
+	if (g_failed)
+	{
+		glusMutexUnlock(&g_mutex);
+
+		glusLogPrint(GLUS_LOG_ERROR, "Recording stopped after a failed frame");
+
+		return GLUS_FALSE;
+	}
+
+	// Only this thread takes free slots, so the found slot stays free after unlocking.
+
+	while ((slot = glusWindowRecordingFindSlot(GLUS_RECORDING_SLOT_FREE, -1)) == 0 && !g_sink.dropFrames)
+	{
+		glusConditionWait(&g_freeCondition, &g_mutex);
+	}
+
+	glusMutexUnlock(&g_mutex);
+
+	result = slot && glusScreenshotUseTga(0, 0, &slot->image);
+
+	glusMutexLock(&g_mutex);
+
+	if (!slot)
+	{
+		g_stats.droppedFrames++;
+	}
+	else if (!result)
+	{
+		g_stats.failedFrames++;
+	}
+	else
+	{
+		slot->frame = g_currentFrame;
+		slot->sequence = g_nextCaptureSequence++;
+		slot->state = GLUS_RECORDING_SLOT_CAPTURED;
+
+		g_stats.capturedFrames++;
+		g_stats.queuedFrames++;
+
+		if (g_stats.queuedFrames > g_stats.maxQueuedFrames)
+		{
+			g_stats.maxQueuedFrames = g_stats.queuedFrames;
+		}
+
+		glusConditionSignal(&g_capturedCondition);
+	}
+
+	if (!g_threads)
+	{
+		glusWindowRecordingProcess(GLUS_FALSE);
+	}
+
+	g_stats.captureTime += _glusThreadGetRawTime() - startTime;
+
+	glusMutexUnlock(&g_mutex);
+
+	g_currentFrame++;
+
+	return GLUS_TRUE;
+}
+
+GLUSboolean GLUSAPIENTRY glusWindowStartRecordingSink(const GLUSrecordingsink* sink, GLUSint numberFrames, GLUSint framesPerSecond)
 {
+	GLUSint width, height, numberThreads, numberSlots, i;
+
+	size_t encodedLength = 0;
+
 	glusWindowStopRecording();
 
-	if (numberFrames < 1 || numberFrames > GLUS_MAX_FRAMES || framesPerSecond < 1 || framesPerSecond > GLUS_MAX_FRAMES_PER_SECOND)
+	if (!sink || numberFrames < 1 || framesPerSecond < 1)
+	{
+		return GLUS_FALSE;
+	}
+
+	switch (sink->type)
+	{
+		case GLUS_RECORDING_TGA:
+		case GLUS_RECORDING_TGA_RLE:
+			if (!sink->filename || !glusWindowRecordingCheckPattern(sink->filename))
+			{
+				glusLogPrint(GLUS_LOG_ERROR, "Recording file name has to contain exactly one integer conversion like %%04d");
+
+				return GLUS_FALSE;
+			}
+			// The file name template has to leave room for the frame number.
+			if (strlen(sink->filename) + 16 > GLUS_MAX_FILENAME)
+			{
+				return GLUS_FALSE;
+			}
+			break;
+		case GLUS_RECORDING_Y4M:
+		case GLUS_RECORDING_RGB:
+			if (!sink->filename || strlen(sink->filename) + 16 > GLUS_MAX_FILENAME)
+			{
+				return GLUS_FALSE;
+			}
+			break;
+		case GLUS_RECORDING_CUSTOM:
+			if (!sink->write)
+			{
+				return GLUS_FALSE;
+			}
+			break;
+		default:
+			return GLUS_FALSE;
+	}
+
+	width = glusWindowGetWidth();
+	height = glusWindowGetHeight();
+
+	if (width < 1 || height < 1)
 	{
 		return GLUS_FALSE;
 	}
 
-	if (!glusImageCreateTga(&g_tgaimage, glusWindowGetWidth(), glusWindowGetHeight(), 1, GLUS_RGBA))
+	g_sink = *sink;
+
+	g_filename[0] = '\0';
+	if (sink->filename)
+	{
+		strcpy(g_filename, sink->filename);
+	}
+	g_sink.filename = g_filename;
+
+	if (sink->type == GLUS_RECORDING_Y4M)
+	{
+		encodedLength = 6 + (size_t)width * height * 3;
+	}
+	else if (sink->type == GLUS_RECORDING_RGB)
+	{
+		encodedLength = (size_t)width * height * 3;
+	}
+
+	// The window loop itself is busy, so leave one processor to it.
+	numberThreads = sink->numberThreads > 0 ? sink->numberThreads : glusThreadGetNumberProcessors() - 1;
+	if (numberThreads < 1)
+	{
+		numberThreads = 1;
+	}
+
+	numberSlots = sink->numberBuffers > 0 ? sink->numberBuffers : numberThreads + 2;
+
+	memset(&g_stats, 0, sizeof(g_stats));
+
+	g_quit = GLUS_FALSE;
+	g_writing = GLUS_FALSE;
+	g_failed = GLUS_FALSE;
+	g_nextCaptureSequence = 0;
+	g_nextWriteSequence = 0;
+
+	if (!glusMutexCreate(&g_mutex))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!glusConditionCreate(&g_capturedCondition))
+	{
+		glusMutexDestroy(&g_mutex);
+
+		return GLUS_FALSE;
+	}
+
+	if (!glusConditionCreate(&g_freeCondition))
+	{
+		glusConditionDestroy(&g_capturedCondition);
+		glusMutexDestroy(&g_mutex);
+
+		return GLUS_FALSE;
+	}
+
+	g_slots = (GLUSrecordingslot*)glusMemoryMalloc(numberSlots * sizeof(GLUSrecordingslot));
+
+	if (!g_slots)
+	{
+		glusConditionDestroy(&g_freeCondition);
+		glusConditionDestroy(&g_capturedCondition);
+		glusMutexDestroy(&g_mutex);
+
+		return GLUS_FALSE;
+	}
+
+	memset(g_slots, 0, numberSlots * sizeof(GLUSrecordingslot));
+
+	g_numberSlots = numberSlots;
+
+	for (i = 0; i < numberSlots; i++)
+	{
+		if (!glusImageCreateTga(&g_slots[i].image, width, height, 1, GLUS_RGBA))
+		{
+			glusWindowRecordingDestroy();
+
+			return GLUS_FALSE;
+		}
+
+		if (encodedLength > 0)
+		{
+			g_slots[i].encoded = (GLUSubyte*)glusMemoryMalloc(encodedLength);
+
+			if (!g_slots[i].encoded)
+			{
+				glusWindowRecordingDestroy();
+
+				return GLUS_FALSE;
+			}
+		}
+	}
+
+	if (encodedLength > 0 && !glusWindowRecordingOpenStream(width, height, framesPerSecond))
 	{
+		glusWindowRecordingDestroy();
+
 		return GLUS_FALSE;
 	}
 
+	g_threads = (GLUSthread*)glusMemoryMalloc(numberThreads * sizeof(GLUSthread));
+
+	if (g_threads)
+	{
+		for (i = 0; i < numberThreads; i++)
+		{
+			if (!glusThreadCreate(&g_threads[i], glusWindowRecordingRun, 0))
+			{
+				break;
+			}
+		}
+
+		g_numberThreads = i;
+
+		// If no thread could be started, the frames are encoded by the window loop.
+		if (g_numberThreads == 0)
+		{
+			glusMemoryFree(g_threads);
+
+			g_threads = 0;
+		}
+	}
+
+	g_currentFrame = 0;
 	g_numberFrames = numberFrames;
 
 	g_recordingTime = 1.0f / (GLUSfloat)framesPerSecond;
 
+	g_recording = GLUS_TRUE;
+
 	return GLUS_TRUE;
 }
 
+GLUSboolean GLUSAPIENTRY glusWindowStartRecording(GLUSint numberFrames, GLUSint framesPerSecond)
+{
+	GLUSrecordingsink sink;
+
+	memset(&sink, 0, sizeof(sink));
+
+	sink.type = GLUS_RECORDING_TGA;
+	sink.filename = "screenshot-%04d.tga";
+
+	return glusWindowStartRecordingSink(&sink, numberFrames, framesPerSecond);
+}
+
 GLUSboolean GLUSAPIENTRY glusWindowIsRecording(GLUSvoid)
 {
-	return g_tgaimage.data != 0;
+	return g_recording;
 }
 
 GLUSvoid GLUSAPIENTRY glusWindowStopRecording(GLUSvoid)
 {
+	if (g_recording)
+	{
+		glusWindowRecordingDestroy();
+	}
+
+	g_recording = GLUS_FALSE;
+
 	g_currentFrame = 0;
 	g_numberFrames = 0;
 	g_recordingTime = 0.0f;
+}
+
+GLUSboolean GLUSAPIENTRY glusWindowGetRecordingStats(GLUSrecordingstats* stats)
+{
+	if (!stats)
+	{
+		return GLUS_FALSE;
+	}
+
+	if (g_slots)
+	{
+		glusMutexLock(&g_mutex);
+
+		*stats = g_stats;
 
-	glusImageDestroyTga(&g_tgaimage);
+		glusMutexUnlock(&g_mutex);
+	}
+	else
+	{
+		*stats = g_stats;
+	}
+
+	return GLUS_TRUE;
 }
@@ -0,0 +1,329 @@
+/*
+ * GLUS - Modern OpenGL, OpenGL ES and OpenVG Utilities. Copyright (C) since 2010 Norbert Nopper
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GL/glus.h"
+
+#define GLUS_DEFAULT_MAX_STEPS 8
+
+static GLUSboolean (*glusSimulate)(const GLUSfloat time) = 0;
+
+static GLUSvoid (*glusPublish)(GLUSvoid) = 0;
+
+static GLUSfloat g_timeStep = 0.0f;
+static GLUSint g_maxSteps = 0;
+static GLUSboolean g_threaded = GLUS_FALSE;
+
+static GLUSdouble g_accumulator = 0.0;
+static GLUSfloat g_interpolation = 1.0f;
+static GLUSfloat g_pendingInterpolation = 0.0f;
+static GLUSint g_droppedSteps = 0;
+
+static GLUSboolean g_threadRunning = GLUS_FALSE;
+static GLUSthread g_thread;
+static GLUSmutex g_mutex;
+static GLUScondition g_condition;
+
+// All following variables are protected by the mutex, as soon as the thread is running.
+
+static GLUSint g_pendingSteps = 0;
+static GLUSboolean g_simulating = GLUS_FALSE;
+static GLUSboolean g_quit = GLUS_FALSE;
+static GLUSboolean g_result = GLUS_TRUE;
+
+static GLUSboolean glusWindowSchedulerSimulate(GLUSint steps)
+{
+	GLUSboolean result = GLUS_TRUE;
+
+	if (steps == 0)
+	{
+		return GLUS_TRUE;
+	}
+
+	GLUS_PROFILE_BEGIN("glusSimulate");
+
+	while (steps > 0 && result)
+	{
+		result = glusSimulate(g_timeStep);
+
+		steps--;
+	}
+
+	GLUS_PROFILE_END();
+
+	return result;
+}
+
+static GLUSvoid glusWindowSchedulerRun(GLUSvoid* argument)
+{
+	GLUSint steps;
+
+	GLUSboolean result;
+
+	(void)argument;
+
+	glusMutexLock(&g_mutex);
+
+	for (;;)
+	{
+		while (g_pendingSteps == 0 && !g_quit)
+		{
+			glusConditionWait(&g_condition, &g_mutex);
+		}
+
+		if (g_pendingSteps == 0)
+		{
+			break;
+		}
+
+		steps = g_pendingSteps;
+
+		g_pendingSteps = 0;
+		g_simulating = GLUS_TRUE;
+
+		glusMutexUnlock(&g_mutex);
+
+		result = glusWindowSchedulerSimulate(steps);
+
+		glusMutexLock(&g_mutex);
+
+		g_simulating = GLUS_FALSE;
+
+		if (!result)
+		{
+			g_result = GLUS_FALSE;
+		}
+
+		glusConditionBroadcast(&g_condition);
+	}
+
+	glusMutexUnlock(&g_mutex);
+}
+
+static GLUSboolean glusWindowSchedulerWait(GLUSvoid)
+{
+	GLUSboolean result;
+
+	glusMutexLock(&g_mutex);
+
+	while (g_pendingSteps > 0 || g_simulating)
+	{
+		glusConditionWait(&g_condition, &g_mutex);
+	}
+
+	result = g_result;
+
+	glusMutexUnlock(&g_mutex);
+
+	return result;
+}
+
+static GLUSvoid glusWindowSchedulerPost(GLUSint steps)
+{
+	glusMutexLock(&g_mutex);
+
+	g_pendingSteps = steps;
+
+	glusConditionBroadcast(&g_condition);
+
+	glusMutexUnlock(&g_mutex);
+}
+
+static GLUSboolean glusWindowSchedulerStartThread(GLUSvoid)
+{
+	if (!glusMutexCreate(&g_mutex))
+	{
+		return GLUS_FALSE;
+	}
+
+	if (!glusConditionCreate(&g_condition))
+	{
+		glusMutexDestroy(&g_mutex);
+
+		return GLUS_FALSE;
+	}
+
+	g_pendingSteps = 0;
+	g_simulating = GLUS_FALSE;
+	g_quit = GLUS_FALSE;
+	g_result = GLUS_TRUE;
+
+	if (!glusThreadCreate(&g_thread, glusWindowSchedulerRun, 0))
+	{
+		glusConditionDestroy(&g_condition);
+		glusMutexDestroy(&g_mutex);
+
+		return GLUS_FALSE;
+	}
+
+	g_threadRunning = GLUS_TRUE;
+
+	return GLUS_TRUE;
+}
+
+/**
+ * Waits for the running simulation steps and stops the simulation thread.
+ */
+GLUSvoid _glusWindowSchedulerShutdown(GLUSvoid)
+{
+	if (!g_threadRunning)
+	{
+		return;
+	}
+
+	glusMutexLock(&g_mutex);
+
+	g_quit = GLUS_TRUE;
+
+	glusConditionBroadcast(&g_condition);
+
+	glusMutexUnlock(&g_mutex);
+
+	glusThreadJoin(&g_thread);
+
+	glusConditionDestroy(&g_condition);
+	glusMutexDestroy(&g_mutex);
+
+	g_threadRunning = GLUS_FALSE;
+}
+
+/**
+ * Called once per frame before the update function.
+ *
+ * @param time The time passed since the last frame.
+ *
+ * @return GLUS_FALSE, if the simulate function requested to stop.
+ */
+GLUSboolean _glusWindowSchedulerStep(GLUSfloat time)
+{
+	GLUSint steps;
+
+	GLUSfloat interpolation;
+
+	GLUSboolean result;
+
+	if (g_timeStep <= 0.0f)
+	{
+		return GLUS_TRUE;
+	}
+
+	g_accumulator += (GLUSdouble)time;
+
+	steps = (GLUSint)(g_accumulator / (GLUSdouble)g_timeStep);
+
+	g_accumulator -= (GLUSdouble)steps * (GLUSdouble)g_timeStep;
+
+	// If a frame takes longer than the steps, the time is dropped, so the simulation does not fall further behind.
+	if (steps > g_maxSteps)
+	{
+		g_droppedSteps += steps - g_maxSteps;
+
+		steps = g_maxSteps;
+	}
+
+	interpolation = (GLUSfloat)(g_accumulator / (GLUSdouble)g_timeStep);
+
+	if (!glusSimulate)
+	{
+		g_interpolation = interpolation;
+
+		return GLUS_TRUE;
+	}
+
+	if (g_threaded && !g_threadRunning && !glusWindowSchedulerStartThread())
+	{
+		glusLogPrint(GLUS_LOG_WARNING, "Could not start simulation thread");
+
+		g_threaded = GLUS_FALSE;
+	}
+
+	if (!g_threaded)
+	{
+		g_interpolation = interpolation;
+
+		return glusWindowSchedulerSimulate(steps);
+	}
+
+	// Steps of the last frame have to be done, before the state is published or new steps are started.
+
+	result = glusWindowSchedulerWait();
+
+	if (!glusPublish)
+	{
+		// Without a snapshot, the state may not be rendered while it is simulated.
+
+		glusWindowSchedulerPost(steps);
+
+		g_interpolation = interpolation;
+
+		return glusWindowSchedulerWait();
+	}
+
+	// The simulation thread is idle, so the finished steps can be copied to the render state.
+	glusPublish();
+
+	// The update function renders the published state, so the interpolation has to be the one of these steps.
+	g_interpolation = g_pendingInterpolation;
+	g_pendingInterpolation = interpolation;
+
+	if (result)
+	{
+		glusWindowSchedulerPost(steps);
+	}
+
+	return result;
+}
+
+GLUSvoid GLUSAPIENTRY glusWindowSetSimulateFunc(GLUSboolean(*glusNewSimulate)(const GLUSfloat time))
+{
+	glusSimulate = glusNewSimulate;
+}
+
+GLUSvoid GLUSAPIENTRY glusWindowSetSimulatePublishFunc(GLUSvoid(*glusNewPublish)(GLUSvoid))
+{
+	glusPublish = glusNewPublish;
+}
+
+GLUSboolean GLUSAPIENTRY glusWindowSetFixedTimeStep(const GLUSfloat timeStep, const GLUSint maxSteps, const GLUSboolean threaded)
+{
+	if (timeStep < 0.0f)
+	{
+		return GLUS_FALSE;
+	}
+
+	_glusWindowSchedulerShutdown();
+
+	g_timeStep = timeStep;
+	g_maxSteps = maxSteps > 0 ? maxSteps : GLUS_DEFAULT_MAX_STEPS;
+	g_threaded = threaded;
+
+	g_accumulator = 0.0;
+	g_interpolation = 1.0f;
+	g_pendingInterpolation = 0.0f;
+	g_droppedSteps = 0;
+
+	return GLUS_TRUE;
+}
+
+GLUSfloat GLUSAPIENTRY glusWindowGetInterpolation(GLUSvoid)
+{
+	return g_interpolation;
+}
+
+GLUSint GLUSAPIENTRY glusWindowGetDroppedSimulationSteps(GLUSvoid)
+{
+	return g_droppedSteps;
+}